@@ -99,6 +99,12 @@
     @if exist "../out/example_9.dll" del "..\out\example_9.dll"
     @if exist "../out/example_9_*.dll" del "..\out\example_9_*.dll"
     @if exist "../out/example_9_*.pdb" del "..\out\example_9_*.pdb"
+    @if exist "../out/example_10.dll" del "..\out\example_10.dll"
+    @if exist "../out/example_10_*.dll" del "..\out\example_10_*.dll"
+    @if exist "../out/example_10_*.pdb" del "..\out\example_10_*.pdb"
+    @if exist "../out/example_11.dll" del "..\out\example_11.dll"
+    @if exist "../out/example_11_*.dll" del "..\out\example_11_*.dll"
+    @if exist "../out/example_11_*.pdb" del "..\out\example_11_*.pdb"
 
 )
 
@@ -372,6 +378,66 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 @echo [36mResult: [0m %PL_RESULT%
 @echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ example_10 | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_PROFILING_ON -DPL_ALLOW_HOT_RELOAD -DPL_ENABLE_VALIDATION_LAYERS 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="example_10.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: example_10[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/example_10.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/example_10_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ example_11 | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_PROFILING_ON -DPL_ALLOW_HOT_RELOAD -DPL_ENABLE_VALIDATION_LAYERS 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="example_11.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: example_11[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/example_11.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/example_11_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
 :Cleanupdebug
 
 @echo [1m[36mCleaning...[0m
@@ -440,6 +506,12 @@ goto ExitLabel
     @if exist "../out/example_9.dll" del "..\out\example_9.dll"
     @if exist "../out/example_9_*.dll" del "..\out\example_9_*.dll"
     @if exist "../out/example_9_*.pdb" del "..\out\example_9_*.pdb"
+    @if exist "../out/example_10.dll" del "..\out\example_10.dll"
+    @if exist "../out/example_10_*.dll" del "..\out\example_10_*.dll"
+    @if exist "../out/example_10_*.pdb" del "..\out\example_10_*.pdb"
+    @if exist "../out/example_11.dll" del "..\out\example_11.dll"
+    @if exist "../out/example_11_*.dll" del "..\out\example_11_*.dll"
+    @if exist "../out/example_11_*.pdb" del "..\out\example_11_*.pdb"
 
 )
 
@@ -713,6 +785,66 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 @echo [36mResult: [0m %PL_RESULT%
 @echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ example_10 | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_PROFILING_ON -DPL_ALLOW_HOT_RELOAD -DPL_ENABLE_VALIDATION_LAYERS 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="example_10.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: example_10[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/example_10.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/example_10_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ example_11 | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+@set PL_DEFINES=-D_USE_MATH_DEFINES -DPL_PROFILING_ON -DPL_ALLOW_HOT_RELOAD -DPL_ENABLE_VALIDATION_LAYERS 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD 
+@set PL_LINKER_FLAGS=-noimplib -noexp -incremental:no 
+@set PL_SOURCES="example_11.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: example_11[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/example_11.dll" -Fo"../out/" -LD -link %PL_LINKER_FLAGS% -PDB:"../out/example_11_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
 :Cleanuprelease
 
 @echo [1m[36mCleaning...[0m
@@ -0,0 +1,316 @@
+/*
+   example_10.c
+     - demonstrates headless use of the ECS & job extensions
+     - benchmarks the ECS update systems at 1-32 job threads
+
+   Notes:
+     - no window is created; the app builds a scene of skinned, animated
+       characters & static props, times each system, prints the results,
+       then exits
+     - thread counts above the hardware thread count are skipped
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] structs
+// [SECTION] apis
+// [SECTION] helper function declarations
+// [SECTION] pl_app_load
+// [SECTION] pl_app_shutdown
+// [SECTION] pl_app_resize
+// [SECTION] pl_app_update
+// [SECTION] helper function definitions
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl.h"
+#include "pl_profile.h"
+#include "pl_log.h"
+#include "pl_ds.h"
+#include "pl_os.h"
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl_math.h"
+
+// extensions
+#include "pl_job_ext.h"
+#include "pl_ecs_ext.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define BENCH_CHARACTER_COUNT 1000  // skinned & animated characters
+#define BENCH_JOINT_COUNT     32    // joints per character (single chain)
+#define BENCH_PROP_COUNT      50000 // static objects
+#define BENCH_KEYFRAME_COUNT  30
+#define BENCH_FRAME_COUNT     60    // frames timed per thread count
+#define BENCH_SYSTEM_COUNT    5
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plAppData
+{
+    plComponentLibrary tComponentLibrary;
+} plAppData;
+
+//-----------------------------------------------------------------------------
+// [SECTION] apis
+//-----------------------------------------------------------------------------
+
+const plIOI*      gptIO      = NULL;
+const plThreadsI* gptThreads = NULL;
+const plJobI*     gptJob     = NULL;
+const plEcsI*     gptEcs     = NULL;
+
+//-----------------------------------------------------------------------------
+// [SECTION] helper function declarations
+//-----------------------------------------------------------------------------
+
+static float random_float(void); // [0, 1), fixed seed so every run builds the same scene
+static void  build_scene (plComponentLibrary*);
+static void  run_frame   (plComponentLibrary*);
+
+// profile sample names of the timed systems
+static const char* gapcSystemNames[BENCH_SYSTEM_COUNT] = {
+    "pl_run_animation_update_system",
+    "pl_run_transform_update_system",
+    "pl_run_hierarchy_update_system",
+    "pl_run_skin_update_system",
+    "pl_run_object_update_system"
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_load
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void*
+pl_app_load(plApiRegistryI* ptApiRegistry, plAppData* ptAppData)
+{
+    const plDataRegistryI* ptDataRegistry = ptApiRegistry->first(PL_API_DATA_REGISTRY);
+
+    // set log & profile contexts
+    pl_set_log_context(ptDataRegistry->get_data("log"));
+    pl_set_profile_context(ptDataRegistry->get_data("profile"));
+
+    // hot reload
+    if(ptAppData)
+    {
+        gptIO      = ptApiRegistry->first(PL_API_IO);
+        gptThreads = ptApiRegistry->first(PL_API_THREADS);
+        gptJob     = ptApiRegistry->first(PL_API_JOB);
+        gptEcs     = ptApiRegistry->first(PL_API_ECS);
+        return ptAppData;
+    }
+
+    ptAppData = malloc(sizeof(plAppData));
+    memset(ptAppData, 0, sizeof(plAppData));
+
+    // load extensions (graphics is never initialized)
+    const plExtensionRegistryI* ptExtensionRegistry = ptApiRegistry->first(PL_API_EXTENSION_REGISTRY);
+    ptExtensionRegistry->load("pilot_light", NULL, NULL, true);
+    ptExtensionRegistry->load("pilot_light_experimental", NULL, NULL, true);
+
+    gptIO      = ptApiRegistry->first(PL_API_IO);
+    gptThreads = ptApiRegistry->first(PL_API_THREADS);
+    gptJob     = ptApiRegistry->first(PL_API_JOB);
+    gptEcs     = ptApiRegistry->first(PL_API_ECS);
+
+    gptEcs->init_component_library(&ptAppData->tComponentLibrary);
+    build_scene(&ptAppData->tComponentLibrary);
+
+    return ptAppData;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_shutdown
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_shutdown(plAppData* ptAppData)
+{
+    gptEcs->cleanup_component_library(&ptAppData->tComponentLibrary);
+    free(ptAppData);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_resize
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_resize(plAppData* ptAppData)
+{
+    // NOTE: this function is not used here since this example doesn't have a window
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_update
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_update(plAppData* ptAppData)
+{
+    gptIO->new_frame();
+
+    const uint32_t uHardwareThreadCount = gptThreads->get_hardware_thread_count();
+    printf("ecs benchmark: %d characters (%d joints), %d props, %d frames\n",
+        BENCH_CHARACTER_COUNT, BENCH_JOINT_COUNT, BENCH_PROP_COUNT, BENCH_FRAME_COUNT);
+    printf("%8s %12s %12s %12s %12s %12s   (average ms)\n", "threads", "animation", "transform", "hierarchy", "skin", "object");
+
+    for(uint32_t uThreadCount = 1; uThreadCount <= 32; uThreadCount *= 2)
+    {
+        if(uThreadCount > uHardwareThreadCount)
+        {
+            printf("%8u skipped (hardware has %u threads)\n", uThreadCount, uHardwareThreadCount);
+            continue;
+        }
+
+        gptJob->initialize(uThreadCount);
+
+        double adTotals[BENCH_SYSTEM_COUNT] = {0};
+        for(uint32_t uFrame = 0; uFrame < BENCH_FRAME_COUNT; uFrame++)
+        {
+            pl_begin_profile_frame();
+            run_frame(&ptAppData->tComponentLibrary);
+            pl_end_profile_frame();
+
+            uint32_t uSampleCount = 0;
+            const plProfileSample* ptSamples = pl_get_last_frame_samples(0, &uSampleCount);
+            for(uint32_t i = 0; i < uSampleCount; i++)
+            {
+                for(uint32_t j = 0; j < BENCH_SYSTEM_COUNT; j++)
+                {
+                    if(strcmp(ptSamples[i].pcName, gapcSystemNames[j]) == 0)
+                        adTotals[j] += ptSamples[i].dDuration;
+                }
+            }
+        }
+
+        gptJob->cleanup();
+
+        printf("%8u", uThreadCount);
+        for(uint32_t j = 0; j < BENCH_SYSTEM_COUNT; j++)
+            printf(" %12.3f", adTotals[j] * 1000.0 / (double)BENCH_FRAME_COUNT);
+        printf("\n");
+    }
+
+    // benchmark runs once
+    plIO* ptIO = gptIO->get_io();
+    ptIO->bRunning = false;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] helper function definitions
+//-----------------------------------------------------------------------------
+
+static float
+random_float(void)
+{
+    static uint32_t uState = 1234567;
+    uState = uState * 1664525u + 1013904223u;
+    return (float)(uState >> 8) / 16777216.0f;
+}
+
+static void
+build_scene(plComponentLibrary* ptLibrary)
+{
+    char acName[64] = {0};
+
+    // shared rotation keyframes (linear)
+    plAnimationDataComponent* ptAnimationData = NULL;
+    plEntity tAnimationData = gptEcs->create_animation_data(ptLibrary, "bench rotation data", &ptAnimationData);
+    for(uint32_t i = 0; i < BENCH_KEYFRAME_COUNT; i++)
+    {
+        pl_sb_push(ptAnimationData->sbfKeyFrameTimes, (float)i / (float)(BENCH_KEYFRAME_COUNT - 1));
+        const plVec4 tRotation = pl_norm_vec4((plVec4){random_float() * 0.2f, random_float() * 0.2f, 0.0f, 1.0f});
+        for(uint32_t j = 0; j < 4; j++)
+            pl_sb_push(ptAnimationData->sbfKeyFrameData, tRotation.d[j]);
+    }
+
+    // characters: joint chain, skin, skinned mesh object, looping animation
+    for(uint32_t i = 0; i < BENCH_CHARACTER_COUNT; i++)
+    {
+        plEntity atJoints[BENCH_JOINT_COUNT] = {0};
+        for(uint32_t j = 0; j < BENCH_JOINT_COUNT; j++)
+        {
+            plTransformComponent* ptTransform = NULL;
+            snprintf(acName, 64, "character %u joint %u", i, j);
+            atJoints[j] = gptEcs->create_transform(ptLibrary, acName, &ptTransform);
+            ptTransform->tTranslation = j == 0 ? (plVec3){random_float() * 100.0f, 0.0f, random_float() * 100.0f} : (plVec3){0.0f, 0.1f, 0.0f};
+            if(j > 0)
+                gptEcs->attach_component(ptLibrary, atJoints[j], atJoints[j - 1]);
+        }
+
+        plObjectComponent* ptObject = NULL;
+        snprintf(acName, 64, "character %u", i);
+        plEntity tCharacter = gptEcs->create_object(ptLibrary, acName, &ptObject);
+
+        plSkinComponent* ptSkin = NULL;
+        snprintf(acName, 64, "character %u skin", i);
+        plEntity tSkin = gptEcs->create_skin(ptLibrary, acName, &ptSkin);
+        ptSkin->tMeshNode = tCharacter;
+        for(uint32_t j = 0; j < BENCH_JOINT_COUNT; j++)
+        {
+            pl_sb_push(ptSkin->sbtJoints, atJoints[j]);
+            pl_sb_push(ptSkin->sbtInverseBindMatrices, pl_mat4_translate_xyz(0.0f, -0.1f * (float)j, 0.0f));
+            pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+            pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+        }
+
+        plMeshComponent* ptMesh = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tCharacter);
+        ptMesh->tSkinComponent = tSkin;
+        ptMesh->tAABB = (plAABB){.tMin = {-0.5f, 0.0f, -0.5f}, .tMax = {0.5f, 3.2f, 0.5f}};
+
+        plAnimationComponent* ptAnimation = NULL;
+        snprintf(acName, 64, "character %u animation", i);
+        gptEcs->create_animation(ptLibrary, acName, &ptAnimation);
+        ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING | PL_ANIMATION_FLAG_LOOPED;
+        ptAnimation->fEnd = 1.0f;
+        ptAnimation->fTimer = random_float();
+        ptAnimation->fBlendAmount = 1.0f;
+        pl_sb_push(ptAnimation->sbtSamplers, ((plAnimationSampler){.tMode = PL_ANIMATION_MODE_LINEAR, .tData = tAnimationData}));
+        for(uint32_t j = 0; j < BENCH_JOINT_COUNT; j++)
+        {
+            const plAnimationChannel tChannel = {
+                .tPath         = PL_ANIMATION_PATH_ROTATION,
+                .tTarget       = atJoints[j],
+                .uSamplerIndex = 0
+            };
+            pl_sb_push(ptAnimation->sbtChannels, tChannel);
+        }
+    }
+
+    // static props
+    for(uint32_t i = 0; i < BENCH_PROP_COUNT; i++)
+    {
+        plObjectComponent* ptObject = NULL;
+        snprintf(acName, 64, "prop %u", i);
+        plEntity tProp = gptEcs->create_object(ptLibrary, acName, &ptObject);
+
+        plTransformComponent* ptTransform = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tProp);
+        ptTransform->tTranslation = (plVec3){random_float() * 1000.0f, 0.0f, random_float() * 1000.0f};
+        ptTransform->tRotation = pl_norm_vec4((plVec4){0.0f, random_float(), 0.0f, 1.0f});
+
+        plMeshComponent* ptMesh = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tProp);
+        ptMesh->tAABB = (plAABB){.tMin = {-1.0f, 0.0f, -1.0f}, .tMax = {1.0f, 2.0f, 1.0f}};
+    }
+}
+
+static void
+run_frame(plComponentLibrary* ptLibrary)
+{
+    gptEcs->run_animation_update_system(ptLibrary, 1.0f / 60.0f);
+    gptEcs->run_transform_update_system(ptLibrary);
+    gptEcs->run_hierarchy_update_system(ptLibrary);
+    gptEcs->run_skin_update_system(ptLibrary);
+    gptEcs->run_object_update_system(ptLibrary);
+}
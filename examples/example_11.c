@@ -0,0 +1,506 @@
+/*
+   example_11.c
+     - demonstrates headless use of the ECS fixed timestep & input streams
+     - records a run & replays it bit identically at 1-32 job threads
+
+   Notes:
+     - meant for a runtime built with PL_HEADLESS_APP (see pl_config.h) but
+       runs with a window too (nothing is drawn)
+     - the first launch records: every frame feeds its real delta & a
+       scripted "player" input (no devices when headless) to
+       advance_fixed_step, which appends one input per step to the stream;
+       the stream & the final state hash are written to
+       example_11_inputs.bin
+     - later launches load that file instead of recording
+     - either way the stream is then replayed with run_fixed_steps at each
+       thread count & the state hashes are compared to the recorded one
+     - thread counts above the hardware thread count are skipped
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] defines
+// [SECTION] structs
+// [SECTION] apis
+// [SECTION] helper function declarations
+// [SECTION] pl_app_load
+// [SECTION] pl_app_shutdown
+// [SECTION] pl_app_resize
+// [SECTION] pl_app_update
+// [SECTION] helper function definitions
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pl.h"
+#include "pl_profile.h"
+#include "pl_log.h"
+#include "pl_ds.h"
+#include "pl_os.h"
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl_math.h"
+
+// extensions
+#include "pl_job_ext.h"
+#include "pl_ecs_ext.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define REPLAY_FILE            "example_11_inputs.bin"
+#define REPLAY_STEP_COUNT      240  // fixed steps recorded (4 seconds at 60 Hz)
+#define REPLAY_CHARACTER_COUNT 64   // animated joint chains
+#define REPLAY_JOINT_COUNT     16
+#define REPLAY_PROP_COUNT      5000 // static objects
+#define REPLAY_PROJECTILE_LIFE 90   // steps before a projectile is removed
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+// one per fixed step
+typedef struct _plReplayInput
+{
+    float    fMoveX;
+    float    fMoveZ;
+    uint32_t uFire;
+} plReplayInput;
+
+typedef struct _plReplayProjectile
+{
+    plEntity tEntity;
+    uint64_t uSpawnStep;
+} plReplayProjectile;
+
+// simulation state owned by the step callback (one per library)
+typedef struct _plReplayWorld
+{
+    plComponentLibrary  tLibrary;
+    plEntity            tPlayer;
+    plReplayProjectile* sbtProjectiles;
+} plReplayWorld;
+
+typedef struct _plAppData
+{
+    plReplayWorld     tWorld;     // recording
+    plEcsInputStream* ptStream;
+    uint64_t          uStateHash; // hash of the recorded run's final state
+    uint32_t          uFrames;
+    bool              bRecording;
+} plAppData;
+
+//-----------------------------------------------------------------------------
+// [SECTION] apis
+//-----------------------------------------------------------------------------
+
+const plIOI*      gptIO      = NULL;
+const plThreadsI* gptThreads = NULL;
+const plJobI*     gptJob     = NULL;
+const plEcsI*     gptEcs     = NULL;
+
+//-----------------------------------------------------------------------------
+// [SECTION] helper function declarations
+//-----------------------------------------------------------------------------
+
+static float    random_float  (uint32_t* puState); // [0, 1)
+static void     build_world   (plReplayWorld*);
+static void     cleanup_world (plReplayWorld*);
+static void     step_world    (plComponentLibrary*, uint64_t uStep, const void* pInput, uint32_t uInputSize, void* pUserData);
+static uint64_t hash_state    (plComponentLibrary*);
+static bool     load_recording(plAppData*);
+static void     save_recording(plAppData*);
+static void     run_replays   (plAppData*);
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_load
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void*
+pl_app_load(plApiRegistryI* ptApiRegistry, plAppData* ptAppData)
+{
+    const plDataRegistryI* ptDataRegistry = ptApiRegistry->first(PL_API_DATA_REGISTRY);
+
+    // set log & profile contexts
+    pl_set_log_context(ptDataRegistry->get_data("log"));
+    pl_set_profile_context(ptDataRegistry->get_data("profile"));
+
+    // hot reload
+    if(ptAppData)
+    {
+        gptIO      = ptApiRegistry->first(PL_API_IO);
+        gptThreads = ptApiRegistry->first(PL_API_THREADS);
+        gptJob     = ptApiRegistry->first(PL_API_JOB);
+        gptEcs     = ptApiRegistry->first(PL_API_ECS);
+        return ptAppData;
+    }
+
+    ptAppData = malloc(sizeof(plAppData));
+    memset(ptAppData, 0, sizeof(plAppData));
+
+    // load extensions (graphics is never initialized)
+    const plExtensionRegistryI* ptExtensionRegistry = ptApiRegistry->first(PL_API_EXTENSION_REGISTRY);
+    ptExtensionRegistry->load("pilot_light", NULL, NULL, true);
+    ptExtensionRegistry->load("pilot_light_experimental", NULL, NULL, true);
+
+    gptIO      = ptApiRegistry->first(PL_API_IO);
+    gptThreads = ptApiRegistry->first(PL_API_THREADS);
+    gptJob     = ptApiRegistry->first(PL_API_JOB);
+    gptEcs     = ptApiRegistry->first(PL_API_ECS);
+
+    gptJob->initialize(0);
+
+    ptAppData->ptStream = gptEcs->create_input_stream();
+    ptAppData->bRecording = !load_recording(ptAppData);
+    if(ptAppData->bRecording)
+    {
+        build_world(&ptAppData->tWorld);
+        const plFixedStepDesc tDesc = {
+            .ptRecordStream = ptAppData->ptStream,
+            .step           = step_world,
+            .pUserData      = &ptAppData->tWorld
+        };
+        gptEcs->set_fixed_step(&ptAppData->tWorld.tLibrary, &tDesc);
+        printf("recording %d fixed steps\n", REPLAY_STEP_COUNT);
+    }
+    return ptAppData;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_shutdown
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_shutdown(plAppData* ptAppData)
+{
+    if(ptAppData->bRecording)
+        cleanup_world(&ptAppData->tWorld);
+    gptEcs->cleanup_input_stream(&ptAppData->ptStream);
+    gptJob->cleanup();
+    free(ptAppData);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_resize
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_resize(plAppData* ptAppData)
+{
+    // NOTE: this function is not used here since this example doesn't draw
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] pl_app_update
+//-----------------------------------------------------------------------------
+
+PL_EXPORT void
+pl_app_update(plAppData* ptAppData)
+{
+    gptIO->new_frame();
+    plIO* ptIO = gptIO->get_io();
+
+    if(ptAppData->bRecording)
+    {
+        // scripted player: steers in a slow circle & fires now & then
+        static uint32_t uInputState = 7;
+        const float fAngle = (float)ptAppData->uFrames * 0.05f;
+        const plReplayInput tInput = {
+            .fMoveX = cosf(fAngle) * 4.0f,
+            .fMoveZ = sinf(fAngle) * 4.0f,
+            .uFire  = random_float(&uInputState) < 0.1f
+        };
+        ptAppData->uFrames++;
+
+        // real frame delta; the last frame runs exactly the steps left so the
+        // recording has REPLAY_STEP_COUNT inputs
+        plComponentLibrary* ptLibrary = &ptAppData->tWorld.tLibrary;
+        const plFixedStepState* ptState = gptEcs->get_fixed_step_state(ptLibrary);
+        const uint32_t uStepsLeft = REPLAY_STEP_COUNT - (uint32_t)ptState->uStep;
+        if(ptIO->fDeltaTime >= (float)uStepsLeft * ptState->tDesc.fStepSize - (float)ptState->dAccumulator)
+            gptEcs->run_fixed_steps(ptLibrary, uStepsLeft, &tInput, sizeof(tInput));
+        else
+            gptEcs->advance_fixed_step(ptLibrary, ptIO->fDeltaTime, &tInput, sizeof(tInput));
+
+        if(ptState->uStep < REPLAY_STEP_COUNT)
+            return;
+
+        ptAppData->uStateHash = hash_state(ptLibrary);
+        printf("recorded %d steps over %u frames (%llu dropped), state hash %016llx\n",
+            REPLAY_STEP_COUNT, ptAppData->uFrames, (unsigned long long)ptState->uDroppedSteps, (unsigned long long)ptAppData->uStateHash);
+        save_recording(ptAppData);
+    }
+
+    run_replays(ptAppData);
+
+    // example runs once
+    ptIO->bRunning = false;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] helper function definitions
+//-----------------------------------------------------------------------------
+
+static float
+random_float(uint32_t* puState)
+{
+    *puState = *puState * 1664525u + 1013904223u;
+    return (float)(*puState >> 8) / 16777216.0f;
+}
+
+static void
+build_world(plReplayWorld* ptWorld)
+{
+    plComponentLibrary* ptLibrary = &ptWorld->tLibrary;
+    gptEcs->init_component_library(ptLibrary);
+    uint32_t uState = 1234567; // fixed seed so every build is the same
+    char acName[64] = {0};
+
+    // shared rotation keyframes (linear)
+    plAnimationDataComponent* ptAnimationData = NULL;
+    plEntity tAnimationData = gptEcs->create_animation_data(ptLibrary, "replay rotation data", &ptAnimationData);
+    for(uint32_t i = 0; i < 30; i++)
+    {
+        pl_sb_push(ptAnimationData->sbfKeyFrameTimes, (float)i / 29.0f);
+        const plVec4 tRotation = pl_norm_vec4((plVec4){random_float(&uState) * 0.2f, random_float(&uState) * 0.2f, 0.0f, 1.0f});
+        for(uint32_t j = 0; j < 4; j++)
+            pl_sb_push(ptAnimationData->sbfKeyFrameData, tRotation.d[j]);
+    }
+
+    // characters: joint chain & looping animation
+    for(uint32_t i = 0; i < REPLAY_CHARACTER_COUNT; i++)
+    {
+        plEntity atJoints[REPLAY_JOINT_COUNT] = {0};
+        for(uint32_t j = 0; j < REPLAY_JOINT_COUNT; j++)
+        {
+            plTransformComponent* ptTransform = NULL;
+            snprintf(acName, 64, "character %u joint %u", i, j);
+            atJoints[j] = gptEcs->create_transform(ptLibrary, acName, &ptTransform);
+            ptTransform->tTranslation = j == 0 ? (plVec3){random_float(&uState) * 100.0f, 0.0f, random_float(&uState) * 100.0f} : (plVec3){0.0f, 0.1f, 0.0f};
+            if(j > 0)
+                gptEcs->attach_component(ptLibrary, atJoints[j], atJoints[j - 1]);
+        }
+
+        plAnimationComponent* ptAnimation = NULL;
+        snprintf(acName, 64, "character %u animation", i);
+        gptEcs->create_animation(ptLibrary, acName, &ptAnimation);
+        ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING | PL_ANIMATION_FLAG_LOOPED;
+        ptAnimation->fEnd = 1.0f;
+        ptAnimation->fTimer = random_float(&uState);
+        ptAnimation->fBlendAmount = 1.0f;
+        pl_sb_push(ptAnimation->sbtSamplers, ((plAnimationSampler){.tMode = PL_ANIMATION_MODE_LINEAR, .tData = tAnimationData}));
+        for(uint32_t j = 0; j < REPLAY_JOINT_COUNT; j++)
+        {
+            const plAnimationChannel tChannel = {
+                .tPath         = PL_ANIMATION_PATH_ROTATION,
+                .tTarget       = atJoints[j],
+                .uSamplerIndex = 0
+            };
+            pl_sb_push(ptAnimation->sbtChannels, tChannel);
+        }
+    }
+
+    // static props
+    for(uint32_t i = 0; i < REPLAY_PROP_COUNT; i++)
+    {
+        snprintf(acName, 64, "prop %u", i);
+        plEntity tProp = gptEcs->create_object(ptLibrary, acName, NULL);
+        plTransformComponent* ptTransform = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tProp);
+        ptTransform->tTranslation = (plVec3){random_float(&uState) * 1000.0f, 0.0f, random_float(&uState) * 1000.0f};
+        plMeshComponent* ptMesh = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tProp);
+        ptMesh->tAABB = (plAABB){.tMin = {-1.0f, 0.0f, -1.0f}, .tMax = {1.0f, 2.0f, 1.0f}};
+    }
+
+    // player
+    ptWorld->tPlayer = gptEcs->create_object(ptLibrary, "player", NULL);
+    plMeshComponent* ptMesh = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, ptWorld->tPlayer);
+    ptMesh->tAABB = (plAABB){.tMin = {-0.5f, 0.0f, -0.5f}, .tMax = {0.5f, 2.0f, 0.5f}};
+}
+
+static void
+cleanup_world(plReplayWorld* ptWorld)
+{
+    pl_sb_free(ptWorld->sbtProjectiles);
+    gptEcs->cleanup_component_library(&ptWorld->tLibrary);
+}
+
+// everything that changes the world goes through the step's input so replays
+// match the recording
+static void
+step_world(plComponentLibrary* ptLibrary, uint64_t uStep, const void* pInput, uint32_t uInputSize, void* pUserData)
+{
+    plReplayWorld* ptWorld = pUserData;
+    const float fStepSize = gptEcs->get_fixed_step_state(ptLibrary)->tDesc.fStepSize;
+    plReplayInput tInput = {0};
+    if(pInput && uInputSize == sizeof(plReplayInput))
+        memcpy(&tInput, pInput, sizeof(plReplayInput));
+
+    plTransformComponent* ptPlayer = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptWorld->tPlayer);
+    ptPlayer->tTranslation.x += tInput.fMoveX * fStepSize;
+    ptPlayer->tTranslation.z += tInput.fMoveZ * fStepSize;
+    const plVec3 tPlayerPosition = ptPlayer->tTranslation; // pointer invalid after spawning
+
+    // projectiles fly along +z & expire
+    for(uint32_t i = 0; i < pl_sb_size(ptWorld->sbtProjectiles); i++)
+    {
+        plTransformComponent* ptTransform = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptWorld->sbtProjectiles[i].tEntity);
+        ptTransform->tTranslation.z += 20.0f * fStepSize;
+    }
+    while(pl_sb_size(ptWorld->sbtProjectiles) > 0 && uStep - ptWorld->sbtProjectiles[0].uSpawnStep >= REPLAY_PROJECTILE_LIFE)
+    {
+        gptEcs->remove_entity(ptLibrary, ptWorld->sbtProjectiles[0].tEntity);
+        pl_sb_del(ptWorld->sbtProjectiles, 0);
+    }
+
+    if(tInput.uFire)
+    {
+        const plReplayProjectile tProjectile = {
+            .tEntity    = gptEcs->create_object(ptLibrary, NULL, NULL),
+            .uSpawnStep = uStep
+        };
+        plTransformComponent* ptTransform = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tProjectile.tEntity);
+        ptTransform->tTranslation = pl_add_vec3(tPlayerPosition, (plVec3){0.0f, 1.0f, 0.0f});
+        plMeshComponent* ptMesh = gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tProjectile.tEntity);
+        ptMesh->tAABB = (plAABB){.tMin = {-0.1f, -0.1f, -0.1f}, .tMax = {0.1f, 0.1f, 0.1f}};
+        pl_sb_push(ptWorld->sbtProjectiles, tProjectile);
+    }
+}
+
+// FNV-1a over entity generations, world matrices & object bounds
+static uint64_t
+hash_bytes(uint64_t uHash, const void* pData, size_t szSize)
+{
+    const unsigned char* pucData = pData;
+    for(size_t i = 0; i < szSize; i++)
+    {
+        uHash ^= pucData[i];
+        uHash *= 1099511628211ull;
+    }
+    return uHash;
+}
+
+static uint64_t
+hash_state(plComponentLibrary* ptLibrary)
+{
+    uint64_t uHash = 14695981039346656037ull;
+    uHash = hash_bytes(uHash, ptLibrary->sbtEntityGenerations, sizeof(uint32_t) * pl_sb_size(ptLibrary->sbtEntityGenerations));
+    const plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities); i++)
+        uHash = hash_bytes(uHash, &sbtTransforms[i].tWorld, sizeof(plMat4));
+    const plMeshComponent* sbtMeshes = ptLibrary->tMeshComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary->tMeshComponentManager.sbtEntities); i++)
+        uHash = hash_bytes(uHash, &sbtMeshes[i].tAABBFinal, sizeof(plAABB));
+    return uHash;
+}
+
+// file: state hash, then the saved input stream
+static bool
+load_recording(plAppData* ptAppData)
+{
+    FILE* ptFile = fopen(REPLAY_FILE, "rb");
+    if(ptFile == NULL)
+        return false;
+    fseek(ptFile, 0, SEEK_END);
+    const long lSize = ftell(ptFile);
+    fseek(ptFile, 0, SEEK_SET);
+
+    bool bLoaded = false;
+    if(lSize > (long)sizeof(uint64_t))
+    {
+        unsigned char* pucData = malloc((size_t)lSize);
+        if(fread(pucData, 1, (size_t)lSize, ptFile) == (size_t)lSize)
+        {
+            memcpy(&ptAppData->uStateHash, pucData, sizeof(uint64_t));
+            bLoaded = gptEcs->load_input_stream(ptAppData->ptStream, &pucData[sizeof(uint64_t)], (size_t)lSize - sizeof(uint64_t));
+        }
+        free(pucData);
+    }
+    fclose(ptFile);
+
+    if(bLoaded)
+        printf("loaded %s: %llu steps, state hash %016llx\n", REPLAY_FILE,
+            (unsigned long long)gptEcs->get_stream_length(ptAppData->ptStream), (unsigned long long)ptAppData->uStateHash);
+    else
+        printf("%s is invalid, recording a new one\n", REPLAY_FILE);
+    return bLoaded;
+}
+
+static void
+save_recording(plAppData* ptAppData)
+{
+    size_t szSize = 0;
+    gptEcs->save_input_stream(ptAppData->ptStream, NULL, &szSize);
+    unsigned char* pucData = malloc(sizeof(uint64_t) + szSize);
+    memcpy(pucData, &ptAppData->uStateHash, sizeof(uint64_t));
+    gptEcs->save_input_stream(ptAppData->ptStream, &pucData[sizeof(uint64_t)], &szSize);
+
+    FILE* ptFile = fopen(REPLAY_FILE, "wb");
+    if(ptFile)
+    {
+        fwrite(pucData, 1, sizeof(uint64_t) + szSize, ptFile);
+        fclose(ptFile);
+        printf("saved %s (%zu bytes)\n", REPLAY_FILE, sizeof(uint64_t) + szSize);
+    }
+    free(pucData);
+}
+
+static void
+run_replays(plAppData* ptAppData)
+{
+    const uint32_t uStepCount = (uint32_t)gptEcs->get_stream_length(ptAppData->ptStream);
+    const uint32_t uHardwareThreadCount = gptThreads->get_hardware_thread_count();
+    printf("%8s %18s %10s %10s\n", "threads", "state hash", "result", "replay ms");
+
+    gptJob->cleanup();
+    uint32_t uMismatches = 0;
+    for(uint32_t uThreadCount = 1; uThreadCount <= 32; uThreadCount *= 2)
+    {
+        if(uThreadCount > uHardwareThreadCount)
+        {
+            printf("%8u skipped (hardware has %u threads)\n", uThreadCount, uHardwareThreadCount);
+            continue;
+        }
+        gptJob->initialize(uThreadCount);
+
+        plReplayWorld tWorld = {0};
+        build_world(&tWorld);
+        const plFixedStepDesc tDesc = {
+            .ptPlaybackStream = ptAppData->ptStream,
+            .step             = step_world,
+            .pUserData        = &tWorld
+        };
+        gptEcs->set_fixed_step(&tWorld.tLibrary, &tDesc);
+
+        pl_begin_profile_frame();
+        gptEcs->run_fixed_steps(&tWorld.tLibrary, uStepCount, NULL, 0);
+        pl_end_profile_frame();
+
+        double dDuration = 0.0;
+        uint32_t uSampleCount = 0;
+        const plProfileSample* ptSamples = pl_get_last_frame_samples(0, &uSampleCount);
+        for(uint32_t i = 0; i < uSampleCount; i++)
+        {
+            if(strcmp(ptSamples[i].pcName, "pl_ecs_run_fixed_steps") == 0)
+                dDuration += ptSamples[i].dDuration;
+        }
+
+        const uint64_t uHash = hash_state(&tWorld.tLibrary);
+        const bool bMatch = uHash == ptAppData->uStateHash;
+        uMismatches += bMatch ? 0 : 1;
+        printf("%8u   %016llx %10s %10.2f\n", uThreadCount, (unsigned long long)uHash, bMatch ? "match" : "MISMATCH", dDuration * 1000.0);
+
+        cleanup_world(&tWorld);
+        gptJob->cleanup();
+    }
+    gptJob->initialize(0);
+    if(uMismatches == 0)
+        printf("all replays match the recording\n");
+    else
+        printf("%u replays don't match the recording\n", uMismatches);
+}
@@ -0,0 +1,559 @@
+/*
+   pl_ecs_archetype.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] archetype storage
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] archetype storage
+//-----------------------------------------------------------------------------
+
+static inline unsigned char*
+pl__archetype_element(const plArchetype* ptArchetype, uint32_t uRow, plComponentType tType)
+{
+    const plArchetypeChunk* ptChunk = &ptArchetype->sbtChunks[uRow / ptArchetype->uRowsPerChunk];
+    const uint32_t uChunkRow = uRow % ptArchetype->uRowsPerChunk;
+    return &ptChunk->pucData[ptArchetype->auColumnOffsets[tType] + uChunkRow * gaszComponentSizes[tType]];
+}
+
+static inline plEntity*
+pl__archetype_entity(const plArchetype* ptArchetype, uint32_t uRow)
+{
+    const plArchetypeChunk* ptChunk = &ptArchetype->sbtChunks[uRow / ptArchetype->uRowsPerChunk];
+    plEntity* atEntities = (plEntity*)ptChunk->pucData;
+    return &atEntities[uRow % ptArchetype->uRowsPerChunk];
+}
+
+static uint32_t
+pl__archetype_layout(plArchetype* ptArchetype, uint32_t uRowsPerChunk)
+{
+    // entity column first, then component columns in type order (16 byte aligned)
+    uint32_t uOffset = uRowsPerChunk * (uint32_t)sizeof(plEntity);
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        ptArchetype->auColumnOffsets[i] = UINT32_MAX;
+        if(ptArchetype->tMask & PL_COMPONENT_MASK(i))
+        {
+            uOffset = (uint32_t)pl_align_up(uOffset, 16);
+            ptArchetype->auColumnOffsets[i] = uOffset;
+            uOffset += uRowsPerChunk * (uint32_t)gaszComponentSizes[i];
+        }
+    }
+    return uOffset;
+}
+
+static uint32_t
+pl__archetype_find_or_create(plArchetypeStorage* ptStorage, plComponentMask tMask)
+{
+    const uint32_t uArchetypeCount = pl_sb_size(ptStorage->sbtArchetypes);
+    for(uint32_t i = 0; i < uArchetypeCount; i++)
+    {
+        if(ptStorage->sbtArchetypes[i].tMask == tMask)
+            return i;
+    }
+
+    plArchetype tArchetype = {.tMask = tMask};
+    memset(tArchetype.auAddEdges, 0xFF, sizeof(tArchetype.auAddEdges));
+    memset(tArchetype.auRemoveEdges, 0xFF, sizeof(tArchetype.auRemoveEdges));
+
+    // as many rows as fit in a chunk (oversized rows get a chunk of their own)
+    size_t szRowSize = sizeof(plEntity);
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        if(tMask & PL_COMPONENT_MASK(i))
+            szRowSize += gaszComponentSizes[i];
+    }
+    uint32_t uRowsPerChunk = (uint32_t)(PL_ECS_CHUNK_SIZE / szRowSize);
+    while(uRowsPerChunk > 1 && pl__archetype_layout(&tArchetype, uRowsPerChunk) > PL_ECS_CHUNK_SIZE)
+        uRowsPerChunk--;
+    if(uRowsPerChunk == 0)
+        uRowsPerChunk = 1;
+    const uint32_t uLayoutSize = pl__archetype_layout(&tArchetype, uRowsPerChunk);
+    tArchetype.uRowsPerChunk = uRowsPerChunk;
+    tArchetype.uChunkSize = uLayoutSize > PL_ECS_CHUNK_SIZE ? uLayoutSize : PL_ECS_CHUNK_SIZE;
+
+    pl_sb_push(ptStorage->sbtArchetypes, tArchetype);
+    return uArchetypeCount;
+}
+
+static uint32_t
+pl__archetype_allocate_row(plArchetypeStorage* ptStorage, uint32_t uArchetype, plEntity tEntity)
+{
+    plArchetype* ptArchetype = &ptStorage->sbtArchetypes[uArchetype];
+    const uint32_t uRow = ptArchetype->uEntityCount++;
+    const uint32_t uChunk = uRow / ptArchetype->uRowsPerChunk;
+    if(uChunk == pl_sb_size(ptArchetype->sbtChunks))
+    {
+        plArchetypeChunk tChunk = {.pucData = PL_ALLOC(ptArchetype->uChunkSize)};
+        pl_sb_push(ptArchetype->sbtChunks, tChunk);
+    }
+    ptArchetype->sbtChunks[uChunk].uCount++;
+    *pl__archetype_entity(ptArchetype, uRow) = tEntity;
+    ptStorage->sbtRecords[tEntity.uIndex].uArchetype = uArchetype;
+    ptStorage->sbtRecords[tEntity.uIndex].uRow = uRow;
+    return uRow;
+}
+
+static void
+pl__archetype_free_row(plArchetypeStorage* ptStorage, uint32_t uArchetype, uint32_t uRow)
+{
+    // keep rows packed (move last row into freed slot)
+    plArchetype* ptArchetype = &ptStorage->sbtArchetypes[uArchetype];
+    const uint32_t uLastRow = --ptArchetype->uEntityCount;
+    if(uRow != uLastRow)
+    {
+        const plEntity tMovedEntity = *pl__archetype_entity(ptArchetype, uLastRow);
+        *pl__archetype_entity(ptArchetype, uRow) = tMovedEntity;
+        for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+        {
+            if(ptArchetype->tMask & PL_COMPONENT_MASK(i))
+                memcpy(pl__archetype_element(ptArchetype, uRow, i), pl__archetype_element(ptArchetype, uLastRow, i), gaszComponentSizes[i]);
+        }
+        ptStorage->sbtRecords[tMovedEntity.uIndex].uRow = uRow;
+    }
+    ptArchetype->sbtChunks[uLastRow / ptArchetype->uRowsPerChunk].uCount--;
+}
+
+static void
+pl__archetype_move_entity(plArchetypeStorage* ptStorage, plEntity tEntity, uint32_t uDstArchetype)
+{
+    const plArchetypeRecord tOldRecord = ptStorage->sbtRecords[tEntity.uIndex];
+    const uint32_t uDstRow = pl__archetype_allocate_row(ptStorage, uDstArchetype, tEntity);
+
+    const plArchetype* ptSrc = &ptStorage->sbtArchetypes[tOldRecord.uArchetype];
+    const plArchetype* ptDst = &ptStorage->sbtArchetypes[uDstArchetype];
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        if(!(ptDst->tMask & PL_COMPONENT_MASK(i)))
+            continue;
+        if(ptSrc->tMask & PL_COMPONENT_MASK(i))
+            memcpy(pl__archetype_element(ptDst, uDstRow, i), pl__archetype_element(ptSrc, tOldRecord.uRow, i), gaszComponentSizes[i]);
+        else
+            pl__ecs_init_component(i, pl__archetype_element(ptDst, uDstRow, i));
+    }
+    pl__archetype_free_row(ptStorage, tOldRecord.uArchetype, tOldRecord.uRow);
+}
+
+static plEntity
+pl__archetype_claim_entity(plArchetypeStorage* ptStorage)
+{
+    plEntity tNewEntity = {0};
+    if(pl_sb_size(ptStorage->sbtEntityFreeIndices) > 0) // free slot available
+    {
+        tNewEntity.uIndex = pl_sb_pop(ptStorage->sbtEntityFreeIndices);
+        tNewEntity.uGeneration = ptStorage->sbtEntityGenerations[tNewEntity.uIndex];
+    }
+    else // create new slot
+    {
+        tNewEntity.uIndex = pl_sb_size(ptStorage->sbtEntityGenerations);
+        pl_sb_push(ptStorage->sbtEntityGenerations, 0);
+        pl_sb_push(ptStorage->sbtRecords, ((plArchetypeRecord){UINT32_MAX, UINT32_MAX}));
+    }
+    return tNewEntity;
+}
+
+static plArchetypeStorage*
+pl_ecs_create_archetype_storage(void)
+{
+    plArchetypeStorage* ptStorage = PL_ALLOC(sizeof(plArchetypeStorage));
+    memset(ptStorage, 0, sizeof(plArchetypeStorage));
+    pl__archetype_find_or_create(ptStorage, 0); // archetype 0 holds entities without components
+    return ptStorage;
+}
+
+static void
+pl_ecs_cleanup_archetype_storage(plArchetypeStorage** pptStorage)
+{
+    plArchetypeStorage* ptStorage = *pptStorage;
+    for(uint32_t i = 0; i < pl_sb_size(ptStorage->sbtArchetypes); i++)
+    {
+        for(uint32_t j = 0; j < pl_sb_size(ptStorage->sbtArchetypes[i].sbtChunks); j++)
+            PL_FREE(ptStorage->sbtArchetypes[i].sbtChunks[j].pucData);
+        pl_sb_free(ptStorage->sbtArchetypes[i].sbtChunks);
+    }
+    pl_sb_free(ptStorage->sbtArchetypes);
+    pl_sb_free(ptStorage->sbtRecords);
+    pl_sb_free(ptStorage->sbtEntityGenerations);
+    pl_sb_free(ptStorage->sbtEntityFreeIndices);
+    pl_sb_free(ptStorage->sbtJobChunks);
+    pl_sb_free(ptStorage->sbuHierarchyPasses);
+    PL_FREE(ptStorage);
+    *pptStorage = NULL;
+}
+
+static void
+pl_ecs_archetype_import_library(plArchetypeStorage* ptStorage, plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    PL_ASSERT(pl_sb_size(ptStorage->sbtEntityGenerations) == 0 && "archetype storage must be empty");
+
+    // component set of each entity
+    const uint32_t uSlotCount = pl_sb_size(ptLibrary->sbtEntityGenerations);
+    const plComponentMask* atMasks = ptLibrary->sbtEntitySignatures;
+
+    // same entity handles so references between components stay valid
+    pl_sb_resize(ptStorage->sbtEntityGenerations, uSlotCount);
+    pl_sb_resize(ptStorage->sbtRecords, uSlotCount);
+    for(uint32_t i = 0; i < uSlotCount; i++)
+    {
+        ptStorage->sbtEntityGenerations[i] = ptLibrary->sbtEntityGenerations[i];
+        ptStorage->sbtRecords[i] = (plArchetypeRecord){UINT32_MAX, UINT32_MAX};
+    }
+    for(uint32_t i = uSlotCount; i > 0; i--)
+    {
+        if(atMasks[i - 1] == 0)
+            pl_sb_push(ptStorage->sbtEntityFreeIndices, i - 1);
+    }
+
+    // place entities (archetype order follows first occurrence)
+    for(uint32_t i = 0; i < uSlotCount; i++)
+    {
+        if(atMasks[i] == 0)
+            continue;
+        const plEntity tEntity = {.uIndex = i, .uGeneration = ptLibrary->sbtEntityGenerations[i]};
+        const uint32_t uArchetype = pl__archetype_find_or_create(ptStorage, atMasks[i]);
+        pl__archetype_allocate_row(ptStorage, uArchetype, tEntity);
+    }
+
+    // copy columns manager by manager
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        const unsigned char* pucComponents = ptManager->pComponents;
+        for(uint32_t j = 0; j < pl_sb_size(ptManager->sbtEntities); j++)
+        {
+            const plArchetypeRecord tRecord = ptStorage->sbtRecords[ptManager->sbtEntities[j].uIndex];
+            memcpy(pl__archetype_element(&ptStorage->sbtArchetypes[tRecord.uArchetype], tRecord.uRow, i), &pucComponents[j * ptManager->szStride], gaszComponentSizes[i]);
+        }
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static plEntity
+pl_ecs_archetype_create_entity(plArchetypeStorage* ptStorage, plComponentMask tMask)
+{
+    const plEntity tNewEntity = pl__archetype_claim_entity(ptStorage);
+    const uint32_t uArchetype = pl__archetype_find_or_create(ptStorage, tMask);
+    const uint32_t uRow = pl__archetype_allocate_row(ptStorage, uArchetype, tNewEntity);
+
+    const plArchetype* ptArchetype = &ptStorage->sbtArchetypes[uArchetype];
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        if(tMask & PL_COMPONENT_MASK(i))
+            pl__ecs_init_component(i, pl__archetype_element(ptArchetype, uRow, i));
+    }
+    return tNewEntity;
+}
+
+static bool
+pl_ecs_archetype_is_entity_valid(plArchetypeStorage* ptStorage, plEntity tEntity)
+{
+    if(tEntity.uIndex >= pl_sb_size(ptStorage->sbtEntityGenerations))
+        return false;
+    return ptStorage->sbtEntityGenerations[tEntity.uIndex] == tEntity.uGeneration;
+}
+
+static void
+pl_ecs_archetype_remove_entity(plArchetypeStorage* ptStorage, plEntity tEntity)
+{
+    if(!pl_ecs_archetype_is_entity_valid(ptStorage, tEntity))
+        return;
+
+    const plArchetypeRecord tRecord = ptStorage->sbtRecords[tEntity.uIndex];
+    pl__archetype_free_row(ptStorage, tRecord.uArchetype, tRecord.uRow);
+    ptStorage->sbtRecords[tEntity.uIndex] = (plArchetypeRecord){UINT32_MAX, UINT32_MAX};
+    ptStorage->sbtEntityGenerations[tEntity.uIndex]++;
+    pl_sb_push(ptStorage->sbtEntityFreeIndices, tEntity.uIndex);
+}
+
+static void*
+pl_ecs_archetype_get_component(plArchetypeStorage* ptStorage, plComponentType tType, plEntity tEntity)
+{
+    if(!pl_ecs_archetype_is_entity_valid(ptStorage, tEntity))
+        return NULL;
+
+    const plArchetypeRecord tRecord = ptStorage->sbtRecords[tEntity.uIndex];
+    const plArchetype* ptArchetype = &ptStorage->sbtArchetypes[tRecord.uArchetype];
+    if(!(ptArchetype->tMask & PL_COMPONENT_MASK(tType)))
+        return NULL;
+    return pl__archetype_element(ptArchetype, tRecord.uRow, tType);
+}
+
+static void*
+pl_ecs_archetype_add_component(plArchetypeStorage* ptStorage, plComponentType tType, plEntity tEntity)
+{
+    if(!pl_ecs_archetype_is_entity_valid(ptStorage, tEntity))
+        return NULL;
+
+    const uint32_t uSrcArchetype = ptStorage->sbtRecords[tEntity.uIndex].uArchetype;
+    if(ptStorage->sbtArchetypes[uSrcArchetype].tMask & PL_COMPONENT_MASK(tType))
+    {
+        // match component library behavior (component is reset)
+        void* pComponent = pl_ecs_archetype_get_component(ptStorage, tType, tEntity);
+        pl__ecs_init_component(tType, pComponent);
+        return pComponent;
+    }
+
+    uint32_t uDstArchetype = ptStorage->sbtArchetypes[uSrcArchetype].auAddEdges[tType];
+    if(uDstArchetype == UINT32_MAX)
+    {
+        uDstArchetype = pl__archetype_find_or_create(ptStorage, ptStorage->sbtArchetypes[uSrcArchetype].tMask | PL_COMPONENT_MASK(tType));
+        ptStorage->sbtArchetypes[uSrcArchetype].auAddEdges[tType] = uDstArchetype;
+        ptStorage->sbtArchetypes[uDstArchetype].auRemoveEdges[tType] = uSrcArchetype;
+    }
+    pl__archetype_move_entity(ptStorage, tEntity, uDstArchetype);
+    return pl_ecs_archetype_get_component(ptStorage, tType, tEntity);
+}
+
+static void
+pl_ecs_archetype_remove_component(plArchetypeStorage* ptStorage, plComponentType tType, plEntity tEntity)
+{
+    if(!pl_ecs_archetype_is_entity_valid(ptStorage, tEntity))
+        return;
+
+    const uint32_t uSrcArchetype = ptStorage->sbtRecords[tEntity.uIndex].uArchetype;
+    if(!(ptStorage->sbtArchetypes[uSrcArchetype].tMask & PL_COMPONENT_MASK(tType)))
+        return;
+
+    uint32_t uDstArchetype = ptStorage->sbtArchetypes[uSrcArchetype].auRemoveEdges[tType];
+    if(uDstArchetype == UINT32_MAX)
+    {
+        uDstArchetype = pl__archetype_find_or_create(ptStorage, ptStorage->sbtArchetypes[uSrcArchetype].tMask & ~PL_COMPONENT_MASK(tType));
+        ptStorage->sbtArchetypes[uSrcArchetype].auRemoveEdges[tType] = uDstArchetype;
+        ptStorage->sbtArchetypes[uDstArchetype].auAddEdges[tType] = uSrcArchetype;
+    }
+    pl__archetype_move_entity(ptStorage, tEntity, uDstArchetype);
+}
+
+static void
+pl_ecs_archetype_query_begin(plArchetypeStorage* ptStorage, plComponentMask tRequired, plComponentMask tExcluded, plArchetypeIterator* ptIterator)
+{
+    memset(ptIterator, 0, sizeof(plArchetypeIterator));
+    ptIterator->_ptStorage = ptStorage;
+    ptIterator->_tRequired = tRequired;
+    ptIterator->_tExcluded = tExcluded;
+}
+
+static bool
+pl_ecs_archetype_query_next(plArchetypeIterator* ptIterator)
+{
+    plArchetypeStorage* ptStorage = ptIterator->_ptStorage;
+    while(ptIterator->_uArchetype < pl_sb_size(ptStorage->sbtArchetypes))
+    {
+        const plArchetype* ptArchetype = &ptStorage->sbtArchetypes[ptIterator->_uArchetype];
+        const uint32_t uChunkCount = (ptArchetype->uEntityCount + ptArchetype->uRowsPerChunk - 1) / ptArchetype->uRowsPerChunk;
+        const bool bMatch = (ptArchetype->tMask & ptIterator->_tRequired) == ptIterator->_tRequired && (ptArchetype->tMask & ptIterator->_tExcluded) == 0;
+        if(bMatch && ptIterator->_uChunk < uChunkCount)
+        {
+            const plArchetypeChunk* ptChunk = &ptArchetype->sbtChunks[ptIterator->_uChunk++];
+            ptIterator->uCount = ptChunk->uCount;
+            ptIterator->atEntities = (const plEntity*)ptChunk->pucData;
+            for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+                ptIterator->apColumns[i] = (ptArchetype->tMask & PL_COMPONENT_MASK(i)) ? &ptChunk->pucData[ptArchetype->auColumnOffsets[i]] : NULL;
+            return true;
+        }
+        ptIterator->_uArchetype++;
+        ptIterator->_uChunk = 0;
+    }
+    ptIterator->uCount = 0;
+    return false;
+}
+
+static void
+pl__archetype_gather_chunks(plArchetypeStorage* ptStorage, plComponentMask tRequired)
+{
+    pl_sb_reset(ptStorage->sbtJobChunks);
+    for(uint32_t i = 0; i < pl_sb_size(ptStorage->sbtArchetypes); i++)
+    {
+        plArchetype* ptArchetype = &ptStorage->sbtArchetypes[i];
+        if((ptArchetype->tMask & tRequired) != tRequired)
+            continue;
+        for(uint32_t j = 0; j < pl_sb_size(ptArchetype->sbtChunks); j++)
+        {
+            if(ptArchetype->sbtChunks[j].uCount > 0)
+                pl_sb_push(ptStorage->sbtJobChunks, &ptArchetype->sbtChunks[j]);
+        }
+    }
+}
+
+static void
+pl_run_archetype_transform_update_system(plArchetypeStorage* ptStorage)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plArchetypeIterator tIter = {0};
+    pl_ecs_archetype_query_begin(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM), 0, &tIter);
+    while(pl_ecs_archetype_query_next(&tIter))
+    {
+        plTransformComponent* atTransforms = tIter.apColumns[PL_COMPONENT_TYPE_TRANSFORM];
+        for(uint32_t i = 0; i < tIter.uCount; i++)
+            atTransforms[i].tWorld = pl_rotation_translation_scale(atTransforms[i].tRotation, atTransforms[i].tTranslation, atTransforms[i].tScale);
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_run_archetype_hierarchy_update_system(plArchetypeStorage* ptStorage)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    const uint32_t uEntityCount = pl_sb_size(ptStorage->sbtRecords);
+    while(pl_sb_size(ptStorage->sbuHierarchyPasses) < uEntityCount)
+        pl_sb_push(ptStorage->sbuHierarchyPasses, 0);
+    const uint32_t uPass = ++ptStorage->uHierarchyPass;
+
+    // chunk order says nothing about hierarchy order, so not yet updated ancestors
+    // are walked up & updated first (same as the library's hierarchy pass)
+    const plComponentMask tNodeMask = PL_COMPONENT_MASK(PL_COMPONENT_TYPE_HIERARCHY) | PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM);
+    plArchetypeIterator tIter = {0};
+    pl_ecs_archetype_query_begin(ptStorage, tNodeMask, 0, &tIter);
+    while(pl_ecs_archetype_query_next(&tIter))
+    {
+        const plHierarchyComponent* atHierarchy = tIter.apColumns[PL_COMPONENT_TYPE_HIERARCHY];
+        plTransformComponent* atTransforms = tIter.apColumns[PL_COMPONENT_TYPE_TRANSFORM];
+        for(uint32_t i = 0; i < tIter.uCount; i++)
+        {
+            // transforms of the not yet updated chain, child first, & the
+            // transform its topmost node is parented to (if any)
+            plTransformComponent* atStack[PL_ECS_MAX_HIERARCHY_DEPTH];
+            plTransformComponent* ptTopParent = NULL;
+            uint32_t uDepth = 0;
+            plEntity tCurrent = tIter.atEntities[i];
+            plTransformComponent* ptCurrent = &atTransforms[i];
+            plEntity tParent = atHierarchy[i].tParent;
+            while(ptStorage->sbuHierarchyPasses[tCurrent.uIndex] != uPass && uDepth < PL_ECS_MAX_HIERARCHY_DEPTH)
+            {
+                ptStorage->sbuHierarchyPasses[tCurrent.uIndex] = uPass; // also stops on cycles
+                atStack[uDepth++] = ptCurrent;
+                ptTopParent = NULL;
+
+                if(!pl_ecs_archetype_is_entity_valid(ptStorage, tParent))
+                    break;
+                const plArchetypeRecord tParentRecord = ptStorage->sbtRecords[tParent.uIndex];
+                const plArchetype* ptParentArchetype = &ptStorage->sbtArchetypes[tParentRecord.uArchetype];
+                if(ptParentArchetype->tMask & PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM))
+                    ptTopParent = (plTransformComponent*)pl__archetype_element(ptParentArchetype, tParentRecord.uRow, PL_COMPONENT_TYPE_TRANSFORM);
+                if((ptParentArchetype->tMask & tNodeMask) != tNodeMask)
+                    break;
+                tCurrent = tParent;
+                ptCurrent = ptTopParent;
+                tParent = ((const plHierarchyComponent*)pl__archetype_element(ptParentArchetype, tParentRecord.uRow, PL_COMPONENT_TYPE_HIERARCHY))->tParent;
+            }
+
+            const plTransformComponent* ptParentTransform = ptTopParent;
+            while(uDepth > 0)
+            {
+                plTransformComponent* ptChildTransform = atStack[--uDepth];
+                if(ptParentTransform)
+                    ptChildTransform->tWorld = pl_mul_mat4(&ptParentTransform->tWorld, &ptChildTransform->tWorld);
+                ptParentTransform = ptChildTransform;
+            }
+        }
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl__archetype_object_update_job(uint32_t uJobIndex, void* pData)
+{
+    plArchetypeStorage* ptStorage = pData;
+    const plArchetypeChunk* ptChunk = ptStorage->sbtJobChunks[uJobIndex];
+    const plEntity* atEntities = (const plEntity*)ptChunk->pucData;
+    const plArchetype* ptArchetype = &ptStorage->sbtArchetypes[ptStorage->sbtRecords[atEntities[0].uIndex].uArchetype];
+    const plObjectComponent* atObjects = (const plObjectComponent*)&ptChunk->pucData[ptArchetype->auColumnOffsets[PL_COMPONENT_TYPE_OBJECT]];
+
+    // objects usually reference their own transform & mesh, which live in this chunk
+    plTransformComponent* atTransforms = NULL;
+    plMeshComponent* atMeshes = NULL;
+    if(ptArchetype->tMask & PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM))
+        atTransforms = (plTransformComponent*)&ptChunk->pucData[ptArchetype->auColumnOffsets[PL_COMPONENT_TYPE_TRANSFORM]];
+    if(ptArchetype->tMask & PL_COMPONENT_MASK(PL_COMPONENT_TYPE_MESH))
+        atMeshes = (plMeshComponent*)&ptChunk->pucData[ptArchetype->auColumnOffsets[PL_COMPONENT_TYPE_MESH]];
+
+    for(uint32_t i = 0; i < ptChunk->uCount; i++)
+    {
+        const plObjectComponent* ptObject = &atObjects[i];
+        const plTransformComponent* ptTransform = NULL;
+        plMeshComponent* ptMesh = NULL;
+        if(atTransforms && ptObject->tTransform.ulData == atEntities[i].ulData)
+            ptTransform = &atTransforms[i];
+        else
+            ptTransform = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+        if(atMeshes && ptObject->tMesh.ulData == atEntities[i].ulData)
+            ptMesh = &atMeshes[i];
+        else
+            ptMesh = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_MESH, ptObject->tMesh);
+
+        plMat4 tTransform = ptTransform->tWorld;
+
+        if(ptMesh->tSkinComponent.uIndex != UINT32_MAX)
+        {
+            const plSkinComponent* ptSkinComponent = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+            if(ptSkinComponent)
+            {
+                const plTransformComponent* ptJointComponent = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, ptSkinComponent->sbtJoints[0]);
+                tTransform = pl_mul_mat4(&ptJointComponent->tWorld, &ptSkinComponent->sbtInverseBindMatrices[0]);
+            }
+        }
+
+        pl__ecs_update_mesh_aabb(ptMesh, &tTransform);
+    }
+}
+
+static void
+pl_run_archetype_object_update_system(plArchetypeStorage* ptStorage)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    // one job per chunk
+    pl__archetype_gather_chunks(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_OBJECT));
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__archetype_object_update_job,
+        .pData = ptStorage
+    };
+    pl__ecs_dispatch_batch(pl_sb_size(ptStorage->sbtJobChunks), 0, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_run_archetype_skin_update_system(plArchetypeStorage* ptStorage)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plArchetypeIterator tIter = {0};
+    pl_ecs_archetype_query_begin(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_SKIN), 0, &tIter);
+    while(pl_ecs_archetype_query_next(&tIter))
+    {
+        plSkinComponent* atSkins = tIter.apColumns[PL_COMPONENT_TYPE_SKIN];
+        for(uint32_t i = 0; i < tIter.uCount; i++)
+        {
+            plSkinComponent* ptSkinComponent = &atSkins[i];
+            const plTransformComponent* ptParent = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, ptSkinComponent->tMeshNode);
+            const plMat4 tInverseWorldTransform = pl_mat4_invert(&ptParent->tWorld);
+            for(uint32_t j = 0; j < pl_sb_size(ptSkinComponent->sbtJoints); j++)
+            {
+                const plTransformComponent* ptJointComponent = pl_ecs_archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, ptSkinComponent->sbtJoints[j]);
+                pl__ecs_skin_joint(&tInverseWorldTransform, &ptJointComponent->tWorld, &ptSkinComponent->sbtInverseBindMatrices[j], &ptSkinComponent->sbtTextureData[j * 2]);
+            }
+        }
+    }
+
+    pl_end_profile_sample(0);
+}
@@ -0,0 +1,440 @@
+/*
+   pl_ecs_blend_tree.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] blend trees
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] blend trees
+//-----------------------------------------------------------------------------
+
+static plAnimationBlendTree*
+pl_ecs_create_blend_tree(plComponentLibrary* ptLibrary, uint32_t uJointCount, const plEntity* atJoints)
+{
+    plAnimationBlendTree* ptTree = PL_ALLOC(sizeof(plAnimationBlendTree));
+    memset(ptTree, 0, sizeof(plAnimationBlendTree));
+    ptTree->ptLibrary = ptLibrary;
+    ptTree->uJointCount = uJointCount;
+    pl_sb_resize(ptTree->sbtJoints, uJointCount);
+    pl_sb_resize(ptTree->sbtRestPose, uJointCount);
+    for(uint32_t i = 0; i < uJointCount; i++)
+    {
+        ptTree->sbtJoints[i] = atJoints[i];
+        const plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, atJoints[i]);
+        ptTree->sbtRestPose[i] = (plJointPose){
+            .tRotation    = ptTransform ? ptTransform->tRotation : (plVec4){0.0f, 0.0f, 0.0f, 1.0f},
+            .tTranslation = ptTransform ? ptTransform->tTranslation : (plVec3){0},
+            .tScale       = ptTransform ? ptTransform->tScale : (plVec3){1.0f, 1.0f, 1.0f}
+        };
+    }
+
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    pl_sb_push(ptData->sbtBlendTrees, ptTree);
+    return ptTree;
+}
+
+static void
+pl_ecs_cleanup_blend_tree(plComponentLibrary* ptLibrary, plAnimationBlendTree** pptTree)
+{
+    plAnimationBlendTree* ptTree = *pptTree;
+    if(ptTree == NULL)
+        return;
+
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtBlendTrees); i++)
+    {
+        if(ptData->sbtBlendTrees[i] == ptTree)
+        {
+            pl_sb_del(ptData->sbtBlendTrees, i);
+            break;
+        }
+    }
+
+    for(uint32_t i = 0; i < pl_sb_size(ptTree->sbtNodes); i++)
+    {
+        pl__ecs_free_animation_clip(&ptTree->sbtNodes[i].ptClip);
+        pl_sb_free(ptTree->sbtNodes[i].sbtChannels);
+    }
+    pl_sb_free(ptTree->sbtJoints);
+    pl_sb_free(ptTree->sbtRestPose);
+    pl_sb_free(ptTree->sbtNodes);
+    pl_sb_free(ptTree->sbtPoses);
+    pl_sb_free(ptTree->sbbNeeded);
+    pl_sb_free(ptTree->sbuInputs);
+    pl_sb_free(ptTree->sbtPositions);
+    pl_sb_free(ptTree->sbfWeights);
+    pl_sb_free(ptTree->sbfMasks);
+    PL_FREE(ptTree);
+    *pptTree = NULL;
+}
+
+static uint32_t
+pl__ecs_add_blend_node(plAnimationBlendTree* ptTree, const plBlendNode* ptNode)
+{
+    pl_sb_push(ptTree->sbtNodes, *ptNode);
+    pl_sb_push(ptTree->sbbNeeded, false);
+    pl_sb_add_n(ptTree->sbtPoses, ptTree->uJointCount);
+    return pl_sb_size(ptTree->sbtNodes) - 1;
+}
+
+static uint32_t
+pl_ecs_add_blend_clip(plAnimationBlendTree* ptTree, plEntity tAnimation, float fSpeed, bool bLoop)
+{
+    plComponentLibrary* ptLibrary = ptTree->ptLibrary;
+    const plAnimationComponent* ptAnimation = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tAnimation);
+    PL_ASSERT(ptAnimation && "blend clips need an animation component");
+
+    // private copy of the clip (sampling moves track cursors)
+    plBlendNode tNode = {
+        .tType     = PL_BLEND_NODE_TYPE_CLIP,
+        .ptClip    = pl__ecs_build_animation_clip(ptLibrary, ptAnimation, NULL),
+        .fSpeed    = fSpeed,
+        .fDuration = ptAnimation->fEnd,
+        .bLoop     = bLoop
+    };
+
+    // only channels targeting a joint of this tree are applied
+    for(uint32_t i = 0; i < pl_sb_size(ptAnimation->sbtChannels); i++)
+    {
+        const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[i];
+        if(tNode.ptClip->sbuChannelLanes[i] == UINT32_MAX)
+            continue;
+
+        for(uint32_t j = 0; j < ptTree->uJointCount; j++)
+        {
+            if(ptTree->sbtJoints[j].ulData == ptChannel->tTarget.ulData)
+            {
+                const plBlendChannel tChannel = {
+                    .uJoint = j,
+                    .uLane  = tNode.ptClip->sbuChannelLanes[i],
+                    .tPath  = ptChannel->tPath
+                };
+                pl_sb_push(tNode.sbtChannels, tChannel);
+                break;
+            }
+        }
+    }
+    return pl__ecs_add_blend_node(ptTree, &tNode);
+}
+
+static uint32_t
+pl__ecs_add_blend_space(plAnimationBlendTree* ptTree, plBlendNodeType tType, uint32_t uInputCount, const uint32_t* auInputs, const float* afPositions, const plVec2* atPositions)
+{
+    PL_ASSERT(uInputCount > 0);
+    plBlendNode tNode = {
+        .tType        = tType,
+        .uInputOffset = pl_sb_size(ptTree->sbuInputs),
+        .uInputCount  = uInputCount
+    };
+    for(uint32_t i = 0; i < uInputCount; i++)
+    {
+        PL_ASSERT(auInputs[i] < pl_sb_size(ptTree->sbtNodes) && "blend inputs must be added first");
+        pl_sb_push(ptTree->sbuInputs, auInputs[i]);
+        pl_sb_push(ptTree->sbtPositions, afPositions ? pl_create_vec2(afPositions[i], 0.0f) : atPositions[i]);
+        pl_sb_push(ptTree->sbfWeights, 0.0f);
+    }
+    return pl__ecs_add_blend_node(ptTree, &tNode);
+}
+
+static uint32_t
+pl_ecs_add_blend_space_1d(plAnimationBlendTree* ptTree, uint32_t uInputCount, const uint32_t* auInputs, const float* afPositions)
+{
+    return pl__ecs_add_blend_space(ptTree, PL_BLEND_NODE_TYPE_SPACE_1D, uInputCount, auInputs, afPositions, NULL);
+}
+
+static uint32_t
+pl_ecs_add_blend_space_2d(plAnimationBlendTree* ptTree, uint32_t uInputCount, const uint32_t* auInputs, const plVec2* atPositions)
+{
+    return pl__ecs_add_blend_space(ptTree, PL_BLEND_NODE_TYPE_SPACE_2D, uInputCount, auInputs, NULL, atPositions);
+}
+
+static uint32_t
+pl_ecs_add_blend_layer(plAnimationBlendTree* ptTree, const plBlendLayerDesc* ptDesc)
+{
+    const uint32_t uNodeCount = pl_sb_size(ptTree->sbtNodes);
+    PL_ASSERT(ptDesc->uBase < uNodeCount && ptDesc->uLayer < uNodeCount && "blend inputs must be added first");
+    PL_ASSERT((ptDesc->tMode != PL_BLEND_LAYER_MODE_ADDITIVE || ptDesc->uReference < uNodeCount) && "additive layers need a reference pose");
+
+    plBlendNode tNode = {
+        .tType       = PL_BLEND_NODE_TYPE_LAYER,
+        .tParameter  = {ptDesc->fWeight, 0.0f},
+        .tLayerMode  = ptDesc->tMode,
+        .uBase       = ptDesc->uBase,
+        .uLayer      = ptDesc->uLayer,
+        .uReference  = ptDesc->tMode == PL_BLEND_LAYER_MODE_ADDITIVE ? ptDesc->uReference : UINT32_MAX,
+        .uMaskOffset = UINT32_MAX
+    };
+    if(ptDesc->afMask)
+    {
+        tNode.uMaskOffset = pl_sb_add_n(ptTree->sbfMasks, ptTree->uJointCount);
+        memcpy(&ptTree->sbfMasks[tNode.uMaskOffset], ptDesc->afMask, sizeof(float) * ptTree->uJointCount);
+    }
+    return pl__ecs_add_blend_node(ptTree, &tNode);
+}
+
+static void
+pl_ecs_set_blend_parameter(plAnimationBlendTree* ptTree, uint32_t uNode, plVec2 tValue)
+{
+    ptTree->sbtNodes[uNode].tParameter = tValue;
+}
+
+static void
+pl_ecs_set_blend_clip_time(plAnimationBlendTree* ptTree, uint32_t uNode, float fTime)
+{
+    ptTree->sbtNodes[uNode].fTime = fTime;
+}
+
+static void
+pl__ecs_blend_space_weights(const plBlendNode* ptNode, const plVec2* atPositions, float* afWeights)
+{
+    const uint32_t uCount = ptNode->uInputCount;
+    const plVec2 tValue = ptNode->tParameter;
+    memset(afWeights, 0, sizeof(float) * uCount);
+
+    if(ptNode->tType == PL_BLEND_NODE_TYPE_SPACE_1D)
+    {
+        // positions are ascending, so only the bracketing pair contributes
+        if(tValue.x <= atPositions[0].x)
+        {
+            afWeights[0] = 1.0f;
+            return;
+        }
+        for(uint32_t i = 1; i < uCount; i++)
+        {
+            if(tValue.x <= atPositions[i].x)
+            {
+                const float fT = (tValue.x - atPositions[i - 1].x) / (atPositions[i].x - atPositions[i - 1].x);
+                afWeights[i - 1] = 1.0f - fT;
+                afWeights[i] = fT;
+                return;
+            }
+        }
+        afWeights[uCount - 1] = 1.0f;
+        return;
+    }
+
+    // gradient band interpolation: each sample's influence falls off linearly
+    // toward every other sample, weights are normalized afterwards
+    float fSum = 0.0f;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plVec2 tOffset = pl_sub_vec2(tValue, atPositions[i]);
+        float fWeight = 1.0f;
+        for(uint32_t j = 0; j < uCount; j++)
+        {
+            const plVec2 tEdge = pl_sub_vec2(atPositions[j], atPositions[i]);
+            const float fLengthSq = pl_dot_vec2(tEdge, tEdge);
+            if(j == i || fLengthSq <= 0.0f)
+                continue;
+            fWeight = pl_minf(fWeight, pl_clampf(0.0f, 1.0f - pl_dot_vec2(tOffset, tEdge) / fLengthSq, 1.0f));
+        }
+        afWeights[i] = fWeight;
+        fSum += fWeight;
+    }
+    if(fSum <= 0.0f) // coincident samples
+    {
+        afWeights[0] = 1.0f;
+        return;
+    }
+    for(uint32_t i = 0; i < uCount; i++)
+        afWeights[i] /= fSum;
+}
+
+static void
+pl__ecs_evaluate_blend_tree(plAnimationBlendTree* ptTree, float fDeltaTime)
+{
+    const uint32_t uNodeCount = pl_sb_size(ptTree->sbtNodes);
+    const uint32_t uJointCount = ptTree->uJointCount;
+    if(uNodeCount == 0)
+        return;
+
+    // every clip advances (even unused ones, so they stay in phase)
+    for(uint32_t i = 0; i < uNodeCount; i++)
+    {
+        plBlendNode* ptNode = &ptTree->sbtNodes[i];
+        if(ptNode->tType != PL_BLEND_NODE_TYPE_CLIP)
+            continue;
+        ptNode->fTime += fDeltaTime * ptNode->fSpeed;
+        if(ptNode->bLoop && ptNode->fDuration > 0.0f)
+        {
+            ptNode->fTime = fmodf(ptNode->fTime, ptNode->fDuration);
+            if(ptNode->fTime < 0.0f)
+                ptNode->fTime += ptNode->fDuration;
+        }
+        else
+            ptNode->fTime = pl_clampf(0.0f, ptNode->fTime, ptNode->fDuration);
+    }
+
+    // find nodes contributing to the output (inputs always precede their users)
+    memset(ptTree->sbbNeeded, 0, sizeof(bool) * uNodeCount);
+    ptTree->sbbNeeded[uNodeCount - 1] = true;
+    for(uint32_t i = uNodeCount; i-- > 0;)
+    {
+        const plBlendNode* ptNode = &ptTree->sbtNodes[i];
+        if(!ptTree->sbbNeeded[i])
+            continue;
+
+        if(ptNode->tType == PL_BLEND_NODE_TYPE_SPACE_1D || ptNode->tType == PL_BLEND_NODE_TYPE_SPACE_2D)
+        {
+            float* afWeights = &ptTree->sbfWeights[ptNode->uInputOffset];
+            pl__ecs_blend_space_weights(ptNode, &ptTree->sbtPositions[ptNode->uInputOffset], afWeights);
+            for(uint32_t j = 0; j < ptNode->uInputCount; j++)
+            {
+                if(afWeights[j] > 0.0f)
+                    ptTree->sbbNeeded[ptTree->sbuInputs[ptNode->uInputOffset + j]] = true;
+            }
+        }
+        else if(ptNode->tType == PL_BLEND_NODE_TYPE_LAYER)
+        {
+            ptTree->sbbNeeded[ptNode->uBase] = true;
+            if(ptNode->tParameter.x > 0.0f)
+            {
+                ptTree->sbbNeeded[ptNode->uLayer] = true;
+                if(ptNode->uReference != UINT32_MAX)
+                    ptTree->sbbNeeded[ptNode->uReference] = true;
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < uNodeCount; i++)
+    {
+        if(!ptTree->sbbNeeded[i])
+            continue;
+
+        const plBlendNode* ptNode = &ptTree->sbtNodes[i];
+        plJointPose* atPose = &ptTree->sbtPoses[i * uJointCount];
+
+        if(ptNode->tType == PL_BLEND_NODE_TYPE_CLIP)
+        {
+            memcpy(atPose, ptTree->sbtRestPose, sizeof(plJointPose) * uJointCount);
+            pl__ecs_sample_animation_clip(ptNode->ptClip, ptNode->fTime);
+            const float* afSamples = ptNode->ptClip->sbfSamples;
+            for(uint32_t j = 0; j < pl_sb_size(ptNode->sbtChannels); j++)
+            {
+                const plBlendChannel* ptChannel = &ptNode->sbtChannels[j];
+                const float* pfSample = &afSamples[ptChannel->uLane];
+                plJointPose* ptJoint = &atPose[ptChannel->uJoint];
+                if(ptChannel->tPath == PL_ANIMATION_PATH_TRANSLATION)
+                    ptJoint->tTranslation = pl_create_vec3(pfSample[0], pfSample[1], pfSample[2]);
+                else if(ptChannel->tPath == PL_ANIMATION_PATH_ROTATION)
+                    ptJoint->tRotation = pl_create_vec4(pfSample[0], pfSample[1], pfSample[2], pfSample[3]);
+                else if(ptChannel->tPath == PL_ANIMATION_PATH_SCALE)
+                    ptJoint->tScale = pl_create_vec3(pfSample[0], pfSample[1], pfSample[2]);
+            }
+        }
+
+        else if(ptNode->tType == PL_BLEND_NODE_TYPE_LAYER)
+        {
+            const plJointPose* atBase = &ptTree->sbtPoses[ptNode->uBase * uJointCount];
+            memcpy(atPose, atBase, sizeof(plJointPose) * uJointCount);
+            if(!(ptNode->tParameter.x > 0.0f))
+                continue;
+
+            const plJointPose* atLayer = &ptTree->sbtPoses[ptNode->uLayer * uJointCount];
+            const float* afMask = ptNode->uMaskOffset == UINT32_MAX ? NULL : &ptTree->sbfMasks[ptNode->uMaskOffset];
+            for(uint32_t j = 0; j < uJointCount; j++)
+            {
+                const float fWeight = ptNode->tParameter.x * (afMask ? afMask[j] : 1.0f);
+                if(fWeight <= 0.0f)
+                    continue;
+
+                plJointPose* ptJoint = &atPose[j];
+                if(ptNode->tLayerMode == PL_BLEND_LAYER_MODE_OVERRIDE)
+                {
+                    ptJoint->tTranslation = pl_lerp_vec3(ptJoint->tTranslation, atLayer[j].tTranslation, fWeight);
+                    ptJoint->tScale = pl_lerp_vec3(ptJoint->tScale, atLayer[j].tScale, fWeight);
+                    ptJoint->tRotation = pl_quat_slerp(ptJoint->tRotation, atLayer[j].tRotation, fWeight);
+                }
+                else // additive: layer relative to the reference pose, applied on top of base
+                {
+                    const plJointPose* ptReference = &ptTree->sbtPoses[ptNode->uReference * uJointCount + j];
+                    const plVec4 tInverseReference = {-ptReference->tRotation.x, -ptReference->tRotation.y, -ptReference->tRotation.z, ptReference->tRotation.w};
+                    const plVec4 tDelta = pl_quat_slerp((plVec4){0.0f, 0.0f, 0.0f, 1.0f}, pl_mul_quat(atLayer[j].tRotation, tInverseReference), fWeight);
+                    ptJoint->tRotation = pl_norm_vec4(pl_mul_quat(tDelta, ptJoint->tRotation));
+                    ptJoint->tTranslation = pl_add_vec3(ptJoint->tTranslation, pl_mul_vec3_scalarf(pl_sub_vec3(atLayer[j].tTranslation, ptReference->tTranslation), fWeight));
+                    for(uint32_t k = 0; k < 3; k++)
+                    {
+                        const float fRatio = ptReference->tScale.d[k] != 0.0f ? atLayer[j].tScale.d[k] / ptReference->tScale.d[k] : 1.0f;
+                        ptJoint->tScale.d[k] *= 1.0f + (fRatio - 1.0f) * fWeight;
+                    }
+                }
+            }
+        }
+
+        else // blend spaces: weighted sum (rotations normalized, flipped onto the same hemisphere)
+        {
+            memset(atPose, 0, sizeof(plJointPose) * uJointCount);
+            for(uint32_t k = 0; k < ptNode->uInputCount; k++)
+            {
+                const float fWeight = ptTree->sbfWeights[ptNode->uInputOffset + k];
+                if(fWeight <= 0.0f)
+                    continue;
+
+                const plJointPose* atInput = &ptTree->sbtPoses[ptTree->sbuInputs[ptNode->uInputOffset + k] * uJointCount];
+                for(uint32_t j = 0; j < uJointCount; j++)
+                {
+                    plJointPose* ptJoint = &atPose[j];
+                    const float fSign = pl_dot_vec4(ptJoint->tRotation, atInput[j].tRotation) < 0.0f ? -1.0f : 1.0f;
+                    ptJoint->tRotation = pl_add_vec4(ptJoint->tRotation, pl_mul_vec4_scalarf(atInput[j].tRotation, fWeight * fSign));
+                    ptJoint->tTranslation = pl_add_vec3(ptJoint->tTranslation, pl_mul_vec3_scalarf(atInput[j].tTranslation, fWeight));
+                    ptJoint->tScale = pl_add_vec3(ptJoint->tScale, pl_mul_vec3_scalarf(atInput[j].tScale, fWeight));
+                }
+            }
+            for(uint32_t j = 0; j < uJointCount; j++)
+                atPose[j].tRotation = pl_norm_vec4(atPose[j].tRotation);
+        }
+    }
+}
+
+static void
+pl__blend_tree_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plAnimationBlendTree* ptTree = ptData->sbtBlendTrees[uJobIndex];
+    const uint32_t uNodeCount = pl_sb_size(ptTree->sbtNodes);
+    if(uNodeCount == 0)
+        return;
+
+    pl__ecs_evaluate_blend_tree(ptTree, ptData->fBlendTreeDeltaTime);
+
+    // output is the last node
+    const plJointPose* atPose = &ptTree->sbtPoses[(uNodeCount - 1) * ptTree->uJointCount];
+    for(uint32_t i = 0; i < ptTree->uJointCount; i++)
+    {
+        plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptTree->sbtJoints[i]);
+        if(ptTransform == NULL)
+            continue;
+        ptTransform->tTranslation = atPose[i].tTranslation;
+        ptTransform->tRotation = atPose[i].tRotation;
+        ptTransform->tScale = atPose[i].tScale;
+    }
+}
+
+static void
+pl_run_blend_tree_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    ptData->fBlendTreeDeltaTime = fDeltaTime;
+
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__blend_tree_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(pl_sb_size(ptData->sbtBlendTrees), PL_ECS_BLEND_TREE_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    pl_end_profile_sample(0);
+}
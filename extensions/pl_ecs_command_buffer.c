@@ -0,0 +1,253 @@
+/*
+   pl_ecs_command_buffer.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] command buffers
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] command buffers
+//-----------------------------------------------------------------------------
+
+// entities created by a command buffer are placeholders until playback
+#define PL__ECS_PLACEHOLDER_GENERATION (UINT32_MAX - 1)
+
+static plEcsCommandBuffer*
+pl_ecs_create_command_buffer(plComponentLibrary* ptLibrary)
+{
+    plEcsCommandBuffer* ptBuffer = PL_ALLOC(sizeof(plEcsCommandBuffer));
+    memset(ptBuffer, 0, sizeof(plEcsCommandBuffer));
+    ptBuffer->ptLibrary = ptLibrary;
+    return ptBuffer;
+}
+
+static void
+pl_ecs_cleanup_command_buffer(plEcsCommandBuffer** pptBuffer)
+{
+    plEcsCommandBuffer* ptBuffer = *pptBuffer;
+    if(ptBuffer == NULL)
+        return;
+
+    pl_sb_free(ptBuffer->sbtCommands);
+    pl_sb_free(ptBuffer->sbucData);
+    pl_sb_free(ptBuffer->sbtCreated);
+    PL_FREE(ptBuffer);
+    *pptBuffer = NULL;
+}
+
+static void
+pl_ecs_reset_command_buffer(plEcsCommandBuffer* ptBuffer)
+{
+    pl_sb_reset(ptBuffer->sbtCommands);
+    pl_sb_reset(ptBuffer->sbucData);
+    pl_sb_reset(ptBuffer->sbtCreated);
+    ptBuffer->uCreatedCount = 0;
+}
+
+static plEntity
+pl_ecs_cmd_create_entity(plEcsCommandBuffer* ptBuffer)
+{
+    const plEntity tPlaceholder = {ptBuffer->uCreatedCount++, PL__ECS_PLACEHOLDER_GENERATION};
+    const plEcsCommand tCommand = {
+        .tType   = PL_ECS_COMMAND_TYPE_CREATE_ENTITY,
+        .tEntity = tPlaceholder
+    };
+    pl_sb_push(ptBuffer->sbtCommands, tCommand);
+    return tPlaceholder;
+}
+
+static void
+pl_ecs_cmd_remove_entity(plEcsCommandBuffer* ptBuffer, plEntity tEntity)
+{
+    const plEcsCommand tCommand = {
+        .tType   = PL_ECS_COMMAND_TYPE_REMOVE_ENTITY,
+        .tEntity = tEntity
+    };
+    pl_sb_push(ptBuffer->sbtCommands, tCommand);
+}
+
+static void*
+pl_ecs_cmd_add_component(plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity)
+{
+    // component values are kept 8 byte aligned (they contain pointers)
+    const uint32_t uSize = pl_sb_size(ptBuffer->sbucData);
+    const uint32_t uOffset = (uSize + 7) & ~7u;
+    const uint32_t uAddCount = uOffset + (uint32_t)gaszComponentSizes[tType] - uSize;
+    pl_sb_add_n(ptBuffer->sbucData, uAddCount);
+
+    const plEcsCommand tCommand = {
+        .tType          = PL_ECS_COMMAND_TYPE_ADD_COMPONENT,
+        .tComponentType = tType,
+        .tEntity        = tEntity,
+        .uDataOffset    = uOffset
+    };
+    pl_sb_push(ptBuffer->sbtCommands, tCommand);
+
+    void* pComponent = &ptBuffer->sbucData[uOffset];
+    pl__ecs_init_component(tType, pComponent);
+    return pComponent;
+}
+
+static void
+pl_ecs_cmd_remove_component(plEcsCommandBuffer* ptBuffer, plComponentType tType, plEntity tEntity)
+{
+    const plEcsCommand tCommand = {
+        .tType          = PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT,
+        .tComponentType = tType,
+        .tEntity        = tEntity
+    };
+    pl_sb_push(ptBuffer->sbtCommands, tCommand);
+}
+
+static plEntity
+pl_ecs_resolve_entity(plEcsCommandBuffer* ptBuffer, plEntity tEntity)
+{
+    if(tEntity.uGeneration != PL__ECS_PLACEHOLDER_GENERATION)
+        return tEntity;
+    if(tEntity.uIndex < pl_sb_size(ptBuffer->sbtCreated))
+        return ptBuffer->sbtCreated[tEntity.uIndex];
+    return (plEntity){UINT32_MAX, UINT32_MAX};
+}
+
+static int
+pl__ecs_compare_indices_descending(const void* pA, const void* pB)
+{
+    const uint32_t uA = *(const uint32_t*)pA;
+    const uint32_t uB = *(const uint32_t*)pB;
+    return (uA < uB) - (uA > uB);
+}
+
+static void
+pl__ecs_queue_removal(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint64_t uComponentIndex = pl_hm_lookup(ptLibrary->_ptManagers[tType]->ptHashmap, tEntity.uIndex);
+    if(uComponentIndex == UINT64_MAX)
+        return;
+
+    if(tType == PL_COMPONENT_TYPE_TAG)
+    {
+        const plTagComponent* sbtTags = ptLibrary->tTagComponentManager.pComponents;
+        pl__ecs_remove_tag_name(ptLibrary, sbtTags[uComponentIndex].acName, tEntity.uIndex);
+    }
+    pl_sb_push(ptData->sbuPendingRemovals[tType], (uint32_t)uComponentIndex);
+}
+
+static void
+pl__ecs_flush_removals(plComponentLibrary* ptLibrary, plComponentType tType)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    uint32_t* sbuIndices = ptData->sbuPendingRemovals[tType];
+    const uint32_t uIndexCount = pl_sb_size(sbuIndices);
+    if(uIndexCount == 0)
+        return;
+
+    // highest dense index first, so the last component swapped into each
+    // hole is never one that is still waiting to be removed
+    qsort(sbuIndices, uIndexCount, sizeof(uint32_t), pl__ecs_compare_indices_descending);
+    uint32_t uPreviousIndex = UINT32_MAX;
+    for(uint32_t i = 0; i < uIndexCount; i++)
+    {
+        if(sbuIndices[i] == uPreviousIndex) // removed component & entity in one playback
+            continue;
+        uPreviousIndex = sbuIndices[i];
+        pl__ecs_manager_remove(ptLibrary, tType, sbuIndices[i]);
+    }
+    pl_sb_reset(ptData->sbuPendingRemovals[tType]);
+}
+
+static void
+pl_ecs_playback_command_buffers(plComponentLibrary* ptLibrary, uint32_t uBufferCount, plEcsCommandBuffer** atBuffers)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+
+    for(uint32_t uBufferIndex = 0; uBufferIndex < uBufferCount; uBufferIndex++)
+    {
+        plEcsCommandBuffer* ptBuffer = atBuffers[uBufferIndex];
+        PL_ASSERT(ptBuffer->ptLibrary == ptLibrary);
+        pl_sb_reset(ptBuffer->sbtCreated);
+
+        const uint32_t uCommandCount = pl_sb_size(ptBuffer->sbtCommands);
+        for(uint32_t i = 0; i < uCommandCount; i++)
+        {
+            const plEcsCommand* ptCommand = &ptBuffer->sbtCommands[i];
+            if(ptCommand->tType == PL_ECS_COMMAND_TYPE_CREATE_ENTITY)
+            {
+                pl_sb_push(ptBuffer->sbtCreated, pl_ecs_create_entity(ptLibrary));
+                continue;
+            }
+
+            // commands on entities removed earlier in playback (or stale handles) are dropped
+            const plEntity tEntity = pl_ecs_resolve_entity(ptBuffer, ptCommand->tEntity);
+            if(!pl_ecs_is_entity_valid(ptLibrary, tEntity))
+                continue;
+
+            switch(ptCommand->tType)
+            {
+                case PL_ECS_COMMAND_TYPE_REMOVE_ENTITY:
+                {
+                    // signatures only change on flush (duplicates are skipped there)
+                    plComponentMask tSignature = ptLibrary->sbtEntitySignatures[tEntity.uIndex];
+                    while(tSignature)
+                    {
+                        pl__ecs_queue_removal(ptLibrary, (plComponentType)pl__ecs_ctz64(tSignature), tEntity);
+                        tSignature &= tSignature - 1;
+                    }
+
+                    // slot is only reused after the flush (pending removals still reference it)
+                    ptLibrary->sbtEntityGenerations[tEntity.uIndex]++;
+                    pl_sb_push(ptData->sbuPendingFreeIndices, tEntity.uIndex);
+                    break;
+                }
+
+                case PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT:
+                {
+                    pl__ecs_queue_removal(ptLibrary, ptCommand->tComponentType, tEntity);
+                    break;
+                }
+
+                case PL_ECS_COMMAND_TYPE_ADD_COMPONENT:
+                {
+                    // a removal recorded earlier must not drop the new component
+                    const plComponentType tType = ptCommand->tComponentType;
+                    pl__ecs_flush_removals(ptLibrary, tType);
+
+                    void* pComponent = pl_ecs_get_component(ptLibrary, tType, tEntity);
+                    if(pComponent == NULL)
+                        pComponent = pl_ecs_add_component(ptLibrary, tType, tEntity);
+                    else if(tType == PL_COMPONENT_TYPE_TAG)
+                        pl__ecs_remove_tag_name(ptLibrary, ((plTagComponent*)pComponent)->acName, tEntity.uIndex);
+                    memcpy(pComponent, &ptBuffer->sbucData[ptCommand->uDataOffset], gaszComponentSizes[tType]);
+
+                    if(tType == PL_COMPONENT_TYPE_TAG && ((plTagComponent*)pComponent)->acName[0] != 0)
+                    {
+                        pl_hm_insert(ptLibrary->ptTagHashmap, pl__ecs_tag_key(((plTagComponent*)pComponent)->acName), tEntity.uIndex);
+                        pl__ecs_name_insert(ptData, ((plTagComponent*)pComponent)->acName, tEntity.uIndex);
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+        pl__ecs_flush_removals(ptLibrary, i);
+
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbuPendingFreeIndices); i++)
+        pl_sb_push(ptLibrary->sbtEntityFreeIndices, ptData->sbuPendingFreeIndices[i]);
+    pl_sb_reset(ptData->sbuPendingFreeIndices);
+    pl_end_profile_sample(0);
+}
@@ -5,11 +5,12 @@
 /*
 Index of this file:
 // [SECTION] includes
-// [SECTION] structs
-// [SECTION] global data
-// [SECTION] internal api
 // [SECTION] public api implementations
 // [SECTION] internal api implementations
+// [SECTION] cached queries
+// [SECTION] render extraction
+// [SECTION] fixed timestep
+// [SECTION] unity build
 // [SECTION] extension loading
 */
 
@@ -17,113 +18,7 @@ Index of this file:
 // [SECTION] includes
 //-----------------------------------------------------------------------------
 
-#include <float.h> // FLT_MAX
-#define PL_MATH_INCLUDE_FUNCTIONS
-#include "pl.h"
-#include "pl_ecs_ext.h"
-#include "pl_ds.h"
-#include "pl_math.h"
-#include "pl_profile.h"
-#include "pl_log.h"
-
-// extensions
-#include "pl_job_ext.h"
-#include "pl_script_ext.h"
-#include "pl_ext.inc"
-
-//-----------------------------------------------------------------------------
-// [SECTION] structs
-//-----------------------------------------------------------------------------
-
-typedef struct _plComponentLibraryData
-{
-    plTransformComponent* sbtTransformsCopy; // used for inverse kinematics system
-} plComponentLibraryData;
-
-//-----------------------------------------------------------------------------
-// [SECTION] global data
-//-----------------------------------------------------------------------------
-
-static uint64_t uLogChannelEcs = UINT64_MAX;
-
-//-----------------------------------------------------------------------------
-// [SECTION] internal api
-//-----------------------------------------------------------------------------
-
-// setup/shutdown
-static void     pl_ecs_init_component_library   (plComponentLibrary* ptLibrary);
-static void     pl_ecs_cleanup_component_library(plComponentLibrary* ptLibrary);
-
-// low level (most users shouldn't use this)
-static plEntity pl_ecs_create_entity         (plComponentLibrary* ptLibrary);
-static void     pl_ecs_remove_entity         (plComponentLibrary* ptLibrary, plEntity tEntity);
-static bool     pl_ecs_is_entity_valid       (plComponentLibrary* ptLibrary, plEntity tEntity);
-static plEntity pl_ecs_get_entity            (plComponentLibrary* ptLibrary, const char* pcName);
-static size_t   pl_ecs_get_index             (plComponentManager* ptManager, plEntity tEntity);
-static void*    pl_ecs_get_component         (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
-static void*    pl_ecs_add_component         (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
-
-// components
-static plEntity pl_ecs_create_tag                (plComponentLibrary*, const char* pcName);
-static plEntity pl_ecs_create_mesh               (plComponentLibrary*, const char* pcName, plMeshComponent**);
-static plEntity pl_ecs_create_object             (plComponentLibrary*, const char* pcName, plObjectComponent**);
-static plEntity pl_ecs_create_transform          (plComponentLibrary*, const char* pcName, plTransformComponent**);
-static plEntity pl_ecs_create_material           (plComponentLibrary*, const char* pcName, plMaterialComponent**);
-static plEntity pl_ecs_create_skin               (plComponentLibrary*, const char* pcName, plSkinComponent**);
-static plEntity pl_ecs_create_animation          (plComponentLibrary*, const char* pcName, plAnimationComponent**);
-static plEntity pl_ecs_create_animation_data     (plComponentLibrary*, const char* pcName, plAnimationDataComponent**);
-static plEntity pl_ecs_create_perspective_camera (plComponentLibrary*, const char* pcName, plVec3 tPos, float fYFov, float fAspect, float fNearZ, float fFarZ, plCameraComponent**);
-static plEntity pl_ecs_create_orthographic_camera(plComponentLibrary*, const char* pcName, plVec3 tPos, float fWidth, float fHeight, float fNearZ, float fFarZ, plCameraComponent**);
-static plEntity pl_ecs_create_directional_light  (plComponentLibrary*, const char* pcName, plVec3 tDirection, plLightComponent**);
-static plEntity pl_ecs_create_point_light        (plComponentLibrary*, const char* pcName, plVec3 tPosition, plLightComponent**);
-static plEntity pl_ecs_create_script             (plComponentLibrary*, const char* pcFile, plScriptFlags, plScriptComponent**);
-static void     pl_ecs_attach_script             (plComponentLibrary*, const char* pcFile, plScriptFlags, plEntity, plScriptComponent**);
-
-
-// heirarchy
-static void pl_ecs_attach_component (plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent);
-static void pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity);
-
-// update systems
-static void pl_run_object_update_system            (plComponentLibrary* ptLibrary);
-static void pl_run_transform_update_system         (plComponentLibrary* ptLibrary);
-static void pl_run_skin_update_system              (plComponentLibrary* ptLibrary);
-static void pl_run_hierarchy_update_system         (plComponentLibrary* ptLibrary);
-static void pl_run_animation_update_system         (plComponentLibrary* ptLibrary, float fDeltaTime);
-static void pl_run_inverse_kinematics_update_system(plComponentLibrary* ptLibrary);
-static void pl_run_script_update_system            (plComponentLibrary* ptLibrary);
-
-// misc.
-static void pl_calculate_normals (plMeshComponent* atMeshes, uint32_t uComponentCount);
-static void pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount);
-
-// camera
-static void pl_camera_set_fov        (plCameraComponent* ptCamera, float fYFov);
-static void pl_camera_set_clip_planes(plCameraComponent* ptCamera, float fNearZ, float fFarZ);
-static void pl_camera_set_aspect     (plCameraComponent* ptCamera, float fAspect);
-static void pl_camera_set_pos        (plCameraComponent* ptCamera, float fX, float fY, float fZ);
-static void pl_camera_set_pitch_yaw  (plCameraComponent* ptCamera, float fPitch, float fYaw);
-static void pl_camera_translate      (plCameraComponent* ptCamera, float fDx, float fDy, float fDz);
-static void pl_camera_rotate         (plCameraComponent* ptCamera, float fDPitch, float fDYaw);
-static void pl_camera_update         (plCameraComponent* ptCamera);
-static void pl_camera_look_at        (plCameraComponent* ptCamera, plVec3 tEye, plVec3 tTarget);
-
-static inline float
-pl__wrap_angle(float tTheta)
-{
-    static const float f2Pi = 2.0f * PL_PI;
-    const float fMod = fmodf(tTheta, f2Pi);
-    if (fMod > PL_PI)       return fMod - f2Pi;
-    else if (fMod < -PL_PI) return fMod + f2Pi;
-    return fMod;
-}
-
-static inline bool
-pl_ecs_has_entity(plComponentManager* ptManager, plEntity tEntity)
-{
-    PL_ASSERT(tEntity.uIndex != UINT32_MAX);
-    return pl_hm_has_key(ptManager->ptHashmap, tEntity.uIndex);
-}
+#include "pl_ecs_internal.h"
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal api implementation
@@ -196,6 +91,13 @@ pl_ecs_init_component_library(plComponentLibrary* ptLibrary)
     ptLibrary->pInternal = PL_ALLOC(sizeof(plComponentLibraryData));
     memset(ptLibrary->pInternal, 0, sizeof(plComponentLibraryData));
 
+    // queries used by systems
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plComponentType atObjectQuery[] = {PL_COMPONENT_TYPE_OBJECT, PL_COMPONENT_TYPE_TRANSFORM, PL_COMPONENT_TYPE_MESH};
+    const plComponentType atHierarchyQuery[] = {PL_COMPONENT_TYPE_HIERARCHY, PL_COMPONENT_TYPE_TRANSFORM};
+    ptData->ptObjectQuery = pl_ecs_create_query(ptLibrary, 3, atObjectQuery);
+    ptData->ptHierarchyQuery = pl_ecs_create_query(ptLibrary, 2, atHierarchyQuery);
+
     pl_log_info(uLogChannelEcs, "initialized component library");
 }
 
@@ -211,6 +113,7 @@ pl_ecs_cleanup_component_library(plComponentLibrary* ptLibrary)
     {
         pl_sb_free(sbtAnimations[i].sbtChannels);
         pl_sb_free(sbtAnimations[i].sbtSamplers);
+        pl__ecs_free_animation_clip(&sbtAnimations[i]._ptClip);
     }
 
     for(uint32_t i = 0; i < pl_sb_size(sbtAnimationDatas); i++)
@@ -256,11 +159,69 @@ pl_ecs_cleanup_component_library(plComponentLibrary* ptLibrary)
     }
 
     plComponentLibraryData* ptData = ptLibrary->pInternal;
-    pl_sb_free(ptData->sbtTransformsCopy);
+    pl_sb_free(ptData->sbtTransformCache);
+    pl_sb_free(ptData->sbuTransformChanged);
+    pl_sb_free(ptData->sbuTransformForce);
+    pl_sb_free(ptData->sbuHierarchyPasses);
+    pl_sb_free(ptData->sbtObjectCache);
+    pl_sb_free(ptData->sbuObjectChanged);
+    pl_sb_free(ptData->sbuObjectForce);
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtSkinCache); i++)
+    {
+        pl_sb_free(ptData->sbtSkinCache[i].sbuJoints);
+    }
+    pl_sb_free(ptData->sbtSkinCache);
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtIKChains); i++)
+    {
+        pl_sb_free(ptData->sbtIKChains[i].sbtJoints);
+        pl_sb_free(ptData->sbtIKChains[i].sbuJoints);
+    }
+    pl_sb_free(ptData->sbtIKChains);
+    pl_sb_free(ptData->sbuIKSolveList);
+    pl_sb_free(ptData->sbuIKMarks);
+    pl_sb_free(ptData->sbuIKChangedCopy);
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtSkinnedMeshes); i++)
+    {
+        pl_sb_free(ptData->sbtSkinnedMeshes[i].sbtVertexPositions);
+        pl_sb_free(ptData->sbtSkinnedMeshes[i].sbtVertexData);
+    }
+    pl_sb_free(ptData->sbtSkinnedMeshes);
+    pl_sb_free(ptData->sbuSkinnedMeshIndices);
+    pl_sb_free(ptData->sbtScriptPlaying);
+    pl_sb_free(ptData->sbuScriptWaves);
+    pl_sb_free(ptData->sbtScriptSchedule);
+    pl_sb_free(ptData->sbuScriptWaveStarts);
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbptScriptBuffers); i++)
+    {
+        pl_ecs_cleanup_command_buffer(&ptData->sbptScriptBuffers[i]);
+    }
+    pl_sb_free(ptData->sbptScriptBuffers);
+    pl_sb_free(ptData->sbtAnimationSamples);
+    pl_sb_free(ptData->sbuAnimationSampleOffsets);
+    pl_sb_free(ptData->sbbAnimationActive);
+    pl_sb_free(ptData->sbuAnimationTargetMarks);
+    pl_sb_free(ptData->sbuPendingFreeIndices);
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        pl_sb_free(ptData->sbuPendingRemovals[i]);
+    }
+    pl_ecs_cleanup_query(ptLibrary, &ptData->ptObjectQuery);
+    pl_ecs_cleanup_query(ptLibrary, &ptData->ptHierarchyQuery);
+    PL_ASSERT(pl_sb_size(ptData->sbtQueries) == 0 && "queries must be cleaned up before the library");
+    pl_sb_free(ptData->sbtQueries);
+    PL_ASSERT(pl_sb_size(ptData->sbtBlendTrees) == 0 && "blend trees must be cleaned up before the library");
+    pl_sb_free(ptData->sbtBlendTrees);
+    pl_sb_free(ptData->sbtNameNodes);
+    pl_sb_free(ptData->sbtNameLeaves);
+    pl_sb_free(ptData->sbuFreeNameNodes);
+    pl_sb_free(ptData->sbuFreeNameLeaves);
+    pl_sb_free(ptData->sbcNames);
+    pl_sb_free(ptData->sbtFixedPrevious);
 
     // general
     pl_sb_free(ptLibrary->sbtEntityFreeIndices);
     pl_sb_free(ptLibrary->sbtEntityGenerations);
+    pl_sb_free(ptLibrary->sbtEntitySignatures);
     pl_hm_free(ptLibrary->ptTagHashmap);
     PL_FREE(ptLibrary->pInternal);
     ptLibrary->pInternal = NULL;
@@ -279,6 +240,7 @@ pl_ecs_create_entity(plComponentLibrary* ptLibrary)
     {
         tNewEntity.uIndex = pl_sb_size(ptLibrary->sbtEntityGenerations);
         pl_sb_push(ptLibrary->sbtEntityGenerations, 0);
+        pl_sb_push(ptLibrary->sbtEntitySignatures, 0);
     }
     return tNewEntity;
 }
@@ -293,132 +255,38 @@ pl_ecs_remove_entity(plComponentLibrary* ptLibrary, plEntity tEntity)
     plTagComponent* ptTag = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TAG, tEntity);
     if(ptTag)
     {
-        pl_hm_remove_str(ptLibrary->ptTagHashmap, ptTag->acName);
+        pl__ecs_remove_tag_name(ptLibrary, ptTag->acName, tEntity.uIndex);
     }
 
     ptLibrary->sbtEntityGenerations[tEntity.uIndex]++;
 
-    // remove from individual managers
-    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    // remove from owning managers only
+    plComponentMask tSignature = ptLibrary->sbtEntitySignatures[tEntity.uIndex];
+    while(tSignature)
     {
-        if(pl_hm_has_key(ptLibrary->_ptManagers[i]->ptHashmap, tEntity.uIndex))
-        {
-            pl_hm_remove(ptLibrary->_ptManagers[i]->ptHashmap, tEntity.uIndex);
-            const uint64_t uEntityValue = pl_hm_get_free_index(ptLibrary->_ptManagers[i]->ptHashmap);
-            
-
-            // must keep valid entities contiguous (move last entity into removed slot)
-            if(pl_sb_size(ptLibrary->_ptManagers[i]->sbtEntities) > 1)
-            {
-                plEntity tLastEntity = pl_sb_back(ptLibrary->_ptManagers[i]->sbtEntities);
-                pl_hm_remove(ptLibrary->_ptManagers[i]->ptHashmap, tLastEntity.uIndex);
-                pl_hm_get_free_index(ptLibrary->_ptManagers[i]->ptHashmap); // burn slot
-                pl_hm_insert(ptLibrary->_ptManagers[i]->ptHashmap, tLastEntity.uIndex, uEntityValue);
-            }
-
-            pl_sb_del_swap(ptLibrary->_ptManagers[i]->sbtEntities, uEntityValue);
-            switch(i)
-            {
-                case PL_COMPONENT_TYPE_TAG:
-                {
-                    plTagComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_TRANSFORM:
-                {
-                    plTransformComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_MESH:
-                {
-                    plMeshComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_OBJECT:
-                {
-                    plObjectComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_HIERARCHY:
-                {
-                    plHierarchyComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_MATERIAL:
-                {
-                    plMaterialComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_SKIN:
-                {
-                    plSkinComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_CAMERA:
-                {
-                    plCameraComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_ANIMATION:
-                {
-                    plAnimationComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_ANIMATION_DATA:
-                {
-                    plAnimationDataComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-
-                case PL_COMPONENT_TYPE_INVERSE_KINEMATICS:
-                {
-                    plInverseKinematicsComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
+        const plComponentType tType = (plComponentType)pl__ecs_ctz64(tSignature);
+        tSignature &= tSignature - 1;
+        const uint64_t uComponentIndex = pl_hm_lookup(ptLibrary->_ptManagers[tType]->ptHashmap, tEntity.uIndex);
+        pl__ecs_manager_remove(ptLibrary, tType, (uint32_t)uComponentIndex);
+    }
+}
 
-                case PL_COMPONENT_TYPE_LIGHT:
-                {
-                    plLightComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
+static void
+pl_ecs_remove_component(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity)
+{
+    if(!pl_ecs_is_entity_valid(ptLibrary, tEntity))
+        return;
 
-                case PL_COMPONENT_TYPE_SCRIPT:
-                {
-                    plScriptComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
+    const uint64_t uComponentIndex = pl_hm_lookup(ptLibrary->_ptManagers[tType]->ptHashmap, tEntity.uIndex);
+    if(uComponentIndex == UINT64_MAX)
+        return;
 
-                case PL_COMPONENT_TYPE_HUMANOID:
-                {
-                    plHumanoidComponent* sbComponents = ptLibrary->_ptManagers[i]->pComponents;
-                    pl_sb_del_swap(sbComponents, uEntityValue);
-                    break;
-                }
-            }
-        }
+    if(tType == PL_COMPONENT_TYPE_TAG)
+    {
+        plTagComponent* ptTag = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TAG, tEntity);
+        pl__ecs_remove_tag_name(ptLibrary, ptTag->acName, tEntity.uIndex);
     }
+    pl__ecs_manager_remove(ptLibrary, tType, (uint32_t)uComponentIndex);
 }
 
 static bool
@@ -429,10 +297,75 @@ pl_ecs_is_entity_valid(plComponentLibrary* ptLibrary, plEntity tEntity)
     return ptLibrary->sbtEntityGenerations[tEntity.uIndex] == tEntity.uGeneration;
 }
 
+static plComponentMask
+pl_ecs_get_signature(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    if(tEntity.uIndex >= pl_sb_size(ptLibrary->sbtEntitySignatures))
+        return 0;
+    if(ptLibrary->sbtEntityGenerations[tEntity.uIndex] != tEntity.uGeneration)
+        return 0;
+    return ptLibrary->sbtEntitySignatures[tEntity.uIndex];
+}
+
+static bool
+pl_ecs_has_component(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity)
+{
+    return (pl_ecs_get_signature(ptLibrary, tEntity) & PL_COMPONENT_MASK(tType)) != 0;
+}
+
+static uint32_t
+pl_ecs_get_entities_with(plComponentLibrary* ptLibrary, plComponentMask tRequired, plComponentMask tExcluded, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    if(atEntitiesOut == NULL)
+        uMaxEntities = 0;
+
+    const plComponentMask* atSignatures = ptLibrary->sbtEntitySignatures;
+    uint32_t uFound = 0;
+
+    if(tRequired == 0)
+    {
+        const uint32_t uSlotCount = pl_sb_size(atSignatures);
+        for(uint32_t i = 0; i < uSlotCount; i++)
+        {
+            // free slots own nothing (but neither do live entities without components)
+            if(atSignatures[i] == 0 || (atSignatures[i] & tExcluded))
+                continue;
+            if(uFound < uMaxEntities)
+                atEntitiesOut[uFound] = (plEntity){.uIndex = i, .uGeneration = ptLibrary->sbtEntityGenerations[i]};
+            uFound++;
+        }
+        return uFound;
+    }
+
+    // smallest required manager drives the walk
+    const plComponentManager* ptManager = NULL;
+    plComponentMask tTypes = tRequired;
+    while(tTypes)
+    {
+        const plComponentManager* ptCandidate = ptLibrary->_ptManagers[pl__ecs_ctz64(tTypes)];
+        tTypes &= tTypes - 1;
+        if(ptManager == NULL || pl_sb_size(ptCandidate->sbtEntities) < pl_sb_size(ptManager->sbtEntities))
+            ptManager = ptCandidate;
+    }
+
+    const uint32_t uEntityCount = pl_sb_size(ptManager->sbtEntities);
+    for(uint32_t i = 0; i < uEntityCount; i++)
+    {
+        const plEntity tEntity = ptManager->sbtEntities[i];
+        const plComponentMask tSignature = atSignatures[tEntity.uIndex];
+        if((tSignature & tRequired) != tRequired || (tSignature & tExcluded))
+            continue;
+        if(uFound < uMaxEntities)
+            atEntitiesOut[uFound] = tEntity;
+        uFound++;
+    }
+    return uFound;
+}
+
 static plEntity
 pl_ecs_get_entity(plComponentLibrary* ptLibrary, const char* pcName)
 {
-    const uint64_t ulHash = pl_hm_hash_str(pcName);
+    const uint64_t ulHash = pl__ecs_tag_key(pcName);
     if(pl_hm_has_key(ptLibrary->ptTagHashmap, ulHash))
     {
         uint64_t uIndex = pl_hm_lookup(ptLibrary->ptTagHashmap, ulHash);
@@ -460,6 +393,10 @@ pl_ecs_get_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
     if(ptManager->ptParentLibrary->sbtEntityGenerations[tEntity.uIndex] != tEntity.uGeneration)
         return NULL;
 
+    // misses never reach the hashmap
+    if(!(ptManager->ptParentLibrary->sbtEntitySignatures[tEntity.uIndex] & PL_COMPONENT_MASK(tType)))
+        return NULL;
+
     size_t szIndex = pl_ecs_get_index(ptManager, tEntity);
 
     if(szIndex == UINT64_MAX)
@@ -469,6 +406,152 @@ pl_ecs_get_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
     return &pucData[szIndex * ptManager->szStride];
 }
 
+static void
+pl__ecs_init_component(plComponentType tType, void* pComponent)
+{
+    switch(tType)
+    {
+    case PL_COMPONENT_TYPE_TAG:
+    {
+        plTagComponent* ptComponent = pComponent;
+        *ptComponent = (plTagComponent){0};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_MESH:
+    {
+        plMeshComponent* ptComponent = pComponent;
+        *ptComponent = (plMeshComponent){.tSkinComponent = {UINT32_MAX, UINT32_MAX}};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_TRANSFORM:
+    {
+        plTransformComponent* ptComponent = pComponent;
+        *ptComponent = (plTransformComponent){.tWorld = pl_identity_mat4(), .tScale = {1.0f, 1.0f, 1.0f}, .tRotation = {0.0f, 0.0f, 0.0f, 1.0f}};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_OBJECT:
+    {
+        plObjectComponent* ptComponent = pComponent;
+        *ptComponent = (plObjectComponent){.tMesh= {UINT32_MAX, UINT32_MAX}, .tTransform ={UINT32_MAX, UINT32_MAX}};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_HIERARCHY:
+    {
+        plHierarchyComponent* ptComponent = pComponent;
+        *ptComponent = (plHierarchyComponent){0};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_MATERIAL:
+    {
+        plMaterialComponent* ptComponent = pComponent;
+        *ptComponent = (plMaterialComponent){
+            .tBlendMode            = PL_BLEND_MODE_OPAQUE,
+            .tFlags                = PL_MATERIAL_FLAG_NONE,
+            .tShaderType           = PL_SHADER_TYPE_PBR,
+            .tBaseColor            = {1.0f, 1.0f, 1.0f, 1.0f},
+            .tEmissiveColor        = {0.0f, 0.0f, 0.0f, 0.0f},
+            .fRoughness            = 1.0f,
+            .fMetalness            = 1.0f,
+            .fNormalMapStrength    = 1.0f,
+            .fOcclusionMapStrength = 1.0f,
+            .fAlphaCutoff          = 0.5f,
+            .atTextureMaps         = {0}
+        };
+        for(uint32_t i = 0; i < PL_TEXTURE_SLOT_COUNT; i++)
+        {
+            ptComponent->atTextureMaps[i].tResource.uIndex = UINT32_MAX;
+            ptComponent->atTextureMaps[i].tResource.uGeneration = UINT32_MAX;
+        }
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_SKIN:
+    {
+        plSkinComponent* ptComponent = pComponent;
+        *ptComponent = (plSkinComponent){.tMeshNode = {UINT32_MAX, UINT32_MAX}};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_CAMERA:
+    {
+        plCameraComponent* ptComponent = pComponent;
+        *ptComponent = (plCameraComponent){0};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_ANIMATION:
+    {
+        plAnimationComponent* ptComponent = pComponent;
+        *ptComponent = (plAnimationComponent){
+            .fSpeed       = 1.0f,
+            .fBlendAmount = 1.0f
+        };
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_ANIMATION_DATA:
+    {
+        plAnimationDataComponent* ptComponent = pComponent;
+        *ptComponent = (plAnimationDataComponent){0};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_INVERSE_KINEMATICS:
+    {
+        plInverseKinematicsComponent* ptComponent = pComponent;
+        *ptComponent = (plInverseKinematicsComponent){.bEnabled = true, .tTarget = UINT32_MAX, .uIterationCount = 1, .tSolver = PL_IK_SOLVER_CCD, .fTolerance = 0.001f};
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_LIGHT:
+    {
+        plLightComponent* ptComponent = pComponent;
+        *ptComponent = (plLightComponent){
+            .tPosition           = {0.0f, 0.0f, 0.0f},
+            .tColor              = {1.0f, 1.0f, 1.0f},
+            .tDirection          = {0.0f, -1.0f, 0.0f},
+            .fIntensity          = 1.0f,
+            .fRange              = 10.0f,
+            .tType               = PL_LIGHT_TYPE_DIRECTIONAL,
+            .uCascadeCount       = 0,
+            .tFlags              = 0,
+            .afCascadeSplits     = {0}
+        };
+        for(uint32_t i = 0; i < PL_MAX_SHADOW_CASCADES; i++)
+            ptComponent->afCascadeSplits[i] = 8 * powf(10.0f, (float)i);
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_SCRIPT:
+    {
+        plScriptComponent* ptComponent = pComponent;
+        *ptComponent = (plScriptComponent){
+            .tFlags = PL_SCRIPT_FLAG_NONE,
+            .acFile = {0}
+        };
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_HUMANOID:
+    {
+        plHumanoidComponent* ptComponent = pComponent;
+        *ptComponent = (plHumanoidComponent){
+            .atBones = {0}
+        };
+        for(uint32_t i = 0; i < PL_HUMANOID_BONE_COUNT; i++)
+        {
+            ptComponent->atBones[i].ulData = UINT64_MAX;
+        }
+        break;
+    }
+    }
+}
+
 static void*
 pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity)
 {
@@ -489,6 +572,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         bAddSlot = true;
     }
     pl_hm_insert(ptManager->ptHashmap, (uint64_t)tEntity.uIndex, uComponentIndex);
+    ptLibrary->sbtEntitySignatures[tEntity.uIndex] |= PL_COMPONENT_MASK(tType);
 
     ptManager->sbtEntities[uComponentIndex] = tEntity;
     switch (ptManager->tComponentType)
@@ -499,8 +583,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plTagComponent){0};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_MESH:
@@ -509,8 +592,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plMeshComponent){.tSkinComponent = {UINT32_MAX, UINT32_MAX}};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_TRANSFORM:
@@ -519,8 +601,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plTransformComponent){.tWorld = pl_identity_mat4(), .tScale = {1.0f, 1.0f, 1.0f}, .tRotation = {0.0f, 0.0f, 0.0f, 1.0f}};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_OBJECT:
@@ -529,8 +610,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plObjectComponent){.tMesh= {UINT32_MAX, UINT32_MAX}, .tTransform ={UINT32_MAX, UINT32_MAX}};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_HIERARCHY:
@@ -539,8 +619,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plHierarchyComponent){0};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_MATERIAL:
@@ -549,25 +628,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plMaterialComponent){
-            .tBlendMode            = PL_BLEND_MODE_OPAQUE,
-            .tFlags                = PL_MATERIAL_FLAG_NONE,
-            .tShaderType           = PL_SHADER_TYPE_PBR,
-            .tBaseColor            = {1.0f, 1.0f, 1.0f, 1.0f},
-            .tEmissiveColor        = {0.0f, 0.0f, 0.0f, 0.0f},
-            .fRoughness            = 1.0f,
-            .fMetalness            = 1.0f,
-            .fNormalMapStrength    = 1.0f,
-            .fOcclusionMapStrength = 1.0f,
-            .fAlphaCutoff          = 0.5f,
-            .atTextureMaps         = {0}
-        };
-        for(uint32_t i = 0; i < PL_TEXTURE_SLOT_COUNT; i++)
-        {
-            sbComponents[uComponentIndex].atTextureMaps[i].tResource.uIndex = UINT32_MAX;
-            sbComponents[uComponentIndex].atTextureMaps[i].tResource.uGeneration = UINT32_MAX;
-        }
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_SKIN:
@@ -576,8 +637,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plSkinComponent){.tMeshNode = {UINT32_MAX, UINT32_MAX}};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_CAMERA:
@@ -586,8 +646,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plCameraComponent){0};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_ANIMATION:
@@ -596,11 +655,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plAnimationComponent){
-            .fSpeed       = 1.0f,
-            .fBlendAmount = 1.0f
-        };
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_ANIMATION_DATA:
@@ -609,8 +664,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plAnimationDataComponent){0};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_INVERSE_KINEMATICS:
@@ -619,8 +673,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plInverseKinematicsComponent){.bEnabled = true, .tTarget = UINT32_MAX, .uIterationCount = 1};
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_LIGHT:
@@ -629,20 +682,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plLightComponent){
-            .tPosition           = {0.0f, 0.0f, 0.0f},
-            .tColor              = {1.0f, 1.0f, 1.0f},
-            .tDirection          = {0.0f, -1.0f, 0.0f},
-            .fIntensity          = 1.0f,
-            .fRange              = 10.0f,
-            .tType               = PL_LIGHT_TYPE_DIRECTIONAL,
-            .uCascadeCount       = 0,
-            .tFlags              = 0,
-            .afCascadeSplits     = {0}
-        };
-        for(uint32_t i = 0; i < PL_MAX_SHADOW_CASCADES; i++)
-            sbComponents[uComponentIndex].afCascadeSplits[i] = 8 * powf(10.0f, (float)i);
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_SCRIPT:
@@ -651,11 +691,7 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plScriptComponent){
-            .tFlags = PL_SCRIPT_FLAG_NONE,
-            .acFile = {0}
-        };
-        return &sbComponents[uComponentIndex];
+        break;
     }
 
     case PL_COMPONENT_TYPE_HUMANOID:
@@ -664,19 +700,16 @@ pl_ecs_add_component(plComponentLibrary* ptLibrary, plComponentType tType, plEnt
         if(bAddSlot)
             pl_sb_add(sbComponents);
         ptManager->pComponents = sbComponents;
-        sbComponents[uComponentIndex] = (plHumanoidComponent){
-            .atBones = {0}
-        };
-        for(uint32_t i = 0; i < PL_HUMANOID_BONE_COUNT; i++)
-        {
-            sbComponents[uComponentIndex].atBones[i].ulData = UINT64_MAX;
-        }
-        return &sbComponents[uComponentIndex];
+        break;
     }
-
     }
 
-    return NULL;
+    unsigned char* pucData = ptManager->pComponents;
+    void* pComponent = &pucData[uComponentIndex * ptManager->szStride];
+    pl__ecs_init_component(ptManager->tComponentType, pComponent);
+    pl__ecs_query_on_add(ptLibrary, tType, tEntity, (uint32_t)uComponentIndex);
+    pl__ecs_mark_changed(ptLibrary, tType, (uint32_t)uComponentIndex);
+    return pComponent;
 }
 
 static plEntity
@@ -691,7 +724,8 @@ pl_ecs_create_tag(plComponentLibrary* ptLibrary, const char* pcName)
         strncpy(ptTag->acName, "unnamed", PL_MAX_NAME_LENGTH);
 
     if(pcName)
-        pl_hm_insert_str(ptLibrary->ptTagHashmap, pcName, tNewEntity.uIndex);
+        pl_hm_insert(ptLibrary->ptTagHashmap, pl__ecs_tag_key(pcName), tNewEntity.uIndex);
+    pl__ecs_name_insert(ptLibrary->pInternal, ptTag->acName, tNewEntity.uIndex);
 
 
     return tNewEntity;
@@ -740,31 +774,30 @@ pl_ecs_create_point_light(plComponentLibrary* ptLibrary, const char* pcName, plV
     return tNewEntity;
 }
 
-static plEntity
-pl_ecs_create_script(plComponentLibrary* ptLibrary, const char* pcFile, plScriptFlags tFlags, plScriptComponent** pptCompOut)
+// loads the script's extension & finds its api (by name)
+static const plScriptI*
+pl__ecs_load_script(const char* pcFile, plScriptFlags tFlags)
 {
-    pl_log_debug_f(uLogChannelEcs, "created script: '%s'", pcFile);
-    plEntity tNewEntity = pl_ecs_create_tag(ptLibrary, pcFile);
+    gptExtensionRegistry->load(pcFile, "pl_load_script", "pl_unload_script", tFlags & PL_SCRIPT_FLAG_RELOADABLE);
+
+    const plScriptI* ptScriptApi = gptApiRegistry->first(PL_API_SCRIPT);
+    while(ptScriptApi && strncmp(pcFile, ptScriptApi->name(), PL_MAX_NAME_LENGTH) != 0)
+        ptScriptApi = gptApiRegistry->next(ptScriptApi);
+    PL_ASSERT(ptScriptApi);
+    return ptScriptApi;
+}
+
+static plEntity
+pl_ecs_create_script(plComponentLibrary* ptLibrary, const char* pcFile, plScriptFlags tFlags, plScriptComponent** pptCompOut)
+{
+    pl_log_debug_f(uLogChannelEcs, "created script: '%s'", pcFile);
+    plEntity tNewEntity = pl_ecs_create_tag(ptLibrary, pcFile);
     plScriptComponent* ptScript =  pl_ecs_add_component(ptLibrary, PL_COMPONENT_TYPE_SCRIPT, tNewEntity);
     ptScript->tFlags = tFlags;
     strncpy(ptScript->acFile, pcFile, PL_MAX_NAME_LENGTH);
 
-    gptExtensionRegistry->load(pcFile, "pl_load_script", "pl_unload_script", tFlags & PL_SCRIPT_FLAG_RELOADABLE);
-
-    const plScriptI* ptScriptApi = gptApiRegistry->first(PL_API_SCRIPT);
-    if(strncmp(pcFile, ptScriptApi->name(), PL_MAX_NAME_LENGTH) != 0)
-    {
-        while(ptScriptApi)
-        {
-            ptScriptApi = gptApiRegistry->next(ptScriptApi);
-            if(strncmp(pcFile, ptScriptApi->name(), PL_MAX_NAME_LENGTH) == 0)
-            {
-                break;
-            }
-        }
-    }
+    const plScriptI* ptScriptApi = pl__ecs_load_script(pcFile, tFlags);
     ptScript->_ptApi = ptScriptApi;
-    PL_ASSERT(ptScriptApi);
 
     if(ptScriptApi->setup)
         ptScriptApi->setup(ptLibrary, tNewEntity);
@@ -782,22 +815,8 @@ pl_ecs_attach_script(plComponentLibrary* ptLibrary, const char* pcFile, plScript
     ptScript->tFlags = tFlags;
     strncpy(ptScript->acFile, pcFile, PL_MAX_NAME_LENGTH);
 
-    gptExtensionRegistry->load(pcFile, "pl_load_script", "pl_unload_script", tFlags & PL_SCRIPT_FLAG_RELOADABLE);
-
-    const plScriptI* ptScriptApi = gptApiRegistry->first(PL_API_SCRIPT);
-    if(strncmp(pcFile, ptScriptApi->name(), PL_MAX_NAME_LENGTH) != 0)
-    {
-        while(ptScriptApi)
-        {
-            ptScriptApi = gptApiRegistry->next(ptScriptApi);
-            if(strncmp(pcFile, ptScriptApi->name(), PL_MAX_NAME_LENGTH) == 0)
-            {
-                break;
-            }
-        }
-    }
+    const plScriptI* ptScriptApi = pl__ecs_load_script(pcFile, tFlags);
     ptScript->_ptApi = ptScriptApi;
-    PL_ASSERT(ptScriptApi);
 
     if(ptScriptApi->setup)
         ptScriptApi->setup(ptLibrary, tEntity);
@@ -991,46 +1010,223 @@ pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity)
     ptHierarchyComponent->tParent.uIndex = UINT32_MAX;
 }
 
+static inline void
+pl__ecs_mul_mat4(const plMat4* ptLeft, const plMat4* ptRight, plMat4* ptOut)
+{
+#ifdef PL__ECS_SSE2
+    // same summation order as pl_mul_mat4
+    const __m128 tLeft0 = _mm_loadu_ps(ptLeft->col[0].d);
+    const __m128 tLeft1 = _mm_loadu_ps(ptLeft->col[1].d);
+    const __m128 tLeft2 = _mm_loadu_ps(ptLeft->col[2].d);
+    const __m128 tLeft3 = _mm_loadu_ps(ptLeft->col[3].d);
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const float* pfRight = ptRight->col[i].d;
+        __m128 tResult = _mm_mul_ps(tLeft0, _mm_set1_ps(pfRight[0]));
+        tResult = _mm_add_ps(tResult, _mm_mul_ps(tLeft1, _mm_set1_ps(pfRight[1])));
+        tResult = _mm_add_ps(tResult, _mm_mul_ps(tLeft2, _mm_set1_ps(pfRight[2])));
+        tResult = _mm_add_ps(tResult, _mm_mul_ps(tLeft3, _mm_set1_ps(pfRight[3])));
+        _mm_storeu_ps(ptOut->col[i].d, tResult);
+    }
+#else
+    *ptOut = pl_mul_mat4(ptLeft, ptRight);
+#endif
+}
+
+// joint matrices are affine, so transpose(inverse(m)) only needs the 3x3
+// cofactors (cross products of the columns) instead of a full 4x4 inverse
+static inline void
+pl__ecs_affine_inverse_transpose(const plMat4* ptMatrix, plMat4* ptOut)
+{
+    const plVec3 tTranslation = ptMatrix->col[3].xyz;
+    const plVec3 atCofactors[3] = {
+        pl_cross_vec3(ptMatrix->col[1].xyz, ptMatrix->col[2].xyz),
+        pl_cross_vec3(ptMatrix->col[2].xyz, ptMatrix->col[0].xyz),
+        pl_cross_vec3(ptMatrix->col[0].xyz, ptMatrix->col[1].xyz)
+    };
+    const float fDeterminant = pl_dot_vec3(ptMatrix->col[0].xyz, atCofactors[0]);
+    const float fInverseDeterminant = fDeterminant != 0.0f ? 1.0f / fDeterminant : 0.0f;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        const plVec3 tColumn = pl_mul_vec3_scalarf(atCofactors[i], fInverseDeterminant);
+        ptOut->col[i] = pl_create_vec4(tColumn.x, tColumn.y, tColumn.z, -pl_dot_vec3(tColumn, tTranslation));
+    }
+    ptOut->col[3] = pl_create_vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+// writes the joint & normal matrix of one palette entry (sbtTextureData layout)
+static inline void
+pl__ecs_skin_joint(const plMat4* ptInverseMeshWorld, const plMat4* ptJointWorld, const plMat4* ptInverseBind, plMat4* atOut)
+{
+    plMat4 tJointMatrix;
+    pl__ecs_mul_mat4(ptJointWorld, ptInverseBind, &tJointMatrix);
+    pl__ecs_mul_mat4(ptInverseMeshWorld, &tJointMatrix, &atOut[0]);
+    pl__ecs_affine_inverse_transpose(&atOut[0], &atOut[1]);
+}
+
+// transform through a cached dense index (only looked up again after the transform moved)
+static inline const plTransformComponent*
+pl__ecs_cached_transform(plComponentLibrary* ptLibrary, plEntity tEntity, uint32_t* puIndex)
+{
+    const plComponentManager* ptManager = &ptLibrary->tTransformComponentManager;
+    const plTransformComponent* sbtTransforms = ptManager->pComponents;
+    if(*puIndex < pl_sb_size(ptManager->sbtEntities) && ptManager->sbtEntities[*puIndex].ulData == tEntity.ulData)
+        return &sbtTransforms[*puIndex];
+
+    const plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+    if(ptTransform)
+        *puIndex = (uint32_t)(ptTransform - sbtTransforms);
+    return ptTransform;
+}
+
+static void
+pl__skin_update_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plSkinComponent* sbtComponents = ptLibrary->tSkinComponentManager.pComponents;
+
+    plSkinComponent* ptSkinComponent = &sbtComponents[uJobIndex];
+    plSkinCache* ptCache = &ptData->sbtSkinCache[uJobIndex];
+    const plTransformComponent* ptParent = pl__ecs_cached_transform(ptLibrary, ptSkinComponent->tMeshNode, &ptCache->uMeshNode);
+    const plMat4 tInverseWorldTransform = pl_mat4_invert(&ptParent->tWorld);
+    const uint32_t uJointCount = pl_sb_size(ptSkinComponent->sbtJoints);
+    for(uint32_t j = 0; j < uJointCount; j++)
+    {
+        const plTransformComponent* ptJointComponent = pl__ecs_cached_transform(ptLibrary, ptSkinComponent->sbtJoints[j], &ptCache->sbuJoints[j]);
+        pl__ecs_skin_joint(&tInverseWorldTransform, &ptJointComponent->tWorld, &ptSkinComponent->sbtInverseBindMatrices[j], &ptSkinComponent->sbtTextureData[j * 2]);
+    }
+}
+
 static void
 pl_run_skin_update_system(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(0, __FUNCTION__);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
     plSkinComponent* sbtComponents = ptLibrary->tSkinComponentManager.pComponents;
-
     const uint32_t uComponentCount = pl_sb_size(sbtComponents);
+
+    // cache entries follow the skin's dense index; joint lists that changed size
+    // start over (indices themselves are validated on use, so moves are harmless)
+    const uint32_t uOldCacheCount = pl_sb_size(ptData->sbtSkinCache);
+    if(uComponentCount > uOldCacheCount)
+    {
+        pl_sb_add_n(ptData->sbtSkinCache, uComponentCount - uOldCacheCount);
+        memset(&ptData->sbtSkinCache[uOldCacheCount], 0, sizeof(plSkinCache) * (uComponentCount - uOldCacheCount));
+    }
     for(uint32_t i = 0; i < uComponentCount; i++)
     {
-        plSkinComponent* ptSkinComponent = &sbtComponents[i];
-        plTransformComponent* ptParent = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptSkinComponent->tMeshNode);
-        plMat4 tInverseWorldTransform = pl_mat4_invert(&ptParent->tWorld);
-        for(uint32_t j = 0; j < pl_sb_size(ptSkinComponent->sbtJoints); j++)
+        plSkinCache* ptCache = &ptData->sbtSkinCache[i];
+        const uint32_t uJointCount = pl_sb_size(sbtComponents[i].sbtJoints);
+        if(pl_sb_size(ptCache->sbuJoints) != uJointCount)
         {
-            plEntity tJointEntity = ptSkinComponent->sbtJoints[j];
-            plTransformComponent* ptJointComponent = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tJointEntity);
-
-            const plMat4* ptIBM = &ptSkinComponent->sbtInverseBindMatrices[j];
-            plMat4 tJointMatrix = pl_mul_mat4(&ptJointComponent->tWorld, ptIBM);
-            tJointMatrix = pl_mul_mat4(&tInverseWorldTransform, &tJointMatrix);
-            plMat4 tInvertJoint = pl_mat4_invert(&tJointMatrix);
-            plMat4 tNormalMatrix = pl_mat4_transpose(&tInvertJoint);
-            ptSkinComponent->sbtTextureData[j*2] = tJointMatrix;
-            ptSkinComponent->sbtTextureData[j*2 + 1] = tNormalMatrix;
+            pl_sb_resize(ptCache->sbuJoints, uJointCount);
+            memset(ptCache->sbuJoints, 0xff, sizeof(uint32_t) * uJointCount);
         }
     }
 
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__skin_update_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(uComponentCount, PL_ECS_SKIN_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
     pl_end_profile_sample(0);
 }
 
+static plAABB
+pl__ecs_transform_aabb(const plAABB* ptAABB, const plMat4* ptTransform)
+{
+    const plVec3 tVerticies[] = {
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMin.x, ptAABB->tMin.y, ptAABB->tMin.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMax.x, ptAABB->tMin.y, ptAABB->tMin.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMax.x, ptAABB->tMax.y, ptAABB->tMin.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMin.x, ptAABB->tMax.y, ptAABB->tMin.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMin.x, ptAABB->tMin.y, ptAABB->tMax.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMax.x, ptAABB->tMin.y, ptAABB->tMax.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMax.x, ptAABB->tMax.y, ptAABB->tMax.z }),
+        pl_mul_mat4_vec3(ptTransform, (plVec3){  ptAABB->tMin.x, ptAABB->tMax.y, ptAABB->tMax.z }),
+    };
+
+    // calculate AABB
+    plAABB tResult = {
+        .tMin = {FLT_MAX, FLT_MAX, FLT_MAX},
+        .tMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX}
+    };
+    
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        if(tVerticies[i].x > tResult.tMax.x) tResult.tMax.x = tVerticies[i].x;
+        if(tVerticies[i].y > tResult.tMax.y) tResult.tMax.y = tVerticies[i].y;
+        if(tVerticies[i].z > tResult.tMax.z) tResult.tMax.z = tVerticies[i].z;
+        if(tVerticies[i].x < tResult.tMin.x) tResult.tMin.x = tVerticies[i].x;
+        if(tVerticies[i].y < tResult.tMin.y) tResult.tMin.y = tVerticies[i].y;
+        if(tVerticies[i].z < tResult.tMin.z) tResult.tMin.z = tVerticies[i].z;
+    }
+    return tResult;
+}
+
 static void
-pl__object_update_job(uint32_t uJobIndex, void* pData)
+pl__ecs_update_mesh_aabb(plMeshComponent* ptMesh, const plMat4* ptTransform)
 {
-    plComponentLibrary* ptLibrary = pData;
+    ptMesh->tAABBFinal = pl__ecs_transform_aabb(&ptMesh->tAABB, ptTransform);
+}
+
+// transform & mesh of the object at dense index uIndex
+static inline void
+pl__ecs_object_parts(plComponentLibrary* ptLibrary, uint32_t uIndex, plTransformComponent** pptTransformOut, plMeshComponent** pptMeshOut)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plObjectComponent* ptObject = &((plObjectComponent*)ptLibrary->tObjectComponentManager.pComponents)[uIndex];
+    const plEntity tEntity = ptLibrary->tObjectComponentManager.sbtEntities[uIndex];
+
+    // common case: transform & mesh live on the object entity itself, so the
+    //              cached query already holds their dense indices
+    const plEcsQuery* ptQuery = ptData->ptObjectQuery;
+    const uint32_t uRow = tEntity.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tEntity.uIndex] : UINT32_MAX;
+
+    if(uRow != UINT32_MAX && ptObject->tTransform.ulData == tEntity.ulData)
+        *pptTransformOut = &((plTransformComponent*)ptLibrary->tTransformComponentManager.pComponents)[ptQuery->sbuIndices[1][uRow]];
+    else
+        *pptTransformOut = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+
+    if(uRow != UINT32_MAX && ptObject->tMesh.ulData == tEntity.ulData)
+        *pptMeshOut = &((plMeshComponent*)ptLibrary->tMeshComponentManager.pComponents)[ptQuery->sbuIndices[2][uRow]];
+    else
+        *pptMeshOut = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, ptObject->tMesh);
+}
+
+// returns true if the world AABB was recomputed
+static bool
+pl__ecs_update_object(plComponentLibrary* ptLibrary, uint32_t uIndex, bool bForce)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
     plObjectComponent* sbtComponents = ptLibrary->tObjectComponentManager.pComponents;
-    plObjectComponent* ptObject = &sbtComponents[uJobIndex];
-    plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
-    plMeshComponent* ptMesh = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, ptObject->tMesh);
+    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    plObjectComponent* ptObject = &sbtComponents[uIndex];
+
+    plTransformComponent* ptTransform = NULL;
+    plMeshComponent* ptMesh = NULL;
+    pl__ecs_object_parts(ptLibrary, uIndex, &ptTransform, &ptMesh);
     plSkinComponent* ptSkinComponent = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
 
+    // skip if neither the world transform nor the mesh's local AABB changed
+    // (skinned objects follow their root joint & are always updated)
+    plObjectCache* ptCache = &ptData->sbtObjectCache[uIndex];
+    const uint32_t uTransformIndex = (uint32_t)(ptTransform - sbtTransforms);
+    if(!bForce && ptSkinComponent == NULL &&
+        ptCache->tTransform.ulData == ptObject->tTransform.ulData &&
+        ptCache->tMesh.ulData == ptObject->tMesh.ulData &&
+        memcmp(&ptCache->tAABB, &ptMesh->tAABB, sizeof(plAABB)) == 0 &&
+        !pl__ecs_bit_test(ptData->sbuTransformChanged, uTransformIndex))
+        return false;
+
+    ptCache->tTransform = ptObject->tTransform;
+    ptCache->tMesh = ptObject->tMesh;
+    ptCache->tAABB = ptMesh->tAABB;
+
     plMat4 tTransform = ptTransform->tWorld;
 
     if(ptSkinComponent)
@@ -1042,30 +1238,29 @@ pl__object_update_job(uint32_t uJobIndex, void* pData)
         tTransform = pl_mul_mat4(&ptJointComponent->tWorld, ptIBM);
     }
 
-    const plVec3 tVerticies[] = {
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMin.x, ptMesh->tAABB.tMin.y, ptMesh->tAABB.tMin.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMax.x, ptMesh->tAABB.tMin.y, ptMesh->tAABB.tMin.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMax.x, ptMesh->tAABB.tMax.y, ptMesh->tAABB.tMin.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMin.x, ptMesh->tAABB.tMax.y, ptMesh->tAABB.tMin.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMin.x, ptMesh->tAABB.tMin.y, ptMesh->tAABB.tMax.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMax.x, ptMesh->tAABB.tMin.y, ptMesh->tAABB.tMax.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMax.x, ptMesh->tAABB.tMax.y, ptMesh->tAABB.tMax.z }),
-        pl_mul_mat4_vec3(&tTransform, (plVec3){  ptMesh->tAABB.tMin.x, ptMesh->tAABB.tMax.y, ptMesh->tAABB.tMax.z }),
-    };
+    pl__ecs_update_mesh_aabb(ptMesh, &tTransform);
+    return true;
+}
 
-    // calculate AABB
-    ptMesh->tAABBFinal.tMax = (plVec3){-FLT_MAX, -FLT_MAX, -FLT_MAX};
-    ptMesh->tAABBFinal.tMin = (plVec3){FLT_MAX, FLT_MAX, FLT_MAX};
-    
-    for(uint32_t i = 0; i < 8; i++)
+static void
+pl__object_update_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+
+    // one job per bitset word so no two jobs write the same word
+    const uint32_t uStart = uJobIndex * 64;
+    const uint32_t uEnd = pl_minu(uStart + 64, pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities));
+    const uint64_t uForce = ptData->sbuObjectForce[uJobIndex];
+    uint64_t uChanged = 0;
+    for(uint32_t i = uStart; i < uEnd; i++)
     {
-        if(tVerticies[i].x > ptMesh->tAABBFinal.tMax.x) ptMesh->tAABBFinal.tMax.x = tVerticies[i].x;
-        if(tVerticies[i].y > ptMesh->tAABBFinal.tMax.y) ptMesh->tAABBFinal.tMax.y = tVerticies[i].y;
-        if(tVerticies[i].z > ptMesh->tAABBFinal.tMax.z) ptMesh->tAABBFinal.tMax.z = tVerticies[i].z;
-        if(tVerticies[i].x < ptMesh->tAABBFinal.tMin.x) ptMesh->tAABBFinal.tMin.x = tVerticies[i].x;
-        if(tVerticies[i].y < ptMesh->tAABBFinal.tMin.y) ptMesh->tAABBFinal.tMin.y = tVerticies[i].y;
-        if(tVerticies[i].z < ptMesh->tAABBFinal.tMin.z) ptMesh->tAABBFinal.tMin.z = tVerticies[i].z;
+        const uint64_t uBit = 1ull << (i - uStart);
+        if(pl__ecs_update_object(ptLibrary, i, (uForce & uBit) != 0))
+            uChanged |= uBit;
     }
+    ptData->sbuObjectChanged[uJobIndex] = uChanged;
+    ptData->sbuObjectForce[uJobIndex] = 0;
 }
 
 static void
@@ -1073,641 +1268,3274 @@ pl_run_object_update_system(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(0, __FUNCTION__);
     
-    plObjectComponent* sbtComponents = ptLibrary->tObjectComponentManager.pComponents;
-    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint32_t uComponentCount = pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities);
+    const uint32_t uWordCount = (uComponentCount + 63) / 64;
+    pl_sb_resize(ptData->sbtObjectCache, uComponentCount);
+    pl_sb_resize(ptData->sbuObjectChanged, uWordCount);
+    pl__ecs_bits_reserve(&ptData->sbuObjectForce, uComponentCount);
 
     plAtomicCounter* ptCounter = NULL;
     plJobDesc tJobDesc = {
         .task = pl__object_update_job,
         .pData = ptLibrary
     };
-    gptJob->dispatch_batch(uComponentCount, 0, tJobDesc, &ptCounter);
+    pl__ecs_dispatch_batch(uWordCount, 0, tJobDesc, &ptCounter);
     gptJob->wait_for_counter(ptCounter);
 
     pl_end_profile_sample(0);
 }
 
-static void
-pl_run_transform_update_system(plComponentLibrary* ptLibrary)
+// blended skinning matrix column (kept in registers with SSE2)
+#ifdef PL__ECS_SSE2
+typedef __m128 plSkinColumn;
+#else
+typedef plVec4 plSkinColumn;
+#endif
+
+// blends the palette entries a vertex is bound to (get_skinning_matrix in skinning.comp);
+// out of range joints add nothing, identity if every weight is zero
+static inline void
+pl__ecs_skinning_matrix(const plMat4* atPalette, uint32_t uJointCount, const plVec4* ptJoints, const plVec4* ptWeights, plSkinColumn atColumns[4])
 {
-    pl_begin_profile_sample(0, __FUNCTION__);
-    plTransformComponent* sbtComponents = ptLibrary->tTransformComponentManager.pComponents;
-
-    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
-    for(uint32_t i = 0; i < uComponentCount; i++)
+    // branch free: out of range joints read joint 0 with no weight
+    const plMat4* aptJoints[4];
+    float afWeights[4];
+    for(uint32_t i = 0; i < 4; i++)
     {
-        plTransformComponent* ptTransform = &sbtComponents[i];
-        ptTransform->tWorld = pl_rotation_translation_scale(ptTransform->tRotation, ptTransform->tTranslation, ptTransform->tScale);
+        const uint32_t uJoint = (uint32_t)ptJoints->d[i];
+        const bool bValid = uJoint < uJointCount;
+        aptJoints[i] = &atPalette[bValid ? uJoint * 2 : 0];
+        afWeights[i] = bValid ? ptWeights->d[i] : 0.0f;
     }
 
-    pl_end_profile_sample(0);
-}
-
-static void
-pl_run_hierarchy_update_system(plComponentLibrary* ptLibrary)
-{
-    pl_begin_profile_sample(0, __FUNCTION__);
+    if(afWeights[0] == 0.0f && afWeights[1] == 0.0f && afWeights[2] == 0.0f && afWeights[3] == 0.0f)
+    {
+#ifdef PL__ECS_SSE2
+        atColumns[0] = _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);
+        atColumns[1] = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+        atColumns[2] = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+        atColumns[3] = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+#else
+        const plMat4 tIdentity = pl_identity_mat4();
+        memcpy(atColumns, &tIdentity, sizeof(plMat4));
+#endif
+        return;
+    }
 
-    const uint32_t uComponentCount = pl_sb_size(ptLibrary->tHierarchyComponentManager.sbtEntities);
-    for(uint32_t i = 0; i < uComponentCount; i++)
+    for(uint32_t c = 0; c < 4; c++)
     {
-        const plEntity tChildEntity = ptLibrary->tHierarchyComponentManager.sbtEntities[i];
-        plHierarchyComponent* ptHierarchyComponent = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tChildEntity);
-        plTransformComponent* ptParentTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptHierarchyComponent->tParent);
-        plTransformComponent* ptChildTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tChildEntity);
-        if(ptParentTransform && ptChildTransform)
-            ptChildTransform->tWorld = pl_mul_mat4(&ptParentTransform->tWorld, &ptChildTransform->tWorld);
+#ifdef PL__ECS_SSE2
+        __m128 tColumn = _mm_mul_ps(_mm_set1_ps(afWeights[0]), _mm_loadu_ps(aptJoints[0]->col[c].d));
+        tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_set1_ps(afWeights[1]), _mm_loadu_ps(aptJoints[1]->col[c].d)));
+        tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_set1_ps(afWeights[2]), _mm_loadu_ps(aptJoints[2]->col[c].d)));
+        tColumn = _mm_add_ps(tColumn, _mm_mul_ps(_mm_set1_ps(afWeights[3]), _mm_loadu_ps(aptJoints[3]->col[c].d)));
+        atColumns[c] = tColumn;
+#else
+        plVec4 tColumn = pl_mul_vec4_scalarf(aptJoints[0]->col[c], afWeights[0]);
+        tColumn = pl_add_vec4(tColumn, pl_mul_vec4_scalarf(aptJoints[1]->col[c], afWeights[1]));
+        tColumn = pl_add_vec4(tColumn, pl_mul_vec4_scalarf(aptJoints[2]->col[c], afWeights[2]));
+        tColumn = pl_add_vec4(tColumn, pl_mul_vec4_scalarf(aptJoints[3]->col[c], afWeights[3]));
+        atColumns[c] = tColumn;
+#endif
     }
+}
 
-    pl_end_profile_sample(0);
+// skin * (v, w) (w = 1 for points, 0 for directions)
+static inline plVec3
+pl__ecs_skin_vec3(const plSkinColumn atColumns[4], plVec3 tValue, bool bPoint)
+{
+#ifdef PL__ECS_SSE2
+    __m128 tResult = _mm_mul_ps(atColumns[0], _mm_set1_ps(tValue.x));
+    tResult = _mm_add_ps(tResult, _mm_mul_ps(atColumns[1], _mm_set1_ps(tValue.y)));
+    tResult = _mm_add_ps(tResult, _mm_mul_ps(atColumns[2], _mm_set1_ps(tValue.z)));
+    if(bPoint)
+        tResult = _mm_add_ps(tResult, atColumns[3]);
+    float afResult[4];
+    _mm_storeu_ps(afResult, tResult);
+    return (plVec3){afResult[0], afResult[1], afResult[2]};
+#else
+    plVec4 tResult = pl_mul_vec4_scalarf(atColumns[0], tValue.x);
+    tResult = pl_add_vec4(tResult, pl_mul_vec4_scalarf(atColumns[1], tValue.y));
+    tResult = pl_add_vec4(tResult, pl_mul_vec4_scalarf(atColumns[2], tValue.z));
+    if(bPoint)
+        tResult = pl_add_vec4(tResult, atColumns[3]);
+    return tResult.xyz;
+#endif
 }
 
+// copies the attributes skinning doesn't touch into their vertex data buffer slots
+// (same order as the renderer's vertex data buffer)
 static void
-pl_run_script_update_system(plComponentLibrary* ptLibrary)
+pl__ecs_copy_unskinned_attributes(const plMeshComponent* ptMesh, plSkinnedMeshData* ptOutput)
 {
-    pl_begin_profile_sample(0, __FUNCTION__);
-
-    plScriptComponent* sbtComponents = ptLibrary->tScriptComponentManager.pComponents;
+    const uint32_t uStride = ptOutput->uDataStride;
+    uint32_t uOffset = 0;
+    if(pl_sb_size(ptMesh->sbtVertexNormals) > 0)  uOffset++;
+    if(pl_sb_size(ptMesh->sbtVertexTangents) > 0) uOffset++;
 
-    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
-    for(uint32_t i = 0; i < uComponentCount; i++)
+    // texture coordinates (pairs of sets share a slot)
+    for(uint32_t i = 0; i < 8; i += 2)
     {
-        const plEntity tEnitity = ptLibrary->tScriptComponentManager.sbtEntities[i];
-        if(sbtComponents[i].tFlags == 0)
-            continue;
+        const uint32_t uTexCount0 = pl_sb_size(ptMesh->sbtVertexTextureCoordinates[i]);
+        const bool bHasSecondSet = pl_sb_size(ptMesh->sbtVertexTextureCoordinates[i + 1]) > 0;
+        for(uint32_t j = 0; j < uTexCount0; j++)
+        {
+            const plVec2 tTextureCoordinates0 = ptMesh->sbtVertexTextureCoordinates[i][j];
+            const plVec2 tTextureCoordinates1 = bHasSecondSet ? ptMesh->sbtVertexTextureCoordinates[i + 1][j] : (plVec2){0};
+            ptOutput->sbtVertexData[j * uStride + uOffset] = pl_create_vec4(tTextureCoordinates0.u, tTextureCoordinates0.v, tTextureCoordinates1.u, tTextureCoordinates1.v);
+        }
+        if(uTexCount0 > 0)
+            uOffset++;
+    }
+
+    // color 0
+    const uint32_t uColorCount = pl_sb_size(ptMesh->sbtVertexColors[0]);
+    for(uint32_t j = 0; j < uColorCount; j++)
+        ptOutput->sbtVertexData[j * uStride + uOffset] = ptMesh->sbtVertexColors[0][j];
+    if(uColorCount > 0)
+        uOffset++;
 
-        if(sbtComponents[i].tFlags & PL_SCRIPT_FLAG_PLAYING)
-            sbtComponents[i]._ptApi->run(ptLibrary, tEnitity);
-        if(sbtComponents[i].tFlags & PL_SCRIPT_FLAG_PLAY_ONCE)
-            sbtComponents[i].tFlags = PL_SCRIPT_FLAG_NONE;
+    // color 1 has a slot but is never filled
+    if(pl_sb_size(ptMesh->sbtVertexColors[1]) > 0)
+    {
+        for(uint32_t j = 0; j < ptOutput->uVertexCount; j++)
+            ptOutput->sbtVertexData[j * uStride + uOffset] = (plVec4){0};
     }
-    pl_end_profile_sample(0);
 }
 
 static void
-pl_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+pl__cpu_skinning_job(uint32_t uJobIndex, void* pData)
 {
-    pl_begin_profile_sample(0, __FUNCTION__);
-    plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
-    
-    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
-    for(uint32_t i = 0; i < uComponentCount; i++)
-    {
-        plAnimationComponent* ptAnimationComponent = &sbtComponents[i];
-
-        if(!(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_PLAYING))
-            continue;
-
-        ptAnimationComponent->fTimer += fDeltaTime;
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint32_t uMeshIndex = ptData->sbuSkinnedMeshIndices[uJobIndex];
+    plMeshComponent* ptMesh = &((plMeshComponent*)ptLibrary->tMeshComponentManager.pComponents)[uMeshIndex];
+    plSkinnedMeshData* ptOutput = &ptData->sbtSkinnedMeshes[uMeshIndex];
+    const plSkinComponent* ptSkin = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+
+    pl__ecs_copy_unskinned_attributes(ptMesh, ptOutput);
+
+    const uint32_t uVertexCount = ptOutput->uVertexCount;
+    const uint32_t uStride = ptOutput->uDataStride;
+    const uint32_t uJointCount = pl_sb_size(ptSkin->sbtJoints);
+    const bool bHasNormals = pl_sb_size(ptMesh->sbtVertexNormals) > 0;
+    const bool bHasTangents = pl_sb_size(ptMesh->sbtVertexTangents) > 0;
+    const bool bHasWeights = pl_sb_size(ptMesh->sbtVertexJoints[0]) > 0 && pl_sb_size(ptMesh->sbtVertexWeights[0]) > 0;
+    const plVec4 tNoInfluence = {0};
+
+    plAABB tBounds = {
+        .tMin = {FLT_MAX, FLT_MAX, FLT_MAX},
+        .tMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX}
+    };
 
-        if(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_LOOPED)
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        plSkinColumn atSkin[4];
+        pl__ecs_skinning_matrix(ptSkin->sbtTextureData, uJointCount,
+            bHasWeights ? &ptMesh->sbtVertexJoints[0][i] : &tNoInfluence,
+            bHasWeights ? &ptMesh->sbtVertexWeights[0][i] : &tNoInfluence, atSkin);
+
+        const plVec3 tPosition = pl__ecs_skin_vec3(atSkin, ptMesh->sbtVertexPositions[i], true);
+        ptOutput->sbtVertexPositions[i] = tPosition;
+        tBounds.tMin = pl_min_vec3(tBounds.tMin, tPosition);
+        tBounds.tMax = pl_max_vec3(tBounds.tMax, tPosition);
+
+        plVec4* ptVertexData = &ptOutput->sbtVertexData[i * uStride];
+        if(bHasNormals)
         {
-            ptAnimationComponent->fTimer = fmodf(ptAnimationComponent->fTimer, ptAnimationComponent->fEnd);
+            const plVec3 tNormal = pl_norm_vec3(pl__ecs_skin_vec3(atSkin, ptMesh->sbtVertexNormals[i], false));
+            *ptVertexData = pl_create_vec4(tNormal.x, tNormal.y, tNormal.z, 0.0f);
+            ptVertexData++;
         }
-
-        if(ptAnimationComponent->fTimer > ptAnimationComponent->fEnd)
+        if(bHasTangents)
         {
-            ptAnimationComponent->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
-            ptAnimationComponent->fTimer = 0.0f;
-            continue;
+            const plVec4 tSource = ptMesh->sbtVertexTangents[i];
+            const plVec3 tTangent = pl_norm_vec3(pl__ecs_skin_vec3(atSkin, tSource.xyz, false));
+            *ptVertexData = pl_create_vec4(tTangent.x, tTangent.y, tTangent.z, tSource.w);
         }
+    }
+    ptOutput->tAABB = tBounds;
 
-        const uint32_t uChannelCount = pl_sb_size(ptAnimationComponent->sbtChannels);
-        for(uint32_t j = 0; j < uChannelCount; j++)
-        {
-            
-            const plAnimationChannel* ptChannel = &ptAnimationComponent->sbtChannels[j];
-            const plAnimationSampler* ptSampler = &ptAnimationComponent->sbtSamplers[ptChannel->uSamplerIndex];
-            const plAnimationDataComponent* ptData = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, ptSampler->tData);
-            plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptChannel->tTarget);
-
-            // wrap t around, so the animation loops.
-            // make sure that t is never earlier than the first keyframe and never later then the last keyframe.
-            const float fModTime = pl_clampf(ptData->sbfKeyFrameTimes[0], ptAnimationComponent->fTimer, pl_sb_top(ptData->sbfKeyFrameTimes));
-            int iNextKey = 0;
+    // world bounds from the skinned vertices (mesh node space)
+    const plTransformComponent* ptMeshNode = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptSkin->tMeshNode);
+    if(uVertexCount > 0 && ptMeshNode)
+        ptMesh->tAABBFinal = pl__ecs_transform_aabb(&ptOutput->tAABB, &ptMeshNode->tWorld);
+}
 
-            const uint32_t uInputDataCount = pl_sb_size(ptData->sbfKeyFrameTimes);
+static void
+pl_run_cpu_skinning_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
 
-            for(uint32_t k = 0; k < uInputDataCount; k++)
-            {
-                
-                if(fModTime <= ptData->sbfKeyFrameTimes[k])
-                {
-                    iNextKey = pl_clampi(1, k, uInputDataCount - 1);
-                    break;
-                }
-            }
-            const int iPrevKey = pl_clampi(0, iNextKey - 1, uInputDataCount - 1);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plMeshComponent* sbtMeshes = ptLibrary->tMeshComponentManager.pComponents;
+    const uint32_t uMeshCount = pl_sb_size(sbtMeshes);
 
-            const float fKeyDelta = ptData->sbfKeyFrameTimes[iNextKey] - ptData->sbfKeyFrameTimes[iPrevKey];
+    // output entries follow the dense mesh index & keep their buffers between runs
+    const uint32_t uOldCount = pl_sb_size(ptData->sbtSkinnedMeshes);
+    if(uMeshCount > uOldCount)
+    {
+        pl_sb_add_n(ptData->sbtSkinnedMeshes, uMeshCount - uOldCount);
+        memset(&ptData->sbtSkinnedMeshes[uOldCount], 0, sizeof(plSkinnedMeshData) * (uMeshCount - uOldCount));
+    }
 
-            // normalize t: [t0, t1] -> [0, 1]
-            const float fTn = (fModTime - ptData->sbfKeyFrameTimes[iPrevKey]) / fKeyDelta;
+    // size outputs up front so jobs don't allocate
+    pl_sb_reset(ptData->sbuSkinnedMeshIndices);
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtSkinnedMeshes); i++)
+    {
+        plSkinnedMeshData* ptOutput = &ptData->sbtSkinnedMeshes[i];
+        ptOutput->tMesh = (plEntity){UINT32_MAX, UINT32_MAX};
+        if(i >= uMeshCount)
+            continue;
 
-            const float fTSq = fTn * fTn;
-            const float fTCub = fTSq * fTn;
+        plMeshComponent* ptMesh = &sbtMeshes[i];
+        const plSkinComponent* ptSkin = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+        if(ptSkin == NULL)
+            continue;
 
-            const int iA = 0;
+        // same stride as the renderer's vertex data buffer
+        uint32_t uStride = 0;
+        if(pl_sb_size(ptMesh->sbtVertexNormals) > 0)               uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexTangents) > 0)              uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexColors[0]) > 0)             uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexColors[1]) > 0)             uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexTextureCoordinates[0]) > 0) uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexTextureCoordinates[2]) > 0) uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexTextureCoordinates[4]) > 0) uStride++;
+        if(pl_sb_size(ptMesh->sbtVertexTextureCoordinates[6]) > 0) uStride++;
+
+        const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        ptOutput->tMesh = ptLibrary->tMeshComponentManager.sbtEntities[i];
+        ptOutput->uVertexCount = uVertexCount;
+        ptOutput->uDataStride = uStride;
+        pl_sb_resize(ptOutput->sbtVertexPositions, uVertexCount);
+        pl_sb_resize(ptOutput->sbtVertexData, uVertexCount * uStride);
+        pl_sb_push(ptData->sbuSkinnedMeshIndices, i);
+    }
 
-            switch(ptChannel->tPath)
-            {
-                case PL_ANIMATION_PATH_TRANSLATION:
-                {
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__cpu_skinning_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(pl_sb_size(ptData->sbuSkinnedMeshIndices), PL_ECS_CPU_SKINNING_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
 
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec3 tPrev = *(plVec3*)&ptData->sbfKeyFrameData[iPrevKey * 3];
-                        const plVec3 tNext = *(plVec3*)&ptData->sbfKeyFrameData[iNextKey * 3];
-                        const plVec3 tTranslation = (plVec3){
-                            .x = tPrev.x * (1.0f - fTn) + tNext.x * fTn,
-                            .y = tPrev.y * (1.0f - fTn) + tNext.y * fTn,
-                            .z = tPrev.z * (1.0f - fTn) + tNext.z * fTn,
-                        };
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        const plVec3 tTranslation = *(plVec3*)&ptData->sbfKeyFrameData[iPrevKey * 3];
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 3 * 3;
-                        const int iNextIndex = iNextKey * 3 * 3;
-                        const int iV = 1 * 3;
-                        const int iB = 2 * 3;
-
-                        plVec3 tTranslation = {0};
-                        for(uint32_t k = 0; k < 3; k++)
-                        {
-                            const float iV0 = *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iV];
-                            const float a = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iA];
-                            const float b = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iB];
-                            const float v1 = *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iV];
-                            tTranslation.d[k] = ((2 * fTCub - 3 * fTSq + 1) * iV0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
-                        }
-                        ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tTranslation, ptAnimationComponent->fBlendAmount);
-                    }
-                    break;
-                }
+    pl_end_profile_sample(0);
+}
 
-                case PL_ANIMATION_PATH_SCALE:
-                {
+static const plSkinnedMeshData*
+pl_ecs_get_skinned_mesh_data(plComponentLibrary* ptLibrary, plEntity tMesh)
+{
+    if(pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tMesh) == NULL)
+        return NULL;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const size_t szIndex = pl_ecs_get_index(&ptLibrary->tMeshComponentManager, tMesh);
+    if(szIndex >= pl_sb_size(ptData->sbtSkinnedMeshes) || ptData->sbtSkinnedMeshes[szIndex].tMesh.ulData != tMesh.ulData)
+        return NULL;
+    return &ptData->sbtSkinnedMeshes[szIndex];
+}
 
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec3 tPrev = *(plVec3*)&ptData->sbfKeyFrameData[iPrevKey * 3];
-                        const plVec3 tNext = *(plVec3*)&ptData->sbfKeyFrameData[iNextKey * 3];
-                        ptTransform->tScale = (plVec3){
-                            .x = tPrev.x * (1.0f - fTn) + tNext.x * fTn,
-                            .y = tPrev.y * (1.0f - fTn) + tNext.y * fTn,
-                            .z = tPrev.z * (1.0f - fTn) + tNext.z * fTn,
-                        };
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        ptTransform->tScale = *(plVec3*)&ptData->sbfKeyFrameData[iPrevKey * 3];
-                    }
-
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 3 * 3;
-                        const int iNextIndex = iNextKey * 3 * 3;
-                        const int iV = 1 * 3;
-                        const int iB = 2 * 3;
-
-                        for(uint32_t k = 0; k < 3; k++)
-                        {
-                            float v0 = *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iV];
-                            float a = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iA];
-                            float b = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iB];
-                            float v1 = *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iV];
-                            ptTransform->tScale.d[k] = ((2 * fTCub - 3 * fTSq + 1) * v0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
-                        }
-                    }
-                    break;
-                }
+static void
+pl__transform_update_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plTransformComponent* sbtComponents = ptLibrary->tTransformComponentManager.pComponents;
 
-                case PL_ANIMATION_PATH_ROTATION:
-                {
+    // one job per bitset word so no two jobs write the same word
+    const uint32_t uStart = uJobIndex * 64;
+    const uint32_t uEnd = pl_minu(uStart + 64, pl_sb_size(sbtComponents));
+    const uint64_t uForce = ptData->sbuTransformForce[uJobIndex];
+    uint64_t uChanged = 0;
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        plTransformComponent* ptTransform = &sbtComponents[i];
+        plTransformCache* ptCache = &ptData->sbtTransformCache[i];
+        const uint64_t uBit = 1ull << (i - uStart);
+
+        // only rebuild when the local values changed
+        if(!(uForce & uBit) &&
+            memcmp(&ptCache->tScale, &ptTransform->tScale, sizeof(plVec3)) == 0 &&
+            memcmp(&ptCache->tRotation, &ptTransform->tRotation, sizeof(plVec4)) == 0 &&
+            memcmp(&ptCache->tTranslation, &ptTransform->tTranslation, sizeof(plVec3)) == 0)
+            continue;
 
-                    if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
-                    {
-                        const plVec4 tQ0 = *(plVec4*)&ptData->sbfKeyFrameData[iPrevKey * 4];
-                        const plVec4 tQ1 = *(plVec4*)&ptData->sbfKeyFrameData[iNextKey * 4];
-                        const plVec4 tRotation = pl_quat_slerp(tQ0, tQ1, fTn);
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tRotation, ptAnimationComponent->fBlendAmount);
-                    }
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
-                    {
-                        const plVec4 tRotation = *(plVec4*)&ptData->sbfKeyFrameData[iPrevKey * 4];
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tRotation, ptAnimationComponent->fBlendAmount);
-                    }
-                    else if(ptSampler->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
-                    {
-                        const int iPrevIndex = iPrevKey * 4 * 3;
-                        const int iNextIndex = iNextKey * 4 * 3;
-                        const int iV = 1 * 4;
-                        const int iB = 2 * 4;
-
-                        plVec4 tResult = {0};
-                        for(uint32_t k = 0; k < 4; k++)
-                        {
-                            const float iV0 = *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iV];
-                            const float a = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iA];
-                            const float b = fKeyDelta * *(float*)&ptData->sbfKeyFrameData[iPrevIndex + k + iB];
-                            const float iV1 = *(float*)&ptData->sbfKeyFrameData[iNextIndex + k + iV];
-
-                            tResult.d[k] = ((2 * fTCub - 3 * fTSq + 1) * iV0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * iV1) + ((fTCub - fTSq) * a);
-                        }
-                        ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tResult, ptAnimationComponent->fBlendAmount);
-                    }
-                    break;
-                }
-            }
-        }
+        ptCache->tScale = ptTransform->tScale;
+        ptCache->tRotation = ptTransform->tRotation;
+        ptCache->tTranslation = ptTransform->tTranslation;
+        ptCache->tLocal = pl_rotation_translation_scale(ptTransform->tRotation, ptTransform->tTranslation, ptTransform->tScale);
+        ptTransform->tWorld = ptCache->tLocal;
+        uChanged |= uBit;
     }
-
-    pl_end_profile_sample(0);
+    ptData->sbuTransformChanged[uJobIndex] = uChanged;
+    ptData->sbuTransformForce[uJobIndex] = 0;
 }
 
 static void
-pl_run_inverse_kinematics_update_system(plComponentLibrary* ptLibrary)
+pl_run_transform_update_system(plComponentLibrary* ptLibrary)
 {
     pl_begin_profile_sample(0, __FUNCTION__);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint32_t uComponentCount = pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities);
+    const uint32_t uWordCount = (uComponentCount + 63) / 64;
+    pl_sb_resize(ptData->sbtTransformCache, uComponentCount);
+    pl_sb_resize(ptData->sbuTransformChanged, uWordCount);
+    pl__ecs_bits_reserve(&ptData->sbuTransformForce, uComponentCount);
 
-    plInverseKinematicsComponent* sbtComponents = ptLibrary->tInverseKinematicsComponentManager.pComponents;
-    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__transform_update_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(uWordCount, (PL_ECS_TRANSFORM_BATCH_SIZE + 63) / 64, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
 
-    plComponentLibraryData* ptData = ptLibrary->pInternal;
-    pl_sb_resize(ptData->sbtTransformsCopy, pl_sb_size(sbtTransforms));
-    memcpy(ptData->sbtTransformsCopy, sbtTransforms, pl_sb_size(sbtTransforms) * sizeof(plTransformComponent));
-    
-    bool bRecomputeHierarchy = false;
-    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
-    for(uint32_t i = 0; i < uComponentCount; i++)
-    {
+    pl_end_profile_sample(0);
+}
 
-        const plEntity tIKEntity = ptLibrary->tInverseKinematicsComponentManager.sbtEntities[i];
-        const size_t uIKIndex = pl_ecs_get_index(&ptLibrary->tInverseKinematicsComponentManager, tIKEntity);
+static void
+pl__ecs_update_hierarchy_node(plComponentLibrary* ptLibrary, uint32_t uHierarchyIndex)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plEcsQuery* ptQuery = ptData->ptHierarchyQuery;
+    plHierarchyComponent* sbtHierarchyComponents = ptLibrary->tHierarchyComponentManager.pComponents;
+    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
 
-        const plInverseKinematicsComponent* ptInverseKinematicsComponent = &sbtComponents[uIKIndex];
-        
-        if(!ptInverseKinematicsComponent->bEnabled)
-            continue;
+    // the child's transform comes from the cached query so only the parent needs a lookup
+    const plEntity tChildEntity = ptLibrary->tHierarchyComponentManager.sbtEntities[uHierarchyIndex];
+    const uint32_t uRow = tChildEntity.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tChildEntity.uIndex] : UINT32_MAX;
+    if(uRow == UINT32_MAX)
+        return;
+    plTransformComponent* ptParentTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtHierarchyComponents[uHierarchyIndex].tParent);
+    const uint32_t uChildIndex = ptQuery->sbuIndices[1][uRow];
+    const uint32_t uParentIndex = ptParentTransform ? (uint32_t)(ptParentTransform - sbtTransforms) : UINT32_MAX;
+
+    // dirty if the child, its parent or the parent link changed (propagates down
+    // the tree since ancestors are always updated first)
+    plTransformCache* ptCache = &ptData->sbtTransformCache[uChildIndex];
+    if(!pl__ecs_bit_test(ptData->sbuTransformChanged, uChildIndex) && ptCache->uParentIndex == uParentIndex &&
+        (ptParentTransform == NULL || !pl__ecs_bit_test(ptData->sbuTransformChanged, uParentIndex)))
+        return;
+
+    ptCache->uParentIndex = uParentIndex;
+    if(ptParentTransform)
+        sbtTransforms[uChildIndex].tWorld = pl_mul_mat4(&ptParentTransform->tWorld, &ptCache->tLocal);
+    else
+        sbtTransforms[uChildIndex].tWorld = ptCache->tLocal;
+    pl__ecs_bit_set(&ptData->sbuTransformChanged, uChildIndex);
+}
 
-        const size_t uTransformIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tIKEntity);
-        const size_t uTargetIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, ptInverseKinematicsComponent->tTarget);
+// updates every hierarchy node whose transform, parent or parent link changed
+static void
+pl__ecs_propagate_hierarchy(plComponentLibrary* ptLibrary)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plEcsQuery* ptQuery = ptData->ptHierarchyQuery;
+    plHierarchyComponent* sbtHierarchyComponents = ptLibrary->tHierarchyComponentManager.pComponents;
 
-        plTransformComponent* ptTransform = &ptData->sbtTransformsCopy[uTransformIndex];
-        plTransformComponent* ptTarget = &ptData->sbtTransformsCopy[uTargetIndex];
-        plHierarchyComponent* ptHierComp = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tIKEntity);
-        
-        PL_ASSERT(uTransformIndex != UINT64_MAX);
-        PL_ASSERT(uTargetIndex != UINT64_MAX);
-        PL_ASSERT(ptHierComp);
+    const uint32_t uComponentCount = pl_sb_size(ptLibrary->tHierarchyComponentManager.sbtEntities);
+    while(pl_sb_size(ptData->sbuHierarchyPasses) < uComponentCount)
+        pl_sb_push(ptData->sbuHierarchyPasses, 0);
+    const uint32_t uPass = ++ptData->uHierarchyPass;
 
-        const plVec3 tTargetPos = ptTarget->tWorld.col[3].xyz;
-        for(uint32_t j = 0; j < ptInverseKinematicsComponent->uIterationCount; j++)
+    // manager order is arbitrary (attaching may place a parent after its child), so
+    // not yet updated ancestors are walked up & updated first
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        uint32_t auStack[PL_ECS_MAX_HIERARCHY_DEPTH];
+        uint32_t uDepth = 0;
+        uint32_t uCurrent = i;
+        while(ptData->sbuHierarchyPasses[uCurrent] != uPass && uDepth < PL_ECS_MAX_HIERARCHY_DEPTH)
         {
-            plTransformComponent* aptStack[32] = {0};
-            plEntity tParentEntity = ptHierComp->tParent;
-            plTransformComponent* ptChildTransform = ptTransform;
-            for(uint32_t uChain = 0; uChain < pl_min(ptInverseKinematicsComponent->uChainLength, 32); ++uChain)
-            {
-                bRecomputeHierarchy = true;
+            ptData->sbuHierarchyPasses[uCurrent] = uPass; // also stops on cycles
+            auStack[uDepth++] = uCurrent;
 
-                // stack stores all traversed chain links so far
-                aptStack[uChain] = ptChildTransform;
+            const plEntity tParent = sbtHierarchyComponents[uCurrent].tParent;
+            const uint32_t uParentRow = tParent.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tParent.uIndex] : UINT32_MAX;
+            if(uParentRow == UINT32_MAX || ptQuery->sbtEntities[uParentRow].ulData != tParent.ulData)
+                break;
+            uCurrent = ptQuery->sbuIndices[0][uParentRow];
+        }
 
-                // compute required parent rotation that moves ik transform closer to target transform
-                const size_t uParentIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tParentEntity);
-                PL_ASSERT(uParentIndex != UINT64_MAX);
-                plTransformComponent* ptParentTransform =  &ptData->sbtTransformsCopy[uParentIndex];
-                const plVec3 tParentPos = ptParentTransform->tWorld.col[3].xyz;
-                const plVec3 tDirParentToIk = pl_norm_vec3(pl_sub_vec3(ptTransform->tWorld.col[3].xyz, tParentPos));
-                const plVec3 tDirParentToTarget = pl_norm_vec3(pl_sub_vec3(tTargetPos, tParentPos));
+        while(uDepth > 0)
+            pl__ecs_update_hierarchy_node(ptLibrary, auStack[--uDepth]);
+    }
+}
+
+static void
+pl_run_hierarchy_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+    pl__ecs_propagate_hierarchy(ptLibrary);
+    pl_end_profile_sample(0);
+}
+
+static void
+pl__script_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+
+    // batches (& their command buffers) don't depend on the thread count
+    plEcsCommandBuffer* ptBuffer = ptData->sbptScriptBuffers[uJobIndex];
+    const uint32_t uStart = uJobIndex * PL_ECS_SCRIPT_BATCH_SIZE;
+    const uint32_t uEnd = pl_minu(uStart + PL_ECS_SCRIPT_BATCH_SIZE, ptData->uScriptWaveCount);
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        const plEntity tEntity = ptData->sbtScriptSchedule[ptData->uScriptWaveStart + i];
+        const plScriptComponent* ptScript = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SCRIPT, tEntity);
+        if(ptScript)
+            ptScript->_ptApi->run_job(ptLibrary, tEntity, ptBuffer);
+    }
+}
+
+static void
+pl_run_script_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plScriptComponent* sbtComponents = ptLibrary->tScriptComponentManager.pComponents;
+    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
+
+    // each script goes in the wave after the last earlier script it conflicts with (writes vs
+    // reads/writes of the same component type, entity writes vs reads); scripts without "run_job"
+    // get a wave of their own that every later script waits for
+    uint32_t auLastRead[PL_COMPONENT_TYPE_COUNT] = {0};
+    uint32_t auLastWrite[PL_COMPONENT_TYPE_COUNT] = {0};
+    uint32_t auLastEntityWrite[PL_COMPONENT_TYPE_COUNT] = {0};
+    uint32_t uBarrier = 0; // waves are 1 based here so 0 means "none"
+    uint32_t uWaveCount = 0;
+    pl_sb_reset(ptData->sbtScriptPlaying);
+    pl_sb_reset(ptData->sbuScriptWaves);
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        const plScriptComponent* ptScript = &sbtComponents[i];
+        if(!(ptScript->tFlags & PL_SCRIPT_FLAG_PLAYING))
+            continue;
+
+        uint32_t uWave = uBarrier + 1;
+        if(ptScript->_ptApi->run_job == NULL)
+        {
+            uWave = pl_maxu(uWave, uWaveCount + 1);
+            uBarrier = uWave;
+        }
+        else
+        {
+            for(uint32_t j = 0; j < PL_COMPONENT_TYPE_COUNT; j++)
+            {
+                const uint64_t uBit = 1ull << j;
+                if(ptScript->uReads & uBit)
+                    uWave = pl_maxu(uWave, pl_maxu(auLastWrite[j], auLastEntityWrite[j]) + 1);
+                if(ptScript->uWrites & uBit)
+                    uWave = pl_maxu(uWave, pl_maxu(pl_maxu(auLastRead[j], auLastWrite[j]), auLastEntityWrite[j]) + 1);
+                if(ptScript->uEntityWrites & uBit)
+                    uWave = pl_maxu(uWave, pl_maxu(auLastRead[j], auLastWrite[j]) + 1);
+            }
+            for(uint32_t j = 0; j < PL_COMPONENT_TYPE_COUNT; j++)
+            {
+                const uint64_t uBit = 1ull << j;
+                if(ptScript->uReads & uBit)        auLastRead[j]        = pl_maxu(auLastRead[j], uWave);
+                if(ptScript->uWrites & uBit)       auLastWrite[j]       = pl_maxu(auLastWrite[j], uWave);
+                if(ptScript->uEntityWrites & uBit) auLastEntityWrite[j] = pl_maxu(auLastEntityWrite[j], uWave);
+            }
+        }
+        uWaveCount = pl_maxu(uWaveCount, uWave);
+        pl_sb_push(ptData->sbuScriptWaves, uWave - 1);
+        pl_sb_push(ptData->sbtScriptPlaying, ptLibrary->tScriptComponentManager.sbtEntities[i]);
+    }
+
+    // group by wave (counting sort keeps component order within a wave)
+    const uint32_t uScriptCount = pl_sb_size(ptData->sbtScriptPlaying);
+    pl_sb_resize(ptData->sbuScriptWaveStarts, uWaveCount + 1);
+    memset(ptData->sbuScriptWaveStarts, 0, sizeof(uint32_t) * (uWaveCount + 1));
+    for(uint32_t i = 0; i < uScriptCount; i++)
+        ptData->sbuScriptWaveStarts[ptData->sbuScriptWaves[i] + 1]++;
+    for(uint32_t i = 0; i < uWaveCount; i++)
+        ptData->sbuScriptWaveStarts[i + 1] += ptData->sbuScriptWaveStarts[i];
+    pl_sb_resize(ptData->sbtScriptSchedule, uScriptCount);
+    for(uint32_t i = 0; i < uScriptCount; i++)
+        ptData->sbtScriptSchedule[ptData->sbuScriptWaveStarts[ptData->sbuScriptWaves[i]]++] = ptData->sbtScriptPlaying[i];
+    memmove(&ptData->sbuScriptWaveStarts[1], ptData->sbuScriptWaveStarts, sizeof(uint32_t) * uWaveCount);
+    ptData->sbuScriptWaveStarts[0] = 0;
+
+    for(uint32_t uWave = 0; uWave < uWaveCount; uWave++)
+    {
+        ptData->uScriptWaveStart = ptData->sbuScriptWaveStarts[uWave];
+        ptData->uScriptWaveCount = ptData->sbuScriptWaveStarts[uWave + 1] - ptData->uScriptWaveStart;
+        const plEntity tFirst = ptData->sbtScriptSchedule[ptData->uScriptWaveStart];
+        const plScriptComponent* ptFirst = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SCRIPT, tFirst);
+        if(ptFirst && ptFirst->_ptApi->run_job == NULL)
+        {
+            ptFirst->_ptApi->run(ptLibrary, tFirst);
+            continue;
+        }
+
+        const uint32_t uBatchCount = (ptData->uScriptWaveCount + PL_ECS_SCRIPT_BATCH_SIZE - 1) / PL_ECS_SCRIPT_BATCH_SIZE;
+        while(pl_sb_size(ptData->sbptScriptBuffers) < uBatchCount)
+            pl_sb_push(ptData->sbptScriptBuffers, pl_ecs_create_command_buffer(ptLibrary));
+        for(uint32_t i = 0; i < uBatchCount; i++)
+            pl_ecs_reset_command_buffer(ptData->sbptScriptBuffers[i]);
+
+        plAtomicCounter* ptCounter = NULL;
+        plJobDesc tJobDesc = {
+            .task  = pl__script_job,
+            .pData = ptLibrary
+        };
+        pl__ecs_dispatch_batch(uBatchCount, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+        pl_ecs_playback_command_buffers(ptLibrary, uBatchCount, ptData->sbptScriptBuffers);
+    }
+
+    // play once scripts stop after their first run
+    for(uint32_t i = 0; i < uScriptCount; i++)
+    {
+        plScriptComponent* ptScript = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_SCRIPT, ptData->sbtScriptSchedule[i]);
+        if(ptScript && ptScript->tFlags & PL_SCRIPT_FLAG_PLAY_ONCE)
+            ptScript->tFlags = PL_SCRIPT_FLAG_NONE;
+    }
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_run_systems(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    pl_run_script_update_system(ptLibrary);
+    pl_run_animation_update_system(ptLibrary, fDeltaTime);
+    pl_run_blend_tree_system(ptLibrary, fDeltaTime);
+    pl_run_transform_update_system(ptLibrary);
+    pl_run_hierarchy_update_system(ptLibrary);
+    pl_run_inverse_kinematics_update_system(ptLibrary);
+    pl_run_skin_update_system(ptLibrary);
+    pl_run_object_update_system(ptLibrary);
+}
+
+// first key with a time >= fTime (key times are sorted), tries the cached
+// cursor & the key after it first since playback usually moves forward
+static inline uint32_t
+pl__ecs_find_next_key(const float* afTimes, uint32_t uKeyCount, float fTime, uint32_t* puCursor)
+{
+    uint32_t uKey = *puCursor;
+    for(uint32_t i = 0; i < 2 && uKey < uKeyCount; i++, uKey++)
+    {
+        if(fTime <= afTimes[uKey] && (uKey == 0 || afTimes[uKey - 1] < fTime))
+        {
+            *puCursor = uKey;
+            return uKey;
+        }
+    }
+
+    // binary search fallback (seeking, looping or large time steps)
+    uint32_t uLow = 0;
+    uint32_t uHigh = uKeyCount;
+    while(uLow < uHigh)
+    {
+        const uint32_t uMid = uLow + (uHigh - uLow) / 2;
+        if(afTimes[uMid] < fTime)
+            uLow = uMid + 1;
+        else
+            uHigh = uMid;
+    }
+    *puCursor = uLow;
+    return uLow;
+}
+
+static void
+pl__ecs_free_animation_clip(plAnimationClip** pptClip)
+{
+    plAnimationClip* ptClip = *pptClip;
+    if(ptClip == NULL)
+        return;
+
+    pl_sb_free(ptClip->sbtTracks);
+    pl_sb_free(ptClip->sbfTimes);
+    pl_sb_free(ptClip->sbfValues);
+    pl_sb_free(ptClip->sbfSamples);
+    pl_sb_free(ptClip->sbuChannelLanes);
+    pl_sb_free(ptClip->sbtCompressedChannels);
+    pl_sb_free(ptClip->sbuKeys);
+    pl_sb_free(ptClip->sbuValues);
+    PL_FREE(ptClip);
+    *pptClip = NULL;
+}
+
+// components other than the largest of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)]
+#define PL__ECS_SMALLEST_THREE_RANGE 0.70710678f
+
+// longest run of keys a single reduced segment may replace
+#define PL__ECS_MAX_REDUCED_KEY_SPAN 256
+
+// smallest three: drops the largest component (made positive, q & -q are the
+// same rotation) & stores the others in 15 bits each, the dropped index goes
+// in the low bits of the first two values
+static inline void
+pl__ecs_quantize_rotation(plVec4 tQ, uint16_t* auOut)
+{
+    tQ = pl_norm_vec4(tQ);
+    uint32_t uLargest = 0;
+    for(uint32_t k = 1; k < 4; k++)
+    {
+        if(fabsf(tQ.d[k]) > fabsf(tQ.d[uLargest]))
+            uLargest = k;
+    }
+    const float fSign = tQ.d[uLargest] < 0.0f ? -1.0f : 1.0f;
+
+    uint32_t uOut = 0;
+    for(uint32_t k = 0; k < 4; k++)
+    {
+        if(k == uLargest)
+            continue;
+        const float fValue = pl_clampf(-1.0f, fSign * tQ.d[k] / PL__ECS_SMALLEST_THREE_RANGE, 1.0f);
+        auOut[uOut++] = (uint16_t)((uint32_t)((fValue * 0.5f + 0.5f) * 32767.0f + 0.5f) << 1);
+    }
+    auOut[0] |= (uint16_t)(uLargest & 1);
+    auOut[1] |= (uint16_t)(uLargest >> 1);
+}
+
+static inline plVec4
+pl__ecs_dequantize_rotation(const uint16_t* auIn)
+{
+    const uint32_t uLargest = (auIn[0] & 1) | ((auIn[1] & 1) << 1);
+    plVec4 tQ = {0};
+    float fSumSq = 0.0f;
+    uint32_t uIn = 0;
+    for(uint32_t k = 0; k < 4; k++)
+    {
+        if(k == uLargest)
+            continue;
+        const float fValue = ((float)(auIn[uIn++] >> 1) * (2.0f / 32767.0f) - 1.0f) * PL__ECS_SMALLEST_THREE_RANGE;
+        tQ.d[k] = fValue;
+        fSumSq += fValue * fValue;
+    }
+    tQ.d[uLargest] = sqrtf(pl_maxf(0.0f, 1.0f - fSumSq));
+    return tQ;
+}
+
+static inline plVec4
+pl__ecs_dequantize_vec3(const uint16_t* auIn, plVec3 tMin, plVec3 tScale)
+{
+    return (plVec4){
+        tMin.x + (float)auIn[0] * tScale.x,
+        tMin.y + (float)auIn[1] * tScale.y,
+        tMin.z + (float)auIn[2] * tScale.z,
+        0.0f
+    };
+}
+
+// angle (radians) for rotations, largest component difference otherwise
+static inline float
+pl__ecs_channel_error(bool bRotation, plVec4 tA, plVec4 tB)
+{
+    if(bRotation)
+    {
+        // |a - b| = 2sin(angle / 4) for unit quaternions (stays precise for small angles unlike acos)
+        tA = pl_norm_vec4(tA);
+        tB = pl_norm_vec4(tB);
+        if(pl_dot_vec4(tA, tB) < 0.0f)
+            tB = pl_mul_vec4_scalarf(tB, -1.0f);
+        return 4.0f * asinf(pl_minf(pl_length_vec4(pl_sub_vec4(tA, tB)) * 0.5f, 1.0f));
+    }
+    return pl_maxf(fabsf(tA.x - tB.x), pl_maxf(fabsf(tA.y - tB.y), fabsf(tA.z - tB.z)));
+}
+
+// can keys between uAnchor & uCandidate be dropped (checked against the source keys)
+static bool
+pl__ecs_segment_fits(const float* afTimes, const plVec4* atSource, const plVec4* atDecoded, bool bRotation, bool bStep, uint32_t uAnchor, uint32_t uCandidate, float fTolerance)
+{
+    const float fSpan = afTimes[uCandidate] - afTimes[uAnchor];
+    if(!bStep && !(fSpan > 0.0f))
+        return false;
+
+    for(uint32_t k = uAnchor + 1; k < uCandidate; k++)
+    {
+        plVec4 tValue = atDecoded[uAnchor]; // step keys hold the anchor value
+        if(!bStep)
+        {
+            const float fTn = (afTimes[k] - afTimes[uAnchor]) / fSpan;
+            if(bRotation)
+                tValue = pl_quat_slerp(atDecoded[uAnchor], atDecoded[uCandidate], fTn);
+            else
+                tValue.xyz = pl_lerp_vec3(atDecoded[uAnchor].xyz, atDecoded[uCandidate].xyz, fTn);
+        }
+        if(pl__ecs_channel_error(bRotation, tValue, atSource[k]) > fTolerance)
+            return false;
+    }
+    return true;
+}
+
+static void
+pl__ecs_compress_channel(plAnimationClip* ptClip, uint32_t uTrack, uint32_t uLane, bool bRotation, bool bStep, const plVec4* atSource, float fTolerance)
+{
+    const plAnimationTrack* ptTrack = &ptClip->sbtTracks[uTrack];
+    const float* afTimes = &ptClip->sbfTimes[ptTrack->uTimeOffset];
+    const uint32_t uKeyCount = ptTrack->uKeyCount;
+
+    plCompressedChannel tChannel = {
+        .uLane        = uLane,
+        .uTrack       = uTrack,
+        .bRotation    = bRotation,
+        .bStep        = bStep,
+        .tConstant    = atSource[0],
+        .uKeyOffset   = pl_sb_size(ptClip->sbuKeys),
+        .uValueOffset = pl_sb_size(ptClip->sbuValues)
+    };
+
+    // constant channels only keep their first key (uKeyCount stays 0)
+    bool bConstant = true;
+    for(uint32_t k = 1; k < uKeyCount && bConstant; k++)
+        bConstant = pl__ecs_channel_error(bRotation, atSource[k], atSource[0]) <= fTolerance;
+    if(bConstant)
+    {
+        pl_sb_push(ptClip->sbtCompressedChannels, tChannel);
+        return;
+    }
+
+    // quantize (reduction measures error using the values the sampler will see)
+    if(!bRotation)
+    {
+        plVec3 tMax = atSource[0].xyz;
+        tChannel.tMin = atSource[0].xyz;
+        for(uint32_t k = 1; k < uKeyCount; k++)
+        {
+            tChannel.tMin = pl_min_vec3(tChannel.tMin, atSource[k].xyz);
+            tMax = pl_max_vec3(tMax, atSource[k].xyz);
+        }
+        tChannel.tScale = pl_mul_vec3_scalarf(pl_sub_vec3(tMax, tChannel.tMin), 1.0f / 65535.0f);
+    }
+
+    uint16_t* sbuQuantized = NULL;
+    plVec4* sbtDecoded = NULL;
+    pl_sb_resize(sbuQuantized, uKeyCount * 3);
+    pl_sb_resize(sbtDecoded, uKeyCount);
+    for(uint32_t k = 0; k < uKeyCount; k++)
+    {
+        uint16_t* auQuantized = &sbuQuantized[k * 3];
+        if(bRotation)
+        {
+            pl__ecs_quantize_rotation(atSource[k], auQuantized);
+            sbtDecoded[k] = pl__ecs_dequantize_rotation(auQuantized);
+        }
+        else
+        {
+            for(uint32_t c = 0; c < 3; c++)
+            {
+                const float fExtent = tChannel.tScale.d[c] * 65535.0f;
+                const float fValue = fExtent > 0.0f ? (atSource[k].d[c] - tChannel.tMin.d[c]) / fExtent : 0.0f;
+                auQuantized[c] = (uint16_t)(pl_clampf(0.0f, fValue, 1.0f) * 65535.0f + 0.5f);
+            }
+            sbtDecoded[k] = pl__ecs_dequantize_vec3(auQuantized, tChannel.tMin, tChannel.tScale);
+        }
+    }
+
+    pl_sb_reserve(ptClip->sbuKeys, uKeyCount); // room for every key
+    pl_sb_reserve(ptClip->sbuValues, uKeyCount * 3);
+
+    // key reduction (greedy: each segment is grown by doubling, then bisected back to the
+    // longest span whose dropped keys stay within tolerance)
+    uint32_t uAnchor = 0;
+    while(true)
+    {
+        pl_sb_push(ptClip->sbuKeys, (uint16_t)uAnchor);
+        pl_sb_push(ptClip->sbuValues, sbuQuantized[uAnchor * 3]);
+        pl_sb_push(ptClip->sbuValues, sbuQuantized[uAnchor * 3 + 1]);
+        pl_sb_push(ptClip->sbuValues, sbuQuantized[uAnchor * 3 + 2]);
+        tChannel.uKeyCount++;
+        if(uAnchor == uKeyCount - 1)
+            break;
+
+        const uint32_t uLast = pl_min(uKeyCount - 1, uAnchor + PL__ECS_MAX_REDUCED_KEY_SPAN);
+        uint32_t uFits = uAnchor + 1;
+        uint32_t uFails = uLast + 1;
+        for(uint32_t uSpan = 2; uAnchor + uSpan <= uLast; uSpan *= 2)
+        {
+            if(!pl__ecs_segment_fits(afTimes, atSource, sbtDecoded, bRotation, bStep, uAnchor, uAnchor + uSpan, fTolerance))
+            {
+                uFails = uAnchor + uSpan;
+                break;
+            }
+            uFits = uAnchor + uSpan;
+        }
+        if(uFails > uLast && uFits < uLast)
+        {
+            if(pl__ecs_segment_fits(afTimes, atSource, sbtDecoded, bRotation, bStep, uAnchor, uLast, fTolerance))
+                uFits = uLast;
+            else
+                uFails = uLast;
+        }
+        while(uFails - uFits > 1)
+        {
+            const uint32_t uMid = uFits + (uFails - uFits) / 2;
+            if(pl__ecs_segment_fits(afTimes, atSource, sbtDecoded, bRotation, bStep, uAnchor, uMid, fTolerance))
+                uFits = uMid;
+            else
+                uFails = uMid;
+        }
+        uAnchor = uFits;
+    }
+
+    pl_sb_free(sbuQuantized);
+    pl_sb_free(sbtDecoded);
+    pl_sb_push(ptClip->sbtCompressedChannels, tChannel);
+}
+
+// same as pl__ecs_find_next_key but over a subset of the track's keys
+static inline uint32_t
+pl__ecs_find_next_reduced_key(const float* afTimes, const uint16_t* auKeys, uint32_t uKeyCount, float fTime, uint32_t* puCursor)
+{
+    uint32_t uKey = *puCursor;
+    for(uint32_t i = 0; i < 2 && uKey < uKeyCount; i++, uKey++)
+    {
+        if(fTime <= afTimes[auKeys[uKey]] && (uKey == 0 || afTimes[auKeys[uKey - 1]] < fTime))
+        {
+            *puCursor = uKey;
+            return uKey;
+        }
+    }
+
+    uint32_t uLow = 0;
+    uint32_t uHigh = uKeyCount;
+    while(uLow < uHigh)
+    {
+        const uint32_t uMid = uLow + (uHigh - uLow) / 2;
+        if(afTimes[auKeys[uMid]] < fTime)
+            uLow = uMid + 1;
+        else
+            uHigh = uMid;
+    }
+    *puCursor = uLow;
+    return uLow;
+}
+
+static void
+pl__ecs_sample_compressed_channel(plAnimationClip* ptClip, plCompressedChannel* ptChannel, float fTime)
+{
+    plVec4 tValue = ptChannel->tConstant;
+    if(ptChannel->uKeyCount > 0)
+    {
+        const plAnimationTrack* ptTrack = &ptClip->sbtTracks[ptChannel->uTrack];
+        const float* afTimes = &ptClip->sbfTimes[ptTrack->uTimeOffset];
+        const uint16_t* auKeys = &ptClip->sbuKeys[ptChannel->uKeyOffset];
+        const uint16_t* auValues = &ptClip->sbuValues[ptChannel->uValueOffset];
+
+        const float fModTime = pl_clampf(afTimes[0], fTime, afTimes[ptTrack->uKeyCount - 1]);
+        const uint32_t uNextKey = (uint32_t)pl_clampi(1, (int)pl__ecs_find_next_reduced_key(afTimes, auKeys, ptChannel->uKeyCount, fModTime, &ptChannel->uCursor), (int)ptChannel->uKeyCount - 1);
+        const uint32_t uPrevKey = uNextKey - 1;
+
+        const plVec4 tPrev = ptChannel->bRotation ? pl__ecs_dequantize_rotation(&auValues[uPrevKey * 3]) : pl__ecs_dequantize_vec3(&auValues[uPrevKey * 3], ptChannel->tMin, ptChannel->tScale);
+        if(ptChannel->bStep)
+            tValue = tPrev;
+        else
+        {
+            const plVec4 tNext = ptChannel->bRotation ? pl__ecs_dequantize_rotation(&auValues[uNextKey * 3]) : pl__ecs_dequantize_vec3(&auValues[uNextKey * 3], ptChannel->tMin, ptChannel->tScale);
+            const float fT0 = afTimes[auKeys[uPrevKey]];
+            const float fTn = (fModTime - fT0) / (afTimes[auKeys[uNextKey]] - fT0);
+            if(ptChannel->bRotation)
+                tValue = pl_quat_slerp(tPrev, tNext, fTn);
+            else
+                tValue.xyz = pl_lerp_vec3(tPrev.xyz, tNext.xyz, fTn);
+        }
+    }
+
+    memcpy(&ptClip->sbfSamples[ptChannel->uLane], &tValue, sizeof(float) * (ptChannel->bRotation ? 4 : 3));
+}
+
+// ptCompression may be NULL (uncompressed)
+static plAnimationClip*
+pl__ecs_build_animation_clip(plComponentLibrary* ptLibrary, const plAnimationComponent* ptAnimation, const plAnimationCompressionDesc* ptCompression)
+{
+    plAnimationClip* ptClip = PL_ALLOC(sizeof(plAnimationClip));
+    memset(ptClip, 0, sizeof(plAnimationClip));
+    if(ptCompression)
+    {
+        ptClip->bCompressed = true;
+        ptClip->tCompression = *ptCompression;
+    }
+
+    const uint32_t uChannelCount = pl_sb_size(ptAnimation->sbtChannels);
+    pl_sb_resize(ptClip->sbuChannelLanes, uChannelCount);
+
+    // group channels sharing a sampling mode & key times into tracks
+    uint32_t* sbuChannelTracks = NULL;
+    bool* sbbChannelCompressed = NULL;
+    pl_sb_resize(sbuChannelTracks, uChannelCount);
+    pl_sb_resize(sbbChannelCompressed, uChannelCount);
+    for(uint32_t i = 0; i < uChannelCount; i++)
+    {
+        const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[i];
+        const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[ptChannel->uSamplerIndex];
+        const plAnimationDataComponent* ptData = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, ptSampler->tData);
+        ptClip->sbuChannelLanes[i] = UINT32_MAX;
+        sbuChannelTracks[i] = UINT32_MAX;
+
+        // weights & unknown paths are never applied
+        const bool bSupportedPath = ptChannel->tPath == PL_ANIMATION_PATH_TRANSLATION || ptChannel->tPath == PL_ANIMATION_PATH_ROTATION || ptChannel->tPath == PL_ANIMATION_PATH_SCALE;
+        if(ptData == NULL || pl_sb_size(ptData->sbfKeyFrameTimes) == 0 || !bSupportedPath)
+            continue;
+
+        const uint32_t uKeyCount = pl_sb_size(ptData->sbfKeyFrameTimes);
+
+        // cubic splines stay as floats (tangents don't survive key reduction), kept keys are 16 bit
+        sbbChannelCompressed[i] = ptCompression && ptSampler->tMode != PL_ANIMATION_MODE_CUBIC_SPLINE && uKeyCount <= UINT16_MAX + 1;
+
+        for(uint32_t j = 0; j < pl_sb_size(ptClip->sbtTracks); j++)
+        {
+            const plAnimationTrack* ptTrack = &ptClip->sbtTracks[j];
+            if(ptTrack->tMode == ptSampler->tMode && ptTrack->uKeyCount == uKeyCount &&
+                memcmp(&ptClip->sbfTimes[ptTrack->uTimeOffset], ptData->sbfKeyFrameTimes, sizeof(float) * uKeyCount) == 0)
+            {
+                sbuChannelTracks[i] = j;
+                break;
+            }
+        }
+
+        if(sbuChannelTracks[i] == UINT32_MAX)
+        {
+            sbuChannelTracks[i] = pl_sb_size(ptClip->sbtTracks);
+            const plAnimationTrack tTrack = {
+                .tMode       = ptSampler->tMode,
+                .uKeyCount   = uKeyCount,
+                .uTimeOffset = pl_sb_size(ptClip->sbfTimes)
+            };
+            pl_sb_push(ptClip->sbtTracks, tTrack);
+            memcpy(&ptClip->sbfTimes[pl_sb_add_n(ptClip->sbfTimes, uKeyCount)], ptData->sbfKeyFrameTimes, sizeof(float) * uKeyCount);
+        }
+    }
+
+    // assign lanes (vec3 channels first so they interpolate in one loop, quaternions last)
+    uint32_t uLaneOffset = 0;
+    for(uint32_t j = 0; j < pl_sb_size(ptClip->sbtTracks); j++)
+    {
+        plAnimationTrack* ptTrack = &ptClip->sbtTracks[j];
+        ptTrack->uLaneOffset = uLaneOffset;
+        for(uint32_t uPass = 0; uPass < 2; uPass++)
+        {
+            for(uint32_t i = 0; i < uChannelCount; i++)
+            {
+                const bool bRotation = ptAnimation->sbtChannels[i].tPath == PL_ANIMATION_PATH_ROTATION;
+                if(sbuChannelTracks[i] != j || sbbChannelCompressed[i] || bRotation != (uPass == 1))
+                    continue;
+                ptClip->sbuChannelLanes[i] = uLaneOffset + ptTrack->uLaneCount;
+                ptTrack->uLaneCount += bRotation ? 4 : 3;
+            }
+            if(uPass == 0)
+                ptTrack->uVectorLaneCount = ptTrack->uLaneCount;
+        }
+        uLaneOffset += ptTrack->uLaneCount;
+    }
+    for(uint32_t i = 0; i < uChannelCount; i++)
+    {
+        if(sbuChannelTracks[i] == UINT32_MAX || !sbbChannelCompressed[i])
+            continue;
+        ptClip->sbuChannelLanes[i] = uLaneOffset;
+        uLaneOffset += ptAnimation->sbtChannels[i].tPath == PL_ANIMATION_PATH_ROTATION ? 4 : 3;
+    }
+    pl_sb_resize(ptClip->sbfSamples, uLaneOffset);
+
+    // pack values as [key][section][lane] (cubic splines have in-tangent, value & out-tangent sections)
+    for(uint32_t j = 0; j < pl_sb_size(ptClip->sbtTracks); j++)
+    {
+        plAnimationTrack* ptTrack = &ptClip->sbtTracks[j];
+        const uint32_t uSectionCount = ptTrack->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE ? 3 : 1;
+        const uint32_t uKeyStride = uSectionCount * ptTrack->uLaneCount;
+        const uint32_t uValueCount = ptTrack->uKeyCount * uKeyStride;
+        ptTrack->uValueOffset = pl_sb_add_n(ptClip->sbfValues, uValueCount);
+
+        for(uint32_t i = 0; i < uChannelCount; i++)
+        {
+            if(sbuChannelTracks[i] != j || sbbChannelCompressed[i])
+                continue;
+
+            const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[i];
+            const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[ptChannel->uSamplerIndex];
+            const plAnimationDataComponent* ptData = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, ptSampler->tData);
+            const uint32_t uStride = ptChannel->tPath == PL_ANIMATION_PATH_ROTATION ? 4 : 3;
+            const uint32_t uLane = ptClip->sbuChannelLanes[i] - ptTrack->uLaneOffset;
+            const uint32_t uAvailable = pl_sb_size(ptData->sbfKeyFrameData);
+
+            for(uint32_t uKey = 0; uKey < ptTrack->uKeyCount; uKey++)
+            {
+                for(uint32_t uSection = 0; uSection < uSectionCount; uSection++)
+                {
+                    const uint32_t uSource = (uKey * uSectionCount + uSection) * uStride;
+                    float* pfDest = &ptClip->sbfValues[ptTrack->uValueOffset + uKey * uKeyStride + uSection * ptTrack->uLaneCount + uLane];
+                    for(uint32_t k = 0; k < uStride; k++)
+                        pfDest[k] = uSource + k < uAvailable ? ptData->sbfKeyFrameData[uSource + k] : 0.0f;
+                }
+            }
+        }
+    }
+
+    // compressed channels
+    plVec4* sbtSource = NULL;
+    for(uint32_t i = 0; i < uChannelCount; i++)
+    {
+        if(sbuChannelTracks[i] == UINT32_MAX || !sbbChannelCompressed[i])
+            continue;
+
+        const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[i];
+        const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[ptChannel->uSamplerIndex];
+        const plAnimationDataComponent* ptData = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, ptSampler->tData);
+        const plAnimationTrack* ptTrack = &ptClip->sbtTracks[sbuChannelTracks[i]];
+        const bool bRotation = ptChannel->tPath == PL_ANIMATION_PATH_ROTATION;
+        const uint32_t uStride = bRotation ? 4 : 3;
+        const uint32_t uAvailable = pl_sb_size(ptData->sbfKeyFrameData);
+
+        pl_sb_resize(sbtSource, ptTrack->uKeyCount);
+        for(uint32_t uKey = 0; uKey < ptTrack->uKeyCount; uKey++)
+        {
+            for(uint32_t k = 0; k < uStride; k++)
+                sbtSource[uKey].d[k] = uKey * uStride + k < uAvailable ? ptData->sbfKeyFrameData[uKey * uStride + k] : 0.0f;
+        }
+
+        const float fTolerance = ptChannel->tPath == PL_ANIMATION_PATH_TRANSLATION ? ptCompression->fTranslationTolerance :
+            (bRotation ? ptCompression->fRotationTolerance : ptCompression->fScaleTolerance);
+        pl__ecs_compress_channel(ptClip, sbuChannelTracks[i], ptClip->sbuChannelLanes[i], bRotation, ptSampler->tMode == PL_ANIMATION_MODE_STEP, sbtSource, fTolerance);
+    }
+    pl_sb_free(sbtSource);
+    pl_sb_free(sbuChannelTracks);
+    pl_sb_free(sbbChannelCompressed);
+    return ptClip;
+}
+
+// samples every track into sbfSamples (one loop over all lanes of a track)
+static void
+pl__ecs_sample_animation_clip(plAnimationClip* ptClip, float fTime)
+{
+    const uint32_t uTrackCount = pl_sb_size(ptClip->sbtTracks);
+    for(uint32_t j = 0; j < uTrackCount; j++)
+    {
+        plAnimationTrack* ptTrack = &ptClip->sbtTracks[j];
+        const float* afTimes = &ptClip->sbfTimes[ptTrack->uTimeOffset];
+        const float* afValues = &ptClip->sbfValues[ptTrack->uValueOffset];
+        float* afResult = &ptClip->sbfSamples[ptTrack->uLaneOffset];
+        const uint32_t uLaneCount = ptTrack->uLaneCount;
+        const uint32_t uKeyCount = ptTrack->uKeyCount;
+
+        if(uLaneCount == 0) // only compressed channels
+            continue;
+
+        if(uKeyCount == 1) // constant
+        {
+            const uint32_t uValueSection = ptTrack->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE ? 1 : 0;
+            memcpy(afResult, &afValues[uValueSection * uLaneCount], sizeof(float) * uLaneCount);
+            continue;
+        }
+
+        // make sure that t is never earlier than the first keyframe and never later then the last keyframe.
+        const float fModTime = pl_clampf(afTimes[0], fTime, afTimes[uKeyCount - 1]);
+        const uint32_t uNextKey = (uint32_t)pl_clampi(1, (int)pl__ecs_find_next_key(afTimes, uKeyCount, fModTime, &ptTrack->uCursor), (int)uKeyCount - 1);
+        const uint32_t uPrevKey = uNextKey - 1;
+
+        const float fKeyDelta = afTimes[uNextKey] - afTimes[uPrevKey];
+
+        // normalize t: [t0, t1] -> [0, 1]
+        const float fTn = (fModTime - afTimes[uPrevKey]) / fKeyDelta;
+
+        const float fTSq = fTn * fTn;
+        const float fTCub = fTSq * fTn;
+
+        if(ptTrack->tMode == PL_ANIMATION_MODE_LINEAR)
+        {
+            const float* afPrev = &afValues[uPrevKey * uLaneCount];
+            const float* afNext = &afValues[uNextKey * uLaneCount];
+            for(uint32_t k = 0; k < ptTrack->uVectorLaneCount; k++)
+                afResult[k] = afPrev[k] * (1.0f - fTn) + afNext[k] * fTn;
+            for(uint32_t k = ptTrack->uVectorLaneCount; k < uLaneCount; k += 4)
+                *(plVec4*)&afResult[k] = pl_quat_slerp(*(const plVec4*)&afPrev[k], *(const plVec4*)&afNext[k], fTn);
+        }
+
+        else if(ptTrack->tMode == PL_ANIMATION_MODE_STEP)
+        {
+            memcpy(afResult, &afValues[uPrevKey * uLaneCount], sizeof(float) * uLaneCount);
+        }
+
+        else if(ptTrack->tMode == PL_ANIMATION_MODE_CUBIC_SPLINE)
+        {
+            // keyframes are stored as (in-tangent, value, out-tangent)
+            const float* afPrev = &afValues[uPrevKey * uLaneCount * 3];
+            const float* afNext = &afValues[uNextKey * uLaneCount * 3];
+            const float* afV0 = &afPrev[uLaneCount];
+            const float* afB  = &afPrev[uLaneCount * 2];
+            const float* afA  = afNext;
+            const float* afV1 = &afNext[uLaneCount];
+            for(uint32_t k = 0; k < uLaneCount; k++)
+            {
+                const float v0 = afV0[k];
+                const float a = fKeyDelta * afA[k];
+                const float b = fKeyDelta * afB[k];
+                const float v1 = afV1[k];
+                afResult[k] = ((2 * fTCub - 3 * fTSq + 1) * v0) + ((fTCub - 2 * fTSq + fTn) * b) + ((-2 * fTCub + 3 * fTSq) * v1) + ((fTCub - fTSq) * a);
+            }
+        }
+
+        else
+            memset(afResult, 0, sizeof(float) * uLaneCount);
+    }
+
+    const uint32_t uCompressedCount = pl_sb_size(ptClip->sbtCompressedChannels);
+    for(uint32_t i = 0; i < uCompressedCount; i++)
+        pl__ecs_sample_compressed_channel(ptClip, &ptClip->sbtCompressedChannels[i], fTime);
+}
+
+static inline plVec4
+pl__ecs_get_channel_sample(const plAnimationClip* ptClip, const plAnimationChannel* ptChannel, uint32_t uChannel)
+{
+    const float* pfSample = &ptClip->sbfSamples[ptClip->sbuChannelLanes[uChannel]];
+    if(ptChannel->tPath == PL_ANIMATION_PATH_ROTATION)
+        return *(const plVec4*)pfSample;
+    return (plVec4){pfSample[0], pfSample[1], pfSample[2], 0.0f};
+}
+
+static void
+pl__ecs_apply_channel(plTransformComponent* ptTransform, plAnimationPath tPath, plVec4 tValue, float fBlendAmount)
+{
+    switch(tPath)
+    {
+        case PL_ANIMATION_PATH_TRANSLATION:
+            ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tValue.xyz, fBlendAmount);
+            break;
+
+        case PL_ANIMATION_PATH_SCALE:
+            ptTransform->tScale = tValue.xyz;
+            break;
+
+        case PL_ANIMATION_PATH_ROTATION:
+            ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tValue, fBlendAmount);
+            break;
+    }
+}
+
+// advances the animation timer, returns false if nothing should be applied this frame
+static bool
+pl__ecs_advance_animation(plAnimationComponent* ptAnimationComponent, float fDeltaTime)
+{
+    if(!(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_PLAYING))
+        return false;
+
+    ptAnimationComponent->fTimer += fDeltaTime;
+
+    if(ptAnimationComponent->tFlags & PL_ANIMATION_FLAG_LOOPED)
+    {
+        ptAnimationComponent->fTimer = fmodf(ptAnimationComponent->fTimer, ptAnimationComponent->fEnd);
+    }
+
+    if(ptAnimationComponent->fTimer > ptAnimationComponent->fEnd)
+    {
+        ptAnimationComponent->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
+        ptAnimationComponent->fTimer = 0.0f;
+        return false;
+    }
+    return true;
+}
+
+// true if two playing animations have a channel targeting the same entity
+static bool
+pl__ecs_animations_share_targets(plComponentLibrary* ptLibrary)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
+    const uint32_t uComponentCount = pl_sb_size(ptLibrary->tAnimationComponentManager.sbtEntities);
+    const uint32_t uEntityCount = pl_sb_size(ptLibrary->sbtEntityGenerations);
+
+    if(pl_sb_size(ptData->sbuAnimationTargetMarks) < uEntityCount)
+    {
+        const uint32_t uOldMarkCount = pl_sb_size(ptData->sbuAnimationTargetMarks);
+        pl_sb_resize(ptData->sbuAnimationTargetMarks, uEntityCount);
+        memset(&ptData->sbuAnimationTargetMarks[uOldMarkCount], 0, sizeof(uint64_t) * (uEntityCount - uOldMarkCount));
+    }
+    const uint64_t uRun = ++ptData->uAnimationRun;
+
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        if(!(sbtComponents[i].tFlags & PL_ANIMATION_FLAG_PLAYING))
+            continue;
+
+        const uint32_t uChannelCount = pl_sb_size(sbtComponents[i].sbtChannels);
+        for(uint32_t j = 0; j < uChannelCount; j++)
+        {
+            const uint32_t uTarget = sbtComponents[i].sbtChannels[j].tTarget.uIndex;
+            if(uTarget >= uEntityCount)
+                continue;
+            const uint64_t uMark = ptData->sbuAnimationTargetMarks[uTarget];
+            if((uMark >> 32) == uRun && (uint32_t)uMark != i)
+                return true;
+            ptData->sbuAnimationTargetMarks[uTarget] = (uRun << 32) | i;
+        }
+    }
+    return false;
+}
+
+static void
+pl__animation_update_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
+    plAnimationComponent* ptAnimationComponent = &sbtComponents[uJobIndex];
+    plAnimationClip* ptClip = ptAnimationComponent->_ptClip;
+
+    const bool bActive = pl__ecs_advance_animation(ptAnimationComponent, ptData->fAnimationDeltaTime);
+    if(bActive)
+        pl__ecs_sample_animation_clip(ptClip, ptAnimationComponent->fTimer);
+
+    const uint32_t uChannelCount = pl_sb_size(ptAnimationComponent->sbtChannels);
+    for(uint32_t j = 0; j < uChannelCount && bActive; j++)
+    {
+        if(ptClip->sbuChannelLanes[j] == UINT32_MAX) // not sampled
+            continue;
+
+        const plAnimationChannel* ptChannel = &ptAnimationComponent->sbtChannels[j];
+        const plVec4 tValue = pl__ecs_get_channel_sample(ptClip, ptChannel, j);
+
+        if(ptData->bAnimationOrdered) // applied serially after all jobs finish
+            ptData->sbtAnimationSamples[ptData->sbuAnimationSampleOffsets[uJobIndex] + j] = tValue;
+        else
+        {
+            plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptChannel->tTarget);
+            pl__ecs_apply_channel(ptTransform, ptChannel->tPath, tValue, ptAnimationComponent->fBlendAmount);
+        }
+    }
+
+    if(ptData->bAnimationOrdered)
+        ptData->sbbAnimationActive[uJobIndex] = bActive;
+}
+
+static void
+pl_run_animation_update_system(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+    plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    ptData->fAnimationDeltaTime = fDeltaTime;
+    
+    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
+
+    // channel data is packed on first use (allocations stay out of the jobs)
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        if(sbtComponents[i]._ptClip == NULL)
+            sbtComponents[i]._ptClip = pl__ecs_build_animation_clip(ptLibrary, &sbtComponents[i], NULL);
+    }
+
+    // blends read & write their targets, so playing animations sharing a target
+    // can't be applied from the jobs; those runs (& every deterministic mode or
+    // fixed step run) sample into scratch & apply serially in component order instead
+    ptData->bAnimationOrdered = ptData->bDeterministic || ptData->bFixedStep || pl__ecs_animations_share_targets(ptLibrary);
+
+    // ordered runs: reserve a sample slot per channel
+    if(ptData->bAnimationOrdered)
+    {
+        uint32_t uSampleCount = 0;
+        pl_sb_resize(ptData->sbuAnimationSampleOffsets, uComponentCount);
+        pl_sb_resize(ptData->sbbAnimationActive, uComponentCount);
+        for(uint32_t i = 0; i < uComponentCount; i++)
+        {
+            ptData->sbuAnimationSampleOffsets[i] = uSampleCount;
+            uSampleCount += pl_sb_size(sbtComponents[i].sbtChannels);
+        }
+        pl_sb_resize(ptData->sbtAnimationSamples, uSampleCount);
+    }
+
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__animation_update_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(uComponentCount, PL_ECS_ANIMATION_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    // ordered runs: apply in component order so animations sharing targets
+    //               blend exactly as a serial update would
+    if(ptData->bAnimationOrdered)
+    {
+        for(uint32_t i = 0; i < uComponentCount; i++)
+        {
+            if(!ptData->sbbAnimationActive[i])
+                continue;
+
+            const plAnimationComponent* ptAnimationComponent = &sbtComponents[i];
+            const uint32_t uChannelCount = pl_sb_size(ptAnimationComponent->sbtChannels);
+            for(uint32_t j = 0; j < uChannelCount; j++)
+            {
+                if(ptAnimationComponent->_ptClip->sbuChannelLanes[j] == UINT32_MAX)
+                    continue;
+                const plAnimationChannel* ptChannel = &ptAnimationComponent->sbtChannels[j];
+                plTransformComponent* ptTransform = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptChannel->tTarget);
+                pl__ecs_apply_channel(ptTransform, ptChannel->tPath, ptData->sbtAnimationSamples[ptData->sbuAnimationSampleOffsets[i] + j], ptAnimationComponent->fBlendAmount);
+            }
+        }
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_ecs_set_deterministic(plComponentLibrary* ptLibrary, bool bDeterministic)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    ptData->bDeterministic = bDeterministic;
+}
+
+static void
+pl_ecs_invalidate_animation_cache(plComponentLibrary* ptLibrary, plEntity tAnimation)
+{
+    plAnimationComponent* ptAnimation = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tAnimation);
+    if(ptAnimation)
+        pl__ecs_free_animation_clip(&ptAnimation->_ptClip);
+}
+
+static void
+pl_ecs_compress_animation(plComponentLibrary* ptLibrary, plEntity tAnimation, const plAnimationCompressionDesc* ptDesc)
+{
+    plAnimationComponent* ptAnimation = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tAnimation);
+    if(ptAnimation == NULL)
+        return;
+
+    static const plAnimationCompressionDesc tDefaultDesc = {
+        .fTranslationTolerance = PL_ECS_ANIMATION_TOLERANCE,
+        .fRotationTolerance    = PL_ECS_ANIMATION_TOLERANCE,
+        .fScaleTolerance       = PL_ECS_ANIMATION_TOLERANCE
+    };
+    pl__ecs_free_animation_clip(&ptAnimation->_ptClip);
+    ptAnimation->_ptClip = pl__ecs_build_animation_clip(ptLibrary, ptAnimation, ptDesc ? ptDesc : &tDefaultDesc);
+}
+
+static void
+pl__ecs_manager_remove(plComponentLibrary* ptLibrary, plComponentType tType, uint32_t uIndex)
+{
+    plComponentManager* ptManager = ptLibrary->_ptManagers[tType];
+    const plEntity tEntity = ptManager->sbtEntities[uIndex];
+    const uint32_t uLastIndex = pl_sb_size(ptManager->sbtEntities) - 1;
+
+    pl_hm_remove(ptManager->ptHashmap, tEntity.uIndex);
+    pl_hm_get_free_index(ptManager->ptHashmap); // burn slot
+    ptLibrary->sbtEntitySignatures[tEntity.uIndex] &= ~PL_COMPONENT_MASK(tType);
+
+    // must keep valid entities contiguous (move last entity into removed slot)
+    plEntity tMovedEntity = {UINT32_MAX, UINT32_MAX};
+    if(uIndex < uLastIndex)
+    {
+        tMovedEntity = ptManager->sbtEntities[uLastIndex];
+        pl_hm_remove(ptManager->ptHashmap, tMovedEntity.uIndex);
+        pl_hm_get_free_index(ptManager->ptHashmap); // burn slot
+        pl_hm_insert(ptManager->ptHashmap, tMovedEntity.uIndex, uIndex);
+
+        unsigned char* pucComponents = ptManager->pComponents;
+        ptManager->sbtEntities[uIndex] = tMovedEntity;
+        memcpy(&pucComponents[uIndex * ptManager->szStride], &pucComponents[uLastIndex * ptManager->szStride], ptManager->szStride);
+    }
+    pl_sb_pop(ptManager->sbtEntities);
+    pl_sb_pop_n(ptManager->pComponents, 1); // untyped, so only the size is touched
+
+    pl__ecs_query_on_remove(ptLibrary, tType, tEntity, tMovedEntity, uIndex);
+    if(tMovedEntity.uIndex != UINT32_MAX)
+        pl__ecs_mark_changed(ptLibrary, tType, uIndex);
+}
+
+static void
+pl__ecs_mark_changed(plComponentLibrary* ptLibrary, plComponentType tType, uint32_t uIndex)
+{
+    // components that are new or moved to a new dense index have no valid cache entry
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    if(tType == PL_COMPONENT_TYPE_TRANSFORM)
+        pl__ecs_bit_set(&ptData->sbuTransformForce, uIndex);
+    else if(tType == PL_COMPONENT_TYPE_OBJECT)
+        pl__ecs_bit_set(&ptData->sbuObjectForce, uIndex);
+}
+
+static const uint64_t*
+pl_ecs_get_changed_bitset(plComponentLibrary* ptLibrary, plComponentType tType, uint32_t* puCountOut)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    if(tType == PL_COMPONENT_TYPE_TRANSFORM)
+    {
+        *puCountOut = pl_sb_size(ptData->sbtTransformCache);
+        return ptData->sbuTransformChanged;
+    }
+    if(tType == PL_COMPONENT_TYPE_OBJECT)
+    {
+        *puCountOut = pl_sb_size(ptData->sbtObjectCache);
+        return ptData->sbuObjectChanged;
+    }
+    PL_ASSERT(false && "change tracking is only available for transforms & objects");
+    *puCountOut = 0;
+    return NULL;
+}
+
+static void
+pl_ecs_mark_transform_dirty(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    if(!pl_ecs_has_entity(&ptLibrary->tTransformComponentManager, tEntity))
+        return;
+    pl__ecs_mark_changed(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, (uint32_t)pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tEntity));
+}
+
+#define PL__ECS_MAX_IK_JOINTS 32 // effector + max chain length
+
+// rotates a vector by a unit quaternion
+static inline plVec3
+pl__ecs_rotate_vec3(plVec4 tQ, plVec3 tV)
+{
+    const plVec3 tT = pl_mul_vec3_scalarf(pl_cross_vec3(tQ.xyz, tV), 2.0f);
+    return pl_add_vec3(pl_add_vec3(tV, pl_mul_vec3_scalarf(tT, tQ.w)), pl_cross_vec3(tQ.xyz, tT));
+}
+
+// shortest arc rotation taking unit vector a onto unit vector b (identity if either is zero)
+static inline plVec4
+pl__ecs_rotation_between(plVec3 tA, plVec3 tB)
+{
+    const float fDot = pl_dot_vec3(tA, tB);
+    if(fDot < -0.999999f)
+    {
+        // opposite, any perpendicular axis works
+        plVec3 tAxis = pl_cross_vec3((plVec3){1.0f, 0.0f, 0.0f}, tA);
+        if(pl_length_sqr_vec3(tAxis) < 0.000001f)
+            tAxis = pl_cross_vec3((plVec3){0.0f, 1.0f, 0.0f}, tA);
+        tAxis = pl_norm_vec3(tAxis);
+        return pl_create_vec4(tAxis.x, tAxis.y, tAxis.z, 0.0f);
+    }
+    const plVec3 tCross = pl_cross_vec3(tA, tB);
+    return pl_norm_vec4(pl_create_vec4(tCross.x, tCross.y, tCross.z, 1.0f + fDot));
+}
+
+// chain entries are the effector followed by its ancestors (at most uChainLength, stops at a
+// joint without parent transform)
+static void
+pl__ecs_build_ik_chain(plComponentLibrary* ptLibrary, plEntity tEffector, const plInverseKinematicsComponent* ptIK, plIKChain* ptChain)
+{
+    ptChain->tEffector = tEffector;
+    ptChain->uLength = ptIK->uChainLength;
+    ptChain->uTarget = UINT32_MAX;
+    pl_sb_reset(ptChain->sbtJoints);
+
+    const uint32_t uMaxJoints = pl_minu(ptIK->uChainLength + 1, PL__ECS_MAX_IK_JOINTS);
+    plEntity tCurrent = tEffector;
+    pl_sb_reserve(ptChain->sbtJoints, uMaxJoints);
+    pl_sb_push(ptChain->sbtJoints, tCurrent);
+    while(pl_sb_size(ptChain->sbtJoints) < uMaxJoints)
+    {
+        const plHierarchyComponent* ptHierarchy = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tCurrent);
+        if(ptHierarchy == NULL || pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptHierarchy->tParent) == NULL)
+            break;
+        tCurrent = ptHierarchy->tParent;
+        pl_sb_push(ptChain->sbtJoints, tCurrent);
+    }
+    pl_sb_resize(ptChain->sbuJoints, pl_sb_size(ptChain->sbtJoints));
+}
+
+// refreshes the chain's transform indices; false if the hierarchy no longer matches it
+static bool
+pl__ecs_refresh_ik_chain(plComponentLibrary* ptLibrary, plIKChain* ptChain)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plEcsQuery* ptQuery = ptData->ptHierarchyQuery;
+    const plHierarchyComponent* sbtHierarchy = ptLibrary->tHierarchyComponentManager.pComponents;
+    const uint32_t uJointCount = pl_sb_size(ptChain->sbtJoints);
+    const bool bTruncated = uJointCount < pl_minu(ptChain->uLength + 1, PL__ECS_MAX_IK_JOINTS);
+    for(uint32_t i = 0; i < uJointCount; i++)
+    {
+        const plEntity tJoint = ptChain->sbtJoints[i];
+        const bool bLast = i + 1 == uJointCount;
+        const uint32_t uRow = tJoint.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tJoint.uIndex] : UINT32_MAX;
+
+        // only the last joint may lack a parent (& only if the chain was cut short there)
+        if(uRow == UINT32_MAX || ptQuery->sbtEntities[uRow].ulData != tJoint.ulData)
+        {
+            if(!bLast || pl__ecs_cached_transform(ptLibrary, tJoint, &ptChain->sbuJoints[i]) == NULL)
+                return false;
+            continue;
+        }
+
+        const plEntity tParent = sbtHierarchy[ptQuery->sbuIndices[0][uRow]].tParent;
+        if(bLast)
+        {
+            if(bTruncated && pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tParent) != NULL)
+                return false;
+        }
+        else if(tParent.ulData != ptChain->sbtJoints[i + 1].ulData)
+            return false;
+        ptChain->sbuJoints[i] = ptQuery->sbuIndices[1][uRow];
+    }
+    return true;
+}
+
+// cyclic coordinate descent: each joint (effector's parent first) rotates the part of the chain
+// below it so the effector points at the target
+static void
+pl__ecs_solve_ik_ccd(const plInverseKinematicsComponent* ptIK, uint32_t uJointCount, plVec3 tTarget, plVec3* atPositions, plVec4* atRotations)
+{
+    const float fToleranceSq = ptIK->fTolerance * ptIK->fTolerance;
+    for(uint32_t uIteration = 0; uIteration < ptIK->uIterationCount; uIteration++)
+    {
+        if(pl_length_sqr_vec3(pl_sub_vec3(atPositions[0], tTarget)) <= fToleranceSq)
+            break;
+
+        for(uint32_t i = 1; i < uJointCount; i++)
+        {
+            const plVec3 tToEffector = pl_norm_vec3(pl_sub_vec3(atPositions[0], atPositions[i]));
+            const plVec3 tToTarget = pl_norm_vec3(pl_sub_vec3(tTarget, atPositions[i]));
+            const plVec4 tQ = pl__ecs_rotation_between(tToEffector, tToTarget);
+            for(uint32_t j = 0; j < i; j++)
+                atPositions[j] = pl_add_vec3(atPositions[i], pl__ecs_rotate_vec3(tQ, pl_sub_vec3(atPositions[j], atPositions[i])));
+            for(uint32_t j = 0; j <= i; j++)
+                atRotations[j] = pl_norm_vec4(pl_mul_quat(tQ, atRotations[j]));
+        }
+    }
+}
+
+// forward & backward reaching: joints are moved onto the target & back onto the root keeping
+// bone lengths, then each joint's rotation is the shortest arc onto its new bone direction
+static void
+pl__ecs_solve_ik_fabrik(const plInverseKinematicsComponent* ptIK, uint32_t uJointCount, plVec3 tTarget, plVec3* atPositions, plVec4* atRotations)
+{
+    plVec3 atSource[PL__ECS_MAX_IK_JOINTS];
+    float afLengths[PL__ECS_MAX_IK_JOINTS];
+    float fTotalLength = 0.0f;
+    const uint32_t uRoot = uJointCount - 1;
+    for(uint32_t i = 0; i < uJointCount; i++)
+    {
+        atSource[i] = atPositions[i];
+        if(i < uRoot)
+        {
+            afLengths[i] = pl_length_vec3(pl_sub_vec3(atPositions[i], atPositions[i + 1]));
+            fTotalLength += afLengths[i];
+        }
+    }
+
+    const plVec3 tRoot = atPositions[uRoot];
+    const float fToleranceSq = ptIK->fTolerance * ptIK->fTolerance;
+    if(pl_length_vec3(pl_sub_vec3(tTarget, tRoot)) >= fTotalLength)
+    {
+        // out of reach, stretch toward the target
+        const plVec3 tDirection = pl_norm_vec3(pl_sub_vec3(tTarget, tRoot));
+        for(uint32_t i = uRoot; i > 0; i--)
+            atPositions[i - 1] = pl_add_vec3(atPositions[i], pl_mul_vec3_scalarf(tDirection, afLengths[i - 1]));
+    }
+    else
+    {
+        for(uint32_t uIteration = 0; uIteration < ptIK->uIterationCount; uIteration++)
+        {
+            if(pl_length_sqr_vec3(pl_sub_vec3(atPositions[0], tTarget)) <= fToleranceSq)
+                break;
+
+            // backward (effector onto the target)
+            atPositions[0] = tTarget;
+            for(uint32_t i = 1; i < uJointCount; i++)
+                atPositions[i] = pl_add_vec3(atPositions[i - 1], pl_mul_vec3_scalarf(pl_norm_vec3(pl_sub_vec3(atPositions[i], atPositions[i - 1])), afLengths[i - 1]));
+
+            // forward (root back in place)
+            atPositions[uRoot] = tRoot;
+            for(uint32_t i = uRoot; i > 0; i--)
+                atPositions[i - 1] = pl_add_vec3(atPositions[i], pl_mul_vec3_scalarf(pl_norm_vec3(pl_sub_vec3(atPositions[i - 1], atPositions[i])), afLengths[i - 1]));
+        }
+    }
+
+    // rotations from the root down (children inherit their parent's rotation)
+    plVec4 tParentRotation = pl_create_vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    for(uint32_t i = uRoot; i > 0; i--)
+    {
+        const plVec3 tSourceBone = pl__ecs_rotate_vec3(tParentRotation, pl_norm_vec3(pl_sub_vec3(atSource[i - 1], atSource[i])));
+        const plVec3 tBone = pl_norm_vec3(pl_sub_vec3(atPositions[i - 1], atPositions[i]));
+        atRotations[i] = pl_norm_vec4(pl_mul_quat(pl__ecs_rotation_between(tSourceBone, tBone), tParentRotation));
+        tParentRotation = atRotations[i];
+    }
+    atRotations[0] = tParentRotation;
+}
+
+static void
+pl__ik_solve_job(uint32_t uJobIndex, void* pData)
+{
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    const plInverseKinematicsComponent* sbtComponents = ptLibrary->tInverseKinematicsComponentManager.pComponents;
+
+    const uint32_t uIKIndex = ptData->sbuIKSolveList[uJobIndex];
+    const plInverseKinematicsComponent* ptIK = &sbtComponents[uIKIndex];
+    const plIKChain* ptChain = &ptData->sbtIKChains[uIKIndex];
+    const uint32_t uJointCount = pl_sb_size(ptChain->sbuJoints);
+
+    plVec3 atPositions[PL__ECS_MAX_IK_JOINTS];
+    plVec4 atRotations[PL__ECS_MAX_IK_JOINTS];
+    for(uint32_t i = 0; i < uJointCount; i++)
+    {
+        atPositions[i] = sbtTransforms[ptChain->sbuJoints[i]].tWorld.col[3].xyz;
+        atRotations[i] = pl_create_vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    const plVec3 tTarget = sbtTransforms[ptChain->uTarget].tWorld.col[3].xyz;
+    if(ptIK->tSolver == PL_IK_SOLVER_FABRIK)
+        pl__ecs_solve_ik_fabrik(ptIK, uJointCount, tTarget, atPositions, atRotations);
+    else
+        pl__ecs_solve_ik_ccd(ptIK, uJointCount, tTarget, atPositions, atRotations);
+
+    // new world matrices (world space rotation about each joint), root first
+    plMat4 atWorld[PL__ECS_MAX_IK_JOINTS];
+    for(uint32_t i = uJointCount; i > 0; i--)
+    {
+        plTransformComponent* ptTransform = &sbtTransforms[ptChain->sbuJoints[i - 1]];
+        const plMat4 tRotation = pl_mat4_rotate_quat(atRotations[i - 1]);
+        atWorld[i - 1] = pl_mul_mat4(&tRotation, &ptTransform->tWorld);
+        atWorld[i - 1].col[3] = pl_create_vec4(atPositions[i - 1].x, atPositions[i - 1].y, atPositions[i - 1].z, 1.0f);
+    }
+
+    // local matrices of the rotated joints are overridden in the transform cache (hierarchy
+    // propagation then rebuilds everything below them), the root keeps its parent's world
+    for(uint32_t i = uJointCount - 1; i > 0; i--)
+    {
+        const uint32_t uIndex = ptChain->sbuJoints[i];
+        plTransformCache* ptCache = &ptData->sbtTransformCache[uIndex];
+        if(i == uJointCount - 1)
+        {
+            const plMat4 tInverseWorld = pl_mat4_invert(&sbtTransforms[uIndex].tWorld);
+            const plMat4 tInverseParent = pl_mul_mat4(&ptCache->tLocal, &tInverseWorld);
+            ptCache->tLocal = pl_mul_mat4(&tInverseParent, &atWorld[i]);
+        }
+        else
+        {
+            const plMat4 tInverseParent = pl_mat4_invert(&atWorld[i + 1]);
+            ptCache->tLocal = pl_mul_mat4(&tInverseParent, &atWorld[i]);
+        }
+    }
+    for(uint32_t i = 0; i < uJointCount; i++)
+        sbtTransforms[ptChain->sbuJoints[i]].tWorld = atWorld[i];
+}
+
+// earliest wave a chain using this transform can be solved in (after the last chain using it)
+static inline uint32_t
+pl__ecs_ik_wave(const plComponentLibraryData* ptData, uint32_t uTransform)
+{
+    const uint64_t uMark = ptData->sbuIKMarks[uTransform];
+    if((uint32_t)(uMark >> 32) == ptData->uIKRun)
+        return (uint32_t)uMark + 1;
+    return 0;
+}
+
+static void
+pl_run_inverse_kinematics_update_system(plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plInverseKinematicsComponent* sbtComponents = ptLibrary->tInverseKinematicsComponentManager.pComponents;
+    const uint32_t uComponentCount = pl_sb_size(sbtComponents);
+    const uint32_t uTransformCount = pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities);
+
+    // chains follow the IK component's dense index & are only rebuilt when the hierarchy changed
+    const uint32_t uOldChainCount = pl_sb_size(ptData->sbtIKChains);
+    if(uComponentCount > uOldChainCount)
+    {
+        pl_sb_add_n(ptData->sbtIKChains, uComponentCount - uOldChainCount);
+        memset(&ptData->sbtIKChains[uOldChainCount], 0, sizeof(plIKChain) * (uComponentCount - uOldChainCount));
+    }
+    if(pl_sb_size(ptData->sbuIKMarks) < uTransformCount)
+    {
+        const uint32_t uOldMarkCount = pl_sb_size(ptData->sbuIKMarks);
+        pl_sb_resize(ptData->sbuIKMarks, uTransformCount);
+        memset(&ptData->sbuIKMarks[uOldMarkCount], 0, sizeof(uint64_t) * (uTransformCount - uOldMarkCount));
+    }
+    ptData->uIKRun++;
+
+    // waves: chains sharing transforms (joints or targets) with an earlier chain wait for it
+    uint32_t uWaveCount = 0;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        const plInverseKinematicsComponent* ptIK = &sbtComponents[i];
+        plIKChain* ptChain = &ptData->sbtIKChains[i];
+        ptChain->uWave = UINT32_MAX;
+        if(!ptIK->bEnabled || ptIK->uChainLength == 0 || ptIK->uIterationCount == 0)
+            continue;
+
+        const plEntity tEntity = ptLibrary->tInverseKinematicsComponentManager.sbtEntities[i];
+        if(ptChain->tEffector.ulData != tEntity.ulData || ptChain->uLength != ptIK->uChainLength || !pl__ecs_refresh_ik_chain(ptLibrary, ptChain))
+        {
+            pl__ecs_build_ik_chain(ptLibrary, tEntity, ptIK, ptChain);
+            if(!pl__ecs_refresh_ik_chain(ptLibrary, ptChain))
+                continue;
+        }
+        const uint32_t uJointCount = pl_sb_size(ptChain->sbuJoints);
+        if(uJointCount < 2 || pl__ecs_cached_transform(ptLibrary, ptIK->tTarget, &ptChain->uTarget) == NULL)
+            continue;
+
+        uint32_t uWave = pl__ecs_ik_wave(ptData, ptChain->uTarget);
+        for(uint32_t j = 0; j < uJointCount; j++)
+            uWave = pl_maxu(uWave, pl__ecs_ik_wave(ptData, ptChain->sbuJoints[j]));
+        const uint64_t uMark = ((uint64_t)ptData->uIKRun << 32) | uWave;
+        ptData->sbuIKMarks[ptChain->uTarget] = uMark;
+        for(uint32_t j = 0; j < uJointCount; j++)
+            ptData->sbuIKMarks[ptChain->sbuJoints[j]] = uMark;
+        ptChain->uWave = uWave;
+        uWaveCount = pl_maxu(uWaveCount, uWave + 1);
+    }
+
+    const uint32_t uWordCount = (uTransformCount + 63) / 64;
+    pl__ecs_bits_reserve(&ptData->sbuTransformChanged, uTransformCount);
+    pl__ecs_bits_reserve(&ptData->sbuTransformForce, uTransformCount);
+    pl_sb_resize(ptData->sbuIKChangedCopy, uWordCount);
+    for(uint32_t uWave = 0; uWave < uWaveCount; uWave++)
+    {
+        pl_sb_reset(ptData->sbuIKSolveList);
+        for(uint32_t i = 0; i < uComponentCount; i++)
+        {
+            if(ptData->sbtIKChains[i].uWave == uWave)
+                pl_sb_push(ptData->sbuIKSolveList, i);
+        }
+
+        plAtomicCounter* ptCounter = NULL;
+        plJobDesc tJobDesc = {
+            .task  = pl__ik_solve_job,
+            .pData = ptLibrary
+        };
+        pl__ecs_dispatch_batch(pl_sb_size(ptData->sbuIKSolveList), PL_ECS_IK_BATCH_SIZE, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+
+        // only the rotated joints are marked, so hierarchy propagation just rebuilds their
+        // subtrees; earlier changes are restored afterwards
+        memcpy(ptData->sbuIKChangedCopy, ptData->sbuTransformChanged, sizeof(uint64_t) * uWordCount);
+        memset(ptData->sbuTransformChanged, 0, sizeof(uint64_t) * uWordCount);
+        for(uint32_t i = 0; i < pl_sb_size(ptData->sbuIKSolveList); i++)
+        {
+            const plIKChain* ptChain = &ptData->sbtIKChains[ptData->sbuIKSolveList[i]];
+            for(uint32_t j = 1; j < pl_sb_size(ptChain->sbuJoints); j++)
+            {
+                // overridden local matrices are rebuilt from local values next frame
+                pl__ecs_bit_set(&ptData->sbuTransformChanged, ptChain->sbuJoints[j]);
+                pl__ecs_bit_set(&ptData->sbuTransformForce, ptChain->sbuJoints[j]);
+            }
+        }
+        pl__ecs_propagate_hierarchy(ptLibrary);
+        for(uint32_t i = 0; i < uWordCount; i++)
+            ptData->sbuTransformChanged[i] |= ptData->sbuIKChangedCopy[i];
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_camera_set_fov(plCameraComponent* ptCamera, float fYFov)
+{
+    ptCamera->fFieldOfView = fYFov;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_set_clip_planes(plCameraComponent* ptCamera, float fNearZ, float fFarZ)
+{
+    ptCamera->fNearZ = fNearZ;
+    ptCamera->fFarZ = fFarZ;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_set_aspect(plCameraComponent* ptCamera, float fAspect)
+{
+    ptCamera->fAspectRatio = fAspect;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_set_pos(plCameraComponent* ptCamera, float fX, float fY, float fZ)
+{
+    ptCamera->tPos.x = fX;
+    ptCamera->tPos.y = fY;
+    ptCamera->tPos.z = fZ;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_set_pitch_yaw(plCameraComponent* ptCamera, float fPitch, float fYaw)
+{
+    ptCamera->fPitch = fPitch;
+    ptCamera->fYaw = fYaw;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_translate(plCameraComponent* ptCamera, float fDx, float fDy, float fDz)
+{
+    ptCamera->tPos = pl_add_vec3(ptCamera->tPos, pl_mul_vec3_scalarf(ptCamera->_tRightVec, fDx));
+    ptCamera->tPos = pl_add_vec3(ptCamera->tPos, pl_mul_vec3_scalarf(ptCamera->_tForwardVec, fDz));
+    ptCamera->tPos.y += fDy;
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_rotate(plCameraComponent* ptCamera, float fDPitch, float fDYaw)
+{
+    ptCamera->fPitch += fDPitch;
+    ptCamera->fYaw += fDYaw;
+
+    ptCamera->fYaw = pl__wrap_angle(ptCamera->fYaw);
+    ptCamera->fPitch = pl_clampf(0.995f * -PL_PI_2, ptCamera->fPitch, 0.995f * PL_PI_2);
+    ptCamera->uVersion++;
+}
+
+static void
+pl_camera_look_at(plCameraComponent* ptCamera, plVec3 tEye, plVec3 tTarget)
+{
+    const plVec3 tDirection = pl_norm_vec3(pl_sub_vec3(tTarget, tEye));
+    ptCamera->fYaw = atan2f(tDirection.x, tDirection.z);
+    ptCamera->fPitch = asinf(tDirection.y);
+    ptCamera->tPos = tEye;
+    ptCamera->uVersion++;
+}
+
+// inputs the cached matrices depend on (compared to catch direct writes)
+static inline void
+pl__camera_inputs(const plCameraComponent* ptCamera, float afInputsOut[13])
+{
+    afInputsOut[0]  = (float)ptCamera->tType;
+    afInputsOut[1]  = ptCamera->tPos.x;
+    afInputsOut[2]  = ptCamera->tPos.y;
+    afInputsOut[3]  = ptCamera->tPos.z;
+    afInputsOut[4]  = ptCamera->fNearZ;
+    afInputsOut[5]  = ptCamera->fFarZ;
+    afInputsOut[6]  = ptCamera->fFieldOfView;
+    afInputsOut[7]  = ptCamera->fAspectRatio;
+    afInputsOut[8]  = ptCamera->fWidth;
+    afInputsOut[9]  = ptCamera->fHeight;
+    afInputsOut[10] = ptCamera->fPitch;
+    afInputsOut[11] = ptCamera->fYaw;
+    afInputsOut[12] = ptCamera->fRoll;
+}
+
+static void
+pl_camera_update(plCameraComponent* ptCamera)
+{
+    float afInputs[13];
+    pl__camera_inputs(ptCamera, afInputs);
+    if(ptCamera->_uBuiltVersion != 0 && ptCamera->_uBuiltVersion == ptCamera->uVersion &&
+        memcmp(afInputs, ptCamera->_afBuiltInputs, sizeof(afInputs)) == 0)
+        return;
+    ptCamera->uVersion++;
+    ptCamera->_uBuiltVersion = ptCamera->uVersion;
+    memcpy(ptCamera->_afBuiltInputs, afInputs, sizeof(afInputs));
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~update view~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+    // world space
+    static const plVec4 tOriginalUpVec      = {0.0f, 1.0f, 0.0f, 0.0f};
+    static const plVec4 tOriginalForwardVec = {0.0f, 0.0f, 1.0f, 0.0f};
+    static const plVec4 tOriginalRightVec   = {-1.0f, 0.0f, 0.0f, 0.0f};
+
+    const plMat4 tXRotMat   = pl_mat4_rotate_vec3(ptCamera->fPitch, tOriginalRightVec.xyz);
+    const plMat4 tYRotMat   = pl_mat4_rotate_vec3(ptCamera->fYaw, tOriginalUpVec.xyz);
+    const plMat4 tZRotMat   = pl_mat4_rotate_vec3(ptCamera->fRoll, tOriginalForwardVec.xyz);
+    const plMat4 tTranslate = pl_mat4_translate_vec3((plVec3){ptCamera->tPos.x, ptCamera->tPos.y, ptCamera->tPos.z});
+
+    // rotations: rotY * rotX * rotZ
+    plMat4 tRotations = pl_mul_mat4t(&tXRotMat, &tZRotMat);
+    tRotations        = pl_mul_mat4t(&tYRotMat, &tRotations);
+
+    // update camera vectors
+    ptCamera->_tRightVec   = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalRightVec)).xyz;
+    ptCamera->_tUpVec      = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalUpVec)).xyz;
+    ptCamera->_tForwardVec = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalForwardVec)).xyz;
+
+    // update camera transform: translate * rotate
+    ptCamera->tTransformMat = pl_mul_mat4t(&tTranslate, &tRotations);
+
+    // update camera view matrix
+    ptCamera->tViewMat   = pl_mat4t_invert(&ptCamera->tTransformMat);
+
+    // flip x & y so camera looks down +z and remains right handed (+x to the right)
+    const plMat4 tFlipXY = pl_mat4_scale_xyz(-1.0f, -1.0f, 1.0f);
+    ptCamera->tViewMat   = pl_mul_mat4t(&tFlipXY, &ptCamera->tViewMat);
+
+    //~~~~~~~~~~~~~~~~~~~~~~~~~~~update projection~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    if(ptCamera->tType == PL_CAMERA_TYPE_PERSPECTIVE)
+    {
+        const float fInvtanHalfFovy = 1.0f / tanf(ptCamera->fFieldOfView / 2.0f);
+        ptCamera->tProjMat.col[0].x = fInvtanHalfFovy / ptCamera->fAspectRatio;
+        ptCamera->tProjMat.col[1].y = fInvtanHalfFovy;
+        ptCamera->tProjMat.col[2].z = ptCamera->fFarZ / (ptCamera->fFarZ - ptCamera->fNearZ);
+        ptCamera->tProjMat.col[2].w = 1.0f;
+        ptCamera->tProjMat.col[3].z = -ptCamera->fNearZ * ptCamera->fFarZ / (ptCamera->fFarZ - ptCamera->fNearZ);
+        ptCamera->tProjMat.col[3].w = 0.0f;  
+    }
+    else if(ptCamera->tType == PL_CAMERA_TYPE_ORTHOGRAPHIC)
+    {
+        ptCamera->tProjMat.col[0].x = 2.0f / ptCamera->fWidth;
+        ptCamera->tProjMat.col[1].y = 2.0f / ptCamera->fHeight;
+        ptCamera->tProjMat.col[2].z = 1 / (ptCamera->fFarZ - ptCamera->fNearZ);
+        ptCamera->tProjMat.col[3].w = 1.0f;
+    }
+}
+
+static const plCameraDerivedData*
+pl_camera_get_derived_data(plCameraComponent* ptCamera)
+{
+    pl_camera_update(ptCamera);
+    plCameraDerivedData* ptDerived = &ptCamera->tDerived;
+    if(ptDerived->uVersion == ptCamera->uVersion)
+        return ptDerived;
+    ptDerived->uVersion = ptCamera->uVersion;
+
+    ptDerived->fTanHalfFovY = 0.0f;
+    ptDerived->fTanHalfFovX = 0.0f;
+    if(ptCamera->tType == PL_CAMERA_TYPE_PERSPECTIVE)
+    {
+        ptDerived->fTanHalfFovY = tanf(0.5f * ptCamera->fFieldOfView);
+        ptDerived->fTanHalfFovX = ptDerived->fTanHalfFovY * ptCamera->fAspectRatio;
+    }
+
+    ptDerived->tViewProjMat = pl_mul_mat4(&ptCamera->tProjMat, &ptCamera->tViewMat);
+    ptDerived->tInvViewProjMat = pl_mat4_invert(&ptDerived->tViewProjMat);
+
+    // planes from the rows of the view projection matrix (0 to 1 clip depth)
+    const plMat4* ptM = &ptDerived->tViewProjMat;
+    plVec4 atRows[4];
+    for(uint32_t i = 0; i < 4; i++)
+        atRows[i] = (plVec4){ptM->col[0].d[i], ptM->col[1].d[i], ptM->col[2].d[i], ptM->col[3].d[i]};
+    ptDerived->atPlanes[0] = pl_add_vec4(atRows[3], atRows[0]);
+    ptDerived->atPlanes[1] = pl_sub_vec4(atRows[3], atRows[0]);
+    ptDerived->atPlanes[2] = pl_add_vec4(atRows[3], atRows[1]);
+    ptDerived->atPlanes[3] = pl_sub_vec4(atRows[3], atRows[1]);
+    ptDerived->atPlanes[4] = atRows[2];
+    ptDerived->atPlanes[5] = pl_sub_vec4(atRows[3], atRows[2]);
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const float fLength = pl_length_vec3(ptDerived->atPlanes[i].xyz);
+        if(fLength > 0.0f)
+            ptDerived->atPlanes[i] = pl_div_vec4_scalarf(ptDerived->atPlanes[i], fLength);
+    }
+
+    static const plVec3 atClipCorners[8] = {
+        { -1.0f,  1.0f, 0.0f },
+        { -1.0f, -1.0f, 0.0f },
+        {  1.0f, -1.0f, 0.0f },
+        {  1.0f,  1.0f, 0.0f },
+        { -1.0f,  1.0f, 1.0f },
+        { -1.0f, -1.0f, 1.0f },
+        {  1.0f, -1.0f, 1.0f },
+        {  1.0f,  1.0f, 1.0f },
+    };
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        const plVec4 tCorner = pl_mul_mat4_vec4(&ptDerived->tInvViewProjMat, (plVec4){.xyz = atClipCorners[i], .w = 1.0f});
+        ptDerived->atCorners[i] = pl_div_vec3_scalarf(tCorner.xyz, tCorner.w);
+    }
+    return ptDerived;
+}
+
+static void
+pl_camera_get_frustum_slice(plCameraComponent* ptCamera, float fStart, float fEnd, plVec3 atCornersOut[8])
+{
+    const plCameraDerivedData* ptDerived = pl_camera_get_derived_data(ptCamera);
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const plVec3 tEdge = pl_sub_vec3(ptDerived->atCorners[i + 4], ptDerived->atCorners[i]);
+        atCornersOut[i]     = pl_add_vec3(ptDerived->atCorners[i], pl_mul_vec3_scalarf(tEdge, fStart));
+        atCornersOut[i + 4] = pl_add_vec3(ptDerived->atCorners[i], pl_mul_vec3_scalarf(tEdge, fEnd));
+    }
+}
+
+static void
+pl_calculate_normals(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plMeshVectorWork* sbtWork = NULL;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[i];
+        if(pl_sb_size(ptMesh->sbtVertexNormals) > 0 || pl_sb_size(ptMesh->sbtVertexPositions) == 0 || pl_sb_size(ptMesh->sbuIndices) < 3)
+            continue;
+        pl_sb_resize(ptMesh->sbtVertexNormals, pl_sb_size(ptMesh->sbtVertexPositions));
+        const plMeshVectorWork tWork = {.ptMesh = ptMesh};
+        pl_sb_push(sbtWork, tWork);
+    }
+
+    const uint32_t uWorkCount = pl_sb_size(sbtWork);
+    if(uWorkCount > 0)
+    {
+        plMeshVectorJobData tJobData = {.atWork = sbtWork};
+        pl__ecs_run_mesh_jobs(&tJobData, uWorkCount, pl__ecs_mesh_prepare_job);
+        pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_TRIANGLES, pl__ecs_face_normal_job);
+        pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_VERTICES, pl__ecs_vertex_normal_job);
+        pl__ecs_cleanup_mesh_work(&tJobData);
+    }
+    pl_sb_free(sbtWork);
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount)
+{
+    pl_calculate_tangents_ex(atMeshes, uComponentCount, PL_TANGENT_MODE_FAST);
+}
+
+static void
+pl_calculate_tangents_ex(plMeshComponent* atMeshes, uint32_t uComponentCount, plTangentMode tMode)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    plMeshVectorWork* sbtWork = NULL;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        plMeshComponent* ptMesh = &atMeshes[i];
+        const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+        if(pl_sb_size(ptMesh->sbtVertexTangents) > 0 || uVertexCount == 0 || pl_sb_size(ptMesh->sbuIndices) < 3 ||
+            pl_sb_size(ptMesh->sbtVertexNormals) != uVertexCount || pl_sb_size(ptMesh->sbtVertexTextureCoordinates[0]) != uVertexCount)
+            continue;
+        pl_sb_resize(ptMesh->sbtVertexTangents, uVertexCount);
+        const plMeshVectorWork tWork = {.ptMesh = ptMesh, .tMode = tMode};
+        pl_sb_push(sbtWork, tWork);
+    }
+
+    const uint32_t uWorkCount = pl_sb_size(sbtWork);
+    if(uWorkCount > 0)
+    {
+        plMeshVectorJobData tJobData = {.atWork = sbtWork};
+        pl__ecs_run_mesh_jobs(&tJobData, uWorkCount, pl__ecs_mesh_prepare_job);
+        if(tMode == PL_TANGENT_MODE_MIKKTSPACE)
+        {
+            pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_TRIANGLES, pl__ecs_mikk_face_job);
+            pl__ecs_run_mesh_jobs(&tJobData, uWorkCount, pl__ecs_mikk_group_job);
+            pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_GROUPS, pl__ecs_mikk_eval_job);
+            pl__ecs_run_mesh_jobs(&tJobData, uWorkCount, pl__ecs_mikk_output_job);
+        }
+        else
+        {
+            pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_TRIANGLES, pl__ecs_face_tangent_job);
+            pl__ecs_run_mesh_range_jobs(&tJobData, PL__ECS_MESH_RANGE_VERTICES, pl__ecs_vertex_tangent_job);
+        }
+        pl__ecs_cleanup_mesh_work(&tJobData);
+    }
+    pl_sb_free(sbtWork);
+
+    pl_end_profile_sample(0);
+}
+
+static void
+pl__ecs_run_mesh_jobs(plMeshVectorJobData* ptJobData, uint32_t uWorkCount, void (*task)(uint32_t, void*))
+{
+    plAtomicCounter* ptCounter = NULL;
+    const plJobDesc tJobDesc = {
+        .task  = task,
+        .pData = ptJobData
+    };
+    pl__ecs_dispatch_batch(uWorkCount, 1, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
+
+static void
+pl__ecs_run_mesh_range_jobs(plMeshVectorJobData* ptJobData, uint32_t uRangeType, void (*task)(uint32_t, void*))
+{
+    // split every mesh's triangles/vertices/groups into ranges, so small meshes
+    // are a job each & large meshes are spread over many
+    pl_sb_reset(ptJobData->sbtRanges);
+    for(uint32_t i = 0; i < pl_sb_size(ptJobData->atWork); i++)
+    {
+        const plMeshVectorWork* ptWork = &ptJobData->atWork[i];
+        uint32_t uCount = ptWork->uTriangleCount;
+        if(uRangeType == PL__ECS_MESH_RANGE_VERTICES)
+            uCount = ptWork->uVertexCount;
+        else if(uRangeType == PL__ECS_MESH_RANGE_GROUPS)
+            uCount = ptWork->uGroupCount;
+        for(uint32_t uStart = 0; uStart < uCount; uStart += PL_ECS_MESH_RANGE_SIZE)
+        {
+            const plMeshVectorRange tRange = {
+                .uWork  = i,
+                .uStart = uStart,
+                .uEnd   = pl_min(uStart + PL_ECS_MESH_RANGE_SIZE, uCount)
+            };
+            pl_sb_push(ptJobData->sbtRanges, tRange);
+        }
+    }
+
+    const uint32_t uRangeCount = pl_sb_size(ptJobData->sbtRanges);
+    if(uRangeCount == 0)
+        return;
+
+    plAtomicCounter* ptCounter = NULL;
+    const plJobDesc tJobDesc = {
+        .task  = task,
+        .pData = ptJobData
+    };
+    pl__ecs_dispatch_batch(uRangeCount, 1, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
+
+static void
+pl__ecs_cleanup_mesh_work(plMeshVectorJobData* ptJobData)
+{
+    for(uint32_t i = 0; i < pl_sb_size(ptJobData->atWork); i++)
+    {
+        plMeshVectorWork* ptWork = &ptJobData->atWork[i];
+        PL_FREE(ptWork->auCornerStart);
+        PL_FREE(ptWork->auCorners);
+        PL_FREE(ptWork->atFaceS);
+        PL_FREE(ptWork->atFaceT);
+        PL_FREE(ptWork->auFaceFlags);
+        PL_FREE(ptWork->auWelded);
+        PL_FREE(ptWork->aiNeighbors);
+        PL_FREE(ptWork->auCornerGroup);
+        PL_FREE(ptWork->auGroupStart);
+        PL_FREE(ptWork->auGroupMembers);
+        PL_FREE(ptWork->auGroupVertex);
+        PL_FREE(ptWork->atGroupTangents);
+    }
+    pl_sb_free(ptJobData->sbtRanges);
+}
+
+static void
+pl__ecs_mesh_prepare_job(uint32_t uJobIndex, void* pData)
+{
+    plMeshVectorJobData* ptJobData = pData;
+    plMeshVectorWork* ptWork = &ptJobData->atWork[uJobIndex];
+    const plMeshComponent* ptMesh = ptWork->ptMesh;
+    const uint32_t* auIndices = ptMesh->sbuIndices;
+
+    ptWork->uTriangleCount = pl_sb_size(ptMesh->sbuIndices) / 3;
+    ptWork->uVertexCount   = pl_sb_size(ptMesh->sbtVertexPositions);
+    const uint32_t uCornerCount = ptWork->uTriangleCount * 3;
+    const uint32_t uVertexCount = ptWork->uVertexCount;
+
+    ptWork->atFaceS = PL_ALLOC(sizeof(plVec3) * ptWork->uTriangleCount);
+    ptWork->atFaceT = PL_ALLOC(sizeof(plVec3) * ptWork->uTriangleCount);
+
+    // vertex -> adjacent triangle corners (counting sort, corners ascending per vertex)
+    ptWork->auCornerStart = PL_ALLOC(sizeof(uint32_t) * (uVertexCount + 1));
+    ptWork->auCorners     = PL_ALLOC(sizeof(uint32_t) * uCornerCount);
+    uint32_t* auCornerStart = ptWork->auCornerStart;
+    memset(auCornerStart, 0, sizeof(uint32_t) * (uVertexCount + 1));
+    for(uint32_t i = 0; i < uCornerCount; i++)
+        auCornerStart[auIndices[i] + 1]++;
+    for(uint32_t i = 0; i < uVertexCount; i++)
+        auCornerStart[i + 1] += auCornerStart[i];
+    for(uint32_t i = uCornerCount; i > 0; i--) // auCornerStart[v + 1] ends up as start of v
+        ptWork->auCorners[--auCornerStart[auIndices[i - 1] + 1]] = i - 1;
+    memmove(auCornerStart, &auCornerStart[1], sizeof(uint32_t) * uVertexCount);
+    auCornerStart[uVertexCount] = uCornerCount;
+
+    if(ptWork->tMode != PL_TANGENT_MODE_MIKKTSPACE)
+        return;
+
+    // mikktspace treats vertices with equal position, normal & uv as one vertex
+    ptWork->auWelded    = PL_ALLOC(sizeof(uint32_t) * uVertexCount);
+    ptWork->auFaceFlags = PL_ALLOC(sizeof(uint32_t) * ptWork->uTriangleCount);
+    uint32_t uTableSize = 1;
+    while(uTableSize < uVertexCount * 2)
+        uTableSize *= 2;
+    uint32_t* auTable = PL_ALLOC(sizeof(uint32_t) * uTableSize);
+    memset(auTable, 0xff, sizeof(uint32_t) * uTableSize);
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        float afKey[8];
+        pl__ecs_mikk_vertex_key(ptMesh, i, afKey);
+        uint64_t uHash = 14695981039346656037ull;
+        const unsigned char* pucKey = (const unsigned char*)afKey;
+        for(uint32_t j = 0; j < sizeof(afKey); j++)
+            uHash = (uHash ^ pucKey[j]) * 1099511628211ull;
+
+        uint32_t uSlot = (uint32_t)uHash & (uTableSize - 1);
+        ptWork->auWelded[i] = i;
+        while(auTable[uSlot] != UINT32_MAX)
+        {
+            float afOther[8];
+            pl__ecs_mikk_vertex_key(ptMesh, auTable[uSlot], afOther);
+            if(memcmp(afKey, afOther, sizeof(afKey)) == 0)
+            {
+                ptWork->auWelded[i] = auTable[uSlot];
+                break;
+            }
+            uSlot = (uSlot + 1) & (uTableSize - 1);
+        }
+        if(ptWork->auWelded[i] == i)
+            auTable[uSlot] = i;
+    }
+    PL_FREE(auTable);
+
+    // triangles using a welded vertex twice are degenerate
+    for(uint32_t i = 0; i < ptWork->uTriangleCount; i++)
+    {
+        const uint32_t uIndex0 = ptWork->auWelded[auIndices[i * 3 + 0]];
+        const uint32_t uIndex1 = ptWork->auWelded[auIndices[i * 3 + 1]];
+        const uint32_t uIndex2 = ptWork->auWelded[auIndices[i * 3 + 2]];
+        ptWork->auFaceFlags[i] = (uIndex0 == uIndex1 || uIndex1 == uIndex2 || uIndex0 == uIndex2) ? PL__ECS_MIKK_DEGENERATE : 0;
+    }
+}
+
+static void
+pl__ecs_face_normal_job(uint32_t uJobIndex, void* pData)
+{
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    const plMeshComponent* ptMesh = ptWork->ptMesh;
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        const plVec3 tP0 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[i * 3 + 0]];
+        const plVec3 tP1 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[i * 3 + 1]];
+        const plVec3 tP2 = ptMesh->sbtVertexPositions[ptMesh->sbuIndices[i * 3 + 2]];
+
+        // unnormalized, so larger triangles weigh more
+        ptWork->atFaceS[i] = pl_cross_vec3(pl_sub_vec3(tP1, tP0), pl_sub_vec3(tP2, tP0));
+    }
+}
+
+static void
+pl__ecs_vertex_normal_job(uint32_t uJobIndex, void* pData)
+{
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    plMeshComponent* ptMesh = ptWork->ptMesh;
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        plVec3 tNormal = {0};
+        for(uint32_t j = ptWork->auCornerStart[i]; j < ptWork->auCornerStart[i + 1]; j++)
+            tNormal = pl_add_vec3(tNormal, ptWork->atFaceS[ptWork->auCorners[j] / 3]);
+
+        // unused & zero area vertices keep a zero normal
+        const float fLength = pl_length_vec3(tNormal);
+        ptMesh->sbtVertexNormals[i] = fLength > 0.0f ? pl_mul_vec3_scalarf(tNormal, 1.0f / fLength) : tNormal;
+    }
+}
+
+static void
+pl__ecs_face_tangent_job(uint32_t uJobIndex, void* pData)
+{
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    const plMeshComponent* ptMesh = ptWork->ptMesh;
+    const plVec2* atTexCoords = ptMesh->sbtVertexTextureCoordinates[0];
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        const uint32_t uIndex0 = ptMesh->sbuIndices[i * 3 + 0];
+        const uint32_t uIndex1 = ptMesh->sbuIndices[i * 3 + 1];
+        const uint32_t uIndex2 = ptMesh->sbuIndices[i * 3 + 2];
+
+        const plVec3 tEdge1 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex1], ptMesh->sbtVertexPositions[uIndex0]);
+        const plVec3 tEdge2 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex2], ptMesh->sbtVertexPositions[uIndex0]);
+
+        const float fDeltaU1 = atTexCoords[uIndex1].x - atTexCoords[uIndex0].x;
+        const float fDeltaV1 = atTexCoords[uIndex1].y - atTexCoords[uIndex0].y;
+        const float fDeltaU2 = atTexCoords[uIndex2].x - atTexCoords[uIndex0].x;
+        const float fDeltaV2 = atTexCoords[uIndex2].y - atTexCoords[uIndex0].y;
+        const float fHandedness = ((fDeltaU1 * fDeltaV2 - fDeltaV1 * fDeltaU2) < 0.0f) ? -1.0f : 1.0f;
+
+        // directions of increasing u & v, scaled by uv area
+        ptWork->atFaceS[i] = pl_mul_vec3_scalarf(pl_sub_vec3(pl_mul_vec3_scalarf(tEdge1, fDeltaV2), pl_mul_vec3_scalarf(tEdge2, fDeltaV1)), fHandedness);
+        ptWork->atFaceT[i] = pl_mul_vec3_scalarf(pl_sub_vec3(pl_mul_vec3_scalarf(tEdge2, fDeltaU1), pl_mul_vec3_scalarf(tEdge1, fDeltaU2)), fHandedness);
+    }
+}
+
+static void
+pl__ecs_vertex_tangent_job(uint32_t uJobIndex, void* pData)
+{
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    plMeshComponent* ptMesh = ptWork->ptMesh;
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        plVec3 tTangent = {0};
+        plVec3 tBitangent = {0};
+        for(uint32_t j = ptWork->auCornerStart[i]; j < ptWork->auCornerStart[i + 1]; j++)
+        {
+            tTangent = pl_add_vec3(tTangent, ptWork->atFaceS[ptWork->auCorners[j] / 3]);
+            tBitangent = pl_add_vec3(tBitangent, ptWork->atFaceT[ptWork->auCorners[j] / 3]);
+        }
+
+        // gram-schmidt against the normal
+        const plVec3 tNormal = ptMesh->sbtVertexNormals[i];
+        tTangent = pl_sub_vec3(tTangent, pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, tTangent)));
+        const float fLength = pl_length_vec3(tTangent);
+        if(fLength > 0.0f)
+            tTangent = pl_mul_vec3_scalarf(tTangent, 1.0f / fLength);
+        else // no uv gradient, any direction in the normal's plane
+            tTangent = fabsf(tNormal.x) < 0.9f ? pl_norm_vec3(pl_cross_vec3(tNormal, (plVec3){1.0f, 0.0f, 0.0f})) : pl_norm_vec3(pl_cross_vec3(tNormal, (plVec3){0.0f, 1.0f, 0.0f}));
+        const float fHandedness = pl_dot_vec3(pl_cross_vec3(tNormal, tTangent), tBitangent) < 0.0f ? -1.0f : 1.0f;
+        ptMesh->sbtVertexTangents[i] = (plVec4){tTangent.x, tTangent.y, tTangent.z, fHandedness};
+    }
+}
+
+static inline void
+pl__ecs_mikk_vertex_key(const plMeshComponent* ptMesh, uint32_t uVertex, float afKeyOut[8])
+{
+    // +0.0f so -0 & 0 compare (& hash) equal
+    afKeyOut[0] = ptMesh->sbtVertexPositions[uVertex].x + 0.0f;
+    afKeyOut[1] = ptMesh->sbtVertexPositions[uVertex].y + 0.0f;
+    afKeyOut[2] = ptMesh->sbtVertexPositions[uVertex].z + 0.0f;
+    afKeyOut[3] = ptMesh->sbtVertexNormals[uVertex].x + 0.0f;
+    afKeyOut[4] = ptMesh->sbtVertexNormals[uVertex].y + 0.0f;
+    afKeyOut[5] = ptMesh->sbtVertexNormals[uVertex].z + 0.0f;
+    afKeyOut[6] = ptMesh->sbtVertexTextureCoordinates[0][uVertex].x + 0.0f;
+    afKeyOut[7] = ptMesh->sbtVertexTextureCoordinates[0][uVertex].y + 0.0f;
+}
+
+static inline bool
+pl__ecs_mikk_not_zero(float fValue)
+{
+    return fabsf(fValue) > FLT_MIN;
+}
+
+static inline bool
+pl__ecs_mikk_vec_not_zero(plVec3 tValue)
+{
+    return pl__ecs_mikk_not_zero(tValue.x) || pl__ecs_mikk_not_zero(tValue.y) || pl__ecs_mikk_not_zero(tValue.z);
+}
+
+static inline plVec3
+pl__ecs_mikk_project(plVec3 tNormal, plVec3 tValue)
+{
+    // onto the normal's plane, normalized if not zero
+    tValue = pl_sub_vec3(tValue, pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, tValue)));
+    return pl__ecs_mikk_vec_not_zero(tValue) ? pl_mul_vec3_scalarf(tValue, 1.0f / pl_length_vec3(tValue)) : tValue;
+}
+
+static void
+pl__ecs_mikk_face_job(uint32_t uJobIndex, void* pData)
+{
+    // per triangle tangent & bitangent directions (mikktspace InitTriInfo)
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    const plMeshComponent* ptMesh = ptWork->ptMesh;
+    const plVec2* atTexCoords = ptMesh->sbtVertexTextureCoordinates[0];
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        const uint32_t uIndex0 = ptMesh->sbuIndices[i * 3 + 0];
+        const uint32_t uIndex1 = ptMesh->sbuIndices[i * 3 + 1];
+        const uint32_t uIndex2 = ptMesh->sbuIndices[i * 3 + 2];
+
+        const float fT21x = atTexCoords[uIndex1].x - atTexCoords[uIndex0].x;
+        const float fT21y = atTexCoords[uIndex1].y - atTexCoords[uIndex0].y;
+        const float fT31x = atTexCoords[uIndex2].x - atTexCoords[uIndex0].x;
+        const float fT31y = atTexCoords[uIndex2].y - atTexCoords[uIndex0].y;
+        const plVec3 tD1 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex1], ptMesh->sbtVertexPositions[uIndex0]);
+        const plVec3 tD2 = pl_sub_vec3(ptMesh->sbtVertexPositions[uIndex2], ptMesh->sbtVertexPositions[uIndex0]);
+
+        const float fSignedAreaSTx2 = fT21x * fT31y - fT21y * fT31x;
+        const plVec3 tOs = pl_sub_vec3(pl_mul_vec3_scalarf(tD1, fT31y), pl_mul_vec3_scalarf(tD2, fT21y));
+        const plVec3 tOt = pl_add_vec3(pl_mul_vec3_scalarf(tD1, -fT31x), pl_mul_vec3_scalarf(tD2, fT21x));
+
+        uint32_t uFlags = (ptWork->auFaceFlags[i] & PL__ECS_MIKK_DEGENERATE) | PL__ECS_MIKK_GROUP_WITH_ANY;
+        if(fSignedAreaSTx2 > 0.0f)
+            uFlags |= PL__ECS_MIKK_ORIENT_PRESERVING;
+
+        ptWork->atFaceS[i] = (plVec3){0};
+        ptWork->atFaceT[i] = (plVec3){0};
+        if(pl__ecs_mikk_not_zero(fSignedAreaSTx2))
+        {
+            const float fAbsArea = fabsf(fSignedAreaSTx2);
+            const float fLenOs = pl_length_vec3(tOs);
+            const float fLenOt = pl_length_vec3(tOt);
+            const float fSign = (uFlags & PL__ECS_MIKK_ORIENT_PRESERVING) ? 1.0f : -1.0f;
+            if(pl__ecs_mikk_not_zero(fLenOs))
+                ptWork->atFaceS[i] = pl_mul_vec3_scalarf(tOs, fSign / fLenOs);
+            if(pl__ecs_mikk_not_zero(fLenOt))
+                ptWork->atFaceT[i] = pl_mul_vec3_scalarf(tOt, fSign / fLenOt);
+
+            // triangles without a usable uv mapping join any group
+            if(pl__ecs_mikk_not_zero(fLenOs / fAbsArea) && pl__ecs_mikk_not_zero(fLenOt / fAbsArea))
+                uFlags &= ~PL__ECS_MIKK_GROUP_WITH_ANY;
+        }
+        ptWork->auFaceFlags[i] = uFlags;
+    }
+}
+
+static int
+pl__ecs_mikk_edge_compare(const void* pA, const void* pB)
+{
+    const plMikkEdge* ptA = pA;
+    const plMikkEdge* ptB = pB;
+    if(ptA->uKey != ptB->uKey)
+        return ptA->uKey < ptB->uKey ? -1 : 1;
+    if(ptA->uTriangle != ptB->uTriangle)
+        return ptA->uTriangle < ptB->uTriangle ? -1 : 1;
+    return (int)ptA->uEdge - (int)ptB->uEdge;
+}
+
+static int
+pl__ecs_uint_compare(const void* pA, const void* pB)
+{
+    const uint32_t uA = *(const uint32_t*)pA;
+    const uint32_t uB = *(const uint32_t*)pB;
+    return uA < uB ? -1 : (uA > uB ? 1 : 0);
+}
+
+static void
+pl__ecs_mikk_group_job(uint32_t uJobIndex, void* pData)
+{
+    // fans of triangles around each vertex that are connected by edges & share uv
+    // orientation (mikktspace BuildNeighborsFast & Build4RuleGroups)
+    plMeshVectorJobData* ptJobData = pData;
+    plMeshVectorWork* ptWork = &ptJobData->atWork[uJobIndex];
+    const uint32_t* auIndices = ptWork->ptMesh->sbuIndices;
+    const uint32_t* auWelded = ptWork->auWelded;
+    uint32_t* auFlags = ptWork->auFaceFlags;
+    const uint32_t uTriangleCount = ptWork->uTriangleCount;
+
+    // edges sorted by (min vertex, max vertex, triangle), then paired with an
+    // unpaired edge running the other way
+    ptWork->aiNeighbors = PL_ALLOC(sizeof(int32_t) * uTriangleCount * 3);
+    memset(ptWork->aiNeighbors, 0xff, sizeof(int32_t) * uTriangleCount * 3);
+    plMikkEdge* atEdges = PL_ALLOC(sizeof(plMikkEdge) * uTriangleCount * 3);
+    uint32_t uEdgeCount = 0;
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+    {
+        if(auFlags[i] & PL__ECS_MIKK_DEGENERATE)
+            continue;
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            const uint32_t uA = auWelded[auIndices[i * 3 + j]];
+            const uint32_t uB = auWelded[auIndices[i * 3 + (j < 2 ? j + 1 : 0)]];
+            atEdges[uEdgeCount].uKey = ((uint64_t)pl_min(uA, uB) << 32) | pl_max(uA, uB);
+            atEdges[uEdgeCount].uTriangle = i;
+            atEdges[uEdgeCount].uEdge = j;
+            uEdgeCount++;
+        }
+    }
+    qsort(atEdges, uEdgeCount, sizeof(plMikkEdge), pl__ecs_mikk_edge_compare);
+    for(uint32_t i = 0; i < uEdgeCount; i++)
+    {
+        const plMikkEdge tA = atEdges[i];
+        if(ptWork->aiNeighbors[tA.uTriangle * 3 + tA.uEdge] != -1)
+            continue;
+        const uint32_t uStartA = auWelded[auIndices[tA.uTriangle * 3 + tA.uEdge]];
+        for(uint32_t j = i + 1; j < uEdgeCount && atEdges[j].uKey == tA.uKey; j++)
+        {
+            const plMikkEdge tB = atEdges[j];
+            const uint32_t uStartB = auWelded[auIndices[tB.uTriangle * 3 + tB.uEdge]];
+            if(uStartB != uStartA && ptWork->aiNeighbors[tB.uTriangle * 3 + tB.uEdge] == -1)
+            {
+                ptWork->aiNeighbors[tA.uTriangle * 3 + tA.uEdge] = (int32_t)tB.uTriangle;
+                ptWork->aiNeighbors[tB.uTriangle * 3 + tB.uEdge] = (int32_t)tA.uTriangle;
+                break;
+            }
+        }
+    }
+    PL_FREE(atEdges);
+
+    // groups (a triangle corner belongs to at most one)
+    ptWork->auCornerGroup   = PL_ALLOC(sizeof(uint32_t) * uTriangleCount * 3);
+    ptWork->auGroupStart    = PL_ALLOC(sizeof(uint32_t) * (uTriangleCount * 3 + 1));
+    ptWork->auGroupMembers  = PL_ALLOC(sizeof(uint32_t) * uTriangleCount * 3);
+    ptWork->auGroupVertex   = PL_ALLOC(sizeof(uint32_t) * uTriangleCount * 3);
+    memset(ptWork->auCornerGroup, 0xff, sizeof(uint32_t) * uTriangleCount * 3);
+    uint32_t* auStack = PL_ALLOC(sizeof(uint32_t) * (uTriangleCount * 6 + 2));
+    uint32_t uGroupCount = 0;
+    uint32_t uMemberCount = 0;
+    for(uint32_t i = 0; i < uTriangleCount; i++)
+    {
+        if(auFlags[i] & (PL__ECS_MIKK_GROUP_WITH_ANY | PL__ECS_MIKK_DEGENERATE))
+            continue;
+
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            if(ptWork->auCornerGroup[i * 3 + j] != UINT32_MAX)
+                continue;
+
+            const uint32_t uGroup = uGroupCount++;
+            const uint32_t uVertex = auWelded[auIndices[i * 3 + j]];
+            const uint32_t uOrient = auFlags[i] & PL__ECS_MIKK_ORIENT_PRESERVING;
+            ptWork->auGroupStart[uGroup] = uMemberCount;
+            ptWork->auGroupVertex[uGroup] = uVertex;
+            ptWork->auCornerGroup[i * 3 + j] = uGroup;
+            ptWork->auGroupMembers[uMemberCount++] = i;
+
+            // depth first over the fan (left neighbor before right, like AssignRecur)
+            uint32_t uStackSize = 0;
+            const int32_t iRight = ptWork->aiNeighbors[i * 3 + (j > 0 ? j - 1 : 2)];
+            const int32_t iLeft = ptWork->aiNeighbors[i * 3 + j];
+            if(iRight >= 0) auStack[uStackSize++] = (uint32_t)iRight;
+            if(iLeft >= 0)  auStack[uStackSize++] = (uint32_t)iLeft;
+            while(uStackSize > 0)
+            {
+                const uint32_t uTriangle = auStack[--uStackSize];
+                uint32_t uCorner = 0;
+                while(uCorner < 3 && auWelded[auIndices[uTriangle * 3 + uCorner]] != uVertex)
+                    uCorner++;
+                if(uCorner == 3 || ptWork->auCornerGroup[uTriangle * 3 + uCorner] != UINT32_MAX)
+                    continue;
+
+                // first group to take a free floating triangle decides its orientation
+                if((auFlags[uTriangle] & PL__ECS_MIKK_GROUP_WITH_ANY) &&
+                    ptWork->auCornerGroup[uTriangle * 3 + 0] == UINT32_MAX &&
+                    ptWork->auCornerGroup[uTriangle * 3 + 1] == UINT32_MAX &&
+                    ptWork->auCornerGroup[uTriangle * 3 + 2] == UINT32_MAX)
+                    auFlags[uTriangle] = (auFlags[uTriangle] & ~PL__ECS_MIKK_ORIENT_PRESERVING) | uOrient;
+                if((auFlags[uTriangle] & PL__ECS_MIKK_ORIENT_PRESERVING) != uOrient)
+                    continue;
+
+                ptWork->auCornerGroup[uTriangle * 3 + uCorner] = uGroup;
+                ptWork->auGroupMembers[uMemberCount++] = uTriangle;
+                const int32_t iNextRight = ptWork->aiNeighbors[uTriangle * 3 + (uCorner > 0 ? uCorner - 1 : 2)];
+                const int32_t iNextLeft = ptWork->aiNeighbors[uTriangle * 3 + uCorner];
+                if(iNextRight >= 0) auStack[uStackSize++] = (uint32_t)iNextRight;
+                if(iNextLeft >= 0)  auStack[uStackSize++] = (uint32_t)iNextLeft;
+            }
+
+            // tangent spaces are summed in triangle order
+            qsort(&ptWork->auGroupMembers[ptWork->auGroupStart[uGroup]], uMemberCount - ptWork->auGroupStart[uGroup], sizeof(uint32_t), pl__ecs_uint_compare);
+        }
+    }
+    PL_FREE(auStack);
+    ptWork->auGroupStart[uGroupCount] = uMemberCount;
+    ptWork->uGroupCount = uGroupCount;
+    ptWork->atGroupTangents = PL_ALLOC(sizeof(plVec4) * (uGroupCount + 1));
+}
+
+static void
+pl__ecs_mikk_eval_job(uint32_t uJobIndex, void* pData)
+{
+    // angle weighted average of the group's projected tangents (mikktspace EvalTspace)
+    plMeshVectorJobData* ptJobData = pData;
+    const plMeshVectorRange tRange = ptJobData->sbtRanges[uJobIndex];
+    plMeshVectorWork* ptWork = &ptJobData->atWork[tRange.uWork];
+    const plMeshComponent* ptMesh = ptWork->ptMesh;
+
+    for(uint32_t i = tRange.uStart; i < tRange.uEnd; i++)
+    {
+        const uint32_t uVertex = ptWork->auGroupVertex[i];
+        const plVec3 tNormal = ptMesh->sbtVertexNormals[uVertex];
+        plVec3 tResult = {0};
+        bool bOrient = true;
+        for(uint32_t j = ptWork->auGroupStart[i]; j < ptWork->auGroupStart[i + 1]; j++)
+        {
+            const uint32_t uTriangle = ptWork->auGroupMembers[j];
+            bOrient = (ptWork->auFaceFlags[uTriangle] & PL__ECS_MIKK_ORIENT_PRESERVING) != 0;
+            if(ptWork->auFaceFlags[uTriangle] & PL__ECS_MIKK_GROUP_WITH_ANY)
+                continue;
+
+            uint32_t uCorner = 0;
+            while(ptWork->auWelded[ptMesh->sbuIndices[uTriangle * 3 + uCorner]] != uVertex)
+                uCorner++;
+
+            const plVec3 tOs = pl__ecs_mikk_project(tNormal, ptWork->atFaceS[uTriangle]);
+
+            // angle of the triangle at the vertex (in the normal's plane)
+            const plVec3 tP0 = ptMesh->sbtVertexPositions[ptWork->auWelded[ptMesh->sbuIndices[uTriangle * 3 + (uCorner > 0 ? uCorner - 1 : 2)]]];
+            const plVec3 tP1 = ptMesh->sbtVertexPositions[uVertex];
+            const plVec3 tP2 = ptMesh->sbtVertexPositions[ptWork->auWelded[ptMesh->sbuIndices[uTriangle * 3 + (uCorner < 2 ? uCorner + 1 : 0)]]];
+            const plVec3 tV1 = pl__ecs_mikk_project(tNormal, pl_sub_vec3(tP0, tP1));
+            const plVec3 tV2 = pl__ecs_mikk_project(tNormal, pl_sub_vec3(tP2, tP1));
+            float fCos = pl_dot_vec3(tV1, tV2);
+            fCos = fCos > 1.0f ? 1.0f : (fCos < -1.0f ? -1.0f : fCos);
+            const float fAngle = (float)acos(fCos);
+
+            tResult = pl_add_vec3(tResult, pl_mul_vec3_scalarf(tOs, fAngle));
+        }
+        if(pl__ecs_mikk_vec_not_zero(tResult))
+            tResult = pl_mul_vec3_scalarf(tResult, 1.0f / pl_length_vec3(tResult));
+        ptWork->atGroupTangents[i] = (plVec4){tResult.x, tResult.y, tResult.z, bOrient ? 1.0f : -1.0f};
+    }
+}
+
+static void
+pl__ecs_mesh_duplicate_vertex(plMeshComponent* ptMesh, uint32_t uVertex, uint32_t uVertexCount)
+{
+    // append a copy of the vertex to every vertex stream
+    plEcsSnapshotField atFields[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    const uint32_t uFieldCount = pl__ecs_snapshot_fields(PL_COMPONENT_TYPE_MESH, ptMesh, atFields);
+    for(uint32_t i = 0; i < uFieldCount; i++)
+    {
+        void** ppBuffer = atFields[i].ppBuffer;
+        if(*ppBuffer == (void*)ptMesh->sbuIndices || pl_sb_size(*ppBuffer) != uVertexCount)
+            continue;
+        pl__sb_may_grow_(ppBuffer, atFields[i].uStride, 1, 8, __FILE__, __LINE__);
+        unsigned char* pucBuffer = *ppBuffer;
+        memcpy(&pucBuffer[uVertexCount * atFields[i].uStride], &pucBuffer[uVertex * atFields[i].uStride], atFields[i].uStride);
+        pl__sb_header(*ppBuffer)->uSize++;
+    }
+}
+
+static void
+pl__ecs_mikk_output_job(uint32_t uJobIndex, void* pData)
+{
+    // corners of a vertex can end up in different groups (uv mirroring, seams
+    // sharing positions), those vertices are split
+    plMeshVectorJobData* ptJobData = pData;
+    plMeshVectorWork* ptWork = &ptJobData->atWork[uJobIndex];
+    plMeshComponent* ptMesh = ptWork->ptMesh;
+    const uint32_t uCornerCount = ptWork->uTriangleCount * 3;
+
+    // degenerate triangles take the tangent of the first good corner on the same vertex
+    const uint32_t uDefaultGroup = ptWork->uGroupCount;
+    ptWork->atGroupTangents[uDefaultGroup] = (plVec4){1.0f, 0.0f, 0.0f, 1.0f};
+    uint32_t* auCornerGroup = ptWork->auCornerGroup;
+    uint32_t* auFirstCorner = PL_ALLOC(sizeof(uint32_t) * ptWork->uVertexCount);
+    memset(auFirstCorner, 0xff, sizeof(uint32_t) * ptWork->uVertexCount);
+    for(uint32_t i = 0; i < uCornerCount; i++)
+    {
+        const uint32_t uVertex = ptWork->auWelded[ptMesh->sbuIndices[i]];
+        if(!(ptWork->auFaceFlags[i / 3] & PL__ECS_MIKK_DEGENERATE) && auFirstCorner[uVertex] == UINT32_MAX)
+            auFirstCorner[uVertex] = i;
+    }
+    for(uint32_t i = 0; i < uCornerCount; i++)
+    {
+        if(ptWork->auFaceFlags[i / 3] & PL__ECS_MIKK_DEGENERATE)
+        {
+            const uint32_t uSource = auFirstCorner[ptWork->auWelded[ptMesh->sbuIndices[i]]];
+            auCornerGroup[i] = uSource == UINT32_MAX ? UINT32_MAX : auCornerGroup[uSource];
+        }
+        if(auCornerGroup[i] == UINT32_MAX)
+            auCornerGroup[i] = uDefaultGroup;
+    }
+    PL_FREE(auFirstCorner);
+
+    // first group written to a vertex keeps it, others go to (shared) copies
+    uint32_t uVertexCount = ptWork->uVertexCount;
+    uint32_t* sbuVertexGroup = NULL;
+    uint32_t* sbuNextCopy = NULL;
+    pl_sb_resize(sbuVertexGroup, uVertexCount);
+    pl_sb_resize(sbuNextCopy, uVertexCount);
+    memset(sbuVertexGroup, 0xff, sizeof(uint32_t) * uVertexCount);
+    memset(sbuNextCopy, 0xff, sizeof(uint32_t) * uVertexCount);
+    for(uint32_t i = 0; i < uCornerCount; i++)
+    {
+        const uint32_t uGroup = auCornerGroup[i];
+        const plVec4 tTangent = ptWork->atGroupTangents[uGroup];
+        uint32_t uTarget = ptMesh->sbuIndices[i];
+        while(true)
+        {
+            if(sbuVertexGroup[uTarget] == UINT32_MAX)
+            {
+                sbuVertexGroup[uTarget] = uGroup;
+                ptMesh->sbtVertexTangents[uTarget] = tTangent;
+                break;
+            }
+            if(memcmp(&ptMesh->sbtVertexTangents[uTarget], &tTangent, sizeof(plVec4)) == 0)
+                break;
+            if(sbuNextCopy[uTarget] == UINT32_MAX)
+            {
+                pl__ecs_mesh_duplicate_vertex(ptMesh, ptMesh->sbuIndices[i], uVertexCount);
+                sbuNextCopy[uTarget] = uVertexCount;
+                pl_sb_push(sbuVertexGroup, UINT32_MAX);
+                pl_sb_push(sbuNextCopy, UINT32_MAX);
+                uVertexCount++;
+            }
+            uTarget = sbuNextCopy[uTarget];
+        }
+        ptMesh->sbuIndices[i] = uTarget;
+    }
+    pl_sb_free(sbuVertexGroup);
+    pl_sb_free(sbuNextCopy);
+}
 
-                // TODO: check if this transform is part of a humanoid and need some constraining
+//-----------------------------------------------------------------------------
+// [SECTION] cached queries
+//-----------------------------------------------------------------------------
 
-                plVec4 tQ = {0};
+static uint32_t
+pl__ecs_query_slot(const plEcsQuery* ptQuery, plComponentType tType)
+{
+    for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+    {
+        if(ptQuery->atComponentTypes[i] == tType)
+            return i;
+    }
+    return UINT32_MAX;
+}
 
-                // simple shortest rotation without constraint
-                const plVec3 tAxis = pl_norm_vec3(pl_cross_vec3(tDirParentToIk, tDirParentToTarget));
-                const float fAngle = acosf(pl_clampf(-1.0f, pl_dot_vec3(tDirParentToIk, tDirParentToTarget), 1.0f));
-                tQ = pl_norm_vec4(pl_quat_rotation_normal_vec3(fAngle, tAxis));
+static void
+pl__ecs_query_try_add(plComponentLibrary* ptLibrary, plEcsQuery* ptQuery, plEntity tEntity)
+{
+    if((ptLibrary->sbtEntitySignatures[tEntity.uIndex] & ptQuery->_tMask) != ptQuery->_tMask)
+        return;
 
-                // parent to world space
-                pl_decompose_matrix(&ptParentTransform->tWorld, &ptParentTransform->tScale, &ptParentTransform->tRotation, &ptParentTransform->tTranslation);
+    while(pl_sb_size(ptQuery->_sbuRows) <= tEntity.uIndex)
+        pl_sb_push(ptQuery->_sbuRows, UINT32_MAX);
 
-                // rotate parent
-                ptParentTransform->tRotation = pl_norm_vec4(pl_mul_quat(tQ, ptParentTransform->tRotation));
-                ptParentTransform->tWorld = pl_rotation_translation_scale(ptParentTransform->tRotation, ptParentTransform->tTranslation, ptParentTransform->tScale);
+    uint32_t uRow = ptQuery->_sbuRows[tEntity.uIndex];
+    if(uRow == UINT32_MAX)
+    {
+        uRow = ptQuery->uCount++;
+        ptQuery->_sbuRows[tEntity.uIndex] = uRow;
+        pl_sb_push(ptQuery->sbtEntities, tEntity);
+        for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+            pl_sb_add(ptQuery->sbuIndices[i]);
+    }
 
-                // parent back to local space (if parent has parent)
-                plHierarchyComponent* ptHierParentComp = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tParentEntity);
-                if(ptHierParentComp)
-                {
-                    plEntity tParentOfParentEntity = ptHierParentComp->tParent;
-                    const size_t uGrandParentIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tParentOfParentEntity);
-                    PL_ASSERT(uGrandParentIndex != UINT64_MAX);
-                    plTransformComponent* ptParentOfParentTransform = &ptData->sbtTransformsCopy[uGrandParentIndex];
-                    const plMat4 tParentOfParentInverse = pl_mat4_invert(&ptParentOfParentTransform->tWorld);
-                    plMat4 tW = pl_rotation_translation_scale(ptParentTransform->tRotation, ptParentTransform->tTranslation, ptParentTransform->tScale);
-                    plMat4 tNewMatrix = pl_mul_mat4(&tParentOfParentInverse, &tW);
-                    pl_decompose_matrix(&tNewMatrix, &ptParentTransform->tScale, &ptParentTransform->tRotation, &ptParentTransform->tTranslation);
-                    // keep parent world matrix in world space!
-                }
+    for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+        ptQuery->sbuIndices[i][uRow] = (uint32_t)pl_hm_lookup(ptLibrary->_ptManagers[ptQuery->atComponentTypes[i]]->ptHashmap, tEntity.uIndex);
+}
 
-                // update chain from parent to children
-                const plTransformComponent* ptRecurseParent = ptParentTransform;
-                for(int recurse_chain = (int)uChain; recurse_chain >=0; --recurse_chain)
-                {
-                    plMat4 tW = pl_rotation_translation_scale(aptStack[recurse_chain]->tRotation, aptStack[recurse_chain]->tTranslation, aptStack[recurse_chain]->tScale);
-                    aptStack[recurse_chain]->tWorld = pl_mul_mat4(&ptRecurseParent->tWorld, &tW);
-                    ptRecurseParent = aptStack[recurse_chain];
-                }
+static void
+pl__ecs_query_on_add(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity, uint32_t uIndex)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtQueries); i++)
+    {
+        plEcsQuery* ptQuery = ptData->sbtQueries[i];
+        if(ptQuery->_tMask & PL_COMPONENT_MASK(tType))
+            pl__ecs_query_try_add(ptLibrary, ptQuery, tEntity);
+    }
+}
 
-                if(ptHierParentComp == NULL)
-                {
-                    // chain root reached, exit
-                    break;
-                }
+static void
+pl__ecs_query_on_remove(plComponentLibrary* ptLibrary, plComponentType tType, plEntity tRemoved, plEntity tMoved, uint32_t uIndex)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtQueries); i++)
+    {
+        plEcsQuery* ptQuery = ptData->sbtQueries[i];
+        if(!(ptQuery->_tMask & PL_COMPONENT_MASK(tType)))
+            continue;
 
-                // move up in the chain by one
-                ptChildTransform = ptParentTransform;
-                tParentEntity = ptHierParentComp->tParent;
-                PL_ASSERT(uChain < 32);
+        // drop removed entity's row (swap with last row)
+        const uint32_t uRow = tRemoved.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tRemoved.uIndex] : UINT32_MAX;
+        if(uRow != UINT32_MAX)
+        {
+            const uint32_t uLastRow = --ptQuery->uCount;
+            if(uRow != uLastRow)
+            {
+                const plEntity tLastEntity = ptQuery->sbtEntities[uLastRow];
+                ptQuery->sbtEntities[uRow] = tLastEntity;
+                for(uint32_t j = 0; j < ptQuery->uComponentCount; j++)
+                    ptQuery->sbuIndices[j][uRow] = ptQuery->sbuIndices[j][uLastRow];
+                ptQuery->_sbuRows[tLastEntity.uIndex] = uRow;
             }
+            pl_sb_pop(ptQuery->sbtEntities);
+            for(uint32_t j = 0; j < ptQuery->uComponentCount; j++)
+                pl_sb_pop(ptQuery->sbuIndices[j]);
+            ptQuery->_sbuRows[tRemoved.uIndex] = UINT32_MAX;
         }
 
+        // entity moved into the freed manager slot
+        if(tMoved.uIndex != UINT32_MAX && tMoved.uIndex < pl_sb_size(ptQuery->_sbuRows))
+        {
+            const uint32_t uMovedRow = ptQuery->_sbuRows[tMoved.uIndex];
+            if(uMovedRow != UINT32_MAX)
+                ptQuery->sbuIndices[pl__ecs_query_slot(ptQuery, tType)][uMovedRow] = uIndex;
+        }
     }
+}
 
-    if(bRecomputeHierarchy)
-    {
+static plEcsQuery*
+pl_ecs_create_query(plComponentLibrary* ptLibrary, uint32_t uComponentCount, const plComponentType* atComponentTypes)
+{
+    PL_ASSERT(uComponentCount > 0 && uComponentCount <= PL_COMPONENT_TYPE_COUNT);
 
-        const uint32_t uHierarchyCount = pl_sb_size(ptLibrary->tHierarchyComponentManager.sbtEntities);
-        for(uint32_t i = 0; i < uHierarchyCount; i++)
-        {
-            const plEntity tChildEntity = ptLibrary->tHierarchyComponentManager.sbtEntities[i];
-            
-            const size_t uChildIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tChildEntity);
-            PL_ASSERT(uChildIndex != UINT64_MAX);
+    plEcsQuery* ptQuery = PL_ALLOC(sizeof(plEcsQuery));
+    memset(ptQuery, 0, sizeof(plEcsQuery));
+    ptQuery->uComponentCount = uComponentCount;
 
-            const plTransformComponent* ptTransformChild = &ptData->sbtTransformsCopy[uChildIndex];
+    // smallest manager drives the initial join
+    uint32_t uSmallest = 0;
+    for(uint32_t i = 0; i < uComponentCount; i++)
+    {
+        ptQuery->atComponentTypes[i] = atComponentTypes[i];
+        ptQuery->_tMask |= PL_COMPONENT_MASK(atComponentTypes[i]);
+        if(pl_sb_size(ptLibrary->_ptManagers[atComponentTypes[i]]->sbtEntities) < pl_sb_size(ptLibrary->_ptManagers[atComponentTypes[uSmallest]]->sbtEntities))
+            uSmallest = i;
+    }
 
-            plMat4 tWorldMatrix = pl_rotation_translation_scale(ptTransformChild->tRotation, ptTransformChild->tTranslation, ptTransformChild->tScale);
+    const plComponentManager* ptManager = ptLibrary->_ptManagers[atComponentTypes[uSmallest]];
+    const uint32_t uEntityCount = pl_sb_size(ptManager->sbtEntities);
+    for(uint32_t i = 0; i < uEntityCount; i++)
+        pl__ecs_query_try_add(ptLibrary, ptQuery, ptManager->sbtEntities[i]);
 
-            plHierarchyComponent* ptHierarchyComponent = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tChildEntity);
-            
-            plEntity tParentID = ptHierarchyComponent->tParent;
-            while(tParentID.uIndex != UINT32_MAX)
-            {
-                const size_t uParentIndex = pl_ecs_get_index(&ptLibrary->tTransformComponentManager, tParentID);
-                if(uParentIndex == UINT64_MAX)
-                    break;
-                plTransformComponent* ptTransformParent = &ptData->sbtTransformsCopy[uParentIndex];
-                plMat4 tLocalMatrix = pl_rotation_translation_scale(ptTransformParent->tRotation, ptTransformParent->tTranslation, ptTransformParent->tScale);
-                tWorldMatrix = pl_mul_mat4(&tLocalMatrix, &tWorldMatrix);
-
-                const plHierarchyComponent* ptHierarchyRecursive = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tParentID);
-                if(ptHierarchyRecursive)
-                    tParentID = ptHierarchyRecursive->tParent;
-                else
-                    tParentID.uIndex = UINT32_MAX;
-            }
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    pl_sb_push(ptData->sbtQueries, ptQuery);
+    return ptQuery;
+}
+
+static void
+pl_ecs_cleanup_query(plComponentLibrary* ptLibrary, plEcsQuery** pptQuery)
+{
+    plEcsQuery* ptQuery = *pptQuery;
+    if(ptQuery == NULL)
+        return;
 
-            sbtTransforms[uChildIndex].tWorld = tWorldMatrix;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtQueries); i++)
+    {
+        if(ptData->sbtQueries[i] == ptQuery)
+        {
+            pl_sb_del_swap(ptData->sbtQueries, i);
+            break;
         }
+    }
 
+    pl_sb_free(ptQuery->sbtEntities);
+    pl_sb_free(ptQuery->_sbuRows);
+    for(uint32_t i = 0; i < ptQuery->uComponentCount; i++)
+    {
+        pl_sb_free(ptQuery->sbuIndices[i]);
     }
+    PL_FREE(ptQuery);
+    *pptQuery = NULL;
+}
 
-    pl_sb_reset(ptData->sbtTransformsCopy);
+//-----------------------------------------------------------------------------
+// [SECTION] render extraction
+//-----------------------------------------------------------------------------
 
-    pl_end_profile_sample(0);
+static plRenderSnapshot*
+pl_ecs_create_render_snapshot(void)
+{
+    plRenderSnapshot* ptSnapshot = PL_ALLOC(sizeof(plRenderSnapshot));
+    memset(ptSnapshot, 0, sizeof(plRenderSnapshot));
+    return ptSnapshot;
 }
 
 static void
-pl_camera_set_fov(plCameraComponent* ptCamera, float fYFov)
+pl_ecs_cleanup_render_snapshot(plRenderSnapshot** pptSnapshot)
 {
-    ptCamera->fFieldOfView = fYFov;
+    plRenderSnapshot* ptSnapshot = *pptSnapshot;
+    if(ptSnapshot == NULL)
+        return;
+
+    pl_sb_free(ptSnapshot->sbtObjects);
+    pl_sb_free(ptSnapshot->sbtSkins);
+    pl_sb_free(ptSnapshot->sbtPalettes);
+    pl_sb_free(ptSnapshot->_sbuObjectRows);
+    pl_sb_free(ptSnapshot->_sbuSkinRows);
+    PL_FREE(ptSnapshot);
+    *pptSnapshot = NULL;
 }
 
 static void
-pl_camera_set_clip_planes(plCameraComponent* ptCamera, float fNearZ, float fFarZ)
+pl__ecs_extract_object_job(uint32_t uJobIndex, void* pData)
 {
-    ptCamera->fNearZ = fNearZ;
-    ptCamera->fFarZ = fFarZ;
+    plRenderExtractJobData* ptJobData = pData;
+    plComponentLibrary* ptLibrary = ptJobData->ptLibrary;
+    plRenderSnapshot* ptSnapshot = ptJobData->ptSnapshot;
+    const plObjectComponent* ptObject = &((plObjectComponent*)ptLibrary->tObjectComponentManager.pComponents)[uJobIndex];
+    const plEntity tEntity = ptLibrary->tObjectComponentManager.sbtEntities[uJobIndex];
+
+    plTransformComponent* ptTransform = NULL;
+    plMeshComponent* ptMesh = NULL;
+    pl__ecs_object_parts(ptLibrary, uJobIndex, &ptTransform, &ptMesh);
+
+    plRenderObject* ptOut = &ptSnapshot->sbtObjects[uJobIndex];
+    ptOut->tEntity   = tEntity;
+    ptOut->tMesh     = ptObject->tMesh;
+    ptOut->tMaterial = ptMesh->tMaterial;
+    ptOut->tSkin     = ptMesh->tSkinComponent;
+    ptOut->tWorld    = ptTransform->tWorld;
+    ptOut->tAABB     = ptMesh->tAABBFinal;
+    ptSnapshot->_sbuObjectRows[tEntity.uIndex] = uJobIndex;
+
+    // fixed steps: blend with the state before the last step (objects
+    // created by that step have nothing to blend with)
+    if(ptJobData->sbtPrevious && tEntity.uIndex < pl_sb_size(ptJobData->sbtPrevious))
+    {
+        const plFixedStepPrevious* ptPrevious = &ptJobData->sbtPrevious[tEntity.uIndex];
+        if(ptPrevious->uCapture == ptJobData->uCapture && ptPrevious->tObject.ulData == tEntity.ulData)
+        {
+            ptOut->tWorld = pl__ecs_blend_world(&ptPrevious->tWorld, &ptTransform->tWorld, ptJobData->fAlpha);
+            ptOut->tAABB.tMin = pl_min_vec3(ptPrevious->tAABB.tMin, ptOut->tAABB.tMin);
+            ptOut->tAABB.tMax = pl_max_vec3(ptPrevious->tAABB.tMax, ptOut->tAABB.tMax);
+        }
+    }
 }
 
 static void
-pl_camera_set_aspect(plCameraComponent* ptCamera, float fAspect)
+pl__ecs_extract_skin_job(uint32_t uJobIndex, void* pData)
 {
-    ptCamera->fAspectRatio = fAspect;
+    plRenderExtractJobData* ptJobData = pData;
+    const plSkinComponent* ptSkin = &((plSkinComponent*)ptJobData->ptLibrary->tSkinComponentManager.pComponents)[uJobIndex];
+    const plRenderSkin* ptOut = &ptJobData->ptSnapshot->sbtSkins[uJobIndex];
+    if(ptOut->uPaletteCount > 0)
+        memcpy(&ptJobData->ptSnapshot->sbtPalettes[ptOut->uPaletteOffset], ptSkin->sbtTextureData, sizeof(plMat4) * ptOut->uPaletteCount);
 }
 
 static void
-pl_camera_set_pos(plCameraComponent* ptCamera, float fX, float fY, float fZ)
+pl_ecs_extract_render_snapshot(plComponentLibrary* ptLibrary, plRenderSnapshot* ptSnapshot)
 {
-    ptCamera->tPos.x = fX;
-    ptCamera->tPos.y = fY;
-    ptCamera->tPos.z = fZ;
+    pl_begin_profile_sample(0, __FUNCTION__);
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint32_t uEntityCount = pl_sb_size(ptLibrary->sbtEntityGenerations);
+    const uint32_t uObjectCount = pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities);
+    const uint32_t uSkinCount = pl_sb_size(ptLibrary->tSkinComponentManager.sbtEntities);
+    const plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+
+    ptSnapshot->uFrame = ++ptData->uRenderExtractions;
+    ptSnapshot->uObjectCount = uObjectCount;
+    ptSnapshot->uSkinCount = uSkinCount;
+    pl_sb_resize(ptSnapshot->sbtObjects, uObjectCount);
+    pl_sb_resize(ptSnapshot->sbtSkins, uSkinCount);
+    pl_sb_resize(ptSnapshot->_sbuObjectRows, uEntityCount);
+    pl_sb_resize(ptSnapshot->_sbuSkinRows, uEntityCount);
+    memset(ptSnapshot->_sbuObjectRows, 0xff, sizeof(uint32_t) * uEntityCount);
+    memset(ptSnapshot->_sbuSkinRows, 0xff, sizeof(uint32_t) * uEntityCount);
+
+    // palettes are packed back to back (only the joint & normal matrices the
+    // skin system writes, not the unused tail of sbtTextureData)
+    uint32_t uPaletteCount = 0;
+    for(uint32_t i = 0; i < uSkinCount; i++)
+    {
+        const plEntity tSkin = ptLibrary->tSkinComponentManager.sbtEntities[i];
+        const uint32_t uMatrixCount = pl_minu(pl_sb_size(sbtSkins[i].sbtJoints) * 2, pl_sb_size(sbtSkins[i].sbtTextureData));
+        ptSnapshot->sbtSkins[i] = (plRenderSkin){
+            .tEntity        = tSkin,
+            .uPaletteOffset = uPaletteCount,
+            .uPaletteCount  = uMatrixCount
+        };
+        ptSnapshot->_sbuSkinRows[tSkin.uIndex] = i;
+        uPaletteCount += uMatrixCount;
+    }
+    pl_sb_resize(ptSnapshot->sbtPalettes, uPaletteCount);
+
+    plRenderExtractJobData tJobData = {
+        .ptLibrary  = ptLibrary,
+        .ptSnapshot = ptSnapshot
+    };
+    if(ptData->bFixedStep && ptData->tFixedStep.tDesc.bInterpolate)
+    {
+        tJobData.sbtPrevious = ptData->sbtFixedPrevious;
+        tJobData.uCapture    = ptData->uFixedCapture;
+        tJobData.fAlpha      = ptData->tFixedStep.fAlpha;
+    }
+
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__ecs_extract_skin_job,
+        .pData = &tJobData
+    };
+    pl__ecs_dispatch_batch(uSkinCount, PL_ECS_SKIN_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    ptCounter = NULL;
+    tJobDesc.task = pl__ecs_extract_object_job;
+    pl__ecs_dispatch_batch(uObjectCount, PL_ECS_EXTRACT_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+
+    pl_end_profile_sample(0);
 }
 
-static void
-pl_camera_set_pitch_yaw(plCameraComponent* ptCamera, float fPitch, float fYaw)
+static const plRenderObject*
+pl_ecs_get_render_object(const plRenderSnapshot* ptSnapshot, plEntity tObject)
 {
-    ptCamera->fPitch = fPitch;
-    ptCamera->fYaw = fYaw;
+    if(tObject.uIndex >= pl_sb_size(ptSnapshot->_sbuObjectRows))
+        return NULL;
+    const uint32_t uRow = ptSnapshot->_sbuObjectRows[tObject.uIndex];
+    if(uRow == UINT32_MAX || ptSnapshot->sbtObjects[uRow].tEntity.ulData != tObject.ulData)
+        return NULL;
+    return &ptSnapshot->sbtObjects[uRow];
 }
 
-static void
-pl_camera_translate(plCameraComponent* ptCamera, float fDx, float fDy, float fDz)
+static const plMat4*
+pl_ecs_get_render_skin_palette(const plRenderSnapshot* ptSnapshot, plEntity tSkin, uint32_t* puMatrixCountOut)
 {
-    ptCamera->tPos = pl_add_vec3(ptCamera->tPos, pl_mul_vec3_scalarf(ptCamera->_tRightVec, fDx));
-    ptCamera->tPos = pl_add_vec3(ptCamera->tPos, pl_mul_vec3_scalarf(ptCamera->_tForwardVec, fDz));
-    ptCamera->tPos.y += fDy;
+    if(puMatrixCountOut)
+        *puMatrixCountOut = 0;
+    if(tSkin.uIndex >= pl_sb_size(ptSnapshot->_sbuSkinRows))
+        return NULL;
+    const uint32_t uRow = ptSnapshot->_sbuSkinRows[tSkin.uIndex];
+    if(uRow == UINT32_MAX || ptSnapshot->sbtSkins[uRow].tEntity.ulData != tSkin.ulData)
+        return NULL;
+    if(puMatrixCountOut)
+        *puMatrixCountOut = ptSnapshot->sbtSkins[uRow].uPaletteCount;
+    return &ptSnapshot->sbtPalettes[ptSnapshot->sbtSkins[uRow].uPaletteOffset];
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] fixed timestep
+//-----------------------------------------------------------------------------
+
 static void
-pl_camera_rotate(plCameraComponent* ptCamera, float fDPitch, float fDYaw)
+pl_ecs_set_fixed_step(plComponentLibrary* ptLibrary, const plFixedStepDesc* ptDesc)
 {
-    ptCamera->fPitch += fDPitch;
-    ptCamera->fYaw += fDYaw;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    memset(&ptData->tFixedStep, 0, sizeof(plFixedStepState));
+    ptData->uFixedCapture++; // drop captured state
+    ptData->bFixedStep = ptDesc != NULL;
+    if(ptDesc == NULL)
+        return;
+
+    plFixedStepDesc* ptFixedDesc = &ptData->tFixedStep.tDesc;
+    *ptFixedDesc = *ptDesc;
+    if(ptFixedDesc->fStepSize <= 0.0f)
+        ptFixedDesc->fStepSize = PL_ECS_FIXED_STEP_SIZE;
+    if(ptFixedDesc->uMaxSubsteps == 0)
+        ptFixedDesc->uMaxSubsteps = PL_ECS_MAX_SUBSTEPS;
+}
 
-    ptCamera->fYaw = pl__wrap_angle(ptCamera->fYaw);
-    ptCamera->fPitch = pl_clampf(0.995f * -PL_PI_2, ptCamera->fPitch, 0.995f * PL_PI_2);
+static const plFixedStepState*
+pl_ecs_get_fixed_step_state(plComponentLibrary* ptLibrary)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    return ptData->bFixedStep ? &ptData->tFixedStep : NULL;
 }
 
 static void
-pl_camera_look_at(plCameraComponent* ptCamera, plVec3 tEye, plVec3 tTarget)
+pl__ecs_fixed_capture_job(uint32_t uJobIndex, void* pData)
 {
-    const plVec3 tDirection = pl_norm_vec3(pl_sub_vec3(tTarget, tEye));
-    ptCamera->fYaw = atan2f(tDirection.x, tDirection.z);
-    ptCamera->fPitch = asinf(tDirection.y);
-    ptCamera->tPos = tEye;
+    plComponentLibrary* ptLibrary = pData;
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const plEntity tEntity = ptLibrary->tObjectComponentManager.sbtEntities[uJobIndex];
+
+    plTransformComponent* ptTransform = NULL;
+    plMeshComponent* ptMesh = NULL;
+    pl__ecs_object_parts(ptLibrary, uJobIndex, &ptTransform, &ptMesh);
+
+    plFixedStepPrevious* ptPrevious = &ptData->sbtFixedPrevious[tEntity.uIndex];
+    ptPrevious->tObject  = tEntity;
+    ptPrevious->uCapture = ptData->uFixedCapture;
+    ptPrevious->tWorld   = ptTransform->tWorld;
+    ptPrevious->tAABB    = ptMesh->tAABBFinal;
 }
 
+// object state extraction blends with (before the last step of an advance)
 static void
-pl_camera_update(plCameraComponent* ptCamera)
+pl__ecs_fixed_capture(plComponentLibrary* ptLibrary)
 {
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~update view~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-
-    // world space
-    static const plVec4 tOriginalUpVec      = {0.0f, 1.0f, 0.0f, 0.0f};
-    static const plVec4 tOriginalForwardVec = {0.0f, 0.0f, 1.0f, 0.0f};
-    static const plVec4 tOriginalRightVec   = {-1.0f, 0.0f, 0.0f, 0.0f};
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    const uint32_t uEntityCount = pl_sb_size(ptLibrary->sbtEntityGenerations);
+    const uint32_t uOldCount = pl_sb_size(ptData->sbtFixedPrevious);
+    if(uOldCount < uEntityCount)
+    {
+        pl_sb_resize(ptData->sbtFixedPrevious, uEntityCount);
+        memset(&ptData->sbtFixedPrevious[uOldCount], 0, sizeof(plFixedStepPrevious) * (uEntityCount - uOldCount));
+    }
+    ptData->uFixedCapture++;
 
-    const plMat4 tXRotMat   = pl_mat4_rotate_vec3(ptCamera->fPitch, tOriginalRightVec.xyz);
-    const plMat4 tYRotMat   = pl_mat4_rotate_vec3(ptCamera->fYaw, tOriginalUpVec.xyz);
-    const plMat4 tZRotMat   = pl_mat4_rotate_vec3(ptCamera->fRoll, tOriginalForwardVec.xyz);
-    const plMat4 tTranslate = pl_mat4_translate_vec3((plVec3){ptCamera->tPos.x, ptCamera->tPos.y, ptCamera->tPos.z});
+    plAtomicCounter* ptCounter = NULL;
+    plJobDesc tJobDesc = {
+        .task  = pl__ecs_fixed_capture_job,
+        .pData = ptLibrary
+    };
+    pl__ecs_dispatch_batch(pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities), PL_ECS_EXTRACT_BATCH_SIZE, tJobDesc, &ptCounter);
+    gptJob->wait_for_counter(ptCounter);
+}
 
-    // rotations: rotY * rotX * rotZ
-    plMat4 tRotations = pl_mul_mat4t(&tXRotMat, &tZRotMat);
-    tRotations        = pl_mul_mat4t(&tYRotMat, &tRotations);
+static void
+pl__ecs_run_fixed_step(plComponentLibrary* ptLibrary, const void* pInput, uint32_t uInputSize)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    plFixedStepState* ptState = &ptData->tFixedStep;
+    const plFixedStepDesc* ptDesc = &ptState->tDesc;
 
-    // update camera vectors
-    ptCamera->_tRightVec   = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalRightVec)).xyz;
-    ptCamera->_tUpVec      = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalUpVec)).xyz;
-    ptCamera->_tForwardVec = pl_norm_vec4(pl_mul_mat4_vec4(&tRotations, tOriginalForwardVec)).xyz;
+    if(ptDesc->ptPlaybackStream)
+        pInput = pl_ecs_get_stream_input(ptDesc->ptPlaybackStream, ptState->uStep, &uInputSize);
+    if(ptDesc->ptRecordStream)
+        pl_ecs_append_stream_input(ptDesc->ptRecordStream, pInput, uInputSize);
 
-    // update camera transform: translate * rotate
-    ptCamera->tTransformMat = pl_mul_mat4t(&tTranslate, &tRotations);
+    ptState->pInput = pInput;
+    ptState->uInputSize = uInputSize;
+    if(ptDesc->step)
+        ptDesc->step(ptLibrary, ptState->uStep, pInput, uInputSize, ptDesc->pUserData);
 
-    // update camera view matrix
-    ptCamera->tViewMat   = pl_mat4t_invert(&ptCamera->tTransformMat);
+    pl_run_systems(ptLibrary, ptDesc->fStepSize);
 
-    // flip x & y so camera looks down +z and remains right handed (+x to the right)
-    const plMat4 tFlipXY = pl_mat4_scale_xyz(-1.0f, -1.0f, 1.0f);
-    ptCamera->tViewMat   = pl_mul_mat4t(&tFlipXY, &ptCamera->tViewMat);
+    ptState->pInput = NULL;
+    ptState->uInputSize = 0;
+    ptState->uStep++;
+}
 
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~update projection~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    if(ptCamera->tType == PL_CAMERA_TYPE_PERSPECTIVE)
-    {
-        const float fInvtanHalfFovy = 1.0f / tanf(ptCamera->fFieldOfView / 2.0f);
-        ptCamera->tProjMat.col[0].x = fInvtanHalfFovy / ptCamera->fAspectRatio;
-        ptCamera->tProjMat.col[1].y = fInvtanHalfFovy;
-        ptCamera->tProjMat.col[2].z = ptCamera->fFarZ / (ptCamera->fFarZ - ptCamera->fNearZ);
-        ptCamera->tProjMat.col[2].w = 1.0f;
-        ptCamera->tProjMat.col[3].z = -ptCamera->fNearZ * ptCamera->fFarZ / (ptCamera->fFarZ - ptCamera->fNearZ);
-        ptCamera->tProjMat.col[3].w = 0.0f;  
-    }
-    else if(ptCamera->tType == PL_CAMERA_TYPE_ORTHOGRAPHIC)
+static void
+pl__ecs_run_fixed_steps(plComponentLibrary* ptLibrary, uint32_t uStepCount, const void* pInput, uint32_t uInputSize)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < uStepCount; i++)
     {
-        ptCamera->tProjMat.col[0].x = 2.0f / ptCamera->fWidth;
-        ptCamera->tProjMat.col[1].y = 2.0f / ptCamera->fHeight;
-        ptCamera->tProjMat.col[2].z = 1 / (ptCamera->fFarZ - ptCamera->fNearZ);
-        ptCamera->tProjMat.col[3].w = 1.0f;
+        // state before the first step was never simulated, so there's nothing to blend from
+        if(i + 1 == uStepCount && ptData->tFixedStep.tDesc.bInterpolate && ptData->tFixedStep.uStep > 0)
+            pl__ecs_fixed_capture(ptLibrary);
+        pl__ecs_run_fixed_step(ptLibrary, pInput, uInputSize);
     }
 }
 
-static void
-pl_calculate_normals(plMeshComponent* atMeshes, uint32_t uComponentCount)
+static uint32_t
+pl_ecs_advance_fixed_step(plComponentLibrary* ptLibrary, float fDeltaTime, const void* pInput, uint32_t uInputSize)
 {
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    PL_ASSERT(ptData->bFixedStep && "fixed stepping is disabled (see set_fixed_step)");
+    if(!ptData->bFixedStep)
+        return 0;
+    pl_begin_profile_sample(0, __FUNCTION__);
 
-    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+    plFixedStepState* ptState = &ptData->tFixedStep;
+    const double dStepSize = (double)ptState->tDesc.fStepSize;
+    ptState->dAccumulator += fDeltaTime > 0.0f ? (double)fDeltaTime : 0.0;
+
+    // spiral of death guard: drop whatever doesn't fit in uMaxSubsteps
+    double dStepCount = floor(ptState->dAccumulator / dStepSize);
+    const double dMaxSteps = (double)ptState->tDesc.uMaxSubsteps;
+    if(dStepCount > dMaxSteps)
     {
-        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        ptState->uDroppedSteps += (uint64_t)(dStepCount - dMaxSteps);
+        ptState->dAccumulator -= (dStepCount - dMaxSteps) * dStepSize;
+        dStepCount = dMaxSteps;
+    }
+    const uint32_t uStepCount = (uint32_t)dStepCount;
 
-        if(pl_sb_size(ptMesh->sbtVertexNormals) == 0)
-        {
-            pl_sb_resize(ptMesh->sbtVertexNormals, pl_sb_size(ptMesh->sbtVertexPositions));
-            for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices) - 2; i += 3)
-            {
-                const uint32_t uIndex0 = ptMesh->sbuIndices[i + 0];
-                const uint32_t uIndex1 = ptMesh->sbuIndices[i + 1];
-                const uint32_t uIndex2 = ptMesh->sbuIndices[i + 2];
+    pl__ecs_run_fixed_steps(ptLibrary, uStepCount, pInput, uInputSize);
+    ptState->dAccumulator -= dStepCount * dStepSize;
+    if(ptState->dAccumulator < 0.0)
+        ptState->dAccumulator = 0.0;
+    ptState->fAlpha = pl_clampf(0.0f, (float)(ptState->dAccumulator / dStepSize), 1.0f);
 
-                const plVec3 tP0 = ptMesh->sbtVertexPositions[uIndex0];
-                const plVec3 tP1 = ptMesh->sbtVertexPositions[uIndex1];
-                const plVec3 tP2 = ptMesh->sbtVertexPositions[uIndex2];
+    pl_end_profile_sample(0);
+    return uStepCount;
+}
 
-                const plVec3 tEdge1 = pl_sub_vec3(tP1, tP0);
-                const plVec3 tEdge2 = pl_sub_vec3(tP2, tP0);
+static void
+pl_ecs_run_fixed_steps(plComponentLibrary* ptLibrary, uint32_t uStepCount, const void* pInput, uint32_t uInputSize)
+{
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    PL_ASSERT(ptData->bFixedStep && "fixed stepping is disabled (see set_fixed_step)");
+    if(!ptData->bFixedStep)
+        return;
+    pl_begin_profile_sample(0, __FUNCTION__);
+    pl__ecs_run_fixed_steps(ptLibrary, uStepCount, pInput, uInputSize);
+    pl_end_profile_sample(0);
+}
 
-                const plVec3 tNorm = pl_cross_vec3(tEdge1, tEdge2);
+static plMat4
+pl__ecs_blend_world(const plMat4* ptPrevious, const plMat4* ptCurrent, float fAlpha)
+{
+    if(memcmp(ptPrevious, ptCurrent, sizeof(plMat4)) == 0)
+        return *ptCurrent;
+
+    // decomposition needs positive determinants
+    const float fPreviousDet = pl_dot_vec3(pl_cross_vec3(ptPrevious->col[0].xyz, ptPrevious->col[1].xyz), ptPrevious->col[2].xyz);
+    const float fCurrentDet = pl_dot_vec3(pl_cross_vec3(ptCurrent->col[0].xyz, ptCurrent->col[1].xyz), ptCurrent->col[2].xyz);
+    if(!(fPreviousDet > 0.0f) || !(fCurrentDet > 0.0f))
+        return *ptCurrent;
+
+    plVec3 tPreviousScale, tPreviousTranslation, tCurrentScale, tCurrentTranslation;
+    plVec4 tPreviousRotation, tCurrentRotation;
+    pl_decompose_matrix(ptPrevious, &tPreviousScale, &tPreviousRotation, &tPreviousTranslation);
+    pl_decompose_matrix(ptCurrent, &tCurrentScale, &tCurrentRotation, &tCurrentTranslation);
+
+    const plVec4 tRotation = pl_quat_slerp(tPreviousRotation, tCurrentRotation, fAlpha);
+    const plVec3 tTranslation = pl_add_vec3(tPreviousTranslation, pl_mul_vec3_scalarf(pl_sub_vec3(tCurrentTranslation, tPreviousTranslation), fAlpha));
+    const plVec3 tScale = pl_add_vec3(tPreviousScale, pl_mul_vec3_scalarf(pl_sub_vec3(tCurrentScale, tPreviousScale), fAlpha));
+    return pl_rotation_translation_scale(tRotation, tTranslation, tScale);
+}
 
-                ptMesh->sbtVertexNormals[uIndex0] = tNorm;
-                ptMesh->sbtVertexNormals[uIndex1] = tNorm;
-                ptMesh->sbtVertexNormals[uIndex2] = tNorm;
-            }
-        }
-    }
+static plEcsInputStream*
+pl_ecs_create_input_stream(void)
+{
+    plEcsInputStream* ptStream = PL_ALLOC(sizeof(plEcsInputStream));
+    memset(ptStream, 0, sizeof(plEcsInputStream));
+    pl_sb_push(ptStream->sbuOffsets, 0);
+    return ptStream;
 }
 
 static void
-pl_calculate_tangents(plMeshComponent* atMeshes, uint32_t uComponentCount)
+pl_ecs_cleanup_input_stream(plEcsInputStream** pptStream)
 {
+    plEcsInputStream* ptStream = *pptStream;
+    if(ptStream == NULL)
+        return;
+    pl_sb_free(ptStream->sbuOffsets);
+    pl_sb_free(ptStream->sbucData);
+    PL_FREE(ptStream);
+    *pptStream = NULL;
+}
 
-    for(uint32_t uMeshIndex = 0; uMeshIndex < uComponentCount; uMeshIndex++)
+static void
+pl_ecs_append_stream_input(plEcsInputStream* ptStream, const void* pInput, uint32_t uInputSize)
+{
+    const uint64_t uOffset = pl_sb_size(ptStream->sbucData);
+    if(pInput && uInputSize > 0)
     {
-        plMeshComponent* ptMesh = &atMeshes[uMeshIndex];
+        pl_sb_resize(ptStream->sbucData, (uint32_t)(uOffset + uInputSize));
+        memcpy(&ptStream->sbucData[uOffset], pInput, uInputSize);
+    }
+    pl_sb_push(ptStream->sbuOffsets, pl_sb_size(ptStream->sbucData));
+}
 
-        if(pl_sb_size(ptMesh->sbtVertexTangents) == 0 && pl_sb_size(ptMesh->sbtVertexTextureCoordinates[0]) > 0)
-        {
-            pl_sb_resize(ptMesh->sbtVertexTangents, pl_sb_size(ptMesh->sbtVertexPositions));
-            memset(ptMesh->sbtVertexTangents, 0, pl_sb_size(ptMesh->sbtVertexPositions) * sizeof(plVec4));
-            for(uint32_t i = 0; i < pl_sb_size(ptMesh->sbuIndices) - 2; i += 3)
-            {
-                const uint32_t uIndex0 = ptMesh->sbuIndices[i + 0];
-                const uint32_t uIndex1 = ptMesh->sbuIndices[i + 1];
-                const uint32_t uIndex2 = ptMesh->sbuIndices[i + 2];
-
-                const plVec3 tP0 = ptMesh->sbtVertexPositions[uIndex0];
-                const plVec3 tP1 = ptMesh->sbtVertexPositions[uIndex1];
-                const plVec3 tP2 = ptMesh->sbtVertexPositions[uIndex2];
-
-                const plVec2 tTex0 = ptMesh->sbtVertexTextureCoordinates[0][uIndex0];
-                const plVec2 tTex1 = ptMesh->sbtVertexTextureCoordinates[0][uIndex1];
-                const plVec2 tTex2 = ptMesh->sbtVertexTextureCoordinates[0][uIndex2];
-
-                const plVec3 atNormals[3] = { 
-                    ptMesh->sbtVertexNormals[uIndex0],
-                    ptMesh->sbtVertexNormals[uIndex1],
-                    ptMesh->sbtVertexNormals[uIndex2],
-                };
-
-                const plVec3 tEdge1 = pl_sub_vec3(tP1, tP0);
-                const plVec3 tEdge2 = pl_sub_vec3(tP2, tP0);
-
-                const float fDeltaU1 = tTex1.x - tTex0.x;
-                const float fDeltaV1 = tTex1.y - tTex0.y;
-                const float fDeltaU2 = tTex2.x - tTex0.x;
-                const float fDeltaV2 = tTex2.y - tTex0.y;
-
-                const float fSx = fDeltaU1;
-                const float fSy = fDeltaU2;
-                const float fTx = fDeltaV1;
-                const float fTy = fDeltaV2;
-                const float fHandedness = ((fSx * fTy - fTx * fSy) < 0.0f) ? -1.0f : 1.0f;
-
-                const plVec3 tTangent = {
-                        fHandedness * (fDeltaV2 * tEdge1.x - fDeltaV1 * tEdge2.x),
-                        fHandedness * (fDeltaV2 * tEdge1.y - fDeltaV1 * tEdge2.y),
-                        fHandedness * (fDeltaV2 * tEdge1.z - fDeltaV1 * tEdge2.z)
-                };
-
-                plVec4 atFinalTangents[3] = {0};
-                for(uint32_t j = 0; j < 3; j++)
-                {
-                    atFinalTangents[j].xyz = pl_mul_vec3(tTangent, atNormals[j]);
-                    atFinalTangents[j].xyz = pl_mul_vec3(atNormals[j], atFinalTangents[j].xyz);
-                    atFinalTangents[j].xyz = pl_norm_vec3(pl_sub_vec3(tTangent, atFinalTangents[j].xyz));
-                    atFinalTangents[j].w = fHandedness;
-                }
+static uint64_t
+pl_ecs_get_stream_length(const plEcsInputStream* ptStream)
+{
+    return pl_sb_size(ptStream->sbuOffsets) - 1;
+}
 
-                ptMesh->sbtVertexTangents[uIndex0] = atFinalTangents[0];
-                ptMesh->sbtVertexTangents[uIndex1] = atFinalTangents[1];
-                ptMesh->sbtVertexTangents[uIndex2] = atFinalTangents[2];
-            } 
-        }
+static const void*
+pl_ecs_get_stream_input(const plEcsInputStream* ptStream, uint64_t uStep, uint32_t* puInputSizeOut)
+{
+    *puInputSizeOut = 0;
+    if(uStep >= pl_ecs_get_stream_length(ptStream))
+        return NULL;
+    const uint64_t uOffset = ptStream->sbuOffsets[uStep];
+    *puInputSizeOut = (uint32_t)(ptStream->sbuOffsets[uStep + 1] - uOffset);
+    return *puInputSizeOut > 0 ? &ptStream->sbucData[uOffset] : NULL;
+}
+
+static bool
+pl_ecs_save_input_stream(const plEcsInputStream* ptStream, void* pBuffer, size_t* pszSize)
+{
+    const plEcsInputStreamHeader tHeader = {
+        .uMagic     = PL__ECS_INPUT_STREAM_MAGIC,
+        .uVersion   = PL__ECS_INPUT_STREAM_VERSION,
+        .uStepCount = pl_ecs_get_stream_length(ptStream),
+        .uDataSize  = pl_sb_size(ptStream->sbucData)
+    };
+    const size_t szOffsetSize = sizeof(uint64_t) * (size_t)(tHeader.uStepCount + 1);
+    const size_t szSize = sizeof(plEcsInputStreamHeader) + szOffsetSize + (size_t)tHeader.uDataSize;
+    if(pBuffer == NULL)
+    {
+        *pszSize = szSize;
+        return true;
+    }
+    if(*pszSize < szSize)
+        return false;
+
+    unsigned char* pucBuffer = pBuffer;
+    memcpy(pucBuffer, &tHeader, sizeof(plEcsInputStreamHeader));
+    memcpy(&pucBuffer[sizeof(plEcsInputStreamHeader)], ptStream->sbuOffsets, szOffsetSize);
+    if(tHeader.uDataSize > 0)
+        memcpy(&pucBuffer[sizeof(plEcsInputStreamHeader) + szOffsetSize], ptStream->sbucData, (size_t)tHeader.uDataSize);
+    *pszSize = szSize;
+    return true;
+}
+
+static bool
+pl_ecs_load_input_stream(plEcsInputStream* ptStream, const void* pBuffer, size_t szSize)
+{
+    const unsigned char* pucBuffer = pBuffer;
+    plEcsInputStreamHeader tHeader;
+    if(szSize < sizeof(plEcsInputStreamHeader))
+        return false;
+    memcpy(&tHeader, pucBuffer, sizeof(plEcsInputStreamHeader));
+    if(tHeader.uMagic != PL__ECS_INPUT_STREAM_MAGIC || tHeader.uVersion != PL__ECS_INPUT_STREAM_VERSION)
+        return false;
+    if(tHeader.uStepCount >= UINT32_MAX || tHeader.uDataSize >= UINT32_MAX)
+        return false;
+    const size_t szOffsetSize = sizeof(uint64_t) * (size_t)(tHeader.uStepCount + 1);
+    if(szSize != sizeof(plEcsInputStreamHeader) + szOffsetSize + (size_t)tHeader.uDataSize)
+        return false;
+
+    // offsets must start at 0, never decrease & end at the data size
+    const unsigned char* pucOffsets = &pucBuffer[sizeof(plEcsInputStreamHeader)];
+    uint64_t uPrevious = 0;
+    for(uint64_t i = 0; i <= tHeader.uStepCount; i++)
+    {
+        uint64_t uOffset;
+        memcpy(&uOffset, &pucOffsets[sizeof(uint64_t) * i], sizeof(uint64_t));
+        if((i == 0 && uOffset != 0) || uOffset < uPrevious || uOffset > tHeader.uDataSize)
+            return false;
+        uPrevious = uOffset;
     }
+    if(uPrevious != tHeader.uDataSize)
+        return false;
+
+    pl_sb_resize(ptStream->sbuOffsets, (uint32_t)(tHeader.uStepCount + 1));
+    memcpy(ptStream->sbuOffsets, pucOffsets, szOffsetSize);
+    pl_sb_resize(ptStream->sbucData, (uint32_t)tHeader.uDataSize);
+    if(tHeader.uDataSize > 0)
+        memcpy(ptStream->sbucData, &pucOffsets[szOffsetSize], (size_t)tHeader.uDataSize);
+    return true;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] unity build
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_archetype.c"
+#include "pl_ecs_command_buffer.c"
+#include "pl_ecs_blend_tree.c"
+#include "pl_ecs_snapshot.c"
+#include "pl_ecs_name_index.c"
+
 //-----------------------------------------------------------------------------
 // [SECTION] extension loading
 //-----------------------------------------------------------------------------
@@ -1720,7 +4548,14 @@ pl_load_ecs_api(void)
         .cleanup_component_library            = pl_ecs_cleanup_component_library,
         .create_entity                        = pl_ecs_create_entity,
         .remove_entity                        = pl_ecs_remove_entity,
+        .remove_component                     = pl_ecs_remove_component,
         .get_entity                           = pl_ecs_get_entity,
+        .find_entities_by_prefix              = pl_ecs_find_entities_by_prefix,
+        .find_entities_by_glob                = pl_ecs_find_entities_by_glob,
+        .find_entities_by_path                = pl_ecs_find_entities_by_path,
+        .get_signature                        = pl_ecs_get_signature,
+        .has_component                        = pl_ecs_has_component,
+        .get_entities_with                    = pl_ecs_get_entities_with,
         .is_entity_valid                      = pl_ecs_is_entity_valid,
         .get_index                            = pl_ecs_get_index,
         .get_component                        = pl_ecs_get_component,
@@ -1743,13 +4578,75 @@ pl_load_ecs_api(void)
         .deattach_component                   = pl_ecs_deattach_component,
         .calculate_normals                    = pl_calculate_normals,
         .calculate_tangents                   = pl_calculate_tangents,
+        .calculate_tangents_ex                = pl_calculate_tangents_ex,
         .run_object_update_system             = pl_run_object_update_system,
         .run_transform_update_system          = pl_run_transform_update_system,
         .run_hierarchy_update_system          = pl_run_hierarchy_update_system,
         .run_skin_update_system               = pl_run_skin_update_system,
         .run_animation_update_system          = pl_run_animation_update_system,
         .run_inverse_kinematics_update_system = pl_run_inverse_kinematics_update_system,
-        .run_script_update_system             = pl_run_script_update_system
+        .run_script_update_system             = pl_run_script_update_system,
+        .run_systems                          = pl_run_systems,
+        .set_deterministic                    = pl_ecs_set_deterministic,
+        .invalidate_animation_cache           = pl_ecs_invalidate_animation_cache,
+        .compress_animation                   = pl_ecs_compress_animation,
+        .create_blend_tree                    = pl_ecs_create_blend_tree,
+        .cleanup_blend_tree                   = pl_ecs_cleanup_blend_tree,
+        .add_blend_clip                       = pl_ecs_add_blend_clip,
+        .add_blend_space_1d                   = pl_ecs_add_blend_space_1d,
+        .add_blend_space_2d                   = pl_ecs_add_blend_space_2d,
+        .add_blend_layer                      = pl_ecs_add_blend_layer,
+        .set_blend_parameter                  = pl_ecs_set_blend_parameter,
+        .set_blend_clip_time                  = pl_ecs_set_blend_clip_time,
+        .run_blend_tree_system                = pl_run_blend_tree_system,
+        .run_cpu_skinning_system              = pl_run_cpu_skinning_system,
+        .get_skinned_mesh_data                = pl_ecs_get_skinned_mesh_data,
+        .get_changed_bitset                   = pl_ecs_get_changed_bitset,
+        .mark_transform_dirty                 = pl_ecs_mark_transform_dirty,
+        .create_query                         = pl_ecs_create_query,
+        .cleanup_query                        = pl_ecs_cleanup_query,
+        .create_command_buffer                = pl_ecs_create_command_buffer,
+        .cleanup_command_buffer               = pl_ecs_cleanup_command_buffer,
+        .reset_command_buffer                 = pl_ecs_reset_command_buffer,
+        .cmd_create_entity                    = pl_ecs_cmd_create_entity,
+        .cmd_remove_entity                    = pl_ecs_cmd_remove_entity,
+        .cmd_add_component                    = pl_ecs_cmd_add_component,
+        .cmd_remove_component                 = pl_ecs_cmd_remove_component,
+        .resolve_entity                       = pl_ecs_resolve_entity,
+        .playback_command_buffers             = pl_ecs_playback_command_buffers,
+        .save_snapshot                        = pl_ecs_save_snapshot,
+        .load_snapshot                        = pl_ecs_load_snapshot,
+        .create_render_snapshot               = pl_ecs_create_render_snapshot,
+        .cleanup_render_snapshot              = pl_ecs_cleanup_render_snapshot,
+        .extract_render_snapshot              = pl_ecs_extract_render_snapshot,
+        .get_render_object                    = pl_ecs_get_render_object,
+        .get_render_skin_palette              = pl_ecs_get_render_skin_palette,
+        .set_fixed_step                       = pl_ecs_set_fixed_step,
+        .advance_fixed_step                   = pl_ecs_advance_fixed_step,
+        .run_fixed_steps                      = pl_ecs_run_fixed_steps,
+        .get_fixed_step_state                 = pl_ecs_get_fixed_step_state,
+        .create_input_stream                  = pl_ecs_create_input_stream,
+        .cleanup_input_stream                 = pl_ecs_cleanup_input_stream,
+        .append_stream_input                  = pl_ecs_append_stream_input,
+        .get_stream_input                     = pl_ecs_get_stream_input,
+        .get_stream_length                    = pl_ecs_get_stream_length,
+        .save_input_stream                    = pl_ecs_save_input_stream,
+        .load_input_stream                    = pl_ecs_load_input_stream,
+        .create_archetype_storage             = pl_ecs_create_archetype_storage,
+        .cleanup_archetype_storage            = pl_ecs_cleanup_archetype_storage,
+        .archetype_import_library             = pl_ecs_archetype_import_library,
+        .archetype_create_entity              = pl_ecs_archetype_create_entity,
+        .archetype_remove_entity              = pl_ecs_archetype_remove_entity,
+        .archetype_is_entity_valid            = pl_ecs_archetype_is_entity_valid,
+        .archetype_get_component              = pl_ecs_archetype_get_component,
+        .archetype_add_component              = pl_ecs_archetype_add_component,
+        .archetype_remove_component           = pl_ecs_archetype_remove_component,
+        .archetype_query_begin                = pl_ecs_archetype_query_begin,
+        .archetype_query_next                 = pl_ecs_archetype_query_next,
+        .run_archetype_transform_update_system = pl_run_archetype_transform_update_system,
+        .run_archetype_hierarchy_update_system = pl_run_archetype_hierarchy_update_system,
+        .run_archetype_object_update_system    = pl_run_archetype_object_update_system,
+        .run_archetype_skin_update_system      = pl_run_archetype_skin_update_system
     };
     return &tApi;
 }
@@ -1758,15 +4655,17 @@ static const plCameraI*
 pl_load_camera_api(void)
 {
     static const plCameraI tApi = {
-        .set_fov         = pl_camera_set_fov,
-        .set_clip_planes = pl_camera_set_clip_planes,
-        .set_aspect      = pl_camera_set_aspect,
-        .set_pos         = pl_camera_set_pos,
-        .set_pitch_yaw   = pl_camera_set_pitch_yaw,
-        .translate       = pl_camera_translate,
-        .rotate          = pl_camera_rotate,
-        .update          = pl_camera_update,
-        .look_at         = pl_camera_look_at,
+        .set_fov           = pl_camera_set_fov,
+        .set_clip_planes   = pl_camera_set_clip_planes,
+        .set_aspect        = pl_camera_set_aspect,
+        .set_pos           = pl_camera_set_pos,
+        .set_pitch_yaw     = pl_camera_set_pitch_yaw,
+        .translate         = pl_camera_translate,
+        .rotate            = pl_camera_rotate,
+        .update            = pl_camera_update,
+        .look_at           = pl_camera_look_at,
+        .get_derived_data  = pl_camera_get_derived_data,
+        .get_frustum_slice = pl_camera_get_frustum_slice,
     };
     return &tApi;   
 }
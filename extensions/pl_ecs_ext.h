@@ -41,6 +41,68 @@ typedef struct _plCameraI plCameraI;
 
 #define PL_MAX_SHADOW_CASCADES 4
 
+#ifndef PL_ECS_CHUNK_SIZE
+    #define PL_ECS_CHUNK_SIZE 16384 // archetype storage chunk size in bytes
+#endif
+
+#ifndef PL_ECS_TRANSFORM_BATCH_SIZE
+    #define PL_ECS_TRANSFORM_BATCH_SIZE 256 // transforms per job
+#endif
+
+#ifndef PL_ECS_SKIN_BATCH_SIZE
+    #define PL_ECS_SKIN_BATCH_SIZE 4 // skins per job
+#endif
+
+#ifndef PL_ECS_ANIMATION_BATCH_SIZE
+    #define PL_ECS_ANIMATION_BATCH_SIZE 8 // animations per job
+#endif
+
+#ifndef PL_ECS_BLEND_TREE_BATCH_SIZE
+    #define PL_ECS_BLEND_TREE_BATCH_SIZE 1 // blend trees (characters) per job
+#endif
+
+#ifndef PL_ECS_CPU_SKINNING_BATCH_SIZE
+    #define PL_ECS_CPU_SKINNING_BATCH_SIZE 1 // skinned meshes per job
+#endif
+
+#ifndef PL_ECS_SCRIPT_BATCH_SIZE
+    #define PL_ECS_SCRIPT_BATCH_SIZE 8 // parallel scripts per job (each batch records into its own command buffer)
+#endif
+
+#ifndef PL_ECS_IK_BATCH_SIZE
+    #define PL_ECS_IK_BATCH_SIZE 16 // inverse kinematics chains per job
+#endif
+
+#ifndef PL_ECS_EXTRACT_BATCH_SIZE
+    #define PL_ECS_EXTRACT_BATCH_SIZE 512 // objects per render extraction job
+#endif
+
+#ifndef PL_ECS_MAX_JOB_BATCHES
+    #define PL_ECS_MAX_JOB_BATCHES 32 // batches per dispatch (keep below pl_job_ext.c's PL_MAX_BATCHES)
+#endif
+
+#ifndef PL_ECS_FIXED_STEP_SIZE
+    #define PL_ECS_FIXED_STEP_SIZE (1.0f / 60.0f) // default fixed timestep (seconds)
+#endif
+
+#ifndef PL_ECS_MAX_SUBSTEPS
+    #define PL_ECS_MAX_SUBSTEPS 8 // default fixed steps per advance (excess frame time is dropped)
+#endif
+
+#ifndef PL_ECS_MESH_RANGE_SIZE
+    #define PL_ECS_MESH_RANGE_SIZE 4096 // triangles/vertices per normal & tangent generation job
+#endif
+
+#ifndef PL_ECS_MAX_HIERARCHY_DEPTH
+    #define PL_ECS_MAX_HIERARCHY_DEPTH 64
+#endif
+
+#ifndef PL_ECS_ANIMATION_TOLERANCE
+    #define PL_ECS_ANIMATION_TOLERANCE 0.0001f // default compression tolerance (units & radians)
+#endif
+
+#define PL_COMPONENT_MASK(tType) (1ull << (tType))
+
 //-----------------------------------------------------------------------------
 // [SECTION] includes
 //-----------------------------------------------------------------------------
@@ -59,6 +121,22 @@ typedef struct _plComponentManager plComponentManager;
 typedef struct _plTextureMap       plTextureMap;
 typedef struct _plAnimationChannel plAnimationChannel;
 typedef struct _plAnimationSampler plAnimationSampler;
+typedef struct _plAnimationClip    plAnimationClip; // opaque type (packed channel data)
+typedef struct _plAnimationCompressionDesc plAnimationCompressionDesc;
+typedef struct _plAnimationBlendTree plAnimationBlendTree; // opaque type (per character pose evaluator)
+typedef struct _plBlendLayerDesc     plBlendLayerDesc;
+typedef struct _plSkinnedMeshData    plSkinnedMeshData;
+typedef struct _plArchetypeStorage plArchetypeStorage; // opaque type (chunked SoA entity storage)
+typedef struct _plArchetypeIterator plArchetypeIterator;
+typedef struct _plEcsQuery          plEcsQuery;
+typedef struct _plEcsCommandBuffer  plEcsCommandBuffer; // opaque type (deferred entity/component changes)
+typedef struct _plRenderSnapshot    plRenderSnapshot;
+typedef struct _plRenderObject      plRenderObject;
+typedef struct _plRenderSkin        plRenderSkin;
+typedef struct _plCameraDerivedData plCameraDerivedData;
+typedef struct _plFixedStepDesc     plFixedStepDesc;
+typedef struct _plFixedStepState    plFixedStepState;
+typedef struct _plEcsInputStream    plEcsInputStream; // opaque type (recorded per step inputs)
 
 // ecs components
 typedef struct _plTagComponent               plTagComponent;
@@ -87,11 +165,16 @@ typedef int plCameraType;
 typedef int plAnimationMode;
 typedef int plAnimationPath;
 typedef int plAnimationFlags;
+typedef int plBlendLayerMode;
+typedef int plIKSolver;
+typedef int plTangentMode;
 typedef int plMeshFormatFlags;
 typedef int plLightFlags;
 typedef int plLightType;
 typedef int plHumanoidBone;
 
+typedef uint64_t plComponentMask; // bit per plComponentType (see PL_COMPONENT_MASK)
+
 typedef union _plEntity
 {
     struct
@@ -122,7 +205,19 @@ typedef struct _plEcsI
     plEntity (*get_entity)     (plComponentLibrary*, const char* pcName);
     void*    (*get_component)  (plComponentLibrary*, plComponentType, plEntity);
     void*    (*add_component)  (plComponentLibrary*, plComponentType, plEntity);
+    void     (*remove_component)(plComponentLibrary*, plComponentType, plEntity);
     size_t   (*get_index)      (plComponentManager*, plEntity);
+
+    // name lookups (return match count, write up to uMaxEntities sorted by name; NULL/0 to count)
+    //   - names are indexed when tags are added; rename by removing & re-adding the tag
+    uint32_t (*find_entities_by_prefix)(plComponentLibrary*, const char* pcPrefix, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+    uint32_t (*find_entities_by_glob)  (plComponentLibrary*, const char* pcPattern, plEntity* atEntitiesOut, uint32_t uMaxEntities); // '*' & '?'
+    uint32_t (*find_entities_by_path)  (plComponentLibrary*, const char* pcPath, plEntity* atEntitiesOut, uint32_t uMaxEntities);    // "root/arm/hand", segments may be globs
+
+    // component signatures (PL_COMPONENT_MASK bits of the components an entity owns)
+    plComponentMask (*get_signature)    (plComponentLibrary*, plEntity); // 0 for invalid entities
+    bool            (*has_component)    (plComponentLibrary*, plComponentType, plEntity);
+    uint32_t        (*get_entities_with)(plComponentLibrary*, plComponentMask tRequired, plComponentMask tExcluded, plEntity* atEntitiesOut, uint32_t uMaxEntities); // returns count; NULL/0 to count
     
     // entity helpers (creates entity and necessary components)
     //   - do NOT store out parameter; use it immediately
@@ -147,9 +242,10 @@ typedef struct _plEcsI
     void (*attach_component)   (plComponentLibrary*, plEntity tEntity, plEntity tParent);
     void (*deattach_component) (plComponentLibrary*, plEntity);
 
-    // meshes
-    void (*calculate_normals) (plMeshComponent*, uint32_t uMeshCount);
-    void (*calculate_tangents)(plMeshComponent*, uint32_t uMeshCount);
+    // meshes (only fill missing streams; tangents also need normals & TEXCOORD_0)
+    void (*calculate_normals)    (plMeshComponent*, uint32_t uMeshCount);
+    void (*calculate_tangents)   (plMeshComponent*, uint32_t uMeshCount); // PL_TANGENT_MODE_FAST
+    void (*calculate_tangents_ex)(plMeshComponent*, uint32_t uMeshCount, plTangentMode); // mikktspace may split vertices
 
     // systems
     void (*run_object_update_system)            (plComponentLibrary*);
@@ -159,6 +255,97 @@ typedef struct _plEcsI
     void (*run_animation_update_system)         (plComponentLibrary*, float fDeltaTime);
     void (*run_inverse_kinematics_update_system)(plComponentLibrary*);
     void (*run_script_update_system)            (plComponentLibrary*);
+    void (*run_systems)                         (plComponentLibrary*, float fDeltaTime); // script, animation, blend tree, transform, hierarchy, IK, skin, object
+    void (*set_deterministic)                   (plComponentLibrary*, bool); // always on during fixed steps
+
+    // animation (call "invalidate_animation_cache" after editing channels, samplers or their data)
+    void (*invalidate_animation_cache)(plComponentLibrary*, plEntity tAnimation);
+    void (*compress_animation)        (plComponentLibrary*, plEntity tAnimation, const plAnimationCompressionDesc* ptDesc); // ptDesc may be NULL
+
+    // animation blend trees (layered pose evaluation per character)
+    //   - inputs must be added before the nodes using them; the last node added is the output
+    plAnimationBlendTree* (*create_blend_tree)      (plComponentLibrary*, uint32_t uJointCount, const plEntity* atJoints);
+    void                  (*cleanup_blend_tree)     (plComponentLibrary*, plAnimationBlendTree**); // before the library
+    uint32_t              (*add_blend_clip)         (plAnimationBlendTree*, plEntity tAnimation, float fSpeed, bool bLoop);
+    uint32_t              (*add_blend_space_1d)     (plAnimationBlendTree*, uint32_t uInputCount, const uint32_t* auInputs, const float* afPositions); // ascending
+    uint32_t              (*add_blend_space_2d)     (plAnimationBlendTree*, uint32_t uInputCount, const uint32_t* auInputs, const plVec2* atPositions);
+    uint32_t              (*add_blend_layer)        (plAnimationBlendTree*, const plBlendLayerDesc*);
+    void                  (*set_blend_parameter)    (plAnimationBlendTree*, uint32_t uNode, plVec2 tValue); // blend position (x: layer weight)
+    void                  (*set_blend_clip_time)    (plAnimationBlendTree*, uint32_t uNode, float fTime);
+    void                  (*run_blend_tree_system)  (plComponentLibrary*, float fDeltaTime); // before transform & hierarchy systems
+
+    // cpu skinning (reference & headless fallback for shaders/skinning.comp)
+    void                     (*run_cpu_skinning_system)(plComponentLibrary*); // after skin & object systems
+    const plSkinnedMeshData* (*get_skinned_mesh_data)  (plComponentLibrary*, plEntity tMesh); // valid until the next run
+
+    // change tracking (bit i set if dense index i changed during the last system run)
+    const uint64_t* (*get_changed_bitset)  (plComponentLibrary*, plComponentType, uint32_t* puBitCountOut);
+    void            (*mark_transform_dirty)(plComponentLibrary*, plEntity); // after writing tWorld directly
+
+    // cached queries (entities having every listed component & dense indices into each manager)
+    plEcsQuery* (*create_query) (plComponentLibrary*, uint32_t uComponentCount, const plComponentType*);
+    void        (*cleanup_query)(plComponentLibrary*, plEcsQuery**); // before the library
+
+    // command buffers (deferred entity/component changes, one buffer per job/thread)
+    //   - do NOT store "cmd_add_component" result; only valid until the next record
+    plEcsCommandBuffer* (*create_command_buffer)   (plComponentLibrary*);
+    void                (*cleanup_command_buffer)  (plEcsCommandBuffer**);
+    void                (*reset_command_buffer)    (plEcsCommandBuffer*);
+    plEntity            (*cmd_create_entity)       (plEcsCommandBuffer*); // placeholder until playback
+    void                (*cmd_remove_entity)       (plEcsCommandBuffer*, plEntity);
+    void*               (*cmd_add_component)       (plEcsCommandBuffer*, plComponentType, plEntity);
+    void                (*cmd_remove_component)    (plEcsCommandBuffer*, plComponentType, plEntity);
+    plEntity            (*resolve_entity)          (plEcsCommandBuffer*, plEntity); // placeholder -> entity after playback
+    void                (*playback_command_buffers)(plComponentLibrary*, uint32_t uBufferCount, plEcsCommandBuffer**); // in array & record order
+
+    // snapshots (versioned binary image of the whole library; pass pBuffer NULL to query size)
+    bool (*save_snapshot)(plComponentLibrary*, void* pBuffer, size_t* pszSize);
+    bool (*load_snapshot)(plComponentLibrary*, const void* pBuffer, size_t szSize); // library must have no entities
+
+    // render extraction (packed copy of render relevant state, see plRenderSnapshot)
+    plRenderSnapshot*     (*create_render_snapshot) (void);
+    void                  (*cleanup_render_snapshot)(plRenderSnapshot**);
+    void                  (*extract_render_snapshot)(plComponentLibrary*, plRenderSnapshot*); // after object & skin systems
+    const plRenderObject* (*get_render_object)      (const plRenderSnapshot*, plEntity tObject);
+    const plMat4*         (*get_render_skin_palette)(const plRenderSnapshot*, plEntity tSkin, uint32_t* puMatrixCountOut);
+
+    // fixed timestep simulation (each step: desc's "step" callback, then "run_systems")
+    void                    (*set_fixed_step)      (plComponentLibrary*, const plFixedStepDesc*); // NULL disables
+    uint32_t                (*advance_fixed_step)  (plComponentLibrary*, float fDeltaTime, const void* pInput, uint32_t uInputSize); // returns steps run
+    void                    (*run_fixed_steps)     (plComponentLibrary*, uint32_t uStepCount, const void* pInput, uint32_t uInputSize);
+    const plFixedStepState* (*get_fixed_step_state)(plComponentLibrary*);
+
+    // input streams (one input blob per fixed step; pass pBuffer NULL to query size)
+    plEcsInputStream* (*create_input_stream) (void);
+    void              (*cleanup_input_stream)(plEcsInputStream**);
+    void              (*append_stream_input) (plEcsInputStream*, const void* pInput, uint32_t uInputSize);
+    const void*       (*get_stream_input)    (const plEcsInputStream*, uint64_t uStep, uint32_t* puInputSizeOut);
+    uint64_t          (*get_stream_length)   (const plEcsInputStream*);
+    bool              (*save_input_stream)   (const plEcsInputStream*, void* pBuffer, size_t* pszSize);
+    bool              (*load_input_stream)   (plEcsInputStream*, const void* pBuffer, size_t szSize);
+
+    // archetype storage (chunked SoA backend)
+    //   - adding/removing a component moves the entity (previously returned pointers are invalidated)
+    plArchetypeStorage* (*create_archetype_storage) (void);
+    void                (*cleanup_archetype_storage)(plArchetypeStorage**);
+    void                (*archetype_import_library) (plArchetypeStorage*, plComponentLibrary*); // storage must be empty; keeps entity handles
+    plEntity (*archetype_create_entity)   (plArchetypeStorage*, plComponentMask);
+    void     (*archetype_remove_entity)   (plArchetypeStorage*, plEntity);
+    bool     (*archetype_is_entity_valid) (plArchetypeStorage*, plEntity);
+    void*    (*archetype_get_component)   (plArchetypeStorage*, plComponentType, plEntity);
+    void*    (*archetype_add_component)   (plArchetypeStorage*, plComponentType, plEntity);
+    void     (*archetype_remove_component)(plArchetypeStorage*, plComponentType, plEntity);
+
+    // archetype queries (visit every chunk whose archetype has all required & none of the excluded components)
+    //   - do NOT add/remove entities or components while iterating
+    void (*archetype_query_begin)(plArchetypeStorage*, plComponentMask tRequired, plComponentMask tExcluded, plArchetypeIterator*);
+    bool (*archetype_query_next) (plArchetypeIterator*);
+
+    // archetype storage systems (same results as component library versions)
+    void (*run_archetype_transform_update_system)(plArchetypeStorage*);
+    void (*run_archetype_hierarchy_update_system)(plArchetypeStorage*);
+    void (*run_archetype_object_update_system)   (plArchetypeStorage*);
+    void (*run_archetype_skin_update_system)     (plArchetypeStorage*);
 } plEcsI;
 
 typedef struct _plCameraI
@@ -172,6 +359,10 @@ typedef struct _plCameraI
     void (*rotate)         (plCameraComponent*, float fDPitch, float fDYaw);
     void (*look_at)        (plCameraComponent*, plVec3 tEye, plVec3 tTarget);
     void (*update)         (plCameraComponent*);
+
+    // derived data (rebuilt once per uVersion, see plCameraDerivedData)
+    const plCameraDerivedData* (*get_derived_data) (plCameraComponent*); // writes to the camera; call before handing to jobs
+    void                       (*get_frustum_slice)(plCameraComponent*, float fStart, float fEnd, plVec3 atCornersOut[8]); // near to far fractions
 } plCameraI;
 
 //-----------------------------------------------------------------------------
@@ -265,6 +456,24 @@ enum _plAnimationFlags
     PL_ANIMATION_FLAG_LOOPED  = 1 << 1
 };
 
+enum _plBlendLayerMode
+{
+    PL_BLEND_LAYER_MODE_OVERRIDE, // lerp from base to layer
+    PL_BLEND_LAYER_MODE_ADDITIVE  // add the layer's difference from the reference pose
+};
+
+enum _plIKSolver
+{
+    PL_IK_SOLVER_CCD,   // cyclic coordinate descent (rotates each joint toward the target, effector first)
+    PL_IK_SOLVER_FABRIK // forward & backward reaching (repositions joints, then derives rotations)
+};
+
+enum _plTangentMode
+{
+    PL_TANGENT_MODE_FAST,      // area weighted average of adjacent triangles (never splits vertices)
+    PL_TANGENT_MODE_MIKKTSPACE // matches MikkTSpace (what most bakers use for tangent space normal maps)
+};
+
 enum _plScriptFlags
 {
     PL_SCRIPT_FLAG_NONE       = 0,
@@ -412,6 +621,33 @@ typedef struct _plAnimationChannel
     uint32_t        uSamplerIndex;
 } plAnimationChannel;
 
+typedef struct _plAnimationCompressionDesc
+{
+    float fTranslationTolerance; // max per axis difference from the source
+    float fRotationTolerance;    // max angle from the source (radians)
+    float fScaleTolerance;       // max per axis difference from the source
+} plAnimationCompressionDesc;
+
+typedef struct _plBlendLayerDesc
+{
+    plBlendLayerMode tMode;
+    uint32_t         uBase;
+    uint32_t         uLayer;
+    uint32_t         uReference; // additive only
+    float            fWeight;
+    const float*     afMask;     // optional per joint weights (copied)
+} plBlendLayerDesc;
+
+typedef struct _plSkinnedMeshData
+{
+    plEntity tMesh;
+    uint32_t uVertexCount;
+    uint32_t uDataStride;        // vec4s per vertex in sbtVertexData
+    plVec3*  sbtVertexPositions; // vertex position buffer layout
+    plVec4*  sbtVertexData;      // vertex data buffer layout (normal, tangent, texture coordinates, color)
+    plAABB   tAABB;              // skinned bounds (mesh node space)
+} plSkinnedMeshData;
+
 typedef struct _plComponentManager
 {
     plComponentLibrary* ptParentLibrary;
@@ -424,9 +660,10 @@ typedef struct _plComponentManager
 
 typedef struct _plComponentLibrary
 {
-    uint32_t*  sbtEntityGenerations;
-    uint32_t*  sbtEntityFreeIndices;
-    plHashMap* ptTagHashmap;
+    uint32_t*        sbtEntityGenerations;
+    uint32_t*        sbtEntityFreeIndices;
+    plComponentMask* sbtEntitySignatures; // components owned, indexed by entity index
+    plHashMap*       ptTagHashmap;
 
     // managers
     plComponentManager tTagComponentManager;
@@ -448,6 +685,100 @@ typedef struct _plComponentLibrary
     void*               pInternal;
 } plComponentLibrary;
 
+typedef struct _plEcsQuery
+{
+    uint32_t        uComponentCount;
+    plComponentType atComponentTypes[PL_COMPONENT_TYPE_COUNT];
+
+    // results (row i: sbtEntities[i] with components at index sbuIndices[j][i] of atComponentTypes[j]'s manager)
+    uint32_t        uCount;
+    plEntity*       sbtEntities;
+    uint32_t*       sbuIndices[PL_COMPONENT_TYPE_COUNT];
+
+    // [INTERNAL]
+    plComponentMask _tMask;
+    uint32_t*       _sbuRows; // entity index -> row (UINT32_MAX if not matched)
+} plEcsQuery;
+
+typedef struct _plCameraDerivedData
+{
+    uint32_t uVersion;        // camera version this was built for
+    float    fTanHalfFovY;    // perspective only
+    float    fTanHalfFovX;    // perspective only (fTanHalfFovY * aspect)
+    plMat4   tViewProjMat;    // tProjMat * tViewMat
+    plMat4   tInvViewProjMat;
+    plVec4   atPlanes[6];     // world space, inward unit normal & offset; left, right, bottom, top, near, far
+    plVec3   atCorners[8];    // world space; near plane (-x +y, -x -y, +x -y, +x +y in clip space), then far plane
+} plCameraDerivedData;
+
+typedef struct _plRenderObject
+{
+    plEntity tEntity;   // object
+    plEntity tMesh;
+    plEntity tMaterial;
+    plEntity tSkin;     // mesh's tSkinComponent
+    plMat4   tWorld;    // object transform
+    plAABB   tAABB;     // world space (mesh tAABBFinal)
+} plRenderObject;
+
+typedef struct _plRenderSkin
+{
+    plEntity tEntity;
+    uint32_t uPaletteOffset; // into sbtPalettes
+    uint32_t uPaletteCount;  // matrices (joint & normal matrix per joint, sbtTextureData layout)
+} plRenderSkin;
+
+typedef struct _plRenderSnapshot
+{
+    uint64_t        uFrame;       // extraction number within the library (0 if never extracted)
+    uint32_t        uObjectCount;
+    plRenderObject* sbtObjects;   // object component order
+    uint32_t        uSkinCount;
+    plRenderSkin*   sbtSkins;     // skin component order
+    plMat4*         sbtPalettes;
+
+    // [INTERNAL]
+    uint32_t* _sbuObjectRows; // entity index -> row (UINT32_MAX if not extracted)
+    uint32_t* _sbuSkinRows;
+} plRenderSnapshot;
+
+typedef struct _plFixedStepDesc
+{
+    float             fStepSize;        // seconds (default: PL_ECS_FIXED_STEP_SIZE)
+    uint32_t          uMaxSubsteps;     // per "advance_fixed_step" (default: PL_ECS_MAX_SUBSTEPS)
+    bool              bInterpolate;     // blend extracted object transforms between the last two steps
+    plEcsInputStream* ptRecordStream;   // optional, every step's input is appended
+    plEcsInputStream* ptPlaybackStream; // optional, replaces the inputs passed in
+    void            (*step)(plComponentLibrary*, uint64_t uStep, const void* pInput, uint32_t uInputSize, void* pUserData); // optional
+    void*             pUserData;
+} plFixedStepDesc;
+
+typedef struct _plFixedStepState
+{
+    plFixedStepDesc tDesc;         // defaults applied
+    uint64_t        uStep;         // steps run (index of the running step during a step)
+    uint64_t        uDroppedSteps; // steps skipped by the uMaxSubsteps guard
+    double          dAccumulator;  // seconds not yet simulated
+    float           fAlpha;        // dAccumulator / fStepSize (interpolation factor)
+    const void*     pInput;        // input of the running step (NULL outside of steps)
+    uint32_t        uInputSize;
+} plFixedStepState;
+
+typedef struct _plArchetypeIterator
+{
+    // current chunk (valid after archetype_query_next(...) returns true)
+    uint32_t        uCount;
+    const plEntity* atEntities;
+    void*           apColumns[PL_COMPONENT_TYPE_COUNT]; // indexed by plComponentType, NULL if archetype lacks component
+
+    // [INTERNAL]
+    plArchetypeStorage* _ptStorage;
+    plComponentMask     _tRequired;
+    plComponentMask     _tExcluded;
+    uint32_t            _uArchetype;
+    uint32_t            _uChunk;
+} plArchetypeIterator;
+
 //-----------------------------------------------------------------------------
 // [SECTION] components
 //-----------------------------------------------------------------------------
@@ -557,6 +888,14 @@ typedef struct _plCameraComponent
     plVec3       _tUpVec;
     plVec3       _tForwardVec;
     plVec3       _tRightVec;
+
+    // cached derived data (see plCameraI)
+    uint32_t            uVersion; // bumped whenever the matrices are rebuilt
+    plCameraDerivedData tDerived; // valid after plCameraI.get_derived_data
+
+    // [INTERNAL]
+    uint32_t _uBuiltVersion;      // version the matrices were last built for (0 if never)
+    float    _afBuiltInputs[13];  // inputs the matrices were last built from
 } plCameraComponent;
 
 typedef struct _plAnimationDataComponent
@@ -575,20 +914,31 @@ typedef struct _plAnimationComponent
     float               fBlendAmount;
     plAnimationChannel* sbtChannels;
     plAnimationSampler* sbtSamplers;
+
+    // [INTERNAL]
+    plAnimationClip* _ptClip; // packed on first update
 } plAnimationComponent;
 
 typedef struct _plInverseKinematicsComponent
 {
-    bool     bEnabled;
-    plEntity tTarget;
-    uint32_t uChainLength;
-    uint32_t uIterationCount;
+    bool       bEnabled;
+    plEntity   tTarget;
+    uint32_t   uChainLength;    // ancestors rotated (max 31)
+    uint32_t   uIterationCount; // max iterations
+    plIKSolver tSolver;
+    float      fTolerance;      // stop once the effector is this close to the target
 } plInverseKinematicsComponent;
 
 typedef struct _plScriptComponent
 {
     plScriptFlags tFlags;
     char          acFile[PL_MAX_NAME_LENGTH];
+
+    // component access of "run_job" (bits are 1 << plComponentType), usually set by "setup"
+    uint64_t uReads;        // read on any entity
+    uint64_t uWrites;       // written on any entity
+    uint64_t uEntityWrites; // written on the script's entity only
+
     const struct _plScriptI* _ptApi;
 } plScriptComponent;
 
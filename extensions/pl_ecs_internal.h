@@ -0,0 +1,781 @@
+/*
+   pl_ecs_internal.h
+   - FORWARD COMPATIBILITY NOT GUARANTEED
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] structs
+// [SECTION] global data
+// [SECTION] internal api
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_ECS_INTERNAL_H
+#define PL_ECS_INTERNAL_H
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <float.h> // FLT_MAX
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl.h"
+#include "pl_ecs_ext.h"
+#include "pl_ds.h"
+#include "pl_math.h"
+#include "pl_profile.h"
+#include "pl_log.h"
+
+// skin palette matrix products & cpu skinning use SSE2 when available (define PL_ECS_NO_SIMD to force the scalar path)
+#if !defined(PL_ECS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PL__ECS_SSE2
+    #include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+    static inline uint32_t pl__ecs_ctz64(uint64_t uValue) { unsigned long ulIndex = 0; _BitScanForward64(&ulIndex, uValue); return (uint32_t)ulIndex; }
+#else
+    static inline uint32_t pl__ecs_ctz64(uint64_t uValue) { return (uint32_t)__builtin_ctzll(uValue); }
+#endif
+
+// extensions
+#include "pl_job_ext.h"
+#include "pl_script_ext.h"
+#include "pl_ext.inc"
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plTransformCache
+{
+    plVec3   tScale;       // local values tLocal was built from
+    plVec4   tRotation;
+    plVec3   tTranslation;
+    plMat4   tLocal;
+    uint32_t uParentIndex; // parent transform used for last world matrix (UINT32_MAX if none)
+} plTransformCache;
+
+typedef struct _plObjectCache
+{
+    plEntity tTransform; // inputs the world AABB was last built from
+    plEntity tMesh;
+    plAABB   tAABB;
+} plObjectCache;
+
+typedef struct _plSkinCache
+{
+    uint32_t  uMeshNode; // dense transform indices (refreshed when the transform moves)
+    uint32_t* sbuJoints;
+} plSkinCache;
+
+typedef struct _plIKChain
+{
+    plEntity  tEffector; // IK entity the chain was built for
+    uint32_t  uLength;   // chain length it was built with
+    uint32_t  uTarget;   // dense transform index (refreshed when the transform moves)
+    uint32_t  uWave;     // solved after every chain of an earlier wave it shares transforms with
+    plEntity* sbtJoints; // effector first, then its ancestors
+    uint32_t* sbuJoints; // dense transform indices
+} plIKChain;
+
+typedef struct _plAnimationTrack
+{
+    plAnimationMode tMode;
+    uint32_t        uKeyCount;
+    uint32_t        uCursor;          // last next key (forward playback fast path)
+    uint32_t        uTimeOffset;      // into sbfTimes
+    uint32_t        uValueOffset;     // into sbfValues
+    uint32_t        uLaneOffset;      // into sbfSamples
+    uint32_t        uLaneCount;       // floats per key section (every channel of the track)
+    uint32_t        uVectorLaneCount; // leading lanes of vec3 channels (quaternions follow)
+} plAnimationTrack;
+
+typedef struct _plCompressedChannel
+{
+    uint32_t uLane;        // into sbfSamples
+    uint32_t uTrack;       // key times are shared with this track
+    uint32_t uKeyCount;    // kept keys (0 if constant)
+    uint32_t uKeyOffset;   // into sbuKeys
+    uint32_t uValueOffset; // into sbuValues (3 per kept key)
+    uint32_t uCursor;      // last next kept key (forward playback fast path)
+    bool     bRotation;    // smallest three quaternion (otherwise fixed point vec3)
+    bool     bStep;
+    plVec4   tConstant;    // value of constant channels
+    plVec3   tMin;         // fixed point range: tMin + value * tScale
+    plVec3   tScale;
+} plCompressedChannel;
+
+typedef struct _plAnimationClip
+{
+    plAnimationTrack*    sbtTracks;       // channels sharing a sampling mode & key times
+    float*               sbfTimes;
+    float*               sbfValues;       // per track: [key][section][lane]
+    float*               sbfSamples;      // per track: [lane] (last sampled values), compressed channels follow
+    uint32_t*            sbuChannelLanes; // channel -> first lane in sbfSamples (UINT32_MAX if not sampled)
+
+    // compressed clips only (linear & step channels)
+    plCompressedChannel* sbtCompressedChannels;
+    uint16_t*            sbuKeys;         // kept keys (indices into the track's key times)
+    uint16_t*            sbuValues;
+    bool                 bCompressed;
+    plAnimationCompressionDesc tCompression; // kept so snapshots can rebuild compressed clips
+} plAnimationClip;
+
+typedef enum _plBlendNodeType
+{
+    PL_BLEND_NODE_TYPE_CLIP,
+    PL_BLEND_NODE_TYPE_SPACE_1D,
+    PL_BLEND_NODE_TYPE_SPACE_2D,
+    PL_BLEND_NODE_TYPE_LAYER
+} plBlendNodeType;
+
+typedef struct _plJointPose
+{
+    plVec4 tRotation;
+    plVec3 tTranslation;
+    plVec3 tScale;
+} plJointPose;
+
+typedef struct _plBlendChannel
+{
+    uint32_t        uJoint;
+    uint32_t        uLane; // into the clip's sbfSamples
+    plAnimationPath tPath;
+} plBlendChannel;
+
+typedef struct _plBlendNode
+{
+    plBlendNodeType tType;
+    plVec2          tParameter; // blend position (spaces) or weight in x (layers)
+
+    // clips
+    plAnimationClip* ptClip;
+    plBlendChannel*  sbtChannels;
+    float            fTime;
+    float            fSpeed;
+    float            fDuration;
+    bool             bLoop;
+
+    // blend spaces
+    uint32_t uInputOffset; // into sbuInputs, sbtPositions & sbfWeights
+    uint32_t uInputCount;
+
+    // layers
+    plBlendLayerMode tLayerMode;
+    uint32_t         uBase;
+    uint32_t         uLayer;
+    uint32_t         uReference;
+    uint32_t         uMaskOffset; // into sbfMasks (UINT32_MAX if unmasked)
+} plBlendNode;
+
+typedef struct _plAnimationBlendTree
+{
+    plComponentLibrary* ptLibrary;
+    uint32_t            uJointCount;
+    plEntity*           sbtJoints;
+    plJointPose*        sbtRestPose;
+    plBlendNode*        sbtNodes;   // inputs always precede their users
+    plJointPose*        sbtPoses;   // [node][joint]
+    bool*               sbbNeeded;  // per node (evaluation scratch)
+    uint32_t*           sbuInputs;
+    plVec2*             sbtPositions;
+    float*              sbfWeights; // last evaluated blend space weights
+    float*              sbfMasks;
+} plAnimationBlendTree;
+
+#define PL__ECS_NAME_LEAF 0x80000000 // name index child is a leaf
+
+// name index (crit-bit tree, see pl_ecs_name_index.c)
+typedef struct _plEcsNameNode
+{
+    uint32_t auChildren[2]; // node or leaf (PL__ECS_NAME_LEAF) indices
+    uint32_t uByte;         // critical byte
+    uint8_t  uOtherBits;    // every bit except the critical one
+} plEcsNameNode;
+
+typedef struct _plEcsNameLeaf
+{
+    uint32_t uEntity; // entity index (UINT32_MAX if free)
+    uint32_t uNameOffset;
+    uint32_t uNameLength;
+} plEcsNameLeaf;
+
+typedef struct _plEcsNameSegment
+{
+    const char* pcName; // not terminated
+    uint32_t    uLength;
+} plEcsNameSegment;
+
+typedef struct _plFixedStepPrevious
+{
+    plEntity tObject;
+    uint64_t uCapture;
+    plMat4   tWorld;
+    plAABB   tAABB;
+} plFixedStepPrevious;
+
+typedef struct _plComponentLibraryData
+{
+    // cached queries
+    plEcsQuery** sbtQueries;      // every live query (updated on add/remove)
+    plEcsQuery*  ptObjectQuery;    // object, transform, mesh
+    plEcsQuery*  ptHierarchyQuery; // hierarchy, transform
+
+    // change tracking (indexed by dense component index, bitsets are 64 components per word)
+    plTransformCache* sbtTransformCache;
+    uint64_t*         sbuTransformChanged; // world matrix changed this frame
+    uint64_t*         sbuTransformForce;   // rebuild next frame (new, moved or written externally)
+    uint32_t*         sbuHierarchyPasses;  // last hierarchy pass each hierarchy component was updated in
+    uint32_t          uHierarchyPass;
+    plObjectCache*    sbtObjectCache;
+    uint64_t*         sbuObjectChanged;    // world AABB changed this frame
+    uint64_t*         sbuObjectForce;
+    plSkinCache*      sbtSkinCache;        // per skin (cached joint transform indices)
+
+    // scripts
+    plEntity*            sbtScriptPlaying;     // playing scripts (component order)
+    uint32_t*            sbuScriptWaves;       // wave per playing script
+    plEntity*            sbtScriptSchedule;    // playing scripts grouped by wave (component order within a wave)
+    uint32_t*            sbuScriptWaveStarts;  // first schedule entry per wave (+ end)
+    plEcsCommandBuffer** sbptScriptBuffers;    // one per job batch (reused)
+    uint32_t             uScriptWaveStart;     // schedule range of the wave being run
+    uint32_t             uScriptWaveCount;
+
+    // inverse kinematics
+    plIKChain* sbtIKChains;      // per IK component
+    uint32_t*  sbuIKSolveList;   // IK component indices solved in the current wave
+    uint64_t*  sbuIKMarks;       // per transform: (IK run << 32) | wave of the last chain using it
+    uint64_t*  sbuIKChangedCopy; // transform changed bits before the current wave
+    uint32_t   uIKRun;
+
+    // animation system
+    bool      bDeterministic;
+    bool      bAnimationOrdered;         // current run samples into scratch & applies in component order
+    float     fAnimationDeltaTime;
+    plVec4*   sbtAnimationSamples;       // ordered runs only (one per channel)
+    uint32_t* sbuAnimationSampleOffsets; // ordered runs only (first sample per component)
+    bool*     sbbAnimationActive;        // ordered runs only
+    uint64_t* sbuAnimationTargetMarks;   // per entity index: (animation run << 32) | last component targeting it
+    uint32_t  uAnimationRun;
+
+    // cpu skinning
+    plSkinnedMeshData* sbtSkinnedMeshes;      // per mesh (indexed by dense mesh index)
+    uint32_t*          sbuSkinnedMeshIndices; // dense mesh indices skinned by the current run
+
+    // blend trees
+    plAnimationBlendTree** sbtBlendTrees; // every live tree
+    float                  fBlendTreeDeltaTime;
+
+    // command buffer playback
+    uint32_t* sbuPendingRemovals[PL_COMPONENT_TYPE_COUNT]; // dense indices removed at next flush
+    uint32_t* sbuPendingFreeIndices;                       // destroyed entity slots (freed after flush)
+
+    // name index (every tag with a non-empty name)
+    plEcsNameNode* sbtNameNodes;
+    plEcsNameLeaf* sbtNameLeaves;
+    uint32_t*      sbuFreeNameNodes;
+    uint32_t*      sbuFreeNameLeaves;
+    char*          sbcNames;     // leaf names (terminated)
+    uint32_t       uNameGarbage; // bytes of removed names in sbcNames
+    uint32_t       uNameRoot;    // valid if uNameCount > 0
+    uint32_t       uNameCount;
+
+    // render extraction
+    uint64_t uRenderExtractions;
+
+    // fixed timestep
+    bool                 bFixedStep;
+    plFixedStepState     tFixedStep;
+    plFixedStepPrevious* sbtFixedPrevious; // indexed by object entity index
+    uint64_t             uFixedCapture;    // valid entries of sbtFixedPrevious carry this value
+} plComponentLibraryData;
+
+typedef struct _plRenderExtractJobData
+{
+    plComponentLibrary*        ptLibrary;
+    plRenderSnapshot*          ptSnapshot;
+    const plFixedStepPrevious* sbtPrevious; // NULL unless interpolating fixed steps
+    uint64_t                   uCapture;
+    float                      fAlpha;
+} plRenderExtractJobData;
+
+typedef struct _plEcsInputStream
+{
+    uint64_t*      sbuOffsets; // step i's input is sbucData[sbuOffsets[i], sbuOffsets[i + 1])
+    unsigned char* sbucData;
+} plEcsInputStream;
+
+#define PL__ECS_INPUT_STREAM_MAGIC   0x53494C50 // "PLIS"
+#define PL__ECS_INPUT_STREAM_VERSION 1
+
+typedef struct _plEcsInputStreamHeader
+{
+    uint32_t uMagic;
+    uint32_t uVersion;
+    uint64_t uStepCount;
+    uint64_t uDataSize; // followed by uStepCount + 1 offsets & the data
+} plEcsInputStreamHeader;
+
+typedef enum _plEcsCommandType
+{
+    PL_ECS_COMMAND_TYPE_CREATE_ENTITY,
+    PL_ECS_COMMAND_TYPE_REMOVE_ENTITY,
+    PL_ECS_COMMAND_TYPE_ADD_COMPONENT,
+    PL_ECS_COMMAND_TYPE_REMOVE_COMPONENT
+} plEcsCommandType;
+
+typedef struct _plEcsCommand
+{
+    plEcsCommandType tType;
+    plComponentType  tComponentType;
+    plEntity         tEntity;     // may be a placeholder from this buffer
+    uint32_t         uDataOffset; // add component only (into sbucData)
+} plEcsCommand;
+
+typedef struct _plEcsCommandBuffer
+{
+    plComponentLibrary* ptLibrary;
+    plEcsCommand*       sbtCommands;
+    unsigned char*      sbucData;      // recorded component values
+    plEntity*           sbtCreated;    // placeholder index -> entity (valid after playback)
+    uint32_t            uCreatedCount;
+} plEcsCommandBuffer;
+
+#define PL__ECS_SNAPSHOT_MAGIC      0x53454C50 // "PLES"
+#define PL__ECS_SNAPSHOT_VERSION    2
+#define PL__ECS_SNAPSHOT_ALIGNMENT  16
+#define PL__ECS_SNAPSHOT_MAX_FIELDS 18         // stretchy buffers per component (mesh)
+#define PL__ECS_SNAPSHOT_TAG_INDEXED 0x80000000 // tag string offset flag: name is in the tag hashmap
+
+typedef struct _plEcsSnapshotSection
+{
+    uint32_t uCount;
+    uint32_t uStride;          // component size (tags: string table offset)
+    uint64_t uEntityOffset;
+    uint64_t uComponentOffset;
+} plEcsSnapshotSection;
+
+typedef struct _plEcsSnapshotBuffer
+{
+    uint64_t uOffset;
+    uint32_t uCount;
+    uint32_t uStride;
+} plEcsSnapshotBuffer;
+
+typedef struct _plEcsSnapshotHeader
+{
+    uint32_t             uMagic;
+    uint32_t             uVersion;
+    uint32_t             uComponentTypeCount;
+    uint32_t             uEntityCount;       // entity slots (generations)
+    uint32_t             uFreeIndexCount;
+    uint32_t             uStringTableSize;
+    uint32_t             uBufferCount;       // stretchy buffers (components & fields in manager order)
+    uint32_t             _uUnused;
+    uint64_t             uSize;
+    uint64_t             uGenerationOffset;
+    uint64_t             uFreeIndexOffset;
+    uint64_t             uStringTableOffset;
+    uint64_t             uBufferTableOffset;
+    uint64_t             uCompressionOffset; // per animation (dense order)
+    plEcsSnapshotSection atSections[PL_COMPONENT_TYPE_COUNT];
+} plEcsSnapshotHeader;
+
+typedef struct _plEcsSnapshotCompression
+{
+    uint32_t                   uCompressed; // otherwise the clip is rebuilt lazily (uncompressed)
+    plAnimationCompressionDesc tDesc;
+} plEcsSnapshotCompression;
+
+typedef struct _plEcsSnapshotField
+{
+    void**   ppBuffer;
+    uint32_t uStride;
+} plEcsSnapshotField;
+
+typedef struct _plEcsSnapshotWriter
+{
+    unsigned char* pucData; // NULL while measuring
+    uint64_t       uSize;
+} plEcsSnapshotWriter;
+
+#define PL__ECS_MESH_RANGE_TRIANGLES 0
+#define PL__ECS_MESH_RANGE_VERTICES  1
+#define PL__ECS_MESH_RANGE_GROUPS    2
+
+#define PL__ECS_MIKK_DEGENERATE         (1 << 0) // uses a (welded) vertex twice
+#define PL__ECS_MIKK_ORIENT_PRESERVING  (1 << 1) // positive uv area
+#define PL__ECS_MIKK_GROUP_WITH_ANY     (1 << 2) // no usable uv gradient, joins neighboring groups
+
+typedef struct _plMeshVectorWork
+{
+    plMeshComponent* ptMesh;
+    plTangentMode    tMode;
+    uint32_t         uTriangleCount;
+    uint32_t         uVertexCount;
+    uint32_t*        auCornerStart; // vertex -> first entry of auCorners (uVertexCount + 1)
+    uint32_t*        auCorners;     // triangle corners (index buffer offsets) grouped by vertex
+    plVec3*          atFaceS;       // per triangle normal/tangent
+    plVec3*          atFaceT;       // per triangle bitangent
+
+    // mikktspace
+    uint32_t* auFaceFlags;     // PL__ECS_MIKK_*
+    uint32_t* auWelded;        // vertex -> first vertex with equal position, normal & uv
+    int32_t*  aiNeighbors;     // per triangle edge (-1 if open)
+    uint32_t* auCornerGroup;   // per corner (UINT32_MAX if none)
+    uint32_t  uGroupCount;
+    uint32_t* auGroupStart;    // group -> first entry of auGroupMembers (uGroupCount + 1)
+    uint32_t* auGroupMembers;  // triangles
+    uint32_t* auGroupVertex;   // welded vertex
+    plVec4*   atGroupTangents; // uGroupCount + 1 (last is default)
+} plMeshVectorWork;
+
+typedef struct _plMeshVectorRange
+{
+    uint32_t uWork;
+    uint32_t uStart;
+    uint32_t uEnd;
+} plMeshVectorRange;
+
+typedef struct _plMeshVectorJobData
+{
+    plMeshVectorWork*  atWork;
+    plMeshVectorRange* sbtRanges;
+} plMeshVectorJobData;
+
+typedef struct _plMikkEdge
+{
+    uint64_t uKey; // (min vertex << 32) | max vertex
+    uint32_t uTriangle;
+    uint32_t uEdge;
+} plMikkEdge;
+
+typedef struct _plArchetypeChunk
+{
+    unsigned char* pucData; // entity column followed by one column per component
+    uint32_t       uCount;
+} plArchetypeChunk;
+
+typedef struct _plArchetype
+{
+    plComponentMask   tMask;
+    uint32_t          uRowsPerChunk;
+    uint32_t          uChunkSize;
+    uint32_t          uEntityCount; // rows are packed (every chunk is full except the last)
+    uint32_t          auColumnOffsets[PL_COMPONENT_TYPE_COUNT]; // UINT32_MAX if not part of archetype
+    uint32_t          auAddEdges[PL_COMPONENT_TYPE_COUNT];      // cached archetype transitions (UINT32_MAX if unknown)
+    uint32_t          auRemoveEdges[PL_COMPONENT_TYPE_COUNT];
+    plArchetypeChunk* sbtChunks;
+} plArchetype;
+
+typedef struct _plArchetypeRecord
+{
+    uint32_t uArchetype; // UINT32_MAX if entity slot is free
+    uint32_t uRow;       // chunk = uRow / uRowsPerChunk
+} plArchetypeRecord;
+
+typedef struct _plArchetypeStorage
+{
+    uint32_t*          sbtEntityGenerations;
+    uint32_t*          sbtEntityFreeIndices;
+    plArchetypeRecord* sbtRecords; // indexed by entity index
+    plArchetype*       sbtArchetypes;
+
+    // scratch
+    plArchetypeChunk** sbtJobChunks;
+    uint32_t*          sbuHierarchyPasses; // indexed by entity index
+    uint32_t           uHierarchyPass;
+} plArchetypeStorage;
+
+//-----------------------------------------------------------------------------
+// [SECTION] global data
+//-----------------------------------------------------------------------------
+
+static uint64_t uLogChannelEcs = UINT64_MAX;
+
+static const size_t gaszComponentSizes[PL_COMPONENT_TYPE_COUNT] = {
+    [PL_COMPONENT_TYPE_TAG]                = sizeof(plTagComponent),
+    [PL_COMPONENT_TYPE_TRANSFORM]          = sizeof(plTransformComponent),
+    [PL_COMPONENT_TYPE_MESH]               = sizeof(plMeshComponent),
+    [PL_COMPONENT_TYPE_OBJECT]             = sizeof(plObjectComponent),
+    [PL_COMPONENT_TYPE_HIERARCHY]          = sizeof(plHierarchyComponent),
+    [PL_COMPONENT_TYPE_MATERIAL]           = sizeof(plMaterialComponent),
+    [PL_COMPONENT_TYPE_SKIN]               = sizeof(plSkinComponent),
+    [PL_COMPONENT_TYPE_CAMERA]             = sizeof(plCameraComponent),
+    [PL_COMPONENT_TYPE_ANIMATION]          = sizeof(plAnimationComponent),
+    [PL_COMPONENT_TYPE_ANIMATION_DATA]     = sizeof(plAnimationDataComponent),
+    [PL_COMPONENT_TYPE_INVERSE_KINEMATICS] = sizeof(plInverseKinematicsComponent),
+    [PL_COMPONENT_TYPE_LIGHT]              = sizeof(plLightComponent),
+    [PL_COMPONENT_TYPE_SCRIPT]             = sizeof(plScriptComponent),
+    [PL_COMPONENT_TYPE_HUMANOID]           = sizeof(plHumanoidComponent),
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+// setup/shutdown
+static void     pl_ecs_init_component_library   (plComponentLibrary* ptLibrary);
+static void     pl_ecs_cleanup_component_library(plComponentLibrary* ptLibrary);
+
+// low level (most users shouldn't use this)
+static plEntity pl_ecs_create_entity         (plComponentLibrary* ptLibrary);
+static void     pl_ecs_remove_entity         (plComponentLibrary* ptLibrary, plEntity tEntity);
+static bool     pl_ecs_is_entity_valid       (plComponentLibrary* ptLibrary, plEntity tEntity);
+static plEntity pl_ecs_get_entity            (plComponentLibrary* ptLibrary, const char* pcName);
+static uint32_t pl_ecs_find_entities_by_prefix(plComponentLibrary* ptLibrary, const char* pcPrefix, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+static uint32_t pl_ecs_find_entities_by_glob  (plComponentLibrary* ptLibrary, const char* pcPattern, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+static uint32_t pl_ecs_find_entities_by_path  (plComponentLibrary* ptLibrary, const char* pcPath, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+static plComponentMask pl_ecs_get_signature   (plComponentLibrary* ptLibrary, plEntity tEntity);
+static bool     pl_ecs_has_component         (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
+static uint32_t pl_ecs_get_entities_with     (plComponentLibrary* ptLibrary, plComponentMask tRequired, plComponentMask tExcluded, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+static size_t   pl_ecs_get_index             (plComponentManager* ptManager, plEntity tEntity);
+static void*    pl_ecs_get_component         (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
+static void*    pl_ecs_add_component         (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
+static void     pl_ecs_remove_component      (plComponentLibrary* ptLibrary, plComponentType tType, plEntity tEntity);
+
+// components
+static plEntity pl_ecs_create_tag                (plComponentLibrary*, const char* pcName);
+static plEntity pl_ecs_create_mesh               (plComponentLibrary*, const char* pcName, plMeshComponent**);
+static plEntity pl_ecs_create_object             (plComponentLibrary*, const char* pcName, plObjectComponent**);
+static plEntity pl_ecs_create_transform          (plComponentLibrary*, const char* pcName, plTransformComponent**);
+static plEntity pl_ecs_create_material           (plComponentLibrary*, const char* pcName, plMaterialComponent**);
+static plEntity pl_ecs_create_skin               (plComponentLibrary*, const char* pcName, plSkinComponent**);
+static plEntity pl_ecs_create_animation          (plComponentLibrary*, const char* pcName, plAnimationComponent**);
+static plEntity pl_ecs_create_animation_data     (plComponentLibrary*, const char* pcName, plAnimationDataComponent**);
+static plEntity pl_ecs_create_perspective_camera (plComponentLibrary*, const char* pcName, plVec3 tPos, float fYFov, float fAspect, float fNearZ, float fFarZ, plCameraComponent**);
+static plEntity pl_ecs_create_orthographic_camera(plComponentLibrary*, const char* pcName, plVec3 tPos, float fWidth, float fHeight, float fNearZ, float fFarZ, plCameraComponent**);
+static plEntity pl_ecs_create_directional_light  (plComponentLibrary*, const char* pcName, plVec3 tDirection, plLightComponent**);
+static plEntity pl_ecs_create_point_light        (plComponentLibrary*, const char* pcName, plVec3 tPosition, plLightComponent**);
+static plEntity pl_ecs_create_script             (plComponentLibrary*, const char* pcFile, plScriptFlags, plScriptComponent**);
+static void     pl_ecs_attach_script             (plComponentLibrary*, const char* pcFile, plScriptFlags, plEntity, plScriptComponent**);
+
+
+// heirarchy
+static void pl_ecs_attach_component (plComponentLibrary* ptLibrary, plEntity tEntity, plEntity tParent);
+static void pl_ecs_deattach_component(plComponentLibrary* ptLibrary, plEntity tEntity);
+
+// update systems
+static void pl_run_object_update_system            (plComponentLibrary* ptLibrary);
+static void pl_run_transform_update_system         (plComponentLibrary* ptLibrary);
+static void pl_run_skin_update_system              (plComponentLibrary* ptLibrary);
+static void pl_run_hierarchy_update_system         (plComponentLibrary* ptLibrary);
+static void pl_run_animation_update_system         (plComponentLibrary* ptLibrary, float fDeltaTime);
+static void pl_run_inverse_kinematics_update_system(plComponentLibrary* ptLibrary);
+static void pl_run_script_update_system            (plComponentLibrary* ptLibrary);
+static void pl_run_systems                         (plComponentLibrary* ptLibrary, float fDeltaTime);
+static void pl_ecs_set_deterministic               (plComponentLibrary* ptLibrary, bool bDeterministic);
+static void pl_ecs_invalidate_animation_cache      (plComponentLibrary* ptLibrary, plEntity tAnimation);
+static void pl_ecs_compress_animation              (plComponentLibrary* ptLibrary, plEntity tAnimation, const plAnimationCompressionDesc* ptDesc);
+
+// cpu skinning
+static void                     pl_run_cpu_skinning_system(plComponentLibrary* ptLibrary);
+static const plSkinnedMeshData* pl_ecs_get_skinned_mesh_data(plComponentLibrary* ptLibrary, plEntity tMesh);
+
+// blend trees
+static plAnimationBlendTree* pl_ecs_create_blend_tree  (plComponentLibrary*, uint32_t uJointCount, const plEntity* atJoints);
+static void                  pl_ecs_cleanup_blend_tree (plComponentLibrary*, plAnimationBlendTree**);
+static uint32_t              pl_ecs_add_blend_clip     (plAnimationBlendTree*, plEntity tAnimation, float fSpeed, bool bLoop);
+static uint32_t              pl_ecs_add_blend_space_1d (plAnimationBlendTree*, uint32_t uInputCount, const uint32_t* auInputs, const float* afPositions);
+static uint32_t              pl_ecs_add_blend_space_2d (plAnimationBlendTree*, uint32_t uInputCount, const uint32_t* auInputs, const plVec2* atPositions);
+static uint32_t              pl_ecs_add_blend_layer    (plAnimationBlendTree*, const plBlendLayerDesc*);
+static void                  pl_ecs_set_blend_parameter(plAnimationBlendTree*, uint32_t uNode, plVec2 tValue);
+static void                  pl_ecs_set_blend_clip_time(plAnimationBlendTree*, uint32_t uNode, float fTime);
+static void                  pl_run_blend_tree_system  (plComponentLibrary*, float fDeltaTime);
+
+// change tracking
+static const uint64_t* pl_ecs_get_changed_bitset (plComponentLibrary*, plComponentType, uint32_t* puCountOut);
+static void            pl_ecs_mark_transform_dirty(plComponentLibrary*, plEntity);
+
+// misc.
+static void pl_calculate_normals    (plMeshComponent* atMeshes, uint32_t uComponentCount);
+static void pl_calculate_tangents   (plMeshComponent* atMeshes, uint32_t uComponentCount);
+static void pl_calculate_tangents_ex(plMeshComponent* atMeshes, uint32_t uComponentCount, plTangentMode tMode);
+
+// cached queries
+static plEcsQuery* pl_ecs_create_query (plComponentLibrary*, uint32_t uComponentCount, const plComponentType*);
+static void        pl_ecs_cleanup_query(plComponentLibrary*, plEcsQuery**);
+
+// command buffers
+static plEcsCommandBuffer* pl_ecs_create_command_buffer   (plComponentLibrary*);
+static void                pl_ecs_cleanup_command_buffer  (plEcsCommandBuffer**);
+static void                pl_ecs_reset_command_buffer    (plEcsCommandBuffer*);
+static plEntity            pl_ecs_cmd_create_entity       (plEcsCommandBuffer*);
+static void                pl_ecs_cmd_remove_entity       (plEcsCommandBuffer*, plEntity);
+static void*               pl_ecs_cmd_add_component       (plEcsCommandBuffer*, plComponentType, plEntity);
+static void                pl_ecs_cmd_remove_component    (plEcsCommandBuffer*, plComponentType, plEntity);
+static plEntity            pl_ecs_resolve_entity          (plEcsCommandBuffer*, plEntity);
+static void                pl_ecs_playback_command_buffers(plComponentLibrary*, uint32_t uBufferCount, plEcsCommandBuffer**);
+
+// snapshots
+static bool pl_ecs_save_snapshot(plComponentLibrary*, void* pBuffer, size_t* pszSize);
+static bool pl_ecs_load_snapshot(plComponentLibrary*, const void* pBuffer, size_t szSize);
+
+// render extraction
+static plRenderSnapshot*     pl_ecs_create_render_snapshot (void);
+static void                  pl_ecs_cleanup_render_snapshot(plRenderSnapshot**);
+static void                  pl_ecs_extract_render_snapshot(plComponentLibrary*, plRenderSnapshot*);
+static const plRenderObject* pl_ecs_get_render_object      (const plRenderSnapshot*, plEntity tObject);
+static const plMat4*         pl_ecs_get_render_skin_palette(const plRenderSnapshot*, plEntity tSkin, uint32_t* puMatrixCountOut);
+
+// fixed timestep
+static void                    pl_ecs_set_fixed_step      (plComponentLibrary*, const plFixedStepDesc*);
+static uint32_t                pl_ecs_advance_fixed_step  (plComponentLibrary*, float fDeltaTime, const void* pInput, uint32_t uInputSize);
+static void                    pl_ecs_run_fixed_steps     (plComponentLibrary*, uint32_t uStepCount, const void* pInput, uint32_t uInputSize);
+static const plFixedStepState* pl_ecs_get_fixed_step_state(plComponentLibrary*);
+static plEcsInputStream*       pl_ecs_create_input_stream (void);
+static void                    pl_ecs_cleanup_input_stream(plEcsInputStream**);
+static void                    pl_ecs_append_stream_input (plEcsInputStream*, const void* pInput, uint32_t uInputSize);
+static const void*             pl_ecs_get_stream_input    (const plEcsInputStream*, uint64_t uStep, uint32_t* puInputSizeOut);
+static uint64_t                pl_ecs_get_stream_length   (const plEcsInputStream*);
+static bool                    pl_ecs_save_input_stream   (const plEcsInputStream*, void* pBuffer, size_t* pszSize);
+static bool                    pl_ecs_load_input_stream   (plEcsInputStream*, const void* pBuffer, size_t szSize);
+static void                    pl__ecs_fixed_capture_job  (uint32_t uJobIndex, void* pData);
+static plMat4                  pl__ecs_blend_world        (const plMat4* ptPrevious, const plMat4* ptCurrent, float fAlpha);
+
+// archetype storage
+static plArchetypeStorage* pl_ecs_create_archetype_storage   (void);
+static void                pl_ecs_cleanup_archetype_storage  (plArchetypeStorage**);
+static void                pl_ecs_archetype_import_library   (plArchetypeStorage*, plComponentLibrary*);
+static plEntity            pl_ecs_archetype_create_entity    (plArchetypeStorage*, plComponentMask);
+static void                pl_ecs_archetype_remove_entity    (plArchetypeStorage*, plEntity);
+static bool                pl_ecs_archetype_is_entity_valid  (plArchetypeStorage*, plEntity);
+static void*               pl_ecs_archetype_get_component    (plArchetypeStorage*, plComponentType, plEntity);
+static void*               pl_ecs_archetype_add_component    (plArchetypeStorage*, plComponentType, plEntity);
+static void                pl_ecs_archetype_remove_component (plArchetypeStorage*, plComponentType, plEntity);
+static void                pl_ecs_archetype_query_begin      (plArchetypeStorage*, plComponentMask tRequired, plComponentMask tExcluded, plArchetypeIterator*);
+static bool                pl_ecs_archetype_query_next       (plArchetypeIterator*);
+static void                pl_run_archetype_transform_update_system(plArchetypeStorage*);
+static void                pl_run_archetype_hierarchy_update_system(plArchetypeStorage*);
+static void                pl_run_archetype_object_update_system   (plArchetypeStorage*);
+static void                pl_run_archetype_skin_update_system     (plArchetypeStorage*);
+
+// camera
+static void pl_camera_set_fov        (plCameraComponent* ptCamera, float fYFov);
+static void pl_camera_set_clip_planes(plCameraComponent* ptCamera, float fNearZ, float fFarZ);
+static void pl_camera_set_aspect     (plCameraComponent* ptCamera, float fAspect);
+static void pl_camera_set_pos        (plCameraComponent* ptCamera, float fX, float fY, float fZ);
+static void pl_camera_set_pitch_yaw  (plCameraComponent* ptCamera, float fPitch, float fYaw);
+static void pl_camera_translate      (plCameraComponent* ptCamera, float fDx, float fDy, float fDz);
+static void pl_camera_rotate         (plCameraComponent* ptCamera, float fDPitch, float fDYaw);
+static void pl_camera_update         (plCameraComponent* ptCamera);
+static void pl_camera_look_at        (plCameraComponent* ptCamera, plVec3 tEye, plVec3 tTarget);
+static void pl_camera_get_frustum_slice(plCameraComponent* ptCamera, float fStart, float fEnd, plVec3 atCornersOut[8]);
+static const plCameraDerivedData* pl_camera_get_derived_data(plCameraComponent* ptCamera);
+
+static inline float
+pl__wrap_angle(float tTheta)
+{
+    static const float f2Pi = 2.0f * PL_PI;
+    const float fMod = fmodf(tTheta, f2Pi);
+    if (fMod > PL_PI)       return fMod - f2Pi;
+    else if (fMod < -PL_PI) return fMod + f2Pi;
+    return fMod;
+}
+
+// change tracking bitsets (stretchy buffers of 64 bit words)
+static inline void
+pl__ecs_bits_reserve(uint64_t** psbuBits, uint32_t uBitCount)
+{
+    const uint32_t uWordCount = (uBitCount + 63) / 64;
+    while(pl_sb_size(*psbuBits) < uWordCount)
+        pl_sb_push(*psbuBits, 0);
+}
+
+static inline void
+pl__ecs_bit_set(uint64_t** psbuBits, uint32_t uIndex)
+{
+    pl__ecs_bits_reserve(psbuBits, uIndex + 1);
+    (*psbuBits)[uIndex / 64] |= 1ull << (uIndex % 64);
+}
+
+static inline bool
+pl__ecs_bit_test(const uint64_t* sbuBits, uint32_t uIndex)
+{
+    return uIndex / 64 < pl_sb_size(sbuBits) && (sbuBits[uIndex / 64] & (1ull << (uIndex % 64)));
+}
+
+// pl_hm_hash_str barely varies in its low bits for short names & the hashmap
+// buckets on low bits, so tag names are mixed before being used as keys
+static inline uint64_t
+pl__ecs_tag_key(const char* pcName)
+{
+    uint64_t uKey = pl_hm_hash_str(pcName);
+    uKey ^= uKey >> 33;
+    uKey *= 0xff51afd7ed558ccdull;
+    uKey ^= uKey >> 33;
+    uKey *= 0xc4ceb9fe1a85ec53ull;
+    uKey ^= uKey >> 33;
+    return uKey;
+}
+
+static void pl__ecs_name_insert(plComponentLibraryData*, const char* pcName, uint32_t uEntity);
+static void pl__ecs_name_remove(plComponentLibraryData*, const char* pcName, uint32_t uEntity);
+
+static inline void
+pl__ecs_remove_tag_name(plComponentLibrary* ptLibrary, const char* pcName, uint32_t uEntity)
+{
+    const uint64_t uKey = pl__ecs_tag_key(pcName);
+    if(pl_hm_lookup(ptLibrary->ptTagHashmap, uKey) == uEntity) // another entity may own the name
+    {
+        pl_hm_remove(ptLibrary->ptTagHashmap, uKey);
+        pl_hm_get_free_index(ptLibrary->ptTagHashmap); // values are entity indices, so never reuse slots
+    }
+    pl__ecs_name_remove(ptLibrary->pInternal, pcName, uEntity);
+}
+
+// the job queue holds a fixed number of batches, so large dispatches get
+// bigger groups instead of more batches
+static inline void
+pl__ecs_dispatch_batch(uint32_t uJobCount, uint32_t uGroupSize, plJobDesc tJobDesc, plAtomicCounter** pptCounter)
+{
+    const uint32_t uMinGroupSize = (uJobCount + PL_ECS_MAX_JOB_BATCHES - 1) / PL_ECS_MAX_JOB_BATCHES;
+    if(uGroupSize != 0 && uGroupSize < uMinGroupSize)
+        uGroupSize = uMinGroupSize;
+    gptJob->dispatch_batch(uJobCount, uGroupSize, tJobDesc, pptCounter);
+}
+
+static void pl__ecs_init_component  (plComponentType, void* pComponent);
+static void pl__ecs_update_mesh_aabb(plMeshComponent*, const plMat4* ptTransform);
+static plAABB pl__ecs_transform_aabb(const plAABB*, const plMat4* ptTransform);
+static void pl__ecs_mark_changed    (plComponentLibrary*, plComponentType, uint32_t uIndex);
+static void pl__ecs_query_on_add    (plComponentLibrary*, plComponentType, plEntity, uint32_t uIndex);
+static void pl__ecs_query_on_remove (plComponentLibrary*, plComponentType, plEntity tRemoved, plEntity tMoved, uint32_t uIndex);
+static void pl__ecs_manager_remove  (plComponentLibrary*, plComponentType, uint32_t uIndex);
+static void pl__ecs_free_animation_clip(plAnimationClip**);
+static uint32_t pl__ecs_snapshot_fields(plComponentType, void* pComponent, plEcsSnapshotField* atFields);
+
+// normal & tangent generation
+static void pl__ecs_run_mesh_jobs      (plMeshVectorJobData*, uint32_t uWorkCount, void (*task)(uint32_t, void*));
+static void pl__ecs_run_mesh_range_jobs(plMeshVectorJobData*, uint32_t uRangeType, void (*task)(uint32_t, void*));
+static void pl__ecs_cleanup_mesh_work  (plMeshVectorJobData*);
+static void pl__ecs_mesh_prepare_job   (uint32_t uJobIndex, void* pData);
+static void pl__ecs_face_normal_job    (uint32_t uJobIndex, void* pData);
+static void pl__ecs_vertex_normal_job  (uint32_t uJobIndex, void* pData);
+static void pl__ecs_face_tangent_job   (uint32_t uJobIndex, void* pData);
+static void pl__ecs_vertex_tangent_job (uint32_t uJobIndex, void* pData);
+static void pl__ecs_mikk_face_job      (uint32_t uJobIndex, void* pData);
+static void pl__ecs_mikk_group_job     (uint32_t uJobIndex, void* pData);
+static void pl__ecs_mikk_eval_job      (uint32_t uJobIndex, void* pData);
+static void pl__ecs_mikk_output_job    (uint32_t uJobIndex, void* pData);
+static inline void pl__ecs_mikk_vertex_key(const plMeshComponent*, uint32_t uVertex, float afKeyOut[8]);
+
+static inline bool
+pl_ecs_has_entity(plComponentManager* ptManager, plEntity tEntity)
+{
+    PL_ASSERT(tEntity.uIndex != UINT32_MAX);
+    const plComponentLibrary* ptLibrary = ptManager->ptParentLibrary;
+    if(tEntity.uIndex >= pl_sb_size(ptLibrary->sbtEntitySignatures))
+        return false;
+    return (ptLibrary->sbtEntitySignatures[tEntity.uIndex] & PL_COMPONENT_MASK(ptManager->tComponentType)) != 0;
+}
+
+#endif // PL_ECS_INTERNAL_H
@@ -0,0 +1,351 @@
+/*
+   pl_ecs_name_index.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] name index
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] name index
+//-----------------------------------------------------------------------------
+
+// keys are the name, a terminating 0 & the big endian entity index, so equal
+// names are kept apart & ordered by entity index (no key is a prefix of another)
+static inline uint8_t
+pl__ecs_name_key_byte(const char* pcName, uint32_t uLength, uint32_t uEntity, uint32_t uByte)
+{
+    if(uByte < uLength)
+        return (uint8_t)pcName[uByte];
+    if(uByte == uLength || uByte > uLength + 4)
+        return 0;
+    return (uint8_t)(uEntity >> (8 * (uLength + 4 - uByte)));
+}
+
+static inline uint32_t
+pl__ecs_name_direction(const plEcsNameNode* ptNode, uint8_t uByte)
+{
+    return (1 + (ptNode->uOtherBits | uByte)) >> 8;
+}
+
+static void
+pl__ecs_name_insert(plComponentLibraryData* ptData, const char* pcName, uint32_t uEntity)
+{
+    const uint32_t uLength = (uint32_t)strnlen(pcName, PL_MAX_NAME_LENGTH - 1);
+    if(uLength == 0)
+        return;
+
+    uint32_t uNewByte = 0;
+    uint8_t uNewOtherBits = 0;
+    uint32_t uNewDirection = 0;
+    if(ptData->uNameCount > 0)
+    {
+        // closest existing key
+        uint32_t uRef = ptData->uNameRoot;
+        while(!(uRef & PL__ECS_NAME_LEAF))
+        {
+            const plEcsNameNode* ptNode = &ptData->sbtNameNodes[uRef];
+            uRef = ptNode->auChildren[pl__ecs_name_direction(ptNode, pl__ecs_name_key_byte(pcName, uLength, uEntity, ptNode->uByte))];
+        }
+        const plEcsNameLeaf* ptBest = &ptData->sbtNameLeaves[uRef & ~PL__ECS_NAME_LEAF];
+        const char* pcBest = &ptData->sbcNames[ptBest->uNameOffset];
+
+        // first differing bit
+        const uint32_t uKeyBytes = pl_max(uLength, ptBest->uNameLength) + 5;
+        uint32_t uDifference = 0;
+        for(; uNewByte < uKeyBytes; uNewByte++)
+        {
+            uDifference = pl__ecs_name_key_byte(pcName, uLength, uEntity, uNewByte) ^ pl__ecs_name_key_byte(pcBest, ptBest->uNameLength, ptBest->uEntity, uNewByte);
+            if(uDifference)
+                break;
+        }
+        if(uDifference == 0) // already indexed
+            return;
+        while(uDifference & (uDifference - 1))
+            uDifference &= uDifference - 1;
+        uNewOtherBits = (uint8_t)(uDifference ^ 0xff);
+        const uint8_t uBestByte = pl__ecs_name_key_byte(pcBest, ptBest->uNameLength, ptBest->uEntity, uNewByte);
+        uNewDirection = (1 + (uNewOtherBits | uBestByte)) >> 8;
+    }
+
+    // copy name
+    const uint32_t uNameOffset = pl_sb_add_n(ptData->sbcNames, uLength + 1);
+    memcpy(&ptData->sbcNames[uNameOffset], pcName, uLength);
+    ptData->sbcNames[uNameOffset + uLength] = 0;
+
+    uint32_t uLeaf = 0;
+    if(pl_sb_size(ptData->sbuFreeNameLeaves) > 0)
+        uLeaf = pl_sb_pop(ptData->sbuFreeNameLeaves);
+    else
+        uLeaf = pl_sb_add(ptData->sbtNameLeaves);
+    ptData->sbtNameLeaves[uLeaf] = (plEcsNameLeaf){
+        .uEntity     = uEntity,
+        .uNameOffset = uNameOffset,
+        .uNameLength = uLength
+    };
+
+    ptData->uNameCount++;
+    if(ptData->uNameCount == 1)
+    {
+        ptData->uNameRoot = uLeaf | PL__ECS_NAME_LEAF;
+        return;
+    }
+
+    uint32_t uNode = 0;
+    if(pl_sb_size(ptData->sbuFreeNameNodes) > 0)
+        uNode = pl_sb_pop(ptData->sbuFreeNameNodes);
+    else
+        uNode = pl_sb_add(ptData->sbtNameNodes);
+
+    // descend to where the new critical bit belongs
+    uint32_t* puWhere = &ptData->uNameRoot;
+    while(!(*puWhere & PL__ECS_NAME_LEAF))
+    {
+        plEcsNameNode* ptNode = &ptData->sbtNameNodes[*puWhere];
+        if(ptNode->uByte > uNewByte || (ptNode->uByte == uNewByte && ptNode->uOtherBits > uNewOtherBits))
+            break;
+        puWhere = &ptNode->auChildren[pl__ecs_name_direction(ptNode, pl__ecs_name_key_byte(pcName, uLength, uEntity, ptNode->uByte))];
+    }
+
+    plEcsNameNode* ptNewNode = &ptData->sbtNameNodes[uNode];
+    ptNewNode->uByte = uNewByte;
+    ptNewNode->uOtherBits = uNewOtherBits;
+    ptNewNode->auChildren[uNewDirection] = *puWhere;
+    ptNewNode->auChildren[1 - uNewDirection] = uLeaf | PL__ECS_NAME_LEAF;
+    *puWhere = uNode;
+}
+
+static void
+pl__ecs_name_remove(plComponentLibraryData* ptData, const char* pcName, uint32_t uEntity)
+{
+    const uint32_t uLength = (uint32_t)strnlen(pcName, PL_MAX_NAME_LENGTH - 1);
+    if(ptData->uNameCount == 0 || uLength == 0)
+        return;
+
+    uint32_t* puWhere = &ptData->uNameRoot;
+    uint32_t* puParentWhere = NULL;
+    uint32_t uDirection = 0;
+    while(!(*puWhere & PL__ECS_NAME_LEAF))
+    {
+        puParentWhere = puWhere;
+        plEcsNameNode* ptNode = &ptData->sbtNameNodes[*puWhere];
+        uDirection = pl__ecs_name_direction(ptNode, pl__ecs_name_key_byte(pcName, uLength, uEntity, ptNode->uByte));
+        puWhere = &ptNode->auChildren[uDirection];
+    }
+
+    const uint32_t uLeaf = *puWhere & ~PL__ECS_NAME_LEAF;
+    plEcsNameLeaf* ptLeaf = &ptData->sbtNameLeaves[uLeaf];
+    if(ptLeaf->uEntity != uEntity || ptLeaf->uNameLength != uLength || memcmp(&ptData->sbcNames[ptLeaf->uNameOffset], pcName, uLength) != 0)
+        return;
+
+    ptData->uNameGarbage += uLength + 1;
+    ptLeaf->uEntity = UINT32_MAX;
+    pl_sb_push(ptData->sbuFreeNameLeaves, uLeaf);
+    ptData->uNameCount--;
+
+    // replace parent with the sibling
+    if(puParentWhere)
+    {
+        const uint32_t uParent = *puParentWhere;
+        *puParentWhere = ptData->sbtNameNodes[uParent].auChildren[1 - uDirection];
+        pl_sb_push(ptData->sbuFreeNameNodes, uParent);
+    }
+
+    // compact names once most of the buffer is removed names
+    if(ptData->uNameGarbage > 4096 && ptData->uNameGarbage > pl_sb_size(ptData->sbcNames) / 2)
+    {
+        char* sbcNames = NULL;
+        pl_sb_reserve(sbcNames, pl_sb_size(ptData->sbcNames) - ptData->uNameGarbage);
+        for(uint32_t i = 0; i < pl_sb_size(ptData->sbtNameLeaves); i++)
+        {
+            plEcsNameLeaf* ptLiveLeaf = &ptData->sbtNameLeaves[i];
+            if(ptLiveLeaf->uEntity == UINT32_MAX)
+                continue;
+            const uint32_t uOffset = pl_sb_add_n(sbcNames, ptLiveLeaf->uNameLength + 1);
+            memcpy(&sbcNames[uOffset], &ptData->sbcNames[ptLiveLeaf->uNameOffset], ptLiveLeaf->uNameLength + 1);
+            ptLiveLeaf->uNameOffset = uOffset;
+        }
+        pl_sb_free(ptData->sbcNames);
+        ptData->sbcNames = sbcNames;
+        ptData->uNameGarbage = 0;
+    }
+}
+
+// '*' matches any run of characters, '?' any one character
+static bool
+pl__ecs_glob_match(const char* pcPattern, uint32_t uPatternLength, const char* pcName, uint32_t uNameLength)
+{
+    uint32_t uPattern = 0;
+    uint32_t uName = 0;
+    uint32_t uStarPattern = UINT32_MAX;
+    uint32_t uStarName = 0;
+    while(uName < uNameLength)
+    {
+        if(uPattern < uPatternLength && pcPattern[uPattern] == '*')
+        {
+            uStarPattern = uPattern++;
+            uStarName = uName;
+        }
+        else if(uPattern < uPatternLength && (pcPattern[uPattern] == '?' || pcPattern[uPattern] == pcName[uName]))
+        {
+            uPattern++;
+            uName++;
+        }
+        else if(uStarPattern != UINT32_MAX) // let the last star take one more character
+        {
+            uPattern = uStarPattern + 1;
+            uName = ++uStarName;
+        }
+        else
+            return false;
+    }
+    while(uPattern < uPatternLength && pcPattern[uPattern] == '*')
+        uPattern++;
+    return uPattern == uPatternLength;
+}
+
+static uint32_t
+pl__ecs_glob_literal_length(const char* pcPattern, uint32_t uPatternLength)
+{
+    uint32_t uLength = 0;
+    while(uLength < uPatternLength && pcPattern[uLength] != '*' && pcPattern[uLength] != '?')
+        uLength++;
+    return uLength;
+}
+
+static bool
+pl__ecs_path_match(plComponentLibrary* ptLibrary, plEntity tEntity, const plEcsNameSegment* atSegments, uint32_t uSegmentCount)
+{
+    // last segment was matched by the name lookup, walk up the ancestors
+    for(uint32_t i = uSegmentCount - 1; i > 0; i--)
+    {
+        const plHierarchyComponent* ptHierarchy = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tEntity);
+        if(ptHierarchy == NULL || !pl_ecs_is_entity_valid(ptLibrary, ptHierarchy->tParent))
+            return false;
+        tEntity = ptHierarchy->tParent;
+
+        const plTagComponent* ptTag = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_TAG, tEntity);
+        if(ptTag == NULL || !pl__ecs_glob_match(atSegments[i - 1].pcName, atSegments[i - 1].uLength, ptTag->acName, (uint32_t)strnlen(ptTag->acName, PL_MAX_NAME_LENGTH - 1)))
+            return false;
+    }
+
+    // first segment must be a root
+    const plHierarchyComponent* ptHierarchy = pl_ecs_get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tEntity);
+    return ptHierarchy == NULL || !pl_ecs_is_entity_valid(ptLibrary, ptHierarchy->tParent);
+}
+
+static uint32_t
+pl__ecs_name_find(plComponentLibrary* ptLibrary, const char* pcPrefix, uint32_t uPrefixLength, const char* pcPattern, uint32_t uPatternLength,
+    const plEcsNameSegment* atSegments, uint32_t uSegmentCount, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    // entities named pcPrefix... (matching pcPattern & the path segments if given)
+    const plComponentLibraryData* ptData = ptLibrary->pInternal;
+    if(ptData->uNameCount == 0)
+        return 0;
+
+    // best match for the prefix & the highest node whose subtree shares it
+    uint32_t uRef = ptData->uNameRoot;
+    uint32_t uTop = uRef;
+    while(!(uRef & PL__ECS_NAME_LEAF))
+    {
+        const plEcsNameNode* ptNode = &ptData->sbtNameNodes[uRef];
+        const uint8_t uByte = ptNode->uByte < uPrefixLength ? (uint8_t)pcPrefix[ptNode->uByte] : 0;
+        uRef = ptNode->auChildren[pl__ecs_name_direction(ptNode, uByte)];
+        if(ptNode->uByte < uPrefixLength)
+            uTop = uRef;
+    }
+    const plEcsNameLeaf* ptBest = &ptData->sbtNameLeaves[uRef & ~PL__ECS_NAME_LEAF];
+    for(uint32_t i = 0; i < uPrefixLength; i++)
+    {
+        if(pl__ecs_name_key_byte(&ptData->sbcNames[ptBest->uNameOffset], ptBest->uNameLength, ptBest->uEntity, i) != (uint8_t)pcPrefix[i])
+            return 0;
+    }
+
+    // in order walk of the subtree
+    uint32_t uCount = 0;
+    uint32_t* sbuStack = NULL;
+    pl_sb_push(sbuStack, uTop);
+    while(pl_sb_size(sbuStack) > 0)
+    {
+        uRef = pl_sb_pop(sbuStack);
+        if(!(uRef & PL__ECS_NAME_LEAF))
+        {
+            pl_sb_push(sbuStack, ptData->sbtNameNodes[uRef].auChildren[1]);
+            pl_sb_push(sbuStack, ptData->sbtNameNodes[uRef].auChildren[0]);
+            continue;
+        }
+
+        const plEcsNameLeaf* ptLeaf = &ptData->sbtNameLeaves[uRef & ~PL__ECS_NAME_LEAF];
+        if(pcPattern && !pl__ecs_glob_match(pcPattern, uPatternLength, &ptData->sbcNames[ptLeaf->uNameOffset], ptLeaf->uNameLength))
+            continue;
+        const plEntity tEntity = {.uIndex = ptLeaf->uEntity, .uGeneration = ptLibrary->sbtEntityGenerations[ptLeaf->uEntity]};
+        if(atSegments && !pl__ecs_path_match(ptLibrary, tEntity, atSegments, uSegmentCount))
+            continue;
+        if(uCount < uMaxEntities)
+            atEntitiesOut[uCount] = tEntity;
+        uCount++;
+    }
+    pl_sb_free(sbuStack);
+    return uCount;
+}
+
+static uint32_t
+pl__ecs_find_entities_by_segment(plComponentLibrary* ptLibrary, const char* pcPattern, uint32_t uPatternLength,
+    const plEcsNameSegment* atSegments, uint32_t uSegmentCount, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    const uint32_t uLiteralLength = pl__ecs_glob_literal_length(pcPattern, uPatternLength);
+    if(uLiteralLength < uPatternLength)
+        return pl__ecs_name_find(ptLibrary, pcPattern, uLiteralLength, pcPattern, uPatternLength, atSegments, uSegmentCount, atEntitiesOut, uMaxEntities);
+
+    // no wildcards, exact name (prefix including the terminator)
+    char acName[PL_MAX_NAME_LENGTH];
+    if(uPatternLength >= PL_MAX_NAME_LENGTH)
+        return 0;
+    memcpy(acName, pcPattern, uPatternLength);
+    acName[uPatternLength] = 0;
+    return pl__ecs_name_find(ptLibrary, acName, uPatternLength + 1, NULL, 0, atSegments, uSegmentCount, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_ecs_find_entities_by_prefix(plComponentLibrary* ptLibrary, const char* pcPrefix, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    return pl__ecs_name_find(ptLibrary, pcPrefix, (uint32_t)strnlen(pcPrefix, PL_MAX_NAME_LENGTH - 1), NULL, 0, NULL, 0, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_ecs_find_entities_by_glob(plComponentLibrary* ptLibrary, const char* pcPattern, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    return pl__ecs_find_entities_by_segment(ptLibrary, pcPattern, (uint32_t)strlen(pcPattern), NULL, 0, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_ecs_find_entities_by_path(plComponentLibrary* ptLibrary, const char* pcPath, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    plEcsNameSegment atSegments[PL_ECS_MAX_HIERARCHY_DEPTH];
+    uint32_t uSegmentCount = 0;
+    while(*pcPath)
+    {
+        const char* pcEnd = strchr(pcPath, '/');
+        const uint32_t uLength = pcEnd ? (uint32_t)(pcEnd - pcPath) : (uint32_t)strlen(pcPath);
+        if(uLength > 0) // skip empty segments ("/root", "a//b")
+        {
+            if(uSegmentCount == PL_ECS_MAX_HIERARCHY_DEPTH)
+                return 0;
+            atSegments[uSegmentCount++] = (plEcsNameSegment){pcPath, uLength};
+        }
+        pcPath += uLength + (pcEnd ? 1 : 0);
+    }
+    if(uSegmentCount == 0)
+        return 0;
+
+    const plEcsNameSegment* ptLast = &atSegments[uSegmentCount - 1];
+    return pl__ecs_find_entities_by_segment(ptLibrary, ptLast->pcName, ptLast->uLength, atSegments, uSegmentCount, atEntitiesOut, uMaxEntities);
+}
@@ -0,0 +1,441 @@
+/*
+   pl_ecs_snapshot.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] snapshots
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_internal.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] snapshots
+//-----------------------------------------------------------------------------
+
+// stretchy buffers owned by a component (snapshot order)
+static uint32_t
+pl__ecs_snapshot_fields(plComponentType tType, void* pComponent, plEcsSnapshotField* atFields)
+{
+    #define PL__ECS_SNAPSHOT_FIELD(sb) atFields[uCount++] = (plEcsSnapshotField){(void**)&(sb), (uint32_t)sizeof(*(sb))}
+
+    uint32_t uCount = 0;
+    switch(tType)
+    {
+    case PL_COMPONENT_TYPE_MESH:
+    {
+        plMeshComponent* ptMesh = pComponent;
+        PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexPositions);
+        PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexNormals);
+        PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexTangents);
+        for(uint32_t i = 0; i < 2; i++)
+        {
+            PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexColors[i]);
+            PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexWeights[i]);
+            PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexJoints[i]);
+        }
+        for(uint32_t i = 0; i < 8; i++)
+            PL__ECS_SNAPSHOT_FIELD(ptMesh->sbtVertexTextureCoordinates[i]);
+        PL__ECS_SNAPSHOT_FIELD(ptMesh->sbuIndices);
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_SKIN:
+    {
+        plSkinComponent* ptSkin = pComponent;
+        PL__ECS_SNAPSHOT_FIELD(ptSkin->sbtInverseBindMatrices);
+        PL__ECS_SNAPSHOT_FIELD(ptSkin->sbtJoints);
+        PL__ECS_SNAPSHOT_FIELD(ptSkin->sbtTextureData);
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_ANIMATION:
+    {
+        plAnimationComponent* ptAnimation = pComponent;
+        PL__ECS_SNAPSHOT_FIELD(ptAnimation->sbtChannels);
+        PL__ECS_SNAPSHOT_FIELD(ptAnimation->sbtSamplers);
+        break;
+    }
+
+    case PL_COMPONENT_TYPE_ANIMATION_DATA:
+    {
+        plAnimationDataComponent* ptData = pComponent;
+        PL__ECS_SNAPSHOT_FIELD(ptData->sbfKeyFrameTimes);
+        PL__ECS_SNAPSHOT_FIELD(ptData->sbfKeyFrameData);
+        break;
+    }
+    }
+
+    #undef PL__ECS_SNAPSHOT_FIELD
+    PL_ASSERT(uCount <= PL__ECS_SNAPSHOT_MAX_FIELDS);
+    return uCount;
+}
+
+// appends (or reserves when pData is NULL) an aligned block, returning its offset
+static uint64_t
+pl__ecs_snapshot_write(plEcsSnapshotWriter* ptWriter, const void* pData, uint64_t uSize)
+{
+    const uint64_t uOffset = (ptWriter->uSize + PL__ECS_SNAPSHOT_ALIGNMENT - 1) & ~(uint64_t)(PL__ECS_SNAPSHOT_ALIGNMENT - 1);
+    if(ptWriter->pucData)
+    {
+        memset(&ptWriter->pucData[ptWriter->uSize], 0, (size_t)(uOffset - ptWriter->uSize));
+        if(pData)
+            memcpy(&ptWriter->pucData[uOffset], pData, (size_t)uSize);
+        else
+            memset(&ptWriter->pucData[uOffset], 0, (size_t)uSize);
+    }
+    ptWriter->uSize = uOffset + uSize;
+    return uOffset;
+}
+
+// same traversal measures (pucData NULL) & writes
+static void
+pl__ecs_write_snapshot(plComponentLibrary* ptLibrary, plEcsSnapshotWriter* ptWriter)
+{
+    plEcsSnapshotHeader tHeader = {
+        .uMagic              = PL__ECS_SNAPSHOT_MAGIC,
+        .uVersion            = PL__ECS_SNAPSHOT_VERSION,
+        .uComponentTypeCount = PL_COMPONENT_TYPE_COUNT,
+        .uEntityCount        = pl_sb_size(ptLibrary->sbtEntityGenerations),
+        .uFreeIndexCount     = pl_sb_size(ptLibrary->sbtEntityFreeIndices)
+    };
+    pl__ecs_snapshot_write(ptWriter, NULL, sizeof(plEcsSnapshotHeader));
+    tHeader.uGenerationOffset = pl__ecs_snapshot_write(ptWriter, ptLibrary->sbtEntityGenerations, sizeof(uint32_t) * tHeader.uEntityCount);
+    tHeader.uFreeIndexOffset = pl__ecs_snapshot_write(ptWriter, ptLibrary->sbtEntityFreeIndices, sizeof(uint32_t) * tHeader.uFreeIndexCount);
+
+    // dense arrays as is (runtime pointers cleared in the copy), tags become string offsets
+    plEcsSnapshotField atFields[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        plEcsSnapshotSection* ptSection = &tHeader.atSections[i];
+        ptSection->uCount = pl_sb_size(ptManager->sbtEntities);
+        ptSection->uStride = i == PL_COMPONENT_TYPE_TAG ? sizeof(uint32_t) : (uint32_t)ptManager->szStride;
+        ptSection->uEntityOffset = pl__ecs_snapshot_write(ptWriter, ptManager->sbtEntities, sizeof(plEntity) * ptSection->uCount);
+
+        if(i == PL_COMPONENT_TYPE_TAG)
+        {
+            ptSection->uComponentOffset = pl__ecs_snapshot_write(ptWriter, NULL, sizeof(uint32_t) * ptSection->uCount);
+            const plTagComponent* sbtTags = ptManager->pComponents;
+            for(uint32_t j = 0; j < ptSection->uCount; j++)
+            {
+                const plEntity tEntity = ptManager->sbtEntities[j];
+                const uint64_t uKey = pl__ecs_tag_key(sbtTags[j].acName);
+                uint32_t uString = tHeader.uStringTableSize;
+                if(pl_hm_has_key(ptLibrary->ptTagHashmap, uKey) && pl_hm_lookup(ptLibrary->ptTagHashmap, uKey) == tEntity.uIndex)
+                    uString |= PL__ECS_SNAPSHOT_TAG_INDEXED;
+                if(ptWriter->pucData)
+                    memcpy(&ptWriter->pucData[ptSection->uComponentOffset + sizeof(uint32_t) * j], &uString, sizeof(uint32_t));
+                tHeader.uStringTableSize += (uint32_t)strnlen(sbtTags[j].acName, PL_MAX_NAME_LENGTH - 1) + 1;
+            }
+            continue;
+        }
+
+        ptSection->uComponentOffset = pl__ecs_snapshot_write(ptWriter, ptManager->pComponents, ptManager->szStride * ptSection->uCount);
+        for(uint32_t j = 0; j < ptSection->uCount; j++)
+        {
+            void* pComponent = ptWriter->pucData ? &ptWriter->pucData[ptSection->uComponentOffset + ptManager->szStride * j] : NULL;
+            const uint32_t uFieldCount = pl__ecs_snapshot_fields(i, pComponent ? pComponent : ptManager->pComponents, atFields);
+            tHeader.uBufferCount += uFieldCount;
+            if(pComponent == NULL)
+                continue;
+            for(uint32_t k = 0; k < uFieldCount; k++)
+                *atFields[k].ppBuffer = NULL;
+            if(i == PL_COMPONENT_TYPE_ANIMATION)
+                ((plAnimationComponent*)pComponent)->_ptClip = NULL;
+            else if(i == PL_COMPONENT_TYPE_SCRIPT)
+                ((plScriptComponent*)pComponent)->_ptApi = NULL;
+        }
+    }
+
+    // string table
+    const plComponentManager* ptTagManager = &ptLibrary->tTagComponentManager;
+    const plTagComponent* sbtTags = ptTagManager->pComponents;
+    tHeader.uStringTableOffset = pl__ecs_snapshot_write(ptWriter, NULL, tHeader.uStringTableSize);
+    if(ptWriter->pucData)
+    {
+        char* pcStrings = (char*)&ptWriter->pucData[tHeader.uStringTableOffset];
+        for(uint32_t i = 0; i < pl_sb_size(ptTagManager->sbtEntities); i++)
+        {
+            const size_t szLength = strnlen(sbtTags[i].acName, PL_MAX_NAME_LENGTH - 1);
+            memcpy(pcStrings, sbtTags[i].acName, szLength);
+            pcStrings[szLength] = 0;
+            pcStrings += szLength + 1;
+        }
+    }
+
+    // stretchy buffers (every field of every component in manager order, empty ones included)
+    tHeader.uBufferTableOffset = pl__ecs_snapshot_write(ptWriter, NULL, sizeof(plEcsSnapshotBuffer) * tHeader.uBufferCount);
+    uint32_t uBuffer = 0;
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        unsigned char* pucComponents = ptManager->pComponents;
+        for(uint32_t j = 0; j < tHeader.atSections[i].uCount; j++)
+        {
+            const uint32_t uFieldCount = pl__ecs_snapshot_fields(i, &pucComponents[ptManager->szStride * j], atFields);
+            for(uint32_t k = 0; k < uFieldCount; k++)
+            {
+                const void* pBuffer = *atFields[k].ppBuffer;
+                plEcsSnapshotBuffer tBuffer = {
+                    .uCount  = pl_sb_size(pBuffer),
+                    .uStride = atFields[k].uStride
+                };
+                tBuffer.uOffset = pl__ecs_snapshot_write(ptWriter, pBuffer, (uint64_t)tBuffer.uStride * tBuffer.uCount);
+                if(ptWriter->pucData)
+                    memcpy(&ptWriter->pucData[tHeader.uBufferTableOffset + sizeof(plEcsSnapshotBuffer) * uBuffer], &tBuffer, sizeof(plEcsSnapshotBuffer));
+                uBuffer++;
+            }
+        }
+    }
+
+    // clips aren't stored, compressed ones are rebuilt from their desc on load
+    const plComponentManager* ptAnimationManager = &ptLibrary->tAnimationComponentManager;
+    const plAnimationComponent* sbtAnimations = ptAnimationManager->pComponents;
+    const uint32_t uAnimationCount = tHeader.atSections[PL_COMPONENT_TYPE_ANIMATION].uCount;
+    tHeader.uCompressionOffset = pl__ecs_snapshot_write(ptWriter, NULL, sizeof(plEcsSnapshotCompression) * uAnimationCount);
+    for(uint32_t i = 0; i < uAnimationCount && ptWriter->pucData; i++)
+    {
+        const plAnimationClip* ptClip = sbtAnimations[i]._ptClip;
+        if(ptClip == NULL || !ptClip->bCompressed)
+            continue;
+        const plEcsSnapshotCompression tCompression = {
+            .uCompressed = 1,
+            .tDesc       = ptClip->tCompression
+        };
+        memcpy(&ptWriter->pucData[tHeader.uCompressionOffset + sizeof(plEcsSnapshotCompression) * i], &tCompression, sizeof(plEcsSnapshotCompression));
+    }
+
+    tHeader.uSize = ptWriter->uSize;
+    if(ptWriter->pucData)
+        memcpy(ptWriter->pucData, &tHeader, sizeof(plEcsSnapshotHeader));
+}
+
+static bool
+pl_ecs_save_snapshot(plComponentLibrary* ptLibrary, void* pBuffer, size_t* pszSize)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+    plEcsSnapshotWriter tWriter = {0};
+    pl__ecs_write_snapshot(ptLibrary, &tWriter);
+
+    bool bResult = true;
+    if(pBuffer)
+    {
+        if(*pszSize >= tWriter.uSize)
+        {
+            tWriter = (plEcsSnapshotWriter){.pucData = pBuffer};
+            pl__ecs_write_snapshot(ptLibrary, &tWriter);
+        }
+        else
+            bResult = false;
+    }
+    *pszSize = (size_t)tWriter.uSize;
+    pl_end_profile_sample(0);
+    return bResult;
+}
+
+static inline bool
+pl__ecs_snapshot_range_valid(const plEcsSnapshotHeader* ptHeader, uint64_t uOffset, uint64_t uCount, uint64_t uStride)
+{
+    return uOffset <= ptHeader->uSize && (uStride == 0 || uCount <= (ptHeader->uSize - uOffset) / uStride);
+}
+
+// copies uCount elements into a new stretchy buffer (NULL if empty)
+static void*
+pl__ecs_snapshot_read_buffer(const unsigned char* pucData, uint64_t uOffset, uint32_t uCount, uint32_t uStride)
+{
+    if(uCount == 0)
+        return NULL;
+    void* pBuffer = NULL;
+    pl__sb_may_grow_(&pBuffer, uStride, uCount, uCount, __FILE__, __LINE__);
+    pl__sb_header(pBuffer)->uSize = uCount;
+    memcpy(pBuffer, &pucData[uOffset], (size_t)uStride * uCount);
+    return pBuffer;
+}
+
+static bool
+pl__ecs_snapshot_valid(const plEcsSnapshotHeader* ptHeader, const unsigned char* pucData, size_t szSize)
+{
+    if(ptHeader->uMagic != PL__ECS_SNAPSHOT_MAGIC || ptHeader->uVersion != PL__ECS_SNAPSHOT_VERSION ||
+        ptHeader->uComponentTypeCount != PL_COMPONENT_TYPE_COUNT || ptHeader->uSize > szSize)
+        return false;
+
+    if(!pl__ecs_snapshot_range_valid(ptHeader, ptHeader->uGenerationOffset, ptHeader->uEntityCount, sizeof(uint32_t)) ||
+        !pl__ecs_snapshot_range_valid(ptHeader, ptHeader->uFreeIndexOffset, ptHeader->uFreeIndexCount, sizeof(uint32_t)) ||
+        !pl__ecs_snapshot_range_valid(ptHeader, ptHeader->uStringTableOffset, ptHeader->uStringTableSize, 1) ||
+        !pl__ecs_snapshot_range_valid(ptHeader, ptHeader->uBufferTableOffset, ptHeader->uBufferCount, sizeof(plEcsSnapshotBuffer)) ||
+        !pl__ecs_snapshot_range_valid(ptHeader, ptHeader->uCompressionOffset, ptHeader->atSections[PL_COMPONENT_TYPE_ANIMATION].uCount, sizeof(plEcsSnapshotCompression)))
+        return false;
+
+    // layout must match this build
+    union {
+        plMeshComponent          tMesh;
+        plSkinComponent          tSkin;
+        plAnimationComponent     tAnimation;
+        plAnimationDataComponent tAnimationData;
+    } tScratch;
+    plEcsSnapshotField atFields[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    uint32_t uBuffer = 0;
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plEcsSnapshotSection* ptSection = &ptHeader->atSections[i];
+        const uint32_t uStride = i == PL_COMPONENT_TYPE_TAG ? sizeof(uint32_t) : (uint32_t)gaszComponentSizes[i];
+        if(ptSection->uStride != uStride ||
+            !pl__ecs_snapshot_range_valid(ptHeader, ptSection->uEntityOffset, ptSection->uCount, sizeof(plEntity)) ||
+            !pl__ecs_snapshot_range_valid(ptHeader, ptSection->uComponentOffset, ptSection->uCount, uStride))
+            return false;
+
+        for(uint32_t j = 0; j < ptSection->uCount; j++)
+        {
+            plEntity tEntity;
+            memcpy(&tEntity, &pucData[ptSection->uEntityOffset + sizeof(plEntity) * j], sizeof(plEntity));
+            if(tEntity.uIndex >= ptHeader->uEntityCount)
+                return false;
+        }
+
+        const uint32_t uFieldCount = pl__ecs_snapshot_fields(i, &tScratch, atFields);
+        if(uFieldCount == 0)
+            continue;
+        if(uBuffer + (uint64_t)uFieldCount * ptSection->uCount > ptHeader->uBufferCount)
+            return false;
+        for(uint32_t j = 0; j < ptSection->uCount; j++)
+        {
+            for(uint32_t k = 0; k < uFieldCount; k++)
+            {
+                plEcsSnapshotBuffer tBuffer;
+                memcpy(&tBuffer, &pucData[ptHeader->uBufferTableOffset + sizeof(plEcsSnapshotBuffer) * uBuffer++], sizeof(plEcsSnapshotBuffer));
+                if(tBuffer.uStride != atFields[k].uStride || !pl__ecs_snapshot_range_valid(ptHeader, tBuffer.uOffset, tBuffer.uCount, tBuffer.uStride))
+                    return false;
+            }
+        }
+    }
+    if(uBuffer != ptHeader->uBufferCount)
+        return false;
+
+    // tag names must be terminated inside the string table
+    const plEcsSnapshotSection* ptTags = &ptHeader->atSections[PL_COMPONENT_TYPE_TAG];
+    const char* pcStrings = (const char*)&pucData[ptHeader->uStringTableOffset];
+    for(uint32_t i = 0; i < ptTags->uCount; i++)
+    {
+        uint32_t uString;
+        memcpy(&uString, &pucData[ptTags->uComponentOffset + sizeof(uint32_t) * i], sizeof(uint32_t));
+        uString &= ~PL__ECS_SNAPSHOT_TAG_INDEXED;
+        if(uString >= ptHeader->uStringTableSize || memchr(&pcStrings[uString], 0, ptHeader->uStringTableSize - uString) == NULL)
+            return false;
+    }
+    return true;
+}
+
+static bool
+pl_ecs_load_snapshot(plComponentLibrary* ptLibrary, const void* pBuffer, size_t szSize)
+{
+    const unsigned char* pucData = pBuffer;
+    plEcsSnapshotHeader tHeader;
+    if(szSize < sizeof(plEcsSnapshotHeader))
+        return false;
+    memcpy(&tHeader, pucData, sizeof(plEcsSnapshotHeader));
+    if(!pl__ecs_snapshot_valid(&tHeader, pucData, szSize))
+    {
+        pl_log_error(uLogChannelEcs, "invalid or incompatible ecs snapshot");
+        return false;
+    }
+    if(pl_sb_size(ptLibrary->sbtEntityGenerations) > 0)
+    {
+        pl_log_error(uLogChannelEcs, "snapshots can only be loaded into an empty library");
+        return false;
+    }
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    ptLibrary->sbtEntityGenerations = pl__ecs_snapshot_read_buffer(pucData, tHeader.uGenerationOffset, tHeader.uEntityCount, sizeof(uint32_t));
+    ptLibrary->sbtEntityFreeIndices = pl__ecs_snapshot_read_buffer(pucData, tHeader.uFreeIndexOffset, tHeader.uFreeIndexCount, sizeof(uint32_t));
+
+    // signatures aren't stored, they follow from the manager sections
+    pl_sb_resize(ptLibrary->sbtEntitySignatures, tHeader.uEntityCount);
+    if(tHeader.uEntityCount > 0)
+        memset(ptLibrary->sbtEntitySignatures, 0, sizeof(plComponentMask) * tHeader.uEntityCount);
+
+    plEcsSnapshotField atFields[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    uint32_t uBuffer = 0;
+    const char* pcStrings = (const char*)&pucData[tHeader.uStringTableOffset];
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plEcsSnapshotSection* ptSection = &tHeader.atSections[i];
+        plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        const uint32_t uCount = ptSection->uCount;
+        ptManager->sbtEntities = pl__ecs_snapshot_read_buffer(pucData, ptSection->uEntityOffset, uCount, sizeof(plEntity));
+        for(uint32_t j = 0; j < uCount; j++)
+        {
+            pl_hm_insert(ptManager->ptHashmap, ptManager->sbtEntities[j].uIndex, j);
+            ptLibrary->sbtEntitySignatures[ptManager->sbtEntities[j].uIndex] |= PL_COMPONENT_MASK(i);
+        }
+
+        if(i == PL_COMPONENT_TYPE_TAG)
+        {
+            plTagComponent* sbtTags = NULL;
+            if(uCount > 0)
+                pl_sb_resize(sbtTags, uCount);
+            for(uint32_t j = 0; j < uCount; j++)
+            {
+                uint32_t uString;
+                memcpy(&uString, &pucData[ptSection->uComponentOffset + sizeof(uint32_t) * j], sizeof(uint32_t));
+                strncpy(sbtTags[j].acName, &pcStrings[uString & ~PL__ECS_SNAPSHOT_TAG_INDEXED], PL_MAX_NAME_LENGTH);
+                if(uString & PL__ECS_SNAPSHOT_TAG_INDEXED)
+                    pl_hm_insert(ptLibrary->ptTagHashmap, pl__ecs_tag_key(sbtTags[j].acName), ptManager->sbtEntities[j].uIndex);
+                pl__ecs_name_insert(ptLibrary->pInternal, sbtTags[j].acName, ptManager->sbtEntities[j].uIndex);
+            }
+            ptManager->pComponents = sbtTags;
+            continue;
+        }
+
+        ptManager->pComponents = pl__ecs_snapshot_read_buffer(pucData, ptSection->uComponentOffset, uCount, (uint32_t)ptManager->szStride);
+        unsigned char* pucComponents = ptManager->pComponents;
+        for(uint32_t j = 0; j < uCount; j++)
+        {
+            void* pComponent = &pucComponents[ptManager->szStride * j];
+            const uint32_t uFieldCount = pl__ecs_snapshot_fields(i, pComponent, atFields);
+            for(uint32_t k = 0; k < uFieldCount; k++)
+            {
+                plEcsSnapshotBuffer tBuffer;
+                memcpy(&tBuffer, &pucData[tHeader.uBufferTableOffset + sizeof(plEcsSnapshotBuffer) * uBuffer++], sizeof(plEcsSnapshotBuffer));
+                *atFields[k].ppBuffer = pl__ecs_snapshot_read_buffer(pucData, tBuffer.uOffset, tBuffer.uCount, tBuffer.uStride);
+            }
+            if(i == PL_COMPONENT_TYPE_SCRIPT)
+            {
+                plScriptComponent* ptScript = pComponent;
+                ptScript->_ptApi = pl__ecs_load_script(ptScript->acFile, ptScript->tFlags);
+            }
+        }
+    }
+
+    // compressed clips (animation data is loaded by now)
+    const plComponentManager* ptAnimationManager = &ptLibrary->tAnimationComponentManager;
+    for(uint32_t i = 0; i < tHeader.atSections[PL_COMPONENT_TYPE_ANIMATION].uCount; i++)
+    {
+        plEcsSnapshotCompression tCompression;
+        memcpy(&tCompression, &pucData[tHeader.uCompressionOffset + sizeof(plEcsSnapshotCompression) * i], sizeof(plEcsSnapshotCompression));
+        if(tCompression.uCompressed)
+            pl_ecs_compress_animation(ptLibrary, ptAnimationManager->sbtEntities[i], &tCompression.tDesc);
+    }
+
+    // queries & caches see every component as new
+    plComponentLibraryData* ptData = ptLibrary->pInternal;
+    for(uint32_t i = 0; i < pl_sb_size(ptData->sbtQueries); i++)
+    {
+        plEcsQuery* ptQuery = ptData->sbtQueries[i];
+        const plComponentManager* ptManager = ptLibrary->_ptManagers[ptQuery->atComponentTypes[0]];
+        for(uint32_t j = 0; j < pl_sb_size(ptManager->sbtEntities); j++)
+            pl__ecs_query_try_add(ptLibrary, ptQuery, ptManager->sbtEntities[j]);
+    }
+    for(uint32_t i = 0; i < tHeader.atSections[PL_COMPONENT_TYPE_TRANSFORM].uCount; i++)
+        pl__ecs_mark_changed(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, i);
+    for(uint32_t i = 0; i < tHeader.atSections[PL_COMPONENT_TYPE_OBJECT].uCount; i++)
+        pl__ecs_mark_changed(ptLibrary, PL_COMPONENT_TYPE_OBJECT, i);
+
+    pl_end_profile_sample(0);
+    return true;
+}
@@ -17,6 +17,7 @@ Index of this file:
 //-----------------------------------------------------------------------------
 
 #include "pl_ecs_ext.c"
+#include "pl_spatial_ext.c"
 
 #ifdef PL_CORE_EXTENSION_INCLUDE_GRAPHICS
     #include "pl_resource_ext.c"
@@ -55,6 +56,7 @@ pl_load_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     pl_load_ecs_ext(ptApiRegistry, bReload);
     gptECS    = ptApiRegistry->first(PL_API_ECS);
     gptCamera = ptApiRegistry->first(PL_API_CAMERA);
+    pl_load_spatial_ext(ptApiRegistry, bReload);
 
     #ifdef PL_CORE_EXTENSION_INCLUDE_SHADER
         gptShader = ptApiRegistry->first(PL_API_SHADER);
@@ -77,6 +79,7 @@ PL_EXPORT void
 pl_unload_ext(plApiRegistryI* ptApiRegistry, bool bReload)
 {
     pl_unload_ecs_ext(ptApiRegistry, bReload);
+    pl_unload_spatial_ext(ptApiRegistry, bReload);
     #ifdef PL_CORE_EXTENSION_INCLUDE_GRAPHICS
         pl_unload_resource_ext(ptApiRegistry, bReload);
         pl_unload_model_loader_ext(ptApiRegistry, bReload);
@@ -111,6 +114,10 @@ pl_unload_ext(plApiRegistryI* ptApiRegistry, bool bReload)
     #undef STB_SPRINTF_IMPLEMENTATION
 #endif
 
+#define PL_NUMBER_IMPLEMENTATION
+#include "pl_number.h"
+#undef PL_NUMBER_IMPLEMENTATION
+
 #ifdef PL_CORE_EXTENSION_INCLUDE_GRAPHICS
     #define PL_STL_IMPLEMENTATION
     #include "pl_stl.h"
@@ -264,6 +264,12 @@ typedef struct _plRefScene
     // ECS component library
     plComponentLibrary tComponentLibrary;
 
+    // render state extracted from the library by each run_ecs (one per frame
+    // in flight); see pl_refr_run_ecs for what is still read from the library
+    plRenderSnapshot* aptRenderSnapshots[PL_MAX_FRAMES_IN_FLIGHT];
+    plRenderSnapshot* ptRenderSnapshot; // last extracted
+    uint32_t          uNextRenderSnapshot;
+
     // drawables (per scene, will be culled by views)
     plDrawable* sbtOpaqueDrawables;
     plDrawable* sbtTransparentDrawables;
@@ -426,7 +432,7 @@ pl__allocate_dynamic_data(plDevice* ptDevice)
 // general helpers
 static void pl__add_drawable_skin_data_to_global_buffer(plRefScene*, uint32_t uDrawableIndex, plDrawable* atDrawables);
 static void pl__add_drawable_data_to_global_buffer(plRefScene*, uint32_t uDrawableIndex, plDrawable* atDrawables);
-static bool pl__sat_visibility_test(plCameraComponent*, const plAABB*);
+static bool pl__sat_visibility_test(const plCameraComponent*, const plCameraDerivedData*, const plAABB*);
 
 // shader variant system
 static plShaderHandle pl__get_shader_variant(uint32_t uSceneHandle, plShaderHandle tHandle, const plShaderVariant* ptVariant);
@@ -1169,6 +1175,9 @@ pl_refr_create_scene(void)
 
     // initialize ecs library
     gptECS->init_component_library(&ptScene->tComponentLibrary);
+    for(uint32_t i = 0; i < PL_MAX_FRAMES_IN_FLIGHT; i++)
+        ptScene->aptRenderSnapshots[i] = gptECS->create_render_snapshot();
+    ptScene->ptRenderSnapshot = ptScene->aptRenderSnapshots[0];
 
     return uSceneHandle;
 }
@@ -1796,6 +1805,8 @@ pl_refr_cleanup(void)
         pl_hm_free(ptScene->ptOpaqueHashmap);
         pl_hm_free(ptScene->ptTransparentHashmap);
         pl_hm_free(ptScene->ptShadowBindgroupHashmap);
+        for(uint32_t j = 0; j < PL_MAX_FRAMES_IN_FLIGHT; j++)
+            gptECS->cleanup_render_snapshot(&ptScene->aptRenderSnapshots[j]);
         gptECS->cleanup_component_library(&ptScene->tComponentLibrary);
     }
     for(uint32_t i = 0; i < pl_sb_size(gptData->_sbtVariantHandles); i++)
@@ -3263,6 +3274,9 @@ pl_refr_finalize_scene(uint32_t uSceneHandle)
     pl_sb_free(ptScene->sbtVertexDataBuffer);
     pl_sb_free(ptScene->sbuIndexBuffer);
 
+    // drawables are valid before the first run_ecs
+    gptECS->extract_render_snapshot(&ptScene->tComponentLibrary, ptScene->ptRenderSnapshot);
+
     pl_end_profile_sample(0);
 }
 
@@ -3271,13 +3285,21 @@ pl_refr_run_ecs(uint32_t uSceneHandle)
 {
     pl_begin_profile_sample(0, __FUNCTION__);
     plRefScene* ptScene = &gptData->sbtScenes[uSceneHandle];
-    gptECS->run_script_update_system(&ptScene->tComponentLibrary);
-    gptECS->run_animation_update_system(&ptScene->tComponentLibrary, gptIOI->get_io()->fDeltaTime);
-    gptECS->run_transform_update_system(&ptScene->tComponentLibrary);
-    gptECS->run_hierarchy_update_system(&ptScene->tComponentLibrary);
-    gptECS->run_inverse_kinematics_update_system(&ptScene->tComponentLibrary);
-    gptECS->run_skin_update_system(&ptScene->tComponentLibrary);
-    gptECS->run_object_update_system(&ptScene->tComponentLibrary);
+    const float fDeltaTime = gptIOI->get_io()->fDeltaTime;
+
+    // scenes with fixed stepping enabled (see plEcsI.set_fixed_step) run the same
+    // systems once per whole step held by the accumulator
+    if(gptECS->get_fixed_step_state(&ptScene->tComponentLibrary))
+        gptECS->advance_fixed_step(&ptScene->tComponentLibrary, fDeltaTime, NULL, 0);
+    else
+        gptECS->run_systems(&ptScene->tComponentLibrary, fDeltaTime);
+
+    // draw transforms, culling bounds & skin palettes come from the snapshot;
+    // cameras, lights, debug mesh bounds & picking still read the library, so
+    // recording must finish before the next run_ecs
+    ptScene->uNextRenderSnapshot = (ptScene->uNextRenderSnapshot + 1) % PL_MAX_FRAMES_IN_FLIGHT;
+    ptScene->ptRenderSnapshot = ptScene->aptRenderSnapshots[ptScene->uNextRenderSnapshot];
+    gptECS->extract_render_snapshot(&ptScene->tComponentLibrary, ptScene->ptRenderSnapshot);
     pl_end_profile_sample(0);
 }
 
@@ -3330,8 +3352,14 @@ pl_refr_update_skin_textures(plCommandBuffer* ptCommandBuffer, uint32_t uSceneHa
         };
         gptData->uStagingOffset += sizeof(float) * 4 * (size_t)ptSkinTexture->tDesc.tDimensions.x * (size_t)ptSkinTexture->tDesc.tDimensions.y;
         
-        plSkinComponent* ptSkinComponent = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_SKIN, ptScene->sbtSkinData[i].tEntity);
-        memcpy(&ptStagingBuffer->tMemoryAllocation.pHostMapped[tBufferImageCopy.szBufferOffset], ptSkinComponent->sbtTextureData, sizeof(float) * 4 * (size_t)ptSkinTexture->tDesc.tDimensions.x * (size_t)ptSkinTexture->tDesc.tDimensions.y);
+        // palette from the snapshot, texels past it are never sampled
+        uint32_t uPaletteCount = 0;
+        const plMat4* atPalette = gptECS->get_render_skin_palette(ptScene->ptRenderSnapshot, ptScene->sbtSkinData[i].tEntity, &uPaletteCount);
+        const size_t szTextureSize = sizeof(float) * 4 * (size_t)ptSkinTexture->tDesc.tDimensions.x * (size_t)ptSkinTexture->tDesc.tDimensions.y;
+        const size_t szPaletteSize = pl_min(sizeof(plMat4) * uPaletteCount, szTextureSize);
+        if(szPaletteSize > 0)
+            memcpy(&ptStagingBuffer->tMemoryAllocation.pHostMapped[tBufferImageCopy.szBufferOffset], atPalette, szPaletteSize);
+        memset(&ptStagingBuffer->tMemoryAllocation.pHostMapped[tBufferImageCopy.szBufferOffset + szPaletteSize], 0, szTextureSize - szPaletteSize);
         // memcpy(ptStagingBuffer->tMemoryAllocation.pHostMapped, ptSkinComponent->sbtTextureData, sizeof(float) * 4 * (size_t)ptSkinTexture->tDesc.tDimensions.x * (size_t)ptSkinTexture->tDesc.tDimensions.y);
         gptGfx->copy_buffer_to_texture(ptBlitEncoder, gptData->tStagingBufferHandle[uFrameIdx], ptScene->sbtSkinData[i].atDynamicTexture[uFrameIdx], 1, &tBufferImageCopy);
     }
@@ -3393,6 +3421,7 @@ typedef struct _plCullData
 {
     plRefScene* ptScene;
     plCameraComponent* ptCullCamera;
+    const plCameraDerivedData* ptCullCameraData;
     plDrawable* atDrawables;
 } plCullData;
 
@@ -3402,9 +3431,15 @@ pl__refr_cull_job(uint32_t uJobIndex, void* pData)
     plCullData* ptCullData = pData;
     plRefScene* ptScene = ptCullData->ptScene;
     plDrawable tDrawable = ptCullData->atDrawables[uJobIndex];
-    plMeshComponent* ptMesh = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_MESH, tDrawable.tEntity);
+    const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
     ptCullData->atDrawables[uJobIndex].bCulled = true;
-    if(pl__sat_visibility_test(ptCullData->ptCullCamera, &ptMesh->tAABBFinal))
+
+    // entities missing from the snapshot (created after the last extraction
+    // or already destroyed) stay culled
+    if(ptRenderObject == NULL)
+        return;
+
+    if(pl__sat_visibility_test(ptCullData->ptCullCamera, ptCullData->ptCullCameraData, &ptRenderObject->tAABB))
     {
         ptCullData->atDrawables[uJobIndex].bCulled = false;
     }
@@ -3468,30 +3503,9 @@ pl_refr_generate_cascaded_shadow_map(plCommandBuffer* ptCommandBuffer, uint32_t
             ptShadowData->cascadeSplits.d[uCascade] = ptLight->afCascadeSplits[uCascade];
         }
 
-        plVec3 atCameraCorners[] = {
-            { -1.0f,  1.0f, 0.0f },
-            { -1.0f, -1.0f, 0.0f },
-            {  1.0f, -1.0f, 0.0f },
-            {  1.0f,  1.0f, 0.0f },
-            { -1.0f,  1.0f, 1.0f },
-            { -1.0f, -1.0f, 1.0f },
-            {  1.0f, -1.0f, 1.0f },
-            {  1.0f,  1.0f, 1.0f },
-        };
-        plMat4 tCameraInversion = pl_mul_mat4(&ptSceneCamera->tProjMat, &ptSceneCamera->tViewMat);
-        tCameraInversion = pl_mat4_invert(&tCameraInversion);
-        for(uint32_t i = 0; i < 8; i++)
-        {
-            plVec4 tInvCorner = pl_mul_mat4_vec4(&tCameraInversion, (plVec4){.xyz = atCameraCorners[i], .w = 1.0f});
-            atCameraCorners[i] = pl_div_vec3_scalarf(tInvCorner.xyz, tInvCorner.w);
-        }
-
-        for(uint32_t i = 0; i < 4; i++)
-        {
-            const plVec3 tDist = pl_sub_vec3(atCameraCorners[i + 4], atCameraCorners[i]);
-            atCameraCorners[i + 4] = pl_add_vec3(atCameraCorners[i], pl_mul_vec3_scalarf(tDist, fSplitDist));
-            atCameraCorners[i] = pl_add_vec3(atCameraCorners[i], pl_mul_vec3_scalarf(tDist, fLastSplitDist));
-        }
+        // cascade frustum (camera corners are cached until the camera changes)
+        plVec3 atCameraCorners[8];
+        gptCamera->get_frustum_slice(ptSceneCamera, fLastSplitDist, fSplitDist, atCameraCorners);
 
         // get frustum center
         plVec3 tFrustumCenter = {0};
@@ -3669,15 +3683,16 @@ pl_refr_generate_cascaded_shadow_map(plCommandBuffer* ptCommandBuffer, uint32_t
         for(uint32_t i = 0; i < uVisibleOpaqueDrawCount; i++)
         {
             const plDrawable tDrawable = ptScene->sbtOpaqueDrawables[i];
-            plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-            plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+            const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+            if(ptRenderObject == NULL)
+                continue;
             
             plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
 
             plShadowDynamicData* ptDynamicData = (plShadowDynamicData*)tDynamicBinding.pcData;
             ptDynamicData->iDataOffset = tDrawable.uDataOffset;
             ptDynamicData->iVertexOffset = tDrawable.uVertexOffset;
-            ptDynamicData->tModel = ptTransform->tWorld;
+            ptDynamicData->tModel = ptRenderObject->tWorld;
             ptDynamicData->iMaterialIndex = tDrawable.uMaterialIndex;
             ptDynamicData->iIndex = (int)uCascade;
 
@@ -3708,15 +3723,16 @@ pl_refr_generate_cascaded_shadow_map(plCommandBuffer* ptCommandBuffer, uint32_t
         for(uint32_t i = 0; i < uVisibleTransparentDrawCount; i++)
         {
             const plDrawable tDrawable = ptScene->sbtTransparentDrawables[i];
-            plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-            plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+            const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+            if(ptRenderObject == NULL)
+                continue;
             
             plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
 
             plShadowDynamicData* ptDynamicData = (plShadowDynamicData*)tDynamicBinding.pcData;
             ptDynamicData->iDataOffset = tDrawable.uDataOffset;
             ptDynamicData->iVertexOffset = tDrawable.uVertexOffset;
-            ptDynamicData->tModel = ptTransform->tWorld;
+            ptDynamicData->tModel = ptRenderObject->tWorld;
             ptDynamicData->iMaterialIndex = tDrawable.uMaterialIndex;
             ptDynamicData->iIndex = (int)uCascade;
 
@@ -3868,11 +3884,15 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
     plCameraComponent* ptCullCamera = tOptions.ptCullCamera ? gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_CAMERA, *tOptions.ptCullCamera) : ptCamera;
     const uint32_t uFrameIdx = gptGfx->get_current_frame_index();
 
-    const plMat4 tMVP = pl_mul_mat4(&ptCamera->tProjMat, &ptCamera->tViewMat);
+    const plCameraDerivedData* ptCameraData = gptCamera->get_derived_data(ptCamera);
+    const plMat4 tMVP = ptCameraData->tViewProjMat;
 
     if(!gptData->bFrustumCulling)
         ptCullCamera = NULL;
 
+    // built here since cull jobs only read it
+    const plCameraDerivedData* ptCullCameraData = ptCullCamera ? gptCamera->get_derived_data(ptCullCamera) : NULL;
+
     //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~culling~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     
     const uint32_t uOpaqueDrawableCount = pl_sb_size(ptScene->sbtOpaqueDrawables);
@@ -3885,9 +3905,10 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
     {
         // opaque objects
         plCullData tOpaqueCullData = {
-            .ptScene      = ptScene,
-            .ptCullCamera = ptCullCamera,
-            .atDrawables  = ptScene->sbtOpaqueDrawables
+            .ptScene          = ptScene,
+            .ptCullCamera     = ptCullCamera,
+            .ptCullCameraData = ptCullCameraData,
+            .atDrawables      = ptScene->sbtOpaqueDrawables
         };
         
         plJobDesc tOpaqueJobDesc = {
@@ -3899,9 +3920,10 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
 
         // transparent objects
         plCullData tTransparentCullData = {
-            .ptScene      = ptScene,
-            .ptCullCamera = ptCullCamera,
-            .atDrawables  = ptScene->sbtTransparentDrawables
+            .ptScene          = ptScene,
+            .ptCullCamera     = ptCullCamera,
+            .ptCullCameraData = ptCullCameraData,
+            .atDrawables      = ptScene->sbtTransparentDrawables
         };
         
         plJobDesc tTransparentJobDesc = {
@@ -3930,7 +3952,7 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
         .tCameraPos            = ptCamera->tPos,
         .tCameraProjection     = ptCamera->tProjMat,
         .tCameraView           = ptCamera->tViewMat,
-        .tCameraViewProjection = pl_mul_mat4(&ptCamera->tProjMat, &ptCamera->tViewMat)
+        .tCameraViewProjection = ptCameraData->tViewProjMat
     };
     memcpy(gptGfx->get_buffer(ptDevice, ptView->atGlobalBuffers[uFrameIdx])->tMemoryAllocation.pHostMapped, &tBindGroupBuffer, sizeof(BindGroup_0));
 
@@ -4149,15 +4171,16 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
         for(uint32_t i = 0; i < uVisibleOpaqueDrawCount; i++)
         {
             const plDrawable tDrawable = ptView->sbtVisibleOpaqueDrawables[i];
-            plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-            plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+            const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+            if(ptRenderObject == NULL)
+                continue;
             
             plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
 
             DynamicData* ptDynamicData = (DynamicData*)tDynamicBinding.pcData;
             ptDynamicData->iDataOffset = tDrawable.uDataOffset;
             ptDynamicData->iVertexOffset = tDrawable.uVertexOffset;
-            ptDynamicData->tModel = ptTransform->tWorld;
+            ptDynamicData->tModel = ptRenderObject->tWorld;
             ptDynamicData->iMaterialOffset = tDrawable.uMaterialIndex;
 
             pl_add_to_draw_stream(ptStream, (plDrawStreamData)
@@ -4356,15 +4379,16 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
         for(uint32_t i = 0; i < uVisibleTransparentDrawCount; i++)
         {
             const plDrawable tDrawable = ptView->sbtVisibleTransparentDrawables[i];
-            plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-            plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+            const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+            if(ptRenderObject == NULL)
+                continue;
             
             plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
 
             DynamicData* ptDynamicData = (DynamicData*)tDynamicBinding.pcData;
             ptDynamicData->iDataOffset = tDrawable.uDataOffset;
             ptDynamicData->iVertexOffset = tDrawable.uVertexOffset;
-            ptDynamicData->tModel = ptTransform->tWorld;
+            ptDynamicData->tModel = ptRenderObject->tWorld;
             ptDynamicData->iMaterialOffset = tDrawable.uMaterialIndex;
 
             pl_add_to_draw_stream(ptStream, (plDrawStreamData)
@@ -4543,8 +4567,9 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
 
                 uint32_t uId = tDrawable.tEntity.uIndex;
                 
-                plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-                plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+                const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+                if(ptRenderObject == NULL)
+                    continue;
                 
                 plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
                 plPickDynamicData* ptDynamicData = (plPickDynamicData*)tDynamicBinding.pcData;
@@ -4554,7 +4579,7 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
                     ((float)((uId & 0x0000ff00) >>  8) / 255.0f),
                     ((float)((uId & 0x00ff0000) >> 16) / 255.0f),
                     1.0f};
-                ptDynamicData->tModel = ptTransform->tWorld;
+                ptDynamicData->tModel = ptRenderObject->tWorld;
 
                 gptGfx->bind_graphics_bind_groups(ptEncoder, gptData->tPickShader, 0, 1, &tPickBindGroup, 1, &tDynamicBinding);
 
@@ -4571,8 +4596,9 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
             {
                 const plDrawable tDrawable = ptView->sbtVisibleTransparentDrawables[i];
 
-                plObjectComponent* ptObject = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_OBJECT, tDrawable.tEntity);
-                plTransformComponent* ptTransform = gptECS->get_component(&ptScene->tComponentLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptObject->tTransform);
+                const plRenderObject* ptRenderObject = gptECS->get_render_object(ptScene->ptRenderSnapshot, tDrawable.tEntity);
+                if(ptRenderObject == NULL)
+                    continue;
                 
                 plDynamicBinding tDynamicBinding = pl__allocate_dynamic_data(ptDevice);
                 plPickDynamicData* ptDynamicData = (plPickDynamicData*)tDynamicBinding.pcData;
@@ -4582,7 +4608,7 @@ pl_refr_render_scene(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions
                     ((float)((uId & 0x0000ff00) >>  8) / 255.0f),
                     ((float)((uId & 0x00ff0000) >> 16) / 255.0f),
                     1.0f};
-                ptDynamicData->tModel = ptTransform->tWorld;
+                ptDynamicData->tModel = ptRenderObject->tWorld;
 
                 gptGfx->bind_graphics_bind_groups(ptEncoder, gptData->tPickShader, 0, 1, &tPickBindGroup, 1, &tDynamicBinding);
 
@@ -5433,9 +5459,9 @@ pl__add_drawable_data_to_global_buffer(plRefScene* ptScene, uint32_t uDrawableIn
 }
 
 static bool
-pl__sat_visibility_test(plCameraComponent* ptCamera, const plAABB* ptAABB)
+pl__sat_visibility_test(const plCameraComponent* ptCamera, const plCameraDerivedData* ptCameraData, const plAABB* ptAABB)
 {
-    const float fTanFov = tanf(0.5f * ptCamera->fFieldOfView);
+    const float fTanFov = ptCameraData->fTanHalfFovY;
 
     const float fZNear = ptCamera->fNearZ;
     const float fZFar = ptCamera->fFarZ;
@@ -80,6 +80,11 @@ typedef struct _plRendererI
     void (*show_graphics_options)(const char* pcTitle);
 
     // per frame
+    //   - "run_ecs" ends by extracting render state (transforms, bounds, skin palettes) into a
+    //     per frame snapshot; "render_scene" only reads that, so component edits made after
+    //     "run_ecs" show up the next frame
+    //   - if the scene's library has fixed stepping enabled (plEcsI.set_fixed_step), "run_ecs"
+    //     advances it by the frame delta instead of running each system once
     void (*run_ecs)     (uint32_t uSceneHandle);
     void (*render_scene)(uint32_t uSceneHandle, uint32_t uViewHandle, plViewOptions tOptions);
     bool (*begin_frame) (void);
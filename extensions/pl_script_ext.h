@@ -32,6 +32,7 @@ typedef struct _plScriptI plScriptI;
 // external 
 typedef struct _plComponentLibrary plComponentLibrary; // pl_ecs_ext.h
 typedef union  _plEntity           plEntity;           // pl_ecs_ext.h
+typedef struct _plEcsCommandBuffer plEcsCommandBuffer; // pl_ecs_ext.h
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api structs
@@ -45,6 +46,11 @@ typedef struct _plScriptI
     // ran every frame
     void (*run)(plComponentLibrary*, plEntity);
 
+    // ran every frame instead of "run" (optional), may run in parallel with other scripts
+    //   - only components declared in the script component's access sets may be touched
+    //   - entities/components must be created & removed through the command buffer
+    void (*run_job)(plComponentLibrary*, plEntity, plEcsCommandBuffer*);
+
     // used by entity component system to differentiate between implmentations
     // of this interface and must be the dll/so name without an extension
     const char* (*name)(void);
@@ -0,0 +1,835 @@
+/*
+   pl_spatial_ext.c
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] internal structs
+// [SECTION] internal api
+// [SECTION] public api implementation
+// [SECTION] internal api implementation
+// [SECTION] extension loading
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <float.h>  // FLT_MAX
+#include <math.h>   // fabsf
+#include <string.h> // memset
+#define PL_MATH_INCLUDE_FUNCTIONS
+#include "pl.h"
+#include "pl_spatial_ext.h"
+#include "pl_ds.h"
+#include "pl_math.h"
+#include "pl_profile.h"
+
+// extensions
+#include "pl_ecs_ext.h"
+#include "pl_ext.inc"
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plSpatialEntry
+{
+    plAABB   tBounds;
+    plEntity tEntity;
+} plSpatialEntry;
+
+typedef struct _plSpatialNode
+{
+    plVec3          tCenter;
+    float           fHalfSize;      // cell half size, loose bounds are twice as large
+    uint32_t        uParent;        // UINT32_MAX for root
+    uint32_t        uDepth;
+    uint32_t        uSubtreeCount;  // entries in this node & below (empty subtrees are pruned)
+    bool            bSplit;         // new entries go to children (set once the node fills up)
+    uint32_t        auChildren[8];  // 0 if none (root is node 0 & never a child)
+    plSpatialEntry* sbtEntries;
+} plSpatialNode;
+
+typedef struct _plSpatialLocation
+{
+    uint32_t uNode; // UINT32_MAX if not in the index
+    uint32_t uSlot;
+} plSpatialLocation;
+
+typedef struct _plSpatialIndex
+{
+    plVec3              tCenter;
+    float               fHalfSize;
+    uint32_t            uMaxDepth;
+    uint32_t            uCount;
+    plSpatialNode*      sbtNodes;           // node 0 is the root
+    uint32_t*           sbuFreeNodes;
+    plSpatialLocation*  sbtLocations;       // indexed by entity index
+
+    // ecs feed
+    plComponentLibrary* ptSourceLibrary;
+    plEntity*           sbtSourceEntities;  // object entities at each dense index as of the last feed
+} plSpatialIndex;
+
+enum _plSpatialQueryType
+{
+    PL_SPATIAL_QUERY_AABB,
+    PL_SPATIAL_QUERY_SPHERE,
+    PL_SPATIAL_QUERY_RAY,
+    PL_SPATIAL_QUERY_FRUSTUM
+};
+
+typedef struct _plSpatialQuery
+{
+    int      tType;
+
+    // aabb (also bounds of sphere)
+    plAABB   tBox;
+
+    // sphere
+    plVec3   tCenter;
+    float    fRadiusSquared;
+
+    // ray
+    plVec3   tOrigin;
+    plVec3   tInvDirection;
+    bool     abParallel[3];  // direction component is 0
+    float    fMaxDistance;
+
+    // frustum (inside where dot(xyz, p) + w >= 0)
+    plVec4   atPlanes[6];
+} plSpatialQuery;
+
+// entries a node holds before new ones are pushed down to children
+#define PL__SPATIAL_SPLIT_COUNT 16
+
+// traversal stack (up to 8 children pushed per level)
+#define PL__SPATIAL_STACK_SIZE (8 * (PL_SPATIAL_MAX_DEPTH + 1))
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api
+//-----------------------------------------------------------------------------
+
+static uint32_t pl__spatial_new_node     (plSpatialIndex*, uint32_t uParent, uint32_t uOctant);
+static void     pl__spatial_free_subtree (plSpatialIndex*, uint32_t uNode);
+static uint32_t pl__spatial_target_depth (const plSpatialIndex*, const plAABB*);
+static bool     pl__spatial_in_node      (const plSpatialIndex*, const plSpatialNode*, const plAABB*);
+static void     pl__spatial_insert       (plSpatialIndex*, plEntity, const plAABB*);
+static void     pl__spatial_place        (plSpatialIndex*, uint32_t uNode, const plSpatialEntry*);
+static void     pl__spatial_split        (plSpatialIndex*, uint32_t uNode);
+static void     pl__spatial_remove_entry (plSpatialIndex*, uint32_t uNode, uint32_t uSlot);
+static bool     pl__spatial_overlaps     (const plSpatialQuery*, const plAABB*);
+static bool     pl__spatial_ray_distance (const plSpatialQuery*, const plAABB*, float* pfDistanceOut);
+static uint32_t pl__spatial_run_query    (const plSpatialIndex*, const plSpatialQuery*, plEntity*, uint32_t uMaxEntities);
+static void     pl__spatial_init_ray     (plSpatialQuery*, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance);
+
+static inline plAABB
+pl__spatial_loose_bounds(const plSpatialNode* ptNode)
+{
+    const float fLooseSize = ptNode->fHalfSize * 2.0f;
+    const plAABB tBounds = {
+        .tMin = {ptNode->tCenter.x - fLooseSize, ptNode->tCenter.y - fLooseSize, ptNode->tCenter.z - fLooseSize},
+        .tMax = {ptNode->tCenter.x + fLooseSize, ptNode->tCenter.y + fLooseSize, ptNode->tCenter.z + fLooseSize}
+    };
+    return tBounds;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api implementation
+//-----------------------------------------------------------------------------
+
+static plSpatialIndex*
+pl_spatial_create(const plSpatialIndexDesc* ptDesc)
+{
+    plSpatialIndex* ptIndex = PL_ALLOC(sizeof(plSpatialIndex));
+    memset(ptIndex, 0, sizeof(plSpatialIndex));
+    ptIndex->tCenter   = ptDesc->tCenter;
+    ptIndex->fHalfSize = ptDesc->fHalfSize > 0.0f ? ptDesc->fHalfSize : 1.0f;
+    ptIndex->uMaxDepth = ptDesc->uMaxDepth == 0 ? 8 : ptDesc->uMaxDepth;
+    if(ptIndex->uMaxDepth > PL_SPATIAL_MAX_DEPTH)
+        ptIndex->uMaxDepth = PL_SPATIAL_MAX_DEPTH;
+
+    const plSpatialNode tRoot = {
+        .tCenter   = ptIndex->tCenter,
+        .fHalfSize = ptIndex->fHalfSize,
+        .uParent   = UINT32_MAX
+    };
+    pl_sb_push(ptIndex->sbtNodes, tRoot);
+    return ptIndex;
+}
+
+static void
+pl_spatial_cleanup(plSpatialIndex** pptIndex)
+{
+    plSpatialIndex* ptIndex = *pptIndex;
+    if(ptIndex == NULL)
+        return;
+
+    for(uint32_t i = 0; i < pl_sb_size(ptIndex->sbtNodes); i++)
+    {
+        pl_sb_free(ptIndex->sbtNodes[i].sbtEntries);
+    }
+    pl_sb_free(ptIndex->sbtNodes);
+    pl_sb_free(ptIndex->sbuFreeNodes);
+    pl_sb_free(ptIndex->sbtLocations);
+    pl_sb_free(ptIndex->sbtSourceEntities);
+    PL_FREE(ptIndex);
+    *pptIndex = NULL;
+}
+
+static void
+pl_spatial_reset(plSpatialIndex* ptIndex)
+{
+    plSpatialNode* ptRoot = &ptIndex->sbtNodes[0];
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        if(ptRoot->auChildren[i])
+            pl__spatial_free_subtree(ptIndex, ptRoot->auChildren[i]);
+        ptRoot->auChildren[i] = 0;
+    }
+    pl_sb_reset(ptRoot->sbtEntries);
+    ptRoot->uSubtreeCount = 0;
+    ptRoot->bSplit = false;
+
+    for(uint32_t i = 0; i < pl_sb_size(ptIndex->sbtLocations); i++)
+        ptIndex->sbtLocations[i].uNode = UINT32_MAX;
+    pl_sb_reset(ptIndex->sbtSourceEntities);
+    ptIndex->ptSourceLibrary = NULL;
+    ptIndex->uCount = 0;
+}
+
+static void
+pl_spatial_update(plSpatialIndex* ptIndex, plEntity tEntity, const plAABB* ptBounds)
+{
+    if(tEntity.uIndex < pl_sb_size(ptIndex->sbtLocations))
+    {
+        const plSpatialLocation tLocation = ptIndex->sbtLocations[tEntity.uIndex];
+        if(tLocation.uNode != UINT32_MAX)
+        {
+            plSpatialNode* ptNode = &ptIndex->sbtNodes[tLocation.uNode];
+            plSpatialEntry* ptEntry = &ptNode->sbtEntries[tLocation.uSlot];
+
+            // still fits its node, nothing moves
+            if(ptEntry->tEntity.ulData == tEntity.ulData && pl__spatial_in_node(ptIndex, ptNode, ptBounds))
+            {
+                ptEntry->tBounds = *ptBounds;
+                return;
+            }
+
+            // moved or stale entry (entity index reused)
+            pl__spatial_remove_entry(ptIndex, tLocation.uNode, tLocation.uSlot);
+        }
+    }
+    pl__spatial_insert(ptIndex, tEntity, ptBounds);
+}
+
+static void
+pl_spatial_remove(plSpatialIndex* ptIndex, plEntity tEntity)
+{
+    if(tEntity.uIndex >= pl_sb_size(ptIndex->sbtLocations))
+        return;
+    const plSpatialLocation tLocation = ptIndex->sbtLocations[tEntity.uIndex];
+    if(tLocation.uNode == UINT32_MAX)
+        return;
+    if(ptIndex->sbtNodes[tLocation.uNode].sbtEntries[tLocation.uSlot].tEntity.ulData != tEntity.ulData)
+        return;
+    pl__spatial_remove_entry(ptIndex, tLocation.uNode, tLocation.uSlot);
+}
+
+static bool
+pl_spatial_get_bounds(const plSpatialIndex* ptIndex, plEntity tEntity, plAABB* ptBoundsOut)
+{
+    if(tEntity.uIndex >= pl_sb_size(ptIndex->sbtLocations))
+        return false;
+    const plSpatialLocation tLocation = ptIndex->sbtLocations[tEntity.uIndex];
+    if(tLocation.uNode == UINT32_MAX)
+        return false;
+    const plSpatialEntry* ptEntry = &ptIndex->sbtNodes[tLocation.uNode].sbtEntries[tLocation.uSlot];
+    if(ptEntry->tEntity.ulData != tEntity.ulData)
+        return false;
+    *ptBoundsOut = ptEntry->tBounds;
+    return true;
+}
+
+static uint32_t
+pl_spatial_get_count(const plSpatialIndex* ptIndex)
+{
+    return ptIndex->uCount;
+}
+
+static void
+pl_spatial_update_from_library(plSpatialIndex* ptIndex, plComponentLibrary* ptLibrary)
+{
+    pl_begin_profile_sample(0, __FUNCTION__);
+
+    const plComponentManager* ptManager = &ptLibrary->tObjectComponentManager;
+    const plObjectComponent* sbtObjects = ptManager->pComponents;
+    const uint32_t uObjectCount = pl_sb_size(ptManager->sbtEntities);
+
+    uint32_t uBitCount = 0;
+    const uint64_t* auChanged = gptECS->get_changed_bitset(ptLibrary, PL_COMPONENT_TYPE_OBJECT, &uBitCount);
+
+    // first feed from this library indexes everything
+    const bool bFull = ptIndex->ptSourceLibrary != ptLibrary;
+    if(bFull && ptIndex->ptSourceLibrary != NULL)
+        pl_spatial_reset(ptIndex);
+    ptIndex->ptSourceLibrary = ptLibrary;
+
+    // removals: a removed object's dense slot was either refilled (& flagged as
+    // changed) or cut off the end of the array
+    const uint32_t uPrevCount = pl_sb_size(ptIndex->sbtSourceEntities);
+    uint32_t uTracked = pl_min(uObjectCount, uBitCount); // slots covered by the bitset
+    for(uint32_t i = 0; i < uPrevCount; i++)
+    {
+        if(i < uTracked)
+        {
+            const uint64_t uWord = auChanged[i / 64] >> (i % 64);
+            if(uWord == 0) // rest of the word is unchanged
+            {
+                i = pl_min(i | 63, uTracked - 1);
+                continue;
+            }
+            if((uWord & 1) == 0)
+                continue;
+        }
+
+        const plEntity tPrevious = ptIndex->sbtSourceEntities[i];
+        if(i < uObjectCount && tPrevious.ulData == ptManager->sbtEntities[i].ulData)
+            continue;
+        if(gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_OBJECT, tPrevious) == NULL)
+            pl_spatial_remove(ptIndex, tPrevious);
+    }
+
+    // changed & new objects
+    pl_sb_resize(ptIndex->sbtSourceEntities, uObjectCount);
+    uTracked = bFull ? 0 : pl_min(uTracked, uPrevCount);
+    for(uint32_t i = 0; i < uObjectCount; i++)
+    {
+        if(i < uTracked)
+        {
+            const uint64_t uWord = auChanged[i / 64] >> (i % 64);
+            if(uWord == 0)
+            {
+                i = pl_min(i | 63, uTracked - 1);
+                continue;
+            }
+            if((uWord & 1) == 0)
+                continue;
+        }
+
+        const plEntity tEntity = ptManager->sbtEntities[i];
+        ptIndex->sbtSourceEntities[i] = tEntity;
+        const plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh);
+        if(ptMesh)
+            pl_spatial_update(ptIndex, tEntity, &ptMesh->tAABBFinal);
+        else
+            pl_spatial_remove(ptIndex, tEntity);
+    }
+
+    pl_end_profile_sample(0);
+}
+
+static uint32_t
+pl_spatial_query_aabb(const plSpatialIndex* ptIndex, const plAABB* ptBounds, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    const plSpatialQuery tQuery = {
+        .tType = PL_SPATIAL_QUERY_AABB,
+        .tBox  = *ptBounds
+    };
+    return pl__spatial_run_query(ptIndex, &tQuery, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_spatial_query_sphere(const plSpatialIndex* ptIndex, plVec3 tCenter, float fRadius, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    const plSpatialQuery tQuery = {
+        .tType          = PL_SPATIAL_QUERY_SPHERE,
+        .tBox           = {
+            .tMin = {tCenter.x - fRadius, tCenter.y - fRadius, tCenter.z - fRadius},
+            .tMax = {tCenter.x + fRadius, tCenter.y + fRadius, tCenter.z + fRadius}
+        },
+        .tCenter        = tCenter,
+        .fRadiusSquared = fRadius * fRadius
+    };
+    return pl__spatial_run_query(ptIndex, &tQuery, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_spatial_query_ray(const plSpatialIndex* ptIndex, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    plSpatialQuery tQuery = {.tType = PL_SPATIAL_QUERY_RAY};
+    pl__spatial_init_ray(&tQuery, tOrigin, tDirection, fMaxDistance);
+    return pl__spatial_run_query(ptIndex, &tQuery, atEntitiesOut, uMaxEntities);
+}
+
+static uint32_t
+pl_spatial_query_frustum(const plSpatialIndex* ptIndex, const plMat4* ptViewProjection, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    plSpatialQuery tQuery = {.tType = PL_SPATIAL_QUERY_FRUSTUM};
+
+    // planes from the rows of the clip matrix (0 <= z <= w)
+    plVec4 atRows[4];
+    for(uint32_t r = 0; r < 4; r++)
+        atRows[r] = (plVec4){ptViewProjection->col[0].d[r], ptViewProjection->col[1].d[r], ptViewProjection->col[2].d[r], ptViewProjection->col[3].d[r]};
+    tQuery.atPlanes[0] = pl_add_vec4(atRows[3], atRows[0]); // left
+    tQuery.atPlanes[1] = pl_sub_vec4(atRows[3], atRows[0]); // right
+    tQuery.atPlanes[2] = pl_add_vec4(atRows[3], atRows[1]); // bottom
+    tQuery.atPlanes[3] = pl_sub_vec4(atRows[3], atRows[1]); // top
+    tQuery.atPlanes[4] = atRows[2];                         // near
+    tQuery.atPlanes[5] = pl_sub_vec4(atRows[3], atRows[2]); // far
+    return pl__spatial_run_query(ptIndex, &tQuery, atEntitiesOut, uMaxEntities);
+}
+
+static bool
+pl_spatial_raycast(const plSpatialIndex* ptIndex, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plSpatialRayHit* ptHitOut)
+{
+    plSpatialQuery tQuery = {.tType = PL_SPATIAL_QUERY_RAY};
+    pl__spatial_init_ray(&tQuery, tOrigin, tDirection, fMaxDistance);
+
+    plSpatialRayHit tBest = {.tEntity = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX}, .fDistance = FLT_MAX};
+
+    uint32_t auStack[PL__SPATIAL_STACK_SIZE];
+    uint32_t uStackSize = 0;
+    auStack[uStackSize++] = 0;
+    while(uStackSize > 0)
+    {
+        const plSpatialNode* ptNode = &ptIndex->sbtNodes[auStack[--uStackSize]];
+
+        // nodes starting past the closest hit can't contain a closer one (root is unbounded)
+        if(ptNode->uParent != UINT32_MAX)
+        {
+            const plAABB tLooseBounds = pl__spatial_loose_bounds(ptNode);
+            float fDistance = 0.0f;
+            if(!pl__spatial_ray_distance(&tQuery, &tLooseBounds, &fDistance) || fDistance > tBest.fDistance)
+                continue;
+        }
+
+        const uint32_t uEntryCount = pl_sb_size(ptNode->sbtEntries);
+        for(uint32_t i = 0; i < uEntryCount; i++)
+        {
+            float fDistance = 0.0f;
+            if(pl__spatial_ray_distance(&tQuery, &ptNode->sbtEntries[i].tBounds, &fDistance) && fDistance < tBest.fDistance)
+            {
+                tBest.fDistance = fDistance;
+                tBest.tEntity = ptNode->sbtEntries[i].tEntity;
+            }
+        }
+
+        for(uint32_t i = 0; i < 8; i++)
+        {
+            if(ptNode->auChildren[i])
+                auStack[uStackSize++] = ptNode->auChildren[i];
+        }
+    }
+
+    if(tBest.tEntity.uIndex == UINT32_MAX)
+        return false;
+    if(ptHitOut)
+        *ptHitOut = tBest;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] internal api implementation
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__spatial_new_node(plSpatialIndex* ptIndex, uint32_t uParent, uint32_t uOctant)
+{
+    uint32_t uNode = 0;
+    if(pl_sb_size(ptIndex->sbuFreeNodes) > 0)
+        uNode = pl_sb_pop(ptIndex->sbuFreeNodes);
+    else
+    {
+        uNode = pl_sb_size(ptIndex->sbtNodes);
+        pl_sb_add(ptIndex->sbtNodes);
+        ptIndex->sbtNodes[uNode].sbtEntries = NULL;
+    }
+
+    const plSpatialNode* ptParent = &ptIndex->sbtNodes[uParent];
+    const float fHalfSize = ptParent->fHalfSize * 0.5f;
+    plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+    plSpatialEntry* sbtEntries = ptNode->sbtEntries; // keep memory of reused nodes
+    memset(ptNode, 0, sizeof(plSpatialNode));
+    ptNode->sbtEntries = sbtEntries;
+    ptNode->fHalfSize  = fHalfSize;
+    ptNode->uParent    = uParent;
+    ptNode->uDepth     = ptParent->uDepth + 1;
+    ptNode->tCenter.x  = ptParent->tCenter.x + ((uOctant & 1) ? fHalfSize : -fHalfSize);
+    ptNode->tCenter.y  = ptParent->tCenter.y + ((uOctant & 2) ? fHalfSize : -fHalfSize);
+    ptNode->tCenter.z  = ptParent->tCenter.z + ((uOctant & 4) ? fHalfSize : -fHalfSize);
+    ptIndex->sbtNodes[uParent].auChildren[uOctant] = uNode;
+    return uNode;
+}
+
+static void
+pl__spatial_free_subtree(plSpatialIndex* ptIndex, uint32_t uNode)
+{
+    // only called on empty subtrees
+    plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        if(ptNode->auChildren[i])
+            pl__spatial_free_subtree(ptIndex, ptNode->auChildren[i]);
+        ptNode->auChildren[i] = 0;
+    }
+    pl_sb_reset(ptNode->sbtEntries);
+    pl_sb_push(ptIndex->sbuFreeNodes, uNode);
+}
+
+static uint32_t
+pl__spatial_target_depth(const plSpatialIndex* ptIndex, const plAABB* ptBounds)
+{
+    // deepest level whose cell half size still covers the largest half extent
+    // (center anywhere in the cell keeps the AABB within the loose bounds)
+    const float fExtentX = ptBounds->tMax.x - ptBounds->tMin.x;
+    const float fExtentY = ptBounds->tMax.y - ptBounds->tMin.y;
+    const float fExtentZ = ptBounds->tMax.z - ptBounds->tMin.z;
+    const float fHalfExtent = 0.5f * pl_max(fExtentX, pl_max(fExtentY, fExtentZ));
+
+    uint32_t uDepth = 0;
+    float fHalfSize = ptIndex->fHalfSize;
+    while(uDepth < ptIndex->uMaxDepth && fHalfSize * 0.5f >= fHalfExtent)
+    {
+        fHalfSize *= 0.5f;
+        uDepth++;
+    }
+    return uDepth;
+}
+
+static inline plVec3
+pl__spatial_bounds_center(const plAABB* ptBounds)
+{
+    return (plVec3){
+        0.5f * (ptBounds->tMin.x + ptBounds->tMax.x),
+        0.5f * (ptBounds->tMin.y + ptBounds->tMax.y),
+        0.5f * (ptBounds->tMin.z + ptBounds->tMax.z)
+    };
+}
+
+static inline bool
+pl__spatial_in_cell(const plSpatialNode* ptNode, plVec3 tPoint)
+{
+    return fabsf(tPoint.x - ptNode->tCenter.x) <= ptNode->fHalfSize &&
+           fabsf(tPoint.y - ptNode->tCenter.y) <= ptNode->fHalfSize &&
+           fabsf(tPoint.z - ptNode->tCenter.z) <= ptNode->fHalfSize;
+}
+
+static bool
+pl__spatial_in_node(const plSpatialIndex* ptIndex, const plSpatialNode* ptNode, const plAABB* ptBounds)
+{
+    // bounds still within the node's loose bounds (they may fit deeper now, but
+    // that only costs queries a little)
+    if(ptNode->uDepth == 0)
+        return true;
+    const plVec3 tCenter = pl__spatial_bounds_center(ptBounds);
+    return pl__spatial_in_cell(ptNode, tCenter) && pl__spatial_target_depth(ptIndex, ptBounds) >= ptNode->uDepth;
+}
+
+static inline uint32_t
+pl__spatial_octant(const plSpatialNode* ptNode, plVec3 tPoint)
+{
+    return (tPoint.x >= ptNode->tCenter.x ? 1 : 0) |
+           (tPoint.y >= ptNode->tCenter.y ? 2 : 0) |
+           (tPoint.z >= ptNode->tCenter.z ? 4 : 0);
+}
+
+static void
+pl__spatial_place(plSpatialIndex* ptIndex, uint32_t uNode, const plSpatialEntry* ptEntry)
+{
+    // counts are handled by the caller
+    plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+    pl_sb_push(ptNode->sbtEntries, *ptEntry);
+    ptIndex->sbtLocations[ptEntry->tEntity.uIndex].uNode = uNode;
+    ptIndex->sbtLocations[ptEntry->tEntity.uIndex].uSlot = pl_sb_size(ptNode->sbtEntries) - 1;
+
+    if(!ptNode->bSplit && ptNode->uDepth < ptIndex->uMaxDepth && pl_sb_size(ptNode->sbtEntries) > PL__SPATIAL_SPLIT_COUNT)
+        pl__spatial_split(ptIndex, uNode);
+}
+
+static void
+pl__spatial_split(plSpatialIndex* ptIndex, uint32_t uNode)
+{
+    // push entries that fit a level deeper into children
+    ptIndex->sbtNodes[uNode].bSplit = true;
+    const uint32_t uDepth = ptIndex->sbtNodes[uNode].uDepth;
+
+    uint32_t uSlot = 0;
+    while(uSlot < pl_sb_size(ptIndex->sbtNodes[uNode].sbtEntries))
+    {
+        plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+        const plSpatialEntry tEntry = ptNode->sbtEntries[uSlot];
+        const plVec3 tCenter = pl__spatial_bounds_center(&tEntry.tBounds);
+        if(pl__spatial_target_depth(ptIndex, &tEntry.tBounds) <= uDepth || !pl__spatial_in_cell(ptNode, tCenter))
+        {
+            uSlot++;
+            continue;
+        }
+
+        // swap last entry into the slot
+        const uint32_t uLastSlot = pl_sb_size(ptNode->sbtEntries) - 1;
+        if(uSlot < uLastSlot)
+        {
+            ptNode->sbtEntries[uSlot] = ptNode->sbtEntries[uLastSlot];
+            ptIndex->sbtLocations[ptNode->sbtEntries[uSlot].tEntity.uIndex].uSlot = uSlot;
+        }
+        pl_sb_pop_n(ptNode->sbtEntries, 1);
+
+        const uint32_t uOctant = pl__spatial_octant(ptNode, tCenter);
+        uint32_t uChild = ptNode->auChildren[uOctant];
+        if(uChild == 0)
+            uChild = pl__spatial_new_node(ptIndex, uNode, uOctant);
+        ptIndex->sbtNodes[uChild].uSubtreeCount++;
+        pl__spatial_place(ptIndex, uChild, &tEntry);
+    }
+}
+
+static void
+pl__spatial_insert(plSpatialIndex* ptIndex, plEntity tEntity, const plAABB* ptBounds)
+{
+    // descend by center through split nodes (bounds centered outside the root
+    // cell stay at the root)
+    uint32_t uNode = 0;
+    const plVec3 tCenter = pl__spatial_bounds_center(ptBounds);
+    if(pl__spatial_in_cell(&ptIndex->sbtNodes[0], tCenter))
+    {
+        const uint32_t uDepth = pl__spatial_target_depth(ptIndex, ptBounds);
+        while(ptIndex->sbtNodes[uNode].bSplit && ptIndex->sbtNodes[uNode].uDepth < uDepth)
+        {
+            const plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+            const uint32_t uOctant = pl__spatial_octant(ptNode, tCenter);
+            if(ptNode->auChildren[uOctant])
+                uNode = ptNode->auChildren[uOctant];
+            else
+                uNode = pl__spatial_new_node(ptIndex, uNode, uOctant);
+        }
+    }
+
+    if(tEntity.uIndex >= pl_sb_size(ptIndex->sbtLocations))
+    {
+        const uint32_t uOldSize = pl_sb_size(ptIndex->sbtLocations);
+        pl_sb_resize(ptIndex->sbtLocations, tEntity.uIndex + 1);
+        for(uint32_t i = uOldSize; i < tEntity.uIndex + 1; i++)
+            ptIndex->sbtLocations[i].uNode = UINT32_MAX;
+    }
+
+    for(uint32_t uParent = uNode; uParent != UINT32_MAX; uParent = ptIndex->sbtNodes[uParent].uParent)
+        ptIndex->sbtNodes[uParent].uSubtreeCount++;
+    ptIndex->uCount++;
+
+    const plSpatialEntry tEntry = {
+        .tBounds = *ptBounds,
+        .tEntity = tEntity
+    };
+    pl__spatial_place(ptIndex, uNode, &tEntry);
+}
+
+static void
+pl__spatial_remove_entry(plSpatialIndex* ptIndex, uint32_t uNode, uint32_t uSlot)
+{
+    plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+    ptIndex->sbtLocations[ptNode->sbtEntries[uSlot].tEntity.uIndex].uNode = UINT32_MAX;
+
+    // swap last entry into the slot
+    const uint32_t uLastSlot = pl_sb_size(ptNode->sbtEntries) - 1;
+    if(uSlot < uLastSlot)
+    {
+        ptNode->sbtEntries[uSlot] = ptNode->sbtEntries[uLastSlot];
+        ptIndex->sbtLocations[ptNode->sbtEntries[uSlot].tEntity.uIndex].uSlot = uSlot;
+    }
+    pl_sb_pop_n(ptNode->sbtEntries, 1);
+
+    // update counts & prune the highest subtree left empty (root stays)
+    uint32_t uEmptyNode = UINT32_MAX;
+    while(uNode != UINT32_MAX)
+    {
+        plSpatialNode* ptCurrent = &ptIndex->sbtNodes[uNode];
+        ptCurrent->uSubtreeCount--;
+        if(ptCurrent->uSubtreeCount == 0 && ptCurrent->uParent != UINT32_MAX)
+            uEmptyNode = uNode;
+        uNode = ptCurrent->uParent;
+    }
+
+    if(uEmptyNode != UINT32_MAX)
+    {
+        plSpatialNode* ptParent = &ptIndex->sbtNodes[ptIndex->sbtNodes[uEmptyNode].uParent];
+        for(uint32_t i = 0; i < 8; i++)
+        {
+            if(ptParent->auChildren[i] == uEmptyNode)
+                ptParent->auChildren[i] = 0;
+        }
+        pl__spatial_free_subtree(ptIndex, uEmptyNode);
+    }
+    ptIndex->uCount--;
+}
+
+static void
+pl__spatial_init_ray(plSpatialQuery* ptQuery, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance)
+{
+    ptQuery->tOrigin      = tOrigin;
+    ptQuery->fMaxDistance = fMaxDistance;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        ptQuery->abParallel[i] = tDirection.d[i] == 0.0f;
+        ptQuery->tInvDirection.d[i] = ptQuery->abParallel[i] ? 0.0f : 1.0f / tDirection.d[i];
+    }
+}
+
+static bool
+pl__spatial_ray_distance(const plSpatialQuery* ptQuery, const plAABB* ptBounds, float* pfDistanceOut)
+{
+    // slab test
+    float fNear = 0.0f;
+    float fFar = ptQuery->fMaxDistance;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        if(ptQuery->abParallel[i])
+        {
+            if(ptQuery->tOrigin.d[i] < ptBounds->tMin.d[i] || ptQuery->tOrigin.d[i] > ptBounds->tMax.d[i])
+                return false;
+            continue;
+        }
+        float fT0 = (ptBounds->tMin.d[i] - ptQuery->tOrigin.d[i]) * ptQuery->tInvDirection.d[i];
+        float fT1 = (ptBounds->tMax.d[i] - ptQuery->tOrigin.d[i]) * ptQuery->tInvDirection.d[i];
+        if(fT0 > fT1)
+        {
+            const float fTemp = fT0;
+            fT0 = fT1;
+            fT1 = fTemp;
+        }
+        fNear = pl_max(fNear, fT0);
+        fFar = pl_min(fFar, fT1);
+        if(fNear > fFar)
+            return false;
+    }
+    *pfDistanceOut = fNear;
+    return true;
+}
+
+static bool
+pl__spatial_overlaps(const plSpatialQuery* ptQuery, const plAABB* ptBounds)
+{
+    switch(ptQuery->tType)
+    {
+        case PL_SPATIAL_QUERY_AABB:
+            return ptBounds->tMin.x <= ptQuery->tBox.tMax.x && ptBounds->tMax.x >= ptQuery->tBox.tMin.x &&
+                   ptBounds->tMin.y <= ptQuery->tBox.tMax.y && ptBounds->tMax.y >= ptQuery->tBox.tMin.y &&
+                   ptBounds->tMin.z <= ptQuery->tBox.tMax.z && ptBounds->tMax.z >= ptQuery->tBox.tMin.z;
+
+        case PL_SPATIAL_QUERY_SPHERE:
+        {
+            // squared distance from the center to the box
+            float fDistanceSquared = 0.0f;
+            for(uint32_t i = 0; i < 3; i++)
+            {
+                const float fValue = ptQuery->tCenter.d[i];
+                if(fValue < ptBounds->tMin.d[i])
+                    fDistanceSquared += (ptBounds->tMin.d[i] - fValue) * (ptBounds->tMin.d[i] - fValue);
+                else if(fValue > ptBounds->tMax.d[i])
+                    fDistanceSquared += (fValue - ptBounds->tMax.d[i]) * (fValue - ptBounds->tMax.d[i]);
+            }
+            return fDistanceSquared <= ptQuery->fRadiusSquared;
+        }
+
+        case PL_SPATIAL_QUERY_RAY:
+        {
+            float fDistance = 0.0f;
+            return pl__spatial_ray_distance(ptQuery, ptBounds, &fDistance);
+        }
+
+        case PL_SPATIAL_QUERY_FRUSTUM:
+        {
+            // outside if the corner furthest along a plane's normal is behind it
+            for(uint32_t i = 0; i < 6; i++)
+            {
+                const plVec4 tPlane = ptQuery->atPlanes[i];
+                const float fX = tPlane.x >= 0.0f ? ptBounds->tMax.x : ptBounds->tMin.x;
+                const float fY = tPlane.y >= 0.0f ? ptBounds->tMax.y : ptBounds->tMin.y;
+                const float fZ = tPlane.z >= 0.0f ? ptBounds->tMax.z : ptBounds->tMin.z;
+                if(tPlane.x * fX + tPlane.y * fY + tPlane.z * fZ + tPlane.w < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t
+pl__spatial_run_query(const plSpatialIndex* ptIndex, const plSpatialQuery* ptQuery, plEntity* atEntitiesOut, uint32_t uMaxEntities)
+{
+    uint32_t uFound = 0;
+
+    uint32_t auStack[PL__SPATIAL_STACK_SIZE];
+    uint32_t uStackSize = 0;
+    auStack[uStackSize++] = 0;
+    while(uStackSize > 0)
+    {
+        const plSpatialNode* ptNode = &ptIndex->sbtNodes[auStack[--uStackSize]];
+
+        // root also holds bounds centered outside it, so it's always visited
+        if(ptNode->uParent != UINT32_MAX)
+        {
+            const plAABB tLooseBounds = pl__spatial_loose_bounds(ptNode);
+            if(!pl__spatial_overlaps(ptQuery, &tLooseBounds))
+                continue;
+        }
+
+        const uint32_t uEntryCount = pl_sb_size(ptNode->sbtEntries);
+        for(uint32_t i = 0; i < uEntryCount; i++)
+        {
+            if(pl__spatial_overlaps(ptQuery, &ptNode->sbtEntries[i].tBounds))
+            {
+                if(uFound < uMaxEntities)
+                    atEntitiesOut[uFound] = ptNode->sbtEntries[i].tEntity;
+                uFound++;
+            }
+        }
+
+        for(uint32_t i = 0; i < 8; i++)
+        {
+            if(ptNode->auChildren[i])
+                auStack[uStackSize++] = ptNode->auChildren[i];
+        }
+    }
+    return uFound;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] extension loading
+//-----------------------------------------------------------------------------
+
+static const plSpatialI*
+pl_load_spatial_api(void)
+{
+    static const plSpatialI tApi = {
+        .create              = pl_spatial_create,
+        .cleanup             = pl_spatial_cleanup,
+        .reset               = pl_spatial_reset,
+        .update              = pl_spatial_update,
+        .remove              = pl_spatial_remove,
+        .get_bounds          = pl_spatial_get_bounds,
+        .get_count           = pl_spatial_get_count,
+        .update_from_library = pl_spatial_update_from_library,
+        .query_aabb          = pl_spatial_query_aabb,
+        .query_sphere        = pl_spatial_query_sphere,
+        .query_ray           = pl_spatial_query_ray,
+        .query_frustum       = pl_spatial_query_frustum,
+        .raycast             = pl_spatial_raycast
+    };
+    return &tApi;
+}
+
+static void
+pl_load_spatial_ext(plApiRegistryI* ptApiRegistry, bool bReload)
+{
+    ptApiRegistry->add(PL_API_SPATIAL, pl_load_spatial_api());
+}
+
+static void
+pl_unload_spatial_ext(plApiRegistryI* ptApiRegistry, bool bReload)
+{
+    ptApiRegistry->remove(pl_load_spatial_api());
+}
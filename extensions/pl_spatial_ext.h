@@ -0,0 +1,123 @@
+/*
+   pl_spatial_ext.h
+     - dynamic spatial index (loose octree) over entity AABBs
+*/
+
+/*
+Index of this file:
+// [SECTION] header mess
+// [SECTION] includes
+// [SECTION] APIs
+// [SECTION] defines
+// [SECTION] forward declarations
+// [SECTION] public api structs
+// [SECTION] structs
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] header mess
+//-----------------------------------------------------------------------------
+
+#ifndef PL_SPATIAL_EXT_H
+#define PL_SPATIAL_EXT_H
+
+// extension version (format XYYZZ)
+#define PL_SPATIAL_EXT_VERSION    "1.0.0"
+#define PL_SPATIAL_EXT_VERSION_NUM 10000
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pl_math.h"
+#include "pl_ecs_ext.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] APIs
+//-----------------------------------------------------------------------------
+
+#define PL_API_SPATIAL "PL_API_SPATIAL"
+typedef struct _plSpatialI plSpatialI;
+
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#define PL_SPATIAL_MAX_DEPTH 16
+
+//-----------------------------------------------------------------------------
+// [SECTION] forward declarations
+//-----------------------------------------------------------------------------
+
+typedef struct _plSpatialIndex     plSpatialIndex; // opaque type
+typedef struct _plSpatialIndexDesc plSpatialIndexDesc;
+typedef struct _plSpatialRayHit    plSpatialRayHit;
+
+//-----------------------------------------------------------------------------
+// [SECTION] public api structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plSpatialI
+{
+    // setup/shutdown
+    plSpatialIndex* (*create) (const plSpatialIndexDesc*);
+    void            (*cleanup)(plSpatialIndex**);
+    void            (*reset)  (plSpatialIndex*); // removes everything (keeps memory)
+
+    // manual updates
+    //   - "update" inserts the entity or moves it to its new bounds
+    //   - only changes the octree when the bounds leave their node, so call it freely
+    void     (*update)    (plSpatialIndex*, plEntity, const plAABB*);
+    void     (*remove)    (plSpatialIndex*, plEntity);
+    bool     (*get_bounds)(const plSpatialIndex*, plEntity, plAABB* ptBoundsOut);
+    uint32_t (*get_count) (const plSpatialIndex*);
+
+    // ecs feed
+    //   - indexes every object by its mesh's tAABBFinal
+    //   - incremental: only visits objects flagged by the object system's change bitset
+    //     (see plEcsI.get_changed_bitset) & objects removed since the last call
+    //   - call once after each "run_object_update_system" (& cpu skinning, if used); the
+    //     first call (or a call with a different library) indexes every object
+    //   - an index fed from a library shouldn't also be updated manually
+    void (*update_from_library)(plSpatialIndex*, plComponentLibrary*);
+
+    // queries
+    //   - return the number of matching entities, only the first uMaxEntities are written
+    //     (pass NULL/0 to count)
+    //   - results are in no particular order
+    //   - queries only read the index, so any number may run concurrently (but not
+    //     concurrently with updates)
+    //   - "query_frustum" takes a view projection matrix with 0 to 1 clip depth (plCameraComponent's
+    //     tProjMat * tViewMat)
+    uint32_t (*query_aabb)   (const plSpatialIndex*, const plAABB*, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+    uint32_t (*query_sphere) (const plSpatialIndex*, plVec3 tCenter, float fRadius, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+    uint32_t (*query_ray)    (const plSpatialIndex*, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+    uint32_t (*query_frustum)(const plSpatialIndex*, const plMat4* ptViewProjection, plEntity* atEntitiesOut, uint32_t uMaxEntities);
+
+    // closest AABB hit along the ray (distance is 0 for rays starting inside an AABB);
+    // false if nothing is hit within fMaxDistance
+    bool (*raycast)(const plSpatialIndex*, plVec3 tOrigin, plVec3 tDirection, float fMaxDistance, plSpatialRayHit* ptHitOut);
+} plSpatialI;
+
+//-----------------------------------------------------------------------------
+// [SECTION] structs
+//-----------------------------------------------------------------------------
+
+typedef struct _plSpatialIndexDesc
+{
+    // octree cell covering the bulk of the world; AABBs centered outside it
+    // still work but are kept (& tested by every query) at the root
+    plVec3   tCenter;
+    float    fHalfSize;
+    uint32_t uMaxDepth; // default: 8 (max PL_SPATIAL_MAX_DEPTH)
+} plSpatialIndexDesc;
+
+typedef struct _plSpatialRayHit
+{
+    plEntity tEntity;
+    float    fDistance; // in units of tDirection's length
+} plSpatialRayHit;
+
+#endif // PL_SPATIAL_EXT_H
@@ -272,10 +272,10 @@ COMPILE TIME OPTIONS
     (pl__sb_may_grow((buf), sizeof(*(buf)), 1, 8, __FILE__, __LINE__), (buf)[pl__sb_header((buf))->uSize++] = (v))
 
 #define pl_sb_reserve(buf, n) \
-    (pl__sb_may_grow((buf), sizeof(*(buf)), (n), (n), __FILE__, __LINE__))
+    pl__sb_reserve_((void**)&(buf), sizeof(*(buf)), (n), __FILE__, __LINE__)
 
 #define pl_sb_resize(buf, n) \
-    (pl__sb_may_grow((buf), sizeof(*(buf)), (n), (n), __FILE__, __LINE__), pl__sb_header((buf))->uSize = (n))
+    pl__sb_resize_((void**)&(buf), sizeof(*(buf)), (n), __FILE__, __LINE__)
 
 #define pl_sb_del_n(buf, i, n) \
     (memmove(&(buf)[i], &(buf)[(i) + (n)], sizeof *(buf) * (pl__sb_header(buf)->uSize - (n) - (i))), pl__sb_header(buf)->uSize -= (n))
@@ -349,18 +349,18 @@ typedef struct
 } plSbHeader_;
 
 static void
-pl__sb_grow(void** ptrBuffer, size_t szElementSize, size_t szNewItems, const char* pcFile, int iLine)
+pl__sb_grow(void** ptrBuffer, size_t szElementSize, size_t szNewCapacity, const char* pcFile, int iLine)
 {
 
     plSbHeader_* ptOldHeader = pl__sb_header(*ptrBuffer);
 
-    const size_t szNewSize = (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plSbHeader_);
+    const size_t szNewSize = szNewCapacity * szElementSize + sizeof(plSbHeader_);
     plSbHeader_* ptNewHeader = (plSbHeader_*)PL_DS_ALLOC_INDIRECT(szNewSize, pcFile, iLine); //-V592
-    memset(ptNewHeader, 0, (ptOldHeader->uCapacity + szNewItems) * szElementSize + sizeof(plSbHeader_));
+    memset(ptNewHeader, 0, szNewSize);
     if(ptNewHeader)
     {
         ptNewHeader->uSize = ptOldHeader->uSize;
-        ptNewHeader->uCapacity = ptOldHeader->uCapacity + (uint32_t)szNewItems;
+        ptNewHeader->uCapacity = (uint32_t)szNewCapacity;
         memcpy(&ptNewHeader[1], *ptrBuffer, ptOldHeader->uSize * szElementSize);
         PL_DS_FREE(ptOldHeader);
         *ptrBuffer = &ptNewHeader[1];
@@ -375,7 +375,11 @@ pl__sb_may_grow_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, size
         plSbHeader_* ptOriginalHeader = pl__sb_header(*ptrBuffer);
         if(ptOriginalHeader->uSize + szNewItems > ptOriginalHeader->uCapacity)
         {
-            pl__sb_grow(ptrBuffer, szElementSize, szNewItems, pcFile, iLine);
+            // grow geometrically so repeated adds stay amortized O(1)
+            size_t szNewCapacity = ptOriginalHeader->uSize + szNewItems;
+            if(szNewCapacity < (size_t)ptOriginalHeader->uCapacity * 2 && (size_t)ptOriginalHeader->uCapacity * 2 <= UINT32_MAX)
+                szNewCapacity = (size_t)ptOriginalHeader->uCapacity * 2;
+            pl__sb_grow(ptrBuffer, szElementSize, szNewCapacity, pcFile, iLine);
         }
     }
     else // first run
@@ -392,6 +396,24 @@ pl__sb_may_grow_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, size
     }
 }
 
+static void
+pl__sb_reserve_(void** ptrBuffer, size_t szElementSize, size_t szNewItems, const char* pcFile, int iLine)
+{
+    if(*ptrBuffer == NULL)
+        pl__sb_may_grow_(ptrBuffer, szElementSize, szNewItems, szNewItems, pcFile, iLine);
+    else if(pl__sb_header(*ptrBuffer)->uSize + szNewItems > pl__sb_header(*ptrBuffer)->uCapacity)
+        pl__sb_grow(ptrBuffer, szElementSize, pl__sb_header(*ptrBuffer)->uSize + szNewItems, pcFile, iLine); // exact
+}
+
+static void
+pl__sb_resize_(void** ptrBuffer, size_t szElementSize, size_t szNewSize, const char* pcFile, int iLine)
+{
+    const size_t szOldSize = *ptrBuffer ? pl__sb_header(*ptrBuffer)->uSize : 0;
+    pl__sb_may_grow_(ptrBuffer, szElementSize, szNewSize > szOldSize ? szNewSize - szOldSize : 0, szNewSize, pcFile, iLine);
+    if(*ptrBuffer)
+        pl__sb_header(*ptrBuffer)->uSize = (uint32_t)szNewSize;
+}
+
 static void
 pl__sb_vsprintf(char** ppcBuffer, const char* pcFormat, va_list args)
 {
@@ -10,6 +10,9 @@
    #include ...
    #define PL_JSON_IMPLEMENTATION
    #include "pl_json.h"
+   Notes:
+   * if pl_number.h is included before the implementation it is used for
+     number parsing & formatting, otherwise the C library is used
 */
 
 // library version (format XYYZZ)
@@ -19,11 +22,12 @@
 /*
 Index of this file:
 // [SECTION] header mess
+// [SECTION] defines
 // [SECTION] includes
 // [SECTION] forward declarations
 // [SECTION] public api
 // [SECTION] enums
-// [SECTION] jsmn.h
+// [SECTION] structs
 // [SECTION] c file
 */
 
@@ -34,19 +38,35 @@ Index of this file:
 #ifndef PL_JSON_H
 #define PL_JSON_H
 
+//-----------------------------------------------------------------------------
+// [SECTION] defines
+//-----------------------------------------------------------------------------
+
+#ifndef PL_JSON_MAX_DEPTH
+    #define PL_JSON_MAX_DEPTH 1024 // deeper documents are rejected (parsing & streaming writer)
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] includes
 //-----------------------------------------------------------------------------
 
 #include <stdint.h>  // uint*_t
 #include <stdbool.h> // bool
+#include <stddef.h>  // size_t
 
 //-----------------------------------------------------------------------------
 // [SECTION] forward declarations
 //-----------------------------------------------------------------------------
 
 // basic types
-typedef struct _plJsonObject plJsonObject; // opaque pointer to json object
+typedef struct _plJsonObject     plJsonObject;     // opaque pointer to json object
+typedef struct _plJsonWriter     plJsonWriter;     // streaming writer state (caller owned)
+typedef struct _plJsonWriterDesc plJsonWriterDesc;
+typedef struct _plJsonMemorySink plJsonMemorySink; // pUserData for pl_json_memory_sink
+typedef struct _plJsonBinValue   plJsonBinValue;   // value inside a plBin buffer (read without copying)
+
+// callbacks
+typedef void (*plJsonSinkCallback)(void* pUserData, const char* pcData, size_t szSize);
 
 // enums
 typedef int plJsonType;
@@ -56,11 +76,17 @@ typedef int plJsonType;
 //-----------------------------------------------------------------------------
 
 // main
-bool          pl_load_json           (const char* pcJson, plJsonObject** pptJsonOut);
+bool          pl_load_json           (const char* pcJson, plJsonObject** pptJsonOut); // null terminated (wraps pl_parse_json)
+bool          pl_parse_json          (const char* pcJson, size_t szLength, plJsonObject** pptJsonOut);
 void          pl_unload_json         (plJsonObject**);
 plJsonObject* pl_json_new_root_object(const char* pcName); // for writing
 char*         pl_write_json          (plJsonObject*, char* pcBuffer, uint32_t* puBufferSize);
 
+// newline delimited json (one document per line, blank lines skipped)
+//   * returns false once no documents remain or on a parse error
+//   * on error, *pszCursor is left at the start of the offending line (< szLength)
+bool          pl_parse_json_ndjson   (const char* pcJson, size_t szLength, size_t* pszCursor, plJsonObject** pptJsonOut);
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~reading~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 // members
@@ -125,6 +151,64 @@ void pl_json_add_string_array(plJsonObject*, const char* pcName,    char**, uint
 plJsonObject* pl_json_add_member      (plJsonObject*, const char* pcName);                  // returns object to be modified with above commands
 plJsonObject* pl_json_add_member_array(plJsonObject*, const char* pcName, uint32_t uCount); // returns array of uCount length
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~streaming writer~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// notes
+//   - output is staged in the caller's buffer & handed to the sink whenever it fills
+//     (memory use is bounded by that buffer, no tree is built)
+//   - misuse (value without key in object, unbalanced end, etc.) is latched and
+//     reported by pl_json_writer_finish
+//   - floats/doubles are written with the fewest digits that round trip (nan/inf become null)
+
+void pl_json_writer_init  (plJsonWriter*, const plJsonWriterDesc*);
+void pl_json_writer_flush (plJsonWriter*);
+bool pl_json_writer_finish(plJsonWriter*); // flushes, returns false if the document is incomplete or was misused
+
+void pl_json_write_begin_object(plJsonWriter*);
+void pl_json_write_end_object  (plJsonWriter*);
+void pl_json_write_begin_array (plJsonWriter*);
+void pl_json_write_end_array   (plJsonWriter*);
+void pl_json_write_key         (plJsonWriter*, const char* pcKey);
+void pl_json_write_string      (plJsonWriter*, const char*);
+void pl_json_write_int         (plJsonWriter*, int64_t);
+void pl_json_write_uint        (plJsonWriter*, uint64_t);
+void pl_json_write_float       (plJsonWriter*, float);
+void pl_json_write_double      (plJsonWriter*, double);
+void pl_json_write_bool        (plJsonWriter*, bool);
+void pl_json_write_null        (plJsonWriter*);
+
+// provided sinks
+void pl_json_memory_sink(void* pUserData, const char* pcData, size_t szSize); // pUserData: plJsonMemorySink*
+void pl_json_file_sink  (void* pUserData, const char* pcData, size_t szSize); // pUserData: FILE*
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~binary format (plBin)~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// notes
+//   - plBin is a flat, position independent encoding of the json model meant to
+//     be mapped or read into memory & used in place (little endian)
+//   - values are tagged 32 bit references, small integers are stored inline
+//   - arrays & objects store offset tables (O(1) element access), objects with
+//     more than PL_JSON_MEMBER_INDEX_THRESHOLD members also store a hash index
+//   - names & strings are deduplicated, null terminated, & kept as written in
+//     the json source (escapes are not decoded, same as pl_json_as_string)
+//   - numbers whose text isn't reproduced by formatting (i.e. "1.0") keep their
+//     text so json -> plBin -> json is lossless
+//   - pl_load_json_bin validates the buffer, pl_json_bin_root only checks the
+//     header (use on trusted data)
+
+bool           pl_write_json_bin          (plJsonObject*, void* pBuffer, size_t* pszSize); // pBuffer NULL to query size
+bool           pl_load_json_bin           (const void* pBuffer, size_t szSize, plJsonObject** pptJsonOut);
+bool           pl_json_bin_root           (const void* pBuffer, size_t szSize, plJsonBinValue* ptValueOut);
+plJsonType     pl_json_bin_get_type       (plJsonBinValue); // PL_JSON_TYPE_UNSPECIFIED for missing members/elements
+uint32_t       pl_json_bin_count          (plJsonBinValue); // members, elements, or string length
+plJsonBinValue pl_json_bin_member         (plJsonBinValue, const char* pcName);
+plJsonBinValue pl_json_bin_member_by_index(plJsonBinValue, uint32_t uIndex, const char** ppcNameOut);
+plJsonBinValue pl_json_bin_element        (plJsonBinValue, uint32_t uIndex);
+int64_t        pl_json_bin_as_int         (plJsonBinValue);
+double         pl_json_bin_as_double      (plJsonBinValue);
+bool           pl_json_bin_as_bool        (plJsonBinValue);
+const char*    pl_json_bin_as_string      (plJsonBinValue);
+
 //-----------------------------------------------------------------------------
 // [SECTION] enums
 //-----------------------------------------------------------------------------
@@ -140,379 +224,51 @@ enum plJsonType_
 	PL_JSON_TYPE_NULL,
 };
 
-#endif //PL_JSON_H
-
-#ifdef PL_JSON_IMPLEMENTATION
-
-#ifndef PL_GLTF_EXTENSION_H
-
 //-----------------------------------------------------------------------------
-// [SECTION] jsmn.h
+// [SECTION] structs
 //-----------------------------------------------------------------------------
 
-/*
- * MIT License
- *
- * Copyright (c) 2010 Serge Zaitsev
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
- * SOFTWARE.
- */
-#ifndef JSMN_H
-#define JSMN_H
-
-#include <stddef.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#ifdef JSMN_STATIC
-#define JSMN_API static
-#else
-#define JSMN_API extern
-#endif
-
-typedef enum 
-{
-  JSMN_UNDEFINED = 0,
-  JSMN_OBJECT    = 1 << 0,
-  JSMN_ARRAY     = 1 << 1,
-  JSMN_STRING    = 1 << 2,
-  JSMN_PRIMITIVE = 1 << 3  // number, boolean (true/false) or null
-} jsmntype_t;
-
-enum jsmnerr 
-{
-  
-  JSMN_ERROR_NOMEM = -1, // Not enough tokens were provided
-  JSMN_ERROR_INVAL = -2, // Invalid character inside JSON string
-  JSMN_ERROR_PART  = -3  // The string is not a full JSON packet, more bytes expected
-};
-
-typedef struct jsmntok 
+typedef struct _plJsonWriterDesc
 {
-  jsmntype_t type;  // type (object, array, string etc.)
-  int        start; // start position in JSON data string
-  int        end;   // end position in JSON data string
-  int        size;
-} jsmntok_t;
+    plJsonSinkCallback pfSink;
+    void*              pUserData;
+    char*              pcBuffer;    // staging buffer (caller owned)
+    uint32_t           uBufferSize;
+    bool               bPretty;     // newlines & 4 space indentation
+} plJsonWriterDesc;
 
-typedef struct jsmn_parser
+typedef struct _plJsonMemorySink
 {
-  unsigned int pos;      // offset in the JSON string
-  unsigned int toknext;  // next token to allocate
-  int          toksuper; // superior token node, e.g. parent object or array
-} jsmn_parser;
-
-
-JSMN_API void jsmn_init (jsmn_parser* parser);
-JSMN_API int  jsmn_parse(jsmn_parser* parser, const char* js, const size_t len, jsmntok_t* tokens, const unsigned int num_tokens);
+    char*  pcBuffer;
+    size_t szCapacity;
+    size_t szSize;     // bytes written (excluding null terminator)
+    bool   bOverflow;  // output was truncated
+} plJsonMemorySink;
 
-#ifndef JSMN_HEADER
-
-// allocates a fresh unused token from the token pool.
-static jsmntok_t*
-jsmn_alloc_token(jsmn_parser* parser, jsmntok_t* tokens, const size_t num_tokens) 
+typedef struct _plJsonBinValue
 {
-  jsmntok_t* tok;
-  if (parser->toknext >= num_tokens)
-    return NULL;
-  tok = &tokens[parser->toknext++];
-  tok->start = tok->end = -1;
-  tok->size = 0;
-  return tok;
-}
-
-// Fills token type and boundaries.
-static void
-jsmn_fill_token(jsmntok_t* token, const jsmntype_t type, const int start, const int end) 
-{
-  token->type = type;
-  token->start = start;
-  token->end = end;
-  token->size = 0;
-}
-
-// Fills next available token with JSON primitive.
-static int
-jsmn_parse_primitive(jsmn_parser* parser, const char* js, const size_t len, jsmntok_t* tokens, const size_t num_tokens) 
-{
-  jsmntok_t* token;
-  int start;
-
-  start = parser->pos;
-
-  for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) 
-  {
-    switch (js[parser->pos]) 
-    {
-    /* In strict mode primitive must be followed by "," or "}" or "]" */
-    case ':':
-    case '\t':
-    case '\r':
-    case '\n':
-    case ' ':
-    case ',':
-    case ']':
-    case '}':
-      goto found;
-    default:
-                   /* to quiet a warning from gcc*/
-      break;
-    }
-    if (js[parser->pos] < 32 || js[parser->pos] >= 127) 
-    {
-      parser->pos = start;
-      return JSMN_ERROR_INVAL;
-    }
-  }
-found:
-  if (tokens == NULL) 
-  {
-    parser->pos--;
-    return 0;
-  }
-  token = jsmn_alloc_token(parser, tokens, num_tokens);
-  if (token == NULL) 
-  {
-    parser->pos = start;
-    return JSMN_ERROR_NOMEM;
-  }
-  jsmn_fill_token(token, JSMN_PRIMITIVE, start, parser->pos);
-  parser->pos--;
-  return 0;
-}
-
-// fills next token with JSON string.
-static int 
-jsmn_parse_string(jsmn_parser* parser, const char* js, const size_t len, jsmntok_t* tokens, const size_t num_tokens) 
-{
-  jsmntok_t* token;
-
-  int start = parser->pos;
-  
-  /* Skip starting quote */
-  parser->pos++;
-  
-  for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) 
-  {
-    char c = js[parser->pos];
-
-    /* Quote: end of string */
-    if (c == '\"') 
-    {
-      if (tokens == NULL)
-        return 0;
-      token = jsmn_alloc_token(parser, tokens, num_tokens);
-      if (token == NULL) 
-      {
-        parser->pos = start;
-        return JSMN_ERROR_NOMEM;
-      }
-      jsmn_fill_token(token, JSMN_STRING, start + 1, parser->pos);
-      return 0;
-    }
-
-    /* Backslash: Quoted symbol expected */
-    if (c == '\\' && parser->pos + 1 < len) 
-    {
-      int i;
-      parser->pos++;
-      switch (js[parser->pos]) 
-      {
-      /* Allowed escaped symbols */
-      case '\"':
-      case '/':
-      case '\\':
-      case 'b':
-      case 'f':
-      case 'r':
-      case 'n':
-      case 't':
-        break;
-      /* Allows escaped symbol \uXXXX */
-      case 'u':
-        parser->pos++;
-        for (i = 0; i < 4 && parser->pos < len && js[parser->pos] != '\0'; i++) 
-        {
-          /* If it isn't a hex character we have an error */
-          if (!((js[parser->pos] >= 48 && js[parser->pos] <= 57) ||   /* 0-9 */
-                (js[parser->pos] >= 65 && js[parser->pos] <= 70) ||   /* A-F */
-                (js[parser->pos] >= 97 && js[parser->pos] <= 102)))   /* a-f */
-            {
-            parser->pos = start;
-            return JSMN_ERROR_INVAL;
-          }
-          parser->pos++;
-        }
-        parser->pos--;
-        break;
-      /* Unexpected symbol */
-      default:
-        parser->pos = start;
-        return JSMN_ERROR_INVAL;
-      }
-    }
-  }
-  parser->pos = start;
-  return JSMN_ERROR_PART;
-}
-
-JSMN_API int
-jsmn_parse(jsmn_parser* parser, const char* js, const size_t len, jsmntok_t* tokens, const unsigned int num_tokens) 
-{
-  int r;
-  int i;
-  jsmntok_t* token;
-  int count = parser->toknext;
-
-  for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) 
-  {
-    char c;
-    jsmntype_t type;
-
-    c = js[parser->pos];
-    switch (c) 
-    {
-    case '{':
-    case '[':
-      count++;
-      if (tokens == NULL)
-        break;
-      token = jsmn_alloc_token(parser, tokens, num_tokens);
-      if (token == NULL)
-        return JSMN_ERROR_NOMEM;
-      if (parser->toksuper != -1) 
-      {
-        jsmntok_t *t = &tokens[parser->toksuper];
-        t->size++;
-      }
-      token->type = (c == '{' ? JSMN_OBJECT : JSMN_ARRAY);
-      token->start = parser->pos;
-      parser->toksuper = parser->toknext - 1;
-      break;
-    case '}':
-    case ']':
-      if (tokens == NULL)
-        break;
-      type = (c == '}' ? JSMN_OBJECT : JSMN_ARRAY);
-      for (i = parser->toknext - 1; i >= 0; i--) 
-      {
-        token = &tokens[i];
-        if (token->start != -1 && token->end == -1) 
-        {
-          if (token->type != type)
-            return JSMN_ERROR_INVAL;
-          parser->toksuper = -1;
-          token->end = parser->pos + 1;
-          break;
-        }
-      }
-      /* Error if unmatched closing bracket */
-      if (i == -1)
-        return JSMN_ERROR_INVAL;
-      for (; i >= 0; i--) 
-      {
-        token = &tokens[i];
-        if (token->start != -1 && token->end == -1) 
-        {
-          parser->toksuper = i;
-          break;
-        }
-      }
-      break;
-    case '\"':
-      r = jsmn_parse_string(parser, js, len, tokens, num_tokens);
-      if (r < 0)
-        return r;
-      count++;
-      if (parser->toksuper != -1 && tokens != NULL)
-        tokens[parser->toksuper].size++;
-      break;
-    case '\t':
-    case '\r':
-    case '\n':
-    case ' ':
-      break;
-    case ':':
-      parser->toksuper = parser->toknext - 1;
-      break;
-    case ',':
-      if (tokens != NULL && parser->toksuper != -1 &&
-          tokens[parser->toksuper].type != JSMN_ARRAY &&
-          tokens[parser->toksuper].type != JSMN_OBJECT) 
-        {
-            for (i = parser->toknext - 1; i >= 0; i--) 
-            {
-            if (tokens[i].type == JSMN_ARRAY || tokens[i].type == JSMN_OBJECT) 
-            {
-                if (tokens[i].start != -1 && tokens[i].end == -1) 
-                {
-                parser->toksuper = i;
-                break;
-                }
-            }
-            }
-        }
-      break;
-
-    /* In non-strict mode every unquoted value is a primitive */
-    default:
-      r = jsmn_parse_primitive(parser, js, len, tokens, num_tokens);
-      if (r < 0)
-        return r;
-      count++;
-      if (parser->toksuper != -1 && tokens != NULL)
-        tokens[parser->toksuper].size++;
-      break;
-    }
-  }
-
-  if (tokens != NULL) 
-  {
-    for (i = parser->toknext - 1; i >= 0; i--) {
-      /* Unmatched opened object or array */
-      if (tokens[i].start != -1 && tokens[i].end == -1)
-        return JSMN_ERROR_PART;
-    }
-  }
+    const uint32_t* puBase; // start of plBin buffer (NULL if missing)
+    uint32_t        uRef;   // tagged reference
+} plJsonBinValue;
 
-  return count;
-}
+// the details of the following structure don't matter to you, but it must
+// be visible so you can handle the memory allocation for it
 
-JSMN_API void
-jsmn_init(jsmn_parser* parser)
+typedef struct _plJsonWriter
 {
-  parser->pos = 0;
-  parser->toknext = 0;
-  parser->toksuper = -1;
-}
-
-#endif /* JSMN_HEADER */
-
-#ifdef __cplusplus
-}
-#endif
+    plJsonWriterDesc tDesc;
+    uint32_t         uCursor;
+    uint32_t         uDepth;
+    bool             bFirst;       // no members written yet in current container
+    bool             bAfterKey;    // key written, waiting for value
+    bool             bRootWritten;
+    bool             bError;
+    uint64_t         auObjectBits[(PL_JSON_MAX_DEPTH + 63) / 64]; // container kind per depth (1 = object)
+} plJsonWriter;
 
-#endif /* JSMN_H */
+#endif //PL_JSON_H
 
-#endif
+#ifdef PL_JSON_IMPLEMENTATION
 
 //-----------------------------------------------------------------------------
 // [SECTION] c file
@@ -526,6 +282,11 @@ Index of this file:
 // [SECTION] stretchy buffer
 // [SECTION] internal api
 // [SECTION] public api implementation
+// [SECTION] number conversion
+// [SECTION] streaming writer
+// [SECTION] binary format
+// [SECTION] stage 1 (structural index)
+// [SECTION] stage 2 (tape)
 // [SECTION] internal api implementation
 */
 
@@ -536,6 +297,7 @@ Index of this file:
 #include <string.h> // memset
 #include <float.h>  // FLT_MAX
 #include <stdio.h>  // sprintf
+#include <stdlib.h> // strtod, strtof
 
 //-----------------------------------------------------------------------------
 // [SECTION] defines
@@ -560,23 +322,52 @@ Index of this file:
     #define PL_JSON_FREE(x)  free((x))
 #endif
 
-#ifndef PL_JSON_MAX_NAME_LENGTH
-    #define PL_JSON_MAX_NAME_LENGTH 256
+#ifndef PL_JSON_MEMBER_INDEX_THRESHOLD
+    #define PL_JSON_MEMBER_INDEX_THRESHOLD 16 // objects with more members build a hashed index on first lookup
+#endif
+
+// plBin
+#define PL_JSON_BIN_MAGIC             0x4E42504C // "PLBN"
+#define PL_JSON_BIN_VERSION           1
+#define PL_JSON_BIN_HEADER_WORDS      4
+#define PL_JSON_BIN_MAX_WORDS         (1u << 29)  // references hold a 29 bit word offset (2 GiB)
+#define PL_JSON_BIN_INLINE_INT_LIMIT  (1 << 28)   // integers in [-2^28, 2^28) are stored in the reference
+
+// stage 1 uses SSE2 when available (define PL_JSON_NO_SIMD to force the scalar path)
+#if !defined(PL_JSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PL_JSON_SSE2
+    #include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+    static inline uint32_t pl__json_ctz64(uint64_t uValue) { unsigned long ulIndex = 0; _BitScanForward64(&ulIndex, uValue); return (uint32_t)ulIndex; }
+#else
+    static inline uint32_t pl__json_ctz64(uint64_t uValue) { return (uint32_t)__builtin_ctzll(uValue); }
 #endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal types
 //-----------------------------------------------------------------------------
 
+enum _plJsonObjectFlags
+{
+    PL_JSON_OBJECT_FLAGS_NONE            = 0,
+    PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN = 1 << 0, // sbtChildren is a slice of the document node pool
+    PL_JSON_OBJECT_FLAGS_POOLED_VALUES   = 1 << 1, // sbuValueOffsets/sbuValueLength are slices of the document value pool
+};
+
 typedef struct _plJsonObject
 {
     plJsonType    tType;
     uint32_t      uChildCount;
     plJsonObject* ptRootObject;
-    char          acName[PL_JSON_MAX_NAME_LENGTH]; 
+    uint32_t      uNameOffset; // offset into document buffer
+    uint32_t      uNameLength;
     plJsonObject* sbtChildren;
-    uint32_t      uChildrenFound;
-    char*         sbcBuffer;
+    uint32_t*     auMemberIndex; // lazily built (open addressing, child index + 1)
+    uint32_t      uMemberIndexMask;
+    uint32_t      uFlags;
 
     union
     {
@@ -590,11 +381,74 @@ typedef struct _plJsonObject
         {
             uint32_t    uValueOffset;
             uint32_t    uValueLength;
-        };    
+        };
     };
-    
+
 } plJsonObject;
 
+// stage 1 character classes for a 64 byte block (bit i -> byte i)
+typedef struct _plJsonBlock
+{
+    uint64_t uBackslash;
+    uint64_t uQuote;
+    uint64_t uStructural; // { } [ ] : ,
+    uint64_t uWhitespace;
+    uint64_t uControl;    // < 0x20
+    uint64_t uNonAscii;
+} plJsonBlock;
+
+// stage 2 output (one per value or key)
+typedef struct _plJsonToken
+{
+    plJsonType tType;
+    uint32_t   uStart; // first character (strings exclude quotes)
+    uint32_t   uEnd;   // one past the last character
+    uint32_t   uSize;  // members (objects) or elements (arrays)
+} plJsonToken;
+
+enum _plJsonParseState
+{
+    PL_JSON_PARSE_STATE_VALUE,
+    PL_JSON_PARSE_STATE_OBJECT_FIRST,
+    PL_JSON_PARSE_STATE_OBJECT_KEY,
+    PL_JSON_PARSE_STATE_OBJECT_COLON,
+    PL_JSON_PARSE_STATE_OBJECT_NEXT,
+    PL_JSON_PARSE_STATE_ARRAY_FIRST,
+    PL_JSON_PARSE_STATE_ARRAY_NEXT,
+    PL_JSON_PARSE_STATE_DONE
+};
+
+// plBin reference tags (low 3 bits)
+enum _plJsonBinTag
+{
+    PL_JSON_BIN_TAG_SPECIAL, // payload: 0 null, 1 false, 2 true
+    PL_JSON_BIN_TAG_INT,     // payload: 29 bit signed integer
+    PL_JSON_BIN_TAG_INT64,
+    PL_JSON_BIN_TAG_DOUBLE,
+    PL_JSON_BIN_TAG_STRING,
+    PL_JSON_BIN_TAG_NUMBER,  // number that keeps its text
+    PL_JSON_BIN_TAG_ARRAY,
+    PL_JSON_BIN_TAG_OBJECT
+};
+
+typedef struct _plJsonBinEncoder
+{
+    uint32_t* sbuWords;
+    uint32_t* auStringIndex; // open addressing (string record offset, 0 = empty)
+    uint32_t  uStringIndexMask;
+    uint32_t  uStringCount;
+    bool      bOverflow;
+} plJsonBinEncoder;
+
+// root objects are always allocated as documents
+typedef struct _plJsonDocument
+{
+    plJsonObject  tRoot; // must be first
+    char*         sbcBuffer; // copy of source text (strings terminated in place) + written names/values
+    plJsonObject* sbtNodes;  // node pool for loaded documents
+    uint32_t*     sbuValues; // array value offset/length pool for loaded documents
+} plJsonDocument;
+
 //-----------------------------------------------------------------------------
 // [SECTION] stretchy buffer
 //-----------------------------------------------------------------------------
@@ -631,9 +485,6 @@ typedef struct _plJsonObject
 #define pl_sb_json_add_n(buf, n) \
     (pl__sb_json_may_grow((buf), sizeof(*(buf)), (n), (n)), (n) ? (pl__sb_json_header(buf)->uSize += (n), pl__sb_json_header(buf)->uSize - (n)) : pl_sb_json_size(buf))
 
-#define pl_sb_json_sprintf(buf, pcFormat, ...) \
-    pl__sb_json_sprintf(&(buf), (pcFormat), __VA_ARGS__)
-
 #define pl__sb_json_header(buf) ((plSbJsonHeader_*)(((char*)(buf)) - sizeof(plSbJsonHeader_)))
 #define pl__sb_json_may_grow(buf, s, n, m) pl__sb_json_may_grow_((void**)&(buf), (s), (n), (m))
 
@@ -685,34 +536,34 @@ pl__sb_json_may_grow_(void** pBuffer, size_t szElementSize, size_t szNewItems, s
     }     
 }
 
-static void
-pl__sb_json_vsprintf(char** ppcBuffer, const char* pcFormat, va_list args)
-{
-    va_list args2;
-    va_copy(args2, args);
-    int32_t n = vsnprintf(NULL, 0, pcFormat, args2);
-    va_end(args2);
-    uint32_t an = pl_sb_json_size(*ppcBuffer);
-    pl_sb_json_resize(*ppcBuffer, an + n + 1);
-    vsnprintf(*ppcBuffer + an, n + 1, pcFormat, args);
-}
-
-static void
-pl__sb_json_sprintf(char** ppcBuffer, const char* pcFormat, ...)
-{
-    va_list args;
-    va_start(args, pcFormat);
-    pl__sb_json_vsprintf(ppcBuffer, pcFormat, args);
-    va_end(args);
-}
 
 //-----------------------------------------------------------------------------
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
 
-static plJsonType pl__get_json_token_object_type(const char* pcJson, jsmntok_t*);
-static void       pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSize, uint32_t* puCursor, uint32_t* puDepth);
-static void       pl__check_json_object(plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* puCursor, uint32_t* puDepth);
+static inline plJsonDocument* pl__json_document(plJsonObject* ptJson) { return (plJsonDocument*)ptJson->ptRootObject; }
+
+static bool          pl__json_structural_index    (const char* pcJson, uint32_t uLength, uint32_t** psbuIndexOut);
+static bool          pl__json_build_tape          (const char* pcJson, uint32_t uLength, const uint32_t* auIndex, uint32_t uIndexCount, plJsonToken* atTape, uint32_t* puTokenCountOut);
+static uint32_t      pl__build_json_object        (plJsonDocument*, plJsonToken* atTape, uint32_t uToken, plJsonObject*, uint32_t* puNodeCursor, uint32_t* puValueCursor);
+static void          pl__free_json                (plJsonObject*);
+static plJsonObject* pl__json_add_child           (plJsonObject*, const char* pcName, plJsonType);
+static uint32_t      pl__json_push_text           (plJsonObject*, const char* pcText, uint32_t uLength, bool bQuoted);
+static uint32_t      pl__json_push_number         (plJsonObject*, const char* pcText, uint32_t uLength, uint32_t* puLengthOut);
+static uint32_t      pl__json_format_uint64       (uint64_t, char* pcBuffer);
+static uint32_t      pl__json_format_int64        (int64_t, char* pcBuffer);
+static uint32_t      pl__json_format_real         (double, bool bSinglePrecision, char* pcBuffer);
+static double        pl__json_to_double           (const char* pcText, uint32_t uLength);
+static float         pl__json_to_float            (const char* pcText, uint32_t uLength);
+static int64_t       pl__json_to_int64            (const char* pcText, uint32_t uLength);
+static int64_t       pl__json_double_to_int64     (double dValue);
+static uint32_t      pl__json_hash                (const char* pcText, uint32_t uLength);
+static void          pl__build_json_member_index  (plJsonObject*);
+static uint32_t      pl__json_bin_encode          (plJsonBinEncoder*, plJsonObject*);
+static bool          pl__json_bin_check           (const uint32_t* puBase, uint32_t uWordCount, uint32_t uRef, uint32_t uDepth, uint32_t* puNodeCount, uint32_t* puValueCount);
+static void          pl__json_bin_build           (plJsonDocument*, const uint32_t* puBase, uint32_t uRef, plJsonObject*, uint32_t* puNodeCursor, uint32_t* puValueCursor);
+static void          pl__write_json_object        (plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSize, uint32_t* puCursor, uint32_t* puDepth);
+static void          pl__check_json_object        (plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* puCursor, uint32_t* puDepth);
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
@@ -721,284 +572,112 @@ static void       pl__check_json_object(plJsonObject* ptJson, uint32_t* puBuffer
 plJsonObject*
 pl_json_new_root_object(const char* pcName)
 {
-    plJsonObject* ptJson = PL_JSON_ALLOC(sizeof(plJsonObject));
-    memset(ptJson, 0, sizeof(plJsonObject));
+    plJsonDocument* ptDocument = PL_JSON_ALLOC(sizeof(plJsonDocument));
+    memset(ptDocument, 0, sizeof(plJsonDocument));
+    plJsonObject* ptJson = &ptDocument->tRoot;
     ptJson->tType = PL_JSON_TYPE_OBJECT;
     ptJson->ptRootObject = ptJson;
-    strncpy(ptJson->acName, pcName, 256);
+    ptJson->uNameLength = (uint32_t)strlen(pcName);
+    ptJson->uNameOffset = pl__json_push_text(ptJson, pcName, ptJson->uNameLength, false);
     return ptJson;
 }
 
 bool
 pl_load_json(const char* pcJson, plJsonObject** pptJsonOut)
 {
-    jsmn_parser tP = {0};
-    jsmntok_t* sbtTokens = NULL;
-    pl_sb_json_resize(sbtTokens, 512);
+    return pl_parse_json(pcJson, strlen(pcJson), pptJsonOut);
+}
 
-    jsmn_init(&tP);
+bool
+pl_parse_json(const char* pcJson, size_t szLength, plJsonObject** pptJsonOut)
+{
+    *pptJsonOut = NULL;
 
-    int iResult = 0;
-    while(true)
-    {
-        iResult = jsmn_parse(&tP, pcJson, strlen(pcJson), sbtTokens, pl_sb_json_size(sbtTokens));
+    // offsets are 32 bit
+    if(szLength >= UINT32_MAX)
+        return false;
+    const uint32_t uLength = (uint32_t)szLength;
 
-        if(iResult == JSMN_ERROR_INVAL)
-        {
-            pl_sb_json_free(sbtTokens);
-            PL_ASSERT(false);
-            return false;
-            
-        }
-        else if(iResult == JSMN_ERROR_NOMEM)
-        {
-            pl_sb_json_add_n(sbtTokens, 256);
-        }
-        else if(iResult == JSMN_ERROR_PART)
-        {
-            pl_sb_json_free(sbtTokens);
-            PL_ASSERT(false);
-            return false;
-        }
-        else
-        {
-            break;
-        }
+    // stage 1: positions of structural characters, quotes, & scalar starts
+    uint32_t* sbuIndex = NULL;
+    if(!pl__json_structural_index(pcJson, uLength, &sbuIndex))
+    {
+        pl_sb_json_free(sbuIndex);
+        return false;
     }
 
-    uint32_t uLayer = 0;
-    uint32_t uCurrentTokenIndex = 0;
-    plJsonObject** sbtObjectStack = NULL;
-    *pptJsonOut = PL_JSON_ALLOC(sizeof(plJsonObject));
-    memset(*pptJsonOut, 0, sizeof(plJsonObject));
-    plJsonObject* ptJsonOut = *pptJsonOut;
-    ptJsonOut->ptRootObject = ptJsonOut;
-    ptJsonOut->tType = PL_JSON_TYPE_OBJECT;
-    pl_sb_json_reserve(ptJsonOut->sbcBuffer, strlen(pcJson));
-    ptJsonOut->uChildCount = sbtTokens[uCurrentTokenIndex].size;
-    strcpy(ptJsonOut->acName, "ROOT");
-    pl_sb_json_reserve(ptJsonOut->sbtChildren, sbtTokens[uCurrentTokenIndex].size);
-    pl_sb_json_push(sbtObjectStack, ptJsonOut);
-    while(uCurrentTokenIndex < (uint32_t)iResult)
+    // stage 2: validate grammar & produce tape (never more tokens than indices)
+    const uint32_t uIndexCount = pl_sb_json_size(sbuIndex);
+    plJsonToken* sbtTape = NULL;
+    pl_sb_json_resize(sbtTape, uIndexCount);
+    uint32_t uTokenCount = 0;
+    const bool bResult = pl__json_build_tape(pcJson, uLength, sbuIndex, uIndexCount, sbtTape, &uTokenCount);
+    pl_sb_json_free(sbuIndex);
+    if(!bResult)
     {
+        pl_sb_json_free(sbtTape);
+        return false;
+    }
 
-        if(pl_sb_json_top(sbtObjectStack)->uChildrenFound == pl_sb_json_top(sbtObjectStack)->uChildCount)
-            pl_sb_json_pop(sbtObjectStack);
-        else
-        {
-            
-            plJsonObject* ptParentObject = pl_sb_json_top(sbtObjectStack);
-
-            jsmntok_t* ptCurrentToken = &sbtTokens[uCurrentTokenIndex];
-            jsmntok_t* ptNextToken = &sbtTokens[uCurrentTokenIndex + 1];
-
-            switch (ptCurrentToken->type)
-            {
-
-            // value
-            case JSMN_PRIMITIVE:
-                if(ptParentObject->tType == PL_JSON_TYPE_ARRAY)
-                {
-                    const uint32_t uBufferLocation = pl_sb_json_size(ptJsonOut->sbcBuffer);
-                    pl_sb_json_resize(ptJsonOut->sbcBuffer, uBufferLocation + ptCurrentToken->end - ptCurrentToken->start + 1);
-                    memcpy(&ptJsonOut->sbcBuffer[uBufferLocation], &pcJson[ptCurrentToken->start], ptCurrentToken->end - ptCurrentToken->start);
-                    pl_sb_json_push(ptParentObject->sbuValueOffsets, uBufferLocation);
-                    pl_sb_json_push(ptParentObject->sbuValueLength, ptCurrentToken->end - ptCurrentToken->start);
-                    ptParentObject->uChildrenFound++;
-                }
-                else
-                {
-                    const uint32_t uBufferLocation = pl_sb_json_size(ptJsonOut->sbcBuffer);
-                    pl_sb_json_resize(ptJsonOut->sbcBuffer, uBufferLocation + ptCurrentToken->end - ptCurrentToken->start + 1);
-                    memcpy(&ptJsonOut->sbcBuffer[uBufferLocation], &pcJson[ptCurrentToken->start], ptCurrentToken->end - ptCurrentToken->start);
-                    ptParentObject->uValueOffset = uBufferLocation;
-                    ptParentObject->uValueLength = ptCurrentToken->end - ptCurrentToken->start;
-                    ptParentObject->uChildrenFound++;
-                    pl_sb_json_pop(sbtObjectStack);
-                }
-                break;
-
-            case JSMN_STRING:
-            {
-                // value
-                if(ptCurrentToken->size == 0)
-                {
-                    if(ptParentObject->tType == PL_JSON_TYPE_ARRAY)
-                    {
-                        const uint32_t uBufferLocation = pl_sb_json_size(ptJsonOut->sbcBuffer);
-                        pl_sb_json_resize(ptJsonOut->sbcBuffer, uBufferLocation + ptCurrentToken->end - ptCurrentToken->start + 1);
-                        memcpy(&ptJsonOut->sbcBuffer[uBufferLocation], &pcJson[ptCurrentToken->start], ptCurrentToken->end - ptCurrentToken->start);
-                        pl_sb_json_push(ptParentObject->sbuValueOffsets, uBufferLocation);
-                        pl_sb_json_push(ptParentObject->sbuValueLength, ptCurrentToken->end - ptCurrentToken->start);
-                        ptParentObject->uChildrenFound++;
-                    }
-                    else
-                    {
-                        const uint32_t uBufferLocation = pl_sb_json_size(ptJsonOut->sbcBuffer);
-                        pl_sb_json_resize(ptJsonOut->sbcBuffer, uBufferLocation + ptCurrentToken->end - ptCurrentToken->start + 1);
-                        memcpy(&ptJsonOut->sbcBuffer[uBufferLocation], &pcJson[ptCurrentToken->start], ptCurrentToken->end - ptCurrentToken->start);
-                        ptParentObject->uValueOffset = uBufferLocation;
-                        ptParentObject->uValueLength = ptCurrentToken->end - ptCurrentToken->start;
-                        ptParentObject->uChildrenFound++;
-                        pl_sb_json_pop(sbtObjectStack);
-                    }
-                }
-
-                // key
-                else
-                {
-                    plJsonObject tNewJsonObject = {
-                        pl__get_json_token_object_type(pcJson, ptNextToken),
-                        (uint32_t)ptNextToken->size
-                    };
-                    tNewJsonObject.ptRootObject = ptJsonOut;
-                    if(tNewJsonObject.uChildCount == 0)
-                    {
-                        tNewJsonObject.uChildrenFound--;
-                    }
-                    ptParentObject->uChildrenFound++;
-                    strncpy(tNewJsonObject.acName, &pcJson[ptCurrentToken->start], ptCurrentToken->end - ptCurrentToken->start);
-                    pl_sb_json_push(ptParentObject->sbtChildren, tNewJsonObject);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbtChildren, ptNextToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueOffsets, ptNextToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueLength, ptNextToken->size);
-                    pl_sb_json_push(sbtObjectStack, &pl_sb_json_top(ptParentObject->sbtChildren));
-
-                    if(tNewJsonObject.tType == PL_JSON_TYPE_ARRAY)
-                    {
-                        uCurrentTokenIndex++;
-                    }
-                }
-                break;
-            }
+    plJsonDocument* ptDocument = PL_JSON_ALLOC(sizeof(plJsonDocument));
+    memset(ptDocument, 0, sizeof(plJsonDocument));
+    plJsonObject* ptJsonOut = &ptDocument->tRoot;
+    ptJsonOut->ptRootObject = ptJsonOut;
 
-            case JSMN_OBJECT:
-            {
-                if(ptParentObject->tType == PL_JSON_TYPE_ARRAY)
-                {
-                    plJsonObject tNewJsonObject = {
-                        pl__get_json_token_object_type(pcJson, ptCurrentToken),
-                        (uint32_t)ptCurrentToken->size
-                    };
-                    tNewJsonObject.ptRootObject = ptJsonOut;
-                    strcpy(tNewJsonObject.acName, "UNNAMED OBJECT");
-                    pl_sb_json_push(ptParentObject->sbtChildren, tNewJsonObject);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbtChildren, ptCurrentToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueOffsets, ptCurrentToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueLength, ptCurrentToken->size);
-                    pl_sb_json_push(sbtObjectStack, &pl_sb_json_top(ptParentObject->sbtChildren));
-                    ptParentObject->uChildrenFound++;
-                }
-                else if(ptParentObject->tType == PL_JSON_TYPE_OBJECT)
-                {
-                    // combining key/pair
-                    // ptParentObject->uChildrenFound++;
-                }
-                else
-                {                
-                    pl_sb_json_free(sbtTokens);
-                    PL_ASSERT(false); // shouldn't be possible
-                    return false;
-                }
-                break;
-            }
+    // single copy of the source, names & values are offsets into it
+    pl_sb_json_resize(ptDocument->sbcBuffer, uLength + 1);
+    memcpy(ptDocument->sbcBuffer, pcJson, uLength);
+    ptDocument->sbcBuffer[uLength] = 0;
+    ptJsonOut->uNameLength = 4;
+    ptJsonOut->uNameOffset = pl__json_push_text(ptJsonOut, "ROOT", 4, false);
 
-            case JSMN_ARRAY:
-            {
-                if(ptParentObject->tType == PL_JSON_TYPE_ARRAY)
-                {
-                    plJsonObject tNewJsonObject = {
-                        pl__get_json_token_object_type(pcJson, ptCurrentToken),
-                        (uint32_t)ptCurrentToken->size
-                    };
-                    tNewJsonObject.ptRootObject = ptJsonOut;
-                    strcpy(tNewJsonObject.acName, "UNNAMED ARRAY");
-                    pl_sb_json_push(ptParentObject->sbtChildren, tNewJsonObject);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbtChildren, ptCurrentToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueOffsets, ptCurrentToken->size);
-                    pl_sb_json_reserve(pl_sb_json_top(ptParentObject->sbtChildren).sbuValueLength, ptCurrentToken->size);
-                    pl_sb_json_push(sbtObjectStack, &pl_sb_json_top(ptParentObject->sbtChildren));
-                    ptParentObject->uChildrenFound++;
-                }
-                else if(ptParentObject->tType == PL_JSON_TYPE_STRING)
-                {
-                    // combining key/pair
-                }
-                else
-                {
-                    pl_sb_json_free(sbtTokens);
-                    PL_ASSERT(false); // shouldn't be possible
-                    return false;
-                }
-                break;
-            }
-            
-            default:
-                break;
-            }
+    // every node (other than the root) & array value maps to at most one token
+    pl_sb_json_resize(ptDocument->sbtNodes, uTokenCount);
+    pl_sb_json_resize(ptDocument->sbuValues, uTokenCount * 2);
 
-            uCurrentTokenIndex++;
-        }
-    }
+    uint32_t uNodeCursor = 0;
+    uint32_t uValueCursor = 0;
+    pl__build_json_object(ptDocument, sbtTape, 0, ptJsonOut, &uNodeCursor, &uValueCursor);
 
-    pl_sb_json_free(sbtTokens);
+    pl_sb_json_free(sbtTape);
+    *pptJsonOut = ptJsonOut;
     return true;
 }
 
-static void
-pl__free_json(plJsonObject* ptJson)
+bool
+pl_parse_json_ndjson(const char* pcJson, size_t szLength, size_t* pszCursor, plJsonObject** pptJsonOut)
 {
-    for(uint32_t i = 0; i < pl_sb_json_size(ptJson->sbtChildren); i++)
-        pl__free_json(&ptJson->sbtChildren[i]);
+    *pptJsonOut = NULL;
 
-    if(ptJson->tType == PL_JSON_TYPE_ARRAY)
-    {
-        pl_sb_json_free(ptJson->sbuValueOffsets);
-        pl_sb_json_free(ptJson->sbtChildren);
-        pl_sb_json_free(ptJson->sbuValueLength);
-    }
-    else
-    {
-        ptJson->uValueOffset = 0;
-        ptJson->uValueLength = 0;
-    }
+    // skip blank lines
+    size_t szStart = *pszCursor;
+    while(szStart < szLength && (pcJson[szStart] == ' ' || pcJson[szStart] == '\t' || pcJson[szStart] == '\r' || pcJson[szStart] == '\n'))
+        szStart++;
+    *pszCursor = szStart;
+
+    if(szStart >= szLength)
+        return false;
 
-    ptJson->uChildCount = 0;
-    ptJson->uChildrenFound = 0;
+    // raw newlines can't appear inside json strings so the line is the document
+    const char* pcNewLine = memchr(&pcJson[szStart], '\n', szLength - szStart);
+    const size_t szEnd = pcNewLine ? (size_t)(pcNewLine - pcJson) : szLength;
 
-    pl_sb_json_free(ptJson->sbcBuffer);
+    if(!pl_parse_json(&pcJson[szStart], szEnd - szStart, pptJsonOut))
+        return false;
 
-    memset(ptJson->acName, 0, PL_JSON_MAX_NAME_LENGTH);
-    ptJson->tType = PL_JSON_TYPE_UNSPECIFIED;
+    *pszCursor = pcNewLine ? szEnd + 1 : szEnd;
+    return true;
 }
 
 void
 pl_unload_json(plJsonObject** pptJson)
 {
-    plJsonObject* ptJson = *pptJson;
-    for(uint32_t i = 0; i < pl_sb_json_size(ptJson->sbtChildren); i++)
-        pl__free_json(&ptJson->sbtChildren[i]);
-
-    if(ptJson->tType == PL_JSON_TYPE_ARRAY)
-    {
-        pl_sb_json_free(ptJson->sbuValueOffsets);
-        pl_sb_json_free(ptJson->sbtChildren);
-        pl_sb_json_free(ptJson->sbuValueLength);
-    }
-    else
-    {
-        ptJson->uValueOffset = 0;
-        ptJson->uValueLength = 0;
-    }
-
-    ptJson->uChildCount = 0;
-    ptJson->uChildrenFound = 0;
-
-    pl_sb_json_free(ptJson->sbcBuffer);
-
-    memset(ptJson->acName, 0, PL_JSON_MAX_NAME_LENGTH);
-    ptJson->tType = PL_JSON_TYPE_UNSPECIFIED;
-    PL_JSON_FREE(ptJson);
+    plJsonDocument* ptDocument = pl__json_document(*pptJson);
+    pl__free_json(&ptDocument->tRoot);
+    pl_sb_json_free(ptDocument->sbcBuffer);
+    pl_sb_json_free(ptDocument->sbtNodes);
+    pl_sb_json_free(ptDocument->sbuValues);
+    PL_JSON_FREE(ptDocument);
     *pptJson = NULL;
 }
 
@@ -1018,11 +697,33 @@ pl_write_json(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSize)
 plJsonObject*
 pl_json_member_by_name(plJsonObject* ptJson, const char* pcName)
 {
+    if(ptJson->sbtChildren == NULL)
+        return NULL;
+
+    const char* pcBuffer = pl__json_document(ptJson)->sbcBuffer;
+    const uint32_t uLength = (uint32_t)strlen(pcName);
+
+    if(ptJson->tType == PL_JSON_TYPE_OBJECT && ptJson->uChildCount > PL_JSON_MEMBER_INDEX_THRESHOLD)
+    {
+        if(ptJson->auMemberIndex == NULL)
+            pl__build_json_member_index(ptJson);
+
+        uint32_t uSlot = pl__json_hash(pcName, uLength) & ptJson->uMemberIndexMask;
+        while(ptJson->auMemberIndex[uSlot])
+        {
+            plJsonObject* ptMember = &ptJson->sbtChildren[ptJson->auMemberIndex[uSlot] - 1];
+            if(ptMember->uNameLength == uLength && memcmp(pcName, &pcBuffer[ptMember->uNameOffset], uLength) == 0)
+                return ptMember;
+            uSlot = (uSlot + 1) & ptJson->uMemberIndexMask;
+        }
+        return NULL;
+    }
 
     for(uint32_t i = 0; i < ptJson->uChildCount; i++)
     {
-        if(strncmp(pcName, ptJson->sbtChildren[i].acName, strlen(ptJson->sbtChildren[i].acName)) == 0)
-            return &ptJson->sbtChildren[i];
+        plJsonObject* ptMember = &ptJson->sbtChildren[i];
+        if(ptMember->uNameLength == uLength && memcmp(pcName, &pcBuffer[ptMember->uNameOffset], uLength) == 0)
+            return ptMember;
     }
 
     return NULL;
@@ -1031,7 +732,7 @@ pl_json_member_by_name(plJsonObject* ptJson, const char* pcName)
 plJsonObject*
 pl_json_member_by_index(plJsonObject* ptJson, uint32_t uIndex)
 {
-    if(uIndex < ptJson->uChildCount)
+    if(uIndex < ptJson->uChildCount && ptJson->sbtChildren)
         return &ptJson->sbtChildren[uIndex];
     return NULL;
 }
@@ -1039,22 +740,27 @@ pl_json_member_by_index(plJsonObject* ptJson, uint32_t uIndex)
 void
 pl_json_member_list(plJsonObject* ptJson, char** ppcListOut, uint32_t* puSizeOut, uint32_t* puLength)
 {
+    const char* pcBuffer = pl__json_document(ptJson)->sbcBuffer;
+    const uint32_t uMemberCount = ptJson->sbtChildren ? ptJson->uChildCount : 0;
+
     if(ppcListOut)
     {
-        for(uint32_t i = 0; i < pl_sb_json_size(ptJson->sbtChildren); i++)
-            strcpy(ppcListOut[i], ptJson->sbtChildren[i].acName);
+        for(uint32_t i = 0; i < uMemberCount; i++)
+        {
+            memcpy(ppcListOut[i], &pcBuffer[ptJson->sbtChildren[i].uNameOffset], ptJson->sbtChildren[i].uNameLength);
+            ppcListOut[i][ptJson->sbtChildren[i].uNameLength] = 0;
+        }
     }
 
     if(puSizeOut)
-        *puSizeOut = pl_sb_json_size(ptJson->sbtChildren);
+        *puSizeOut = uMemberCount;
 
     if(puLength)
     {
-        for(uint32_t i = 0; i < pl_sb_json_size(ptJson->sbtChildren); i++)
+        for(uint32_t i = 0; i < uMemberCount; i++)
         {
-            const uint32_t uLength = (uint32_t)strlen(ptJson->sbtChildren[i].acName);
-            if(uLength > *puLength) *puLength = uLength;
-        }  
+            if(ptJson->sbtChildren[i].uNameLength > *puLength) *puLength = ptJson->sbtChildren[i].uNameLength;
+        }
     }
 }
 
@@ -1121,7 +827,7 @@ pl_json_string_member(plJsonObject* ptJson, const char* pcName, char* pcDefaultV
         if(uLength < ptMember->uValueLength)
             return NULL;
         memset(pcDefaultValue, 0, uLength);
-        strncpy(pcDefaultValue, &ptMember->ptRootObject->sbcBuffer[ptMember->uValueOffset], ptMember->uValueLength);
+        strncpy(pcDefaultValue, &pl__json_document(ptMember)->sbcBuffer[ptMember->uValueOffset], ptMember->uValueLength);
     }
     return pcDefaultValue;
 }
@@ -1229,7 +935,7 @@ pl_json_as_int(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_NUMBER);
     if(ptJson->tType == PL_JSON_TYPE_NUMBER)
-        return (int)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset], NULL);
+        return (int)pl__json_to_int64(&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
     return 0;
 }
 
@@ -1238,7 +944,7 @@ pl_json_as_uint(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_NUMBER);
     if(ptJson->tType == PL_JSON_TYPE_NUMBER)
-        return (uint32_t)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset], NULL);
+        return (uint32_t)pl__json_to_int64(&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
     return UINT32_MAX;
 }
 
@@ -1247,7 +953,7 @@ pl_json_as_float(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_NUMBER);
     if(ptJson->tType == PL_JSON_TYPE_NUMBER)
-        return (float)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset], NULL);
+        return pl__json_to_float(&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
     return FLT_MAX;
 }
 
@@ -1256,7 +962,7 @@ pl_json_as_double(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_NUMBER);
     if(ptJson->tType == PL_JSON_TYPE_NUMBER)
-        return strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset], NULL);
+        return pl__json_to_double(&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
     return DBL_MAX;
 }
 
@@ -1265,7 +971,7 @@ pl_json_as_string(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_STRING);
     if(ptJson->tType == PL_JSON_TYPE_STRING)
-        return &ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset];
+        return &pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset];
     return NULL;
 }
 
@@ -1274,7 +980,7 @@ pl_json_as_bool(plJsonObject* ptJson)
 {
     PL_ASSERT(ptJson->tType == PL_JSON_TYPE_BOOL);
     if(ptJson->tType == PL_JSON_TYPE_BOOL)
-        return (&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset])[0] == 't';
+        return (&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset])[0] == 't';
     return false;
 }
 
@@ -1292,7 +998,7 @@ pl_json_as_int_array(plJsonObject* ptJson, int* piOut, uint32_t* puSizeOut)
     if(piOut)
     {
         for(uint32_t i = 0; i < ptJson->uChildCount; i++)
-            piOut[i] = (int)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], NULL);
+            piOut[i] = (int)pl__json_to_int64(&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
     }
 }
 
@@ -1310,7 +1016,7 @@ pl_json_as_uint_array(plJsonObject* ptJson, uint32_t* puOut, uint32_t* puSizeOut
     if(puOut)
     {
         for(uint32_t i = 0; i < ptJson->uChildCount; i++)
-            puOut[i] = (uint32_t)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], NULL);
+            puOut[i] = (uint32_t)pl__json_to_int64(&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
     }
 }
 
@@ -1328,7 +1034,7 @@ pl_json_as_float_array(plJsonObject* ptJson, float* pfOut, uint32_t* puSizeOut)
     if(pfOut)
     {
         for(uint32_t i = 0; i < ptJson->uChildCount; i++)
-            pfOut[i] = (float)strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], NULL);
+            pfOut[i] = pl__json_to_float(&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
     }
 }
 
@@ -1346,7 +1052,7 @@ pl_json_as_double_array(plJsonObject* ptJson, double* pdOut, uint32_t* puSizeOut
     if(pdOut)
     {
         for(uint32_t i = 0; i < ptJson->uChildCount; i++)
-            pdOut[i] = strtod(&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], NULL);
+            pdOut[i] = pl__json_to_double(&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
     }
 }
 
@@ -1364,7 +1070,7 @@ pl_json_as_string_array(plJsonObject* ptJson, char** pcOut, uint32_t* puSizeOut,
         {
             PL_ASSERT(*puLength >= ptJson->sbuValueLength[i]);
             memset(pcOut[i], 0, *puLength);
-            strncpy(pcOut[i],&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
+            strncpy(pcOut[i],&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
         }
     }
     else if(puSizeOut)
@@ -1394,395 +1100,1948 @@ pl_json_as_bool_array(plJsonObject* ptJson, bool* pbOut, uint32_t* puSizeOut)
     if(pbOut)
     {
         for(uint32_t i = 0; i < ptJson->uChildCount; i++)
-            pbOut[i] = (&ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]])[0] == 't';
+            pbOut[i] = (&pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]])[0] == 't';
     }
 }
 
+
 void
 pl_json_add_int_member(plJsonObject* ptJson, const char* pcName, int iValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_NUMBER;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = snprintf(NULL, 0, "%i", iValue);
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength);
-    snprintf(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], tNewJsonObject.uValueLength + 1, "%i", iValue);
-
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_NUMBER);
+    char acBuffer[32];
+    ptMember->uValueOffset = pl__json_push_number(ptJson, acBuffer, pl__json_format_int64(iValue, acBuffer), &ptMember->uValueLength);
 }
 
 void
 pl_json_add_uint_member(plJsonObject* ptJson, const char* pcName, uint32_t uValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_NUMBER;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = snprintf(NULL, 0, "%u", uValue);
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength);
-    snprintf(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], tNewJsonObject.uValueLength, "%u", uValue);
-
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_NUMBER);
+    char acBuffer[32];
+    ptMember->uValueOffset = pl__json_push_number(ptJson, acBuffer, pl__json_format_uint64(uValue, acBuffer), &ptMember->uValueLength);
 }
 
 void
 pl_json_add_float_member(plJsonObject* ptJson, const char* pcName, float fValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_NUMBER;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = snprintf(NULL, 0, "%0.7f", fValue);
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength);
-    snprintf(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], tNewJsonObject.uValueLength, "%0.7f", fValue);
-
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_NUMBER);
+    char acBuffer[32];
+    ptMember->uValueOffset = pl__json_push_number(ptJson, acBuffer, pl__json_format_real(fValue, true, acBuffer), &ptMember->uValueLength);
 }
 
 void
 pl_json_add_double_member(plJsonObject* ptJson, const char* pcName, double dValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_NUMBER;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = snprintf(NULL, 0, "%0.15f", dValue);
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength);
-    snprintf(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], tNewJsonObject.uValueLength, "%0.15f", dValue);
-
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_NUMBER);
+    char acBuffer[32];
+    ptMember->uValueOffset = pl__json_push_number(ptJson, acBuffer, pl__json_format_real(dValue, false, acBuffer), &ptMember->uValueLength);
 }
 
 void
 pl_json_add_bool_member(plJsonObject* ptJson, const char* pcName, bool bValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_BOOL;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = snprintf(NULL, 0, "%s", bValue ? "true" : "false");
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength);
-    snprintf(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], tNewJsonObject.uValueLength, bValue ? "true" : "false");
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_BOOL);
+    ptMember->uValueLength = bValue ? 4 : 5;
+    ptMember->uValueOffset = pl__json_push_text(ptJson, bValue ? "true" : "false", ptMember->uValueLength, false);
 }
 
 void
 pl_json_add_string_member(plJsonObject* ptJson, const char* pcName, const char* pcValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_STRING;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-    tNewJsonObject.uValueLength = (uint32_t)strlen(pcValue);
-    pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, tNewJsonObject.uValueOffset + tNewJsonObject.uValueLength + 1);
-    strncpy(&ptJson->ptRootObject->sbcBuffer[tNewJsonObject.uValueOffset], pcValue, tNewJsonObject.uValueLength);
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    plJsonObject* ptMember = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_STRING);
+    ptMember->uValueLength = (uint32_t)strlen(pcValue);
+    ptMember->uValueOffset = pl__json_push_text(ptJson, pcValue, ptMember->uValueLength, true);
 }
 
 plJsonObject*
 pl_json_add_member(plJsonObject* ptJson, const char* pcName)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
-
-    pl_sb_json_add_n(ptJson->sbtChildren, 1); 
-    plJsonObject* ptResult = &pl_sb_json_top(ptJson->sbtChildren);
-    memset(ptResult, 0, sizeof(plJsonObject));
-    snprintf(ptResult->acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    ptResult->tType = PL_JSON_TYPE_OBJECT;
-    ptResult->ptRootObject = ptJson->ptRootObject;
-    return ptResult;
+    return pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_OBJECT);
 }
 
 plJsonObject*
 pl_json_add_member_array(plJsonObject* ptJson, const char* pcName, uint32_t uSize)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbtChildren, uSize);
+    for(uint32_t i = 0; i < uSize; i++)
+        ptArray->sbtChildren[i].ptRootObject = ptJson->ptRootObject;
+    return ptArray;
+}
+
+void
+pl_json_add_int_array(plJsonObject* ptJson, const char* pcName, int* piValues, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    char acBuffer[32];
+    for(uint32_t i = 0; i < uSize; i++)
+        ptArray->sbuValueOffsets[i] = pl__json_push_number(ptJson, acBuffer, pl__json_format_int64(piValues[i], acBuffer), &ptArray->sbuValueLength[i]);
+}
+
+void
+pl_json_add_uint_array(plJsonObject* ptJson, const char* pcName, uint32_t* puValues, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    char acBuffer[32];
+    for(uint32_t i = 0; i < uSize; i++)
+        ptArray->sbuValueOffsets[i] = pl__json_push_number(ptJson, acBuffer, pl__json_format_uint64(puValues[i], acBuffer), &ptArray->sbuValueLength[i]);
+}
+
+void
+pl_json_add_float_array(plJsonObject* ptJson, const char* pcName, float* pfValues, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    char acBuffer[32];
+    for(uint32_t i = 0; i < uSize; i++)
+        ptArray->sbuValueOffsets[i] = pl__json_push_number(ptJson, acBuffer, pl__json_format_real(pfValues[i], true, acBuffer), &ptArray->sbuValueLength[i]);
+}
+
+void
+pl_json_add_double_array(plJsonObject* ptJson, const char* pcName, double* pdValues, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    char acBuffer[32];
+    for(uint32_t i = 0; i < uSize; i++)
+        ptArray->sbuValueOffsets[i] = pl__json_push_number(ptJson, acBuffer, pl__json_format_real(pdValues[i], false, acBuffer), &ptArray->sbuValueLength[i]);
+}
+
+void
+pl_json_add_bool_array(plJsonObject* ptJson, const char* pcName, bool* pbValues, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    for(uint32_t i = 0; i < uSize; i++)
+    {
+        ptArray->sbuValueLength[i] = pbValues[i] ? 4 : 5;
+        ptArray->sbuValueOffsets[i] = pl__json_push_text(ptJson, pbValues[i] ? "true" : "false", ptArray->sbuValueLength[i], false);
+    }
+}
+
+void
+pl_json_add_string_array(plJsonObject* ptJson, const char* pcName, char** ppcBuffer, uint32_t uSize)
+{
+    plJsonObject* ptArray = pl__json_add_child(ptJson, pcName, PL_JSON_TYPE_ARRAY);
+    ptArray->uChildCount = uSize;
+    pl_sb_json_resize(ptArray->sbuValueLength, uSize);
+    pl_sb_json_resize(ptArray->sbuValueOffsets, uSize);
+
+    for(uint32_t i = 0; i < uSize; i++)
+    {
+        ptArray->sbuValueLength[i] = (uint32_t)strlen(ppcBuffer[i]);
+        ptArray->sbuValueOffsets[i] = pl__json_push_text(ptJson, ppcBuffer[i], ptArray->sbuValueLength[i], true);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] number conversion
+//-----------------------------------------------------------------------------
+
+// pl_number.h (locale independent, correctly rounded, shortest round trip) is
+// used when it is included before the implementation, otherwise the C library
+
+static uint32_t
+pl__json_format_uint64(uint64_t uValue, char* pcBuffer) // pcBuffer >= 24
+{
+#ifdef PL_NUMBER_H
+    return pl_format_uint64(uValue, pcBuffer);
+#else
+    char acDigits[24];
+    char* pc = &acDigits[24];
+    do
+    {
+        *--pc = (char)('0' + uValue % 10);
+        uValue /= 10;
+    } while(uValue);
+    const uint32_t uLength = (uint32_t)(&acDigits[24] - pc);
+    memcpy(pcBuffer, pc, uLength);
+    pcBuffer[uLength] = 0;
+    return uLength;
+#endif
+}
+
+static uint32_t
+pl__json_format_int64(int64_t iValue, char* pcBuffer) // pcBuffer >= 24
+{
+    if(iValue >= 0)
+        return pl__json_format_uint64((uint64_t)iValue, pcBuffer);
+    pcBuffer[0] = '-';
+    return pl__json_format_uint64((uint64_t)0 - (uint64_t)iValue, &pcBuffer[1]) + 1;
+}
+
+// shortest text that parses back to the same value
+static uint32_t
+pl__json_format_real(double dValue, bool bSinglePrecision, char* pcBuffer) // pcBuffer >= 32
+{
+#ifdef PL_NUMBER_H
+    return bSinglePrecision ? pl_format_float((float)dValue, pcBuffer) : pl_format_double(dValue, pcBuffer);
+#else
+    const int iMaxPrecision = bSinglePrecision ? 9 : 17;
+    int iLength = 0;
+    for(int iPrecision = 1; iPrecision <= iMaxPrecision; iPrecision++)
+    {
+        iLength = snprintf(pcBuffer, 32, "%.*g", iPrecision, dValue);
+        const double dParsed = strtod(pcBuffer, NULL);
+        if(bSinglePrecision ? ((float)dParsed == (float)dValue) : (dParsed == dValue))
+            break;
+    }
+    return (uint32_t)iLength;
+#endif
+}
+
+static double
+pl__json_to_double(const char* pcText, uint32_t uLength)
+{
+#ifdef PL_NUMBER_H
+    double dValue = 0.0;
+    pl_parse_double(pcText, uLength, &dValue);
+    return dValue;
+#else
+    (void)uLength;
+    return strtod(pcText, NULL);
+#endif
+}
+
+static float
+pl__json_to_float(const char* pcText, uint32_t uLength)
+{
+#ifdef PL_NUMBER_H
+    float fValue = 0.0f;
+    pl_parse_float(pcText, uLength, &fValue);
+    return fValue;
+#else
+    (void)uLength;
+    return strtof(pcText, NULL);
+#endif
+}
+
+// truncates; values outside the int64 range saturate & NaN reads as 0
+static int64_t
+pl__json_double_to_int64(double dValue)
+{
+    if(dValue != dValue)
+        return 0;
+    if(dValue >= 9223372036854775808.0) // 2^63
+        return INT64_MAX;
+    if(dValue <= -9223372036854775808.0)
+        return INT64_MIN;
+    return (int64_t)dValue;
+}
+
+// integers written with a fraction or exponent are truncated
+static int64_t
+pl__json_to_int64(const char* pcText, uint32_t uLength)
+{
+#ifdef PL_NUMBER_H
+    int64_t iValue = 0;
+    if(pl_parse_int64(pcText, uLength, &iValue) == uLength)
+        return iValue;
+#endif
+    return pl__json_double_to_int64(pl__json_to_double(pcText, uLength));
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] streaming writer
+//-----------------------------------------------------------------------------
+
+static void
+pl__json_writer_put(plJsonWriter* ptWriter, const char* pcData, uint32_t uSize)
+{
+    while(uSize > 0)
+    {
+        if(ptWriter->uCursor == ptWriter->tDesc.uBufferSize)
+            pl_json_writer_flush(ptWriter);
+
+        uint32_t uChunk = ptWriter->tDesc.uBufferSize - ptWriter->uCursor;
+        if(uChunk > uSize)
+            uChunk = uSize;
+        memcpy(&ptWriter->tDesc.pcBuffer[ptWriter->uCursor], pcData, uChunk);
+        ptWriter->uCursor += uChunk;
+        pcData += uChunk;
+        uSize -= uChunk;
+    }
+}
+
+static inline void
+pl__json_writer_putc(plJsonWriter* ptWriter, char c)
+{
+    if(ptWriter->uCursor == ptWriter->tDesc.uBufferSize)
+        pl_json_writer_flush(ptWriter);
+    ptWriter->tDesc.pcBuffer[ptWriter->uCursor++] = c;
+}
+
+static void
+pl__json_writer_newline(plJsonWriter* ptWriter)
+{
+    static const char acSpaces[] = "                                                                ";
+    pl__json_writer_putc(ptWriter, '\n');
+    uint32_t uIndent = ptWriter->uDepth * 4;
+    while(uIndent > 0)
+    {
+        const uint32_t uChunk = uIndent < sizeof(acSpaces) - 1 ? uIndent : (uint32_t)sizeof(acSpaces) - 1;
+        pl__json_writer_put(ptWriter, acSpaces, uChunk);
+        uIndent -= uChunk;
+    }
+}
+
+static inline bool
+pl__json_writer_in_object(plJsonWriter* ptWriter)
+{
+    const uint32_t uLevel = ptWriter->uDepth - 1;
+    return (ptWriter->auObjectBits[uLevel / 64] >> (uLevel % 64)) & 1;
+}
+
+// separators/indentation before a value, false if a value isn't allowed here
+static bool
+pl__json_writer_begin_value(plJsonWriter* ptWriter)
+{
+    if(ptWriter->bError)
+        return false;
+
+    if(ptWriter->uDepth == 0)
+    {
+        if(ptWriter->bRootWritten)
+        {
+            ptWriter->bError = true;
+            return false;
+        }
+        ptWriter->bRootWritten = true;
+    }
+    else if(pl__json_writer_in_object(ptWriter))
+    {
+        if(!ptWriter->bAfterKey)
+        {
+            ptWriter->bError = true;
+            return false;
+        }
+        ptWriter->bAfterKey = false;
+    }
+    else
+    {
+        if(!ptWriter->bFirst)
+            pl__json_writer_putc(ptWriter, ',');
+        if(ptWriter->tDesc.bPretty)
+            pl__json_writer_newline(ptWriter);
+        ptWriter->bFirst = false;
+    }
+    return true;
+}
+
+static void
+pl__json_writer_escaped(plJsonWriter* ptWriter, const char* pcText)
+{
+    static const char acHex[] = "0123456789abcdef";
+
+    pl__json_writer_putc(ptWriter, '"');
+    const char* pcRun = pcText;
+    for(const char* pc = pcText; *pc; pc++)
+    {
+        const unsigned char c = (unsigned char)*pc;
+        if(c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        pl__json_writer_put(ptWriter, pcRun, (uint32_t)(pc - pcRun));
+        pcRun = pc + 1;
+
+        char acEscape[6] = {'\\', (char)c, 0, 0, 0, 0};
+        uint32_t uEscapeLength = 2;
+        switch(c)
+        {
+            case '"':
+            case '\\': break;
+            case '\n': acEscape[1] = 'n'; break;
+            case '\r': acEscape[1] = 'r'; break;
+            case '\t': acEscape[1] = 't'; break;
+            case '\b': acEscape[1] = 'b'; break;
+            case '\f': acEscape[1] = 'f'; break;
+            default:
+                acEscape[1] = 'u';
+                acEscape[2] = '0';
+                acEscape[3] = '0';
+                acEscape[4] = acHex[c >> 4];
+                acEscape[5] = acHex[c & 0xF];
+                uEscapeLength = 6;
+        }
+        pl__json_writer_put(ptWriter, acEscape, uEscapeLength);
+    }
+    pl__json_writer_put(ptWriter, pcRun, (uint32_t)strlen(pcRun));
+    pl__json_writer_putc(ptWriter, '"');
+}
+
+static void
+pl__json_writer_begin_container(plJsonWriter* ptWriter, bool bObject)
+{
+    if(!pl__json_writer_begin_value(ptWriter))
+        return;
+
+    if(ptWriter->uDepth == PL_JSON_MAX_DEPTH)
+    {
+        ptWriter->bError = true;
+        return;
+    }
+
+    const uint32_t uLevel = ptWriter->uDepth++;
+    if(bObject)
+        ptWriter->auObjectBits[uLevel / 64] |= (uint64_t)1 << (uLevel % 64);
+    else
+        ptWriter->auObjectBits[uLevel / 64] &= ~((uint64_t)1 << (uLevel % 64));
+    ptWriter->bFirst = true;
+    pl__json_writer_putc(ptWriter, bObject ? '{' : '[');
+}
+
+static void
+pl__json_writer_end_container(plJsonWriter* ptWriter, bool bObject)
+{
+    if(ptWriter->bError)
+        return;
+
+    if(ptWriter->uDepth == 0 || pl__json_writer_in_object(ptWriter) != bObject || ptWriter->bAfterKey)
+    {
+        ptWriter->bError = true;
+        return;
+    }
+
+    ptWriter->uDepth--;
+    if(!ptWriter->bFirst && ptWriter->tDesc.bPretty)
+        pl__json_writer_newline(ptWriter);
+    ptWriter->bFirst = false;
+    pl__json_writer_putc(ptWriter, bObject ? '}' : ']');
+}
+
+void
+pl_json_writer_init(plJsonWriter* ptWriter, const plJsonWriterDesc* ptDesc)
+{
+    PL_ASSERT(ptDesc->pfSink && ptDesc->pcBuffer && ptDesc->uBufferSize > 0);
+    memset(ptWriter, 0, sizeof(plJsonWriter));
+    ptWriter->tDesc = *ptDesc;
+}
+
+void
+pl_json_writer_flush(plJsonWriter* ptWriter)
+{
+    if(ptWriter->uCursor > 0)
+        ptWriter->tDesc.pfSink(ptWriter->tDesc.pUserData, ptWriter->tDesc.pcBuffer, ptWriter->uCursor);
+    ptWriter->uCursor = 0;
+}
+
+bool
+pl_json_writer_finish(plJsonWriter* ptWriter)
+{
+    pl_json_writer_flush(ptWriter);
+    return !ptWriter->bError && ptWriter->bRootWritten && ptWriter->uDepth == 0;
+}
+
+void
+pl_json_write_begin_object(plJsonWriter* ptWriter)
+{
+    pl__json_writer_begin_container(ptWriter, true);
+}
+
+void
+pl_json_write_end_object(plJsonWriter* ptWriter)
+{
+    pl__json_writer_end_container(ptWriter, true);
+}
+
+void
+pl_json_write_begin_array(plJsonWriter* ptWriter)
+{
+    pl__json_writer_begin_container(ptWriter, false);
+}
+
+void
+pl_json_write_end_array(plJsonWriter* ptWriter)
+{
+    pl__json_writer_end_container(ptWriter, false);
+}
+
+void
+pl_json_write_key(plJsonWriter* ptWriter, const char* pcKey)
+{
+    if(ptWriter->bError)
+        return;
+
+    if(ptWriter->uDepth == 0 || !pl__json_writer_in_object(ptWriter) || ptWriter->bAfterKey)
+    {
+        ptWriter->bError = true;
+        return;
+    }
+
+    if(!ptWriter->bFirst)
+        pl__json_writer_putc(ptWriter, ',');
+    if(ptWriter->tDesc.bPretty)
+        pl__json_writer_newline(ptWriter);
+    pl__json_writer_escaped(ptWriter, pcKey);
+    if(ptWriter->tDesc.bPretty)
+        pl__json_writer_put(ptWriter, ": ", 2);
+    else
+        pl__json_writer_putc(ptWriter, ':');
+    ptWriter->bFirst = false;
+    ptWriter->bAfterKey = true;
+}
+
+void
+pl_json_write_string(plJsonWriter* ptWriter, const char* pcValue)
+{
+    if(pl__json_writer_begin_value(ptWriter))
+        pl__json_writer_escaped(ptWriter, pcValue);
+}
+
+void
+pl_json_write_int(plJsonWriter* ptWriter, int64_t iValue)
+{
+    if(!pl__json_writer_begin_value(ptWriter))
+        return;
+    char acBuffer[24];
+    pl__json_writer_put(ptWriter, acBuffer, pl__json_format_int64(iValue, acBuffer));
+}
+
+void
+pl_json_write_uint(plJsonWriter* ptWriter, uint64_t uValue)
+{
+    if(!pl__json_writer_begin_value(ptWriter))
+        return;
+    char acBuffer[24];
+    pl__json_writer_put(ptWriter, acBuffer, pl__json_format_uint64(uValue, acBuffer));
+}
+
+void
+pl_json_write_float(plJsonWriter* ptWriter, float fValue)
+{
+    if(!pl__json_writer_begin_value(ptWriter))
+        return;
+    if(fValue != fValue || fValue - fValue != 0.0f) // nan or inf
+    {
+        pl__json_writer_put(ptWriter, "null", 4);
+        return;
+    }
+    char acBuffer[32];
+    pl__json_writer_put(ptWriter, acBuffer, pl__json_format_real(fValue, true, acBuffer));
+}
+
+void
+pl_json_write_double(plJsonWriter* ptWriter, double dValue)
+{
+    if(!pl__json_writer_begin_value(ptWriter))
+        return;
+    if(dValue != dValue || dValue - dValue != 0.0) // nan or inf
+    {
+        pl__json_writer_put(ptWriter, "null", 4);
+        return;
+    }
+    char acBuffer[32];
+    pl__json_writer_put(ptWriter, acBuffer, pl__json_format_real(dValue, false, acBuffer));
+}
+
+void
+pl_json_write_bool(plJsonWriter* ptWriter, bool bValue)
+{
+    if(pl__json_writer_begin_value(ptWriter))
+        pl__json_writer_put(ptWriter, bValue ? "true" : "false", bValue ? 4 : 5);
+}
+
+void
+pl_json_write_null(plJsonWriter* ptWriter)
+{
+    if(pl__json_writer_begin_value(ptWriter))
+        pl__json_writer_put(ptWriter, "null", 4);
+}
+
+void
+pl_json_memory_sink(void* pUserData, const char* pcData, size_t szSize)
+{
+    plJsonMemorySink* ptSink = (plJsonMemorySink*)pUserData;
+    if(ptSink->szCapacity == 0)
+    {
+        ptSink->bOverflow = true;
+        return;
+    }
+
+    // always leave room for the null terminator
+    size_t szAvailable = ptSink->szCapacity - 1 - ptSink->szSize;
+    if(szSize > szAvailable)
+    {
+        ptSink->bOverflow = true;
+        szSize = szAvailable;
+    }
+    memcpy(&ptSink->pcBuffer[ptSink->szSize], pcData, szSize);
+    ptSink->szSize += szSize;
+    ptSink->pcBuffer[ptSink->szSize] = 0;
+}
+
+void
+pl_json_file_sink(void* pUserData, const char* pcData, size_t szSize)
+{
+    fwrite(pcData, 1, szSize, (FILE*)pUserData);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] binary format
+//-----------------------------------------------------------------------------
+
+// layout (32 bit words, offsets are in words from the start of the buffer)
+//   header:      magic, version, size in bytes, root reference
+//   reference:   tag (low 3 bits) | payload << 3
+//   string/text: length, characters (null terminated, padded to a word)
+//   int64/double 8 bytes (8 byte aligned)
+//   array:       count, references[count]
+//   object:      count, index mask, (name offset, reference)[count], index[mask + 1] (mask != 0)
+
+static uint32_t
+pl__json_bin_alloc(plJsonBinEncoder* ptEncoder, uint32_t uWordCount)
+{
+    const uint32_t uOffset = pl_sb_json_size(ptEncoder->sbuWords);
+    const uint32_t uCapacity = pl_sb_json_capacity(ptEncoder->sbuWords);
+
+    // stretchy buffer only grows by the requested amount, so double here
+    if(uOffset + uWordCount > uCapacity)
+        pl_sb_json_reserve(ptEncoder->sbuWords, uWordCount > uCapacity ? uWordCount : uCapacity);
+
+    pl_sb_json_resize(ptEncoder->sbuWords, uOffset + uWordCount);
+    memset(&ptEncoder->sbuWords[uOffset], 0, sizeof(uint32_t) * uWordCount);
+
+    if(uOffset + uWordCount > PL_JSON_BIN_MAX_WORDS)
+        ptEncoder->bOverflow = true;
+    return uOffset;
+}
+
+static uint32_t
+pl__json_bin_alloc_aligned8(plJsonBinEncoder* ptEncoder)
+{
+    if(pl_sb_json_size(ptEncoder->sbuWords) & 1)
+        pl__json_bin_alloc(ptEncoder, 1);
+    return pl__json_bin_alloc(ptEncoder, 2);
+}
+
+static uint32_t
+pl__json_bin_intern(plJsonBinEncoder* ptEncoder, const char* pcText, uint32_t uLength)
+{
+    // grow at 50% load
+    if((ptEncoder->uStringCount + 1) * 2 > ptEncoder->uStringIndexMask + 1)
+    {
+        const uint32_t uOldCapacity = ptEncoder->auStringIndex ? ptEncoder->uStringIndexMask + 1 : 0;
+        uint32_t* auOldIndex = ptEncoder->auStringIndex;
+        const uint32_t uNewCapacity = uOldCapacity ? uOldCapacity * 2 : 256;
+        ptEncoder->auStringIndex = PL_JSON_ALLOC(sizeof(uint32_t) * uNewCapacity);
+        memset(ptEncoder->auStringIndex, 0, sizeof(uint32_t) * uNewCapacity);
+        ptEncoder->uStringIndexMask = uNewCapacity - 1;
+        for(uint32_t i = 0; i < uOldCapacity; i++)
+        {
+            if(auOldIndex[i] == 0)
+                continue;
+            const uint32_t* puRecord = &ptEncoder->sbuWords[auOldIndex[i]];
+            uint32_t uSlot = pl__json_hash((const char*)&puRecord[1], puRecord[0]) & ptEncoder->uStringIndexMask;
+            while(ptEncoder->auStringIndex[uSlot])
+                uSlot = (uSlot + 1) & ptEncoder->uStringIndexMask;
+            ptEncoder->auStringIndex[uSlot] = auOldIndex[i];
+        }
+        if(auOldIndex)
+            PL_JSON_FREE(auOldIndex);
+    }
+
+    uint32_t uSlot = pl__json_hash(pcText, uLength) & ptEncoder->uStringIndexMask;
+    while(ptEncoder->auStringIndex[uSlot])
+    {
+        const uint32_t* puRecord = &ptEncoder->sbuWords[ptEncoder->auStringIndex[uSlot]];
+        if(puRecord[0] == uLength && memcmp(&puRecord[1], pcText, uLength) == 0)
+            return ptEncoder->auStringIndex[uSlot];
+        uSlot = (uSlot + 1) & ptEncoder->uStringIndexMask;
+    }
+
+    const uint32_t uOffset = pl__json_bin_alloc(ptEncoder, 1 + (uLength + 1 + 3) / 4);
+    ptEncoder->sbuWords[uOffset] = uLength;
+    memcpy(&ptEncoder->sbuWords[uOffset + 1], pcText, uLength);
+    ptEncoder->auStringIndex[uSlot] = uOffset;
+    ptEncoder->uStringCount++;
+    return uOffset;
+}
+
+// integers that format back to the same text
+static bool
+pl__json_bin_parse_integer(const char* pcText, uint32_t uLength, int64_t* piOut)
+{
+    uint32_t uDigitStart = pcText[0] == '-' ? 1 : 0;
+    if(uLength <= uDigitStart || uLength - uDigitStart > 19 || (pcText[uDigitStart] == '0' && uLength - uDigitStart > 1))
+        return false;
+
+    uint64_t uValue = 0;
+    for(uint32_t i = uDigitStart; i < uLength; i++)
+    {
+        if(pcText[i] < '0' || pcText[i] > '9')
+            return false;
+        uValue = uValue * 10 + (uint64_t)(pcText[i] - '0');
+    }
+
+    if(uDigitStart) // negative (-0 is left to the double path)
+    {
+        if(uValue == 0 || uValue > (uint64_t)INT64_MAX + 1)
+            return false;
+        *piOut = uValue == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)uValue;
+    }
+    else
+    {
+        if(uValue > (uint64_t)INT64_MAX)
+            return false;
+        *piOut = (int64_t)uValue;
+    }
+    return true;
+}
+
+static uint32_t
+pl__json_bin_encode_value(plJsonBinEncoder* ptEncoder, plJsonType tType, const char* pcText, uint32_t uLength)
+{
+    switch(tType)
+    {
+        case PL_JSON_TYPE_BOOL:   return PL_JSON_BIN_TAG_SPECIAL | ((pcText[0] == 't' ? 2u : 1u) << 3);
+        case PL_JSON_TYPE_STRING: return PL_JSON_BIN_TAG_STRING | (pl__json_bin_intern(ptEncoder, pcText, uLength) << 3);
+        case PL_JSON_TYPE_NUMBER:
+        {
+            int64_t iValue = 0;
+            if(pl__json_bin_parse_integer(pcText, uLength, &iValue))
+            {
+                if(iValue >= -PL_JSON_BIN_INLINE_INT_LIMIT && iValue < PL_JSON_BIN_INLINE_INT_LIMIT)
+                    return PL_JSON_BIN_TAG_INT | ((uint32_t)iValue << 3);
+                const uint32_t uOffset = pl__json_bin_alloc_aligned8(ptEncoder);
+                memcpy(&ptEncoder->sbuWords[uOffset], &iValue, sizeof(int64_t));
+                return PL_JSON_BIN_TAG_INT64 | (uOffset << 3);
+            }
+
+            char acBuffer[32];
+            const double dValue = pl__json_to_double(pcText, uLength);
+            const uint32_t uFormattedLength = pl__json_format_real(dValue, false, acBuffer);
+            if(uFormattedLength == uLength && memcmp(acBuffer, pcText, uLength) == 0)
+            {
+                const uint32_t uOffset = pl__json_bin_alloc_aligned8(ptEncoder);
+                memcpy(&ptEncoder->sbuWords[uOffset], &dValue, sizeof(double));
+                return PL_JSON_BIN_TAG_DOUBLE | (uOffset << 3);
+            }
+            return PL_JSON_BIN_TAG_NUMBER | (pl__json_bin_intern(ptEncoder, pcText, uLength) << 3);
+        }
+        default: return PL_JSON_BIN_TAG_SPECIAL; // null (& unset array elements)
+    }
+}
+
+static uint32_t
+pl__json_bin_encode(plJsonBinEncoder* ptEncoder, plJsonObject* ptJson)
+{
+    const char* pcBuffer = pl__json_document(ptJson)->sbcBuffer;
+
+    if(ptJson->tType == PL_JSON_TYPE_OBJECT)
+    {
+        const uint32_t uCount = ptJson->sbtChildren ? ptJson->uChildCount : 0;
+        uint32_t uMask = 0;
+        if(uCount > PL_JSON_MEMBER_INDEX_THRESHOLD)
+        {
+            uint32_t uCapacity = 1;
+            while(uCapacity < uCount * 2)
+                uCapacity <<= 1;
+            uMask = uCapacity - 1;
+        }
+
+        const uint32_t uOffset = pl__json_bin_alloc(ptEncoder, 2 + uCount * 2 + (uMask ? uMask + 1 : 0));
+        ptEncoder->sbuWords[uOffset] = uCount;
+        ptEncoder->sbuWords[uOffset + 1] = uMask;
+
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            plJsonObject* ptMember = &ptJson->sbtChildren[i];
+            const uint32_t uName = pl__json_bin_intern(ptEncoder, &pcBuffer[ptMember->uNameOffset], ptMember->uNameLength);
+            const uint32_t uRef = pl__json_bin_encode(ptEncoder, ptMember); // may move sbuWords
+            ptEncoder->sbuWords[uOffset + 2 + i * 2] = uName;
+            ptEncoder->sbuWords[uOffset + 2 + i * 2 + 1] = uRef;
+        }
+
+        // inserted in order so duplicate names resolve to the first member
+        uint32_t* auIndex = &ptEncoder->sbuWords[uOffset + 2 + uCount * 2];
+        for(uint32_t i = 0; uMask && i < uCount; i++)
+        {
+            const plJsonObject* ptMember = &ptJson->sbtChildren[i];
+            uint32_t uSlot = pl__json_hash(&pcBuffer[ptMember->uNameOffset], ptMember->uNameLength) & uMask;
+            while(auIndex[uSlot])
+                uSlot = (uSlot + 1) & uMask;
+            auIndex[uSlot] = i + 1;
+        }
+        return PL_JSON_BIN_TAG_OBJECT | (uOffset << 3);
+    }
+
+    if(ptJson->tType == PL_JSON_TYPE_ARRAY)
+    {
+        const uint32_t uCount = ptJson->uChildCount;
+        const uint32_t uOffset = pl__json_bin_alloc(ptEncoder, 1 + uCount);
+        ptEncoder->sbuWords[uOffset] = uCount;
+
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            uint32_t uRef = PL_JSON_BIN_TAG_SPECIAL;
+            if(ptJson->sbtChildren)
+                uRef = pl__json_bin_encode(ptEncoder, &ptJson->sbtChildren[i]);
+            else if(ptJson->sbuValueOffsets)
+            {
+                // arrays built with pl_json_add_*_array only store text (strings have a leading quote)
+                const char* pcValue = &pcBuffer[ptJson->sbuValueOffsets[i]];
+                plJsonType tType = PL_JSON_TYPE_NUMBER;
+                if(pcValue[-1] == '\"')   tType = PL_JSON_TYPE_STRING;
+                else if(pcValue[0] == 't' || pcValue[0] == 'f') tType = PL_JSON_TYPE_BOOL;
+                else if(pcValue[0] == 'n') tType = PL_JSON_TYPE_NULL;
+                uRef = pl__json_bin_encode_value(ptEncoder, tType, pcValue, ptJson->sbuValueLength[i]);
+            }
+            ptEncoder->sbuWords[uOffset + 1 + i] = uRef;
+        }
+        return PL_JSON_BIN_TAG_ARRAY | (uOffset << 3);
+    }
+
+    return pl__json_bin_encode_value(ptEncoder, ptJson->tType, &pcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
+}
+
+static inline int64_t
+pl__json_bin_inline_int(uint32_t uRef)
+{
+    const uint32_t uPayload = uRef >> 3;
+    return (uPayload & PL_JSON_BIN_INLINE_INT_LIMIT) ? (int64_t)uPayload - 2 * PL_JSON_BIN_INLINE_INT_LIMIT : (int64_t)uPayload;
+}
+
+// NULL if the record doesn't fit in the buffer or isn't terminated
+static const char*
+pl__json_bin_text(const uint32_t* puBase, uint32_t uWordCount, uint32_t uOffset, uint32_t* puLengthOut)
+{
+    if(uOffset < PL_JSON_BIN_HEADER_WORDS || uOffset >= uWordCount)
+        return NULL;
+
+    const uint32_t uLength = puBase[uOffset];
+    if((uint64_t)uLength + 1 > (uint64_t)(uWordCount - uOffset - 1) * 4)
+        return NULL;
+
+    const char* pcText = (const char*)&puBase[uOffset + 1];
+    if(pcText[uLength] != 0)
+        return NULL;
+    *puLengthOut = uLength;
+    return pcText;
+}
+
+// validates a value & counts the nodes/array values needed to load it
+static bool
+pl__json_bin_check(const uint32_t* puBase, uint32_t uWordCount, uint32_t uRef, uint32_t uDepth, uint32_t* puNodeCount, uint32_t* puValueCount)
+{
+    const uint32_t uPayload = uRef >> 3;
+    uint32_t uLength = 0;
+
+    switch(uRef & 7)
+    {
+        case PL_JSON_BIN_TAG_SPECIAL: return uPayload <= 2;
+        case PL_JSON_BIN_TAG_INT:     return true;
+        case PL_JSON_BIN_TAG_INT64:
+        case PL_JSON_BIN_TAG_DOUBLE:  return uPayload >= PL_JSON_BIN_HEADER_WORDS && uPayload + 2 <= uWordCount;
+        case PL_JSON_BIN_TAG_STRING:
+        case PL_JSON_BIN_TAG_NUMBER:  return pl__json_bin_text(puBase, uWordCount, uPayload, &uLength) != NULL;
+
+        case PL_JSON_BIN_TAG_ARRAY:
+        {
+            if(uDepth >= PL_JSON_MAX_DEPTH || uPayload < PL_JSON_BIN_HEADER_WORDS || uPayload >= uWordCount)
+                return false;
+
+            const uint32_t uCount = puBase[uPayload];
+            if(uCount > uWordCount - uPayload - 1)
+                return false;
+
+            // encoder never shares containers, so every node has its own reference word
+            *puNodeCount += uCount;
+            *puValueCount += uCount * 2;
+            if(*puNodeCount > uWordCount)
+                return false;
+
+            for(uint32_t i = 0; i < uCount; i++)
+            {
+                if(!pl__json_bin_check(puBase, uWordCount, puBase[uPayload + 1 + i], uDepth + 1, puNodeCount, puValueCount))
+                    return false;
+            }
+            return true;
+        }
+
+        case PL_JSON_BIN_TAG_OBJECT:
+        {
+            if(uDepth >= PL_JSON_MAX_DEPTH || uPayload < PL_JSON_BIN_HEADER_WORDS || uPayload + 2 > uWordCount)
+                return false;
+
+            const uint32_t uCount = puBase[uPayload];
+            const uint32_t uMask = puBase[uPayload + 1];
+            const uint64_t uRecordWords = 2 + (uint64_t)uCount * 2 + (uMask ? (uint64_t)uMask + 1 : 0);
+            if(uRecordWords > uWordCount - uPayload)
+                return false;
+
+            *puNodeCount += uCount;
+            if(*puNodeCount > uWordCount)
+                return false;
+
+            for(uint32_t i = 0; i < uCount; i++)
+            {
+                if(pl__json_bin_text(puBase, uWordCount, puBase[uPayload + 2 + i * 2], &uLength) == NULL)
+                    return false;
+                if(!pl__json_bin_check(puBase, uWordCount, puBase[uPayload + 2 + i * 2 + 1], uDepth + 1, puNodeCount, puValueCount))
+                    return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// buffer must have passed pl__json_bin_check (nodes & array values come from the document pools)
+static void
+pl__json_bin_build(plJsonDocument* ptDocument, const uint32_t* puBase, uint32_t uRef, plJsonObject* ptJson, uint32_t* puNodeCursor, uint32_t* puValueCursor)
+{
+    const uint32_t uPayload = uRef >> 3;
+    char acBuffer[32];
+    const char* pcText = acBuffer;
+    uint32_t uLength = 0;
+
+    ptJson->ptRootObject = &ptDocument->tRoot;
+
+    switch(uRef & 7)
+    {
+        case PL_JSON_BIN_TAG_SPECIAL:
+        {
+            ptJson->tType = uPayload == 0 ? PL_JSON_TYPE_NULL : PL_JSON_TYPE_BOOL;
+            pcText = uPayload == 0 ? "null" : (uPayload == 1 ? "false" : "true");
+            uLength = (uint32_t)strlen(pcText);
+            break;
+        }
+
+        case PL_JSON_BIN_TAG_INT:
+        {
+            ptJson->tType = PL_JSON_TYPE_NUMBER;
+            uLength = pl__json_format_int64(pl__json_bin_inline_int(uRef), acBuffer);
+            break;
+        }
+
+        case PL_JSON_BIN_TAG_INT64:
+        {
+            int64_t iValue = 0;
+            memcpy(&iValue, &puBase[uPayload], sizeof(int64_t));
+            ptJson->tType = PL_JSON_TYPE_NUMBER;
+            uLength = pl__json_format_int64(iValue, acBuffer);
+            break;
+        }
+
+        case PL_JSON_BIN_TAG_DOUBLE:
+        {
+            double dValue = 0.0;
+            memcpy(&dValue, &puBase[uPayload], sizeof(double));
+            ptJson->tType = PL_JSON_TYPE_NUMBER;
+            uLength = pl__json_format_real(dValue, false, acBuffer);
+            break;
+        }
+
+        case PL_JSON_BIN_TAG_STRING:
+        case PL_JSON_BIN_TAG_NUMBER:
+        {
+            ptJson->tType = (uRef & 7) == PL_JSON_BIN_TAG_STRING ? PL_JSON_TYPE_STRING : PL_JSON_TYPE_NUMBER;
+            pcText = (const char*)&puBase[uPayload + 1];
+            uLength = puBase[uPayload];
+            break;
+        }
+
+        case PL_JSON_BIN_TAG_ARRAY:
+        {
+            const uint32_t uCount = puBase[uPayload];
+            ptJson->tType = PL_JSON_TYPE_ARRAY;
+            ptJson->uChildCount = uCount;
+            ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN;
+            if(uCount == 0)
+                return;
+
+            ptJson->sbtChildren = &ptDocument->sbtNodes[*puNodeCursor];
+            *puNodeCursor += uCount;
+            uint32_t* puOffsets = &ptDocument->sbuValues[*puValueCursor];
+            uint32_t* puLengths = &puOffsets[uCount];
+            *puValueCursor += uCount * 2;
+
+            // arrays of only strings & primitives also expose flat offsets (used by pl_json_as_*_array)
+            bool bValuesOnly = true;
+            for(uint32_t i = 0; i < uCount; i++)
+            {
+                plJsonObject* ptElement = &ptJson->sbtChildren[i];
+                pl__json_bin_build(ptDocument, puBase, puBase[uPayload + 1 + i], ptElement, puNodeCursor, puValueCursor);
+                if(ptElement->tType == PL_JSON_TYPE_OBJECT || ptElement->tType == PL_JSON_TYPE_ARRAY)
+                    bValuesOnly = false;
+                else
+                {
+                    puOffsets[i] = ptElement->uValueOffset;
+                    puLengths[i] = ptElement->uValueLength;
+                }
+            }
+
+            if(bValuesOnly)
+            {
+                ptJson->sbuValueOffsets = puOffsets;
+                ptJson->sbuValueLength = puLengths;
+                ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_VALUES;
+            }
+            return;
+        }
+
+        case PL_JSON_BIN_TAG_OBJECT:
+        {
+            const uint32_t uCount = puBase[uPayload];
+            ptJson->tType = PL_JSON_TYPE_OBJECT;
+            ptJson->uChildCount = uCount;
+            ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN;
+            if(uCount == 0)
+                return;
+
+            ptJson->sbtChildren = &ptDocument->sbtNodes[*puNodeCursor];
+            *puNodeCursor += uCount;
+
+            for(uint32_t i = 0; i < uCount; i++)
+            {
+                const uint32_t* puName = &puBase[puBase[uPayload + 2 + i * 2]];
+                plJsonObject* ptMember = &ptJson->sbtChildren[i];
+                ptMember->uNameLength = puName[0];
+                ptMember->uNameOffset = pl__json_push_text(ptJson, (const char*)&puName[1], puName[0], false);
+                pl__json_bin_build(ptDocument, puBase, puBase[uPayload + 2 + i * 2 + 1], ptMember, puNodeCursor, puValueCursor);
+            }
+            return;
+        }
+    }
+
+    ptJson->uValueLength = uLength;
+    ptJson->uValueOffset = pl__json_push_text(ptJson, pcText, uLength, ptJson->tType == PL_JSON_TYPE_STRING);
+}
+
+bool
+pl_write_json_bin(plJsonObject* ptJson, void* pBuffer, size_t* pszSize)
+{
+    plJsonBinEncoder tEncoder = {0};
+    pl__json_bin_alloc(&tEncoder, PL_JSON_BIN_HEADER_WORDS);
+    const uint32_t uRoot = pl__json_bin_encode(&tEncoder, ptJson);
+
+    const size_t szSize = pl_sb_json_size(tEncoder.sbuWords) * sizeof(uint32_t);
+    tEncoder.sbuWords[0] = PL_JSON_BIN_MAGIC;
+    tEncoder.sbuWords[1] = PL_JSON_BIN_VERSION;
+    tEncoder.sbuWords[2] = (uint32_t)szSize;
+    tEncoder.sbuWords[3] = uRoot;
+
+    bool bResult = !tEncoder.bOverflow;
+    if(pBuffer)
+    {
+        if(*pszSize >= szSize)
+            memcpy(pBuffer, tEncoder.sbuWords, szSize);
+        else
+            bResult = false;
+    }
+    *pszSize = szSize;
+
+    pl_sb_json_free(tEncoder.sbuWords);
+    if(tEncoder.auStringIndex)
+        PL_JSON_FREE(tEncoder.auStringIndex);
+    return bResult;
+}
+
+bool
+pl_load_json_bin(const void* pBuffer, size_t szSize, plJsonObject** pptJsonOut)
+{
+    *pptJsonOut = NULL;
+
+    plJsonBinValue tRoot = {0};
+    if(!pl_json_bin_root(pBuffer, szSize, &tRoot))
+        return false;
+
+    // validation pass so the node & value pools are each allocated once
+    const uint32_t uWordCount = tRoot.puBase[2] / 4;
+    uint32_t uNodeCount = 0;
+    uint32_t uValueCount = 0;
+    if(!pl__json_bin_check(tRoot.puBase, uWordCount, tRoot.uRef, 0, &uNodeCount, &uValueCount))
+        return false;
+
+    plJsonObject* ptJson = pl_json_new_root_object("ROOT");
+    plJsonDocument* ptDocument = pl__json_document(ptJson);
+    pl_sb_json_reserve(ptDocument->sbcBuffer, (uint32_t)szSize);
+    pl_sb_json_resize(ptDocument->sbtNodes, uNodeCount);
+    pl_sb_json_resize(ptDocument->sbuValues, uValueCount);
+
+    uint32_t uNodeCursor = 0;
+    uint32_t uValueCursor = 0;
+    pl__json_bin_build(ptDocument, tRoot.puBase, tRoot.uRef, ptJson, &uNodeCursor, &uValueCursor);
+    *pptJsonOut = ptJson;
+    return true;
+}
+
+bool
+pl_json_bin_root(const void* pBuffer, size_t szSize, plJsonBinValue* ptValueOut)
+{
+    const uint32_t* puBase = (const uint32_t*)pBuffer;
+    if(puBase == NULL || ((uintptr_t)pBuffer & 3) || szSize < PL_JSON_BIN_HEADER_WORDS * sizeof(uint32_t))
+        return false;
+
+    if(puBase[0] != PL_JSON_BIN_MAGIC || puBase[1] != PL_JSON_BIN_VERSION || puBase[2] > szSize || (puBase[2] & 3) || puBase[2] < PL_JSON_BIN_HEADER_WORDS * sizeof(uint32_t))
+        return false;
+
+    ptValueOut->puBase = puBase;
+    ptValueOut->uRef = puBase[3];
+    return true;
+}
+
+plJsonType
+pl_json_bin_get_type(plJsonBinValue tValue)
+{
+    if(tValue.puBase == NULL)
+        return PL_JSON_TYPE_UNSPECIFIED;
+
+    switch(tValue.uRef & 7)
+    {
+        case PL_JSON_BIN_TAG_SPECIAL: return (tValue.uRef >> 3) == 0 ? PL_JSON_TYPE_NULL : PL_JSON_TYPE_BOOL;
+        case PL_JSON_BIN_TAG_STRING:  return PL_JSON_TYPE_STRING;
+        case PL_JSON_BIN_TAG_ARRAY:   return PL_JSON_TYPE_ARRAY;
+        case PL_JSON_BIN_TAG_OBJECT:  return PL_JSON_TYPE_OBJECT;
+        default:                      return PL_JSON_TYPE_NUMBER;
+    }
+}
+
+uint32_t
+pl_json_bin_count(plJsonBinValue tValue)
+{
+    const uint32_t uTag = tValue.uRef & 7;
+    if(tValue.puBase == NULL || uTag == PL_JSON_BIN_TAG_SPECIAL || uTag == PL_JSON_BIN_TAG_INT || uTag == PL_JSON_BIN_TAG_INT64 || uTag == PL_JSON_BIN_TAG_DOUBLE)
+        return 0;
+    return tValue.puBase[tValue.uRef >> 3];
+}
+
+plJsonBinValue
+pl_json_bin_member(plJsonBinValue tValue, const char* pcName)
+{
+    plJsonBinValue tMember = {0};
+    if(tValue.puBase == NULL || (tValue.uRef & 7) != PL_JSON_BIN_TAG_OBJECT)
+        return tMember;
+
+    const uint32_t* puObject = &tValue.puBase[tValue.uRef >> 3];
+    const uint32_t  uCount = puObject[0];
+    const uint32_t  uMask = puObject[1];
+    const uint32_t* puMembers = &puObject[2];
+    const uint32_t  uLength = (uint32_t)strlen(pcName);
+
+    if(uMask)
+    {
+        const uint32_t* puIndex = &puMembers[uCount * 2];
+        uint32_t uSlot = pl__json_hash(pcName, uLength) & uMask;
+        while(puIndex[uSlot])
+        {
+            const uint32_t uMember = puIndex[uSlot] - 1;
+            const uint32_t* puName = &tValue.puBase[puMembers[uMember * 2]];
+            if(puName[0] == uLength && memcmp(&puName[1], pcName, uLength) == 0)
+            {
+                tMember.puBase = tValue.puBase;
+                tMember.uRef = puMembers[uMember * 2 + 1];
+                return tMember;
+            }
+            uSlot = (uSlot + 1) & uMask;
+        }
+        return tMember;
+    }
+
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const uint32_t* puName = &tValue.puBase[puMembers[i * 2]];
+        if(puName[0] == uLength && memcmp(&puName[1], pcName, uLength) == 0)
+        {
+            tMember.puBase = tValue.puBase;
+            tMember.uRef = puMembers[i * 2 + 1];
+            return tMember;
+        }
+    }
+    return tMember;
+}
+
+plJsonBinValue
+pl_json_bin_member_by_index(plJsonBinValue tValue, uint32_t uIndex, const char** ppcNameOut)
+{
+    plJsonBinValue tMember = {0};
+    if(tValue.puBase == NULL || (tValue.uRef & 7) != PL_JSON_BIN_TAG_OBJECT)
+        return tMember;
+
+    const uint32_t* puObject = &tValue.puBase[tValue.uRef >> 3];
+    if(uIndex >= puObject[0])
+        return tMember;
+
+    if(ppcNameOut)
+        *ppcNameOut = (const char*)&tValue.puBase[puObject[2 + uIndex * 2] + 1];
+    tMember.puBase = tValue.puBase;
+    tMember.uRef = puObject[2 + uIndex * 2 + 1];
+    return tMember;
+}
+
+plJsonBinValue
+pl_json_bin_element(plJsonBinValue tValue, uint32_t uIndex)
+{
+    plJsonBinValue tElement = {0};
+    if(tValue.puBase == NULL || (tValue.uRef & 7) != PL_JSON_BIN_TAG_ARRAY)
+        return tElement;
+
+    const uint32_t* puArray = &tValue.puBase[tValue.uRef >> 3];
+    if(uIndex >= puArray[0])
+        return tElement;
+
+    tElement.puBase = tValue.puBase;
+    tElement.uRef = puArray[1 + uIndex];
+    return tElement;
+}
+
+int64_t
+pl_json_bin_as_int(plJsonBinValue tValue)
+{
+    PL_ASSERT(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_NUMBER);
+    const uint32_t uPayload = tValue.uRef >> 3;
+    switch(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_NUMBER ? tValue.uRef & 7 : PL_JSON_BIN_TAG_SPECIAL)
+    {
+        case PL_JSON_BIN_TAG_INT: return pl__json_bin_inline_int(tValue.uRef);
+        case PL_JSON_BIN_TAG_INT64:
+        {
+            int64_t iValue = 0;
+            memcpy(&iValue, &tValue.puBase[uPayload], sizeof(int64_t));
+            return iValue;
+        }
+        case PL_JSON_BIN_TAG_DOUBLE: return pl__json_double_to_int64(pl_json_bin_as_double(tValue));
+        case PL_JSON_BIN_TAG_NUMBER: return pl__json_to_int64((const char*)&tValue.puBase[uPayload + 1], tValue.puBase[uPayload]);
+    }
+    return 0;
+}
+
+double
+pl_json_bin_as_double(plJsonBinValue tValue)
+{
+    PL_ASSERT(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_NUMBER);
+    const uint32_t uPayload = tValue.uRef >> 3;
+    switch(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_NUMBER ? tValue.uRef & 7 : PL_JSON_BIN_TAG_SPECIAL)
+    {
+        case PL_JSON_BIN_TAG_INT:   return (double)pl__json_bin_inline_int(tValue.uRef);
+        case PL_JSON_BIN_TAG_INT64: return (double)pl_json_bin_as_int(tValue);
+        case PL_JSON_BIN_TAG_DOUBLE:
+        {
+            double dValue = 0.0;
+            memcpy(&dValue, &tValue.puBase[uPayload], sizeof(double));
+            return dValue;
+        }
+        case PL_JSON_BIN_TAG_NUMBER: return pl__json_to_double((const char*)&tValue.puBase[uPayload + 1], tValue.puBase[uPayload]);
+    }
+    return DBL_MAX;
+}
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    tNewJsonObject.sbtChildren = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbtChildren, uSize);
-    for(uint32_t i = 0; i < uSize; i++)
-        tNewJsonObject.sbtChildren[i].ptRootObject = ptJson->ptRootObject;
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
-    return &pl_sb_json_top(ptJson->sbtChildren);
+bool
+pl_json_bin_as_bool(plJsonBinValue tValue)
+{
+    PL_ASSERT(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_BOOL);
+    return pl_json_bin_get_type(tValue) == PL_JSON_TYPE_BOOL && (tValue.uRef >> 3) == 2;
 }
 
-void
-pl_json_add_int_array(plJsonObject* ptJson, const char* pcName, int* piValues, uint32_t uSize)
+const char*
+pl_json_bin_as_string(plJsonBinValue tValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    PL_ASSERT(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_STRING);
+    if(pl_json_bin_get_type(tValue) == PL_JSON_TYPE_STRING)
+        return (const char*)&tValue.puBase[(tValue.uRef >> 3) + 1];
+    return NULL;
+}
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+//-----------------------------------------------------------------------------
+// [SECTION] stage 1 (structural index)
+//-----------------------------------------------------------------------------
 
-    for(uint32_t i = 0; i < uSize; i++)
+static inline void
+pl__json_classify_block(const uint8_t* puBlock, plJsonBlock* ptBlockOut)
+{
+    memset(ptBlockOut, 0, sizeof(plJsonBlock));
+
+#ifdef PL_JSON_SSE2
+    const __m128i tBackslash = _mm_set1_epi8('\\');
+    const __m128i tQuote     = _mm_set1_epi8('"');
+    const __m128i tColon     = _mm_set1_epi8(':');
+    const __m128i tComma     = _mm_set1_epi8(',');
+    const __m128i tSpace     = _mm_set1_epi8(' ');
+    const __m128i tTab       = _mm_set1_epi8('\t');
+    const __m128i tNewLine   = _mm_set1_epi8('\n');
+    const __m128i tReturn    = _mm_set1_epi8('\r');
+    const __m128i tControl   = _mm_set1_epi8(0x1F);
+    const __m128i tBracket   = _mm_set1_epi8(0x5B); // '[' & '{' only differ by 0x20 (same for ']' & '}')
+    const __m128i tBrace     = _mm_set1_epi8(0x5D);
+    const __m128i tCaseMask  = _mm_set1_epi8((char)0xDF);
+
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const __m128i tChunk = _mm_loadu_si128((const __m128i*)&puBlock[i * 16]);
+        const __m128i tFolded = _mm_and_si128(tChunk, tCaseMask);
+        const uint32_t uShift = i * 16;
+
+        const __m128i tStructural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(tFolded, tBracket), _mm_cmpeq_epi8(tFolded, tBrace)),
+            _mm_or_si128(_mm_cmpeq_epi8(tChunk, tColon), _mm_cmpeq_epi8(tChunk, tComma)));
+        const __m128i tWhitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(tChunk, tSpace), _mm_cmpeq_epi8(tChunk, tTab)),
+            _mm_or_si128(_mm_cmpeq_epi8(tChunk, tNewLine), _mm_cmpeq_epi8(tChunk, tReturn)));
+
+        // unsigned compare (x <= 0x1F)
+        const __m128i tIsControl = _mm_cmpeq_epi8(_mm_max_epu8(tChunk, tControl), tControl);
+
+        ptBlockOut->uBackslash  |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tChunk, tBackslash)) << uShift;
+        ptBlockOut->uQuote      |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tChunk, tQuote)) << uShift;
+        ptBlockOut->uStructural |= (uint64_t)(uint32_t)_mm_movemask_epi8(tStructural) << uShift;
+        ptBlockOut->uWhitespace |= (uint64_t)(uint32_t)_mm_movemask_epi8(tWhitespace) << uShift;
+        ptBlockOut->uControl    |= (uint64_t)(uint32_t)_mm_movemask_epi8(tIsControl) << uShift;
+        ptBlockOut->uNonAscii   |= (uint64_t)(uint32_t)_mm_movemask_epi8(tChunk) << uShift;
+    }
+#else
+    for(uint32_t i = 0; i < 64; i++)
     {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "%i", piValues[i]);
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+        const uint64_t uBit = 1ull << i;
+        const uint8_t uChar = puBlock[i];
+        switch(uChar)
+        {
+            case '\\': ptBlockOut->uBackslash |= uBit; break;
+            case '"':  ptBlockOut->uQuote     |= uBit; break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':  ptBlockOut->uStructural |= uBit; break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r': ptBlockOut->uWhitespace |= uBit; break;
+            default: break;
+        }
+        if(uChar < 0x20)  ptBlockOut->uControl  |= uBit;
+        if(uChar >= 0x80) ptBlockOut->uNonAscii |= uBit;
+    }
+#endif
+}
+
+// characters escaped by an odd length run of backslashes (carries across blocks)
+static inline uint64_t
+pl__json_find_escaped(uint64_t uBackslash, uint64_t* puPrevEscaped)
+{
+    const uint64_t uEvenBits = 0x5555555555555555ull;
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "%i", piValues[i]);
+    uBackslash &= ~*puPrevEscaped;
+    const uint64_t uFollowsEscape = (uBackslash << 1) | *puPrevEscaped;
+    const uint64_t uOddSequenceStarts = uBackslash & ~uEvenBits & ~uFollowsEscape;
 
-    }
+    const uint64_t uSequencesStartingOnEvenBits = uOddSequenceStarts + uBackslash;
+    *puPrevEscaped = uSequencesStartingOnEvenBits < uOddSequenceStarts ? 1 : 0; // overflow
 
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    const uint64_t uInvertMask = uSequencesStartingOnEvenBits << 1;
+    return (uEvenBits ^ uInvertMask) & uFollowsEscape;
 }
 
-void
-pl_json_add_uint_array(plJsonObject* ptJson, const char* pcName, uint32_t* puValues, uint32_t uSize)
+// bit i set when an odd number of bits at or below i are set
+static inline uint64_t
+pl__json_prefix_xor(uint64_t uValue)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    uValue ^= uValue << 1;
+    uValue ^= uValue << 2;
+    uValue ^= uValue << 4;
+    uValue ^= uValue << 8;
+    uValue ^= uValue << 16;
+    uValue ^= uValue << 32;
+    return uValue;
+}
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+static inline bool
+pl__json_is_hex(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
 
-    for(uint32_t i = 0; i < uSize; i++)
+static bool
+pl__json_validate_escape(const char* pcJson, uint32_t uLength, uint32_t uPos)
+{
+    if(uPos >= uLength)
+        return false;
+
+    switch(pcJson[uPos])
+    {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            return true;
+        case 'u':
+            if(uLength - uPos < 5)
+                return false;
+            return pl__json_is_hex(pcJson[uPos + 1]) && pl__json_is_hex(pcJson[uPos + 2]) &&
+                pl__json_is_hex(pcJson[uPos + 3]) && pl__json_is_hex(pcJson[uPos + 4]);
+        default:
+            return false;
+    }
+}
+
+static bool
+pl__json_validate_utf8(const uint8_t* puText, uint32_t uLength)
+{
+    uint32_t i = 0;
+    while(i < uLength)
     {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "%u", puValues[i]);
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+        const uint8_t uLead = puText[i];
+        if(uLead < 0x80)
+        {
+            i++;
+            continue;
+        }
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "%u", puValues[i]);
+        // continuation count & valid range of the second byte (rejects overlongs & surrogates)
+        uint32_t uContinuations = 0;
+        uint8_t uMin = 0x80;
+        uint8_t uMax = 0xBF;
+        if     (uLead >= 0xC2 && uLead <= 0xDF) { uContinuations = 1; }
+        else if(uLead == 0xE0)                  { uContinuations = 2; uMin = 0xA0; }
+        else if(uLead >= 0xE1 && uLead <= 0xEC) { uContinuations = 2; }
+        else if(uLead == 0xED)                  { uContinuations = 2; uMax = 0x9F; }
+        else if(uLead >= 0xEE && uLead <= 0xEF) { uContinuations = 2; }
+        else if(uLead == 0xF0)                  { uContinuations = 3; uMin = 0x90; }
+        else if(uLead >= 0xF1 && uLead <= 0xF3) { uContinuations = 3; }
+        else if(uLead == 0xF4)                  { uContinuations = 3; uMax = 0x8F; }
+        else
+            return false;
 
+        if(uLength - i <= uContinuations)
+            return false;
+        if(puText[i + 1] < uMin || puText[i + 1] > uMax)
+            return false;
+        for(uint32_t j = 2; j <= uContinuations; j++)
+        {
+            if((puText[i + j] & 0xC0) != 0x80)
+                return false;
+        }
+        i += uContinuations + 1;
     }
-
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    return true;
 }
 
-void
-pl_json_add_float_array(plJsonObject* ptJson, const char* pcName, float* pfValues, uint32_t uSize)
+static bool
+pl__json_structural_index(const char* pcJson, uint32_t uLength, uint32_t** psbuIndexOut)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    uint64_t uPrevEscaped  = 0;
+    uint64_t uPrevInString = 0;
+    uint64_t uPrevScalar   = 0;
+    uint64_t uNonAscii     = 0;
+    uint64_t uErrors       = 0;
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+    uint32_t* sbuIndex = *psbuIndexOut;
+    pl_sb_json_reserve(sbuIndex, 64);
+    pl_sb_json_reset(sbuIndex);
 
-    for(uint32_t i = 0; i < uSize; i++)
+    for(uint32_t uBlockStart = 0; uBlockStart < uLength; uBlockStart += 64)
     {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "%0.7f", pfValues[i]);
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+        // pad the final block with whitespace
+        const uint8_t* puBlock = (const uint8_t*)&pcJson[uBlockStart];
+        uint8_t auPadded[64];
+        if(uLength - uBlockStart < 64)
+        {
+            memset(auPadded, ' ', 64);
+            memcpy(auPadded, puBlock, uLength - uBlockStart);
+            puBlock = auPadded;
+        }
+
+        plJsonBlock tBlock;
+        pl__json_classify_block(puBlock, &tBlock);
+
+        const uint64_t uEscaped = pl__json_find_escaped(tBlock.uBackslash, &uPrevEscaped);
+        const uint64_t uQuote = tBlock.uQuote & ~uEscaped;
+
+        // inside strings (opening quote included, closing quote excluded)
+        const uint64_t uInString = pl__json_prefix_xor(uQuote) ^ uPrevInString;
+        uPrevInString = (uint64_t)((int64_t)uInString >> 63);
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "%0.7f", pfValues[i]);
+        // first character of each run of scalar (number/literal) characters
+        const uint64_t uScalar = ~(tBlock.uStructural | tBlock.uWhitespace | uQuote | uInString);
+        const uint64_t uScalarStart = uScalar & ~((uScalar << 1) | uPrevScalar);
+        uPrevScalar = uScalar >> 63;
 
+        // unescaped control characters aren't allowed in strings
+        uErrors |= tBlock.uControl & uInString;
+        uNonAscii |= tBlock.uNonAscii;
+
+        // escapes are rare, validate them individually
+        uint64_t uEscapes = uEscaped & uInString;
+        while(uEscapes)
+        {
+            if(!pl__json_validate_escape(pcJson, uLength, uBlockStart + pl__json_ctz64(uEscapes)))
+                uErrors = 1;
+            uEscapes &= uEscapes - 1;
+        }
+
+        // append positions (grows geometrically)
+        uint64_t uStructurals = (tBlock.uStructural & ~uInString) | uQuote | uScalarStart;
+        uint32_t uSize = pl_sb_json_size(sbuIndex);
+        if(uSize + 64 > pl_sb_json_capacity(sbuIndex))
+            pl_sb_json_reserve(sbuIndex, pl_sb_json_capacity(sbuIndex));
+        while(uStructurals)
+        {
+            sbuIndex[uSize++] = uBlockStart + pl__json_ctz64(uStructurals);
+            uStructurals &= uStructurals - 1;
+        }
+        pl__sb_json_header(sbuIndex)->uSize = uSize;
     }
 
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    *psbuIndexOut = sbuIndex;
+
+    // unterminated string
+    if(uPrevInString || uErrors)
+        return false;
+
+    if(uNonAscii)
+        return pl__json_validate_utf8((const uint8_t*)pcJson, uLength);
+    return true;
 }
 
-void
-pl_json_add_double_array(plJsonObject* ptJson, const char* pcName, double* pdValues, uint32_t uSize)
+//-----------------------------------------------------------------------------
+// [SECTION] stage 2 (tape)
+//-----------------------------------------------------------------------------
+
+static inline bool
+pl__json_is_delimiter(char c)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    switch(c)
+    {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case ',':
+        case ':':
+        case '}':
+        case ']':
+        case '{':
+        case '[':
+            return true;
+        default:
+            return false;
+    }
+}
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+static bool
+pl__json_parse_scalar(const char* pcJson, uint32_t uLength, uint32_t uPos, plJsonToken* ptTokenOut)
+{
+    uint32_t uEnd = uPos;
+    switch(pcJson[uPos])
+    {
+        case 't':
+            if(uLength - uPos < 4 || memcmp(&pcJson[uPos], "true", 4) != 0) return false;
+            ptTokenOut->tType = PL_JSON_TYPE_BOOL;
+            uEnd += 4;
+            break;
 
-    for(uint32_t i = 0; i < uSize; i++)
+        case 'f':
+            if(uLength - uPos < 5 || memcmp(&pcJson[uPos], "false", 5) != 0) return false;
+            ptTokenOut->tType = PL_JSON_TYPE_BOOL;
+            uEnd += 5;
+            break;
+
+        case 'n':
+            if(uLength - uPos < 4 || memcmp(&pcJson[uPos], "null", 4) != 0) return false;
+            ptTokenOut->tType = PL_JSON_TYPE_NULL;
+            uEnd += 4;
+            break;
+
+        default:
+        {
+            // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+            ptTokenOut->tType = PL_JSON_TYPE_NUMBER;
+            if(pcJson[uEnd] == '-')
+                uEnd++;
+            if(uEnd >= uLength)
+                return false;
+            if(pcJson[uEnd] == '0')
+                uEnd++;
+            else if(pcJson[uEnd] >= '1' && pcJson[uEnd] <= '9')
+            {
+                while(uEnd < uLength && pcJson[uEnd] >= '0' && pcJson[uEnd] <= '9')
+                    uEnd++;
+            }
+            else
+                return false;
+
+            if(uEnd < uLength && pcJson[uEnd] == '.')
+            {
+                uEnd++;
+                if(uEnd >= uLength || pcJson[uEnd] < '0' || pcJson[uEnd] > '9')
+                    return false;
+                while(uEnd < uLength && pcJson[uEnd] >= '0' && pcJson[uEnd] <= '9')
+                    uEnd++;
+            }
+
+            if(uEnd < uLength && (pcJson[uEnd] == 'e' || pcJson[uEnd] == 'E'))
+            {
+                uEnd++;
+                if(uEnd < uLength && (pcJson[uEnd] == '+' || pcJson[uEnd] == '-'))
+                    uEnd++;
+                if(uEnd >= uLength || pcJson[uEnd] < '0' || pcJson[uEnd] > '9')
+                    return false;
+                while(uEnd < uLength && pcJson[uEnd] >= '0' && pcJson[uEnd] <= '9')
+                    uEnd++;
+            }
+            break;
+        }
+    }
+
+    if(uEnd < uLength && !pl__json_is_delimiter(pcJson[uEnd]))
+        return false;
+
+    ptTokenOut->uStart = uPos;
+    ptTokenOut->uEnd = uEnd;
+    ptTokenOut->uSize = 0;
+    return true;
+}
+
+static bool
+pl__json_build_tape(const char* pcJson, uint32_t uLength, const uint32_t* auIndex, uint32_t uIndexCount, plJsonToken* atTape, uint32_t* puTokenCountOut)
+{
+    uint32_t auStack[PL_JSON_MAX_DEPTH]; // tape index of open containers
+    uint32_t uDepth = 0;
+    uint32_t uTokenCount = 0;
+    int tState = PL_JSON_PARSE_STATE_VALUE;
+
+    for(uint32_t i = 0; i < uIndexCount; i++)
     {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "%0.15f", pdValues[i]);
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+        const uint32_t uPos = auIndex[i];
+        const char c = pcJson[uPos];
+        bool bValue = false;
+        bool bClose = false;
+
+        switch(tState)
+        {
+            case PL_JSON_PARSE_STATE_VALUE:
+                bValue = true;
+                break;
+
+            case PL_JSON_PARSE_STATE_ARRAY_FIRST:
+                if(c == ']') bClose = true;
+                else         bValue = true;
+                break;
+
+            case PL_JSON_PARSE_STATE_ARRAY_NEXT:
+                if     (c == ',') tState = PL_JSON_PARSE_STATE_VALUE;
+                else if(c == ']') bClose = true;
+                else              return false;
+                break;
+
+            case PL_JSON_PARSE_STATE_OBJECT_FIRST:
+                if(c == '}')
+                {
+                    bClose = true;
+                    break;
+                }
+                // fallthrough
+
+            case PL_JSON_PARSE_STATE_OBJECT_KEY:
+            {
+                // stage 1 guarantees the next index is the closing quote
+                if(c != '"' || i + 1 >= uIndexCount)
+                    return false;
+                plJsonToken* ptKey = &atTape[uTokenCount++];
+                ptKey->tType = PL_JSON_TYPE_STRING;
+                ptKey->uStart = uPos + 1;
+                ptKey->uEnd = auIndex[++i];
+                ptKey->uSize = 0;
+                atTape[auStack[uDepth - 1]].uSize++;
+                tState = PL_JSON_PARSE_STATE_OBJECT_COLON;
+                break;
+            }
+
+            case PL_JSON_PARSE_STATE_OBJECT_COLON:
+                if(c != ':')
+                    return false;
+                tState = PL_JSON_PARSE_STATE_VALUE;
+                break;
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "%0.15f", pdValues[i]);
+            case PL_JSON_PARSE_STATE_OBJECT_NEXT:
+                if     (c == ',') tState = PL_JSON_PARSE_STATE_OBJECT_KEY;
+                else if(c == '}') bClose = true;
+                else              return false;
+                break;
+
+            default: // content after root value
+                return false;
+        }
+
+        if(bValue)
+        {
+            plJsonToken* ptToken = &atTape[uTokenCount];
+            if(uDepth > 0 && atTape[auStack[uDepth - 1]].tType == PL_JSON_TYPE_ARRAY)
+                atTape[auStack[uDepth - 1]].uSize++;
+
+            if(c == '{' || c == '[')
+            {
+                if(uDepth == PL_JSON_MAX_DEPTH)
+                    return false;
+                ptToken->tType = c == '{' ? PL_JSON_TYPE_OBJECT : PL_JSON_TYPE_ARRAY;
+                ptToken->uStart = uPos;
+                ptToken->uEnd = uPos;
+                ptToken->uSize = 0;
+                auStack[uDepth++] = uTokenCount++;
+                tState = c == '{' ? PL_JSON_PARSE_STATE_OBJECT_FIRST : PL_JSON_PARSE_STATE_ARRAY_FIRST;
+                continue;
+            }
+            else if(c == '"')
+            {
+                if(i + 1 >= uIndexCount)
+                    return false;
+                ptToken->tType = PL_JSON_TYPE_STRING;
+                ptToken->uStart = uPos + 1;
+                ptToken->uEnd = auIndex[++i];
+                ptToken->uSize = 0;
+            }
+            else if(!pl__json_parse_scalar(pcJson, uLength, uPos, ptToken))
+                return false;
+            uTokenCount++;
+        }
+        else if(bClose)
+            atTape[auStack[--uDepth]].uEnd = uPos + 1;
+        else
+            continue;
 
+        // value complete
+        if(uDepth == 0)
+            tState = PL_JSON_PARSE_STATE_DONE;
+        else if(atTape[auStack[uDepth - 1]].tType == PL_JSON_TYPE_OBJECT)
+            tState = PL_JSON_PARSE_STATE_OBJECT_NEXT;
+        else
+            tState = PL_JSON_PARSE_STATE_ARRAY_NEXT;
     }
 
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    *puTokenCountOut = uTokenCount;
+    return tState == PL_JSON_PARSE_STATE_DONE;
 }
 
-void
-pl_json_add_bool_array(plJsonObject* ptJson, const char* pcName, bool* pbValues, uint32_t uSize)
+//-----------------------------------------------------------------------------
+// [SECTION] internal api implementation
+//-----------------------------------------------------------------------------
+
+static uint32_t
+pl__build_json_object(plJsonDocument* ptDocument, plJsonToken* atTape, uint32_t uToken, plJsonObject* ptJson, uint32_t* puNodeCursor, uint32_t* puValueCursor)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
-    ptJson->tType = PL_JSON_TYPE_OBJECT;
+    char* pcBuffer = ptDocument->sbcBuffer;
+    const plJsonToken* ptToken = &atTape[uToken++];
 
-    plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
-    tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+    ptJson->ptRootObject = &ptDocument->tRoot;
+    ptJson->tType = ptToken->tType;
 
-    for(uint32_t i = 0; i < uSize; i++)
+    switch(ptToken->tType)
+    {
+        case PL_JSON_TYPE_OBJECT:
+        {
+            ptJson->uChildCount = ptToken->uSize;
+            ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN;
+            if(ptJson->uChildCount > 0)
+            {
+                ptJson->sbtChildren = &ptDocument->sbtNodes[*puNodeCursor];
+                *puNodeCursor += ptJson->uChildCount;
+            }
+
+            for(uint32_t i = 0; i < ptJson->uChildCount; i++)
+            {
+                const plJsonToken* ptKeyToken = &atTape[uToken++];
+                plJsonObject* ptMember = &ptJson->sbtChildren[i];
+                ptMember->uNameOffset = ptKeyToken->uStart;
+                ptMember->uNameLength = ptKeyToken->uEnd - ptKeyToken->uStart;
+                pcBuffer[ptKeyToken->uEnd] = 0; // closing quote
+                uToken = pl__build_json_object(ptDocument, atTape, uToken, ptMember, puNodeCursor, puValueCursor);
+            }
+            break;
+        }
+
+        case PL_JSON_TYPE_ARRAY:
+        {
+            ptJson->uChildCount = ptToken->uSize;
+            ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN;
+            if(ptJson->uChildCount == 0)
+                break;
+
+            ptJson->sbtChildren = &ptDocument->sbtNodes[*puNodeCursor];
+            *puNodeCursor += ptJson->uChildCount;
+
+            uint32_t* puOffsets = &ptDocument->sbuValues[*puValueCursor];
+            uint32_t* puLengths = &puOffsets[ptJson->uChildCount];
+            *puValueCursor += ptJson->uChildCount * 2;
+
+            // arrays of only strings & primitives also expose flat offsets (used by pl_json_as_*_array)
+            bool bValuesOnly = true;
+            for(uint32_t i = 0; i < ptJson->uChildCount; i++)
+            {
+                const plJsonToken* ptElementToken = &atTape[uToken];
+                if(ptElementToken->tType != PL_JSON_TYPE_OBJECT && ptElementToken->tType != PL_JSON_TYPE_ARRAY)
+                {
+                    puOffsets[i] = ptElementToken->uStart;
+                    puLengths[i] = ptElementToken->uEnd - ptElementToken->uStart;
+                }
+                else
+                    bValuesOnly = false;
+                uToken = pl__build_json_object(ptDocument, atTape, uToken, &ptJson->sbtChildren[i], puNodeCursor, puValueCursor);
+            }
+
+            if(bValuesOnly)
+            {
+                ptJson->sbuValueOffsets = puOffsets;
+                ptJson->sbuValueLength = puLengths;
+                ptJson->uFlags |= PL_JSON_OBJECT_FLAGS_POOLED_VALUES;
+            }
+            break;
+        }
+
+        default:
+        {
+            // parsing is complete so the closing quote or delimiter can be reused as a terminator
+            ptJson->uValueOffset = ptToken->uStart;
+            ptJson->uValueLength = ptToken->uEnd - ptToken->uStart;
+            pcBuffer[ptToken->uEnd] = 0;
+            break;
+        }
+    }
+    return uToken;
+}
+
+static void
+pl__free_json(plJsonObject* ptJson)
+{
+    if(ptJson->sbtChildren)
     {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "%s", pbValues[i] ? "true" : "false");
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+        for(uint32_t i = 0; i < ptJson->uChildCount; i++)
+            pl__free_json(&ptJson->sbtChildren[i]);
+    }
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "%s", pbValues[i] ? "true" : "false");
+    if(!(ptJson->uFlags & PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN))
+    {
+        pl_sb_json_free(ptJson->sbtChildren);
+    }
 
+    if(ptJson->tType == PL_JSON_TYPE_ARRAY && !(ptJson->uFlags & PL_JSON_OBJECT_FLAGS_POOLED_VALUES))
+    {
+        pl_sb_json_free(ptJson->sbuValueOffsets);
+        pl_sb_json_free(ptJson->sbuValueLength);
     }
 
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    if(ptJson->auMemberIndex)
+        PL_JSON_FREE(ptJson->auMemberIndex);
+
+    memset(ptJson, 0, sizeof(plJsonObject));
 }
 
-void
-pl_json_add_string_array(plJsonObject* ptJson, const char* pcName, char** ppcBuffer, uint32_t uSize)
+static plJsonObject*
+pl__json_add_child(plJsonObject* ptJson, const char* pcName, plJsonType tType)
 {
-    ptJson->uChildCount++;
-    ptJson->uChildrenFound++;
     ptJson->tType = PL_JSON_TYPE_OBJECT;
 
+    // loaded documents share a node pool, so move this object's members to their own storage before growing
+    if(ptJson->uFlags & PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN)
+    {
+        plJsonObject* sbtChildren = NULL;
+        if(ptJson->uChildCount > 0)
+        {
+            pl_sb_json_resize(sbtChildren, ptJson->uChildCount);
+            memcpy(sbtChildren, ptJson->sbtChildren, sizeof(plJsonObject) * ptJson->uChildCount);
+        }
+        ptJson->sbtChildren = sbtChildren;
+        ptJson->uFlags &= ~PL_JSON_OBJECT_FLAGS_POOLED_CHILDREN;
+    }
+
+    // invalidate member index
+    if(ptJson->auMemberIndex)
+    {
+        PL_JSON_FREE(ptJson->auMemberIndex);
+        ptJson->auMemberIndex = NULL;
+        ptJson->uMemberIndexMask = 0;
+    }
+
     plJsonObject tNewJsonObject = {0};
-    tNewJsonObject.tType = PL_JSON_TYPE_ARRAY;
+    tNewJsonObject.tType = tType;
     tNewJsonObject.ptRootObject = ptJson->ptRootObject;
-    snprintf(tNewJsonObject.acName, PL_JSON_MAX_NAME_LENGTH, "%s", pcName);
-    tNewJsonObject.sbcBuffer = NULL;
-    tNewJsonObject.uChildCount = uSize;
-    tNewJsonObject.uChildrenFound = uSize;
-    tNewJsonObject.sbuValueLength = NULL;
-    tNewJsonObject.sbuValueOffsets = NULL;
-    pl_sb_json_resize(tNewJsonObject.sbuValueLength, uSize);
-    pl_sb_json_resize(tNewJsonObject.sbuValueOffsets, uSize);
+    tNewJsonObject.uNameLength = (uint32_t)strlen(pcName);
+    tNewJsonObject.uNameOffset = pl__json_push_text(ptJson, pcName, tNewJsonObject.uNameLength, false);
+    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+    ptJson->uChildCount++;
+    return &pl_sb_json_top(ptJson->sbtChildren);
+}
 
-    for(uint32_t i = 0; i < uSize; i++)
-    {
-        const uint32_t uValueOffset = pl_sb_json_size(ptJson->ptRootObject->sbcBuffer);
-        const uint32_t uValueLength = snprintf(NULL, 0, "\"%s\"", ppcBuffer[i]);
-        tNewJsonObject.sbuValueOffsets[i] = uValueOffset;
-        tNewJsonObject.sbuValueLength[i] = uValueLength;
+static uint32_t
+pl__json_push_text(plJsonObject* ptJson, const char* pcText, uint32_t uLength, bool bQuoted)
+{
+    plJsonDocument* ptDocument = pl__json_document(ptJson);
 
-        pl_sb_json_resize(ptJson->ptRootObject->sbcBuffer, uValueOffset + uValueLength + 1);
-        snprintf(&ptJson->ptRootObject->sbcBuffer[uValueOffset], uValueLength + 1, "\"%s\"", ppcBuffer[i]);
+    // leading quote lets the writer distinguish string array values
+    if(bQuoted)
+        pl_sb_json_push(ptDocument->sbcBuffer, '\"');
 
-    }
+    const uint32_t uOffset = pl_sb_json_size(ptDocument->sbcBuffer);
+    pl_sb_json_resize(ptDocument->sbcBuffer, uOffset + uLength + 1);
+    memcpy(&ptDocument->sbcBuffer[uOffset], pcText, uLength);
+    ptDocument->sbcBuffer[uOffset + uLength] = 0;
+    return uOffset;
+}
 
-    pl_sb_json_push(ptJson->sbtChildren, tNewJsonObject);
+static uint32_t
+pl__json_push_number(plJsonObject* ptJson, const char* pcText, uint32_t uLength, uint32_t* puLengthOut)
+{
+    *puLengthOut = uLength;
+    return pl__json_push_text(ptJson, pcText, uLength, false);
 }
 
-//-----------------------------------------------------------------------------
-// [SECTION] internal api implementation
-//-----------------------------------------------------------------------------
+static uint32_t
+pl__json_hash(const char* pcText, uint32_t uLength)
+{
+    // FNV-1a
+    uint32_t uHash = 2166136261u;
+    for(uint32_t i = 0; i < uLength; i++)
+    {
+        uHash ^= (uint8_t)pcText[i];
+        uHash *= 16777619u;
+    }
+    return uHash;
+}
 
-static plJsonType
-pl__get_json_token_object_type(const char* pcJson, jsmntok_t* ptToken)
+static void
+pl__build_json_member_index(plJsonObject* ptJson)
 {
-    switch (ptToken->type)
+    uint32_t uCapacity = 1;
+    while(uCapacity < ptJson->uChildCount * 2)
+        uCapacity <<= 1;
+
+    ptJson->auMemberIndex = PL_JSON_ALLOC(sizeof(uint32_t) * uCapacity);
+    memset(ptJson->auMemberIndex, 0, sizeof(uint32_t) * uCapacity);
+    ptJson->uMemberIndexMask = uCapacity - 1;
+
+    // inserted in order so duplicate names resolve to the first member (matches linear search)
+    const char* pcBuffer = pl__json_document(ptJson)->sbcBuffer;
+    for(uint32_t i = 0; i < ptJson->uChildCount; i++)
     {
-    case JSMN_ARRAY:  return PL_JSON_TYPE_ARRAY;
-    case JSMN_OBJECT: return PL_JSON_TYPE_OBJECT;
-    case JSMN_STRING: return PL_JSON_TYPE_STRING;
-    case JSMN_PRIMITIVE:
-        if     (pcJson[ptToken->start] == 'n')                                      { return PL_JSON_TYPE_NULL;}
-        else if(pcJson[ptToken->start] == 't' || pcJson[ptToken->start] == 'f') { return PL_JSON_TYPE_BOOL;}
-        else                                                                            { return PL_JSON_TYPE_NUMBER;}
-    default:
-        PL_ASSERT(false);
-        break;
+        const plJsonObject* ptMember = &ptJson->sbtChildren[i];
+        uint32_t uSlot = pl__json_hash(&pcBuffer[ptMember->uNameOffset], ptMember->uNameLength) & ptJson->uMemberIndexMask;
+        while(ptJson->auMemberIndex[uSlot])
+            uSlot = (uSlot + 1) & ptJson->uMemberIndexMask;
+        ptJson->auMemberIndex[uSlot] = i + 1;
     }
-    return PL_JSON_TYPE_UNSPECIFIED;
 }
 
+
 static void
 pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSize, uint32_t* puCursor, uint32_t* puDepth)
 {
@@ -1802,22 +3061,22 @@ pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSi
 
         case PL_JSON_TYPE_BOOL:
         {
-            int iSizeNeeded = snprintf(NULL, 0, "%s", (&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
-            snprintf(&pcBuffer[uCursorPosition], iSizeNeeded + 1, "%s", (&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
+            int iSizeNeeded = snprintf(NULL, 0, "%s", (&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
+            snprintf(&pcBuffer[uCursorPosition], iSizeNeeded + 1, "%s", (&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
             uCursorPosition += iSizeNeeded;
             break;
         }
 
         case PL_JSON_TYPE_NUMBER:
         {
-            memcpy(&pcBuffer[uCursorPosition], &ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
+            memcpy(&pcBuffer[uCursorPosition], &pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset], ptJson->uValueLength);
             uCursorPosition += ptJson->uValueLength;
             break;
         }
 
         case PL_JSON_TYPE_STRING:
         {
-            int iSizeNeeded = snprintf(&pcBuffer[uCursorPosition], (int)ptJson->uValueLength + 2 + 1, "\"%s\"", &ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset]);
+            int iSizeNeeded = snprintf(&pcBuffer[uCursorPosition], (int)ptJson->uValueLength + 2 + 1, "\"%s\"", &pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset]);
             uCursorPosition += iSizeNeeded;
             break;
         }
@@ -1839,8 +3098,8 @@ pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSi
                 memset(&pcBuffer[uCursorPosition + 1], 0x20, iSizeNeeded3);
                 uCursorPosition += iSizeNeeded3;
 
-                int iSizeNeeded2 = snprintf(NULL, 0, "\"%s\": ", ptJson->sbtChildren[i].acName);
-                snprintf(&pcBuffer[uCursorPosition], iSizeNeeded2 + 1 , "\"%s\": ", ptJson->sbtChildren[i].acName);
+                int iSizeNeeded2 = (int)ptJson->sbtChildren[i].uNameLength + 4;
+                snprintf(&pcBuffer[uCursorPosition], iSizeNeeded2 + 1, "\"%.*s\": ", (int)ptJson->sbtChildren[i].uNameLength, &pl__json_document(ptJson)->sbcBuffer[ptJson->sbtChildren[i].uNameOffset]);
 
                 uCursorPosition += iSizeNeeded2;
 
@@ -1880,7 +3139,7 @@ pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSi
                 for(uint32_t i = 0; i < ptJson->uChildCount; i++)
                 {
 
-                    const char* pcPrevChar = &ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]];
+                    const char* pcPrevChar = &pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]];
                     char cPreviousChar = ' ';
                     if(pcPrevChar)
                     {
@@ -1892,12 +3151,12 @@ pl__write_json_object(plJsonObject* ptJson, char* pcBuffer, uint32_t* puBufferSi
                     if(cPreviousChar == '\"')
                     {
                         int iSizeNeeded2 = ptJson->sbuValueLength[i] + 2;
-                        snprintf(&pcBuffer[uCursorPosition], iSizeNeeded2 + 1, "\"%s\"", &ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]]);
+                        snprintf(&pcBuffer[uCursorPosition], iSizeNeeded2 + 1, "\"%s\"", &pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]]);
                         uCursorPosition += iSizeNeeded2;
                     }
                     else
                     {
-                        memcpy(&pcBuffer[uCursorPosition], &ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
+                        memcpy(&pcBuffer[uCursorPosition], &pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]], ptJson->sbuValueLength[i]);
                         uCursorPosition += ptJson->sbuValueLength[i];
                     }
                     
@@ -1959,7 +3218,7 @@ pl__check_json_object(plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* pu
         case PL_JSON_TYPE_BOOL:
         {
             
-            int iSizeNeeded = snprintf(NULL, 0, "%s", (&ptJson->ptRootObject->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
+            int iSizeNeeded = snprintf(NULL, 0, "%s", (&pl__json_document(ptJson)->sbcBuffer[ptJson->uValueOffset])[0] == 't' ? "true" : "false");
             uCursorPosition += iSizeNeeded;
             break;
         }
@@ -1990,7 +3249,7 @@ pl__check_json_object(plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* pu
                 int iSizeNeeded3 = *puDepth * 4 + 1;
                 uCursorPosition += iSizeNeeded3;
 
-                int iSizeNeeded2 = snprintf(NULL, 0, "\"%s\": ", ptJson->sbtChildren[i].acName);
+                int iSizeNeeded2 = (int)ptJson->sbtChildren[i].uNameLength + 4;
                 uCursorPosition += iSizeNeeded2;
 
                 pl__check_json_object(&ptJson->sbtChildren[i], &uBufferSize, &uCursorPosition, puDepth);
@@ -2020,7 +3279,7 @@ pl__check_json_object(plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* pu
 
                     // pl__check_json_object(&ptJson->sbtChildren[i], &uBufferSize, &uCursorPosition, puDepth);
 
-                    const char* pcPrevChar = &ptJson->ptRootObject->sbcBuffer[ptJson->sbuValueOffsets[i]];
+                    const char* pcPrevChar = &pl__json_document(ptJson)->sbcBuffer[ptJson->sbuValueOffsets[i]];
                     char cPreviousChar = ' ';
                     if(pcPrevChar)
                     {
@@ -2064,4 +3323,5 @@ pl__check_json_object(plJsonObject* ptJson, uint32_t* puBufferSize, uint32_t* pu
     *puCursor = uCursorPosition;
 }
 
+
 #endif // PL_JSON_IMPLEMENTATION
\ No newline at end of file
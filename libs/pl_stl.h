@@ -2,6 +2,7 @@
    pl_stl.h
      * no dependencies
      * simple asci & binary stl parser
+     * uses pl_number.h for asci floats if it is included before the implementation
      
    Do this:
         #define PL_STL_IMPLEMENTATION
@@ -93,8 +94,9 @@ Index of this file:
 // [SECTION] internal api
 //-----------------------------------------------------------------------------
 
-static bool pl__move_to_next_line(const char* pcData, size_t szDataSize, size_t* pszCurrentPos);
-static char pl__move_to_first_char(const char* pcData, size_t szDataSize, size_t* pszCurrentPos);
+static bool  pl__move_to_next_line (const char* pcData, size_t szDataSize, size_t* pszCurrentPos);
+static char  pl__move_to_first_char(const char* pcData, size_t szDataSize, size_t* pszCurrentPos);
+static float pl__stl_read_float    (const char* pcText, const char* pcTextEnd, const char** ppcEndOut);
 
 //-----------------------------------------------------------------------------
 // [SECTION] public api implementation
@@ -167,11 +169,11 @@ pl_load_stl(const char* pcData, size_t szDataSize, float* afPositionStream, floa
                 if(cFirstChar == 'v')
                 {
                     szCurrentCursor += 6;
-                    const char* pcReturnString = &pcData[szCurrentCursor];
-                    char* pcEnd = NULL;
-                    afPositionStream[szVertexStream0Pos]     = strtof(pcReturnString, &pcEnd);
-                    afPositionStream[szVertexStream0Pos + 1] = strtof(pcEnd, &pcEnd);
-                    afPositionStream[szVertexStream0Pos + 2] = strtof(pcEnd, &pcEnd);
+                    const char* pcDataEnd = &pcData[szDataSize];
+                    const char* pcEnd = &pcData[szCurrentCursor];
+                    afPositionStream[szVertexStream0Pos]     = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
+                    afPositionStream[szVertexStream0Pos + 1] = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
+                    afPositionStream[szVertexStream0Pos + 2] = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
                     afPositionStream += 3;
                 }
             }
@@ -222,12 +224,12 @@ pl_load_stl(const char* pcData, size_t szDataSize, float* afPositionStream, floa
                 if(cFirstChar == 'f')
                 {
                     szCurrentCursor += 12;
-                    const char* pcReturnString = &pcData[szCurrentCursor];
-                    char* pcEnd = NULL;
+                    const char* pcDataEnd = &pcData[szDataSize];
+                    const char* pcEnd = &pcData[szCurrentCursor];
 
-                    const float fNx = strtof(pcReturnString, &pcEnd);
-                    const float fNy = strtof(pcEnd, &pcEnd);
-                    const float fNz = strtof(pcEnd, &pcEnd);
+                    const float fNx = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
+                    const float fNy = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
+                    const float fNz = pl__stl_read_float(pcEnd, pcDataEnd, &pcEnd);
 
                     // vertex 0
                     afNormalStream[szVertexStream1Pos]     = fNx;
@@ -337,4 +339,23 @@ pl__move_to_first_char(const char* pcData, size_t szDataSize, size_t* pszCurrent
     return 0;   
 }
 
-#endif // PL_STL_IMPLEMENTATION
\ No newline at end of file
+static float
+pl__stl_read_float(const char* pcText, const char* pcTextEnd, const char** ppcEndOut)
+{
+    while(pcText < pcTextEnd && (*pcText == ' ' || *pcText == '\t' || *pcText == '\r'))
+        pcText++;
+
+#ifdef PL_NUMBER_H
+    float fValue = 0.0f;
+    pcText += pl_parse_float(pcText, (size_t)(pcTextEnd - pcText), &fValue);
+    *ppcEndOut = pcText;
+    return fValue;
+#else
+    char* pcEnd = NULL;
+    const float fValue = strtof(pcText, &pcEnd);
+    *ppcEndOut = pcEnd;
+    return fValue;
+#endif
+}
+
+#endif // PL_STL_IMPLEMENTATION
@@ -44,22 +44,41 @@ pl_show_ecs_window(plEntity* ptSelectedEntity, plComponentLibrary* ptLibrary, bo
             const float pfRatiosInner[] = {1.0f};
             gptUi->layout_row(PL_UI_LAYOUT_ROW_TYPE_DYNAMIC, 0.0f, 1, pfRatiosInner);
 
-            const uint32_t uEntityCount = pl_sb_size(ptLibrary->tTagComponentManager.sbtEntities);
+            // name filter (prefix, or glob if it has '*' or '?')
+            static char acFilter[256] = {0};
+            static plEntity* sbtFilteredEntities = NULL;
+            gptUi->input_text_hint("##entity filter", "filter", acFilter, 256, PL_UI_INPUT_TEXT_FLAGS_NONE);
+
+            uint32_t uEntityCount = pl_sb_size(ptLibrary->tTagComponentManager.sbtEntities);
+            const plEntity* atEntities = ptLibrary->tTagComponentManager.sbtEntities;
             plTagComponent* sbtTags = ptLibrary->tTagComponentManager.pComponents;
+            const bool bFiltered = acFilter[0] != 0;
+            if(bFiltered)
+            {
+                const bool bGlob = strpbrk(acFilter, "*?") != NULL;
+                uEntityCount = bGlob ? gptEcs->find_entities_by_glob(ptLibrary, acFilter, NULL, 0) : gptEcs->find_entities_by_prefix(ptLibrary, acFilter, NULL, 0);
+                pl_sb_resize(sbtFilteredEntities, uEntityCount);
+                if(bGlob)
+                    gptEcs->find_entities_by_glob(ptLibrary, acFilter, sbtFilteredEntities, uEntityCount);
+                else
+                    gptEcs->find_entities_by_prefix(ptLibrary, acFilter, sbtFilteredEntities, uEntityCount);
+                atEntities = sbtFilteredEntities;
+            }
 
             plUiClipper tClipper = {(uint32_t)uEntityCount};
             while(gptUi->step_clipper(&tClipper))
             {
                 for(uint32_t i = tClipper.uDisplayStart; i < tClipper.uDisplayEnd; i++)
                 {
-                    bool bSelected = ptSelectedEntity->ulData == ptLibrary->tTagComponentManager.sbtEntities[i].ulData;
+                    const plTagComponent* ptTag = bFiltered ? gptEcs->get_component(ptLibrary, PL_COMPONENT_TYPE_TAG, atEntities[i]) : &sbtTags[i];
+                    bool bSelected = ptSelectedEntity->ulData == atEntities[i].ulData;
                     char atBuffer[1024] = {0};
-                    pl_sprintf(atBuffer, "%s, %u", sbtTags[i].acName, ptLibrary->tTagComponentManager.sbtEntities[i].uIndex);
+                    pl_sprintf(atBuffer, "%s, %u", ptTag->acName, atEntities[i].uIndex);
                     if(gptUi->selectable(atBuffer, &bSelected, 0))
                     {
                         if(bSelected)
                         {
-                            *ptSelectedEntity = ptLibrary->tTagComponentManager.sbtEntities[i];
+                            *ptSelectedEntity = atEntities[i];
                             if(ptSelectedEntity->uIndex != UINT32_MAX)
                                 bResult = true;
                                 // gptRenderer->select_entities(ptAppData->uSceneHandle0, 1, &ptAppData->tSelectedEntity);
@@ -308,6 +327,9 @@ pl_show_ecs_window(plEntity* ptSelectedEntity, plComponentLibrary* ptLibrary, bo
 
                     // gptUi->text("Chain Length: %u", ptIKComp->uChainLength);
                     gptUi->text("Iterations: %u", ptIKComp->uIterationCount);
+                    gptUi->slider_float("Tolerance", &ptIKComp->fTolerance, 0.0f, 0.1f, 0);
+                    gptUi->radio_button("CCD", &ptIKComp->tSolver, PL_IK_SOLVER_CCD);
+                    gptUi->radio_button("FABRIK", &ptIKComp->tSolver, PL_IK_SOLVER_FABRIK);
 
                     gptUi->checkbox("Enabled", &ptIKComp->bEnabled);
                     gptUi->end_collapsing_header();
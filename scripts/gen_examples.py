@@ -53,6 +53,8 @@ with pl.project("pilotlight_examples"):
         'example_6',
         'example_8',
         'example_9',
+        'example_10',
+        'example_11',
     ]
 
     for name in examples:
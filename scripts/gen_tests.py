@@ -93,6 +93,177 @@ with pl.project("pilotlight_tests"):
                     pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
                     pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
 
+    # json <-> plBin conversion tool
+    with pl.target("pl_json_bin_tool", pl.TargetType.EXECUTABLE):
+
+        pl.add_source_files("json_bin_tool.c")
+        pl.set_output_binary("pl_json_bin_tool")
+
+        with pl.configuration("debug"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_definitions("_DEBUG")
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-Od", "-MDd", "-Zi")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC", "--debug", "-g")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "--debug", "-g", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
+        with pl.configuration("release"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-O2", "-MD")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
+    # ecs & spatial extension tests/benchmarks
+    with pl.target("pl_ecs_test", pl.TargetType.EXECUTABLE):
+
+        pl.add_source_files("ecs_tests.c")
+        pl.set_output_binary("pl_ecs_test")
+
+        with pl.configuration("debug"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_definitions("_DEBUG")
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-Od", "-MDd", "-Zi")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC", "--debug", "-g")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "--debug", "-g", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
+        with pl.configuration("release"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-O2", "-MD")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
+    # exhaustive pl_number.h float round trip (slow, run on demand)
+    with pl.target("pl_number_exhaustive_test", pl.TargetType.EXECUTABLE):
+
+        pl.add_source_files("number_exhaustive_tests.c")
+        pl.set_output_binary("pl_number_exhaustive_test")
+
+        with pl.configuration("debug"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_definitions("_DEBUG")
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-Od", "-MDd", "-Zi")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC", "--debug", "-g")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "--debug", "-g", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
+        with pl.configuration("release"):
+
+            # win32
+            with pl.platform("Windows"):
+                with pl.compiler("msvc"):
+                    pl.add_compiler_flags("-Zc:preprocessor", "-nologo", "-std:c11", "-W4", "-WX", "-wd4201")
+                    pl.add_compiler_flags("-wd4100", "-wd4996", "-wd4505", "-wd4189", "-wd5105", "-wd4115", "-permissive-")
+                    pl.add_compiler_flags("-O2", "-MD")
+                    pl.add_linker_flags("-incremental:no")
+
+            # linux
+            with pl.platform("Linux"):
+                with pl.compiler("gcc"):
+                    pl.add_link_directories("/usr/lib/x86_64-linux-gnu")
+                    pl.add_dynamic_link_libraries("pthread")
+                    pl.add_compiler_flags("-std=gnu11", "-fPIC")
+                    pl.add_linker_flags("-ldl", "-lm")
+
+            # macos
+            with pl.platform("Darwin"):
+                with pl.compiler("clang"):
+                    pl.add_compiler_flags("-std=c99", "-fmodules", "-ObjC", "-fPIC")
+                    pl.add_link_frameworks("Metal", "MetalKit", "Cocoa", "IOKit", "CoreVideo", "QuartzCore")
+                    pl.add_linker_flags("-Wl,-rpath,/usr/local/lib")
+
 #-----------------------------------------------------------------------------
 # [SECTION] generate scripts
 #-----------------------------------------------------------------------------
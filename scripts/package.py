@@ -33,6 +33,7 @@ extension_headers = [
     "pl_renderer_ext",
     "pl_resource_ext",
     "pl_shader_ext",
+    "pl_spatial_ext",
     "pl_stats_ext",
     "pl_ui_ext",
 ]
@@ -74,6 +74,12 @@
 
     @if exist "../out/pilot_light_test.exe" del "..\out\pilot_light_test.exe"
     @if exist "../out/pilot_light_test_*.pdb" del "..\out\pilot_light_test_*.pdb"
+    @if exist "../out/pl_json_bin_tool.exe" del "..\out\pl_json_bin_tool.exe"
+    @if exist "../out/pl_json_bin_tool_*.pdb" del "..\out\pl_json_bin_tool_*.pdb"
+    @if exist "../out/pl_ecs_test.exe" del "..\out\pl_ecs_test.exe"
+    @if exist "../out/pl_ecs_test_*.pdb" del "..\out\pl_ecs_test_*.pdb"
+    @if exist "../out/pl_number_exhaustive_test.exe" del "..\out\pl_number_exhaustive_test.exe"
+    @if exist "../out/pl_number_exhaustive_test_*.pdb" del "..\out\pl_number_exhaustive_test_*.pdb"
 
 )
 
@@ -117,6 +123,126 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"..
 
 :Exit_pilot_light_test
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_json_bin_tool | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_json_bin_tool
+
+@set PL_DEFINES=-D_DEBUG 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="json_bin_tool.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_json_bin_tool[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_json_bin_tool )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_json_bin_tool.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_json_bin_tool_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_json_bin_tool
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_ecs_test | debug ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_ecs_test
+
+@set PL_DEFINES=-D_DEBUG 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="ecs_tests.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_ecs_test[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_ecs_test )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_ecs_test.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_ecs_test_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_ecs_test
+
+::~~~~~~~~~~~~~~~~~~~~~~ pl_number_exhaustive_test | debug ~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_number_exhaustive_test
+
+@set PL_DEFINES=-D_DEBUG 
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -Od -MDd -Zi 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="number_exhaustive_tests.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_number_exhaustive_test[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_number_exhaustive_test )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_DEFINES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_number_exhaustive_test.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_number_exhaustive_test_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanupdebug
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_number_exhaustive_test
+
 :Cleanupdebug
 
 @echo [1m[36mCleaning...[0m
@@ -160,6 +286,12 @@ goto ExitLabel
 
     @if exist "../out/pilot_light_test.exe" del "..\out\pilot_light_test.exe"
     @if exist "../out/pilot_light_test_*.pdb" del "..\out\pilot_light_test_*.pdb"
+    @if exist "../out/pl_json_bin_tool.exe" del "..\out\pl_json_bin_tool.exe"
+    @if exist "../out/pl_json_bin_tool_*.pdb" del "..\out\pl_json_bin_tool_*.pdb"
+    @if exist "../out/pl_ecs_test.exe" del "..\out\pl_ecs_test.exe"
+    @if exist "../out/pl_ecs_test_*.pdb" del "..\out\pl_ecs_test_*.pdb"
+    @if exist "../out/pl_number_exhaustive_test.exe" del "..\out\pl_number_exhaustive_test.exe"
+    @if exist "../out/pl_number_exhaustive_test_*.pdb" del "..\out\pl_number_exhaustive_test_*.pdb"
 
 )
 
@@ -202,6 +334,123 @@ cl %PL_INCLUDE_DIRECTORIES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pilot_li
 
 :Exit_pilot_light_test
 
+::~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_json_bin_tool | release ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_json_bin_tool
+
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="json_bin_tool.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_json_bin_tool[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_json_bin_tool )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_json_bin_tool.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_json_bin_tool_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_json_bin_tool
+
+::~~~~~~~~~~~~~~~~~~~~~~~~~~~~ pl_ecs_test | release ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_ecs_test
+
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="ecs_tests.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_ecs_test[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_ecs_test )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_ecs_test.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_ecs_test_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_ecs_test
+
+::~~~~~~~~~~~~~~~~~~~~~ pl_number_exhaustive_test | release ~~~~~~~~~~~~~~~~~~~~~~
+
+:: skip during hot reload
+@if %PL_HOT_RELOAD_STATUS% equ 1 goto Exit_pl_number_exhaustive_test
+
+@set PL_INCLUDE_DIRECTORIES=-I"../examples" -I"../src" -I"../libs" -I"../extensions" -I"../out" -I"../dependencies/stb" 
+@set PL_LINK_DIRECTORIES=-LIBPATH:"../out" 
+@set PL_COMPILER_FLAGS=-Zc:preprocessor -nologo -std:c11 -W4 -WX -wd4201 -wd4100 -wd4996 -wd4505 -wd4189 -wd5105 -wd4115 -permissive- -O2 -MD 
+@set PL_LINKER_FLAGS=-incremental:no 
+@set PL_SOURCES="number_exhaustive_tests.c" 
+
+:: run compiler (and linker)
+@echo.
+@echo [1m[93mStep: pl_number_exhaustive_test[0m
+@echo [1m[93m~~~~~~~~~~~~~~~~~~~~~~[0m
+@echo [1m[36mCompiling and Linking...[0m
+
+:: skip actual compilation if hot reloading
+@if %PL_HOT_RELOAD_STATUS% equ 1 ( goto Cleanuppl_number_exhaustive_test )
+
+:: call compiler
+cl %PL_INCLUDE_DIRECTORIES% %PL_COMPILER_FLAGS% %PL_SOURCES% -Fe"../out/pl_number_exhaustive_test.exe" -Fo"../out/" -link %PL_LINKER_FLAGS% -PDB:"../out/pl_number_exhaustive_test_%random%.pdb" %PL_LINK_DIRECTORIES%
+
+:: check build status
+@set PL_BUILD_STATUS=%ERRORLEVEL%
+
+:: failed
+@if %PL_BUILD_STATUS% NEQ 0 (
+    @echo [1m[91mCompilation Failed with error code[0m: %PL_BUILD_STATUS%
+    @set PL_RESULT=[1m[91mFailed.[0m
+    goto Cleanuprelease
+)
+
+:: print results
+@echo [36mResult: [0m %PL_RESULT%
+@echo [36m~~~~~~~~~~~~~~~~~~~~~~[0m
+
+:Exit_pl_number_exhaustive_test
+
 :Cleanuprelease
 
 @echo [1m[36mCleaning...[0m
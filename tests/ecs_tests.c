@@ -0,0 +1,1375 @@
+/*
+   ecs_tests.c
+     * tests & benchmarks for the ecs & spatial extensions
+     * builds the extensions directly (no runtime) against minimal memory &
+       api registry implementations; jobs run through pl_job_ext.c on real
+       worker threads
+
+   usage:
+     pl_ecs_test                    runs the test suites
+     pl_ecs_test bench [entities]   runs the system benchmarks
+
+   bench builds a scene of the requested size (default 1000000 entities) &
+   reports per system timings for both the component library & archetype
+   storage backends at 1 to 32 worker threads (best of several runs, wall
+   clock)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] runtime
+// [SECTION] tests
+// [SECTION] benchmarks
+// [SECTION] main
+// [SECTION] unity build
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pl_ecs_ext.c"
+#include "pl_spatial_ext.c"
+#include "pl_job_ext.c"
+#include "pl_test.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] runtime
+//-----------------------------------------------------------------------------
+
+static void*
+test_realloc(void* pBuffer, size_t szSize, const char* pcFile, int iLine)
+{
+    if(szSize == 0)
+    {
+        free(pBuffer);
+        return NULL;
+    }
+    return realloc(pBuffer, szSize);
+}
+
+static const plMemoryI gtTestMemory = {
+    .realloc = test_realloc
+};
+
+// pl_job_ext.c runs the job systems on real worker threads; the thread &
+// atomic apis below stand in for the platform backends (same primitives)
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+
+struct _plAtomicCounter     { volatile int64_t ilValue; };
+struct _plCriticalSection   { CRITICAL_SECTION tHandle; };
+struct _plConditionVariable { CONDITION_VARIABLE tHandle; };
+struct _plThread
+{
+    HANDLE            tHandle;
+    plThreadProcedure ptProcedure;
+    void*             pData;
+};
+
+static DWORD WINAPI
+test_thread_procedure(LPVOID pData)
+{
+    plThread* ptThread = pData;
+    ptThread->ptProcedure(ptThread->pData);
+    return 0;
+}
+#else
+    #include <pthread.h>
+    #include <stdatomic.h>
+
+struct _plAtomicCounter     { atomic_int_fast64_t ilValue; };
+struct _plCriticalSection   { pthread_mutex_t tHandle; };
+struct _plConditionVariable { pthread_cond_t tHandle; };
+struct _plThread            { pthread_t tHandle; };
+#endif
+
+#define PL_TEST_MAX_THREADS 32
+#define PL_TEST_DEFAULT_THREADS 4
+
+static plOSResult
+test_create_thread(plThreadProcedure ptProcedure, void* pData, plThread** pptThreadOut)
+{
+    plThread* ptThread = malloc(sizeof(plThread));
+    #ifdef _WIN32
+        ptThread->ptProcedure = ptProcedure;
+        ptThread->pData = pData;
+        ptThread->tHandle = CreateThread(NULL, 0, test_thread_procedure, ptThread, 0, NULL);
+        PL_ASSERT(ptThread->tHandle);
+    #else
+        const int iResult = pthread_create(&ptThread->tHandle, NULL, ptProcedure, pData);
+        PL_ASSERT(iResult == 0);
+        (void)iResult;
+    #endif
+    *pptThreadOut = ptThread;
+    return PL_OS_RESULT_SUCCESS;
+}
+
+static void
+test_destroy_thread(plThread** pptThread)
+{
+    #ifdef _WIN32
+        WaitForSingleObject((*pptThread)->tHandle, INFINITE);
+        CloseHandle((*pptThread)->tHandle);
+    #else
+        pthread_join((*pptThread)->tHandle, NULL);
+    #endif
+    free(*pptThread);
+    *pptThread = NULL;
+}
+
+static uint32_t
+test_get_hardware_thread_count(void)
+{
+    // lets the tests pick any worker count up to PL_TEST_MAX_THREADS
+    // (pl_job_ext.c clamps requests to one less than the hardware count)
+    return PL_TEST_MAX_THREADS + 1;
+}
+
+static plOSResult
+test_create_critical_section(plCriticalSection** pptCriticalSectionOut)
+{
+    *pptCriticalSectionOut = malloc(sizeof(plCriticalSection));
+    #ifdef _WIN32
+        InitializeCriticalSection(&(*pptCriticalSectionOut)->tHandle);
+    #else
+        pthread_mutex_init(&(*pptCriticalSectionOut)->tHandle, NULL);
+    #endif
+    return PL_OS_RESULT_SUCCESS;
+}
+
+static void
+test_destroy_critical_section(plCriticalSection** pptCriticalSection)
+{
+    #ifdef _WIN32
+        DeleteCriticalSection(&(*pptCriticalSection)->tHandle);
+    #else
+        pthread_mutex_destroy(&(*pptCriticalSection)->tHandle);
+    #endif
+    free(*pptCriticalSection);
+    *pptCriticalSection = NULL;
+}
+
+static void
+test_enter_critical_section(plCriticalSection* ptCriticalSection)
+{
+    #ifdef _WIN32
+        EnterCriticalSection(&ptCriticalSection->tHandle);
+    #else
+        pthread_mutex_lock(&ptCriticalSection->tHandle);
+    #endif
+}
+
+static void
+test_leave_critical_section(plCriticalSection* ptCriticalSection)
+{
+    #ifdef _WIN32
+        LeaveCriticalSection(&ptCriticalSection->tHandle);
+    #else
+        pthread_mutex_unlock(&ptCriticalSection->tHandle);
+    #endif
+}
+
+static plOSResult
+test_create_condition_variable(plConditionVariable** pptConditionVariableOut)
+{
+    *pptConditionVariableOut = malloc(sizeof(plConditionVariable));
+    #ifdef _WIN32
+        InitializeConditionVariable(&(*pptConditionVariableOut)->tHandle);
+    #else
+        pthread_cond_init(&(*pptConditionVariableOut)->tHandle, NULL);
+    #endif
+    return PL_OS_RESULT_SUCCESS;
+}
+
+static void
+test_destroy_condition_variable(plConditionVariable** pptConditionVariable)
+{
+    #ifndef _WIN32
+        pthread_cond_destroy(&(*pptConditionVariable)->tHandle);
+    #endif
+    free(*pptConditionVariable);
+    *pptConditionVariable = NULL;
+}
+
+static void
+test_wake_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    #ifdef _WIN32
+        WakeConditionVariable(&ptConditionVariable->tHandle);
+    #else
+        pthread_cond_signal(&ptConditionVariable->tHandle);
+    #endif
+}
+
+static void
+test_wake_all_condition_variable(plConditionVariable* ptConditionVariable)
+{
+    #ifdef _WIN32
+        WakeAllConditionVariable(&ptConditionVariable->tHandle);
+    #else
+        pthread_cond_broadcast(&ptConditionVariable->tHandle);
+    #endif
+}
+
+static void
+test_sleep_condition_variable(plConditionVariable* ptConditionVariable, plCriticalSection* ptCriticalSection)
+{
+    // workers check the queue before taking the lock, so a wake up can land
+    // just before they sleep; waking every millisecond keeps the frequent
+    // initialize/cleanup cycles of the tests from waiting on a lost wake up
+    #ifdef _WIN32
+        SleepConditionVariableCS(&ptConditionVariable->tHandle, &ptCriticalSection->tHandle, 1);
+    #else
+        struct timespec tDeadline = {0};
+        timespec_get(&tDeadline, TIME_UTC);
+        tDeadline.tv_nsec += 1000000;
+        if(tDeadline.tv_nsec >= 1000000000)
+        {
+            tDeadline.tv_sec++;
+            tDeadline.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&ptConditionVariable->tHandle, &ptCriticalSection->tHandle, &tDeadline);
+    #endif
+}
+
+static plOSResult
+test_create_atomic_counter(int64_t ilValue, plAtomicCounter** pptCounterOut)
+{
+    *pptCounterOut = malloc(sizeof(plAtomicCounter));
+    #ifdef _WIN32
+        (*pptCounterOut)->ilValue = ilValue;
+    #else
+        atomic_init(&(*pptCounterOut)->ilValue, ilValue);
+    #endif
+    return PL_OS_RESULT_SUCCESS;
+}
+
+static void
+test_destroy_atomic_counter(plAtomicCounter** pptCounter)
+{
+    free(*pptCounter);
+    *pptCounter = NULL;
+}
+
+static void
+test_atomic_store(plAtomicCounter* ptCounter, int64_t ilValue)
+{
+    #ifdef _WIN32
+        InterlockedExchange64(&ptCounter->ilValue, ilValue);
+    #else
+        atomic_store(&ptCounter->ilValue, ilValue);
+    #endif
+}
+
+static int64_t
+test_atomic_load(plAtomicCounter* ptCounter)
+{
+    #ifdef _WIN32
+        return InterlockedCompareExchange64(&ptCounter->ilValue, 0, 0);
+    #else
+        return atomic_load(&ptCounter->ilValue);
+    #endif
+}
+
+static bool
+test_atomic_compare_exchange(plAtomicCounter* ptCounter, int64_t ilExpectedValue, int64_t ilDesiredValue)
+{
+    #ifdef _WIN32
+        return InterlockedCompareExchange64(&ptCounter->ilValue, ilDesiredValue, ilExpectedValue) == ilExpectedValue;
+    #else
+        return atomic_compare_exchange_strong(&ptCounter->ilValue, &ilExpectedValue, ilDesiredValue);
+    #endif
+}
+
+static int64_t
+test_atomic_decrement(plAtomicCounter* ptCounter)
+{
+    #ifdef _WIN32
+        return InterlockedDecrement64(&ptCounter->ilValue);
+    #else
+        return atomic_fetch_sub(&ptCounter->ilValue, 1) - 1;
+    #endif
+}
+
+static const plThreadsI gtTestThreads = {
+    .create_thread               = test_create_thread,
+    .destroy_thread              = test_destroy_thread,
+    .get_hardware_thread_count   = test_get_hardware_thread_count,
+    .create_critical_section     = test_create_critical_section,
+    .destroy_critical_section    = test_destroy_critical_section,
+    .enter_critical_section      = test_enter_critical_section,
+    .leave_critical_section      = test_leave_critical_section,
+    .create_condition_variable   = test_create_condition_variable,
+    .destroy_condition_variable  = test_destroy_condition_variable,
+    .wake_condition_variable     = test_wake_condition_variable,
+    .wake_all_condition_variable = test_wake_all_condition_variable,
+    .sleep_condition_variable    = test_sleep_condition_variable
+};
+
+static const plAtomicsI gtTestAtomics = {
+    .create_atomic_counter   = test_create_atomic_counter,
+    .destroy_atomic_counter  = test_destroy_atomic_counter,
+    .atomic_store            = test_atomic_store,
+    .atomic_load             = test_atomic_load,
+    .atomic_compare_exchange = test_atomic_compare_exchange,
+    .atomic_decrement        = test_atomic_decrement
+};
+
+// pl_job_ext.c only reads the data registry when hot reloading
+static void  test_set_data(const char* pcName, void* pData) {}
+static void* test_get_data(const char* pcName) { return NULL; }
+
+static const plDataRegistryI gtTestDataRegistry = {
+    .set_data = test_set_data,
+    .get_data = test_get_data
+};
+
+// worker threads currently running jobs (0 until the first test starts them)
+static uint32_t guTestThreadCount = 0;
+
+static void
+test_set_thread_count(uint32_t uThreadCount)
+{
+    if(uThreadCount == guTestThreadCount)
+        return;
+    if(guTestThreadCount > 0)
+        gptJob->cleanup();
+    gptJob->initialize(uThreadCount);
+    guTestThreadCount = uThreadCount;
+}
+
+// worker counts the determinism tests compare against each other
+static const uint32_t gauTestThreadCounts[] = {1, 2, 3, 8, PL_TEST_MAX_THREADS};
+#define PL_TEST_THREAD_COUNT_VARIANTS (sizeof(gauTestThreadCounts) / sizeof(gauTestThreadCounts[0]))
+
+#define PL_TEST_MAX_APIS 16
+
+static struct {
+    const char* pcName;
+    const void* pInterface;
+} gatTestApis[PL_TEST_MAX_APIS];
+
+static const void*
+test_add_api(const char* pcName, const void* pInterface)
+{
+    for(uint32_t i = 0; i < PL_TEST_MAX_APIS; i++)
+    {
+        if(gatTestApis[i].pInterface == NULL)
+        {
+            gatTestApis[i].pcName = pcName;
+            gatTestApis[i].pInterface = pInterface;
+            return pInterface;
+        }
+    }
+    return NULL;
+}
+
+static void
+test_remove_api(const void* pInterface)
+{
+    for(uint32_t i = 0; i < PL_TEST_MAX_APIS; i++)
+    {
+        if(gatTestApis[i].pInterface == pInterface)
+            gatTestApis[i].pInterface = NULL;
+    }
+}
+
+static const void*
+test_next_api_from(uint32_t uStart, const char* pcName)
+{
+    for(uint32_t i = uStart; i < PL_TEST_MAX_APIS; i++)
+    {
+        if(gatTestApis[i].pInterface && strcmp(gatTestApis[i].pcName, pcName) == 0)
+            return gatTestApis[i].pInterface;
+    }
+    return NULL;
+}
+
+static const void*
+test_first_api(const char* pcName)
+{
+    return test_next_api_from(0, pcName);
+}
+
+static const void*
+test_next_api(const void* pPrevInterface)
+{
+    for(uint32_t i = 0; i < PL_TEST_MAX_APIS; i++)
+    {
+        if(gatTestApis[i].pInterface == pPrevInterface)
+            return test_next_api_from(i + 1, gatTestApis[i].pcName);
+    }
+    return NULL;
+}
+
+static const plApiRegistryI gtTestApiRegistry = {
+    .add    = test_add_api,
+    .remove = test_remove_api,
+    .first  = test_first_api,
+    .next   = test_next_api
+};
+
+static const plSpatialI* gptSpatial = NULL;
+
+static void
+test_load_extensions(void)
+{
+    gptApiRegistry  = &gtTestApiRegistry;
+    gptMemory       = &gtTestMemory;
+    gptThreads      = &gtTestThreads;
+    gptAtomics      = &gtTestAtomics;
+    gptDataRegistry = &gtTestDataRegistry;
+
+    plProfileInit tProfileInit = {.uThreadCount = 1};
+    pl_set_profile_context(pl_create_profile_context(tProfileInit));
+    pl_set_log_context(pl_create_log_context());
+
+    pl_load_job_ext((plApiRegistryI*)&gtTestApiRegistry, false);
+    gptJob = gtTestApiRegistry.first(PL_API_JOB);
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+
+    pl_load_ecs_ext((plApiRegistryI*)&gtTestApiRegistry, false);
+    gptECS    = gtTestApiRegistry.first(PL_API_ECS);
+    gptCamera = gtTestApiRegistry.first(PL_API_CAMERA);
+    pl_load_spatial_ext((plApiRegistryI*)&gtTestApiRegistry, false);
+    gptSpatial = gtTestApiRegistry.first(PL_API_SPATIAL);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] tests
+//-----------------------------------------------------------------------------
+
+#include "pl_ecs_tests.h"
+#include "pl_ecs_animation_tests.h"
+#include "pl_ecs_script_tests.h"
+#include "pl_ecs_snapshot_tests.h"
+#include "pl_ecs_fixed_step_tests.h"
+#include "pl_ecs_mesh_tests.h"
+#include "pl_ecs_name_tests.h"
+#include "pl_ecs_render_tests.h"
+#include "pl_spatial_tests.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] benchmarks
+//-----------------------------------------------------------------------------
+
+#define BENCH_RUNS 5
+
+// worker counts the system timings are reported at
+static const uint32_t gauBenchThreadCounts[] = {1, 2, 4, 8, 16, PL_TEST_MAX_THREADS};
+#define PL_BENCH_THREAD_COUNT_VARIANTS (sizeof(gauBenchThreadCounts) / sizeof(gauBenchThreadCounts[0]))
+
+// wall clock (clock() would add up the cpu time of every worker thread)
+static double
+bench_now_ms(void)
+{
+    struct timespec tNow = {0};
+    timespec_get(&tNow, TIME_UTC);
+    return (double)tNow.tv_sec * 1000.0 + (double)tNow.tv_nsec / 1000000.0;
+}
+
+static double
+elapsed_ms(double dStart)
+{
+    return bench_now_ms() - dStart;
+}
+
+typedef void (*plBenchLibrarySystem)(plComponentLibrary*);
+typedef void (*plBenchStorageSystem)(plArchetypeStorage*);
+
+// hierarchy & object passes resolving every component through hashed lookups
+// (what the systems did before cached queries)
+static void
+bench_lookup_hierarchy(plComponentLibrary* ptLibrary)
+{
+    const uint32_t uCount = pl_sb_size(ptLibrary->tHierarchyComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plEntity tChild = ptLibrary->tHierarchyComponentManager.sbtEntities[i];
+        const plHierarchyComponent* ptHierarchy = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tChild);
+        const plTransformComponent* ptParent = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptHierarchy->tParent);
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tChild);
+        if(ptParent && ptTransform)
+            ptTransform->tWorld = pl_mul_mat4(&ptParent->tWorld, &ptTransform->tWorld);
+    }
+}
+
+static void
+bench_lookup_objects(plComponentLibrary* ptLibrary)
+{
+    const plObjectComponent* sbtObjects = ptLibrary->tObjectComponentManager.pComponents;
+    const uint32_t uCount = pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        const plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtObjects[i].tTransform);
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh);
+        pl__ecs_update_mesh_aabb(ptMesh, &ptTransform->tWorld);
+    }
+}
+
+// despawning 100k objects (all & a random half) directly vs through a command buffer
+static void
+bench_despawn(void)
+{
+    const uint32_t uObjectCount = 100000;
+    plEntity* sbtEntities = NULL;
+    pl_sb_resize(sbtEntities, uObjectCount);
+
+    printf("\ndespawn            remove_entity    record  playback\n");
+    for(uint32_t uPass = 0; uPass < 2; uPass++)
+    {
+        const uint32_t uRemoveCount = uPass == 0 ? uObjectCount : uObjectCount / 2;
+
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tLibrary);
+        ecs_test_build_objects(&tLibrary, uObjectCount);
+        memcpy(sbtEntities, tLibrary.tObjectComponentManager.sbtEntities, uObjectCount * sizeof(plEntity));
+        guEcsTestSeed = 12345;
+        for(uint32_t i = uObjectCount - 1; i > 0; i--)
+        {
+            const uint32_t j = (uint32_t)(ecs_test_rand() * (float)i);
+            const plEntity tTemp = sbtEntities[i];
+            sbtEntities[i] = sbtEntities[j];
+            sbtEntities[j] = tTemp;
+        }
+        double dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uRemoveCount; i++)
+            gptECS->remove_entity(&tLibrary, sbtEntities[i]);
+        const double dDirect = elapsed_ms(dStart);
+        gptECS->cleanup_component_library(&tLibrary);
+
+        // same entities & order, so both paths do identical work
+        gptECS->init_component_library(&tLibrary);
+        ecs_test_build_objects(&tLibrary, uObjectCount);
+        plEcsCommandBuffer* ptBuffer = gptECS->create_command_buffer(&tLibrary);
+        dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uRemoveCount; i++)
+            gptECS->cmd_remove_entity(ptBuffer, sbtEntities[i]);
+        const double dRecord = elapsed_ms(dStart);
+        dStart = bench_now_ms();
+        gptECS->playback_command_buffers(&tLibrary, 1, &ptBuffer);
+        const double dPlayback = elapsed_ms(dStart);
+        gptECS->cleanup_command_buffer(&ptBuffer);
+        gptECS->cleanup_component_library(&tLibrary);
+
+        printf("%-6s %6u %11.2f ms %6.2f ms %6.2f ms\n", uPass == 0 ? "all" : "random", uRemoveCount, dDirect, dRecord, dPlayback);
+    }
+    pl_sb_free(sbtEntities);
+}
+
+// keyframe sampling on long clips (16 clips x 150 channels): the original linear
+// scan vs cursor/binary search over packed channels
+static void
+bench_keyframe_sampling(void)
+{
+    const uint32_t auKeys[] = {30, 300, 3000, 10000};
+    printf("\nsampling keys  linear scan   cursor+packed\n");
+    for(uint32_t i = 0; i < sizeof(auKeys) / sizeof(auKeys[0]); i++)
+    {
+        plComponentLibrary tReference = {0};
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tReference);
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 5;
+        for(uint32_t j = 0; j < 16; j++)
+            ecs_test_add_clip(&tReference, 50, auKeys[i], false);
+        guEcsTestSeed = 5;
+        for(uint32_t j = 0; j < 16; j++)
+            ecs_test_add_clip(&tLibrary, 50, auKeys[i], false);
+
+        // clips start at random points so the scan covers the whole clip
+        plAnimationComponent* sbtReference = tReference.tAnimationComponentManager.pComponents;
+        plAnimationComponent* sbtAnimations = tLibrary.tAnimationComponentManager.pComponents;
+        for(uint32_t j = 0; j < 16; j++)
+        {
+            sbtReference[j].fTimer = ecs_test_rand() * sbtReference[j].fEnd;
+            sbtAnimations[j].fTimer = sbtReference[j].fTimer;
+        }
+
+        // channels are packed on first use
+        gptECS->run_animation_update_system(&tLibrary, 0.0f);
+
+        double dStart = bench_now_ms();
+        for(uint32_t j = 0; j < 100; j++)
+            ecs_test_reference_animation(&tReference, 1.0f / 60.0f);
+        const double dReference = elapsed_ms(dStart) / 100.0;
+        dStart = bench_now_ms();
+        for(uint32_t j = 0; j < 100; j++)
+            gptECS->run_animation_update_system(&tLibrary, 1.0f / 60.0f);
+        const double dSampled = elapsed_ms(dStart) / 100.0;
+        printf("%14u %8.3f ms %12.3f ms\n", auKeys[i], dReference, dSampled);
+
+        gptECS->cleanup_component_library(&tReference);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+}
+
+// compressed clip size at each tolerance & sample time vs the raw clip
+// (60 joints of mocap like linear/step channels)
+static void
+bench_animation_compression(void)
+{
+    printf("\ncompression tolerance      size   ratio  keys kept  deviation\n");
+    const float afTolerances[] = {1e-4f, 1e-3f, 1e-2f};
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        plComponentLibrary tReference = {0};
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tReference);
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 5;
+        ecs_test_add_mocap_clip(&tReference, 60, 600, -1);
+        guEcsTestSeed = 5;
+        plEntity tAnimation = ecs_test_add_mocap_clip(&tLibrary, 60, 600, -1);
+        gptECS->run_animation_update_system(&tReference, 0.0f);
+        const plAnimationCompressionDesc tDesc = {afTolerances[i], afTolerances[i], afTolerances[i]};
+        gptECS->compress_animation(&tLibrary, tAnimation, &tDesc);
+
+        const plAnimationClip* ptClip = ((plAnimationComponent*)tLibrary.tAnimationComponentManager.pComponents)->_ptClip;
+        const size_t szRawSize = ecs_test_clip_size(((plAnimationComponent*)tReference.tAnimationComponentManager.pComponents)->_ptClip);
+        const size_t szSize = ecs_test_clip_size(ptClip);
+        uint32_t uKeysKept = 0;
+        for(uint32_t j = 0; j < pl_sb_size(ptClip->sbtCompressedChannels); j++)
+            uKeysKept += ptClip->sbtCompressedChannels[j].uKeyCount;
+        float fDeviation = 0.0f;
+        for(uint32_t uFrame = 0; uFrame < 1000; uFrame++)
+        {
+            gptECS->run_animation_update_system(&tReference, 0.0071f);
+            gptECS->run_animation_update_system(&tLibrary, 0.0071f);
+            fDeviation = pl_maxf(fDeviation, ecs_test_bone_space_deviation(&tReference, &tLibrary));
+        }
+        printf("%21g %9zu %6.1fx %5u/%u %10g\n", afTolerances[i], szSize, (double)szRawSize / (double)szSize, uKeysKept, 180 * 600, fDeviation);
+
+        gptECS->cleanup_component_library(&tReference);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+
+    printf("\ncompressed sampling keys  uncompressed   compressed\n");
+    for(uint32_t uKeys = 600; uKeys <= 6000; uKeys *= 10)
+    {
+        plComponentLibrary tReference = {0};
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tReference);
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 5;
+        ecs_test_add_mocap_clip(&tReference, 60, uKeys, -1);
+        guEcsTestSeed = 5;
+        plEntity tAnimation = ecs_test_add_mocap_clip(&tLibrary, 60, uKeys, -1);
+        gptECS->run_animation_update_system(&tReference, 0.0f);
+        gptECS->compress_animation(&tLibrary, tAnimation, NULL);
+
+        double dReferenceBest = 1e30;
+        double dCompressedBest = 1e30;
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            double dStart = bench_now_ms();
+            for(uint32_t j = 0; j < 1000; j++)
+                gptECS->run_animation_update_system(&tReference, 0.0167f);
+            dReferenceBest = pl_min(dReferenceBest, elapsed_ms(dStart));
+            dStart = bench_now_ms();
+            for(uint32_t j = 0; j < 1000; j++)
+                gptECS->run_animation_update_system(&tLibrary, 0.0167f);
+            dCompressedBest = pl_min(dCompressedBest, elapsed_ms(dStart));
+        }
+        printf("%26u %9.2f us %9.2f us\n", uKeys, dReferenceBest, dCompressedBest);
+
+        gptECS->cleanup_component_library(&tReference);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+}
+
+// characters of 50 joints blending a 2D space of 4 clips under a masked
+// override layer
+static void
+bench_blend_trees(uint32_t uCharacterCount)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    plAnimationBlendTree** sbtTrees = NULL;
+    float afMask[50] = {0};
+    for(uint32_t i = 0; i < 25; i++)
+        afMask[i] = 1.0f;
+
+    guEcsTestSeed = 38;
+    for(uint32_t i = 0; i < uCharacterCount; i++)
+    {
+        plEntity atJoints[50] = {0};
+        for(uint32_t j = 0; j < 50; j++)
+            atJoints[j] = gptECS->create_transform(&tLibrary, NULL, NULL);
+        plEntity atClips[5] = {0};
+        plEcsTestJointKeys atKeys[50] = {0};
+        for(uint32_t j = 0; j < 5; j++)
+        {
+            for(uint32_t k = 0; k < 50; k++)
+            {
+                atKeys[k].tStart = pl_create_vec3(ecs_test_rand(), ecs_test_rand(), ecs_test_rand());
+                atKeys[k].tEnd = pl_create_vec3(ecs_test_rand(), ecs_test_rand(), ecs_test_rand());
+                atKeys[k].fStartAngle = ecs_test_rand();
+                atKeys[k].fEndAngle = ecs_test_rand();
+            }
+            atClips[j] = ecs_test_add_blend_clip(&tLibrary, atJoints, atKeys, 50);
+        }
+
+        plAnimationBlendTree* ptTree = gptECS->create_blend_tree(&tLibrary, 50, atJoints);
+        uint32_t auNodes[4] = {0};
+        for(uint32_t j = 0; j < 4; j++)
+            auNodes[j] = gptECS->add_blend_clip(ptTree, atClips[j], 1.0f, true);
+        const plVec2 atPositions[4] = {{.x = 0.0f, .y = 0.0f}, {.x = 1.0f, .y = 0.0f}, {.x = 0.0f, .y = 1.0f}, {.x = 1.0f, .y = 1.0f}};
+        const uint32_t uSpace = gptECS->add_blend_space_2d(ptTree, 4, auNodes, atPositions);
+        gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(0.3f, 0.6f));
+        const plBlendLayerDesc tLayerDesc = {
+            .tMode   = PL_BLEND_LAYER_MODE_OVERRIDE,
+            .uBase   = uSpace,
+            .uLayer  = gptECS->add_blend_clip(ptTree, atClips[4], 1.0f, true),
+            .fWeight = 0.8f,
+            .afMask  = afMask
+        };
+        gptECS->add_blend_layer(ptTree, &tLayerDesc);
+        pl_sb_push(sbtTrees, ptTree);
+    }
+
+    gptECS->run_blend_tree_system(&tLibrary, 0.016f);
+    double dBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        gptECS->run_blend_tree_system(&tLibrary, 0.016f);
+        dBest = pl_min(dBest, elapsed_ms(dStart));
+    }
+    printf("\nblend trees: %u characters x 50 joints %.2f ms (%.1f characters/ms)\n", uCharacterCount, dBest, (double)uCharacterCount / dBest);
+
+    for(uint32_t i = 0; i < pl_sb_size(sbtTrees); i++)
+        gptECS->cleanup_blend_tree(&tLibrary, &sbtTrees[i]);
+    pl_sb_free(sbtTrees);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+// skin palettes: the original per joint lookups & full inverses vs cached joint
+// indices, batched multiplies & affine inverse transposes
+static void
+bench_skin_palettes(void)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 5;
+    ecs_test_build_scene(&tLibrary, 10000, 2500);
+    ecs_test_scramble_transforms(&tLibrary);
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+
+    uint32_t uJointCount = 0;
+    const plSkinComponent* sbtSkins = tLibrary.tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtSkins); i++)
+        uJointCount += pl_sb_size(sbtSkins[i].sbtJoints);
+
+    double dReferenceBest = 1e30;
+    double dBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        ecs_test_reference_skin(&tLibrary);
+        dReferenceBest = pl_min(dReferenceBest, elapsed_ms(dStart));
+        dStart = bench_now_ms();
+        gptECS->run_skin_update_system(&tLibrary);
+        dBest = pl_min(dBest, elapsed_ms(dStart));
+    }
+    const double dThousands = (double)uJointCount / 1000.0;
+    printf("\nskin palettes (%u joints): original %.1f us/1k joints, cached %.1f us/1k joints\n",
+        uJointCount, dReferenceBest * 1000.0 / dThousands, dBest * 1000.0 / dThousands);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+// cpu skinning of 64 meshes x 8k vertices (every attribute) vs a scalar port of
+// shaders/skinning.comp writing positions, normals & tangents only
+static void
+bench_cpu_skinning(void)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 9;
+    for(uint32_t i = 0; i < 64; i++)
+        ecs_test_add_skinned_mesh(&tLibrary, 8000, true);
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+
+    double dBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        gptECS->run_cpu_skinning_system(&tLibrary);
+        dBest = pl_min(dBest, elapsed_ms(dStart));
+    }
+
+    plVec3* sbtPositions = NULL;
+    plVec4* sbtData = NULL;
+    pl_sb_resize(sbtPositions, 8000);
+    pl_sb_resize(sbtData, 8000 * 2);
+    double dReferenceBest = 1e30;
+    const plMeshComponent* sbtMeshes = tLibrary.tMeshComponentManager.pComponents;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        for(uint32_t i = 0; i < pl_sb_size(sbtMeshes); i++)
+        {
+            const plMeshComponent* ptMesh = &sbtMeshes[i];
+            const plSkinComponent* ptSkin = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+            if(ptSkin == NULL)
+                continue;
+            for(uint32_t j = 0; j < pl_sb_size(ptMesh->sbtVertexPositions); j++)
+            {
+                const plMat4 tSkin = ecs_test_reference_skin_matrix(ptSkin->sbtTextureData, ptMesh->sbtVertexJoints[0][j], ptMesh->sbtVertexWeights[0][j]);
+                const plVec3* ptPosition = &ptMesh->sbtVertexPositions[j];
+                const plVec3* ptNormal = &ptMesh->sbtVertexNormals[j];
+                const plVec4* ptTangent = &ptMesh->sbtVertexTangents[j];
+                sbtPositions[j] = pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptPosition->x, ptPosition->y, ptPosition->z, 1.0f)).xyz;
+                sbtData[j * 2].xyz = pl_norm_vec3(pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptNormal->x, ptNormal->y, ptNormal->z, 0.0f)).xyz);
+                sbtData[j * 2 + 1].xyz = pl_norm_vec3(pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptTangent->x, ptTangent->y, ptTangent->z, 0.0f)).xyz);
+            }
+        }
+        dReferenceBest = pl_min(dReferenceBest, elapsed_ms(dStart));
+    }
+    printf("\ncpu skinning (512k vertices): %.2f ms (%.1f Mverts/s), scalar shader port %.2f ms (%.1f Mverts/s)\n",
+        dBest, 512.0 / dBest, dReferenceBest, 512.0 / dReferenceBest);
+
+    pl_sb_free(sbtPositions);
+    pl_sb_free(sbtData);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+// thousands of 4 & 8 bone CCD chains (8 iterations, no early out)
+static void
+bench_inverse_kinematics(uint32_t uChainCount)
+{
+    const plEntity tNone = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX};
+    const plVec4 tIdentity = {.x = 0.0f, .y = 0.0f, .z = 0.0f, .w = 1.0f};
+    printf("\nik chains  bones   solve      frame w/o ik  mean error\n");
+    for(uint32_t uBoneCount = 4; uBoneCount <= 8; uBoneCount += 4)
+    {
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 5;
+        for(uint32_t i = 0; i < uChainCount; i++)
+        {
+            plEntity tJoint = tNone;
+            for(uint32_t j = 0; j < uBoneCount; j++)
+            {
+                const plVec3 tTranslation = j > 0 ? pl_create_vec3(0.0f, 1.0f, 0.0f) : pl_create_vec3((float)i, 0.0f, 0.0f);
+                const plVec4 tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() * 0.2f, 0.0f, ecs_test_rand() * 0.2f, 1.0f));
+                tJoint = ecs_test_add_joint(&tLibrary, tTranslation, tRotation, tJoint);
+            }
+            plEntity tTarget = ecs_test_add_joint(&tLibrary, pl_create_vec3((float)i + 1.5f, 1.0f, 0.5f), tIdentity, tNone);
+            plInverseKinematicsComponent* ptIK = ecs_test_add_ik(&tLibrary, tJoint, tTarget, uBoneCount - 1, 8, PL_IK_SOLVER_CCD);
+            ptIK->fTolerance = 0.0f;
+        }
+
+        ecs_test_ik_frame(&tLibrary, true);
+        double dFrameBest = 1e30;
+        double dSolveBest = 1e30;
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            double dStart = bench_now_ms();
+            ecs_test_ik_frame(&tLibrary, false);
+            dFrameBest = pl_min(dFrameBest, elapsed_ms(dStart));
+            dStart = bench_now_ms();
+            gptECS->run_inverse_kinematics_update_system(&tLibrary);
+            dSolveBest = pl_min(dSolveBest, elapsed_ms(dStart));
+        }
+
+        double dError = 0.0;
+        const plInverseKinematicsComponent* sbtIK = tLibrary.tInverseKinematicsComponentManager.pComponents;
+        for(uint32_t i = 0; i < uChainCount; i++)
+        {
+            const plEntity tEffector = tLibrary.tInverseKinematicsComponentManager.sbtEntities[i];
+            dError += ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), ecs_test_world_position(&tLibrary, sbtIK[i].tTarget));
+        }
+        printf("%9u %6u %7.2f ms %10.2f ms %11g\n", uChainCount, uBoneCount, dSolveBest, dFrameBest, dError / (double)uChainCount);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+}
+
+// snapshot load vs building the same scene through the ecs api (the part of a
+// gltf import after parsing, so a lower bound for the import)
+static void
+bench_snapshot_load(uint32_t uObjectCount)
+{
+    double dBuildBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 43;
+        double dStart = bench_now_ms();
+        ecs_test_build_snapshot_scene(&tLibrary, uObjectCount, 2000);
+        dBuildBest = pl_min(dBuildBest, elapsed_ms(dStart));
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 43;
+    ecs_test_build_snapshot_scene(&tLibrary, uObjectCount, 2000);
+    size_t szSize = 0;
+    gptECS->save_snapshot(&tLibrary, NULL, &szSize);
+    void* pSnapshot = malloc(szSize);
+    double dSaveBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        gptECS->save_snapshot(&tLibrary, pSnapshot, &szSize);
+        dSaveBest = pl_min(dSaveBest, elapsed_ms(dStart));
+    }
+
+    double dLoadBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        plComponentLibrary tLoaded = {0};
+        gptECS->init_component_library(&tLoaded);
+        double dStart = bench_now_ms();
+        gptECS->load_snapshot(&tLoaded, pSnapshot, szSize);
+        dLoadBest = pl_min(dLoadBest, elapsed_ms(dStart));
+        gptECS->cleanup_component_library(&tLoaded);
+    }
+    printf("\nsnapshot (%u objects, %.1f MB): api build %.2f ms, save %.2f ms, load %.2f ms\n",
+        uObjectCount, (double)szSize / (1024.0 * 1024.0), dBuildBest, dSaveBest, dLoadBest);
+
+    free(pSnapshot);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+// aabb vs frustum planes (positive vertex test)
+static bool
+bench_aabb_in_planes(const plVec4 atPlanes[6], const plAABB* ptAABB)
+{
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const plVec3 tPositive = {
+            .x = atPlanes[i].x >= 0.0f ? ptAABB->tMax.x : ptAABB->tMin.x,
+            .y = atPlanes[i].y >= 0.0f ? ptAABB->tMax.y : ptAABB->tMin.y,
+            .z = atPlanes[i].z >= 0.0f ? ptAABB->tMax.z : ptAABB->tMin.z
+        };
+        if(pl_dot_vec3(atPlanes[i].xyz, tPositive) + atPlanes[i].w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+// culling against the camera's cached derived data vs rebuilding it for each
+// test (what call sites did before the cache), plus the per frame camera work
+// of the cascaded shadow setup
+static void
+bench_camera_culling(uint32_t uAABBCount)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    plCameraComponent* ptCamera = NULL;
+    gptECS->create_perspective_camera(&tLibrary, "camera", pl_create_vec3(1.0f, 2.0f, -5.0f), PL_PI_3, 16.0f / 9.0f, 0.1f, 200.0f, &ptCamera);
+    gptCamera->rotate(ptCamera, 0.3f, 1.1f);
+
+    guEcsTestSeed = 48;
+    plAABB* atAABBs = malloc(sizeof(plAABB) * uAABBCount);
+    for(uint32_t i = 0; i < uAABBCount; i++)
+    {
+        const plVec3 tCenter = {.x = ecs_test_rand() * 400.0f - 200.0f, .y = ecs_test_rand() * 400.0f - 200.0f, .z = ecs_test_rand() * 400.0f - 200.0f};
+        const float fRadius = ecs_test_rand() * 5.0f;
+        atAABBs[i] = (plAABB){.tMin = {.x = tCenter.x - fRadius, .y = tCenter.y - fRadius, .z = tCenter.z - fRadius}, .tMax = {.x = tCenter.x + fRadius, .y = tCenter.y + fRadius, .z = tCenter.z + fRadius}};
+    }
+
+    uint32_t uRebuiltVisible = 0;
+    uint32_t uCachedVisible = 0;
+    double dRebuiltBest = 1e30;
+    double dCachedBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        uRebuiltVisible = 0;
+        double dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uAABBCount; i++)
+        {
+            ptCamera->tDerived.uVersion = 0;
+            uRebuiltVisible += bench_aabb_in_planes(gptCamera->get_derived_data(ptCamera)->atPlanes, &atAABBs[i]);
+        }
+        dRebuiltBest = pl_min(dRebuiltBest, elapsed_ms(dStart));
+
+        uCachedVisible = 0;
+        dStart = bench_now_ms();
+        const plCameraDerivedData* ptDerived = gptCamera->get_derived_data(ptCamera);
+        for(uint32_t i = 0; i < uAABBCount; i++)
+            uCachedVisible += bench_aabb_in_planes(ptDerived->atPlanes, &atAABBs[i]);
+        dCachedBest = pl_min(dCachedBest, elapsed_ms(dStart));
+    }
+    printf("\ncull %u aabbs (%u/%u visible): rebuilt per test %.2f ms (%.1f ns/test), cached %.2f ms (%.1f ns/test)\n",
+        uAABBCount, uCachedVisible, uRebuiltVisible, dRebuiltBest, dRebuiltBest * 1e6 / uAABBCount, dCachedBest, dCachedBest * 1e6 / uAABBCount);
+
+    // camera update + 4 cascade slices with an unchanged camera
+    const uint32_t uFrames = 100000;
+    plVec3 atSlice[8] = {0};
+    float fSum = 0.0f;
+    double dStart = bench_now_ms();
+    for(uint32_t uFrame = 0; uFrame < uFrames; uFrame++)
+    {
+        ptCamera->_uBuiltVersion = 0;
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            ptCamera->tDerived.uVersion = 0;
+            gptCamera->get_frustum_slice(ptCamera, (float)i * 0.25f, (float)(i + 1) * 0.25f, atSlice);
+            fSum += atSlice[7].x;
+        }
+    }
+    const double dRebuilt = elapsed_ms(dStart);
+    dStart = bench_now_ms();
+    for(uint32_t uFrame = 0; uFrame < uFrames; uFrame++)
+    {
+        gptCamera->update(ptCamera);
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            gptCamera->get_frustum_slice(ptCamera, (float)i * 0.25f, (float)(i + 1) * 0.25f, atSlice);
+            fSum += atSlice[7].x;
+        }
+    }
+    const double dCached = elapsed_ms(dStart);
+    printf("camera update + 4 cascade slices: rebuilt %.0f ns, cached %.0f ns (%g)\n",
+        dRebuilt * 1e6 / uFrames, dCached * 1e6 / uFrames, (double)fSum);
+
+    free(atAABBs);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+// has-checks through signatures vs probing each manager's hashmap, and
+// signature filtered iteration vs a get_component loop
+static void
+bench_signatures(uint32_t uObjectCount)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scene(&tLibrary, uObjectCount, 0);
+    plEntity* sbtObjects = NULL;
+    pl_sb_resize(sbtObjects, uObjectCount);
+    memcpy(sbtObjects, tLibrary.tObjectComponentManager.sbtEntities, sizeof(plEntity) * uObjectCount);
+    for(uint32_t i = 0; i < uObjectCount; i += 10) // sparse so filters are selective
+        gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_LIGHT, sbtObjects[i]);
+
+    guEcsTestSeed = 49;
+    uint32_t* auOrder = malloc(sizeof(uint32_t) * uObjectCount);
+    for(uint32_t i = 0; i < uObjectCount; i++)
+        auOrder[i] = ecs_test_rand_index(uObjectCount);
+
+    uint32_t uOwned = 0;
+    double dHashmapBest = 1e30;
+    double dSignatureBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uObjectCount; i++)
+        {
+            for(uint32_t j = 0; j < PL_COMPONENT_TYPE_COUNT; j++)
+                uOwned += pl_hm_has_key(tLibrary._ptManagers[j]->ptHashmap, sbtObjects[auOrder[i]].uIndex);
+        }
+        dHashmapBest = pl_min(dHashmapBest, elapsed_ms(dStart));
+
+        dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uObjectCount; i++)
+        {
+            for(uint32_t j = 0; j < PL_COMPONENT_TYPE_COUNT; j++)
+                uOwned += gptECS->has_component(&tLibrary, j, sbtObjects[auOrder[i]]);
+        }
+        dSignatureBest = pl_min(dSignatureBest, elapsed_ms(dStart));
+    }
+    const double dChecks = (double)uObjectCount * PL_COMPONENT_TYPE_COUNT;
+    printf("\nhas-checks (%u entities x %u types, random order): hashmap %.2f ns, signature %.2f ns per check (%u)\n",
+        uObjectCount, PL_COMPONENT_TYPE_COUNT, dHashmapBest * 1e6 / dChecks, dSignatureBest * 1e6 / dChecks, uOwned);
+
+    // transform & light & !camera
+    const plComponentMask tRequired = PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM) | PL_COMPONENT_MASK(PL_COMPONENT_TYPE_LIGHT);
+    const plComponentMask tExcluded = PL_COMPONENT_MASK(PL_COMPONENT_TYPE_CAMERA);
+    plEntity* atEntities = malloc(sizeof(plEntity) * pl_sb_size(tLibrary.sbtEntityGenerations));
+    uint32_t uLoopCount = 0;
+    uint32_t uFilteredCount = 0;
+    double dLoopBest = 1e30;
+    double dFilteredBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        double dStart = bench_now_ms();
+        uLoopCount = 0;
+        const uint32_t uTransformCount = pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities);
+        for(uint32_t i = 0; i < uTransformCount; i++)
+        {
+            const plEntity tEntity = tLibrary.tTransformComponentManager.sbtEntities[i];
+            if(gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_LIGHT, tEntity) && !gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_CAMERA, tEntity))
+                atEntities[uLoopCount++] = tEntity;
+        }
+        dLoopBest = pl_min(dLoopBest, elapsed_ms(dStart));
+
+        dStart = bench_now_ms();
+        uFilteredCount = gptECS->get_entities_with(&tLibrary, tRequired, tExcluded, atEntities, pl_sb_size(tLibrary.sbtEntityGenerations));
+        dFilteredBest = pl_min(dFilteredBest, elapsed_ms(dStart));
+    }
+    printf("filtered iteration (transform & light & !camera, %u/%u matches): get_component loop %.3f ms, get_entities_with %.3f ms\n",
+        uFilteredCount, uLoopCount, dLoopBest, dFilteredBest);
+
+    free(atEntities);
+    free(auOrder);
+    pl_sb_free(sbtObjects);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+static int
+command_bench(uint32_t uEntityCount)
+{
+    if(uEntityCount < 64)
+        uEntityCount = 64;
+
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+
+    double dStart = bench_now_ms();
+    ecs_test_build_scene(&tLibrary, uEntityCount, uEntityCount / 64);
+    printf("scene:  %u objects, %u skins (%.1f ms)\n", uEntityCount, uEntityCount / 64, elapsed_ms(dStart));
+
+    plArchetypeStorage* ptStorage = gptECS->create_archetype_storage();
+    dStart = bench_now_ms();
+    gptECS->archetype_import_library(ptStorage, &tLibrary);
+    printf("import: %.1f ms\n\n", elapsed_ms(dStart));
+
+    // systems run in frame order since later systems consume earlier results
+    const struct {
+        const char*          pcName;
+        plBenchLibrarySystem tLibrarySystem;
+        plBenchStorageSystem tStorageSystem;
+    } atSystems[] = {
+        {"transform", gptECS->run_transform_update_system, gptECS->run_archetype_transform_update_system},
+        {"hierarchy", gptECS->run_hierarchy_update_system, gptECS->run_archetype_hierarchy_update_system},
+        {"skin",      gptECS->run_skin_update_system,      gptECS->run_archetype_skin_update_system},
+        {"object",    gptECS->run_object_update_system,    gptECS->run_archetype_object_update_system},
+    };
+    const uint32_t uSystemCount = sizeof(atSystems) / sizeof(atSystems[0]);
+
+    // per system timings at each worker count
+    double aadLibraryBest[PL_BENCH_THREAD_COUNT_VARIANTS][4] = {0};
+    double aadStorageBest[PL_BENCH_THREAD_COUNT_VARIANTS][4] = {0};
+    for(uint32_t uVariant = 0; uVariant < PL_BENCH_THREAD_COUNT_VARIANTS; uVariant++)
+    {
+        test_set_thread_count(gauBenchThreadCounts[uVariant]);
+        double* adLibraryBest = aadLibraryBest[uVariant];
+        double* adStorageBest = aadStorageBest[uVariant];
+        for(uint32_t i = 0; i < uSystemCount; i++)
+        {
+            adLibraryBest[i] = 1e30;
+            adStorageBest[i] = 1e30;
+        }
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            // every library transform is dirtied so each frame does the full amount
+            // of work (archetype systems always do)
+            ecs_test_dirty_transforms(&tLibrary);
+
+            pl_begin_profile_frame();
+            for(uint32_t i = 0; i < uSystemCount; i++)
+            {
+                dStart = bench_now_ms();
+                atSystems[i].tLibrarySystem(&tLibrary);
+                const double dMs = elapsed_ms(dStart);
+                if(dMs < adLibraryBest[i])
+                    adLibraryBest[i] = dMs;
+            }
+            for(uint32_t i = 0; i < uSystemCount; i++)
+            {
+                dStart = bench_now_ms();
+                atSystems[i].tStorageSystem(ptStorage);
+                const double dMs = elapsed_ms(dStart);
+                if(dMs < adStorageBest[i])
+                    adStorageBest[i] = dMs;
+            }
+            pl_end_profile_frame();
+        }
+    }
+
+    printf("system     threads   library   archetype\n");
+    for(uint32_t i = 0; i < uSystemCount; i++)
+    {
+        for(uint32_t uVariant = 0; uVariant < PL_BENCH_THREAD_COUNT_VARIANTS; uVariant++)
+            printf("%-10s %7u %7.2f ms %8.2f ms\n", atSystems[i].pcName, gauBenchThreadCounts[uVariant], aadLibraryBest[uVariant][i], aadStorageBest[uVariant][i]);
+    }
+
+    // everything below runs on the default worker count
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+
+    // cached queries vs hashed lookups (all transforms dirty)
+    const struct {
+        const char*          pcName;
+        plBenchLibrarySystem tSystem;
+        plBenchLibrarySystem tLookupPass;
+    } atQuerySystems[] = {
+        {"hierarchy", gptECS->run_hierarchy_update_system, bench_lookup_hierarchy},
+        {"object",    gptECS->run_object_update_system,    bench_lookup_objects},
+    };
+    printf("\nsystem         query     lookups   unchanged\n");
+    for(uint32_t i = 0; i < sizeof(atQuerySystems) / sizeof(atQuerySystems[0]); i++)
+    {
+        double dQueryBest = 1e30;
+        double dLookupBest = 1e30;
+        double dUnchangedBest = 1e30;
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            ecs_test_dirty_transforms(&tLibrary);
+            gptECS->run_transform_update_system(&tLibrary);
+            if(i > 0)
+                gptECS->run_hierarchy_update_system(&tLibrary);
+            dStart = bench_now_ms();
+            atQuerySystems[i].tSystem(&tLibrary);
+            const double dQuery = elapsed_ms(dStart);
+
+            // nothing changed since the last frame, so the system skips everything
+            gptECS->run_transform_update_system(&tLibrary);
+            if(i > 0)
+                gptECS->run_hierarchy_update_system(&tLibrary);
+            dStart = bench_now_ms();
+            atQuerySystems[i].tSystem(&tLibrary);
+            const double dUnchanged = elapsed_ms(dStart);
+
+            ecs_test_dirty_transforms(&tLibrary);
+            gptECS->run_transform_update_system(&tLibrary);
+            if(i > 0)
+                gptECS->run_hierarchy_update_system(&tLibrary);
+            dStart = bench_now_ms();
+            atQuerySystems[i].tLookupPass(&tLibrary);
+            const double dLookup = elapsed_ms(dStart);
+
+            if(dQuery < dQueryBest)
+                dQueryBest = dQuery;
+            if(dLookup < dLookupBest)
+                dLookupBest = dLookup;
+            if(dUnchanged < dUnchangedBest)
+                dUnchangedBest = dUnchanged;
+        }
+        printf("%-10s %7.2f ms %8.2f ms %8.2f ms\n", atQuerySystems[i].pcName, dQueryBest, dLookupBest, dUnchangedBest);
+    }
+
+    // change tracking: frames where 1% of transforms move vs all of them
+    double dStaticBest = 1e30;
+    double dMovingBest = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        plTransformComponent* sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+        const uint32_t uTransformCount = pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities);
+        for(uint32_t i = uRun; i < uTransformCount; i += 100)
+            sbtTransforms[i].tTranslation.y += 0.01f;
+        dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uSystemCount; i++)
+            atSystems[i].tLibrarySystem(&tLibrary);
+        const double dStatic = elapsed_ms(dStart);
+
+        ecs_test_dirty_transforms(&tLibrary);
+        dStart = bench_now_ms();
+        for(uint32_t i = 0; i < uSystemCount; i++)
+            atSystems[i].tLibrarySystem(&tLibrary);
+        const double dMoving = elapsed_ms(dStart);
+
+        if(dStatic < dStaticBest)
+            dStaticBest = dStatic;
+        if(dMoving < dMovingBest)
+            dMovingBest = dMoving;
+    }
+    printf("\nframe (every system): 1%% moving %.2f ms, all moving %.2f ms\n", dStaticBest, dMovingBest);
+
+    gptECS->cleanup_archetype_storage(&ptStorage);
+    gptECS->cleanup_component_library(&tLibrary);
+
+    bench_despawn();
+    bench_keyframe_sampling();
+    bench_animation_compression();
+    bench_blend_trees(1000);
+    bench_skin_palettes();
+    bench_cpu_skinning();
+    bench_inverse_kinematics(4000);
+    bench_snapshot_load(20000);
+    bench_camera_culling(200000);
+    bench_signatures(uEntityCount);
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] main
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    test_load_extensions();
+
+    if(argc >= 2 && strcmp(argv[1], "bench") == 0)
+        return command_bench(argc == 3 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1000000);
+
+    // create test context
+    plTestOptions tOptions = {
+        .bPrintSuiteResults = true,
+        .bPrintColor = true
+    };
+    pl_create_test_context(tOptions);
+
+    pl_begin_profile_frame();
+
+    // pl_ecs_ext.c tests
+    pl_ecs_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext");
+
+    pl_ecs_animation_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext animation");
+
+    pl_ecs_script_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext scripts & command buffers");
+
+    pl_ecs_snapshot_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext snapshots");
+
+    pl_ecs_fixed_step_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext fixed step");
+
+    pl_ecs_mesh_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext meshes");
+
+    pl_ecs_name_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext name index");
+
+    pl_ecs_render_tests(NULL);
+    pl_test_run_suite("pl_ecs_ext render extraction");
+
+    // pl_spatial_ext.c tests
+    pl_spatial_tests(NULL);
+    pl_test_run_suite("pl_spatial_ext");
+
+    pl_end_profile_frame();
+
+    bool bResult = pl_test_finish();
+
+    if(!bResult)
+    {
+        exit(1);
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] unity build
+//-----------------------------------------------------------------------------
+
+#define PL_PROFILE_IMPLEMENTATION
+#include "pl_profile.h"
+
+#define PL_LOG_IMPLEMENTATION
+#include "pl_log.h"
+
+#define PL_TEST_WIN32_COLOR
+#define PL_TEST_IMPLEMENTATION
+#include "pl_test.h"
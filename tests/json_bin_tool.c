@@ -0,0 +1,774 @@
+/*
+   json_bin_tool.c
+     * converts between json text & plBin (pl_json.h binary format)
+
+   usage:
+     pl_json_bin_tool to-bin    <input.json>  <output.plbin>
+     pl_json_bin_tool to-json   <input.plbin> <output.json>
+     pl_json_bin_tool roundtrip <input.json>
+     pl_json_bin_tool bench     [megabytes]
+
+   roundtrip converts json -> plBin -> json, checks the result matches the
+   source document, & reports sizes & load times for both formats
+
+   bench generates a scene-like document of the requested size (default 32 MB)
+   & reports pl_json.h throughput on it (best of several runs)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] helpers
+// [SECTION] commands
+// [SECTION] benchmarks
+// [SECTION] main
+// [SECTION] unity build
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pl_json.h"
+#include "pl_number.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] helpers
+//-----------------------------------------------------------------------------
+
+// returned buffer is null terminated & 4 byte aligned (malloc)
+static char*
+read_file(const char* pcPath, size_t* pszSizeOut)
+{
+    FILE* ptFile = fopen(pcPath, "rb");
+    if(ptFile == NULL)
+    {
+        fprintf(stderr, "could not open \"%s\"\n", pcPath);
+        return NULL;
+    }
+
+    fseek(ptFile, 0, SEEK_END);
+    const long lSize = ftell(ptFile);
+    fseek(ptFile, 0, SEEK_SET);
+
+    char* pcData = malloc((size_t)lSize + 1);
+    const size_t szRead = fread(pcData, 1, (size_t)lSize, ptFile);
+    fclose(ptFile);
+    pcData[szRead] = 0;
+    *pszSizeOut = szRead;
+    return pcData;
+}
+
+static bool
+write_file(const char* pcPath, const void* pData, size_t szSize)
+{
+    FILE* ptFile = fopen(pcPath, "wb");
+    if(ptFile == NULL)
+    {
+        fprintf(stderr, "could not open \"%s\"\n", pcPath);
+        return false;
+    }
+    const size_t szWritten = fwrite(pData, 1, szSize, ptFile);
+    fclose(ptFile);
+    return szWritten == szSize;
+}
+
+static char*
+json_to_text(plJsonObject* ptJson, uint32_t* puSizeOut)
+{
+    uint32_t uSize = 0;
+    pl_write_json(ptJson, NULL, &uSize);
+    char* pcText = calloc(1, uSize + 1);
+    pl_write_json(ptJson, pcText, &uSize);
+    *puSizeOut = uSize;
+    return pcText;
+}
+
+static void*
+json_to_bin(plJsonObject* ptJson, size_t* pszSizeOut)
+{
+    size_t szSize = 0;
+    pl_write_json_bin(ptJson, NULL, &szSize);
+    void* pBin = malloc(szSize);
+    if(!pl_write_json_bin(ptJson, pBin, &szSize))
+    {
+        free(pBin);
+        return NULL;
+    }
+    *pszSizeOut = szSize;
+    return pBin;
+}
+
+static double
+elapsed_ms(clock_t tStart)
+{
+    return (double)(clock() - tStart) * 1000.0 / (double)CLOCKS_PER_SEC;
+}
+
+static double
+megabytes_per_second(size_t szSize, double dMilliseconds)
+{
+    return dMilliseconds > 0.0 ? (double)szSize / (1024.0 * 1024.0) / (dMilliseconds / 1000.0) : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] commands
+//-----------------------------------------------------------------------------
+
+static int
+command_to_bin(const char* pcInput, const char* pcOutput)
+{
+    size_t szTextSize = 0;
+    char* pcText = read_file(pcInput, &szTextSize);
+    if(pcText == NULL)
+        return 1;
+
+    plJsonObject* ptJson = NULL;
+    if(!pl_parse_json(pcText, szTextSize, &ptJson))
+    {
+        fprintf(stderr, "\"%s\" is not valid json\n", pcInput);
+        free(pcText);
+        return 1;
+    }
+
+    size_t szBinSize = 0;
+    void* pBin = json_to_bin(ptJson, &szBinSize);
+    const bool bResult = pBin && write_file(pcOutput, pBin, szBinSize);
+    if(pBin == NULL)
+        fprintf(stderr, "document is too large for plBin\n");
+
+    free(pBin);
+    free(pcText);
+    pl_unload_json(&ptJson);
+    return bResult ? 0 : 1;
+}
+
+static int
+command_to_json(const char* pcInput, const char* pcOutput)
+{
+    size_t szBinSize = 0;
+    char* pcBin = read_file(pcInput, &szBinSize);
+    if(pcBin == NULL)
+        return 1;
+
+    plJsonObject* ptJson = NULL;
+    if(!pl_load_json_bin(pcBin, szBinSize, &ptJson))
+    {
+        fprintf(stderr, "\"%s\" is not a valid plBin file\n", pcInput);
+        free(pcBin);
+        return 1;
+    }
+
+    uint32_t uTextSize = 0;
+    char* pcText = json_to_text(ptJson, &uTextSize);
+    const bool bResult = write_file(pcOutput, pcText, uTextSize);
+
+    free(pcText);
+    free(pcBin);
+    pl_unload_json(&ptJson);
+    return bResult ? 0 : 1;
+}
+
+static int
+command_roundtrip(const char* pcInput)
+{
+    size_t szTextSize = 0;
+    char* pcText = read_file(pcInput, &szTextSize);
+    if(pcText == NULL)
+        return 1;
+
+    // text load
+    plJsonObject* ptJson = NULL;
+    clock_t tStart = clock();
+    const bool bParsed = pl_parse_json(pcText, szTextSize, &ptJson);
+    const double dTextLoadTime = elapsed_ms(tStart);
+    if(!bParsed)
+    {
+        fprintf(stderr, "\"%s\" is not valid json\n", pcInput);
+        free(pcText);
+        return 1;
+    }
+
+    size_t szBinSize = 0;
+    void* pBin = json_to_bin(ptJson, &szBinSize);
+    if(pBin == NULL)
+    {
+        fprintf(stderr, "document is too large for plBin\n");
+        free(pcText);
+        pl_unload_json(&ptJson);
+        return 1;
+    }
+
+    // binary load (in place & converted to the dom)
+    plJsonBinValue tRoot = {0};
+    tStart = clock();
+    const bool bMapped = pl_json_bin_root(pBin, szBinSize, &tRoot);
+    const double dBinMapTime = elapsed_ms(tStart);
+
+    plJsonObject* ptCopy = NULL;
+    tStart = clock();
+    const bool bLoaded = pl_load_json_bin(pBin, szBinSize, &ptCopy);
+    const double dBinLoadTime = elapsed_ms(tStart);
+
+    int iResult = 1;
+    if(bMapped && bLoaded)
+    {
+        uint32_t uExpectedSize = 0;
+        uint32_t uCopySize = 0;
+        char* pcExpected = json_to_text(ptJson, &uExpectedSize);
+        char* pcCopy = json_to_text(ptCopy, &uCopySize);
+        if(uExpectedSize == uCopySize && memcmp(pcExpected, pcCopy, uCopySize) == 0)
+            iResult = 0;
+        else
+            fprintf(stderr, "round trip mismatch\n");
+        free(pcExpected);
+        free(pcCopy);
+    }
+    else
+        fprintf(stderr, "plBin load failed\n");
+
+    printf("json:  %10zu bytes  parse   %8.3f ms\n", szTextSize, dTextLoadTime);
+    printf("plBin: %10zu bytes  map     %8.3f ms  to dom %8.3f ms\n", szBinSize, dBinMapTime, dBinLoadTime);
+    printf("%s\n", iResult == 0 ? "round trip ok" : "round trip failed");
+
+    if(ptCopy)
+        pl_unload_json(&ptCopy);
+    pl_unload_json(&ptJson);
+    free(pBin);
+    free(pcText);
+    return iResult;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] benchmarks
+//-----------------------------------------------------------------------------
+
+#define BENCH_RUNS 5 // each timing is the best of this many runs
+
+typedef struct _plBenchBuffer
+{
+    char*  pcData;
+    size_t szSize;
+    size_t szCapacity;
+} plBenchBuffer;
+
+// growing sink so the generator isn't bounded by a preallocated size
+static void
+bench_buffer_sink(void* pUserData, const char* pcData, size_t szSize)
+{
+    plBenchBuffer* ptBuffer = pUserData;
+    if(ptBuffer->szSize + szSize + 1 > ptBuffer->szCapacity)
+    {
+        while(ptBuffer->szSize + szSize + 1 > ptBuffer->szCapacity)
+            ptBuffer->szCapacity = ptBuffer->szCapacity ? ptBuffer->szCapacity * 2 : 1 << 20;
+        ptBuffer->pcData = realloc(ptBuffer->pcData, ptBuffer->szCapacity);
+    }
+    memcpy(&ptBuffer->pcData[ptBuffer->szSize], pcData, szSize);
+    ptBuffer->szSize += szSize;
+    ptBuffer->pcData[ptBuffer->szSize] = 0;
+}
+
+static float
+bench_random_float(void)
+{
+    static uint32_t uState = 1234567;
+    uState = uState * 1664525u + 1013904223u;
+    return (float)(uState >> 8) / 16777216.0f;
+}
+
+static void
+bench_write_node(plJsonWriter* ptWriter, uint32_t uIndex)
+{
+    char acName[64] = {0};
+    snprintf(acName, 64, "node %u", uIndex);
+    pl_json_write_begin_object(ptWriter);
+    pl_json_write_key(ptWriter, "name");        pl_json_write_string(ptWriter, acName);
+    pl_json_write_key(ptWriter, "id");          pl_json_write_uint(ptWriter, uIndex);
+    pl_json_write_key(ptWriter, "visible");     pl_json_write_bool(ptWriter, (uIndex & 3) != 0);
+    pl_json_write_key(ptWriter, "translation");
+    pl_json_write_begin_array(ptWriter);
+    for(uint32_t i = 0; i < 3; i++)
+        pl_json_write_float(ptWriter, bench_random_float() * 1000.0f - 500.0f);
+    pl_json_write_end_array(ptWriter);
+    pl_json_write_key(ptWriter, "rotation");
+    pl_json_write_begin_array(ptWriter);
+    for(uint32_t i = 0; i < 4; i++)
+        pl_json_write_float(ptWriter, bench_random_float() * 2.0f - 1.0f);
+    pl_json_write_end_array(ptWriter);
+    pl_json_write_key(ptWriter, "children");
+    pl_json_write_begin_array(ptWriter);
+    for(uint32_t i = 0; i < (uIndex % 4); i++)
+        pl_json_write_uint(ptWriter, uIndex * 4 + i + 1);
+    pl_json_write_end_array(ptWriter);
+    pl_json_write_key(ptWriter, "mesh");        pl_json_write_null(ptWriter);
+    pl_json_write_end_object(ptWriter);
+}
+
+// {"scene": ..., "config": {wide object}, "nodes": [ {...}, ... ]}
+static char*
+bench_generate_document(size_t szTargetSize, uint32_t uConfigMembers, bool bPretty, size_t* pszSizeOut)
+{
+    plBenchBuffer tBuffer = {0};
+    char acStaging[1 << 16];
+    const plJsonWriterDesc tDesc = {
+        .pfSink      = bench_buffer_sink,
+        .pUserData   = &tBuffer,
+        .pcBuffer    = acStaging,
+        .uBufferSize = sizeof(acStaging),
+        .bPretty     = bPretty
+    };
+    plJsonWriter tWriter = {0};
+    pl_json_writer_init(&tWriter, &tDesc);
+
+    pl_json_write_begin_object(&tWriter);
+    pl_json_write_key(&tWriter, "scene");
+    pl_json_write_string(&tWriter, "bench");
+    pl_json_write_key(&tWriter, "config");
+    pl_json_write_begin_object(&tWriter);
+    char acKey[64] = {0};
+    for(uint32_t i = 0; i < uConfigMembers; i++)
+    {
+        snprintf(acKey, 64, "setting_%u", i);
+        pl_json_write_key(&tWriter, acKey);
+        pl_json_write_int(&tWriter, (int64_t)i * 7);
+    }
+    pl_json_write_end_object(&tWriter);
+    pl_json_write_key(&tWriter, "nodes");
+    pl_json_write_begin_array(&tWriter);
+    for(uint32_t i = 0; tBuffer.szSize + tWriter.uCursor < szTargetSize; i++)
+        bench_write_node(&tWriter, i);
+    pl_json_write_end_array(&tWriter);
+    pl_json_write_end_object(&tWriter);
+    pl_json_writer_finish(&tWriter);
+
+    *pszSizeOut = tBuffer.szSize;
+    return tBuffer.pcData;
+}
+
+// one node document per line
+static char*
+bench_generate_ndjson(size_t szTargetSize, size_t* pszSizeOut)
+{
+    plBenchBuffer tBuffer = {0};
+    char acStaging[1 << 12];
+    const plJsonWriterDesc tDesc = {
+        .pfSink      = bench_buffer_sink,
+        .pUserData   = &tBuffer,
+        .pcBuffer    = acStaging,
+        .uBufferSize = sizeof(acStaging)
+    };
+    for(uint32_t i = 0; tBuffer.szSize < szTargetSize; i++)
+    {
+        plJsonWriter tWriter = {0};
+        pl_json_writer_init(&tWriter, &tDesc);
+        bench_write_node(&tWriter, i);
+        pl_json_writer_finish(&tWriter);
+        bench_buffer_sink(&tBuffer, "\n", 1);
+    }
+    *pszSizeOut = tBuffer.szSize;
+    return tBuffer.pcData;
+}
+
+// flat dom build & hashed member lookup vs a linear name scan
+static void
+bench_dom(const char* pcText, size_t szSize, uint32_t uConfigMembers)
+{
+    double dParse = 1e30;
+    plJsonObject* ptJson = NULL;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        if(ptJson)
+            pl_unload_json(&ptJson);
+        const clock_t tStart = clock();
+        pl_parse_json(pcText, szSize, &ptJson);
+        const double dTime = elapsed_ms(tStart);
+        dParse = dTime < dParse ? dTime : dParse;
+    }
+    printf("dom:      parse %8.2f ms (%7.1f MB/s)\n", dParse, megabytes_per_second(szSize, dParse));
+
+    plJsonObject* ptConfig = pl_json_member(ptJson, "config");
+    uint32_t uNameLength = 0;
+    pl_json_member_list(ptConfig, NULL, NULL, &uNameLength);
+    uNameLength++; // null terminator
+    char* pcNames = malloc((size_t)uConfigMembers * uNameLength);
+    char** apcNames = malloc(sizeof(char*) * uConfigMembers);
+    for(uint32_t i = 0; i < uConfigMembers; i++)
+        apcNames[i] = &pcNames[i * uNameLength];
+    pl_json_member_list(ptConfig, apcNames, NULL, NULL);
+
+    // every member looked up once, in a scrambled order
+    const uint32_t uLookups = uConfigMembers;
+    int64_t iChecksum = 0;
+    clock_t tStart = clock();
+    for(uint32_t i = 0; i < uLookups; i++)
+        iChecksum += pl_json_int_member(ptConfig, apcNames[(i * 7919u) % uConfigMembers], 0);
+    const double dHashed = elapsed_ms(tStart);
+
+    tStart = clock();
+    for(uint32_t i = 0; i < uLookups; i++)
+    {
+        const char* pcName = apcNames[(i * 7919u) % uConfigMembers];
+        for(uint32_t j = 0; j < uConfigMembers; j++)
+        {
+            if(strcmp(apcNames[j], pcName) == 0)
+            {
+                iChecksum -= pl_json_as_int(pl_json_member_by_index(ptConfig, j));
+                break;
+            }
+        }
+    }
+    const double dLinear = elapsed_ms(tStart);
+    printf("dom:      member lookup (%u members) %8.1f ns hashed, %8.1f ns linear scan%s\n", uConfigMembers,
+        dHashed * 1e6 / uLookups, dLinear * 1e6 / uLookups, iChecksum == 0 ? "" : " (MISMATCH)");
+
+    free(apcNames);
+    free(pcNames);
+    pl_unload_json(&ptJson);
+}
+
+static void
+bench_discard_sink(void* pUserData, const char* pcData, size_t szSize)
+{
+    size_t* pszTotal = pUserData;
+    *pszTotal += szSize;
+    (void)pcData;
+}
+
+// streaming writer (bounded staging buffer) vs serializing a loaded tree with pl_write_json,
+// both writing the same nodes
+static void
+bench_write(const char* pcText, size_t szSize)
+{
+    plJsonObject* ptJson = NULL;
+    pl_parse_json(pcText, szSize, &ptJson);
+    uint32_t uNodeCount = 0;
+    plJsonObject* ptNodes = pl_json_array_member(ptJson, "nodes", &uNodeCount);
+
+    double dTree = 1e30;
+    uint32_t uTreeSize = 0;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        const clock_t tStart = clock();
+        uTreeSize = 0;
+        pl_write_json(ptNodes, NULL, &uTreeSize);
+        char* pcOut = malloc(uTreeSize + 1);
+        pl_write_json(ptNodes, pcOut, &uTreeSize);
+        const double dTime = elapsed_ms(tStart);
+        dTree = dTime < dTree ? dTime : dTree;
+        free(pcOut);
+    }
+    pl_unload_json(&ptJson);
+
+    char acStaging[1 << 16];
+    for(uint32_t uPretty = 0; uPretty < 2; uPretty++)
+    {
+        double dStream = 1e30;
+        size_t szStreamed = 0;
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            szStreamed = 0;
+            const plJsonWriterDesc tDesc = {
+                .pfSink      = bench_discard_sink,
+                .pUserData   = &szStreamed,
+                .pcBuffer    = acStaging,
+                .uBufferSize = sizeof(acStaging),
+                .bPretty     = uPretty == 1
+            };
+            plJsonWriter tWriter = {0};
+            const clock_t tStart = clock();
+            pl_json_writer_init(&tWriter, &tDesc);
+            pl_json_write_begin_array(&tWriter);
+            for(uint32_t i = 0; i < uNodeCount; i++)
+                bench_write_node(&tWriter, i);
+            pl_json_write_end_array(&tWriter);
+            pl_json_writer_finish(&tWriter);
+            const double dTime = elapsed_ms(tStart);
+            dStream = dTime < dStream ? dTime : dStream;
+        }
+        printf("write:    %-8s %10zu bytes %8.2f ms (%7.1f MB/s, %6.1f ns/node, %zu byte buffer)\n", uPretty ? "stream+" : "stream",
+            szStreamed, dStream, megabytes_per_second(szStreamed, dStream), dStream * 1e6 / uNodeCount, sizeof(acStaging));
+    }
+    printf("write:    %-8s %10u bytes %8.2f ms (%7.1f MB/s, %6.1f ns/node, whole output buffered)\n", "tree",
+        uTreeSize, dTree, megabytes_per_second(uTreeSize, dTree), dTree * 1e6 / uNodeCount);
+}
+
+// plBin size & load time vs text json
+static void
+bench_bin(const char* pcText, size_t szSize, uint32_t uConfigMembers)
+{
+    plJsonObject* ptJson = NULL;
+    double dText = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        if(ptJson)
+            pl_unload_json(&ptJson);
+        const clock_t tStart = clock();
+        pl_parse_json(pcText, szSize, &ptJson);
+        const double dTime = elapsed_ms(tStart);
+        dText = dTime < dText ? dTime : dText;
+    }
+
+    size_t szBinSize = 0;
+    void* pBin = json_to_bin(ptJson, &szBinSize);
+    pl_unload_json(&ptJson);
+    if(pBin == NULL)
+    {
+        printf("plBin:    document is too large for plBin\n");
+        return;
+    }
+
+    double dMap = 1e30;
+    double dDom = 1e30;
+    plJsonBinValue tRoot = {0};
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        clock_t tStart = clock();
+        pl_json_bin_root(pBin, szBinSize, &tRoot);
+        double dTime = elapsed_ms(tStart);
+        dMap = dTime < dMap ? dTime : dMap;
+
+        plJsonObject* ptCopy = NULL;
+        tStart = clock();
+        pl_load_json_bin(pBin, szBinSize, &ptCopy);
+        dTime = elapsed_ms(tStart);
+        dDom = dTime < dDom ? dTime : dDom;
+        pl_unload_json(&ptCopy);
+    }
+
+    // in place member lookups on the wide config object
+    plJsonBinValue tConfig = pl_json_bin_member(tRoot, "config");
+    char acName[64] = {0};
+    int64_t iChecksum = 0;
+    const clock_t tStart = clock();
+    for(uint32_t i = 0; i < uConfigMembers; i++)
+    {
+        const uint32_t uMember = (i * 7919u) % uConfigMembers;
+        snprintf(acName, 64, "setting_%u", uMember);
+        iChecksum += pl_json_bin_as_int(pl_json_bin_member(tConfig, acName)) - (int64_t)uMember * 7;
+    }
+    const double dLookup = elapsed_ms(tStart);
+
+    printf("plBin:    json  %10zu bytes, parse  %8.2f ms\n", szSize, dText);
+    printf("plBin:    plBin %10zu bytes, map    %8.4f ms, to dom %8.2f ms, member lookup %6.1f ns%s\n", szBinSize, dMap, dDom,
+        dLookup * 1e6 / uConfigMembers, iChecksum == 0 ? "" : " (MISMATCH)");
+    free(pBin);
+}
+
+// pl_number.h conversions vs the c library
+static void
+bench_numbers(void)
+{
+    const uint32_t uCount = 1000000;
+    double* adValues = malloc(sizeof(double) * uCount);
+    int64_t* aiValues = malloc(sizeof(int64_t) * uCount);
+    char* pcText = malloc((size_t)uCount * PL_NUMBER_MAX_CHARS);
+    uint64_t uState = 88172645463325252ull;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        // half scene-like values, half arbitrary finite doubles
+        uState ^= uState << 13; uState ^= uState >> 7; uState ^= uState << 17;
+        if(i & 1)
+        {
+            uint64_t uBits = uState & ~(0x7ffull << 52);
+            uBits |= (uint64_t)(1 + (uState >> 52) % 2046) << 52;
+            memcpy(&adValues[i], &uBits, sizeof(double));
+        }
+        else
+            adValues[i] = (double)(int64_t)(uState % 2000001) / 1000.0 - 1000.0;
+        aiValues[i] = (int64_t)uState >> (uState & 63);
+    }
+
+    // double formatting (shortest round trip vs %.17g)
+    double dFormat = 1e30;
+    double dFormatLibc = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        clock_t tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            pl_format_double(adValues[i], &pcText[(size_t)i * PL_NUMBER_MAX_CHARS]);
+        double dTime = elapsed_ms(tStart);
+        dFormat = dTime < dFormat ? dTime : dFormat;
+
+        char acScratch[PL_NUMBER_MAX_CHARS];
+        tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            snprintf(acScratch, PL_NUMBER_MAX_CHARS, "%.17g", adValues[i]);
+        dTime = elapsed_ms(tStart);
+        dFormatLibc = dTime < dFormatLibc ? dTime : dFormatLibc;
+    }
+
+    // double parsing of the shortest strings
+    double dParse = 1e30;
+    double dParseLibc = 1e30;
+    uint32_t uMismatches = 0;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        uMismatches = 0;
+        double dValue = 0.0;
+        clock_t tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const char* pcNumber = &pcText[(size_t)i * PL_NUMBER_MAX_CHARS];
+            pl_parse_double(pcNumber, strlen(pcNumber), &dValue);
+            uMismatches += dValue != adValues[i];
+        }
+        double dTime = elapsed_ms(tStart);
+        dParse = dTime < dParse ? dTime : dParse;
+
+        tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            uMismatches += strtod(&pcText[(size_t)i * PL_NUMBER_MAX_CHARS], NULL) != adValues[i];
+        dTime = elapsed_ms(tStart);
+        dParseLibc = dTime < dParseLibc ? dTime : dParseLibc;
+    }
+
+    // integers
+    double dIntFormat = 1e30;
+    double dIntFormatLibc = 1e30;
+    double dIntParse = 1e30;
+    double dIntParseLibc = 1e30;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        char acScratch[PL_NUMBER_MAX_CHARS];
+        clock_t tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            pl_format_int64(aiValues[i], &pcText[(size_t)i * PL_NUMBER_MAX_CHARS]);
+        double dTime = elapsed_ms(tStart);
+        dIntFormat = dTime < dIntFormat ? dTime : dIntFormat;
+
+        tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            snprintf(acScratch, PL_NUMBER_MAX_CHARS, "%lld", (long long)aiValues[i]);
+        dTime = elapsed_ms(tStart);
+        dIntFormatLibc = dTime < dIntFormatLibc ? dTime : dIntFormatLibc;
+
+        int64_t iValue = 0;
+        tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const char* pcNumber = &pcText[(size_t)i * PL_NUMBER_MAX_CHARS];
+            pl_parse_int64(pcNumber, strlen(pcNumber), &iValue);
+            uMismatches += iValue != aiValues[i];
+        }
+        dTime = elapsed_ms(tStart);
+        dIntParse = dTime < dIntParse ? dTime : dIntParse;
+
+        tStart = clock();
+        for(uint32_t i = 0; i < uCount; i++)
+            uMismatches += strtoll(&pcText[(size_t)i * PL_NUMBER_MAX_CHARS], NULL, 10) != aiValues[i];
+        dTime = elapsed_ms(tStart);
+        dIntParseLibc = dTime < dIntParseLibc ? dTime : dIntParseLibc;
+    }
+
+    printf("number:   format double %6.1f ns (snprintf %%.17g %6.1f ns)\n", dFormat * 1e6 / uCount, dFormatLibc * 1e6 / uCount);
+    printf("number:   parse double  %6.1f ns (strtod         %6.1f ns)\n", dParse * 1e6 / uCount, dParseLibc * 1e6 / uCount);
+    printf("number:   format int64  %6.1f ns (snprintf %%lld   %6.1f ns)\n", dIntFormat * 1e6 / uCount, dIntFormatLibc * 1e6 / uCount);
+    printf("number:   parse int64   %6.1f ns (strtoll        %6.1f ns)%s\n", dIntParse * 1e6 / uCount, dIntParseLibc * 1e6 / uCount,
+        uMismatches == 0 ? "" : " (ROUND TRIP MISMATCH)");
+
+    free(pcText);
+    free(aiValues);
+    free(adValues);
+}
+
+// two stage parser throughput on compact, pretty printed & newline delimited input
+static void
+bench_parse(size_t szTargetSize)
+{
+    const char* apcLabels[] = {"compact", "pretty"};
+    for(uint32_t uVariant = 0; uVariant < 2; uVariant++)
+    {
+        size_t szSize = 0;
+        char* pcText = bench_generate_document(szTargetSize, 64, uVariant == 1, &szSize);
+        double dBest = 1e30;
+        for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+        {
+            plJsonObject* ptJson = NULL;
+            const clock_t tStart = clock();
+            const bool bResult = pl_parse_json(pcText, szSize, &ptJson);
+            const double dTime = elapsed_ms(tStart);
+            dBest = dTime < dBest ? dTime : dBest;
+            if(bResult)
+                pl_unload_json(&ptJson);
+        }
+        printf("parse:    %-8s %10zu bytes %8.2f ms (%6.3f GB/s)\n", apcLabels[uVariant], szSize, dBest, megabytes_per_second(szSize, dBest) / 1024.0);
+        free(pcText);
+    }
+
+    size_t szSize = 0;
+    char* pcLines = bench_generate_ndjson(szTargetSize, &szSize);
+    double dBest = 1e30;
+    uint32_t uDocuments = 0;
+    for(uint32_t uRun = 0; uRun < BENCH_RUNS; uRun++)
+    {
+        uDocuments = 0;
+        size_t szCursor = 0;
+        plJsonObject* ptJson = NULL;
+        const clock_t tStart = clock();
+        while(pl_parse_json_ndjson(pcLines, szSize, &szCursor, &ptJson))
+        {
+            pl_unload_json(&ptJson);
+            uDocuments++;
+        }
+        const double dTime = elapsed_ms(tStart);
+        dBest = dTime < dBest ? dTime : dBest;
+    }
+    printf("parse:    %-8s %10zu bytes %8.2f ms (%6.3f GB/s, %u documents)\n", "ndjson", szSize, dBest, megabytes_per_second(szSize, dBest) / 1024.0, uDocuments);
+    free(pcLines);
+}
+
+static int
+command_bench(size_t szMegabytes)
+{
+    const uint32_t uConfigMembers = 4096;
+    size_t szSize = 0;
+    char* pcText = bench_generate_document(szMegabytes * 1024 * 1024, uConfigMembers, false, &szSize);
+    printf("document: %zu bytes\n", szSize);
+
+    bench_dom(pcText, szSize, uConfigMembers);
+    bench_bin(pcText, szSize, uConfigMembers);
+    bench_parse(szMegabytes * 1024 * 1024);
+    bench_write(pcText, szSize);
+    bench_numbers();
+
+    free(pcText);
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] main
+//-----------------------------------------------------------------------------
+
+int
+main(int argc, char* argv[])
+{
+    if(argc == 4 && strcmp(argv[1], "to-bin") == 0)
+        return command_to_bin(argv[2], argv[3]);
+    if(argc == 4 && strcmp(argv[1], "to-json") == 0)
+        return command_to_json(argv[2], argv[3]);
+    if(argc == 3 && strcmp(argv[1], "roundtrip") == 0)
+        return command_roundtrip(argv[2]);
+    if(argc <= 3 && argc >= 2 && strcmp(argv[1], "bench") == 0)
+        return command_bench(argc == 3 ? (size_t)strtoul(argv[2], NULL, 10) : 32);
+
+    printf("usage:\n");
+    printf("  pl_json_bin_tool to-bin    <input.json>  <output.plbin>\n");
+    printf("  pl_json_bin_tool to-json   <input.plbin> <output.json>\n");
+    printf("  pl_json_bin_tool roundtrip <input.json>\n");
+    printf("  pl_json_bin_tool bench     [megabytes]\n");
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] unity build
+//-----------------------------------------------------------------------------
+
+#define PL_NUMBER_IMPLEMENTATION
+#include "pl_number.h"
+
+#define PL_JSON_IMPLEMENTATION
+#include "pl_json.h"
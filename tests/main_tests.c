@@ -1,6 +1,7 @@
 #include "pl_ds_tests.h"
 #include "pl_json_tests.h"
 #include "pl_memory_tests.h"
+#include "pl_number_tests.h"
 #include "pl_string_tests.h"
 
 int main()
@@ -28,6 +29,10 @@ int main()
     pl_string_tests(NULL);
     pl_test_run_suite("pl_string.h");
 
+    // pl_number.h tests
+    pl_number_tests(NULL);
+    pl_test_run_suite("pl_number.h");
+
     bool bResult = pl_test_finish();
 
     if(!bResult)
@@ -37,6 +42,10 @@ int main()
     return 0;
 }
 
+// before pl_json.h so it uses pl_number.h for number conversion
+#define PL_NUMBER_IMPLEMENTATION
+#include "pl_number.h"
+
 #define PL_JSON_IMPLEMENTATION
 #include "pl_json.h"
 
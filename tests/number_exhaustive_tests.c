@@ -0,0 +1,63 @@
+/*
+   number_exhaustive_tests.c
+     * exhaustive pl_number.h float round trip (all 2^32 bit patterns)
+
+   usage:
+     pl_number_exhaustive_test
+
+   pilot_light_test samples 1 in PL_NUMBER_TEST_FLOAT_STRIDE patterns so the
+   regular suite stays fast; this target checks every one & takes minutes
+   (build the release configuration)
+*/
+
+/*
+Index of this file:
+// [SECTION] includes
+// [SECTION] main
+// [SECTION] unity build
+*/
+
+//-----------------------------------------------------------------------------
+// [SECTION] includes
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PL_NUMBER_TEST_FLOAT_STRIDE 1
+#include "pl_number_tests.h"
+
+//-----------------------------------------------------------------------------
+// [SECTION] main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    plTestOptions tOptions = {
+        .bPrintSuiteResults = true,
+        .bPrintColor = true
+    };
+    pl_create_test_context(tOptions);
+
+    pl_test_register_test(number_float_round_trip_test, NULL);
+    pl_test_run_suite("pl_number.h (exhaustive)");
+
+    bool bResult = pl_test_finish();
+
+    if(!bResult)
+    {
+        exit(1);
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] unity build
+//-----------------------------------------------------------------------------
+
+#define PL_NUMBER_IMPLEMENTATION
+#include "pl_number.h"
+
+#define PL_TEST_WIN32_COLOR
+#define PL_TEST_IMPLEMENTATION
+#include "pl_test.h"
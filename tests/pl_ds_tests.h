@@ -100,10 +100,64 @@ hashmap_test_2(void* pData)
     pl_sb_free(sbiValues);
 }
 
+void
+stretchy_buffer_growth_test(void* pData)
+{
+    // growth is geometric for every way of growing, so the number of
+    // reallocations stays logarithmic in the final size
+    int* sbiValues = NULL;
+    uint32_t uReallocations = 0;
+    uint32_t uCapacity = 0;
+    for(uint32_t i = 0; i < 100000; i++)
+    {
+        if(i % 3 == 0)
+            pl_sb_push(sbiValues, (int)i);
+        else if(i % 3 == 1)
+            pl_sb_add_n(sbiValues, 2);
+        else
+            pl_sb_resize(sbiValues, pl_sb_size(sbiValues) + 1);
+        if(pl_sb_capacity(sbiValues) != uCapacity)
+        {
+            uCapacity = pl_sb_capacity(sbiValues);
+            uReallocations++;
+        }
+    }
+    pl_test_expect_true(uReallocations < 32, NULL);
+    pl_test_expect_true(pl_sb_capacity(sbiValues) <= 2 * pl_sb_size(sbiValues), NULL);
+    pl_sb_free(sbiValues);
+}
+
+void
+stretchy_buffer_resize_test(void* pData)
+{
+    // reserve is exact & resize/reserve evaluate their arguments once
+    int* asbiValues[2] = {NULL, NULL};
+    uint32_t uIndex = 0;
+    uint32_t uCalls = 0;
+    pl_sb_resize(asbiValues[uIndex++], (uCalls++, 10));
+    pl_test_expect_uint32_equal(uIndex, 1, NULL);
+    pl_test_expect_uint32_equal(uCalls, 1, NULL);
+    pl_test_expect_uint32_equal(pl_sb_size(asbiValues[0]), 10, NULL);
+    pl_test_expect_true(asbiValues[1] == NULL, NULL);
+
+    pl_sb_reserve(asbiValues[--uIndex], (uCalls++, 100));
+    pl_test_expect_uint32_equal(uIndex, 0, NULL);
+    pl_test_expect_uint32_equal(uCalls, 2, NULL);
+    pl_test_expect_uint32_equal(pl_sb_capacity(asbiValues[0]), 110, NULL);
+    pl_test_expect_uint32_equal(pl_sb_size(asbiValues[0]), 10, NULL);
+
+    pl_sb_resize(asbiValues[0], 4);
+    pl_test_expect_uint32_equal(pl_sb_size(asbiValues[0]), 4, NULL);
+    pl_test_expect_uint32_equal(pl_sb_capacity(asbiValues[0]), 110, NULL);
+    pl_sb_free(asbiValues[0]);
+}
+
 void
 pl_ds_tests(void* pData)
 {
     pl_test_register_test(hashmap_test_0, NULL);
     pl_test_register_test(hashmap_test_1, NULL);
     pl_test_register_test(hashmap_test_2, NULL);
+    pl_test_register_test(stretchy_buffer_growth_test, NULL);
+    pl_test_register_test(stretchy_buffer_resize_test, NULL);
 }
\ No newline at end of file
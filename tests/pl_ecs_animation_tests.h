@@ -0,0 +1,808 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+// keyframe data with uStride floats per key (3 per key for cubic splines)
+static plEntity
+ecs_test_create_animation_data(plComponentLibrary* ptLibrary, uint32_t uStride, plAnimationMode tMode)
+{
+    plEntity tEntity = gptECS->create_entity(ptLibrary);
+    plAnimationDataComponent* ptData = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, tEntity);
+    const uint32_t uValuesPerKey = tMode == PL_ANIMATION_MODE_CUBIC_SPLINE ? 3 * uStride : uStride;
+    for(uint32_t i = 0; i < 12; i++)
+    {
+        pl_sb_push(ptData->sbfKeyFrameTimes, (float)i * 0.1f);
+        for(uint32_t j = 0; j < uValuesPerKey; j++)
+            pl_sb_push(ptData->sbfKeyFrameData, ecs_test_rand());
+    }
+    return tEntity;
+}
+
+// a looping translation/rotation/scale animation per skin (two per skin blended
+// at 0.5 when bShared, so every joint is targeted by two animations)
+static void
+ecs_test_add_animations(plComponentLibrary* ptLibrary, bool bShared)
+{
+    const plAnimationMode atModes[] = {PL_ANIMATION_MODE_LINEAR, PL_ANIMATION_MODE_STEP, PL_ANIMATION_MODE_CUBIC_SPLINE};
+    const plAnimationPath atPaths[] = {PL_ANIMATION_PATH_TRANSLATION, PL_ANIMATION_PATH_ROTATION, PL_ANIMATION_PATH_SCALE};
+    const uint32_t auStrides[] = {3, 4, 3};
+    plEntity atData[3][3];
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        for(uint32_t j = 0; j < 3; j++)
+            atData[i][j] = ecs_test_create_animation_data(ptLibrary, auStrides[i], atModes[j]);
+    }
+
+    const uint32_t uSkinCount = pl_sb_size(ptLibrary->tSkinComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uSkinCount; i++)
+    {
+        const plSkinComponent* ptSkin = &((plSkinComponent*)ptLibrary->tSkinComponentManager.pComponents)[i];
+        for(uint32_t uCopy = 0; uCopy < (bShared ? 2u : 1u); uCopy++)
+        {
+            plEntity tEntity = gptECS->create_entity(ptLibrary);
+            plAnimationComponent* ptAnimation = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tEntity);
+            ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING | PL_ANIMATION_FLAG_LOOPED;
+            ptAnimation->fEnd = 1.1f;
+            ptAnimation->fSpeed = 1.0f;
+            ptAnimation->fBlendAmount = uCopy > 0 ? 0.5f : 1.0f;
+            ptAnimation->fTimer = ecs_test_rand();
+            for(uint32_t j = 0; j < pl_sb_size(ptSkin->sbtJoints); j++)
+            {
+                const uint32_t uMode = (i + j) % 3;
+                for(uint32_t k = 0; k < 3; k++)
+                {
+                    const plAnimationSampler tSampler = {.tMode = atModes[uMode], .tData = atData[k][uMode]};
+                    pl_sb_push(ptAnimation->sbtSamplers, tSampler);
+                    const plAnimationChannel tChannel = {
+                        .tPath         = atPaths[k],
+                        .tTarget       = ptSkin->sbtJoints[j],
+                        .uSamplerIndex = pl_sb_size(ptAnimation->sbtSamplers) - 1
+                    };
+                    pl_sb_push(ptAnimation->sbtChannels, tChannel);
+                }
+            }
+        }
+    }
+}
+
+static void
+ecs_test_set_animation_timers(plComponentLibrary* ptLibrary, float fTime)
+{
+    plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtComponents); i++)
+        sbtComponents[i].fTimer = fTime;
+}
+
+static bool
+ecs_test_translation_near(plComponentLibrary* ptLibrary, plEntity tJoint, plVec3 tExpected, float fError)
+{
+    const plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tJoint);
+    return pl_length_vec3(pl_sub_vec3(ptTransform->tTranslation, tExpected)) < fError;
+}
+
+// either sign of the expected quaternion
+static bool
+ecs_test_rotation_near(plComponentLibrary* ptLibrary, plEntity tJoint, plVec4 tExpected, float fError)
+{
+    const plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tJoint);
+    if(pl_dot_vec4(ptTransform->tRotation, tExpected) < 0.0f)
+        tExpected = pl_mul_vec4_scalarf(tExpected, -1.0f);
+    return pl_length_vec4(pl_sub_vec4(ptTransform->tRotation, tExpected)) < fError;
+}
+
+static void
+ecs_test_reset_joints(plComponentLibrary* ptLibrary, const plEntity* atJoints, uint32_t uJointCount)
+{
+    for(uint32_t i = 0; i < uJointCount; i++)
+    {
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, atJoints[i]);
+        ptTransform->tTranslation = pl_create_vec3(0.0f, (float)i, 0.0f);
+        ptTransform->tRotation = pl_create_vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        ptTransform->tScale = pl_create_vec3(1.0f, 1.0f, 1.0f);
+    }
+}
+
+static void
+ecs_test_copy_palettes(plComponentLibrary* ptLibrary, plMat4** psbtPalettes)
+{
+    const plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+    pl_sb_reset(*psbtPalettes);
+    for(uint32_t i = 0; i < pl_sb_size(sbtSkins); i++)
+    {
+        for(uint32_t j = 0; j < pl_sb_size(sbtSkins[i].sbtTextureData); j++)
+            pl_sb_push(*psbtPalettes, sbtSkins[i].sbtTextureData[j]);
+    }
+}
+
+// max relative difference of joint (even) & normal (odd) matrices
+static void
+ecs_test_compare_palettes(const plMat4* sbtPalette0, const plMat4* sbtPalette1, float* pfJointError, float* pfNormalError)
+{
+    *pfJointError = 0.0f;
+    *pfNormalError = 0.0f;
+    for(uint32_t i = 0; i < pl_sb_size(sbtPalette0); i++)
+    {
+        for(uint32_t j = 0; j < 16; j++)
+        {
+            const float fError = fabsf(sbtPalette0[i].d[j] - sbtPalette1[i].d[j]) / pl_maxf(1.0f, fabsf(sbtPalette0[i].d[j]));
+            if(i % 2)
+                *pfNormalError = pl_maxf(*pfNormalError, fError);
+            else
+                *pfJointError = pl_maxf(*pfJointError, fError);
+        }
+    }
+}
+
+// compares the cpu skinned data against the shader port & the renderer's vertex
+// layout; returns the max abs difference (layout mismatches count into puWrong)
+static float
+ecs_test_check_skinned_mesh(plComponentLibrary* ptLibrary, plEntity tMesh, uint32_t* puWrong)
+{
+    const plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tMesh);
+    const plSkinComponent* ptSkin = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+    const plTransformComponent* ptNode = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptSkin->tMeshNode);
+    const plSkinnedMeshData* ptData = gptECS->get_skinned_mesh_data(ptLibrary, tMesh);
+    const uint32_t uVertexCount = pl_sb_size(ptMesh->sbtVertexPositions);
+    const bool bNormals = pl_sb_size(ptMesh->sbtVertexNormals) > 0;
+    const bool bTangents = pl_sb_size(ptMesh->sbtVertexTangents) > 0;
+    const bool bTextureCoordinates = pl_sb_size(ptMesh->sbtVertexTextureCoordinates[0]) > 0;
+    const bool bColors = pl_sb_size(ptMesh->sbtVertexColors[0]) > 0;
+    const uint32_t uStride = bNormals + bTangents + bTextureCoordinates + bColors;
+    if(ptData == NULL || ptData->uVertexCount != uVertexCount || ptData->uDataStride != uStride || ptData->tMesh.ulData != tMesh.ulData)
+    {
+        (*puWrong)++;
+        return 0.0f;
+    }
+
+    float fError = 0.0f;
+    plAABB tBounds = {.tMin = {.x = FLT_MAX, .y = FLT_MAX, .z = FLT_MAX}, .tMax = {.x = -FLT_MAX, .y = -FLT_MAX, .z = -FLT_MAX}};
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        const plMat4 tSkin = ecs_test_reference_skin_matrix(ptSkin->sbtTextureData, ptMesh->sbtVertexJoints[0][i], ptMesh->sbtVertexWeights[0][i]);
+        const plVec3 tPosition = pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptMesh->sbtVertexPositions[i].x, ptMesh->sbtVertexPositions[i].y, ptMesh->sbtVertexPositions[i].z, 1.0f)).xyz;
+        for(uint32_t k = 0; k < 3; k++)
+            fError = pl_maxf(fError, fabsf(tPosition.d[k] - ptData->sbtVertexPositions[i].d[k]));
+        const plVec3 tWorldPosition = pl_mul_mat4_vec3(&ptNode->tWorld, tPosition);
+        tBounds.tMin = pl_min_vec3(tBounds.tMin, tWorldPosition);
+        tBounds.tMax = pl_max_vec3(tBounds.tMax, tWorldPosition);
+
+        const plVec4* atVertexData = &ptData->sbtVertexData[i * uStride];
+        uint32_t uOffset = 0;
+        if(bNormals)
+        {
+            const plVec3* ptNormal = &ptMesh->sbtVertexNormals[i];
+            const plVec3 tNormal = pl_norm_vec3(pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptNormal->x, ptNormal->y, ptNormal->z, 0.0f)).xyz);
+            for(uint32_t k = 0; k < 3; k++)
+                fError = pl_maxf(fError, fabsf(tNormal.d[k] - atVertexData[uOffset].d[k]));
+            *puWrong += atVertexData[uOffset++].w != 0.0f;
+        }
+        if(bTangents)
+        {
+            const plVec4* ptTangent = &ptMesh->sbtVertexTangents[i];
+            const plVec3 tTangent = pl_norm_vec3(pl_mul_mat4_vec4(&tSkin, pl_create_vec4(ptTangent->x, ptTangent->y, ptTangent->z, 0.0f)).xyz);
+            for(uint32_t k = 0; k < 3; k++)
+                fError = pl_maxf(fError, fabsf(tTangent.d[k] - atVertexData[uOffset].d[k]));
+            *puWrong += atVertexData[uOffset++].w != ptTangent->w;
+        }
+        if(bTextureCoordinates)
+        {
+            const plVec4 tValue = atVertexData[uOffset++];
+            *puWrong += tValue.x != ptMesh->sbtVertexTextureCoordinates[0][i].u || tValue.y != ptMesh->sbtVertexTextureCoordinates[0][i].v || tValue.z != 0.0f || tValue.w != 0.0f;
+        }
+        if(bColors)
+            *puWrong += memcmp(&atVertexData[uOffset++], &ptMesh->sbtVertexColors[0][i], sizeof(plVec4)) != 0;
+    }
+
+    // final bounds contain every skinned vertex
+    for(uint32_t k = 0; k < 3; k++)
+        *puWrong += ptMesh->tAABBFinal.tMin.d[k] > tBounds.tMin.d[k] + 1e-3f || ptMesh->tAABBFinal.tMax.d[k] < tBounds.tMax.d[k] - 1e-3f;
+    return fError;
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+animation_determinism_test(void* pData)
+{
+    // same scene run on every worker count & in deterministic mode must stay
+    // bit identical, including when two animations blend onto the same skeleton
+    char acName[64] = {0};
+    for(uint32_t uShared = 0; uShared < 2; uShared++)
+    {
+        // library 0 is the 1 thread reference, library 1 is reused for the rest
+        plComponentLibrary atLibraries[2] = {0};
+        for(uint32_t uVariant = 0; uVariant <= PL_TEST_THREAD_COUNT_VARIANTS; uVariant++)
+        {
+            // the last variant is deterministic mode on the most threads
+            const bool bDeterministic = uVariant == PL_TEST_THREAD_COUNT_VARIANTS;
+            const uint32_t uThreadCount = gauTestThreadCounts[bDeterministic ? uVariant - 1 : uVariant];
+            test_set_thread_count(uThreadCount);
+
+            plComponentLibrary* ptLibrary = &atLibraries[uVariant == 0 ? 0 : 1];
+            guEcsTestSeed = 7;
+            gptECS->init_component_library(ptLibrary);
+            ecs_test_build_scene(ptLibrary, 400, 40);
+            ecs_test_add_animations(ptLibrary, uShared == 1);
+            gptECS->set_deterministic(ptLibrary, bDeterministic);
+            for(uint32_t uFrame = 0; uFrame < 30; uFrame++)
+                ecs_test_run_frame(ptLibrary, 0.016f);
+            if(uVariant == 0)
+                continue;
+
+            if(bDeterministic)
+                snprintf(acName, 64, "%sdeterministic mode", uShared ? "shared targets, " : "");
+            else
+                snprintf(acName, 64, "%s%u threads", uShared ? "shared targets, " : "", uThreadCount);
+            pl_test_expect_true(ecs_test_libraries_identical(&atLibraries[0], ptLibrary), acName);
+            gptECS->cleanup_component_library(ptLibrary);
+        }
+        gptECS->cleanup_component_library(&atLibraries[0]);
+    }
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+}
+
+void
+animation_sampling_test(void* pData)
+{
+    // cursor/binary search sampling vs the linear scan: forward playback,
+    // seeks & large jumps, short & long clips, every interpolation mode
+    for(uint32_t uConfig = 0; uConfig < 4; uConfig++)
+    {
+        const uint32_t uKeys = uConfig < 2 ? 50 : 3000;
+        const bool bMixedModes = (uConfig & 1) != 0;
+        plComponentLibrary tReference = {0};
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tReference);
+        gptECS->init_component_library(&tLibrary);
+        guEcsTestSeed = 11 + uConfig;
+        ecs_test_add_clip(&tReference, 10, uKeys, bMixedModes);
+        guEcsTestSeed = 11 + uConfig;
+        ecs_test_add_clip(&tLibrary, 10, uKeys, bMixedModes);
+        const float fEnd = ((plAnimationComponent*)tLibrary.tAnimationComponentManager.pComponents)[0].fEnd;
+
+        uint32_t uMismatches = 0;
+        for(uint32_t uFrame = 0; uFrame < 2000; uFrame++)
+        {
+            float fDeltaTime = 0.016f;
+            if(uFrame % 300 == 150)
+            {
+                const float fSeek = ecs_test_rand() * fEnd;
+                ecs_test_set_animation_timers(&tReference, fSeek);
+                ecs_test_set_animation_timers(&tLibrary, fSeek);
+            }
+            if(uFrame % 500 == 499)
+                fDeltaTime = fEnd * 0.37f;
+            ecs_test_reference_animation(&tReference, fDeltaTime);
+            gptECS->run_animation_update_system(&tLibrary, fDeltaTime);
+            if(memcmp(tReference.tTransformComponentManager.pComponents, tLibrary.tTransformComponentManager.pComponents,
+                pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities) * sizeof(plTransformComponent)) != 0)
+                uMismatches++;
+        }
+        pl_test_expect_uint32_equal(uMismatches, 0, bMixedModes ? "mixed modes vs linear scan" : "linear vs linear scan");
+        gptECS->cleanup_component_library(&tReference);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+
+    // edited keyframe data is picked up after invalidating the cache
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 3;
+    ecs_test_add_clip(&tLibrary, 2, 20, false);
+    gptECS->run_animation_update_system(&tLibrary, 0.01f);
+    plAnimationDataComponent* sbtData = tLibrary.tAnimationDataComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtData[0].sbfKeyFrameData); i++)
+        sbtData[0].sbfKeyFrameData[i] = 5.0f;
+    gptECS->invalidate_animation_cache(&tLibrary, tLibrary.tAnimationComponentManager.sbtEntities[0]);
+    gptECS->run_animation_update_system(&tLibrary, 0.01f);
+    const plTransformComponent* sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+    pl_test_expect_float_near_equal(sbtTransforms[0].tTranslation.x, 5.0f, 0.0f, "invalidated cache");
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+animation_compression_test(void* pData)
+{
+    // max bone space deviation stays within a small multiple of the tolerance
+    // (rotation & translation errors add up at the unit points)
+    const float afTolerances[] = {1e-4f, 1e-3f, 1e-2f};
+    for(int iMode = -1; iMode <= PL_ANIMATION_MODE_LINEAR; iMode += PL_ANIMATION_MODE_LINEAR + 1)
+    {
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            plComponentLibrary tReference = {0};
+            plComponentLibrary tLibrary = {0};
+            gptECS->init_component_library(&tReference);
+            gptECS->init_component_library(&tLibrary);
+            guEcsTestSeed = 5;
+            ecs_test_add_mocap_clip(&tReference, 20, 300, iMode);
+            guEcsTestSeed = 5;
+            plEntity tAnimation = ecs_test_add_mocap_clip(&tLibrary, 20, 300, iMode);
+            gptECS->run_animation_update_system(&tReference, 0.0f);
+            const plAnimationCompressionDesc tDesc = {afTolerances[i], afTolerances[i], afTolerances[i]};
+            gptECS->compress_animation(&tLibrary, tAnimation, &tDesc);
+
+            plAnimationComponent* ptReference = tReference.tAnimationComponentManager.pComponents;
+            plAnimationComponent* ptAnimation = tLibrary.tAnimationComponentManager.pComponents;
+            pl_test_expect_true(ecs_test_clip_size(ptAnimation->_ptClip) < ecs_test_clip_size(ptReference->_ptClip), "compressed size");
+
+            float fDeviation = 0.0f;
+            for(uint32_t uFrame = 0; uFrame < 600; uFrame++)
+            {
+                if(uFrame % 400 == 200)
+                {
+                    ptReference->fTimer = ecs_test_rand() * ptReference->fEnd;
+                    ptAnimation->fTimer = ptReference->fTimer;
+                }
+                gptECS->run_animation_update_system(&tReference, 0.0071f);
+                gptECS->run_animation_update_system(&tLibrary, 0.0071f);
+                fDeviation = pl_maxf(fDeviation, ecs_test_bone_space_deviation(&tReference, &tLibrary));
+            }
+            pl_test_expect_true(fDeviation < afTolerances[i] * 4.0f + 1e-4f, "bone space deviation");
+            gptECS->cleanup_component_library(&tReference);
+            gptECS->cleanup_component_library(&tLibrary);
+        }
+    }
+
+    // cubic spline channels stay uncompressed (bit identical)
+    plComponentLibrary tReference = {0};
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tReference);
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 9;
+    ecs_test_add_mocap_clip(&tReference, 10, 100, PL_ANIMATION_MODE_CUBIC_SPLINE);
+    guEcsTestSeed = 9;
+    plEntity tAnimation = ecs_test_add_mocap_clip(&tLibrary, 10, 100, PL_ANIMATION_MODE_CUBIC_SPLINE);
+    gptECS->compress_animation(&tLibrary, tAnimation, NULL);
+    for(uint32_t uFrame = 0; uFrame < 100; uFrame++)
+    {
+        gptECS->run_animation_update_system(&tReference, 0.013f);
+        gptECS->run_animation_update_system(&tLibrary, 0.013f);
+    }
+    pl_test_expect_true(memcmp(tReference.tTransformComponentManager.pComponents, tLibrary.tTransformComponentManager.pComponents,
+        10 * sizeof(plTransformComponent)) == 0, "cubic spline channels");
+
+    // invalidating the cache reverts to the uncompressed clip
+    gptECS->invalidate_animation_cache(&tLibrary, tAnimation);
+    gptECS->run_animation_update_system(&tLibrary, 0.0f);
+    const plAnimationComponent* ptAnimation = tLibrary.tAnimationComponentManager.pComponents;
+    pl_test_expect_true(ptAnimation->_ptClip->sbtCompressedChannels == NULL, "invalidated compressed clip");
+    gptECS->cleanup_component_library(&tReference);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+blend_tree_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    plEntity atJoints[3] = {0};
+    for(uint32_t i = 0; i < 3; i++)
+        atJoints[i] = gptECS->create_transform(&tLibrary, NULL, NULL);
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+
+    const plEcsTestJointKeys atKeysA[3] = {
+        {{.x = 0, .y = 0, .z = 0}, {.x = 1, .y = 0, .z = 0}, 0.0f, 0.0f},
+        {{.x = 0, .y = 1, .z = 0}, {.x = 0, .y = 1, .z = 0}, 0.0f, 0.0f},
+        {{.x = 0, .y = 2, .z = 0}, {.x = 0, .y = 2, .z = 0}, 0.0f, 0.0f}
+    };
+    const plEcsTestJointKeys atKeysB[3] = {
+        {{.x = 2, .y = 0, .z = 0}, {.x = 2, .y = 0, .z = 0}, 1.0f, 1.0f},
+        {{.x = 0, .y = 3, .z = 0}, {.x = 0, .y = 3, .z = 0}, 0.5f, 0.5f},
+        {{.x = 4, .y = 0, .z = 0}, {.x = 4, .y = 0, .z = 0}, 1.0f, 1.0f}
+    };
+    const plEcsTestJointKeys atKeysC[3] = {
+        {{.x = 4, .y = 0, .z = 0}, {.x = 4, .y = 0, .z = 0}, -1.0f, -1.0f},
+        {{.x = 0, .y = 5, .z = 0}, {.x = 0, .y = 5, .z = 0}, 0.0f, 0.0f},
+        {{.x = 0, .y = 0, .z = 0}, {.x = 0, .y = 0, .z = 0}, 0.0f, 0.0f}
+    };
+    const plEcsTestJointKeys atKeysRef[3] = {
+        {{.x = 0, .y = 0, .z = 0}, {.x = 0, .y = 0, .z = 0}, 0.0f, 0.0f},
+        {{.x = 0, .y = 1, .z = 0}, {.x = 0, .y = 1, .z = 0}, 0.0f, 0.0f},
+        {{.x = 0, .y = 2, .z = 0}, {.x = 0, .y = 2, .z = 0}, 0.0f, 0.0f}
+    };
+    const plEntity tClipA = ecs_test_add_blend_clip(&tLibrary, atJoints, atKeysA, 1);
+    const plEntity tClipB = ecs_test_add_blend_clip(&tLibrary, atJoints, atKeysB, 3);
+    const plEntity tClipC = ecs_test_add_blend_clip(&tLibrary, atJoints, atKeysC, 3);
+    const plEntity tClipRef = ecs_test_add_blend_clip(&tLibrary, atJoints, atKeysRef, 3);
+
+    // single clip: time advances & loops, unanimated joints keep their pose
+    plAnimationBlendTree* ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    gptECS->add_blend_clip(ptTree, tClipA, 1.0f, true);
+    gptECS->run_blend_tree_system(&tLibrary, 0.25f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(0.25f, 0.0f, 0.0f), 1e-6f), "clip");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[2], pl_create_vec3(0.0f, 2.0f, 0.0f), 1e-6f), "unanimated joint");
+    gptECS->run_blend_tree_system(&tLibrary, 0.95f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(0.2f, 0.0f, 0.0f), 1e-5f), "looped clip");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+    pl_test_expect_true(ptTree == NULL, NULL);
+
+    // 1D blend space: linear weights between neighbours, clamped outside
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+    ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    uint32_t auNodes[3] = {
+        gptECS->add_blend_clip(ptTree, tClipA, 0.0f, false),
+        gptECS->add_blend_clip(ptTree, tClipB, 0.0f, false),
+        gptECS->add_blend_clip(ptTree, tClipC, 0.0f, false)
+    };
+    const float afPositions[3] = {0.0f, 1.0f, 2.0f};
+    uint32_t uSpace = gptECS->add_blend_space_1d(ptTree, 3, auNodes, afPositions);
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(0.25f, 0.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    const plVec4 tBlended = pl_norm_vec4(pl_add_vec4(
+        pl_mul_vec4_scalarf(pl_quat_rotation_normal(0.0f, 0.0f, 1.0f, 0.0f), 0.75f),
+        pl_mul_vec4_scalarf(pl_quat_rotation_normal(1.0f, 0.0f, 1.0f, 0.0f), 0.25f)));
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(0.5f, 0.0f, 0.0f), 1e-6f), "1D translation");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[0], tBlended, 1e-6f), "1D rotation");
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(1.5f, 0.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(3.0f, 0.0f, 0.0f), 1e-6f), "1D second segment");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[1], pl_create_vec3(0.0f, 4.0f, 0.0f), 1e-6f), "1D second segment");
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(7.0f, 0.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[1], pl_create_vec3(0.0f, 5.0f, 0.0f), 1e-6f), "1D clamped");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+
+    // 2D blend space (gradient band interpolation)
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+    ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    auNodes[0] = gptECS->add_blend_clip(ptTree, tClipA, 0.0f, false);
+    auNodes[1] = gptECS->add_blend_clip(ptTree, tClipB, 0.0f, false);
+    auNodes[2] = gptECS->add_blend_clip(ptTree, tClipC, 0.0f, false);
+    const plVec2 atPositions[3] = {{.x = 0.0f, .y = 0.0f}, {.x = 1.0f, .y = 0.0f}, {.x = 0.0f, .y = 1.0f}};
+    uSpace = gptECS->add_blend_space_2d(ptTree, 3, auNodes, atPositions);
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(0.0f, 1.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(4.0f, 0.0f, 0.0f), 1e-6f), "2D on a sample");
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(0.5f, 0.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(1.0f, 0.0f, 0.0f), 1e-6f), "2D on an edge");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[1], pl_create_vec3(0.0f, 2.0f, 0.0f), 1e-6f), "2D on an edge");
+    // weights at (0.3, 0.3): 0.7, 0.3 & 0.3 normalized by 1.3
+    gptECS->set_blend_parameter(ptTree, uSpace, pl_create_vec2(0.3f, 0.3f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3((0.3f * 2.0f + 0.3f * 4.0f) / 1.3f, 0.0f, 0.0f), 1e-5f), "2D inside");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+
+    // override layer with a bone mask
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+    ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    const float afMask[3] = {1.0f, 0.0f, 0.5f};
+    plBlendLayerDesc tLayerDesc = {
+        .tMode   = PL_BLEND_LAYER_MODE_OVERRIDE,
+        .uBase   = gptECS->add_blend_clip(ptTree, tClipRef, 0.0f, false),
+        .uLayer  = gptECS->add_blend_clip(ptTree, tClipB, 0.0f, false),
+        .fWeight = 1.0f,
+        .afMask  = afMask
+    };
+    const uint32_t uLayer = gptECS->add_blend_layer(ptTree, &tLayerDesc);
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(2.0f, 0.0f, 0.0f), 1e-6f), "masked in");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[0], pl_quat_rotation_normal(1.0f, 0.0f, 1.0f, 0.0f), 1e-6f), "masked in");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[1], pl_create_vec3(0.0f, 1.0f, 0.0f), 1e-6f), "masked out");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[1], pl_quat_rotation_normal(0.0f, 0.0f, 1.0f, 0.0f), 1e-6f), "masked out");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[2], pl_create_vec3(2.0f, 1.0f, 0.0f), 1e-6f), "half masked");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[2], pl_quat_rotation_normal(0.5f, 0.0f, 1.0f, 0.0f), 1e-5f), "half masked");
+    gptECS->set_blend_parameter(ptTree, uLayer, pl_create_vec2(0.0f, 0.0f));
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(0.0f, 0.0f, 0.0f), 1e-6f), "layer weight 0");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+
+    // additive layer: base + weight * (layer - reference)
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+    ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    tLayerDesc = (plBlendLayerDesc){
+        .tMode      = PL_BLEND_LAYER_MODE_ADDITIVE,
+        .uBase      = gptECS->add_blend_clip(ptTree, tClipC, 0.0f, false),
+        .uReference = gptECS->add_blend_clip(ptTree, tClipRef, 0.0f, false),
+        .uLayer     = gptECS->add_blend_clip(ptTree, tClipB, 0.0f, false),
+        .fWeight    = 0.5f
+    };
+    gptECS->add_blend_layer(ptTree, &tLayerDesc);
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[0], pl_create_vec3(5.0f, 0.0f, 0.0f), 1e-6f), "additive");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[0], pl_quat_rotation_normal(-0.5f, 0.0f, 1.0f, 0.0f), 1e-5f), "additive");
+    pl_test_expect_true(ecs_test_translation_near(&tLibrary, atJoints[1], pl_create_vec3(0.0f, 6.0f, 0.0f), 1e-6f), "additive");
+    pl_test_expect_true(ecs_test_rotation_near(&tLibrary, atJoints[1], pl_quat_rotation_normal(0.25f, 0.0f, 1.0f, 0.0f), 1e-5f), "additive");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+
+    // poses are written to local transforms before the transform system
+    ecs_test_reset_joints(&tLibrary, atJoints, 3);
+    ptTree = gptECS->create_blend_tree(&tLibrary, 3, atJoints);
+    gptECS->add_blend_clip(ptTree, tClipB, 0.0f, false);
+    gptECS->run_blend_tree_system(&tLibrary, 0.0f);
+    gptECS->run_transform_update_system(&tLibrary);
+    const plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, atJoints[0]);
+    pl_test_expect_float_near_equal(ptTransform->tWorld.col[3].x, 2.0f, 1e-6f, "world matrix");
+    gptECS->cleanup_blend_tree(&tLibrary, &ptTree);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+skin_palette_test(void* pData)
+{
+    // joint matrices match the original system exactly, normal matrices (affine
+    // inverse transpose vs full inverse) within rounding
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 3;
+    ecs_test_build_scene(&tLibrary, 200, 40);
+    ecs_test_scramble_transforms(&tLibrary);
+
+    plMat4* sbtReference = NULL;
+    plMat4* sbtPalettes = NULL;
+    float fJointError = 0.0f;
+    float fNormalError = 0.0f;
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    ecs_test_copy_palettes(&tLibrary, &sbtPalettes);
+    ecs_test_reference_skin(&tLibrary);
+    ecs_test_copy_palettes(&tLibrary, &sbtReference);
+    ecs_test_compare_palettes(sbtReference, sbtPalettes, &fJointError, &fNormalError);
+    pl_test_expect_float_near_equal(fJointError, 0.0f, 0.0f, "joint matrices");
+    pl_test_expect_true(fNormalError < 1e-4f, "normal matrices");
+
+    // removals move joints to new dense indices & joints are added/removed from
+    // skins, so the cached joint indices have to be refreshed
+    plEntity* sbtRemoved = NULL;
+    for(uint32_t i = 0; i < pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities); i += 3)
+    {
+        const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tLibrary.tObjectComponentManager.sbtEntities[i]);
+        if(ptMesh && ptMesh->tSkinComponent.uIndex == UINT32_MAX)
+            pl_sb_push(sbtRemoved, tLibrary.tObjectComponentManager.sbtEntities[i]);
+    }
+    for(uint32_t i = 0; i < pl_sb_size(sbtRemoved); i++)
+        gptECS->remove_entity(&tLibrary, sbtRemoved[i]);
+    plSkinComponent* sbtSkins = tLibrary.tSkinComponentManager.pComponents;
+    pl_sb_push(sbtSkins[0].sbtJoints, sbtSkins[1].sbtJoints[3]);
+    pl_sb_push(sbtSkins[0].sbtInverseBindMatrices, pl_identity_mat4());
+    pl_sb_push(sbtSkins[0].sbtTextureData, pl_identity_mat4());
+    pl_sb_push(sbtSkins[0].sbtTextureData, pl_identity_mat4());
+    pl_sb_pop_n(sbtSkins[2].sbtJoints, 1);
+    pl_sb_pop_n(sbtSkins[2].sbtInverseBindMatrices, 1);
+    pl_sb_pop_n(sbtSkins[2].sbtTextureData, 2);
+
+    ecs_test_scramble_transforms(&tLibrary);
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    ecs_test_copy_palettes(&tLibrary, &sbtPalettes);
+    ecs_test_reference_skin(&tLibrary);
+    ecs_test_copy_palettes(&tLibrary, &sbtReference);
+    ecs_test_compare_palettes(sbtReference, sbtPalettes, &fJointError, &fNormalError);
+    pl_test_expect_float_near_equal(fJointError, 0.0f, 0.0f, "joint matrices after removals");
+    pl_test_expect_true(fNormalError < 1e-4f, "normal matrices after removals");
+
+    pl_sb_free(sbtRemoved);
+    pl_sb_free(sbtReference);
+    pl_sb_free(sbtPalettes);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+cpu_skinning_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 7;
+    ecs_test_build_scene(&tLibrary, 50, 0);
+    plEntity atMeshes[12] = {0};
+    for(uint32_t i = 0; i < 12; i++)
+        atMeshes[i] = ecs_test_add_skinned_mesh(&tLibrary, 300 + i * 50, i % 3 != 0);
+
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+    gptECS->run_cpu_skinning_system(&tLibrary);
+    uint32_t uWrong = 0;
+    float fError = 0.0f;
+    for(uint32_t i = 0; i < 12; i++)
+        fError = pl_maxf(fError, ecs_test_check_skinned_mesh(&tLibrary, atMeshes[i], &uWrong));
+    pl_test_expect_uint32_equal(uWrong, 0, "vertex layout & bounds");
+    pl_test_expect_true(fError < 1e-5f, "vs shader port");
+    pl_test_expect_true(gptECS->get_skinned_mesh_data(&tLibrary, tLibrary.tMeshComponentManager.sbtEntities[0]) == NULL, "unskinned mesh");
+
+    // removing a skinned mesh moves dense indices
+    const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, atMeshes[4]);
+    gptECS->remove_entity(&tLibrary, ptMesh->tSkinComponent);
+    gptECS->remove_entity(&tLibrary, atMeshes[4]);
+    atMeshes[4] = atMeshes[11];
+    plTransformComponent* sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtTransforms); i++)
+        sbtTransforms[i].tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f, 1.0f));
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+    gptECS->run_cpu_skinning_system(&tLibrary);
+    fError = 0.0f;
+    for(uint32_t i = 0; i < 11; i++)
+        fError = pl_maxf(fError, ecs_test_check_skinned_mesh(&tLibrary, atMeshes[i], &uWrong));
+    pl_test_expect_uint32_equal(uWrong, 0, "vertex layout & bounds after removal");
+    pl_test_expect_true(fError < 1e-5f, "vs shader port after removal");
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+ik_two_bone_test(void* pData)
+{
+    const plEntity tNone = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX};
+    const plVec4 tIdentity = {.x = 0.0f, .y = 0.0f, .z = 0.0f, .w = 1.0f};
+    for(plIKSolver tSolver = PL_IK_SOLVER_CCD; tSolver <= PL_IK_SOLVER_FABRIK; tSolver++)
+    {
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tLibrary);
+        plEntity tRoot = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 0.0f, 0.0f), tIdentity, tNone);
+        plEntity tMiddle = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tRoot);
+        plEntity tEffector = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tMiddle);
+        plEntity tChild = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.5f, 0.0f, 0.0f), tIdentity, tEffector);
+        plEntity tTarget = ecs_test_add_joint(&tLibrary, pl_create_vec3(1.0f, 1.0f, 0.0f), tIdentity, tNone);
+        ecs_test_add_ik(&tLibrary, tEffector, tTarget, 2, 32, tSolver);
+
+        // reachable: effector within tolerance, bone lengths kept, root fixed
+        ecs_test_ik_frame(&tLibrary, true);
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), pl_create_vec3(1.0f, 1.0f, 0.0f)) <= 1.1e-3f, "reachable target");
+        pl_test_expect_float_near_equal(ecs_test_distance(ecs_test_world_position(&tLibrary, tMiddle), ecs_test_world_position(&tLibrary, tRoot)), 1.0f, 1e-4f, "bone length");
+        pl_test_expect_float_near_equal(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), ecs_test_world_position(&tLibrary, tMiddle)), 1.0f, 1e-4f, "bone length");
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tRoot), pl_create_vec3(0.0f, 0.0f, 0.0f)) < 1e-6f, "fixed root");
+
+        // descendants follow the effector, local transforms aren't touched
+        const plTransformComponent* ptEffector = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEffector);
+        const plTransformComponent* ptChild = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tChild);
+        const plMat4 tChildLocal = pl_mat4_translate_xyz(0.5f, 0.0f, 0.0f);
+        const plMat4 tExpected = pl_mul_mat4(&ptEffector->tWorld, &tChildLocal);
+        pl_test_expect_true(ecs_test_matrices_near(&tExpected, &ptChild->tWorld, 1e-5f), "descendant");
+        const plTransformComponent* ptMiddle = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMiddle);
+        pl_test_expect_true(ptMiddle->tTranslation.y == 1.0f && memcmp(&ptMiddle->tRotation, &tIdentity, sizeof(plVec4)) == 0, "local transform");
+
+        // without IK the original pose comes back
+        ecs_test_ik_frame(&tLibrary, false);
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), pl_create_vec3(0.0f, 2.0f, 0.0f)) < 1e-6f, "pose without IK");
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tChild), pl_create_vec3(0.5f, 2.0f, 0.0f)) < 1e-6f, "pose without IK");
+
+        // unreachable: the chain stretches straight toward the target
+        plTransformComponent* ptTarget = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tTarget);
+        ptTarget->tTranslation = pl_create_vec3(5.0f, 0.0f, 0.0f);
+        ecs_test_ik_frame(&tLibrary, true);
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), pl_create_vec3(2.0f, 0.0f, 0.0f)) < 2e-3f, "unreachable target");
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tMiddle), pl_create_vec3(1.0f, 0.0f, 0.0f)) < 2e-3f, "unreachable target");
+
+        // reattaching the root under a new joint & growing the chain refreshes the cached chain
+        plEntity tNewRoot = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, -1.0f, 0.0f), tIdentity, tNone);
+        plTransformComponent* ptRoot = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tRoot);
+        ptRoot->tTranslation = pl_create_vec3(0.0f, 1.0f, 0.0f);
+        gptECS->attach_component(&tLibrary, tRoot, tNewRoot);
+        plInverseKinematicsComponent* ptIK = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_INVERSE_KINEMATICS, tEffector);
+        ptIK->uChainLength = 3;
+        ptTarget = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tTarget);
+        ptTarget->tTranslation = pl_create_vec3(1.5f, 0.5f, 0.5f);
+        ecs_test_ik_frame(&tLibrary, true);
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector), pl_create_vec3(1.5f, 0.5f, 0.5f)) <= 1.1e-3f, "longer chain");
+        pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tNewRoot), pl_create_vec3(0.0f, -1.0f, 0.0f)) < 1e-5f, "new root fixed");
+        pl_test_expect_float_near_equal(ecs_test_distance(ecs_test_world_position(&tLibrary, tRoot), ecs_test_world_position(&tLibrary, tNewRoot)), 1.0f, 1e-4f, "bone length");
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+}
+
+void
+ik_n_bone_test(void* pData)
+{
+    // random bone lengths & rest poses, target inside the reach
+    const plEntity tNone = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX};
+    const uint32_t auBoneCounts[] = {6, 24};
+    guEcsTestSeed = 3;
+    for(uint32_t i = 0; i < 2; i++)
+    {
+        for(plIKSolver tSolver = PL_IK_SOLVER_CCD; tSolver <= PL_IK_SOLVER_FABRIK; tSolver++)
+        {
+            const uint32_t uBoneCount = auBoneCounts[i];
+            plComponentLibrary tLibrary = {0};
+            gptECS->init_component_library(&tLibrary);
+            plEntity atJoints[24] = {0};
+            float afLengths[24] = {0};
+            float fReach = 0.0f;
+            for(uint32_t j = 0; j < uBoneCount; j++)
+            {
+                afLengths[j] = 0.5f + ecs_test_rand();
+                const plVec4 tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() * 0.3f, 0.0f, ecs_test_rand() * 0.3f, 1.0f));
+                atJoints[j] = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, j > 0 ? afLengths[j] : 0.0f, 0.0f), tRotation, j > 0 ? atJoints[j - 1] : tNone);
+                if(j > 0)
+                    fReach += afLengths[j];
+            }
+            const plVec3 tGoal = pl_create_vec3(fReach * 0.4f, fReach * 0.3f, fReach * 0.2f);
+            plEntity tTarget = ecs_test_add_joint(&tLibrary, tGoal, pl_create_vec4(0.0f, 0.0f, 0.0f, 1.0f), tNone);
+            ecs_test_add_ik(&tLibrary, atJoints[uBoneCount - 1], tTarget, uBoneCount - 1, tSolver == PL_IK_SOLVER_CCD ? 512 : 64, tSolver);
+            ecs_test_ik_frame(&tLibrary, true);
+
+            pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, atJoints[uBoneCount - 1]), tGoal) <= 1.1e-3f, "converged");
+            uint32_t uStretched = 0;
+            for(uint32_t j = 1; j < uBoneCount; j++)
+            {
+                const float fLength = ecs_test_distance(ecs_test_world_position(&tLibrary, atJoints[j]), ecs_test_world_position(&tLibrary, atJoints[j - 1]));
+                uStretched += fabsf(fLength - afLengths[j]) >= 1e-3f;
+            }
+            pl_test_expect_uint32_equal(uStretched, 0, "bone lengths");
+            gptECS->cleanup_component_library(&tLibrary);
+        }
+    }
+}
+
+void
+ik_shared_joints_test(void* pData)
+{
+    // two effectors share the root & middle joints (solved in separate waves) &
+    // a third chain targets a joint moved by the second
+    const plEntity tNone = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX};
+    const plVec4 tIdentity = {.x = 0.0f, .y = 0.0f, .z = 0.0f, .w = 1.0f};
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    plEntity tRoot = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 0.0f, 0.0f), tIdentity, tNone);
+    plEntity tMiddle = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tRoot);
+    plEntity tEffector0 = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tMiddle);
+    plEntity tEffector1 = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.3f, 1.0f, 0.0f), tIdentity, tMiddle);
+    plEntity tTarget0 = ecs_test_add_joint(&tLibrary, pl_create_vec3(1.0f, 1.0f, 0.0f), tIdentity, tNone);
+    plEntity tTarget1 = ecs_test_add_joint(&tLibrary, pl_create_vec3(-1.0f, 1.0f, 0.0f), tIdentity, tNone);
+    plEntity tOtherRoot = ecs_test_add_joint(&tLibrary, pl_create_vec3(5.0f, 0.0f, 0.0f), tIdentity, tNone);
+    plEntity tOtherMiddle = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tOtherRoot);
+    plEntity tOtherEffector = ecs_test_add_joint(&tLibrary, pl_create_vec3(0.0f, 1.0f, 0.0f), tIdentity, tOtherMiddle);
+    ecs_test_add_ik(&tLibrary, tEffector0, tTarget0, 2, 32, PL_IK_SOLVER_FABRIK);
+    ecs_test_add_ik(&tLibrary, tEffector1, tTarget1, 1, 32, PL_IK_SOLVER_CCD);
+    ecs_test_add_ik(&tLibrary, tOtherEffector, tEffector1, 2, 32, PL_IK_SOLVER_CCD);
+    ecs_test_ik_frame(&tLibrary, true);
+
+    const plComponentLibraryData* ptData = tLibrary.pInternal;
+    pl_test_expect_uint32_equal(ptData->sbtIKChains[0].uWave, 0, "first wave");
+    pl_test_expect_uint32_equal(ptData->sbtIKChains[1].uWave, 1, "shares joints with the first chain");
+    pl_test_expect_uint32_equal(ptData->sbtIKChains[2].uWave, 2, "targets the second chain");
+
+    // the second chain (rotating only the middle joint) leaves the first effector attached
+    pl_test_expect_float_near_equal(ecs_test_distance(ecs_test_world_position(&tLibrary, tEffector0), ecs_test_world_position(&tLibrary, tMiddle)), 1.0f, 1e-4f, "bone length");
+    const plVec3 tMiddlePosition = ecs_test_world_position(&tLibrary, tMiddle);
+    const plVec3 tToTarget = pl_norm_vec3(pl_sub_vec3(ecs_test_world_position(&tLibrary, tTarget1), tMiddlePosition));
+    const plVec3 tToEffector = pl_norm_vec3(pl_sub_vec3(ecs_test_world_position(&tLibrary, tEffector1), tMiddlePosition));
+    pl_test_expect_true(pl_dot_vec3(tToTarget, tToEffector) > 0.9999f, "second chain aims at its target");
+
+    // the third chain chases the second effector's solved position (reach 2)
+    const plVec3 tDirection = pl_norm_vec3(pl_sub_vec3(ecs_test_world_position(&tLibrary, tEffector1), pl_create_vec3(5.0f, 0.0f, 0.0f)));
+    const plVec3 tExpected = pl_add_vec3(pl_create_vec3(5.0f, 0.0f, 0.0f), pl_mul_vec3_scalarf(tDirection, 2.0f));
+    pl_test_expect_true(ecs_test_distance(ecs_test_world_position(&tLibrary, tOtherEffector), tExpected) < 5e-3f, "third chain");
+
+    // removing a joint & a target invalidates chains
+    gptECS->remove_entity(&tLibrary, tMiddle);
+    gptECS->remove_entity(&tLibrary, tTarget1);
+    ecs_test_ik_frame(&tLibrary, true);
+    ecs_test_ik_frame(&tLibrary, true);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_animation_tests(void* pData)
+{
+    pl_test_register_test(animation_determinism_test, NULL);
+    pl_test_register_test(animation_sampling_test, NULL);
+    pl_test_register_test(animation_compression_test, NULL);
+    pl_test_register_test(blend_tree_test, NULL);
+    pl_test_register_test(skin_palette_test, NULL);
+    pl_test_register_test(cpu_skinning_test, NULL);
+    pl_test_register_test(ik_two_bone_test, NULL);
+    pl_test_register_test(ik_n_bone_test, NULL);
+    pl_test_register_test(ik_shared_joints_test, NULL);
+}
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+typedef struct _plEcsTestInput
+{
+    float    fMoveX;
+    float    fMoveZ;
+    uint32_t uSpawn;
+} plEcsTestInput;
+
+typedef struct _plEcsTestStepData
+{
+    uint32_t uCalls;
+    uint32_t uErrors;
+} plEcsTestStepData;
+
+// step callback: the input moves the first 16 objects & spawns objects; an
+// object is removed on a fixed cadence
+static void
+ecs_test_fixed_step(plComponentLibrary* ptLibrary, uint64_t uStep, const void* pInput, uint32_t uInputSize, void* pUserData)
+{
+    plEcsTestStepData* ptStepData = pUserData;
+    ptStepData->uCalls++;
+    plEcsTestInput tInput = {0};
+    if(pInput)
+    {
+        if(uInputSize != sizeof(plEcsTestInput))
+            ptStepData->uErrors++;
+        memcpy(&tInput, pInput, sizeof(plEcsTestInput));
+    }
+    const plFixedStepState* ptState = gptECS->get_fixed_step_state(ptLibrary);
+    if(ptState->uStep != uStep || ptState->pInput != pInput)
+        ptStepData->uErrors++;
+
+    const plObjectComponent* sbtObjects = ptLibrary->tObjectComponentManager.pComponents;
+    for(uint32_t i = 0; i < 16 && i < pl_sb_size(sbtObjects); i++)
+    {
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtObjects[i].tTransform);
+        ptTransform->tTranslation.x += tInput.fMoveX * ptState->tDesc.fStepSize;
+        ptTransform->tTranslation.z += tInput.fMoveZ * ptState->tDesc.fStepSize;
+        ptTransform->tRotation = pl_norm_vec4(pl_mul_quat(ptTransform->tRotation, pl_create_vec4(0.0f, 0.01f * tInput.fMoveX, 0.0f, 1.0f)));
+    }
+    if(tInput.uSpawn)
+    {
+        const plEntity tEntity = gptECS->create_object(ptLibrary, "spawned", NULL);
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        ptTransform->tTranslation = pl_create_vec3(tInput.fMoveX, 1.0f, tInput.fMoveZ);
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tEntity);
+        ptMesh->tAABB.tMin = pl_create_vec3(-1.0f, -1.0f, -1.0f);
+        ptMesh->tAABB.tMax = pl_create_vec3(1.0f, 1.0f, 1.0f);
+    }
+    const uint32_t uObjectCount = pl_sb_size(ptLibrary->tObjectComponentManager.sbtEntities);
+    if(uStep % 37 == 36 && uObjectCount > 100)
+        gptECS->remove_entity(ptLibrary, ptLibrary->tObjectComponentManager.sbtEntities[uObjectCount / 2]);
+}
+
+// objects, skins & two clips sharing a target
+static void
+ecs_test_build_fixed_step_scene(plComponentLibrary* ptLibrary)
+{
+    gptECS->init_component_library(ptLibrary);
+    guEcsTestSeed = 50;
+    ecs_test_build_scene(ptLibrary, 500, 4);
+    const plEntity tClip0 = ecs_test_add_mocap_clip(ptLibrary, 6, 30, -1);
+    const plEntity tClip1 = ecs_test_add_mocap_clip(ptLibrary, 6, 30, PL_ANIMATION_MODE_LINEAR);
+    plAnimationComponent* ptClip0 = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tClip0);
+    plAnimationComponent* ptClip1 = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tClip1);
+    ptClip1->sbtChannels[1].tTarget = ptClip0->sbtChannels[1].tTarget;
+    ptClip1->fBlendAmount = 0.5f;
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+fixed_step_replay_test(void* pData)
+{
+    const uint32_t uStepCount = 300;
+    plEcsInputStream* ptStream = gptECS->create_input_stream();
+    plEcsTestStepData tStepData = {0};
+
+    // live run: jittery frame times & live input, recorded
+    plComponentLibrary tRecorded = {0};
+    ecs_test_build_fixed_step_scene(&tRecorded);
+    pl_test_expect_true(gptECS->get_fixed_step_state(&tRecorded) == NULL, "disabled by default");
+    const plFixedStepDesc tRecordDesc = {.ptRecordStream = ptStream, .step = ecs_test_fixed_step, .pUserData = &tStepData};
+    gptECS->set_fixed_step(&tRecorded, &tRecordDesc);
+    const plFixedStepState* ptState = gptECS->get_fixed_step_state(&tRecorded);
+    pl_test_expect_true(ptState->tDesc.fStepSize == PL_ECS_FIXED_STEP_SIZE && ptState->tDesc.uMaxSubsteps == PL_ECS_MAX_SUBSTEPS, "defaults applied");
+
+    guEcsTestSeed = 4242;
+    uint32_t uStepsRun = 0;
+    uint32_t uStateErrors = 0;
+    while(ptState->uStep < uStepCount)
+    {
+        const plEcsTestInput tInput = {ecs_test_rand() * 2.0f - 1.0f, ecs_test_rand() * 2.0f - 1.0f, ecs_test_rand() < 0.05f};
+        const float fDeltaTime = 0.004f + ecs_test_rand() * 0.04f;
+        const uint32_t uStepsLeft = uStepCount - (uint32_t)ptState->uStep;
+        if(fDeltaTime >= (float)uStepsLeft * ptState->tDesc.fStepSize - (float)ptState->dAccumulator)
+        {
+            gptECS->run_fixed_steps(&tRecorded, uStepsLeft, &tInput, sizeof(tInput)); // finish exactly
+            uStepsRun += uStepsLeft;
+        }
+        else
+            uStepsRun += gptECS->advance_fixed_step(&tRecorded, fDeltaTime, &tInput, sizeof(tInput));
+        if(ptState->dAccumulator < 0.0 || ptState->dAccumulator >= ptState->tDesc.fStepSize || ptState->fAlpha < 0.0f || ptState->fAlpha >= 1.0f || ptState->pInput != NULL)
+            uStateErrors++;
+    }
+    pl_test_expect_uint32_equal(uStateErrors, 0, "accumulator state");
+    pl_test_expect_uint32_equal(uStepsRun, uStepCount, "steps run");
+    pl_test_expect_uint32_equal(tStepData.uCalls, uStepCount, "step callbacks");
+    pl_test_expect_uint32_equal((uint32_t)gptECS->get_stream_length(ptStream), uStepCount, "recorded inputs");
+    pl_test_expect_uint32_equal((uint32_t)ptState->uDroppedSteps, 0, "no dropped steps");
+
+    // stream round trip (corrupt data is rejected & keeps the content)
+    size_t szSize = 0;
+    gptECS->save_input_stream(ptStream, NULL, &szSize);
+    unsigned char* pucStream = malloc(szSize);
+    size_t szSmall = szSize - 1;
+    pl_test_expect_false(gptECS->save_input_stream(ptStream, pucStream, &szSmall), "stream buffer too small");
+    pl_test_expect_true(gptECS->save_input_stream(ptStream, pucStream, &szSize), "save stream");
+    plEcsInputStream* ptLoadedStream = gptECS->create_input_stream();
+    pl_test_expect_true(gptECS->load_input_stream(ptLoadedStream, pucStream, szSize), "load stream");
+    uint32_t uInputErrors = 0;
+    for(uint64_t i = 0; i < uStepCount; i++)
+    {
+        uint32_t uSize0 = 0;
+        uint32_t uSize1 = 0;
+        const void* pInput0 = gptECS->get_stream_input(ptStream, i, &uSize0);
+        const void* pInput1 = gptECS->get_stream_input(ptLoadedStream, i, &uSize1);
+        if(uSize0 != sizeof(plEcsTestInput) || uSize0 != uSize1 || memcmp(pInput0, pInput1, uSize0) != 0)
+            uInputErrors++;
+    }
+    pl_test_expect_uint32_equal(uInputErrors, 0, "loaded inputs");
+    uint32_t uPastEnd = 7;
+    pl_test_expect_true(gptECS->get_stream_input(ptLoadedStream, uStepCount, &uPastEnd) == NULL && uPastEnd == 0, "input past the end");
+    pl_test_expect_false(gptECS->load_input_stream(ptLoadedStream, pucStream, szSize - 1), "truncated stream");
+    pucStream[0] ^= 1;
+    pl_test_expect_false(gptECS->load_input_stream(ptLoadedStream, pucStream, szSize), "corrupt stream");
+    pl_test_expect_uint32_equal((uint32_t)gptECS->get_stream_length(ptLoadedStream), uStepCount, "failed loads keep content");
+    free(pucStream);
+    gptECS->cleanup_input_stream(&ptStream);
+    pl_test_expect_true(ptStream == NULL, NULL);
+
+    // replays are bit identical regardless of frame timing & thread count
+    for(uint32_t uRun = 0; uRun < 4 * PL_TEST_THREAD_COUNT_VARIANTS; uRun++)
+    {
+        const uint32_t uTiming = uRun % 4;
+        test_set_thread_count(gauTestThreadCounts[uRun / 4]);
+        tStepData.uCalls = 0;
+        plComponentLibrary tReplay = {0};
+        ecs_test_build_fixed_step_scene(&tReplay);
+        const plFixedStepDesc tReplayDesc = {.ptPlaybackStream = ptLoadedStream, .step = ecs_test_fixed_step, .pUserData = &tStepData};
+        gptECS->set_fixed_step(&tReplay, &tReplayDesc);
+        const plEcsTestInput tIgnored = {9.0f, 9.0f, 1}; // playback replaces live input
+        if(uTiming < 2)
+            gptECS->run_fixed_steps(&tReplay, uStepCount, &tIgnored, sizeof(tIgnored));
+        else
+        {
+            const plFixedStepState* ptReplayState = gptECS->get_fixed_step_state(&tReplay);
+            const float fDeltaTime = uTiming == 2 ? 1.0f / 30.0f : 1.0f / 144.0f;
+            while(uStepCount - ptReplayState->uStep >= 3)
+                gptECS->advance_fixed_step(&tReplay, fDeltaTime, &tIgnored, sizeof(tIgnored));
+            gptECS->run_fixed_steps(&tReplay, (uint32_t)(uStepCount - ptReplayState->uStep), NULL, 0);
+        }
+        pl_test_expect_uint32_equal(tStepData.uCalls, uStepCount, "replay step callbacks");
+        pl_test_expect_uint32_equal(ecs_test_compare_libraries(&tRecorded, &tReplay), 0, "replay mismatches");
+        gptECS->cleanup_component_library(&tReplay);
+    }
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+    pl_test_expect_uint32_equal(tStepData.uErrors, 0, "step callback state");
+
+    gptECS->cleanup_input_stream(&ptLoadedStream);
+    gptECS->cleanup_component_library(&tRecorded);
+}
+
+void
+fixed_step_accumulator_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scene(&tLibrary, 10, 0);
+    const plFixedStepDesc tDesc = {.fStepSize = 0.01f, .uMaxSubsteps = 4};
+    gptECS->set_fixed_step(&tLibrary, &tDesc);
+    const plFixedStepState* ptState = gptECS->get_fixed_step_state(&tLibrary);
+
+    pl_test_expect_uint32_equal(gptECS->advance_fixed_step(&tLibrary, 0.005f, NULL, 0), 0, "partial step");
+    pl_test_expect_true(fabsf(ptState->fAlpha - 0.5f) < 1e-4f, "alpha after partial step");
+    pl_test_expect_uint32_equal(gptECS->advance_fixed_step(&tLibrary, 0.006f, NULL, 0), 1, "accumulated step");
+    pl_test_expect_true(fabsf(ptState->fAlpha - 0.1f) < 1e-4f, "alpha after accumulated step");
+
+    // spiral of death guard
+    pl_test_expect_uint32_equal(gptECS->advance_fixed_step(&tLibrary, 1.0f, NULL, 0), 4, "substeps clamped");
+    pl_test_expect_uint32_equal((uint32_t)ptState->uDroppedSteps, 96, "dropped steps");
+    pl_test_expect_uint32_equal((uint32_t)ptState->uStep, 5, "step count");
+    pl_test_expect_true(ptState->dAccumulator < 0.01, "accumulator after clamp");
+    pl_test_expect_uint32_equal(gptECS->advance_fixed_step(&tLibrary, -1.0f, NULL, 0), 0, "negative delta");
+    gptECS->run_fixed_steps(&tLibrary, 3, NULL, 0);
+    pl_test_expect_uint32_equal((uint32_t)ptState->uStep, 8, "exact steps");
+
+    gptECS->set_fixed_step(&tLibrary, NULL);
+    pl_test_expect_true(gptECS->get_fixed_step_state(&tLibrary) == NULL, "disabled");
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+fixed_step_interpolation_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 1;
+    ecs_test_build_scene(&tLibrary, 64, 0);
+    plEcsTestStepData tStepData = {0};
+    const plEntity tStatic = tLibrary.tObjectComponentManager.sbtEntities[40];
+    const plEntity tMoving = tLibrary.tObjectComponentManager.sbtEntities[0];
+    plFixedStepDesc tDesc = {.fStepSize = 0.01f, .bInterpolate = true, .step = ecs_test_fixed_step, .pUserData = &tStepData};
+    gptECS->set_fixed_step(&tLibrary, &tDesc);
+    plRenderSnapshot* ptSnapshot = gptECS->create_render_snapshot();
+
+    // nothing captured before the first step
+    plEcsTestInput tInput = {3.0f, -2.0f, 0};
+    gptECS->advance_fixed_step(&tLibrary, 0.0101f, &tInput, sizeof(tInput));
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMoving);
+    pl_test_expect_true(memcmp(&gptECS->get_render_object(ptSnapshot, tMoving)->tWorld, &ptTransform->tWorld, sizeof(plMat4)) == 0, "first step not blended");
+    const plMat4 tPrevious = ptTransform->tWorld;
+    const plAABB tPreviousAABB = ((plMeshComponent*)gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tMoving))->tAABBFinal;
+
+    // one step with ~0.37 of a step left over
+    tInput.uSpawn = 1;
+    gptECS->advance_fixed_step(&tLibrary, 0.0136f, &tInput, sizeof(tInput));
+    const float fAlpha = gptECS->get_fixed_step_state(&tLibrary)->fAlpha;
+    pl_test_expect_true(fAlpha > 0.3f && fAlpha < 0.45f, "alpha");
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMoving);
+    const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tMoving);
+    const plRenderObject* ptObject = gptECS->get_render_object(ptSnapshot, tMoving);
+    const plVec3 tExpected = pl_add_vec3(tPrevious.col[3].xyz, pl_mul_vec3_scalarf(pl_sub_vec3(ptTransform->tWorld.col[3].xyz, tPrevious.col[3].xyz), fAlpha));
+    pl_test_expect_true(fabsf(ptObject->tWorld.col[3].x - tExpected.x) < 1e-4f && fabsf(ptObject->tWorld.col[3].z - tExpected.z) < 1e-4f &&
+        ptObject->tWorld.col[3].x != ptTransform->tWorld.col[3].x, "blended translation");
+    pl_test_expect_true(fabsf(pl_length_vec3(ptObject->tWorld.col[0].xyz) - pl_length_vec3(ptTransform->tWorld.col[0].xyz)) < 1e-3f, "blended rotation keeps scale");
+    pl_test_expect_true(ptObject->tAABB.tMin.x <= fminf(tPreviousAABB.tMin.x, ptMesh->tAABBFinal.tMin.x) &&
+        ptObject->tAABB.tMax.x >= fmaxf(tPreviousAABB.tMax.x, ptMesh->tAABBFinal.tMax.x), "aabb union");
+
+    // static objects & objects spawned during the last step are copied bit for bit
+    const plTransformComponent* ptStatic = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tStatic);
+    pl_test_expect_true(memcmp(&gptECS->get_render_object(ptSnapshot, tStatic)->tWorld, &ptStatic->tWorld, sizeof(plMat4)) == 0, "static object");
+    const plEntity tSpawned = tLibrary.tObjectComponentManager.sbtEntities[pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities) - 1];
+    const plTransformComponent* ptSpawned = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tSpawned);
+    pl_test_expect_true(memcmp(&gptECS->get_render_object(ptSnapshot, tSpawned)->tWorld, &ptSpawned->tWorld, sizeof(plMat4)) == 0, "spawned object");
+
+    // mirrored transforms aren't blended
+    const plEntity tMirrored = tLibrary.tObjectComponentManager.sbtEntities[1];
+    ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMirrored);
+    ptTransform->tScale = pl_create_vec3(-1.0f, 1.0f, 1.0f);
+    gptECS->advance_fixed_step(&tLibrary, 0.01f, &tInput, sizeof(tInput));
+    gptECS->advance_fixed_step(&tLibrary, 0.01f, &tInput, sizeof(tInput));
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMirrored);
+    pl_test_expect_true(memcmp(&gptECS->get_render_object(ptSnapshot, tMirrored)->tWorld, &ptTransform->tWorld, sizeof(plMat4)) == 0, "mirrored object");
+
+    // without interpolation objects are plain copies
+    tDesc.bInterpolate = false;
+    gptECS->set_fixed_step(&tLibrary, &tDesc);
+    gptECS->advance_fixed_step(&tLibrary, 0.025f, &tInput, sizeof(tInput));
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tMoving);
+    pl_test_expect_true(memcmp(&gptECS->get_render_object(ptSnapshot, tMoving)->tWorld, &ptTransform->tWorld, sizeof(plMat4)) == 0, "interpolation disabled");
+    pl_test_expect_uint32_equal(tStepData.uErrors, 0, "step callback state");
+
+    gptECS->cleanup_render_snapshot(&ptSnapshot);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_fixed_step_tests(void* pData)
+{
+    pl_test_register_test(fixed_step_replay_test, NULL);
+    pl_test_register_test(fixed_step_accumulator_test, NULL);
+    pl_test_register_test(fixed_step_interpolation_test, NULL);
+}
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+static void
+ecs_test_free_mesh(plMeshComponent* ptMesh)
+{
+    plEcsSnapshotField atFields[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    const uint32_t uFieldCount = pl__ecs_snapshot_fields(PL_COMPONENT_TYPE_MESH, ptMesh, atFields);
+    for(uint32_t i = 0; i < uFieldCount; i++)
+    {
+        pl_sb_free(*atFields[i].ppBuffer);
+    }
+}
+
+static void
+ecs_test_add_mesh_vertex(plMeshComponent* ptMesh, plVec3 tPosition, plVec2 tUV)
+{
+    pl_sb_push(ptMesh->sbtVertexPositions, tPosition);
+    pl_sb_push(ptMesh->sbtVertexTextureCoordinates[0], tUV);
+}
+
+static void
+ecs_test_add_mesh_triangle(plMeshComponent* ptMesh, uint32_t uIndex0, uint32_t uIndex1, uint32_t uIndex2)
+{
+    pl_sb_push(ptMesh->sbuIndices, uIndex0);
+    pl_sb_push(ptMesh->sbuIndices, uIndex1);
+    pl_sb_push(ptMesh->sbuIndices, uIndex2);
+}
+
+static bool
+ecs_test_vec3_near(plVec3 tA, plVec3 tB, float fError)
+{
+    return fabsf(tA.x - tB.x) < fError && fabsf(tA.y - tB.y) < fError && fabsf(tA.z - tB.z) < fError;
+}
+
+// unit cube faces (normal & tangent per face, uv u runs along the tangent)
+static const plVec3 gatEcsTestCubeNormals[6]  = {{.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = -1.0f, .y = 0.0f, .z = 0.0f}, {.x = 0.0f, .y = 1.0f, .z = 0.0f}, {.x = 0.0f, .y = -1.0f, .z = 0.0f}, {.x = 0.0f, .y = 0.0f, .z = 1.0f}, {.x = 0.0f, .y = 0.0f, .z = -1.0f}};
+static const plVec3 gatEcsTestCubeTangents[6] = {{.x = 0.0f, .y = 0.0f, .z = -1.0f}, {.x = 0.0f, .y = 0.0f, .z = 1.0f}, {.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = -1.0f, .y = 0.0f, .z = 0.0f}};
+
+static void
+ecs_test_build_cube_mesh(plMeshComponent* ptMesh, plVec3 tOffset)
+{
+    const float aafCorners[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const plVec3 tNormal = gatEcsTestCubeNormals[i];
+        const plVec3 tTangent = gatEcsTestCubeTangents[i];
+        const plVec3 tBitangent = pl_cross_vec3(tNormal, tTangent);
+        const uint32_t uStart = pl_sb_size(ptMesh->sbtVertexPositions);
+        for(uint32_t j = 0; j < 4; j++)
+        {
+            const plVec3 tPosition = pl_add_vec3(tOffset, pl_add_vec3(tNormal, pl_add_vec3(pl_mul_vec3_scalarf(tTangent, aafCorners[j][0]), pl_mul_vec3_scalarf(tBitangent, aafCorners[j][1]))));
+            ecs_test_add_mesh_vertex(ptMesh, tPosition, pl_create_vec2(aafCorners[j][0] * 0.5f + 0.5f, aafCorners[j][1] * 0.5f + 0.5f));
+        }
+        ecs_test_add_mesh_triangle(ptMesh, uStart, uStart + 1, uStart + 2);
+        ecs_test_add_mesh_triangle(ptMesh, uStart, uStart + 2, uStart + 3);
+    }
+}
+
+static void
+ecs_test_build_sphere_mesh(plMeshComponent* ptMesh, uint32_t uSegments, uint32_t uRings)
+{
+    for(uint32_t r = 0; r <= uRings; r++)
+    {
+        for(uint32_t s = 0; s <= uSegments; s++)
+        {
+            const float fTheta = PL_PI * (float)r / (float)uRings;
+            const float fPhi = 2.0f * PL_PI * (float)s / (float)uSegments;
+            const plVec3 tPosition = {.x = sinf(fTheta) * cosf(fPhi), .y = cosf(fTheta), .z = -sinf(fTheta) * sinf(fPhi)};
+            ecs_test_add_mesh_vertex(ptMesh, tPosition, pl_create_vec2((float)s / (float)uSegments, (float)r / (float)uRings));
+        }
+    }
+    for(uint32_t r = 0; r < uRings; r++)
+    {
+        for(uint32_t s = 0; s < uSegments; s++)
+        {
+            const uint32_t uA = r * (uSegments + 1) + s;
+            const uint32_t uB = uA + uSegments + 1;
+            ecs_test_add_mesh_triangle(ptMesh, uA, uB, uB + 1);
+            ecs_test_add_mesh_triangle(ptMesh, uA, uB + 1, uA + 1);
+        }
+    }
+}
+
+// wavy uDivisions^2 grid with analytic normals & jittered uvs mirrored around
+// x = 0.5 (the left half has flipped uv orientation); bWelded shares vertices
+// between triangles, otherwise every corner has its own
+static void
+ecs_test_build_grid_mesh(plMeshComponent* ptMesh, uint32_t uDivisions, bool bWelded)
+{
+    const uint32_t uRow = uDivisions + 1;
+    plVec3* sbtPositions = NULL;
+    plVec3* sbtNormals = NULL;
+    plVec2* sbtUVs = NULL;
+    for(uint32_t j = 0; j <= uDivisions; j++)
+    {
+        for(uint32_t i = 0; i <= uDivisions; i++)
+        {
+            const float fX = (float)i / (float)uDivisions;
+            const float fZ = (float)j / (float)uDivisions;
+            pl_sb_push(sbtPositions, pl_create_vec3(fX, 0.2f * sinf(6.0f * fX) * cosf(5.0f * fZ), fZ));
+            pl_sb_push(sbtNormals, pl_norm_vec3(pl_create_vec3(-1.2f * cosf(6.0f * fX) * cosf(5.0f * fZ), 1.0f, 1.0f * sinf(6.0f * fX) * sinf(5.0f * fZ))));
+            const float fJitter = (i == 0 || j == 0 || i == uDivisions || j == uDivisions) ? 0.0f : (ecs_test_rand() - 0.5f) * 0.3f / (float)uDivisions;
+            pl_sb_push(sbtUVs, pl_create_vec2(fabsf(fX - 0.5f) + (2 * i == uDivisions ? 0.0f : fJitter), fZ - fJitter));
+        }
+    }
+    for(uint32_t j = 0; j < uDivisions; j++)
+    {
+        for(uint32_t i = 0; i < uDivisions; i++)
+        {
+            const uint32_t uA = j * uRow + i;
+            const uint32_t auCorners[6] = {uA, uA + uRow, uA + uRow + 1, uA, uA + uRow + 1, uA + 1};
+            for(uint32_t k = 0; k < 6; k++)
+            {
+                const uint32_t uVertex = bWelded ? auCorners[k] : pl_sb_size(ptMesh->sbtVertexPositions);
+                if(!bWelded)
+                {
+                    ecs_test_add_mesh_vertex(ptMesh, sbtPositions[auCorners[k]], sbtUVs[auCorners[k]]);
+                    pl_sb_push(ptMesh->sbtVertexNormals, sbtNormals[auCorners[k]]);
+                }
+                pl_sb_push(ptMesh->sbuIndices, uVertex);
+            }
+        }
+    }
+    if(bWelded)
+    {
+        ptMesh->sbtVertexPositions = sbtPositions;
+        ptMesh->sbtVertexNormals = sbtNormals;
+        ptMesh->sbtVertexTextureCoordinates[0] = sbtUVs;
+    }
+    else
+    {
+        pl_sb_free(sbtPositions);
+        pl_sb_free(sbtNormals);
+        pl_sb_free(sbtUVs);
+    }
+}
+
+// straight from the mikktspace definition: the angle weighted sum of the projected
+// uv tangents of every triangle around the corner's vertex (vertices with equal
+// position, normal & uv are one vertex) with the same uv orientation; assumes
+// those triangles form a single fan
+static plVec4
+ecs_test_reference_mikk_tangent(const plMeshComponent* ptMesh, uint32_t uCorner)
+{
+    const plVec3* atPositions = ptMesh->sbtVertexPositions;
+    const plVec3* atNormals = ptMesh->sbtVertexNormals;
+    const plVec2* atUVs = ptMesh->sbtVertexTextureCoordinates[0];
+    const uint32_t* auIndices = ptMesh->sbuIndices;
+    const uint32_t uVertex = auIndices[uCorner];
+    const plVec3 tNormal = atNormals[uVertex];
+    const uint32_t* auOwn = &auIndices[(uCorner / 3) * 3];
+    const plVec2 tOwnT1 = pl_sub_vec2(atUVs[auOwn[1]], atUVs[auOwn[0]]);
+    const plVec2 tOwnT2 = pl_sub_vec2(atUVs[auOwn[2]], atUVs[auOwn[0]]);
+    const float fOrientation = tOwnT1.x * tOwnT2.y - tOwnT1.y * tOwnT2.x > 0.0f ? 1.0f : -1.0f;
+
+    plVec3 tSum = {0};
+    for(uint32_t i = 0; i < pl_sb_size(auIndices) / 3; i++)
+    {
+        const uint32_t* auTriangle = &auIndices[i * 3];
+        const plVec3 tD1 = pl_sub_vec3(atPositions[auTriangle[1]], atPositions[auTriangle[0]]);
+        const plVec3 tD2 = pl_sub_vec3(atPositions[auTriangle[2]], atPositions[auTriangle[0]]);
+        const plVec2 tT1 = pl_sub_vec2(atUVs[auTriangle[1]], atUVs[auTriangle[0]]);
+        const plVec2 tT2 = pl_sub_vec2(atUVs[auTriangle[2]], atUVs[auTriangle[0]]);
+        const float fArea = tT1.x * tT2.y - tT1.y * tT2.x;
+        const float fSign = fArea > 0.0f ? 1.0f : -1.0f;
+        if(fSign != fOrientation)
+            continue;
+
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            const uint32_t uOther = auTriangle[j];
+            if(memcmp(&atPositions[uOther], &atPositions[uVertex], sizeof(plVec3)) != 0 ||
+                memcmp(&atNormals[uOther], &atNormals[uVertex], sizeof(plVec3)) != 0 ||
+                memcmp(&atUVs[uOther], &atUVs[uVertex], sizeof(plVec2)) != 0)
+                continue;
+
+            const plVec3 tS = pl_mul_vec3_scalarf(pl_norm_vec3(pl_sub_vec3(pl_mul_vec3_scalarf(tD1, tT2.y), pl_mul_vec3_scalarf(tD2, tT1.y))), fSign);
+            const plVec3 tEdge0 = pl_sub_vec3(atPositions[auTriangle[(j + 2) % 3]], atPositions[uOther]);
+            const plVec3 tEdge1 = pl_sub_vec3(atPositions[auTriangle[(j + 1) % 3]], atPositions[uOther]);
+            const plVec3 tV0 = pl_norm_vec3(pl_sub_vec3(tEdge0, pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, tEdge0))));
+            const plVec3 tV1 = pl_norm_vec3(pl_sub_vec3(tEdge1, pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, tEdge1))));
+            const float fAngle = acosf(pl_clampf(-1.0f, pl_dot_vec3(tV0, tV1), 1.0f));
+            const plVec3 tProjected = pl_norm_vec3(pl_sub_vec3(tS, pl_mul_vec3_scalarf(tNormal, pl_dot_vec3(tNormal, tS))));
+            tSum = pl_add_vec3(tSum, pl_mul_vec3_scalarf(tProjected, fAngle));
+        }
+    }
+    const plVec3 tTangent = pl_norm_vec3(tSum);
+    return (plVec4){.x = tTangent.x, .y = tTangent.y, .z = tTangent.z, .w = fOrientation};
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+mikktspace_reference_test(void* pData)
+{
+    // flat & uv mirrored quads
+    for(uint32_t uMode = PL_TANGENT_MODE_FAST; uMode <= PL_TANGENT_MODE_MIKKTSPACE; uMode++)
+    {
+        for(uint32_t uMirror = 0; uMirror < 2; uMirror++)
+        {
+            plMeshComponent tMesh = {0};
+            const plVec3 atCorners[4] = {{.x = 0.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 1.0f, .z = 0.0f}, {.x = 0.0f, .y = 1.0f, .z = 0.0f}};
+            for(uint32_t i = 0; i < 4; i++)
+                ecs_test_add_mesh_vertex(&tMesh, atCorners[i], pl_create_vec2(uMirror ? 1.0f - atCorners[i].x : atCorners[i].x, atCorners[i].y));
+            ecs_test_add_mesh_triangle(&tMesh, 0, 1, 2);
+            ecs_test_add_mesh_triangle(&tMesh, 0, 2, 3);
+            gptECS->calculate_normals(&tMesh, 1);
+            gptECS->calculate_tangents_ex(&tMesh, 1, uMode);
+            uint32_t uWrong = pl_sb_size(tMesh.sbtVertexTangents) == 4 ? 0 : 1;
+            for(uint32_t i = 0; i < 4 && uWrong == 0; i++)
+            {
+                const plVec4 tTangent = tMesh.sbtVertexTangents[i];
+                if(!ecs_test_vec3_near(tMesh.sbtVertexNormals[i], pl_create_vec3(0.0f, 0.0f, 1.0f), 1e-6f) ||
+                    !ecs_test_vec3_near(tTangent.xyz, pl_create_vec3(uMirror ? -1.0f : 1.0f, 0.0f, 0.0f), 1e-6f) || tTangent.w != (uMirror ? -1.0f : 1.0f))
+                    uWrong++;
+            }
+            pl_test_expect_uint32_equal(uWrong, 0, "quad tangents");
+            ecs_test_free_mesh(&tMesh);
+        }
+    }
+
+    // cubes (several meshes per call) & a uv sphere against their analytic tangents
+    for(uint32_t uMode = PL_TANGENT_MODE_FAST; uMode <= PL_TANGENT_MODE_MIKKTSPACE; uMode++)
+    {
+        plMeshComponent atCubes[3] = {0};
+        for(uint32_t i = 0; i < 3; i++)
+            ecs_test_build_cube_mesh(&atCubes[i], pl_create_vec3((float)i * 3.0f, 0.0f, 0.0f));
+        gptECS->calculate_normals(atCubes, 3);
+        gptECS->calculate_tangents_ex(atCubes, 3, uMode);
+        uint32_t uWrong = 0;
+        for(uint32_t i = 0; i < 3; i++)
+        {
+            if(pl_sb_size(atCubes[i].sbtVertexTangents) != 24)
+            {
+                uWrong++;
+                continue;
+            }
+            for(uint32_t j = 0; j < 24; j++)
+            {
+                if(!ecs_test_vec3_near(atCubes[i].sbtVertexNormals[j], gatEcsTestCubeNormals[j / 4], 1e-6f) ||
+                    !ecs_test_vec3_near(atCubes[i].sbtVertexTangents[j].xyz, gatEcsTestCubeTangents[j / 4], 1e-5f) || atCubes[i].sbtVertexTangents[j].w != 1.0f)
+                    uWrong++;
+            }
+            ecs_test_free_mesh(&atCubes[i]);
+        }
+        pl_test_expect_uint32_equal(uWrong, 0, "cube tangents");
+
+        // away from the poles: normal is the position, tangent follows u (v runs down, so bitangents flip)
+        plMeshComponent tSphere = {0};
+        ecs_test_build_sphere_mesh(&tSphere, 64, 32);
+        gptECS->calculate_normals(&tSphere, 1);
+        gptECS->calculate_tangents_ex(&tSphere, 1, uMode);
+        float fWorstNormal = 1.0f;
+        float fWorstTangent = 1.0f;
+        uWrong = pl_sb_size(tSphere.sbtVertexTangents) == pl_sb_size(tSphere.sbtVertexPositions) ? 0 : 1;
+        for(uint32_t i = 0; i < pl_sb_size(tSphere.sbtVertexTangents); i++)
+        {
+            const plVec3 tPosition = tSphere.sbtVertexPositions[i];
+            const float fTheta = acosf(tPosition.y);
+            if(fTheta < 0.2f || fTheta > PL_PI - 0.2f)
+                continue;
+            const float fPhi = 2.0f * PL_PI * tSphere.sbtVertexTextureCoordinates[0][i].x;
+            fWorstNormal = pl_minf(fWorstNormal, pl_dot_vec3(tSphere.sbtVertexNormals[i], pl_norm_vec3(tPosition)));
+            fWorstTangent = pl_minf(fWorstTangent, pl_dot_vec3(tSphere.sbtVertexTangents[i].xyz, pl_create_vec3(-sinf(fPhi), 0.0f, -cosf(fPhi))));
+            if(tSphere.sbtVertexTangents[i].w != -1.0f)
+                uWrong++;
+        }
+        pl_test_expect_true(fWorstNormal > 0.998f && fWorstTangent > 0.998f, "sphere tangents");
+        pl_test_expect_uint32_equal(uWrong, 0, "sphere handedness");
+        ecs_test_free_mesh(&tSphere);
+    }
+
+    // every corner of a mirrored, uv jittered grid matches the reference
+    guEcsTestSeed = 45;
+    plMeshComponent tGrid = {0};
+    ecs_test_build_grid_mesh(&tGrid, 24, true);
+    plMeshComponent tSource = {0};
+    pl_sb_resize(tSource.sbtVertexPositions, pl_sb_size(tGrid.sbtVertexPositions));
+    pl_sb_resize(tSource.sbtVertexNormals, pl_sb_size(tGrid.sbtVertexNormals));
+    pl_sb_resize(tSource.sbtVertexTextureCoordinates[0], pl_sb_size(tGrid.sbtVertexPositions));
+    pl_sb_resize(tSource.sbuIndices, pl_sb_size(tGrid.sbuIndices));
+    memcpy(tSource.sbtVertexPositions, tGrid.sbtVertexPositions, sizeof(plVec3) * pl_sb_size(tGrid.sbtVertexPositions));
+    memcpy(tSource.sbtVertexNormals, tGrid.sbtVertexNormals, sizeof(plVec3) * pl_sb_size(tGrid.sbtVertexNormals));
+    memcpy(tSource.sbtVertexTextureCoordinates[0], tGrid.sbtVertexTextureCoordinates[0], sizeof(plVec2) * pl_sb_size(tGrid.sbtVertexPositions));
+    memcpy(tSource.sbuIndices, tGrid.sbuIndices, sizeof(uint32_t) * pl_sb_size(tGrid.sbuIndices));
+    gptECS->calculate_tangents_ex(&tGrid, 1, PL_TANGENT_MODE_MIKKTSPACE);
+    uint32_t uWrong = 0;
+    float fWorst = 1.0f;
+    for(uint32_t i = 0; i < pl_sb_size(tSource.sbuIndices); i++)
+    {
+        const plVec4 tExpected = ecs_test_reference_mikk_tangent(&tSource, i);
+        const plVec4 tTangent = tGrid.sbtVertexTangents[tGrid.sbuIndices[i]];
+        fWorst = pl_minf(fWorst, pl_dot_vec3(tExpected.xyz, tTangent.xyz));
+        if(tExpected.w != tTangent.w || memcmp(&tGrid.sbtVertexPositions[tGrid.sbuIndices[i]], &tSource.sbtVertexPositions[tSource.sbuIndices[i]], sizeof(plVec3)) != 0)
+            uWrong++;
+    }
+    pl_test_expect_true(fWorst > 0.99999f, "grid tangents vs reference");
+    pl_test_expect_uint32_equal(uWrong, 0, "grid handedness & split positions");
+    pl_test_expect_uint32_equal(pl_sb_size(tGrid.sbtVertexPositions), 25 * 25 + 25, "mirror seam split");
+
+    // duplicated (unwelded) corners give bit identical tangents
+    plMeshComponent tUnwelded = {0};
+    guEcsTestSeed = 45;
+    ecs_test_build_grid_mesh(&tUnwelded, 24, false);
+    gptECS->calculate_tangents_ex(&tUnwelded, 1, PL_TANGENT_MODE_MIKKTSPACE);
+    uWrong = pl_sb_size(tUnwelded.sbuIndices) == pl_sb_size(tGrid.sbuIndices) ? 0 : 1;
+    for(uint32_t i = 0; i < pl_sb_size(tGrid.sbuIndices) && uWrong == 0; i++)
+    {
+        if(memcmp(&tGrid.sbtVertexTangents[tGrid.sbuIndices[i]], &tUnwelded.sbtVertexTangents[tUnwelded.sbuIndices[i]], sizeof(plVec4)) != 0)
+            uWrong++;
+    }
+    pl_test_expect_uint32_equal(uWrong, 0, "welded vs unwelded");
+    ecs_test_free_mesh(&tGrid);
+    ecs_test_free_mesh(&tSource);
+    ecs_test_free_mesh(&tUnwelded);
+
+    // degenerate & zero uv area triangles stay finite & don't disturb their neighbors
+    for(uint32_t uMode = PL_TANGENT_MODE_FAST; uMode <= PL_TANGENT_MODE_MIKKTSPACE; uMode++)
+    {
+        plMeshComponent tMesh = {0};
+        const plVec3 atCorners[4] = {{.x = 0.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 0.0f, .z = 0.0f}, {.x = 1.0f, .y = 1.0f, .z = 0.0f}, {.x = 0.0f, .y = 1.0f, .z = 0.0f}};
+        for(uint32_t i = 0; i < 4; i++)
+            ecs_test_add_mesh_vertex(&tMesh, atCorners[i], pl_create_vec2(atCorners[i].x, atCorners[i].y));
+        ecs_test_add_mesh_triangle(&tMesh, 0, 1, 2);
+        ecs_test_add_mesh_triangle(&tMesh, 0, 2, 3);
+        ecs_test_add_mesh_triangle(&tMesh, 0, 1, 1);
+        ecs_test_add_mesh_vertex(&tMesh, pl_create_vec3(2.0f, 0.0f, 0.0f), pl_create_vec2(1.0f, 0.0f));
+        ecs_test_add_mesh_triangle(&tMesh, 1, 4, 2);
+        ecs_test_add_mesh_vertex(&tMesh, pl_create_vec3(0.5f, 0.5f, 0.0f), pl_create_vec2(0.5f, 0.5f));
+        ecs_test_add_mesh_triangle(&tMesh, 5, 5, 5);
+        gptECS->calculate_normals(&tMesh, 1);
+        gptECS->calculate_tangents_ex(&tMesh, 1, uMode);
+        uWrong = 0;
+        for(uint32_t i = 0; i < pl_sb_size(tMesh.sbtVertexTangents); i++)
+        {
+            const plVec4 tTangent = tMesh.sbtVertexTangents[i];
+            if(!isfinite(tTangent.x) || !isfinite(tTangent.y) || !isfinite(tTangent.z) || !isfinite(tTangent.w))
+                uWrong++;
+        }
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            if(!ecs_test_vec3_near(tMesh.sbtVertexTangents[i].xyz, pl_create_vec3(1.0f, 0.0f, 0.0f), 1e-5f) || tMesh.sbtVertexTangents[i].w != 1.0f)
+                uWrong++;
+        }
+        pl_test_expect_uint32_equal(uWrong, 0, "degenerate triangles");
+        ecs_test_free_mesh(&tMesh);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_mesh_tests(void* pData)
+{
+    pl_test_register_test(mikktspace_reference_test, NULL);
+}
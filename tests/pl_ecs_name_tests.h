@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+// plain recursive glob ('*' any run, '?' any one byte)
+static bool
+ecs_test_glob_match(const char* pcPattern, const char* pcName)
+{
+    if(*pcPattern == '*')
+        return ecs_test_glob_match(pcPattern + 1, pcName) || (*pcName && ecs_test_glob_match(pcPattern, pcName + 1));
+    if(*pcName == 0)
+        return *pcPattern == 0;
+    return (*pcPattern == '?' || *pcPattern == *pcName) && ecs_test_glob_match(pcPattern + 1, pcName + 1);
+}
+
+typedef struct _plEcsTestName
+{
+    const char* pcName;
+    uint32_t    uEntity;
+} plEcsTestName;
+
+static int
+ecs_test_name_compare(const void* pA, const void* pB)
+{
+    const plEcsTestName* ptA = pA;
+    const plEcsTestName* ptB = pB;
+    const int iResult = strcmp(ptA->pcName, ptB->pcName);
+    if(iResult != 0)
+        return iResult;
+    return ptA->uEntity < ptB->uEntity ? -1 : (ptA->uEntity > ptB->uEntity ? 1 : 0);
+}
+
+// scan over every tag, sorted like the name index
+static uint32_t
+ecs_test_find_names(plComponentLibrary* ptLibrary, const char* pcPattern, bool bGlob, plEntity* atEntitiesOut)
+{
+    const plComponentManager* ptManager = &ptLibrary->tTagComponentManager;
+    const plTagComponent* sbtTags = ptManager->pComponents;
+    const uint32_t uTagCount = pl_sb_size(ptManager->sbtEntities);
+    plEcsTestName* atNames = malloc(sizeof(plEcsTestName) * (uTagCount + 1));
+    uint32_t uCount = 0;
+    for(uint32_t i = 0; i < uTagCount; i++)
+    {
+        const char* pcName = sbtTags[i].acName;
+        if(pcName[0] == 0)
+            continue;
+        if(bGlob ? ecs_test_glob_match(pcPattern, pcName) : strncmp(pcName, pcPattern, strlen(pcPattern)) == 0)
+            atNames[uCount++] = (plEcsTestName){pcName, ptManager->sbtEntities[i].uIndex};
+    }
+    qsort(atNames, uCount, sizeof(plEcsTestName), ecs_test_name_compare);
+    for(uint32_t i = 0; i < uCount; i++)
+        atEntitiesOut[i] = (plEntity){.uIndex = atNames[i].uEntity, .uGeneration = ptLibrary->sbtEntityGenerations[atNames[i].uEntity]};
+    free(atNames);
+    return uCount;
+}
+
+// returns the number of patterns whose results differ from the scan
+static uint32_t
+ecs_test_name_mismatches(plComponentLibrary* ptLibrary, const char** apcPatterns, uint32_t uPatternCount, bool bGlob)
+{
+    const uint32_t uMax = pl_sb_size(ptLibrary->tTagComponentManager.sbtEntities) + 1;
+    plEntity* atFound = malloc(sizeof(plEntity) * uMax);
+    plEntity* atExpected = malloc(sizeof(plEntity) * uMax);
+    uint32_t uMismatches = 0;
+    for(uint32_t i = 0; i < uPatternCount; i++)
+    {
+        const uint32_t uFound = bGlob ? gptECS->find_entities_by_glob(ptLibrary, apcPatterns[i], atFound, uMax) :
+            gptECS->find_entities_by_prefix(ptLibrary, apcPatterns[i], atFound, uMax);
+        const uint32_t uExpected = ecs_test_find_names(ptLibrary, apcPatterns[i], bGlob, atExpected);
+        if(uFound != uExpected || memcmp(atFound, atExpected, sizeof(plEntity) * uFound) != 0)
+            uMismatches++;
+    }
+    free(atFound);
+    free(atExpected);
+    return uMismatches;
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+name_index_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    const char* apcNames[] = {"hand", "arm", "armor", "arm", "b", "ab", "a", "\xc3\xa9t\xc3\xa9", "zeta", "arm_left", "arm_right"};
+    plEntity atEntities[11];
+    for(uint32_t i = 0; i < 11; i++)
+        atEntities[i] = gptECS->create_tag(&tLibrary, apcNames[i]);
+
+    // sorted by name (unsigned bytes), equal names by entity index
+    plEntity atFound[16];
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLibrary, "arm", atFound, 16), 5, "prefix count");
+    pl_test_expect_true(atFound[0].ulData == atEntities[1].ulData && atFound[1].ulData == atEntities[3].ulData &&
+        atFound[2].ulData == atEntities[9].ulData && atFound[3].ulData == atEntities[10].ulData && atFound[4].ulData == atEntities[2].ulData, "prefix order");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLibrary, "arm", atFound, 2), 5, "truncated prefix");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLibrary, "arm", NULL, 0), 5, "prefix count only");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLibrary, "", atFound, 16), 11, "empty prefix");
+    pl_test_expect_true(atFound[10].ulData == atEntities[7].ulData, "utf-8 sorts last");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLibrary, "armors", NULL, 0), 0, "longer than any name");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "arm", NULL, 0), 2, "exact glob");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "*r*", NULL, 0), 5, "glob stars");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "a?", atFound, 16), 1, "glob any");
+    pl_test_expect_true(atFound[0].ulData == atEntities[5].ulData, "glob any entity");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "arm_*t", NULL, 0), 2, "glob suffix");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "?", NULL, 0), 2, "glob single");
+
+    // removing the entity or the tag drops the name, a reused slot gets the new generation
+    gptECS->remove_entity(&tLibrary, atEntities[1]);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "arm", atFound, 16), 1, "removed entity");
+    gptECS->remove_component(&tLibrary, PL_COMPONENT_TYPE_TAG, atEntities[3]);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "arm", NULL, 0), 0, "removed tag");
+    const plEntity tReused = gptECS->create_tag(&tLibrary, "arm");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "arm", atFound, 16), 1, "reused slot");
+    pl_test_expect_true(atFound[0].ulData == tReused.ulData && gptECS->get_entity(&tLibrary, "arm").ulData == tReused.ulData, "reused slot generation");
+    gptECS->create_tag(&tLibrary, NULL);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "unnamed", NULL, 0), 1, "unnamed tag");
+
+    // command buffer playback keeps the index current
+    plEcsCommandBuffer* ptBuffer = gptECS->create_command_buffer(&tLibrary);
+    const plEntity tDeferred = gptECS->cmd_create_entity(ptBuffer);
+    plTagComponent* ptTag = gptECS->cmd_add_component(ptBuffer, PL_COMPONENT_TYPE_TAG, tDeferred);
+    strcpy(ptTag->acName, "deferred");
+    ptTag = gptECS->cmd_add_component(ptBuffer, PL_COMPONENT_TYPE_TAG, atEntities[0]);
+    strcpy(ptTag->acName, "renamed hand");
+    gptECS->cmd_remove_entity(ptBuffer, atEntities[4]);
+    gptECS->playback_command_buffers(&tLibrary, 1, &ptBuffer);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "deferred", atFound, 16), 1, "deferred tag");
+    pl_test_expect_true(atFound[0].ulData == gptECS->resolve_entity(ptBuffer, tDeferred).ulData, "deferred entity");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "hand", NULL, 0), 0, "old name");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "renamed hand", NULL, 0), 1, "new name");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_glob(&tLibrary, "b", NULL, 0), 0, "deferred removal");
+    gptECS->cleanup_command_buffer(&ptBuffer);
+
+    // loaded snapshots index the same names
+    size_t szSize = 0;
+    gptECS->save_snapshot(&tLibrary, NULL, &szSize);
+    void* pSnapshot = malloc(szSize);
+    gptECS->save_snapshot(&tLibrary, pSnapshot, &szSize);
+    plComponentLibrary tLoaded = {0};
+    gptECS->init_component_library(&tLoaded);
+    gptECS->load_snapshot(&tLoaded, pSnapshot, szSize);
+    plEntity atLoaded[16];
+    const uint32_t uCount = gptECS->find_entities_by_prefix(&tLibrary, "", atFound, 16);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_prefix(&tLoaded, "", atLoaded, 16), uCount, "snapshot names");
+    pl_test_expect_true(memcmp(atFound, atLoaded, sizeof(plEntity) * uCount) == 0, "snapshot name entities");
+    free(pSnapshot);
+    gptECS->cleanup_component_library(&tLoaded);
+    gptECS->cleanup_component_library(&tLibrary);
+
+    // paths (3 roots, each with an arm & 2 hands)
+    gptECS->init_component_library(&tLibrary);
+    plEntity atHands[6];
+    plEntity atArms[3];
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        char acName[32] = {0};
+        snprintf(acName, 32, "root_%u", i);
+        const plEntity tRoot = gptECS->create_transform(&tLibrary, acName, NULL);
+        atArms[i] = gptECS->create_transform(&tLibrary, "arm", NULL);
+        gptECS->attach_component(&tLibrary, atArms[i], tRoot);
+        for(uint32_t j = 0; j < 2; j++)
+        {
+            atHands[i * 2 + j] = gptECS->create_transform(&tLibrary, j ? "hand" : "hand_l", NULL);
+            gptECS->attach_component(&tLibrary, atHands[i * 2 + j], atArms[i]);
+        }
+    }
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_1/arm/hand", atFound, 16), 1, "path");
+    pl_test_expect_true(atFound[0].ulData == atHands[3].ulData, "path entity");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "/root_1/arm/hand/", NULL, 0), 1, "path slashes");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_*/arm/hand", NULL, 0), 3, "path glob root");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_2/arm/hand*", NULL, 0), 2, "path glob leaf");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_2/*/*", NULL, 0), 2, "path glob segments");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "arm/hand", NULL, 0), 0, "path must start at a root");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_1/hand", NULL, 0), 0, "path skipping a level");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "root_1", NULL, 0), 1, "root path");
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "", NULL, 0), 0, "empty path");
+    gptECS->deattach_component(&tLibrary, atArms[0]);
+    pl_test_expect_uint32_equal(gptECS->find_entities_by_path(&tLibrary, "arm/hand", NULL, 0), 1, "detached arm is a root");
+    gptECS->cleanup_component_library(&tLibrary);
+
+    // random churn against a scan (small alphabet for deep shared prefixes & duplicates)
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 46;
+    const char acAlphabet[] = "ab/c\xe9";
+    const char* apcPrefixes[] = {"", "a", "ab", "ab/", "\xe9", "cc", "b/a", "aaaaaa", "aaaaaaa", "c\xe9/"};
+    const char* apcGlobs[] = {"*", "a*", "*a", "a?b*", "*/*", "??", "ab/c", "\xe9*\xe9", "*c*c*", "b??a"};
+    plEntity* sbtLive = NULL;
+    uint32_t uMismatches = 0;
+    uint32_t uWrongCounts = 0;
+    for(uint32_t uRound = 0; uRound < 6; uRound++)
+    {
+        for(uint32_t i = 0; i < 5000; i++)
+        {
+            if(pl_sb_size(sbtLive) > 0 && ecs_test_rand() < 0.33f)
+            {
+                const uint32_t uVictim = (uint32_t)(ecs_test_rand() * (float)pl_sb_size(sbtLive));
+                if(ecs_test_rand() < 0.5f)
+                    gptECS->remove_entity(&tLibrary, sbtLive[uVictim]);
+                else
+                    gptECS->remove_component(&tLibrary, PL_COMPONENT_TYPE_TAG, sbtLive[uVictim]);
+                pl_sb_del_swap(sbtLive, uVictim);
+            }
+            else
+            {
+                char acName[8] = {0};
+                const uint32_t uLength = 1 + (uint32_t)(ecs_test_rand() * 6.0f);
+                for(uint32_t j = 0; j < uLength; j++)
+                    acName[j] = acAlphabet[(uint32_t)(ecs_test_rand() * 5.0f)];
+                pl_sb_push(sbtLive, gptECS->create_tag(&tLibrary, acName));
+            }
+        }
+        uMismatches += ecs_test_name_mismatches(&tLibrary, apcPrefixes, 10, false);
+        uMismatches += ecs_test_name_mismatches(&tLibrary, apcGlobs, 10, true);
+        const plComponentLibraryData* ptData = tLibrary.pInternal;
+        if(ptData->uNameCount != pl_sb_size(sbtLive))
+            uWrongCounts++;
+
+        // mostly empty index (names arena compaction)
+        if(uRound == 3)
+        {
+            while(pl_sb_size(sbtLive) > 100)
+                gptECS->remove_entity(&tLibrary, pl_sb_pop(sbtLive));
+        }
+    }
+    pl_test_expect_uint32_equal(uMismatches, 0, "lookups vs scan");
+    pl_test_expect_uint32_equal(uWrongCounts, 0, "indexed name count");
+    pl_sb_free(sbtLive);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_name_tests(void* pData)
+{
+    pl_test_register_test(name_index_test, NULL);
+}
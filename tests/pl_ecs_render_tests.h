@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+// every extracted value encodes the frame that wrote it (objects: translation
+// (frame, i, 0), material {frame, i}; joints: translation (frame, joint, 0)),
+// extras are created & removed every frame so component arrays reallocate
+typedef struct _plEcsTestPipeline
+{
+    plComponentLibrary* ptLibrary;
+    plEntity*           sbtObjects;
+    plEntity*           sbtExtras;
+    plEntity            tSkin;
+    plEntity            atJoints[4];
+} plEcsTestPipeline;
+
+static void
+ecs_test_build_pipeline(plEcsTestPipeline* ptPipeline, uint32_t uObjectCount)
+{
+    plComponentLibrary* ptLibrary = ptPipeline->ptLibrary;
+    for(uint32_t i = 0; i < uObjectCount; i++)
+    {
+        const plEntity tObject = gptECS->create_object(ptLibrary, "object", NULL);
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tObject);
+        ptMesh->tAABB = (plAABB){.tMin = {.x = -1.0f, .y = -1.0f, .z = -1.0f}, .tMax = {.x = 1.0f, .y = 1.0f, .z = 1.0f}};
+        pl_sb_push(ptPipeline->sbtObjects, tObject);
+    }
+
+    plSkinComponent* ptSkin = NULL;
+    ptPipeline->tSkin = gptECS->create_skin(ptLibrary, "skin", &ptSkin);
+    ptSkin->tMeshNode = gptECS->create_transform(ptLibrary, "skin node", NULL);
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        ptPipeline->atJoints[i] = gptECS->create_transform(ptLibrary, "joint", NULL);
+        ptSkin = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_SKIN, ptPipeline->tSkin);
+        pl_sb_push(ptSkin->sbtJoints, ptPipeline->atJoints[i]);
+        pl_sb_push(ptSkin->sbtInverseBindMatrices, pl_identity_mat4());
+        pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+        pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+    }
+}
+
+static void
+ecs_test_pipeline_frame(plEcsTestPipeline* ptPipeline, uint32_t uFrame)
+{
+    plComponentLibrary* ptLibrary = ptPipeline->ptLibrary;
+    for(uint32_t i = 0; i < pl_sb_size(ptPipeline->sbtObjects); i++)
+    {
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptPipeline->sbtObjects[i]);
+        ptTransform->tTranslation = pl_create_vec3((float)uFrame, (float)i, 0.0f);
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, ptPipeline->sbtObjects[i]);
+        ptMesh->tMaterial = (plEntity){.uIndex = uFrame, .uGeneration = i};
+    }
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptPipeline->atJoints[i]);
+        ptTransform->tTranslation = pl_create_vec3((float)uFrame, (float)i, 0.0f);
+    }
+
+    if(pl_sb_size(ptPipeline->sbtExtras) >= 32)
+    {
+        for(uint32_t i = 0; i < 16; i++)
+            gptECS->remove_entity(ptLibrary, ptPipeline->sbtExtras[i]);
+        pl_sb_del_n(ptPipeline->sbtExtras, 0, 16);
+    }
+    for(uint32_t i = 0; i < 24; i++)
+        pl_sb_push(ptPipeline->sbtExtras, gptECS->create_object(ptLibrary, "extra", NULL));
+
+    gptECS->run_transform_update_system(ptLibrary);
+    gptECS->run_hierarchy_update_system(ptLibrary);
+    gptECS->run_skin_update_system(ptLibrary);
+    gptECS->run_object_update_system(ptLibrary);
+}
+
+// values in objects [uStart, uEnd) (& the skin palette when uStart is 0) that
+// don't belong to uFrame
+static uint32_t
+ecs_test_pipeline_errors(const plEcsTestPipeline* ptPipeline, const plRenderSnapshot* ptSnapshot, uint32_t uFrame, uint32_t uStart, uint32_t uEnd)
+{
+    uint32_t uErrors = 0;
+    for(uint32_t i = uStart; i < uEnd; i++)
+    {
+        const plRenderObject* ptObject = gptECS->get_render_object(ptSnapshot, ptPipeline->sbtObjects[i]);
+        if(ptObject == NULL)
+        {
+            uErrors++;
+            continue;
+        }
+        if(ptObject->tWorld.col[3].x != (float)uFrame || ptObject->tWorld.col[3].y != (float)i ||
+            ptObject->tAABB.tMin.x != (float)uFrame - 1.0f || ptObject->tAABB.tMax.x != (float)uFrame + 1.0f ||
+            ptObject->tMaterial.uIndex != uFrame || ptObject->tMaterial.uGeneration != i)
+            uErrors++;
+    }
+    if(uStart == 0)
+    {
+        uint32_t uMatrixCount = 0;
+        const plMat4* atPalette = gptECS->get_render_skin_palette(ptSnapshot, ptPipeline->tSkin, &uMatrixCount);
+        if(atPalette == NULL || uMatrixCount != 8)
+            return uErrors + 1;
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            if(atPalette[i * 2].col[3].x != (float)uFrame || atPalette[i * 2].col[3].y != (float)i)
+                uErrors++;
+        }
+    }
+    return uErrors;
+}
+
+static bool
+ecs_test_float_near(float fA, float fB, float fEpsilon)
+{
+    return fabsf(fA - fB) <= fEpsilon * (1.0f + fabsf(fA) + fabsf(fB));
+}
+
+static bool
+ecs_test_vec3_close(plVec3 tA, plVec3 tB, float fEpsilon)
+{
+    return ecs_test_float_near(tA.x, tB.x, fEpsilon) && ecs_test_float_near(tA.y, tB.y, fEpsilon) && ecs_test_float_near(tA.z, tB.z, fEpsilon);
+}
+
+// checks a camera's derived block against computing each value directly from the camera
+static uint32_t
+ecs_test_camera_derived_errors(plCameraComponent* ptCamera)
+{
+    uint32_t uErrors = 0;
+    const plCameraDerivedData* ptDerived = gptCamera->get_derived_data(ptCamera);
+    if(ptDerived != &ptCamera->tDerived || ptDerived->uVersion != ptCamera->uVersion)
+        uErrors++;
+    if(ptCamera->tType == PL_CAMERA_TYPE_PERSPECTIVE)
+    {
+        const float fTanHalfFov = tanf(0.5f * ptCamera->fFieldOfView);
+        if(ptDerived->fTanHalfFovY != fTanHalfFov || !ecs_test_float_near(ptDerived->fTanHalfFovX, fTanHalfFov * ptCamera->fAspectRatio, 1e-6f))
+            uErrors++;
+    }
+
+    // matrices are bit exact
+    const plMat4 tViewProjection = pl_mul_mat4(&ptCamera->tProjMat, &ptCamera->tViewMat);
+    const plMat4 tInverse = pl_mat4_invert(&tViewProjection);
+    if(memcmp(&tViewProjection, &ptDerived->tViewProjMat, sizeof(plMat4)) != 0 || memcmp(&tInverse, &ptDerived->tInvViewProjMat, sizeof(plMat4)) != 0)
+        uErrors++;
+
+    // corners by inverse projecting the clip space cube
+    static const plVec3 atClipCorners[8] = {
+        {.x = -1.0f, .y =  1.0f, .z = 0.0f}, {.x = -1.0f, .y = -1.0f, .z = 0.0f}, {.x = 1.0f, .y = -1.0f, .z = 0.0f}, {.x = 1.0f, .y = 1.0f, .z = 0.0f},
+        {.x = -1.0f, .y =  1.0f, .z = 1.0f}, {.x = -1.0f, .y = -1.0f, .z = 1.0f}, {.x = 1.0f, .y = -1.0f, .z = 1.0f}, {.x = 1.0f, .y = 1.0f, .z = 1.0f}
+    };
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        const plVec4 tCorner = pl_mul_mat4_vec4(&tInverse, (plVec4){.xyz = atClipCorners[i], .w = 1.0f});
+        if(!ecs_test_vec3_close(pl_div_vec3_scalarf(tCorner.xyz, tCorner.w), ptDerived->atCorners[i], 1e-5f))
+            uErrors++;
+    }
+
+    // cascade slices lerp between the near & far corners
+    plVec3 atSlice[8] = {0};
+    gptCamera->get_frustum_slice(ptCamera, 0.1f, 0.37f, atSlice);
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const plVec3 tDistance = pl_sub_vec3(ptDerived->atCorners[i + 4], ptDerived->atCorners[i]);
+        if(!ecs_test_vec3_close(atSlice[i], pl_add_vec3(ptDerived->atCorners[i], pl_mul_vec3_scalarf(tDistance, 0.1f)), 1e-6f) ||
+            !ecs_test_vec3_close(atSlice[i + 4], pl_add_vec3(ptDerived->atCorners[i], pl_mul_vec3_scalarf(tDistance, 0.37f)), 1e-6f))
+            uErrors++;
+    }
+
+    // planes have unit normals, keep the corners inside & classify points like clip space does
+    for(uint32_t uPlane = 0; uPlane < 6; uPlane++)
+    {
+        if(!ecs_test_float_near(pl_length_vec3(ptDerived->atPlanes[uPlane].xyz), 1.0f, 1e-5f))
+            uErrors++;
+        for(uint32_t i = 0; i < 8; i++)
+        {
+            if(pl_dot_vec3(ptDerived->atPlanes[uPlane].xyz, ptDerived->atCorners[i]) + ptDerived->atPlanes[uPlane].w < -1e-3f * (1.0f + ptCamera->fFarZ))
+                uErrors++;
+        }
+    }
+    uint32_t uClassified = 0;
+    for(uint32_t i = 0; i < 5000; i++)
+    {
+        const plVec3 tPoint = {
+            .x = ptCamera->tPos.x + (ecs_test_rand() * 2.0f - 1.0f) * ptCamera->fFarZ,
+            .y = ptCamera->tPos.y + (ecs_test_rand() * 2.0f - 1.0f) * ptCamera->fFarZ,
+            .z = ptCamera->tPos.z + (ecs_test_rand() * 2.0f - 1.0f) * ptCamera->fFarZ
+        };
+        const plVec4 tClip = pl_mul_mat4_vec4(&tViewProjection, (plVec4){.xyz = tPoint, .w = 1.0f});
+        const float fMargin = fminf(fminf(tClip.w - fabsf(tClip.x), tClip.w - fabsf(tClip.y)), fminf(tClip.z, tClip.w - tClip.z));
+        if(fabsf(fMargin) < 1e-3f * fabsf(tClip.w) + 1e-4f)
+            continue; // too close to a plane to classify
+        bool bInside = true;
+        for(uint32_t uPlane = 0; uPlane < 6; uPlane++)
+        {
+            if(pl_dot_vec3(ptDerived->atPlanes[uPlane].xyz, tPoint) + ptDerived->atPlanes[uPlane].w < 0.0f)
+                bInside = false;
+        }
+        if(bInside != (fMargin > 0.0f))
+            uErrors++;
+        uClassified++;
+    }
+    if(uClassified < 1000)
+        uErrors++;
+    return uErrors;
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+render_extraction_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 47;
+    ecs_test_build_scene(&tLibrary, 1000, 8);
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+
+    plRenderSnapshot* ptSnapshot = gptECS->create_render_snapshot();
+    pl_test_expect_true(ptSnapshot->uFrame == 0 && gptECS->get_render_object(ptSnapshot, (plEntity){0}) == NULL, "empty snapshot");
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    pl_test_expect_true(ptSnapshot->uFrame == 1 && ptSnapshot->uObjectCount == 1008 && ptSnapshot->uSkinCount == 8, "extracted counts");
+
+    // copies match the library
+    const plEntity* sbtObjectEntities = tLibrary.tObjectComponentManager.sbtEntities;
+    const plObjectComponent* sbtObjects = tLibrary.tObjectComponentManager.pComponents;
+    uint32_t uWrong = 0;
+    for(uint32_t i = 0; i < ptSnapshot->uObjectCount; i++)
+    {
+        const plRenderObject* ptObject = gptECS->get_render_object(ptSnapshot, sbtObjectEntities[i]);
+        const plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtObjects[i].tTransform);
+        const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh);
+        if(ptObject != &ptSnapshot->sbtObjects[i] ||
+            memcmp(&ptObject->tWorld, &ptTransform->tWorld, sizeof(plMat4)) != 0 ||
+            memcmp(&ptObject->tAABB, &ptMesh->tAABBFinal, sizeof(plAABB)) != 0 ||
+            ptObject->tMesh.ulData != sbtObjects[i].tMesh.ulData || ptObject->tMaterial.ulData != ptMesh->tMaterial.ulData ||
+            ptObject->tSkin.ulData != ptMesh->tSkinComponent.ulData)
+            uWrong++;
+    }
+    const plSkinComponent* sbtSkins = tLibrary.tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t uMatrixCount = 0;
+        const plMat4* atPalette = gptECS->get_render_skin_palette(ptSnapshot, tLibrary.tSkinComponentManager.sbtEntities[i], &uMatrixCount);
+        if(atPalette == NULL || uMatrixCount != 16 || memcmp(atPalette, sbtSkins[i].sbtTextureData, sizeof(plMat4) * 16) != 0)
+            uWrong++;
+    }
+    pl_test_expect_uint32_equal(uWrong, 0, "extracted values");
+
+    // non objects, stale generations & removed entities aren't found; old snapshots keep them
+    uint32_t uMatrixCount = 7;
+    pl_test_expect_true(gptECS->get_render_skin_palette(ptSnapshot, sbtObjectEntities[0], &uMatrixCount) == NULL && uMatrixCount == 0, "palette of non skin");
+    pl_test_expect_true(gptECS->get_render_object(ptSnapshot, tLibrary.tSkinComponentManager.sbtEntities[0]) == NULL, "object of non object");
+    const plEntity tRemoved = sbtObjectEntities[5];
+    gptECS->remove_entity(&tLibrary, tRemoved);
+    gptECS->run_object_update_system(&tLibrary);
+    pl_test_expect_true(gptECS->get_render_object(ptSnapshot, tRemoved) != NULL, "old snapshot untouched");
+    gptECS->extract_render_snapshot(&tLibrary, ptSnapshot);
+    pl_test_expect_true(ptSnapshot->uFrame == 2 && ptSnapshot->uObjectCount == 1007 && gptECS->get_render_object(ptSnapshot, tRemoved) == NULL, "removed object");
+    const plEntity tStale = {.uIndex = tRemoved.uIndex, .uGeneration = tRemoved.uGeneration + 1};
+    const plEntity tOutOfRange = {.uIndex = 1u << 30};
+    pl_test_expect_true(gptECS->get_render_object(ptSnapshot, tStale) == NULL && gptECS->get_render_object(ptSnapshot, tOutOfRange) == NULL, "stale & out of range");
+
+    // frames count per library
+    plComponentLibrary tEmpty = {0};
+    gptECS->init_component_library(&tEmpty);
+    gptECS->extract_render_snapshot(&tEmpty, ptSnapshot);
+    pl_test_expect_true(ptSnapshot->uObjectCount == 0 && ptSnapshot->uSkinCount == 0 && ptSnapshot->uFrame == 1, "empty library");
+    gptECS->cleanup_render_snapshot(&ptSnapshot);
+    pl_test_expect_true(ptSnapshot == NULL, "cleanup");
+    gptECS->cleanup_component_library(&tEmpty);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+render_pipeline_test(void* pData)
+{
+    // frame N+1 is simulated (& extracted into the other snapshot) halfway through reading
+    // snapshot N, the way a render thread overlaps the simulation; arrays reallocate every frame
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    plEcsTestPipeline tPipeline = {.ptLibrary = &tLibrary};
+    ecs_test_build_pipeline(&tPipeline, 4096);
+    plRenderSnapshot* atSnapshots[2] = {gptECS->create_render_snapshot(), gptECS->create_render_snapshot()};
+    uint32_t auObjectCounts[2] = {0};
+    const uint32_t uHalf = pl_sb_size(tPipeline.sbtObjects) / 2;
+
+    uint32_t uErrors = 0;
+    const uint32_t uFrameCount = 60;
+    for(uint32_t uFrame = 1; uFrame <= uFrameCount; uFrame++)
+    {
+        const plRenderSnapshot* ptReading = atSnapshots[(uFrame - 1) % 2];
+        if(uFrame > 1)
+            uErrors += ecs_test_pipeline_errors(&tPipeline, ptReading, uFrame - 1, 0, uHalf);
+
+        ecs_test_pipeline_frame(&tPipeline, uFrame);
+        gptECS->extract_render_snapshot(&tLibrary, atSnapshots[uFrame % 2]);
+        auObjectCounts[uFrame % 2] = pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities);
+
+        if(uFrame > 1)
+        {
+            uErrors += ecs_test_pipeline_errors(&tPipeline, ptReading, uFrame - 1, uHalf, pl_sb_size(tPipeline.sbtObjects));
+            if(ptReading->uFrame != uFrame - 1 || ptReading->uObjectCount != auObjectCounts[(uFrame - 1) % 2])
+                uErrors++;
+        }
+    }
+    pl_test_expect_uint32_equal(uErrors, 0, "snapshot read while simulating");
+
+    // snapshots outlive the library
+    gptECS->cleanup_component_library(&tLibrary);
+    const plRenderSnapshot* ptLast = atSnapshots[uFrameCount % 2];
+    pl_test_expect_uint32_equal(ecs_test_pipeline_errors(&tPipeline, ptLast, uFrameCount, 0, pl_sb_size(tPipeline.sbtObjects)), 0, "snapshot after library cleanup");
+
+    pl_sb_free(tPipeline.sbtObjects);
+    pl_sb_free(tPipeline.sbtExtras);
+    gptECS->cleanup_render_snapshot(&atSnapshots[0]);
+    gptECS->cleanup_render_snapshot(&atSnapshots[1]);
+}
+
+void
+camera_derived_data_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 48;
+
+    plCameraComponent* ptCamera = NULL;
+    const plEntity tCamera = gptECS->create_perspective_camera(&tLibrary, "camera", pl_create_vec3(1.0f, 2.0f, -5.0f), PL_PI_3, 16.0f / 9.0f, 0.1f, 200.0f, &ptCamera);
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(ptCamera), 0, "perspective derived data");
+    gptCamera->rotate(ptCamera, 0.3f, 1.1f);
+    gptCamera->update(ptCamera);
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(ptCamera), 0, "rotated derived data");
+
+    plCameraComponent* ptOrtho = NULL;
+    gptECS->create_orthographic_camera(&tLibrary, "ortho", pl_create_vec3(0.0f, 5.0f, 0.0f), 20.0f, 10.0f, 0.0f, 50.0f, &ptOrtho);
+    gptCamera->set_pitch_yaw(ptOrtho, -0.7f, 0.4f);
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(ptOrtho), 0, "orthographic derived data");
+    ptCamera = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_CAMERA, tCamera); // storage may have moved
+
+    // unchanged cameras keep their version
+    uint32_t uVersion = ptCamera->uVersion;
+    gptCamera->update(ptCamera);
+    pl_test_expect_uint32_equal(ptCamera->uVersion, uVersion, "update without changes");
+    gptCamera->set_pos(ptCamera, 3.0f, 2.0f, 1.0f);
+    pl_test_expect_true(ptCamera->uVersion != uVersion, "set_pos bumps version");
+
+    // derived block is only rebuilt once per version
+    gptCamera->get_derived_data(ptCamera);
+    ptCamera->tDerived.fTanHalfFovY = -1.0f;
+    pl_test_expect_true(gptCamera->get_derived_data(ptCamera)->fTanHalfFovY == -1.0f, "derived data cached");
+    gptCamera->set_fov(ptCamera, 1.0f);
+    pl_test_expect_true(gptCamera->get_derived_data(ptCamera)->fTanHalfFovY == tanf(0.5f), "set_fov rebuilds");
+
+    // direct writes to inputs are picked up
+    uVersion = ptCamera->uVersion;
+    ptCamera->fFarZ = 500.0f;
+    gptCamera->update(ptCamera);
+    pl_test_expect_true(ptCamera->uVersion != uVersion, "direct write bumps version");
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(ptCamera), 0, "derived data after direct write");
+
+    // every setter invalidates
+    uVersion = ptCamera->uVersion;
+    gptCamera->set_clip_planes(ptCamera, 0.2f, 100.0f);
+    pl_test_expect_uint32_equal(ptCamera->uVersion, ++uVersion, "set_clip_planes");
+    gptCamera->set_aspect(ptCamera, 1.5f);
+    pl_test_expect_uint32_equal(ptCamera->uVersion, ++uVersion, "set_aspect");
+    gptCamera->translate(ptCamera, 1.0f, 0.0f, 0.0f);
+    pl_test_expect_uint32_equal(ptCamera->uVersion, ++uVersion, "translate");
+    gptCamera->look_at(ptCamera, pl_create_vec3(0.0f, 0.0f, 0.0f), pl_create_vec3(1.0f, 1.0f, 1.0f));
+    pl_test_expect_uint32_equal(ptCamera->uVersion, ++uVersion, "look_at");
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(ptCamera), 0, "derived data after setters");
+
+    // zero initialized cameras (renderer's temporary shadow cameras) still build
+    plCameraComponent tZero = {.tType = PL_CAMERA_TYPE_ORTHOGRAPHIC, .fWidth = 2.0f, .fHeight = 2.0f, .fFarZ = 1.0f};
+    gptCamera->update(&tZero);
+    pl_test_expect_true(tZero.uVersion == 1 && tZero.tProjMat.col[0].x == 1.0f, "zero initialized camera");
+    pl_test_expect_uint32_equal(ecs_test_camera_derived_errors(&tZero), 0, "zero initialized derived data");
+
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_render_tests(void* pData)
+{
+    pl_test_register_test(render_extraction_test, NULL);
+    pl_test_register_test(render_pipeline_test, NULL);
+    pl_test_register_test(camera_derived_data_test, NULL);
+}
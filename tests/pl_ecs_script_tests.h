@@ -0,0 +1,497 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+// every manager's hashmap points at the right dense index & only holds live entities
+static bool
+ecs_test_managers_consistent(plComponentLibrary* ptLibrary)
+{
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        for(uint32_t j = 0; j < pl_sb_size(ptManager->sbtEntities); j++)
+        {
+            if(!gptECS->is_entity_valid(ptLibrary, ptManager->sbtEntities[j]) ||
+                pl_hm_lookup(ptManager->ptHashmap, ptManager->sbtEntities[j].uIndex) != j)
+                return false;
+        }
+    }
+    return true;
+}
+
+// FNV-1a over every manager's entities & component bytes plus the entity slots
+static uint64_t
+ecs_test_library_hash(plComponentLibrary* ptLibrary)
+{
+    uint64_t uHash = 1469598103934665603ull;
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        const plComponentManager* ptManager = ptLibrary->_ptManagers[i];
+        const uint32_t uCount = pl_sb_size(ptManager->sbtEntities);
+        const unsigned char* pucEntities = (const unsigned char*)ptManager->sbtEntities;
+        const unsigned char* pucComponents = ptManager->pComponents;
+        for(size_t j = 0; j < uCount * sizeof(plEntity); j++)
+            uHash = (uHash ^ pucEntities[j]) * 1099511628211ull;
+        for(size_t j = 0; j < uCount * ptManager->szStride; j++)
+            uHash = (uHash ^ pucComponents[j]) * 1099511628211ull;
+    }
+    const unsigned char* pucGenerations = (const unsigned char*)ptLibrary->sbtEntityGenerations;
+    for(size_t j = 0; j < pl_sb_size(ptLibrary->sbtEntityGenerations) * sizeof(uint32_t); j++)
+        uHash = (uHash ^ pucGenerations[j]) * 1099511628211ull;
+    const unsigned char* pucFreeIndices = (const unsigned char*)ptLibrary->sbtEntityFreeIndices;
+    for(size_t j = 0; j < pl_sb_size(ptLibrary->sbtEntityFreeIndices) * sizeof(uint32_t); j++)
+        uHash = (uHash ^ pucFreeIndices[j]) * 1099511628211ull;
+    return uHash;
+}
+
+// synthetic scripts: movers write their own transform, followers read the
+// transform they follow & write their own light, accumulators all write one
+// shared camera & spawners create entities through their command buffer
+static plEntity* gsbtEcsTestFollowed = NULL; // follower entity index -> followed mover
+static plEntity  gtEcsTestCounter = {0};
+static uint32_t  guEcsTestExclusiveRuns = 0;
+static uint32_t  guEcsTestExclusiveSeen = 0;
+
+static void
+ecs_test_mover_job(plComponentLibrary* ptLibrary, plEntity tEntity, plEcsCommandBuffer* ptBuffer)
+{
+    plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+    ptTransform->tTranslation.x += 1.0f;
+    ptTransform->tTranslation.y = ptTransform->tTranslation.y * 1.5f + 0.25f;
+}
+
+static void
+ecs_test_follower_job(plComponentLibrary* ptLibrary, plEntity tEntity, plEcsCommandBuffer* ptBuffer)
+{
+    const plTransformComponent* ptFollowed = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, gsbtEcsTestFollowed[tEntity.uIndex]);
+    plLightComponent* ptLight = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_LIGHT, tEntity);
+    ptLight->tPosition = pl_add_vec3(ptLight->tPosition, ptFollowed->tTranslation);
+}
+
+// order dependent on purpose
+static void
+ecs_test_accumulator_job(plComponentLibrary* ptLibrary, plEntity tEntity, plEcsCommandBuffer* ptBuffer)
+{
+    plCameraComponent* ptCamera = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_CAMERA, gtEcsTestCounter);
+    ptCamera->fNearZ = ptCamera->fNearZ * 1.25f + (float)(tEntity.uIndex % 7);
+    if(ptCamera->fNearZ > 1e6f)
+        ptCamera->fNearZ -= 1e6f;
+}
+
+static void
+ecs_test_spawner_job(plComponentLibrary* ptLibrary, plEntity tEntity, plEcsCommandBuffer* ptBuffer)
+{
+    plEntity tNewEntity = gptECS->cmd_create_entity(ptBuffer);
+    plTransformComponent* ptTransform = gptECS->cmd_add_component(ptBuffer, PL_COMPONENT_TYPE_TRANSFORM, tNewEntity);
+    ptTransform->tTranslation = pl_create_vec3((float)tEntity.uIndex, 0.0f, 0.0f);
+}
+
+// no "run_job" so it runs alone with full access
+static void
+ecs_test_exclusive_run(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    guEcsTestExclusiveRuns++;
+    guEcsTestExclusiveSeen = pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities);
+}
+
+#define ECS_TEST_SERIAL_SCRIPT(job) \
+    static void job##_serial(plComponentLibrary* ptLibrary, plEntity tEntity) \
+    { \
+        plEcsCommandBuffer* ptBuffer = gptECS->create_command_buffer(ptLibrary); \
+        job##_job(ptLibrary, tEntity, ptBuffer); \
+        gptECS->playback_command_buffers(ptLibrary, 1, &ptBuffer); \
+        gptECS->cleanup_command_buffer(&ptBuffer); \
+    }
+ECS_TEST_SERIAL_SCRIPT(ecs_test_mover)
+ECS_TEST_SERIAL_SCRIPT(ecs_test_follower)
+ECS_TEST_SERIAL_SCRIPT(ecs_test_accumulator)
+ECS_TEST_SERIAL_SCRIPT(ecs_test_spawner)
+
+static const char* ecs_test_script_name(void) { return "synthetic"; }
+
+static const plScriptI gtEcsTestMover       = {.run = ecs_test_mover_serial,       .run_job = ecs_test_mover_job,       .name = ecs_test_script_name};
+static const plScriptI gtEcsTestFollower    = {.run = ecs_test_follower_serial,    .run_job = ecs_test_follower_job,    .name = ecs_test_script_name};
+static const plScriptI gtEcsTestAccumulator = {.run = ecs_test_accumulator_serial, .run_job = ecs_test_accumulator_job, .name = ecs_test_script_name};
+static const plScriptI gtEcsTestSpawner     = {.run = ecs_test_spawner_serial,     .run_job = ecs_test_spawner_job,     .name = ecs_test_script_name};
+static const plScriptI gtEcsTestExclusive   = {.run = ecs_test_exclusive_run,      .name = ecs_test_script_name};
+
+// serial only versions of the same scripts
+static const plScriptI gtEcsTestMoverSerial       = {.run = ecs_test_mover_serial,       .name = ecs_test_script_name};
+static const plScriptI gtEcsTestFollowerSerial    = {.run = ecs_test_follower_serial,    .name = ecs_test_script_name};
+static const plScriptI gtEcsTestAccumulatorSerial = {.run = ecs_test_accumulator_serial, .name = ecs_test_script_name};
+
+static void
+ecs_test_add_script(plComponentLibrary* ptLibrary, plEntity tEntity, const plScriptI* ptApi, uint64_t uReads, uint64_t uWrites, uint64_t uEntityWrites)
+{
+    plScriptComponent* ptScript = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_SCRIPT, tEntity);
+    ptScript->tFlags = PL_SCRIPT_FLAG_PLAYING;
+    ptScript->_ptApi = ptApi;
+    ptScript->uReads = uReads;
+    ptScript->uWrites = uWrites;
+    ptScript->uEntityWrites = uEntityWrites;
+}
+
+// uCount movers & followers, an accumulator every 50 & a spawner every 100
+static void
+ecs_test_build_scripts(plComponentLibrary* ptLibrary, uint32_t uCount, bool bSerial, bool bSpawners)
+{
+    const uint64_t uTransformBit = 1ull << PL_COMPONENT_TYPE_TRANSFORM;
+    pl_sb_resize(gsbtEcsTestFollowed, 65536);
+    plCameraComponent* ptCamera = NULL;
+    gtEcsTestCounter = gptECS->create_perspective_camera(ptLibrary, "counter", pl_create_vec3(0.0f, 0.0f, 0.0f), 1.0f, 1.0f, 1.0f, 100.0f, &ptCamera);
+    ptCamera->fNearZ = 1.0f;
+
+    plEntity* sbtMovers = NULL;
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plTransformComponent* ptTransform = NULL;
+        plEntity tMover = gptECS->create_transform(ptLibrary, NULL, &ptTransform);
+        ptTransform->tTranslation = pl_create_vec3((float)i, (float)(i % 5), 0.0f);
+        pl_sb_push(sbtMovers, tMover);
+        ecs_test_add_script(ptLibrary, tMover, bSerial ? &gtEcsTestMoverSerial : &gtEcsTestMover, 0, 0, uTransformBit);
+    }
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        plEntity tFollower = gptECS->create_point_light(ptLibrary, NULL, pl_create_vec3(0.0f, 0.0f, 0.0f), NULL);
+        gsbtEcsTestFollowed[tFollower.uIndex] = sbtMovers[(i * 7) % uCount];
+        ecs_test_add_script(ptLibrary, tFollower, bSerial ? &gtEcsTestFollowerSerial : &gtEcsTestFollower, uTransformBit, 0, 1ull << PL_COMPONENT_TYPE_LIGHT);
+        if(i % 50 == 0)
+            ecs_test_add_script(ptLibrary, gptECS->create_entity(ptLibrary), bSerial ? &gtEcsTestAccumulatorSerial : &gtEcsTestAccumulator, 0, 1ull << PL_COMPONENT_TYPE_CAMERA, 0);
+        if(bSpawners && i % 100 == 0)
+            ecs_test_add_script(ptLibrary, gptECS->create_entity(ptLibrary), &gtEcsTestSpawner, 0, 0, 0);
+    }
+    pl_sb_free(sbtMovers);
+}
+
+static double
+ecs_test_script_checksum(plComponentLibrary* ptLibrary)
+{
+    double dSum = 0.0;
+    const plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtTransforms); i++)
+        dSum += sbtTransforms[i].tTranslation.x * 1.0001 + sbtTransforms[i].tTranslation.y * (i % 13);
+    const plLightComponent* sbtLights = ptLibrary->tLightComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtLights); i++)
+        dSum += sbtLights[i].tPosition.x * (i % 11) + sbtLights[i].tPosition.y;
+    const plCameraComponent* ptCamera = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_CAMERA, gtEcsTestCounter);
+    return dSum + ptCamera->fNearZ * 3.0;
+}
+
+typedef struct _plEcsTestRecordJob
+{
+    plEcsCommandBuffer** atBuffers;
+    const plEntity*      atEntities;
+    uint32_t             uEntityCount;
+    uint32_t             uJobCount;
+} plEcsTestRecordJob;
+
+static void
+ecs_test_record_job(uint32_t uJobIndex, void* pData)
+{
+    plEcsTestRecordJob* ptJob = pData;
+    plEcsCommandBuffer* ptBuffer = ptJob->atBuffers[uJobIndex];
+    for(uint32_t i = uJobIndex; i < ptJob->uEntityCount; i += ptJob->uJobCount)
+    {
+        if(i % 3 == 0)
+            gptECS->cmd_remove_entity(ptBuffer, ptJob->atEntities[i]);
+        else if(i % 3 == 1)
+            gptECS->cmd_remove_component(ptBuffer, PL_COMPONENT_TYPE_MESH, ptJob->atEntities[i]);
+        if(i % 5 == 0)
+        {
+            plEntity tEntity = gptECS->cmd_create_entity(ptBuffer);
+            plTagComponent* ptTag = gptECS->cmd_add_component(ptBuffer, PL_COMPONENT_TYPE_TAG, tEntity);
+            snprintf(ptTag->acName, PL_MAX_NAME_LENGTH, "new object %u", i);
+            plTransformComponent* ptTransform = gptECS->cmd_add_component(ptBuffer, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+            ptTransform->tTranslation.y = (float)i;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+command_buffer_semantics_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_objects(&tLibrary, 10);
+    const plEntity* atEntities = tLibrary.tObjectComponentManager.sbtEntities;
+    const plEntity tEntity0 = atEntities[0];
+    const plEntity tEntity1 = atEntities[1];
+    const plEntity tEntity2 = atEntities[2];
+    const plEntity tEntity3 = atEntities[3];
+    const uint32_t uLightCount = pl_sb_size(tLibrary.tLightComponentManager.sbtEntities);
+
+    plEcsCommandBuffer* ptBuffer0 = gptECS->create_command_buffer(&tLibrary);
+    plEcsCommandBuffer* ptBuffer1 = gptECS->create_command_buffer(&tLibrary);
+
+    // add after destroy (same buffer) is dropped
+    gptECS->cmd_remove_entity(ptBuffer0, tEntity0);
+    gptECS->cmd_add_component(ptBuffer0, PL_COMPONENT_TYPE_LIGHT, tEntity0);
+
+    // remove then add of the same type leaves the new value
+    gptECS->cmd_remove_component(ptBuffer0, PL_COMPONENT_TYPE_TRANSFORM, tEntity1);
+    plTransformComponent* ptTransform = gptECS->cmd_add_component(ptBuffer0, PL_COMPONENT_TYPE_TRANSFORM, tEntity1);
+    ptTransform->tTranslation = pl_create_vec3(7.0f, 7.0f, 7.0f);
+
+    // a later buffer targeting an entity destroyed by an earlier one is dropped
+    gptECS->cmd_remove_entity(ptBuffer0, tEntity2);
+    gptECS->cmd_add_component(ptBuffer1, PL_COMPONENT_TYPE_LIGHT, tEntity2);
+
+    // placeholders
+    plEntity tPlaceholder0 = gptECS->cmd_create_entity(ptBuffer1);
+    gptECS->cmd_add_component(ptBuffer1, PL_COMPONENT_TYPE_LIGHT, tPlaceholder0);
+    gptECS->cmd_remove_entity(ptBuffer1, tPlaceholder0);
+    plEntity tPlaceholder1 = gptECS->cmd_create_entity(ptBuffer1);
+    plLightComponent* ptLight = gptECS->cmd_add_component(ptBuffer1, PL_COMPONENT_TYPE_LIGHT, tPlaceholder1);
+    ptLight->fIntensity = 3.0f;
+
+    plEcsCommandBuffer* atBuffers[] = {ptBuffer0, ptBuffer1};
+    gptECS->playback_command_buffers(&tLibrary, 2, atBuffers);
+    pl_test_expect_true(ecs_test_managers_consistent(&tLibrary), "managers after playback");
+
+    pl_test_expect_false(gptECS->is_entity_valid(&tLibrary, tEntity0), NULL);
+    pl_test_expect_false(gptECS->is_entity_valid(&tLibrary, tEntity2), NULL);
+    const plTransformComponent* ptNewTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity1);
+    pl_test_expect_true(ptNewTransform && ptNewTransform->tTranslation.x == 7.0f, "re-added component");
+    pl_test_expect_false(gptECS->is_entity_valid(&tLibrary, gptECS->resolve_entity(ptBuffer1, tPlaceholder0)), "destroyed placeholder");
+    const plEntity tCreated = gptECS->resolve_entity(ptBuffer1, tPlaceholder1);
+    const plLightComponent* ptNewLight = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_LIGHT, tCreated);
+    pl_test_expect_true(ptNewLight && ptNewLight->fIntensity == 3.0f, "placeholder component");
+    pl_test_expect_uint32_equal(pl_sb_size(tLibrary.tLightComponentManager.sbtEntities), uLightCount + 1, "light count");
+
+    // slots freed by the playback aren't reused within it
+    pl_test_expect_true(tCreated.uIndex != tEntity0.uIndex && tCreated.uIndex != tEntity2.uIndex, "slot reuse");
+
+    // immediate removal
+    gptECS->remove_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tEntity3);
+    pl_test_expect_true(ecs_test_managers_consistent(&tLibrary), "managers after remove_component");
+    pl_test_expect_true(gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tEntity3) == NULL, NULL);
+
+    gptECS->cleanup_command_buffer(&ptBuffer0);
+    gptECS->cleanup_command_buffer(&ptBuffer1);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+command_buffer_order_test(void* pData)
+{
+    // buffers recorded by jobs play back in buffer order, so the resulting
+    // library doesn't depend on how many threads recorded them
+    uint64_t auHashes[PL_TEST_THREAD_COUNT_VARIANTS] = {0};
+    for(uint32_t uVariant = 0; uVariant < PL_TEST_THREAD_COUNT_VARIANTS; uVariant++)
+    {
+        test_set_thread_count(gauTestThreadCounts[uVariant]);
+        plComponentLibrary tLibrary = {0};
+        gptECS->init_component_library(&tLibrary);
+        ecs_test_build_objects(&tLibrary, 5000);
+        const plComponentType atTypes[] = {PL_COMPONENT_TYPE_OBJECT, PL_COMPONENT_TYPE_MESH};
+        plEcsQuery* ptQuery = gptECS->create_query(&tLibrary, 2, atTypes);
+
+        plEntity* sbtEntities = NULL;
+        for(uint32_t i = 0; i < 5000; i++)
+            pl_sb_push(sbtEntities, tLibrary.tObjectComponentManager.sbtEntities[i]);
+
+        plEcsCommandBuffer* atBuffers[16] = {0};
+        for(uint32_t i = 0; i < 16; i++)
+            atBuffers[i] = gptECS->create_command_buffer(&tLibrary);
+        plEcsTestRecordJob tJob = {
+            .atBuffers    = atBuffers,
+            .atEntities   = sbtEntities,
+            .uEntityCount = 5000,
+            .uJobCount    = 16
+        };
+        plJobDesc tJobDesc = {
+            .task  = ecs_test_record_job,
+            .pData = &tJob
+        };
+        plAtomicCounter* ptCounter = NULL;
+        gptJob->dispatch_batch(16, 1, tJobDesc, &ptCounter);
+        gptJob->wait_for_counter(ptCounter);
+        gptECS->playback_command_buffers(&tLibrary, 16, atBuffers);
+        pl_test_expect_true(ecs_test_managers_consistent(&tLibrary), "managers after playback");
+
+        uint32_t uWrong = 0;
+        char acName[32] = {0};
+        for(uint32_t i = 0; i < 5000; i++)
+        {
+            const bool bValid = gptECS->is_entity_valid(&tLibrary, sbtEntities[i]);
+            const bool bHasMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtEntities[i]) != NULL;
+            snprintf(acName, 32, "object %u", i);
+            const bool bNamed = gptECS->get_entity(&tLibrary, acName).uIndex != UINT32_MAX;
+            if(bValid != (i % 3 != 0) || bHasMesh != (i % 3 == 2) || bNamed != bValid)
+                uWrong++;
+        }
+        for(uint32_t i = 0; i < 16; i++)
+        {
+            for(uint32_t j = 0; j < atBuffers[i]->uCreatedCount; j++)
+            {
+                const plEntity tEntity = gptECS->resolve_entity(atBuffers[i], (plEntity){.uIndex = j, .uGeneration = PL__ECS_PLACEHOLDER_GENERATION});
+                const plTagComponent* ptTag = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TAG, tEntity);
+                const plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+                if(ptTag == NULL || ptTransform == NULL)
+                {
+                    uWrong++;
+                    continue;
+                }
+                snprintf(acName, 32, "new object %u", (uint32_t)ptTransform->tTranslation.y);
+                if(strcmp(acName, ptTag->acName) != 0 || gptECS->get_entity(&tLibrary, acName).uIndex != tEntity.uIndex)
+                    uWrong++;
+            }
+        }
+        pl_test_expect_uint32_equal(uWrong, 0, "played back changes");
+        pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptQuery), "query after playback");
+        auHashes[uVariant] = ecs_test_library_hash(&tLibrary);
+
+        for(uint32_t i = 0; i < 16; i++)
+            gptECS->cleanup_command_buffer(&atBuffers[i]);
+        pl_sb_free(sbtEntities);
+        gptECS->cleanup_query(&tLibrary, &ptQuery);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+
+    char acName[64] = {0};
+    for(uint32_t uVariant = 1; uVariant < PL_TEST_THREAD_COUNT_VARIANTS; uVariant++)
+    {
+        snprintf(acName, 64, "library on %u threads", gauTestThreadCounts[uVariant]);
+        pl_test_expect_uint64_equal(auHashes[0], auHashes[uVariant], acName);
+    }
+}
+
+void
+script_conflict_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scripts(&tLibrary, 200, false, true);
+    ecs_test_add_script(&tLibrary, gptECS->create_entity(&tLibrary), &gtEcsTestExclusive, 0, 0, 0);
+    plEntity tLateMover = gptECS->create_entity(&tLibrary);
+    gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tLateMover);
+    ecs_test_add_script(&tLibrary, tLateMover, &gtEcsTestMover, 0, 0, 1ull << PL_COMPONENT_TYPE_TRANSFORM);
+    guEcsTestExclusiveRuns = 0;
+    gptECS->run_script_update_system(&tLibrary);
+
+    const plComponentLibraryData* ptData = tLibrary.pInternal;
+    const plScriptComponent* sbtScripts = tLibrary.tScriptComponentManager.pComponents;
+    const uint32_t uScriptCount = pl_sb_size(sbtScripts);
+    uint32_t uMoverWave = 0;
+    uint32_t uFollowerMinWave = UINT32_MAX;
+    uint32_t uFollowerMaxWave = 0;
+    uint32_t uExclusiveWave = 0;
+    uint32_t uSpawnerCount = 0;
+    uint32_t uWrongSpawners = 0;
+    uint32_t uWrongAccumulators = 0;
+    uint32_t uPreviousAccumulator = UINT32_MAX;
+    for(uint32_t i = 0; i < uScriptCount; i++)
+    {
+        const uint32_t uWave = ptData->sbuScriptWaves[i];
+        const plScriptI* ptApi = sbtScripts[i]._ptApi;
+        if(ptApi == &gtEcsTestMover && i < uScriptCount - 1)
+            uMoverWave = pl_maxu(uMoverWave, uWave);
+        else if(ptApi == &gtEcsTestFollower)
+        {
+            uFollowerMinWave = pl_minu(uFollowerMinWave, uWave);
+            uFollowerMaxWave = pl_maxu(uFollowerMaxWave, uWave);
+        }
+        else if(ptApi == &gtEcsTestAccumulator)
+        {
+            // accumulators serialize in component order (the first has no earlier writer)
+            uWrongAccumulators += uWave != (uPreviousAccumulator == UINT32_MAX ? 0 : uPreviousAccumulator + 1);
+            uPreviousAccumulator = uWave;
+        }
+        else if(ptApi == &gtEcsTestExclusive)
+            uExclusiveWave = uWave;
+        else if(ptApi == &gtEcsTestSpawner)
+        {
+            uWrongSpawners += uWave != 0;
+            uSpawnerCount++;
+        }
+    }
+    const uint32_t uLateMoverWave = ptData->sbuScriptWaves[uScriptCount - 1];
+    const uint32_t uWaveCount = pl_sb_size(ptData->sbuScriptWaveStarts) - 1;
+
+    pl_test_expect_uint32_equal(uMoverWave, 0, "disjoint entity writes share a wave");
+    pl_test_expect_uint32_equal(uFollowerMinWave, 1, "readers after writers");
+    pl_test_expect_uint32_equal(uFollowerMaxWave, 1, "readers after writers");
+    pl_test_expect_uint32_equal(uWrongAccumulators, 0, "shared writes serialize");
+    pl_test_expect_uint32_equal(uWrongSpawners, 0, "no declared access");
+    pl_test_expect_uint32_equal(uExclusiveWave, pl_maxu(1, uPreviousAccumulator) + 1, "exclusive script after every earlier script");
+    pl_test_expect_uint32_equal(uLateMoverWave, uExclusiveWave + 1, "scripts after an exclusive script");
+    pl_test_expect_uint32_equal(uWaveCount, uLateMoverWave + 1, "wave count");
+    pl_test_expect_uint32_equal(ptData->sbuScriptWaveStarts[uExclusiveWave + 1] - ptData->sbuScriptWaveStarts[uExclusiveWave], 1, "exclusive script runs alone");
+
+    // spawns are played back before the exclusive script runs
+    pl_test_expect_uint32_equal(guEcsTestExclusiveRuns, 1, NULL);
+    pl_test_expect_uint32_equal(guEcsTestExclusiveSeen, 200 + 1 + uSpawnerCount, "played back spawns");
+    gptECS->cleanup_component_library(&tLibrary);
+    pl_sb_free(gsbtEcsTestFollowed);
+}
+
+void
+script_determinism_test(void* pData)
+{
+    // parallel scripts match the serial run & don't depend on the thread count
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scripts(&tLibrary, 2000, true, false);
+    for(uint32_t uFrame = 0; uFrame < 8; uFrame++)
+        gptECS->run_script_update_system(&tLibrary);
+    const double dSerial = ecs_test_script_checksum(&tLibrary);
+    gptECS->cleanup_component_library(&tLibrary);
+
+    double adChecksums[PL_TEST_THREAD_COUNT_VARIANTS] = {0};
+    uint32_t auTransformCounts[PL_TEST_THREAD_COUNT_VARIANTS] = {0};
+    for(uint32_t uVariant = 0; uVariant < PL_TEST_THREAD_COUNT_VARIANTS; uVariant++)
+    {
+        test_set_thread_count(gauTestThreadCounts[uVariant]);
+        gptECS->init_component_library(&tLibrary);
+        ecs_test_build_scripts(&tLibrary, 2000, false, false);
+        for(uint32_t uFrame = 0; uFrame < 8; uFrame++)
+            gptECS->run_script_update_system(&tLibrary);
+        pl_test_expect_true(ecs_test_script_checksum(&tLibrary) == dSerial, "parallel vs serial");
+        gptECS->cleanup_component_library(&tLibrary);
+
+        gptECS->init_component_library(&tLibrary);
+        ecs_test_build_scripts(&tLibrary, 2000, false, true);
+        for(uint32_t uFrame = 0; uFrame < 8; uFrame++)
+            gptECS->run_script_update_system(&tLibrary);
+        adChecksums[uVariant] = ecs_test_script_checksum(&tLibrary);
+        auTransformCounts[uVariant] = pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities);
+        gptECS->cleanup_component_library(&tLibrary);
+    }
+    test_set_thread_count(PL_TEST_DEFAULT_THREADS);
+
+    for(uint32_t uVariant = 1; uVariant < PL_TEST_THREAD_COUNT_VARIANTS; uVariant++)
+    {
+        pl_test_expect_true(adChecksums[0] == adChecksums[uVariant], "with spawners, thread count");
+        pl_test_expect_uint32_equal(auTransformCounts[0], auTransformCounts[uVariant], "spawned entities, thread count");
+    }
+    pl_sb_free(gsbtEcsTestFollowed);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_script_tests(void* pData)
+{
+    pl_test_register_test(command_buffer_semantics_test, NULL);
+    pl_test_register_test(command_buffer_order_test, NULL);
+    pl_test_register_test(script_conflict_test, NULL);
+    pl_test_register_test(script_determinism_test, NULL);
+}
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+snapshot_round_trip_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 43;
+    ecs_test_build_snapshot_scene(&tLibrary, 200, 64);
+    for(uint32_t i = 0; i < 3; i++)
+        ecs_test_run_frame(&tLibrary, 0.1f); // clips built & caches live
+
+    size_t szSize = 0;
+    pl_test_expect_true(gptECS->save_snapshot(&tLibrary, NULL, &szSize), "query size");
+    unsigned char* pucSnapshot = malloc(szSize);
+    size_t szSmall = szSize - 1;
+    pl_test_expect_false(gptECS->save_snapshot(&tLibrary, pucSnapshot, &szSmall), "buffer too small");
+    pl_test_expect_true(gptECS->save_snapshot(&tLibrary, pucSnapshot, &szSize), "save");
+
+    // existing queries pick up the loaded entities
+    plComponentLibrary tLoaded = {0};
+    gptECS->init_component_library(&tLoaded);
+    const plComponentType atTypes[] = {PL_COMPONENT_TYPE_TRANSFORM, PL_COMPONENT_TYPE_MESH};
+    plEcsQuery* ptQuery = gptECS->create_query(&tLoaded, 2, atTypes);
+    pl_test_expect_true(gptECS->load_snapshot(&tLoaded, pucSnapshot, szSize), "load");
+    pl_test_expect_uint32_equal(ecs_test_compare_libraries(&tLibrary, &tLoaded), 0, "round trip mismatches");
+    pl_test_expect_true(ecs_test_query_matches(&tLoaded, ptQuery), "query after load");
+    pl_test_expect_false(gptECS->load_snapshot(&tLoaded, pucSnapshot, szSize), "load into non empty library");
+
+    // the compressed clip comes back compressed (same packed data), the other one is rebuilt lazily
+    const plAnimationComponent* sbtAnimations = tLibrary.tAnimationComponentManager.pComponents;
+    const plAnimationComponent* sbtLoadedAnimations = tLoaded.tAnimationComponentManager.pComponents;
+    const plAnimationClip* ptClip = sbtAnimations[0]._ptClip;
+    const plAnimationClip* ptLoadedClip = sbtLoadedAnimations[0]._ptClip;
+    pl_test_expect_true(ptLoadedClip != NULL && ptLoadedClip->sbtCompressedChannels != NULL, "compressed clip loaded");
+    if(ptLoadedClip)
+    {
+        pl_test_expect_true(memcmp(&ptLoadedClip->tCompression, &ptClip->tCompression, sizeof(plAnimationCompressionDesc)) == 0, "compression desc");
+        pl_test_expect_uint32_equal((uint32_t)ecs_test_clip_size(ptLoadedClip), (uint32_t)ecs_test_clip_size(ptClip), "compressed clip size");
+        pl_test_expect_true(pl_sb_size(ptLoadedClip->sbuValues) == pl_sb_size(ptClip->sbuValues) &&
+            memcmp(ptLoadedClip->sbuValues, ptClip->sbuValues, pl_sb_size(ptClip->sbuValues) * sizeof(uint16_t)) == 0, "compressed values");
+    }
+    pl_test_expect_true(sbtLoadedAnimations[1]._ptClip == NULL, "uncompressed clip rebuilt lazily");
+
+    // resaving gives the same bytes
+    size_t szResaved = 0;
+    gptECS->save_snapshot(&tLoaded, NULL, &szResaved);
+    unsigned char* pucResaved = malloc(szResaved);
+    gptECS->save_snapshot(&tLoaded, pucResaved, &szResaved);
+    pl_test_expect_true(szResaved == szSize && memcmp(pucResaved, pucSnapshot, szSize) == 0, "resaved snapshot");
+    free(pucResaved);
+
+    // systems produce the same results & new entities reuse the same slots
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        ecs_test_run_frame(&tLibrary, 0.05f);
+        ecs_test_run_frame(&tLoaded, 0.05f);
+    }
+    pl_test_expect_true(ecs_test_libraries_identical(&tLibrary, &tLoaded), "systems after load");
+    pl_test_expect_true(gptECS->create_entity(&tLibrary).ulData == gptECS->create_entity(&tLoaded).ulData, "free slot reuse");
+    gptECS->cleanup_query(&tLoaded, &ptQuery);
+    gptECS->cleanup_component_library(&tLoaded);
+
+    // corrupt data is rejected without touching the library
+    plComponentLibrary tRejected = {0};
+    gptECS->init_component_library(&tRejected);
+    unsigned char* pucCorrupt = malloc(szSize);
+    plEcsSnapshotHeader* ptHeader = (plEcsSnapshotHeader*)pucCorrupt;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucSnapshot, szSize - 16), "truncated");
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucSnapshot, 10), "no header");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    ptHeader->uVersion++;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "version");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    ptHeader->atSections[PL_COMPONENT_TYPE_MESH].uStride += 4;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "component layout");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    ptHeader->uBufferCount--;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "buffer count");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    ((plEcsSnapshotBuffer*)&pucCorrupt[ptHeader->uBufferTableOffset])[3].uCount = 0x7fffffff;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "buffer range");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    ptHeader->uCompressionOffset = szSize;
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "compression table range");
+    memcpy(pucCorrupt, pucSnapshot, szSize);
+    memset(&pucCorrupt[ptHeader->uStringTableOffset], 'x', ptHeader->uStringTableSize);
+    pl_test_expect_false(gptECS->load_snapshot(&tRejected, pucCorrupt, szSize), "unterminated names");
+    pl_test_expect_uint32_equal(pl_sb_size(tRejected.sbtEntityGenerations), 0, "rejected library untouched");
+    pl_test_expect_true(gptECS->load_snapshot(&tRejected, pucSnapshot, szSize), "load after rejections");
+
+    free(pucCorrupt);
+    free(pucSnapshot);
+    gptECS->cleanup_component_library(&tRejected);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_snapshot_tests(void* pData)
+{
+    pl_test_register_test(snapshot_round_trip_test, NULL);
+}
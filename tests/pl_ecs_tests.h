@@ -0,0 +1,1349 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+static uint32_t guEcsTestSeed = 12345;
+
+static float
+ecs_test_rand(void)
+{
+    guEcsTestSeed = guEcsTestSeed * 1664525u + 1013904223u;
+    return (float)(guEcsTestSeed >> 8) / 16777216.0f;
+}
+
+// uObjects objects (every 4th starts a new chain, the rest are parented to the
+// previous object) & uSkins skinned objects driven by 8 joint chains
+static void
+ecs_test_build_scene(plComponentLibrary* ptLibrary, uint32_t uObjects, uint32_t uSkins)
+{
+    char acName[32] = {0};
+    plEntity tPrevious = {.uIndex = UINT32_MAX, .uGeneration = UINT32_MAX};
+    for(uint32_t i = 0; i < uObjects; i++)
+    {
+        snprintf(acName, 32, "object %u", i);
+        plEntity tEntity = gptECS->create_object(ptLibrary, acName, NULL);
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        ptTransform->tTranslation = pl_create_vec3(ecs_test_rand() * 10.0f, ecs_test_rand() * 10.0f, ecs_test_rand() * 10.0f);
+        ptTransform->tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand(), ecs_test_rand(), ecs_test_rand(), 1.0f));
+        ptTransform->tScale = pl_create_vec3(1.0f + ecs_test_rand(), 1.0f, 1.0f);
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tEntity);
+        ptMesh->tAABB.tMin = pl_create_vec3(-1.0f, -1.0f, -1.0f);
+        ptMesh->tAABB.tMax = pl_create_vec3(1.0f, 2.0f, 3.0f);
+        if(i % 4 != 0)
+            gptECS->attach_component(ptLibrary, tEntity, tPrevious);
+        tPrevious = tEntity;
+    }
+
+    for(uint32_t i = 0; i < uSkins; i++)
+    {
+        plEntity atJoints[8] = {0};
+        for(uint32_t j = 0; j < 8; j++)
+        {
+            snprintf(acName, 32, "joint %u %u", i, j);
+            plTransformComponent* ptTransform = NULL;
+            atJoints[j] = gptECS->create_transform(ptLibrary, acName, &ptTransform);
+            ptTransform->tTranslation = pl_create_vec3(0.0f, 1.0f, 0.0f);
+            ptTransform->tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() * 0.2f, 0.0f, 0.0f, 1.0f));
+            if(j > 0)
+                gptECS->attach_component(ptLibrary, atJoints[j], atJoints[j - 1]);
+        }
+
+        snprintf(acName, 32, "skinned object %u", i);
+        plEntity tObject = gptECS->create_object(ptLibrary, acName, NULL);
+        snprintf(acName, 32, "skin %u", i);
+        plSkinComponent* ptSkin = NULL;
+        plEntity tSkin = gptECS->create_skin(ptLibrary, acName, &ptSkin);
+        ptSkin->tMeshNode = tObject;
+        for(uint32_t j = 0; j < 8; j++)
+        {
+            pl_sb_push(ptSkin->sbtJoints, atJoints[j]);
+            pl_sb_push(ptSkin->sbtInverseBindMatrices, pl_mat4_translate_xyz(0.0f, -(float)j, 0.0f));
+            pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+            pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+        }
+        plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tObject);
+        ptMesh->tSkinComponent = tSkin;
+        ptMesh->tAABB.tMax = pl_create_vec3(1.0f, 1.0f, 1.0f);
+    }
+}
+
+// nudges every local transform so the next frame rebuilds all of them
+static void
+ecs_test_dirty_transforms(plComponentLibrary* ptLibrary)
+{
+    static float fNudge = 1.0f / 1024.0f;
+    fNudge = -fNudge;
+    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    const uint32_t uCount = pl_sb_size(ptLibrary->tTransformComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uCount; i++)
+        sbtTransforms[i].tTranslation.x += fNudge;
+}
+
+static bool
+ecs_test_matrices_near(const plMat4* ptMat0, const plMat4* ptMat1, float fError)
+{
+    for(uint32_t i = 0; i < 16; i++)
+    {
+        if(fabsf(ptMat0->d[i] - ptMat1->d[i]) > fError * (1.0f + fabsf(ptMat0->d[i])))
+            return false;
+    }
+    return true;
+}
+
+// every entity with all of the query's components has exactly one row & the
+// row's dense indices match the managers' hashmaps
+static bool
+ecs_test_query_matches(plComponentLibrary* ptLibrary, const plEcsQuery* ptQuery)
+{
+    uint32_t uExpected = 0;
+    const plComponentManager* ptFirstManager = ptLibrary->_ptManagers[ptQuery->atComponentTypes[0]];
+    for(uint32_t i = 0; i < pl_sb_size(ptFirstManager->sbtEntities); i++)
+    {
+        const plEntity tEntity = ptFirstManager->sbtEntities[i];
+        bool bMatch = true;
+        for(uint32_t j = 0; j < ptQuery->uComponentCount; j++)
+        {
+            if(!pl_hm_has_key(ptLibrary->_ptManagers[ptQuery->atComponentTypes[j]]->ptHashmap, tEntity.uIndex))
+                bMatch = false;
+        }
+        if(!bMatch)
+            continue;
+        uExpected++;
+
+        const uint32_t uRow = tEntity.uIndex < pl_sb_size(ptQuery->_sbuRows) ? ptQuery->_sbuRows[tEntity.uIndex] : UINT32_MAX;
+        if(uRow >= ptQuery->uCount || ptQuery->sbtEntities[uRow].ulData != tEntity.ulData)
+            return false;
+        for(uint32_t j = 0; j < ptQuery->uComponentCount; j++)
+        {
+            if(ptQuery->sbuIndices[j][uRow] != pl_hm_lookup(ptLibrary->_ptManagers[ptQuery->atComponentTypes[j]]->ptHashmap, tEntity.uIndex))
+                return false;
+        }
+    }
+    return uExpected == ptQuery->uCount && pl_sb_size(ptQuery->sbtEntities) == ptQuery->uCount;
+}
+
+static void
+ecs_test_run_frame(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    gptECS->run_animation_update_system(ptLibrary, fDeltaTime);
+    gptECS->run_transform_update_system(ptLibrary);
+    gptECS->run_hierarchy_update_system(ptLibrary);
+    gptECS->run_skin_update_system(ptLibrary);
+    gptECS->run_object_update_system(ptLibrary);
+}
+
+// bitwise comparison of transforms, skin palettes & object bounds
+static bool
+ecs_test_libraries_identical(plComponentLibrary* ptLibrary0, plComponentLibrary* ptLibrary1)
+{
+    const uint32_t uTransformCount = pl_sb_size(ptLibrary0->tTransformComponentManager.sbtEntities);
+    if(uTransformCount != pl_sb_size(ptLibrary1->tTransformComponentManager.sbtEntities))
+        return false;
+    if(memcmp(ptLibrary0->tTransformComponentManager.pComponents, ptLibrary1->tTransformComponentManager.pComponents, uTransformCount * sizeof(plTransformComponent)) != 0)
+        return false;
+
+    const plSkinComponent* sbtSkins0 = ptLibrary0->tSkinComponentManager.pComponents;
+    const plSkinComponent* sbtSkins1 = ptLibrary1->tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary0->tSkinComponentManager.sbtEntities); i++)
+    {
+        if(memcmp(sbtSkins0[i].sbtTextureData, sbtSkins1[i].sbtTextureData, pl_sb_size(sbtSkins0[i].sbtTextureData) * sizeof(plMat4)) != 0)
+            return false;
+    }
+
+    const plMeshComponent* sbtMeshes0 = ptLibrary0->tMeshComponentManager.pComponents;
+    const plMeshComponent* sbtMeshes1 = ptLibrary1->tMeshComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary0->tMeshComponentManager.sbtEntities); i++)
+    {
+        if(memcmp(&sbtMeshes0[i].tAABBFinal, &sbtMeshes1[i].tAABBFinal, sizeof(plAABB)) != 0)
+            return false;
+    }
+    return true;
+}
+
+// world matrix computed from scratch by walking the parent chain
+static plMat4
+ecs_test_reference_world(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    const plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+    plMat4 tWorld = pl_rotation_translation_scale(ptTransform->tRotation, ptTransform->tTranslation, ptTransform->tScale);
+    const plHierarchyComponent* ptHierarchy = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, tEntity);
+    for(uint32_t i = 0; ptHierarchy && i < PL_ECS_MAX_HIERARCHY_DEPTH; i++)
+    {
+        const plTransformComponent* ptParent = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptHierarchy->tParent);
+        if(ptParent == NULL)
+            break;
+        const plMat4 tParentLocal = pl_rotation_translation_scale(ptParent->tRotation, ptParent->tTranslation, ptParent->tScale);
+        tWorld = pl_mul_mat4(&tParentLocal, &tWorld);
+        ptHierarchy = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_HIERARCHY, ptHierarchy->tParent);
+    }
+    return tWorld;
+}
+
+static void
+ecs_test_build_objects(plComponentLibrary* ptLibrary, uint32_t uCount)
+{
+    char acName[32] = {0};
+    for(uint32_t i = 0; i < uCount; i++)
+    {
+        snprintf(acName, 32, "object %u", i);
+        plEntity tEntity = gptECS->create_object(ptLibrary, acName, NULL);
+        plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        ptTransform->tTranslation.x = (float)i;
+    }
+}
+
+// uJoints transforms with a translation/rotation/scale channel each, all
+// sharing key times (except joint 1) with every 7th key repeated
+static void
+ecs_test_add_clip(plComponentLibrary* ptLibrary, uint32_t uJoints, uint32_t uKeys, bool bMixedModes)
+{
+    float* sbfTimes = NULL;
+    float fTime = 0.0f;
+    for(uint32_t i = 0; i < uKeys; i++)
+    {
+        pl_sb_push(sbfTimes, fTime);
+        fTime += i % 7 == 3 ? 0.0f : 0.005f + 0.02f * ecs_test_rand();
+    }
+
+    plAnimationSampler* sbtSamplers = NULL;
+    plAnimationChannel* sbtChannels = NULL;
+    const plAnimationPath atPaths[] = {PL_ANIMATION_PATH_TRANSLATION, PL_ANIMATION_PATH_ROTATION, PL_ANIMATION_PATH_SCALE};
+    const plAnimationMode atModes[] = {PL_ANIMATION_MODE_CUBIC_SPLINE, PL_ANIMATION_MODE_STEP, PL_ANIMATION_MODE_LINEAR};
+    for(uint32_t i = 0; i < uJoints; i++)
+    {
+        plEntity tTarget = gptECS->create_transform(ptLibrary, NULL, NULL);
+        const plAnimationMode tMode = bMixedModes ? atModes[i % 3] : PL_ANIMATION_MODE_LINEAR;
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            plEntity tData = gptECS->create_entity(ptLibrary);
+            plAnimationDataComponent* ptData = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, tData);
+            const uint32_t uValuesPerKey = (j == 1 ? 4 : 3) * (tMode == PL_ANIMATION_MODE_CUBIC_SPLINE ? 3 : 1);
+            for(uint32_t k = 0; k < uKeys; k++)
+                pl_sb_push(ptData->sbfKeyFrameTimes, i == 1 ? sbfTimes[k] * 0.5f : sbfTimes[k]);
+            for(uint32_t k = 0; k < uKeys * uValuesPerKey; k++)
+                pl_sb_push(ptData->sbfKeyFrameData, ecs_test_rand() * 2.0f - 1.0f);
+            const plAnimationSampler tSampler = {.tMode = tMode, .tData = tData};
+            pl_sb_push(sbtSamplers, tSampler);
+            const plAnimationChannel tChannel = {.tPath = atPaths[j], .tTarget = tTarget, .uSamplerIndex = pl_sb_size(sbtSamplers) - 1};
+            pl_sb_push(sbtChannels, tChannel);
+        }
+    }
+
+    plEntity tEntity = gptECS->create_entity(ptLibrary);
+    plAnimationComponent* ptAnimation = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tEntity);
+    ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING | PL_ANIMATION_FLAG_LOOPED;
+    ptAnimation->fEnd = fTime;
+    ptAnimation->fSpeed = 1.0f;
+    ptAnimation->fBlendAmount = 1.0f;
+    ptAnimation->sbtSamplers = sbtSamplers;
+    ptAnimation->sbtChannels = sbtChannels;
+    pl_sb_free(sbfTimes);
+}
+
+// the original animation system: linear scan for the active key of every
+// channel every frame, sampled & applied one channel at a time
+static void
+ecs_test_reference_animation(plComponentLibrary* ptLibrary, float fDeltaTime)
+{
+    plAnimationComponent* sbtComponents = ptLibrary->tAnimationComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtComponents); i++)
+    {
+        plAnimationComponent* ptAnimation = &sbtComponents[i];
+        if(!(ptAnimation->tFlags & PL_ANIMATION_FLAG_PLAYING))
+            continue;
+
+        ptAnimation->fTimer += fDeltaTime;
+        if(ptAnimation->tFlags & PL_ANIMATION_FLAG_LOOPED)
+            ptAnimation->fTimer = fmodf(ptAnimation->fTimer, ptAnimation->fEnd);
+        if(ptAnimation->fTimer > ptAnimation->fEnd)
+        {
+            ptAnimation->tFlags &= ~PL_ANIMATION_FLAG_PLAYING;
+            ptAnimation->fTimer = 0.0f;
+            continue;
+        }
+
+        for(uint32_t j = 0; j < pl_sb_size(ptAnimation->sbtChannels); j++)
+        {
+            const plAnimationChannel* ptChannel = &ptAnimation->sbtChannels[j];
+            const plAnimationSampler* ptSampler = &ptAnimation->sbtSamplers[ptChannel->uSamplerIndex];
+            const plAnimationDataComponent* ptData = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, ptSampler->tData);
+            plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptChannel->tTarget);
+
+            const float* afTimes = ptData->sbfKeyFrameTimes;
+            const float* afData = ptData->sbfKeyFrameData;
+            const uint32_t uKeyCount = pl_sb_size(ptData->sbfKeyFrameTimes);
+            const float fModTime = pl_clampf(afTimes[0], ptAnimation->fTimer, afTimes[uKeyCount - 1]);
+            int iNextKey = 0;
+            for(uint32_t k = 0; k < uKeyCount; k++)
+            {
+                if(fModTime <= afTimes[k])
+                {
+                    iNextKey = pl_clampi(1, k, uKeyCount - 1);
+                    break;
+                }
+            }
+            const int iPrevKey = pl_clampi(0, iNextKey - 1, uKeyCount - 1);
+            const float fKeyDelta = afTimes[iNextKey] - afTimes[iPrevKey];
+            const float fTn = (fModTime - afTimes[iPrevKey]) / fKeyDelta;
+            const float fTSq = fTn * fTn;
+            const float fTCub = fTSq * fTn;
+
+            const int iStride = ptChannel->tPath == PL_ANIMATION_PATH_ROTATION ? 4 : 3;
+            plVec4 tValue = {0};
+            if(ptSampler->tMode == PL_ANIMATION_MODE_STEP)
+            {
+                for(int k = 0; k < iStride; k++)
+                    tValue.d[k] = afData[iPrevKey * iStride + k];
+            }
+            else if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR && iStride == 4)
+                tValue = pl_quat_slerp(*(plVec4*)&afData[iPrevKey * 4], *(plVec4*)&afData[iNextKey * 4], fTn);
+            else if(ptSampler->tMode == PL_ANIMATION_MODE_LINEAR)
+            {
+                for(int k = 0; k < iStride; k++)
+                    tValue.d[k] = afData[iPrevKey * 3 + k] * (1.0f - fTn) + afData[iNextKey * 3 + k] * fTn;
+            }
+            else
+            {
+                // in-tangent, value, out-tangent per key
+                const int iPrevIndex = iPrevKey * iStride * 3;
+                const int iNextIndex = iNextKey * iStride * 3;
+                for(int k = 0; k < iStride; k++)
+                {
+                    const float fV0 = afData[iPrevIndex + k + iStride];
+                    const float fA = fKeyDelta * afData[iNextIndex + k];
+                    const float fB = fKeyDelta * afData[iPrevIndex + k + 2 * iStride];
+                    const float fV1 = afData[iNextIndex + k + iStride];
+                    tValue.d[k] = ((2 * fTCub - 3 * fTSq + 1) * fV0) + ((fTCub - 2 * fTSq + fTn) * fB) + ((-2 * fTCub + 3 * fTSq) * fV1) + ((fTCub - fTSq) * fA);
+                }
+            }
+
+            if(ptChannel->tPath == PL_ANIMATION_PATH_TRANSLATION)
+                ptTransform->tTranslation = pl_lerp_vec3(ptTransform->tTranslation, tValue.xyz, ptAnimation->fBlendAmount);
+            else if(ptChannel->tPath == PL_ANIMATION_PATH_ROTATION)
+                ptTransform->tRotation = pl_quat_slerp(ptTransform->tRotation, tValue, ptAnimation->fBlendAmount);
+            else
+                ptTransform->tScale = tValue.xyz;
+        }
+    }
+}
+
+// smooth, mocap like clip: uJoints transforms with a translation/rotation/scale
+// channel each & uKeys keys at 30 fps (every 4th joint still, every 6th scaling,
+// some rotation keys sign flipped); iMode < 0 mixes linear & step channels
+static plEntity
+ecs_test_add_mocap_clip(plComponentLibrary* ptLibrary, uint32_t uJoints, uint32_t uKeys, int iMode)
+{
+    plAnimationSampler* sbtSamplers = NULL;
+    plAnimationChannel* sbtChannels = NULL;
+    const plAnimationPath atPaths[] = {PL_ANIMATION_PATH_TRANSLATION, PL_ANIMATION_PATH_ROTATION, PL_ANIMATION_PATH_SCALE};
+    for(uint32_t i = 0; i < uJoints; i++)
+    {
+        plEntity tTarget = gptECS->create_transform(ptLibrary, NULL, NULL);
+        const float fFreq0 = 0.2f + ecs_test_rand();
+        const float fFreq1 = 0.3f + ecs_test_rand();
+        const float fPhase = ecs_test_rand() * 6.0f;
+        const bool bStill = i % 4 == 0;
+        const plAnimationMode tMode = iMode >= 0 ? (plAnimationMode)iMode : (i % 5 == 4 ? PL_ANIMATION_MODE_STEP : PL_ANIMATION_MODE_LINEAR);
+        for(uint32_t j = 0; j < 3; j++)
+        {
+            plEntity tData = gptECS->create_entity(ptLibrary);
+            plAnimationDataComponent* ptData = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, tData);
+            for(uint32_t k = 0; k < uKeys; k++)
+            {
+                const float fTime = (float)k / 30.0f;
+                pl_sb_push(ptData->sbfKeyFrameTimes, fTime);
+                if(j == 0)
+                {
+                    pl_sb_push(ptData->sbfKeyFrameData, bStill ? 0.5f : 0.3f * sinf(fFreq0 * fTime + fPhase));
+                    pl_sb_push(ptData->sbfKeyFrameData, bStill ? 1.0f : 0.2f * cosf(fFreq1 * fTime));
+                    pl_sb_push(ptData->sbfKeyFrameData, 0.1f * (float)i);
+                }
+                else if(j == 1)
+                {
+                    const plVec3 tAxis = pl_norm_vec3(pl_create_vec3(sinf(fFreq0 * fTime * 0.5f + fPhase), 1.0f, cosf(fFreq1 * fTime * 0.3f)));
+                    const float fAngle = 1.2f * sinf(fFreq1 * fTime + fPhase);
+                    plVec4 tQuat = {.x = tAxis.x * sinf(fAngle / 2), .y = tAxis.y * sinf(fAngle / 2), .z = tAxis.z * sinf(fAngle / 2), .w = cosf(fAngle / 2)};
+                    if(k % 2 && i % 3 == 1)
+                        tQuat = pl_mul_vec4_scalarf(tQuat, -1.0f);
+                    for(uint32_t m = 0; m < 4; m++)
+                        pl_sb_push(ptData->sbfKeyFrameData, tQuat.d[m]);
+                }
+                else
+                {
+                    for(uint32_t m = 0; m < 3; m++)
+                        pl_sb_push(ptData->sbfKeyFrameData, i % 6 == 5 ? 1.0f + 0.1f * sinf(fTime * fFreq0) : 1.0f);
+                }
+            }
+            const plAnimationSampler tSampler = {.tMode = tMode, .tData = tData};
+            pl_sb_push(sbtSamplers, tSampler);
+            const plAnimationChannel tChannel = {.tPath = atPaths[j], .tTarget = tTarget, .uSamplerIndex = pl_sb_size(sbtSamplers) - 1};
+            pl_sb_push(sbtChannels, tChannel);
+        }
+    }
+
+    plEntity tEntity = gptECS->create_entity(ptLibrary);
+    plAnimationComponent* ptAnimation = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tEntity);
+    ptAnimation->tFlags = PL_ANIMATION_FLAG_PLAYING | PL_ANIMATION_FLAG_LOOPED;
+    ptAnimation->fEnd = (float)(uKeys - 1) / 30.0f;
+    ptAnimation->fSpeed = 1.0f;
+    ptAnimation->fBlendAmount = 1.0f;
+    ptAnimation->sbtSamplers = sbtSamplers;
+    ptAnimation->sbtChannels = sbtChannels;
+    return tEntity;
+}
+
+// max bone space deviation: unit points along each local axis pushed through
+// both libraries' local transforms
+static float
+ecs_test_bone_space_deviation(plComponentLibrary* ptLibrary0, plComponentLibrary* ptLibrary1)
+{
+    const plTransformComponent* sbtTransforms0 = ptLibrary0->tTransformComponentManager.pComponents;
+    const plTransformComponent* sbtTransforms1 = ptLibrary1->tTransformComponentManager.pComponents;
+    float fDeviation = 0.0f;
+    for(uint32_t i = 0; i < pl_sb_size(ptLibrary0->tTransformComponentManager.sbtEntities); i++)
+    {
+        const plMat4 tLocal0 = pl_rotation_translation_scale(sbtTransforms0[i].tRotation, sbtTransforms0[i].tTranslation, sbtTransforms0[i].tScale);
+        const plMat4 tLocal1 = pl_rotation_translation_scale(sbtTransforms1[i].tRotation, sbtTransforms1[i].tTranslation, sbtTransforms1[i].tScale);
+        for(uint32_t j = 0; j < 6; j++)
+        {
+            plVec4 tPoint = {.x = 0.0f, .y = 0.0f, .z = 0.0f, .w = 1.0f};
+            tPoint.d[j / 2] = j % 2 ? -1.0f : 1.0f;
+            const plVec4 tPoint0 = pl_mul_mat4_vec4(&tLocal0, tPoint);
+            const plVec4 tPoint1 = pl_mul_mat4_vec4(&tLocal1, tPoint);
+            fDeviation = pl_maxf(fDeviation, pl_length_vec3(pl_sub_vec3(tPoint0.xyz, tPoint1.xyz)));
+        }
+    }
+    return fDeviation;
+}
+
+static size_t
+ecs_test_clip_size(const plAnimationClip* ptClip)
+{
+    return pl_sb_size(ptClip->sbfTimes) * sizeof(float) +
+        pl_sb_size(ptClip->sbfValues) * sizeof(float) +
+        pl_sb_size(ptClip->sbuKeys) * sizeof(uint16_t) +
+        pl_sb_size(ptClip->sbuValues) * sizeof(uint16_t) +
+        pl_sb_size(ptClip->sbtCompressedChannels) * sizeof(plCompressedChannel) +
+        pl_sb_size(ptClip->sbtTracks) * sizeof(plAnimationTrack);
+}
+
+// two linear keys (t = 0 & 1) per joint: translation tStart -> tEnd & a rotation
+// about y from fStartAngle -> fEndAngle
+typedef struct _plEcsTestJointKeys
+{
+    plVec3 tStart;
+    plVec3 tEnd;
+    float  fStartAngle;
+    float  fEndAngle;
+} plEcsTestJointKeys;
+
+static plEntity
+ecs_test_add_blend_clip(plComponentLibrary* ptLibrary, const plEntity* atJoints, const plEcsTestJointKeys* atKeys, uint32_t uAnimatedJoints)
+{
+    plAnimationSampler* sbtSamplers = NULL;
+    plAnimationChannel* sbtChannels = NULL;
+    for(uint32_t i = 0; i < uAnimatedJoints; i++)
+    {
+        for(uint32_t j = 0; j < 2; j++)
+        {
+            plEntity tData = gptECS->create_entity(ptLibrary);
+            plAnimationDataComponent* ptData = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION_DATA, tData);
+            pl_sb_push(ptData->sbfKeyFrameTimes, 0.0f);
+            pl_sb_push(ptData->sbfKeyFrameTimes, 1.0f);
+            if(j == 0)
+            {
+                for(uint32_t k = 0; k < 3; k++)
+                    pl_sb_push(ptData->sbfKeyFrameData, atKeys[i].tStart.d[k]);
+                for(uint32_t k = 0; k < 3; k++)
+                    pl_sb_push(ptData->sbfKeyFrameData, atKeys[i].tEnd.d[k]);
+            }
+            else
+            {
+                const plVec4 tStart = pl_quat_rotation_normal(atKeys[i].fStartAngle, 0.0f, 1.0f, 0.0f);
+                const plVec4 tEnd = pl_quat_rotation_normal(atKeys[i].fEndAngle, 0.0f, 1.0f, 0.0f);
+                for(uint32_t k = 0; k < 4; k++)
+                    pl_sb_push(ptData->sbfKeyFrameData, tStart.d[k]);
+                for(uint32_t k = 0; k < 4; k++)
+                    pl_sb_push(ptData->sbfKeyFrameData, tEnd.d[k]);
+            }
+            const plAnimationSampler tSampler = {.tMode = PL_ANIMATION_MODE_LINEAR, .tData = tData};
+            pl_sb_push(sbtSamplers, tSampler);
+            const plAnimationChannel tChannel = {
+                .tPath         = j == 0 ? PL_ANIMATION_PATH_TRANSLATION : PL_ANIMATION_PATH_ROTATION,
+                .tTarget       = atJoints[i],
+                .uSamplerIndex = pl_sb_size(sbtSamplers) - 1
+            };
+            pl_sb_push(sbtChannels, tChannel);
+        }
+    }
+
+    plEntity tEntity = gptECS->create_entity(ptLibrary);
+    plAnimationComponent* ptAnimation = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_ANIMATION, tEntity);
+    ptAnimation->fEnd = 1.0f;
+    ptAnimation->sbtSamplers = sbtSamplers;
+    ptAnimation->sbtChannels = sbtChannels;
+    return tEntity;
+}
+
+// the original skin system: a lookup per joint & a full inverse + transpose for
+// every normal matrix
+static void
+ecs_test_reference_skin(plComponentLibrary* ptLibrary)
+{
+    plSkinComponent* sbtSkins = ptLibrary->tSkinComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtSkins); i++)
+    {
+        const plTransformComponent* ptMeshTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtSkins[i].tMeshNode);
+        const plMat4 tInverseMeshWorld = pl_mat4_invert(&ptMeshTransform->tWorld);
+        for(uint32_t j = 0; j < pl_sb_size(sbtSkins[i].sbtJoints); j++)
+        {
+            const plTransformComponent* ptJoint = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtSkins[i].sbtJoints[j]);
+            plMat4 tJoint = pl_mul_mat4(&ptJoint->tWorld, &sbtSkins[i].sbtInverseBindMatrices[j]);
+            tJoint = pl_mul_mat4(&tInverseMeshWorld, &tJoint);
+            const plMat4 tInverseJoint = pl_mat4_invert(&tJoint);
+            sbtSkins[i].sbtTextureData[j * 2] = tJoint;
+            sbtSkins[i].sbtTextureData[j * 2 + 1] = pl_mat4_transpose(&tInverseJoint);
+        }
+    }
+}
+
+// non uniform scales & arbitrary rotations on every transform
+static void
+ecs_test_scramble_transforms(plComponentLibrary* ptLibrary)
+{
+    plTransformComponent* sbtTransforms = ptLibrary->tTransformComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtTransforms); i++)
+    {
+        sbtTransforms[i].tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f, 1.0f));
+        sbtTransforms[i].tScale = pl_create_vec3(0.5f + ecs_test_rand(), 0.5f + ecs_test_rand(), 0.5f + ecs_test_rand());
+    }
+}
+
+// skinned object with an 8 joint chain & uVertexCount random vertices (4 random
+// joints each, every 17th vertex unweighted); tangents, uvs & colors only when
+// bAllAttributes
+static plEntity
+ecs_test_add_skinned_mesh(plComponentLibrary* ptLibrary, uint32_t uVertexCount, bool bAllAttributes)
+{
+    plEntity atJoints[8] = {0};
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        plTransformComponent* ptTransform = NULL;
+        atJoints[i] = gptECS->create_transform(ptLibrary, NULL, &ptTransform);
+        ptTransform->tTranslation = pl_create_vec3(0.0f, 1.0f, 0.0f);
+        ptTransform->tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand() * 0.5f, ecs_test_rand() * 0.3f, 0.0f, 1.0f));
+        ptTransform->tScale = pl_create_vec3(1.0f, 1.0f + ecs_test_rand() * 0.2f, 1.0f);
+        if(i > 0)
+            gptECS->attach_component(ptLibrary, atJoints[i], atJoints[i - 1]);
+    }
+
+    plEntity tObject = gptECS->create_object(ptLibrary, NULL, NULL);
+    plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tObject);
+    ptTransform->tTranslation = pl_create_vec3(ecs_test_rand() * 10.0f, 0.0f, ecs_test_rand() * 10.0f);
+    plSkinComponent* ptSkin = NULL;
+    plEntity tSkin = gptECS->create_skin(ptLibrary, NULL, &ptSkin);
+    ptSkin->tMeshNode = tObject;
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        pl_sb_push(ptSkin->sbtJoints, atJoints[i]);
+        pl_sb_push(ptSkin->sbtInverseBindMatrices, pl_mat4_translate_xyz(0.0f, -(float)(i + 1), 0.0f));
+        pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+        pl_sb_push(ptSkin->sbtTextureData, pl_identity_mat4());
+    }
+
+    plMeshComponent* ptMesh = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_MESH, tObject);
+    ptMesh->tSkinComponent = tSkin;
+    for(uint32_t i = 0; i < uVertexCount; i++)
+    {
+        pl_sb_push(ptMesh->sbtVertexPositions, pl_create_vec3(ecs_test_rand() * 2.0f - 1.0f, ecs_test_rand() * 8.0f, ecs_test_rand() * 2.0f - 1.0f));
+        pl_sb_push(ptMesh->sbtVertexNormals, pl_norm_vec3(pl_create_vec3(ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f, ecs_test_rand() - 0.5f)));
+        if(bAllAttributes)
+        {
+            pl_sb_push(ptMesh->sbtVertexTangents, pl_create_vec4(1.0f, 0.0f, 0.0f, ecs_test_rand() < 0.5f ? -1.0f : 1.0f));
+            pl_sb_push(ptMesh->sbtVertexTextureCoordinates[0], pl_create_vec2(ecs_test_rand(), ecs_test_rand()));
+            pl_sb_push(ptMesh->sbtVertexColors[0], pl_create_vec4(ecs_test_rand(), ecs_test_rand(), ecs_test_rand(), 1.0f));
+        }
+        plVec4 tJoints = {0};
+        plVec4 tWeights = {0};
+        for(uint32_t j = 0; j < 4; j++)
+        {
+            tJoints.d[j] = (float)(uint32_t)(ecs_test_rand() * 8.0f);
+            tWeights.d[j] = i % 17 == 0 ? 0.0f : ecs_test_rand();
+        }
+        const float fWeightSum = tWeights.x + tWeights.y + tWeights.z + tWeights.w;
+        if(fWeightSum > 0.0f)
+            tWeights = pl_mul_vec4_scalarf(tWeights, 1.0f / fWeightSum);
+        pl_sb_push(ptMesh->sbtVertexJoints[0], tJoints);
+        pl_sb_push(ptMesh->sbtVertexWeights[0], tWeights);
+    }
+    return tObject;
+}
+
+// skin matrix exactly as shaders/skinning.comp builds it
+static plMat4
+ecs_test_reference_skin_matrix(const plMat4* atPalette, plVec4 tJoints, plVec4 tWeights)
+{
+    plMat4 tSkin = {0};
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        const plMat4* ptJoint = &atPalette[(int)tJoints.d[i] * 2];
+        for(uint32_t j = 0; j < 16; j++)
+            tSkin.d[j] += tWeights.d[i] * ptJoint->d[j];
+    }
+    const plMat4 tZero = {0};
+    if(memcmp(&tSkin, &tZero, sizeof(plMat4)) == 0)
+        return pl_identity_mat4();
+    return tSkin;
+}
+
+static plEntity
+ecs_test_add_joint(plComponentLibrary* ptLibrary, plVec3 tTranslation, plVec4 tRotation, plEntity tParent)
+{
+    plTransformComponent* ptTransform = NULL;
+    plEntity tEntity = gptECS->create_transform(ptLibrary, NULL, &ptTransform);
+    ptTransform->tTranslation = tTranslation;
+    ptTransform->tRotation = tRotation;
+    if(tParent.uIndex != UINT32_MAX)
+        gptECS->attach_component(ptLibrary, tEntity, tParent);
+    return tEntity;
+}
+
+static plInverseKinematicsComponent*
+ecs_test_add_ik(plComponentLibrary* ptLibrary, plEntity tEffector, plEntity tTarget, uint32_t uChainLength, uint32_t uIterations, plIKSolver tSolver)
+{
+    plInverseKinematicsComponent* ptIK = gptECS->add_component(ptLibrary, PL_COMPONENT_TYPE_INVERSE_KINEMATICS, tEffector);
+    ptIK->tTarget = tTarget;
+    ptIK->uChainLength = uChainLength;
+    ptIK->uIterationCount = uIterations;
+    ptIK->tSolver = tSolver;
+    ptIK->fTolerance = 1e-3f;
+    return ptIK;
+}
+
+static plVec3
+ecs_test_world_position(plComponentLibrary* ptLibrary, plEntity tEntity)
+{
+    const plTransformComponent* ptTransform = gptECS->get_component(ptLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+    return ptTransform->tWorld.col[3].xyz;
+}
+
+static float
+ecs_test_distance(plVec3 tA, plVec3 tB)
+{
+    return pl_length_vec3(pl_sub_vec3(tA, tB));
+}
+
+static void
+ecs_test_ik_frame(plComponentLibrary* ptLibrary, bool bSolve)
+{
+    gptECS->run_transform_update_system(ptLibrary);
+    gptECS->run_hierarchy_update_system(ptLibrary);
+    if(bSolve)
+        gptECS->run_inverse_kinematics_update_system(ptLibrary);
+}
+
+// dense arrays, entities, stretchy buffer contents & name lookups of two libraries
+// (runtime pointers ignored); returns the number of mismatches
+static uint32_t
+ecs_test_compare_libraries(plComponentLibrary* ptLibrary0, plComponentLibrary* ptLibrary1)
+{
+    uint32_t uMismatches = 0;
+    const uint32_t uEntityCount = pl_sb_size(ptLibrary0->sbtEntityGenerations);
+    const uint32_t uFreeCount = pl_sb_size(ptLibrary0->sbtEntityFreeIndices);
+    if(uEntityCount != pl_sb_size(ptLibrary1->sbtEntityGenerations) || uFreeCount != pl_sb_size(ptLibrary1->sbtEntityFreeIndices))
+        return 1;
+    if(memcmp(ptLibrary0->sbtEntityGenerations, ptLibrary1->sbtEntityGenerations, sizeof(uint32_t) * uEntityCount) != 0 ||
+        (uFreeCount > 0 && memcmp(ptLibrary0->sbtEntityFreeIndices, ptLibrary1->sbtEntityFreeIndices, sizeof(uint32_t) * uFreeCount) != 0))
+        uMismatches++;
+
+    static unsigned char aucComponent0[16384];
+    static unsigned char aucComponent1[16384];
+    plEcsSnapshotField atFields0[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    plEcsSnapshotField atFields1[PL__ECS_SNAPSHOT_MAX_FIELDS];
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        plComponentManager* ptManager0 = ptLibrary0->_ptManagers[i];
+        plComponentManager* ptManager1 = ptLibrary1->_ptManagers[i];
+        const uint32_t uCount = pl_sb_size(ptManager0->sbtEntities);
+        if(uCount != pl_sb_size(ptManager1->sbtEntities))
+        {
+            uMismatches++;
+            continue;
+        }
+        for(uint32_t j = 0; j < uCount; j++)
+        {
+            unsigned char* pucComponent0 = &((unsigned char*)ptManager0->pComponents)[ptManager0->szStride * j];
+            unsigned char* pucComponent1 = &((unsigned char*)ptManager1->pComponents)[ptManager1->szStride * j];
+            if(ptManager0->sbtEntities[j].ulData != ptManager1->sbtEntities[j].ulData ||
+                gptECS->get_component(ptLibrary1, i, ptManager0->sbtEntities[j]) != pucComponent1)
+                uMismatches++;
+
+            // buffer contents, then everything else with the pointers cleared
+            const uint32_t uFieldCount = pl__ecs_snapshot_fields(i, pucComponent0, atFields0);
+            pl__ecs_snapshot_fields(i, pucComponent1, atFields1);
+            for(uint32_t k = 0; k < uFieldCount; k++)
+            {
+                const uint32_t uSize = pl_sb_size(*atFields0[k].ppBuffer);
+                if(uSize != pl_sb_size(*atFields1[k].ppBuffer) ||
+                    (uSize > 0 && memcmp(*atFields0[k].ppBuffer, *atFields1[k].ppBuffer, (size_t)uSize * atFields0[k].uStride) != 0))
+                    uMismatches++;
+            }
+            memcpy(aucComponent0, pucComponent0, ptManager0->szStride);
+            memcpy(aucComponent1, pucComponent1, ptManager1->szStride);
+            pl__ecs_snapshot_fields(i, aucComponent0, atFields0);
+            pl__ecs_snapshot_fields(i, aucComponent1, atFields1);
+            for(uint32_t k = 0; k < uFieldCount; k++)
+            {
+                *atFields0[k].ppBuffer = NULL;
+                *atFields1[k].ppBuffer = NULL;
+            }
+            if(i == PL_COMPONENT_TYPE_ANIMATION)
+            {
+                ((plAnimationComponent*)aucComponent0)->_ptClip = NULL;
+                ((plAnimationComponent*)aucComponent1)->_ptClip = NULL;
+            }
+            if(memcmp(aucComponent0, aucComponent1, ptManager0->szStride) != 0)
+                uMismatches++;
+        }
+    }
+
+    const plTagComponent* sbtTags = ptLibrary0->tTagComponentManager.pComponents;
+    for(uint32_t i = 0; i < pl_sb_size(sbtTags); i++)
+    {
+        if(gptECS->get_entity(ptLibrary0, sbtTags[i].acName).ulData != gptECS->get_entity(ptLibrary1, sbtTags[i].acName).ulData)
+            uMismatches++;
+    }
+    return uMismatches;
+}
+
+// scene, skinned meshes, a compressed & an uncompressed clip, removed entities
+// & duplicate/unnamed tags
+static plEntity
+ecs_test_build_snapshot_scene(plComponentLibrary* ptLibrary, uint32_t uObjects, uint32_t uVertexCount)
+{
+    ecs_test_build_scene(ptLibrary, uObjects, 4);
+    for(uint32_t i = 0; i < 4; i++)
+        ecs_test_add_skinned_mesh(ptLibrary, uVertexCount, i % 2 == 0);
+    plEntity tCompressed = ecs_test_add_mocap_clip(ptLibrary, 12, 60, -1);
+    ecs_test_add_mocap_clip(ptLibrary, 12, 60, PL_ANIMATION_MODE_LINEAR);
+    const plAnimationCompressionDesc tDesc = {1e-3f, 2e-3f, 3e-3f};
+    gptECS->compress_animation(ptLibrary, tCompressed, &tDesc);
+
+    plMaterialComponent* ptMaterial = NULL;
+    gptECS->create_material(ptLibrary, "material", &ptMaterial);
+    strcpy(ptMaterial->atTextureMaps[0].acName, "texture.png");
+    gptECS->create_perspective_camera(ptLibrary, "camera", pl_create_vec3(0.0f, 1.0f, 2.0f), 1.0f, 1.5f, 0.1f, 100.0f, NULL);
+    gptECS->remove_entity(ptLibrary, gptECS->create_tag(ptLibrary, "removed"));
+    gptECS->create_tag(ptLibrary, "object 3");
+    gptECS->create_tag(ptLibrary, NULL);
+    return tCompressed;
+}
+
+static uint32_t
+ecs_test_rand_index(uint32_t uCount)
+{
+    const uint32_t uIndex = (uint32_t)(ecs_test_rand() * (float)uCount);
+    return uIndex < uCount ? uIndex : uCount - 1;
+}
+
+// signature rebuilt by probing every manager
+static plComponentMask
+ecs_test_brute_force_signature(plComponentLibrary* ptLibrary, uint32_t uIndex)
+{
+    plComponentMask tMask = 0;
+    for(uint32_t i = 0; i < PL_COMPONENT_TYPE_COUNT; i++)
+    {
+        if(pl_hm_has_key(ptLibrary->_ptManagers[i]->ptHashmap, uIndex))
+            tMask |= PL_COMPONENT_MASK(i);
+    }
+    return tMask;
+}
+
+// signatures, has/get component, filtered iteration & queries vs brute force
+static uint32_t
+ecs_test_signature_errors(plComponentLibrary* ptLibrary, plEcsQuery** aptQueries, uint32_t uQueryCount)
+{
+    uint32_t uErrors = 0;
+    const uint32_t uSlotCount = pl_sb_size(ptLibrary->sbtEntityGenerations);
+    if(pl_sb_size(ptLibrary->sbtEntitySignatures) != uSlotCount)
+        uErrors++;
+    for(uint32_t i = 0; i < uSlotCount; i++)
+    {
+        const plComponentMask tMask = ecs_test_brute_force_signature(ptLibrary, i);
+        const plEntity tEntity = {.uIndex = i, .uGeneration = ptLibrary->sbtEntityGenerations[i]};
+        const plEntity tStale = {.uIndex = i, .uGeneration = tEntity.uGeneration + 1};
+        if(ptLibrary->sbtEntitySignatures[i] != tMask || gptECS->get_signature(ptLibrary, tEntity) != tMask || gptECS->get_signature(ptLibrary, tStale) != 0)
+            uErrors++;
+        for(uint32_t j = 0; j < PL_COMPONENT_TYPE_COUNT; j++)
+        {
+            const bool bOwned = (tMask & PL_COMPONENT_MASK(j)) != 0;
+            if(gptECS->has_component(ptLibrary, j, tEntity) != bOwned || (gptECS->get_component(ptLibrary, j, tEntity) != NULL) != bOwned)
+                uErrors++;
+        }
+    }
+
+    // random required/excluded masks (first one unfiltered)
+    for(uint32_t uFilter = 0; uFilter < 20; uFilter++)
+    {
+        plComponentMask tRequired = 0;
+        plComponentMask tExcluded = 0;
+        for(uint32_t j = 0; uFilter > 0 && j < PL_COMPONENT_TYPE_COUNT; j++)
+        {
+            const float fRoll = ecs_test_rand();
+            if(fRoll < 0.125f)
+                tRequired |= PL_COMPONENT_MASK(j);
+            else if(fRoll < 0.25f)
+                tExcluded |= PL_COMPONENT_MASK(j);
+        }
+
+        uint32_t uExpected = 0;
+        for(uint32_t i = 0; i < uSlotCount; i++)
+        {
+            const plComponentMask tMask = ecs_test_brute_force_signature(ptLibrary, i);
+            if(tMask != 0 && (tMask & tRequired) == tRequired && (tMask & tExcluded) == 0)
+                uExpected++;
+        }
+        const uint32_t uCount = gptECS->get_entities_with(ptLibrary, tRequired, tExcluded, NULL, 0);
+        plEntity* atEntities = malloc(sizeof(plEntity) * (uCount + 1));
+        if(uCount != uExpected || gptECS->get_entities_with(ptLibrary, tRequired, tExcluded, atEntities, uCount) != uCount)
+            uErrors++;
+        for(uint32_t i = 0; i < uCount; i++)
+        {
+            const plComponentMask tMask = ecs_test_brute_force_signature(ptLibrary, atEntities[i].uIndex);
+            if(!gptECS->is_entity_valid(ptLibrary, atEntities[i]) || (tMask & tRequired) != tRequired || (tMask & tExcluded) != 0)
+                uErrors++;
+            if(i > 0 && atEntities[i - 1].uIndex == atEntities[i].uIndex)
+                uErrors++;
+        }
+
+        // truncated output keeps the total & the same leading entities
+        plEntity atTruncated[2] = {0};
+        if(uCount > 2 && (gptECS->get_entities_with(ptLibrary, tRequired, tExcluded, atTruncated, 2) != uCount ||
+            atTruncated[0].ulData != atEntities[0].ulData || atTruncated[1].ulData != atEntities[1].ulData))
+            uErrors++;
+        free(atEntities);
+    }
+
+    // cached queries (joined through signatures) still match brute force
+    for(uint32_t j = 0; j < uQueryCount; j++)
+    {
+        uint32_t uExpected = 0;
+        for(uint32_t i = 0; i < uSlotCount; i++)
+        {
+            if((ecs_test_brute_force_signature(ptLibrary, i) & aptQueries[j]->_tMask) == aptQueries[j]->_tMask)
+                uExpected++;
+        }
+        if(aptQueries[j]->uCount != uExpected || !ecs_test_query_matches(ptLibrary, aptQueries[j]))
+            uErrors++;
+    }
+    return uErrors;
+}
+
+// random adds/removes (including no-ops on stale handles & missing components)
+static void
+ecs_test_signature_churn(plComponentLibrary* ptLibrary, plEntity** psbtLive, uint32_t uOperations)
+{
+    for(uint32_t i = 0; i < uOperations; i++)
+    {
+        const float fAction = ecs_test_rand();
+        const uint32_t uLiveCount = pl_sb_size(*psbtLive);
+        if(fAction < 0.15f || uLiveCount == 0)
+        {
+            pl_sb_push(*psbtLive, gptECS->create_entity(ptLibrary));
+            continue;
+        }
+        const uint32_t uSlot = ecs_test_rand_index(uLiveCount);
+        const plEntity tEntity = (*psbtLive)[uSlot];
+        const plComponentType tType = (plComponentType)ecs_test_rand_index(PL_COMPONENT_TYPE_COUNT);
+        if(fAction < 0.55f)
+        {
+            if(tType != PL_COMPONENT_TYPE_SCRIPT && !pl_hm_has_key(ptLibrary->_ptManagers[tType]->ptHashmap, tEntity.uIndex))
+                gptECS->add_component(ptLibrary, tType, tEntity);
+        }
+        else if(fAction < 0.85f)
+            gptECS->remove_component(ptLibrary, tType, tEntity);
+        else if(fAction < 0.93f)
+        {
+            gptECS->remove_entity(ptLibrary, tEntity);
+            pl_sb_del_swap(*psbtLive, uSlot);
+        }
+        else
+        {
+            const plEntity tStale = {.uIndex = tEntity.uIndex, .uGeneration = tEntity.uGeneration + 1};
+            gptECS->add_component(ptLibrary, tType, tStale);
+            gptECS->remove_component(ptLibrary, tType, tStale);
+        }
+    }
+}
+
+// the same churn recorded into a command buffer & played back
+static void
+ecs_test_signature_command_churn(plComponentLibrary* ptLibrary, plEntity** psbtLive, uint32_t uOperations)
+{
+    const uint32_t uLiveCount = pl_sb_size(*psbtLive);
+    if(uLiveCount == 0)
+        return;
+    plEcsCommandBuffer* ptBuffer = gptECS->create_command_buffer(ptLibrary);
+    bool* abRemoved = calloc(uLiveCount, sizeof(bool));
+    for(uint32_t i = 0; i < uOperations; i++)
+    {
+        const float fAction = ecs_test_rand();
+        const uint32_t uSlot = ecs_test_rand_index(uLiveCount);
+        const plComponentType tType = (plComponentType)ecs_test_rand_index(PL_COMPONENT_TYPE_COUNT);
+        if(tType == PL_COMPONENT_TYPE_TAG || tType == PL_COMPONENT_TYPE_SCRIPT)
+            continue;
+        if(fAction < 0.4f)
+            gptECS->cmd_add_component(ptBuffer, tType, (*psbtLive)[uSlot]);
+        else if(fAction < 0.8f)
+            gptECS->cmd_remove_component(ptBuffer, tType, (*psbtLive)[uSlot]);
+        else
+        {
+            gptECS->cmd_remove_entity(ptBuffer, (*psbtLive)[uSlot]);
+            abRemoved[uSlot] = true;
+        }
+    }
+    gptECS->playback_command_buffers(ptLibrary, 1, &ptBuffer);
+    gptECS->cleanup_command_buffer(&ptBuffer);
+    for(uint32_t i = uLiveCount; i > 0; i--)
+    {
+        if(abRemoved[i - 1])
+            pl_sb_del_swap(*psbtLive, i - 1);
+    }
+    free(abRemoved);
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+archetype_systems_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scene(&tLibrary, 2000, 40);
+
+    plArchetypeStorage* ptStorage = gptECS->create_archetype_storage();
+    gptECS->archetype_import_library(ptStorage, &tLibrary);
+
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_skin_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+
+    gptECS->run_archetype_transform_update_system(ptStorage);
+    gptECS->run_archetype_hierarchy_update_system(ptStorage);
+    gptECS->run_archetype_skin_update_system(ptStorage);
+    gptECS->run_archetype_object_update_system(ptStorage);
+
+    // both backends produce the same world matrices & bounds
+    uint32_t uMismatches = 0;
+    const uint32_t uTransformCount = pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uTransformCount; i++)
+    {
+        const plEntity tEntity = tLibrary.tTransformComponentManager.sbtEntities[i];
+        const plTransformComponent* ptLibraryTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        const plTransformComponent* ptStorageTransform = gptECS->archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        if(ptStorageTransform == NULL || !ecs_test_matrices_near(&ptLibraryTransform->tWorld, &ptStorageTransform->tWorld, 1e-4f))
+            uMismatches++;
+    }
+    pl_test_expect_uint32_equal(uMismatches, 0, "world matrices");
+
+    uMismatches = 0;
+    const uint32_t uMeshCount = pl_sb_size(tLibrary.tMeshComponentManager.sbtEntities);
+    for(uint32_t i = 0; i < uMeshCount; i++)
+    {
+        const plEntity tEntity = tLibrary.tMeshComponentManager.sbtEntities[i];
+        const plMeshComponent* ptLibraryMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tEntity);
+        const plMeshComponent* ptStorageMesh = gptECS->archetype_get_component(ptStorage, PL_COMPONENT_TYPE_MESH, tEntity);
+        if(fabsf(ptLibraryMesh->tAABBFinal.tMax.x - ptStorageMesh->tAABBFinal.tMax.x) > 1e-3f ||
+            fabsf(ptLibraryMesh->tAABBFinal.tMin.y - ptStorageMesh->tAABBFinal.tMin.y) > 1e-3f)
+            uMismatches++;
+    }
+    pl_test_expect_uint32_equal(uMismatches, 0, "object bounds");
+
+    // queries visit every entity with the required components
+    uint32_t uQueried = 0;
+    plArchetypeIterator tIter = {0};
+    gptECS->archetype_query_begin(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM), 0, &tIter);
+    while(gptECS->archetype_query_next(&tIter))
+        uQueried += tIter.uCount;
+    pl_test_expect_uint32_equal(uQueried, uTransformCount, "query count");
+
+    gptECS->cleanup_archetype_storage(&ptStorage);
+    pl_test_expect_true(ptStorage == NULL, NULL);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+archetype_churn_test(void* pData)
+{
+    plArchetypeStorage* ptStorage = gptECS->create_archetype_storage();
+
+    // each entity stores its own index so moves between archetypes can be checked
+    plEntity* sbtEntities = NULL;
+    for(uint32_t i = 0; i < 3000; i++)
+    {
+        plEntity tEntity = gptECS->archetype_create_entity(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM));
+        plTransformComponent* ptTransform = gptECS->archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+        ptTransform->tTranslation.x = (float)tEntity.uIndex;
+        pl_sb_push(sbtEntities, tEntity);
+    }
+
+    uint32_t uStaleHandles = 0;
+    for(uint32_t i = 0; i < 20000; i++)
+    {
+        const uint32_t uSlot = (uint32_t)(ecs_test_rand() * (float)pl_sb_size(sbtEntities));
+        if(uSlot >= pl_sb_size(sbtEntities))
+            continue;
+        const plEntity tEntity = sbtEntities[uSlot];
+        const float fAction = ecs_test_rand();
+        if(fAction < 0.3f)
+            gptECS->archetype_add_component(ptStorage, PL_COMPONENT_TYPE_HIERARCHY, tEntity);
+        else if(fAction < 0.5f)
+            gptECS->archetype_remove_component(ptStorage, PL_COMPONENT_TYPE_HIERARCHY, tEntity);
+        else if(fAction < 0.6f)
+            gptECS->archetype_add_component(ptStorage, PL_COMPONENT_TYPE_MATERIAL, tEntity);
+        else if(fAction < 0.7f)
+        {
+            gptECS->archetype_remove_entity(ptStorage, tEntity);
+            if(gptECS->archetype_is_entity_valid(ptStorage, tEntity))
+                uStaleHandles++;
+            pl_sb_del_swap(sbtEntities, uSlot);
+        }
+        else
+        {
+            plEntity tNewEntity = gptECS->archetype_create_entity(ptStorage, PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM));
+            plTransformComponent* ptTransform = gptECS->archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, tNewEntity);
+            ptTransform->tTranslation.x = (float)tNewEntity.uIndex;
+            pl_sb_push(sbtEntities, tNewEntity);
+        }
+    }
+    pl_test_expect_uint32_equal(uStaleHandles, 0, "removed entities are invalid");
+
+    uint32_t uMismatches = 0;
+    for(uint32_t i = 0; i < pl_sb_size(sbtEntities); i++)
+    {
+        const plTransformComponent* ptTransform = gptECS->archetype_get_component(ptStorage, PL_COMPONENT_TYPE_TRANSFORM, sbtEntities[i]);
+        if(ptTransform == NULL || ptTransform->tTranslation.x != (float)sbtEntities[i].uIndex)
+            uMismatches++;
+    }
+    pl_test_expect_uint32_equal(uMismatches, 0, "component data survives moves");
+
+    pl_sb_free(sbtEntities);
+    gptECS->cleanup_archetype_storage(&ptStorage);
+}
+
+void
+cached_query_churn_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    ecs_test_build_scene(&tLibrary, 2000, 40);
+
+    const plComponentType atTypes[] = {PL_COMPONENT_TYPE_MESH, PL_COMPONENT_TYPE_TRANSFORM};
+    plEcsQuery* ptQuery = gptECS->create_query(&tLibrary, 2, atTypes);
+    plComponentLibraryData* ptData = tLibrary.pInternal;
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptQuery), "user query");
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptData->ptObjectQuery), "object query");
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptData->ptHierarchyQuery), "hierarchy query");
+
+    // random entity & component churn, checking every query along the way
+    plEntity* sbtEntities = NULL;
+    for(uint32_t i = 0; i < pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities); i++)
+        pl_sb_push(sbtEntities, tLibrary.tObjectComponentManager.sbtEntities[i]);
+
+    uint32_t uFailures = 0;
+    for(uint32_t i = 0; i < 20000; i++)
+    {
+        const float fAction = ecs_test_rand();
+        const uint32_t uSlot = (uint32_t)(ecs_test_rand() * (float)pl_sb_size(sbtEntities));
+        const bool bValidSlot = uSlot < pl_sb_size(sbtEntities);
+        if(fAction < 0.35f && bValidSlot)
+        {
+            gptECS->remove_entity(&tLibrary, sbtEntities[uSlot]);
+            pl_sb_del_swap(sbtEntities, uSlot);
+        }
+        else if(fAction < 0.6f)
+        {
+            plEntity tEntity = gptECS->create_entity(&tLibrary);
+            gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+            if(ecs_test_rand() < 0.5f)
+            {
+                gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tEntity);
+                if(ecs_test_rand() < 0.5f)
+                {
+                    plObjectComponent* ptObject = gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_OBJECT, tEntity);
+                    ptObject->tMesh = tEntity;
+                    ptObject->tTransform = tEntity;
+                }
+            }
+            pl_sb_push(sbtEntities, tEntity);
+        }
+        else if(fAction < 0.8f && bValidSlot)
+        {
+            if(!pl_hm_has_key(tLibrary.tMeshComponentManager.ptHashmap, sbtEntities[uSlot].uIndex))
+                gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtEntities[uSlot]);
+        }
+        else if(bValidSlot && pl_sb_size(sbtEntities) > 1)
+            gptECS->attach_component(&tLibrary, sbtEntities[uSlot], sbtEntities[(uSlot + 1) % pl_sb_size(sbtEntities)]);
+
+        if(i % 500 == 0 &&
+            !(ecs_test_query_matches(&tLibrary, ptQuery) &&
+              ecs_test_query_matches(&tLibrary, ptData->ptObjectQuery) &&
+              ecs_test_query_matches(&tLibrary, ptData->ptHierarchyQuery)))
+            uFailures++;
+    }
+    pl_test_expect_uint32_equal(uFailures, 0, "queries track churn");
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptQuery), "user query after churn");
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptData->ptObjectQuery), "object query after churn");
+    pl_test_expect_true(ecs_test_query_matches(&tLibrary, ptData->ptHierarchyQuery), "hierarchy query after churn");
+
+    // systems still run on the churned library
+    gptECS->run_transform_update_system(&tLibrary);
+    gptECS->run_hierarchy_update_system(&tLibrary);
+    gptECS->run_object_update_system(&tLibrary);
+
+    pl_sb_free(sbtEntities);
+    gptECS->cleanup_query(&tLibrary, &ptQuery);
+    pl_test_expect_true(ptQuery == NULL, NULL);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+dirty_propagation_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 3;
+    ecs_test_build_scene(&tLibrary, 2000, 40);
+
+    plMat4* sbtPreviousWorlds = NULL;
+    plAABB* sbtPreviousBounds = NULL;
+    uint32_t uWrongWorlds = 0;
+    uint32_t uWrongBounds = 0;
+    uint32_t uMissingBits = 0;
+    for(uint32_t uFrame = 0; uFrame < 200; uFrame++)
+    {
+        // move a few transforms & change the hierarchy, meshes & entity set
+        plTransformComponent* sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+        const uint32_t uTransformCount = pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities);
+        const uint32_t uObjectCount = pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities);
+        const plEntity tObject0 = tLibrary.tObjectComponentManager.sbtEntities[(uint32_t)(ecs_test_rand() * (float)uObjectCount) % uObjectCount];
+        const plEntity tObject1 = tLibrary.tObjectComponentManager.sbtEntities[(uint32_t)(ecs_test_rand() * (float)uObjectCount) % uObjectCount];
+        for(uint32_t i = 0; i < 20; i++)
+            sbtTransforms[(uint32_t)(ecs_test_rand() * (float)uTransformCount) % uTransformCount].tTranslation.x += 1.0f;
+        sbtTransforms[(uint32_t)(ecs_test_rand() * (float)uTransformCount) % uTransformCount].tRotation = pl_norm_vec4(pl_create_vec4(ecs_test_rand(), ecs_test_rand(), 0.0f, 1.0f));
+        if(uFrame % 3 == 0)
+            ((plMeshComponent*)gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tObject0))->tAABB.tMax.y += 1.0f;
+        if(uFrame % 4 == 1 && tObject0.uIndex < tObject1.uIndex)
+            gptECS->attach_component(&tLibrary, tObject1, tObject0);
+        if(uFrame % 5 == 2)
+            gptECS->deattach_component(&tLibrary, tObject0);
+        if(uFrame % 7 == 3 && gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_HIERARCHY, tObject0) == NULL &&
+            ((plMeshComponent*)gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tObject0))->tSkinComponent.uIndex == UINT32_MAX)
+            gptECS->remove_entity(&tLibrary, tObject0);
+        if(uFrame % 6 == 4)
+        {
+            plEntity tEntity = gptECS->create_object(&tLibrary, "new object", NULL);
+            ((plMeshComponent*)gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tEntity))->tAABB.tMax = pl_create_vec3(1.0f, 1.0f, 1.0f);
+        }
+
+        gptECS->run_transform_update_system(&tLibrary);
+        gptECS->run_hierarchy_update_system(&tLibrary);
+        gptECS->run_skin_update_system(&tLibrary);
+        gptECS->run_object_update_system(&tLibrary);
+
+        // tracked results match a from scratch evaluation
+        sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+        uint32_t uBitCount = 0;
+        const uint64_t* auTransformBits = gptECS->get_changed_bitset(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, &uBitCount);
+        for(uint32_t i = 0; i < pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities); i++)
+        {
+            const plMat4 tReference = ecs_test_reference_world(&tLibrary, tLibrary.tTransformComponentManager.sbtEntities[i]);
+            if(!ecs_test_matrices_near(&tReference, &sbtTransforms[i].tWorld, 1e-3f))
+                uWrongWorlds++;
+
+            // every world matrix that changed since last frame is flagged
+            if(uFrame > 0 && i < pl_sb_size(sbtPreviousWorlds) && memcmp(&sbtPreviousWorlds[i], &sbtTransforms[i].tWorld, sizeof(plMat4)) != 0 &&
+                !pl__ecs_bit_test(auTransformBits, i))
+                uMissingBits++;
+        }
+        pl_sb_resize(sbtPreviousWorlds, pl_sb_size(tLibrary.tTransformComponentManager.sbtEntities));
+        for(uint32_t i = 0; i < pl_sb_size(sbtPreviousWorlds); i++)
+            sbtPreviousWorlds[i] = sbtTransforms[i].tWorld;
+
+        const uint64_t* auObjectBits = gptECS->get_changed_bitset(&tLibrary, PL_COMPONENT_TYPE_OBJECT, &uBitCount);
+        const plObjectComponent* sbtObjects = tLibrary.tObjectComponentManager.pComponents;
+        for(uint32_t i = 0; i < pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities); i++)
+        {
+            const plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, sbtObjects[i].tTransform);
+            const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh);
+            plMat4 tWorld = ptTransform->tWorld;
+            const plSkinComponent* ptSkin = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_SKIN, ptMesh->tSkinComponent);
+            if(ptSkin)
+            {
+                const plTransformComponent* ptJoint = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, ptSkin->sbtJoints[0]);
+                tWorld = pl_mul_mat4(&ptJoint->tWorld, &ptSkin->sbtInverseBindMatrices[0]);
+            }
+            const plAABB tReference = pl__ecs_transform_aabb(&ptMesh->tAABB, &tWorld);
+            if(memcmp(&tReference, &ptMesh->tAABBFinal, sizeof(plAABB)) != 0)
+                uWrongBounds++;
+
+            if(uFrame > 0 && i < pl_sb_size(sbtPreviousBounds) && memcmp(&sbtPreviousBounds[i], &ptMesh->tAABBFinal, sizeof(plAABB)) != 0 &&
+                !pl__ecs_bit_test(auObjectBits, i))
+                uMissingBits++;
+        }
+        pl_sb_resize(sbtPreviousBounds, pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities));
+        for(uint32_t i = 0; i < pl_sb_size(sbtPreviousBounds); i++)
+            sbtPreviousBounds[i] = ((plMeshComponent*)gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh))->tAABBFinal;
+    }
+    pl_test_expect_uint32_equal(uWrongWorlds, 0, "world matrices");
+    pl_test_expect_uint32_equal(uWrongBounds, 0, "object bounds");
+    pl_test_expect_uint32_equal(uMissingBits, 0, "changed bitsets");
+
+    pl_sb_free(sbtPreviousWorlds);
+    pl_sb_free(sbtPreviousBounds);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+void
+run_systems_test(void* pData)
+{
+    // "run_systems" matches calling each system by hand in frame order
+    plComponentLibrary atLibraries[2] = {0};
+    for(uint32_t i = 0; i < 2; i++)
+    {
+        gptECS->init_component_library(&atLibraries[i]);
+        guEcsTestSeed = 47;
+        ecs_test_build_snapshot_scene(&atLibraries[i], 100, 32);
+    }
+
+    for(uint32_t uFrame = 0; uFrame < 8; uFrame++)
+    {
+        gptECS->run_systems(&atLibraries[0], 0.05f);
+
+        plComponentLibrary* ptLibrary = &atLibraries[1];
+        gptECS->run_script_update_system(ptLibrary);
+        gptECS->run_animation_update_system(ptLibrary, 0.05f);
+        gptECS->run_blend_tree_system(ptLibrary, 0.05f);
+        gptECS->run_transform_update_system(ptLibrary);
+        gptECS->run_hierarchy_update_system(ptLibrary);
+        gptECS->run_inverse_kinematics_update_system(ptLibrary);
+        gptECS->run_skin_update_system(ptLibrary);
+        gptECS->run_object_update_system(ptLibrary);
+    }
+    pl_test_expect_uint32_equal(ecs_test_compare_libraries(&atLibraries[0], &atLibraries[1]), 0, "manual sequence mismatches");
+
+    for(uint32_t i = 0; i < 2; i++)
+        gptECS->cleanup_component_library(&atLibraries[i]);
+}
+
+void
+signature_churn_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 49;
+
+    const plComponentType atTypes0[] = {PL_COMPONENT_TYPE_TRANSFORM, PL_COMPONENT_TYPE_MESH};
+    const plComponentType atTypes1[] = {PL_COMPONENT_TYPE_CAMERA};
+    plEcsQuery* aptQueries[2] = {
+        gptECS->create_query(&tLibrary, 2, atTypes0),
+        gptECS->create_query(&tLibrary, 1, atTypes1)
+    };
+    pl_test_expect_uint32_equal(ecs_test_signature_errors(&tLibrary, aptQueries, 2), 0, "empty library");
+
+    plEntity* sbtLive = NULL;
+    uint32_t uErrors = 0;
+    for(uint32_t uRound = 0; uRound < 20; uRound++)
+    {
+        ecs_test_signature_churn(&tLibrary, &sbtLive, 2000);
+        uErrors += ecs_test_signature_errors(&tLibrary, aptQueries, 2);
+        if(uRound % 4 == 3)
+        {
+            ecs_test_signature_command_churn(&tLibrary, &sbtLive, 500);
+            uErrors += ecs_test_signature_errors(&tLibrary, aptQueries, 2);
+        }
+    }
+    pl_test_expect_uint32_equal(uErrors, 0, "signatures after churn");
+    pl_test_expect_true(pl_sb_size(sbtLive) > 100, "churn keeps live entities");
+
+    // query created late (initial join reads signatures)
+    const plComponentType atTypes2[] = {PL_COMPONENT_TYPE_LIGHT, PL_COMPONENT_TYPE_TAG};
+    plEcsQuery* ptLateQuery = gptECS->create_query(&tLibrary, 2, atTypes2);
+    pl_test_expect_uint32_equal(ecs_test_signature_errors(&tLibrary, &ptLateQuery, 1), 0, "late query");
+
+    // snapshots rebuild signatures
+    size_t szSize = 0;
+    gptECS->save_snapshot(&tLibrary, NULL, &szSize);
+    unsigned char* pucSnapshot = malloc(szSize);
+    pl_test_expect_true(gptECS->save_snapshot(&tLibrary, pucSnapshot, &szSize), "save");
+    plComponentLibrary tLoaded = {0};
+    gptECS->init_component_library(&tLoaded);
+    pl_test_expect_true(gptECS->load_snapshot(&tLoaded, pucSnapshot, szSize), "load");
+    pl_test_expect_true(pl_sb_size(tLoaded.sbtEntitySignatures) == pl_sb_size(tLibrary.sbtEntitySignatures) &&
+        memcmp(tLoaded.sbtEntitySignatures, tLibrary.sbtEntitySignatures, sizeof(plComponentMask) * pl_sb_size(tLibrary.sbtEntitySignatures)) == 0, "loaded signatures");
+    pl_test_expect_uint32_equal(ecs_test_signature_errors(&tLoaded, NULL, 0), 0, "loaded library");
+
+    // archetype import places entities by signature
+    plArchetypeStorage* ptStorage = gptECS->create_archetype_storage();
+    gptECS->archetype_import_library(ptStorage, &tLibrary);
+    uint32_t uArchetypeErrors = 0;
+    for(uint32_t i = 0; i < pl_sb_size(tLibrary.sbtEntityGenerations); i++)
+    {
+        const plEntity tEntity = {.uIndex = i, .uGeneration = tLibrary.sbtEntityGenerations[i]};
+        const plComponentMask tMask = gptECS->get_signature(&tLibrary, tEntity);
+        for(uint32_t j = 0; tMask != 0 && j < PL_COMPONENT_TYPE_COUNT; j++)
+        {
+            if(((tMask & PL_COMPONENT_MASK(j)) != 0) != (gptECS->archetype_get_component(ptStorage, j, tEntity) != NULL))
+                uArchetypeErrors++;
+        }
+    }
+    pl_test_expect_uint32_equal(uArchetypeErrors, 0, "archetype import");
+    gptECS->cleanup_archetype_storage(&ptStorage);
+
+    // removed slots own nothing until reused
+    const plEntity tEntity = gptECS->create_entity(&tLibrary);
+    gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tEntity);
+    gptECS->add_component(&tLibrary, PL_COMPONENT_TYPE_LIGHT, tEntity);
+    pl_test_expect_true(gptECS->get_signature(&tLibrary, tEntity) == (PL_COMPONENT_MASK(PL_COMPONENT_TYPE_TRANSFORM) | PL_COMPONENT_MASK(PL_COMPONENT_TYPE_LIGHT)), "signature");
+    gptECS->remove_entity(&tLibrary, tEntity);
+    pl_test_expect_true(tLibrary.sbtEntitySignatures[tEntity.uIndex] == 0 && gptECS->get_signature(&tLibrary, tEntity) == 0, "removed entity");
+    const plEntity tReused = gptECS->create_entity(&tLibrary);
+    pl_test_expect_true(tReused.uIndex == tEntity.uIndex && gptECS->get_signature(&tLibrary, tReused) == 0, "reused slot");
+    const plEntity tOutOfRange = {.uIndex = 1u << 30};
+    pl_test_expect_true(gptECS->get_signature(&tLibrary, tOutOfRange) == 0 && !gptECS->has_component(&tLibrary, PL_COMPONENT_TYPE_TAG, tOutOfRange), "out of range entity");
+
+    free(pucSnapshot);
+    pl_sb_free(sbtLive);
+    gptECS->cleanup_query(&tLibrary, &ptLateQuery);
+    gptECS->cleanup_query(&tLibrary, &aptQueries[0]);
+    gptECS->cleanup_query(&tLibrary, &aptQueries[1]);
+    gptECS->cleanup_component_library(&tLoaded);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_ecs_tests(void* pData)
+{
+    pl_test_register_test(archetype_systems_test, NULL);
+    pl_test_register_test(archetype_churn_test, NULL);
+    pl_test_register_test(cached_query_churn_test, NULL);
+    pl_test_register_test(dirty_propagation_test, NULL);
+    pl_test_register_test(run_systems_test, NULL);
+    pl_test_register_test(signature_churn_test, NULL);
+}
@@ -1,11 +1,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>  // NAN
+#include <float.h> // FLT_MAX
 #include "pl_test.h"
 
 #include <stdint.h>
 #include "pl_json.h"
 
+#ifdef _WIN32
+    #include <windows.h> // FindFirstFileA
+#else
+    #include <dirent.h> // opendir
+#endif
+
 void
 write_json_test(void* pData)
 {
@@ -170,6 +178,668 @@ read_json_test(void* pData)
 
 }
 
+void
+read_json_text_test(void* pData)
+{
+    const char* pcJson = 
+        "{\n"
+        "   \"name\": \"scene\",\n"
+        "   \"nam\": \"prefix\",\n"
+        "   \"visible\": true,\n"
+        "   \"parent\": null,\n"
+        "   \"scale\": 2.5,\n"
+        "   \"tags\": [\"a\", \"bc\", \"def\"],\n"
+        "   \"matrix\": [[1, 2], [3, 4]],\n"
+        "   \"nodes\": [{\"id\": 7}, {\"id\": 8, \"children\": []}],\n"
+        "   \"empty\": {}\n"
+        "}";
+
+    plJsonObject* ptRootJsonObject = NULL;
+    pl_test_expect_true(pl_load_json(pcJson, &ptRootJsonObject), NULL);
+
+    // member names are matched exactly, not by prefix
+    char acName[64] = {0};
+    pl_test_expect_string_equal(pl_json_string_member(ptRootJsonObject, "name", acName, 64), "scene", NULL);
+    pl_test_expect_string_equal(pl_json_string_member(ptRootJsonObject, "nam", acName, 64), "prefix", NULL);
+    pl_test_expect_false(pl_json_member_exist(ptRootJsonObject, "na"), NULL);
+    pl_test_expect_true(pl_json_bool_member(ptRootJsonObject, "visible", false), NULL);
+    pl_test_expect_float_near_equal(pl_json_float_member(ptRootJsonObject, "scale", 0.0f), 2.5f, 0.0001f, NULL);
+    pl_test_expect_int_equal(pl_json_get_type(pl_json_member_by_index(ptRootJsonObject, 3)), PL_JSON_TYPE_NULL, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "missing", -1), -1, NULL);
+
+    // member list
+    uint32_t uMemberCount = 0;
+    uint32_t uMaxLength = 0;
+    pl_json_member_list(ptRootJsonObject, NULL, &uMemberCount, &uMaxLength);
+    pl_test_expect_uint32_equal(uMemberCount, 9, NULL);
+    pl_test_expect_uint32_equal(uMaxLength, 7, NULL);
+
+    // string array
+    uint32_t uTagCount = 0;
+    plJsonObject* ptTags = pl_json_array_member(ptRootJsonObject, "tags", &uTagCount);
+    pl_test_expect_uint32_equal(uTagCount, 3, NULL);
+    pl_test_expect_string_equal(pl_json_as_string(pl_json_member_by_index(ptTags, 2)), "def", NULL);
+
+    // nested arrays
+    uint32_t uRowCount = 0;
+    plJsonObject* ptMatrix = pl_json_array_member(ptRootJsonObject, "matrix", &uRowCount);
+    pl_test_expect_uint32_equal(uRowCount, 2, NULL);
+    int aiRow[2] = {0};
+    pl_json_as_int_array(pl_json_member_by_index(ptMatrix, 1), aiRow, NULL);
+    pl_test_expect_int_equal(aiRow[0], 3, NULL);
+    pl_test_expect_int_equal(aiRow[1], 4, NULL);
+
+    // array of objects
+    uint32_t uNodeCount = 0;
+    plJsonObject* ptNodes = pl_json_array_member(ptRootJsonObject, "nodes", &uNodeCount);
+    pl_test_expect_uint32_equal(uNodeCount, 2, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(pl_json_member_by_index(ptNodes, 0), "id", 0), 7, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(pl_json_member_by_index(ptNodes, 1), "id", 0), 8, NULL);
+    uint32_t uChildCount = 1;
+    pl_json_array_member(pl_json_member_by_index(ptNodes, 1), "children", &uChildCount);
+    pl_test_expect_uint32_equal(uChildCount, 0, NULL);
+
+    uint32_t uEmptyCount = 1;
+    pl_json_member_list(pl_json_member(ptRootJsonObject, "empty"), NULL, &uEmptyCount, NULL);
+    pl_test_expect_uint32_equal(uEmptyCount, 0, NULL);
+
+    pl_unload_json(&ptRootJsonObject);
+}
+
+void
+read_json_large_object_test(void* pData)
+{
+    // enough members to use the hashed member index
+    const uint32_t uMemberCount = 1000;
+    char* pcJson = malloc(uMemberCount * 32 + 16);
+    uint32_t uCursor = 0;
+    pcJson[uCursor++] = '{';
+    for(uint32_t i = 0; i < uMemberCount; i++)
+        uCursor += sprintf(&pcJson[uCursor], "%s\"member_%u\": %u", i == 0 ? "" : ", ", i, i * 3);
+    pcJson[uCursor++] = '}';
+    pcJson[uCursor] = 0;
+
+    plJsonObject* ptRootJsonObject = NULL;
+    pl_load_json(pcJson, &ptRootJsonObject);
+    free(pcJson);
+
+    bool bAllFound = true;
+    for(uint32_t i = 0; i < uMemberCount; i++)
+    {
+        char acName[32] = {0};
+        sprintf(acName, "member_%u", i);
+        if(pl_json_uint_member(ptRootJsonObject, acName, UINT32_MAX) != i * 3)
+            bAllFound = false;
+    }
+    pl_test_expect_true(bAllFound, NULL);
+    pl_test_expect_false(pl_json_member_exist(ptRootJsonObject, "member_"), NULL);
+    pl_test_expect_false(pl_json_member_exist(ptRootJsonObject, "member_1000"), NULL);
+
+    // adding to a loaded object invalidates the index
+    pl_json_add_int_member(ptRootJsonObject, "member_1000", 42);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "member_1000", 0), 42, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "member_999", 0), 2997, NULL);
+
+    // round trip through writer
+    uint32_t uBufferSize = 0;
+    pl_write_json(ptRootJsonObject, NULL, &uBufferSize);
+    char* pcBuffer = malloc(uBufferSize + 1);
+    memset(pcBuffer, 0, uBufferSize + 1);
+    pl_write_json(ptRootJsonObject, pcBuffer, &uBufferSize);
+    pl_unload_json(&ptRootJsonObject);
+
+    pl_load_json(pcBuffer, &ptRootJsonObject);
+    free(pcBuffer);
+    uint32_t uSize = 0;
+    pl_json_member_list(ptRootJsonObject, NULL, &uSize, NULL);
+    pl_test_expect_uint32_equal(uSize, uMemberCount + 1, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "member_1000", 0), 42, NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "member_500", 0), 1500, NULL);
+    pl_unload_json(&ptRootJsonObject);
+}
+
+// JSONTestSuite style inputs under tests/json_conformance/ (y_ must parse, n_ must fail,
+// i_ implementation defined & listed below with our result); path is relative to out/
+#ifndef PL_JSON_CONFORMANCE_DIR
+    #define PL_JSON_CONFORMANCE_DIR "../tests/json_conformance/"
+#endif
+
+#define PL_JSON_CONFORMANCE_MAX_FILES 512
+
+typedef struct _plJsonImplementationDefinedCase
+{
+    const char* pcFile;
+    bool        bValid;
+} plJsonImplementationDefinedCase;
+
+static const plJsonImplementationDefinedCase gatJsonImplementationDefinedCases[] = {
+    {"i_string_1st_surrogate_but_2nd_missing.json", true},
+    {"i_string_invalid_utf-8.json",                 false},
+    {"i_string_overlong_sequence_2_bytes.json",     false},
+    {"i_structure_UTF-8_BOM_empty_object.json",     false},
+};
+
+static int
+pl__json_compare_file_names(const void* pA, const void* pB)
+{
+    return strcmp(*(const char* const*)pA, *(const char* const*)pB);
+}
+
+static bool
+pl__json_is_conformance_file(const char* pcName)
+{
+    const size_t szLength = strlen(pcName);
+    if(szLength < 7 || pcName[1] != '_' || strcmp(&pcName[szLength - 5], ".json") != 0)
+        return false;
+    return pcName[0] == 'y' || pcName[0] == 'n' || pcName[0] == 'i';
+}
+
+// fills ppcNamesOut with malloc'd file names (sorted) & returns the count
+static uint32_t
+pl__json_list_conformance_files(char** ppcNamesOut, uint32_t uMaxNames)
+{
+    uint32_t uCount = 0;
+
+    #ifdef _WIN32
+        WIN32_FIND_DATAA tFindData = {0};
+        HANDLE tFind = FindFirstFileA(PL_JSON_CONFORMANCE_DIR "*.json", &tFindData);
+        if(tFind == INVALID_HANDLE_VALUE)
+            return 0;
+        do
+        {
+            if(uCount < uMaxNames && pl__json_is_conformance_file(tFindData.cFileName))
+                ppcNamesOut[uCount++] = _strdup(tFindData.cFileName);
+        } while(FindNextFileA(tFind, &tFindData));
+        FindClose(tFind);
+    #else
+        DIR* ptDir = opendir(PL_JSON_CONFORMANCE_DIR);
+        if(ptDir == NULL)
+            return 0;
+        struct dirent* ptEntry = NULL;
+        while((ptEntry = readdir(ptDir)) != NULL)
+        {
+            if(uCount < uMaxNames && pl__json_is_conformance_file(ptEntry->d_name))
+                ppcNamesOut[uCount++] = strdup(ptEntry->d_name);
+        }
+        closedir(ptDir);
+    #endif
+
+    qsort(ppcNamesOut, uCount, sizeof(char*), pl__json_compare_file_names);
+    return uCount;
+}
+
+// returns a malloc'd, null terminated copy of the file (NULL on failure)
+static char*
+pl__json_read_conformance_file(const char* pcName)
+{
+    char acPath[512] = {0};
+    snprintf(acPath, sizeof(acPath), "%s%s", PL_JSON_CONFORMANCE_DIR, pcName);
+    FILE* ptFile = fopen(acPath, "rb");
+    if(ptFile == NULL)
+        return NULL;
+    fseek(ptFile, 0, SEEK_END);
+    const long lSize = ftell(ptFile);
+    fseek(ptFile, 0, SEEK_SET);
+    char* pcBuffer = malloc((size_t)lSize + 1);
+    const size_t szRead = fread(pcBuffer, 1, (size_t)lSize, ptFile);
+    pcBuffer[szRead] = 0;
+    fclose(ptFile);
+    return pcBuffer;
+}
+
+void
+json_conformance_test(void* pData)
+{
+    char* apcFiles[PL_JSON_CONFORMANCE_MAX_FILES] = {0};
+    const uint32_t uFileCount = pl__json_list_conformance_files(apcFiles, PL_JSON_CONFORMANCE_MAX_FILES);
+    pl_test_expect_true(uFileCount > 0, "conformance corpus found at " PL_JSON_CONFORMANCE_DIR);
+
+    const uint32_t uImplementationDefinedCount = sizeof(gatJsonImplementationDefinedCases) / sizeof(gatJsonImplementationDefinedCases[0]);
+    for(uint32_t i = 0; i < uFileCount; i++)
+    {
+        const char* pcName = apcFiles[i];
+        char* pcJson = pl__json_read_conformance_file(pcName);
+        if(!pl_test_expect_true(pcJson != NULL, pcName))
+        {
+            free(apcFiles[i]);
+            continue;
+        }
+
+        bool bValid = pcName[0] == 'y';
+        if(pcName[0] == 'i')
+        {
+            bool bListed = false;
+            for(uint32_t j = 0; j < uImplementationDefinedCount; j++)
+            {
+                if(strcmp(gatJsonImplementationDefinedCases[j].pcFile, pcName) == 0)
+                {
+                    bValid = gatJsonImplementationDefinedCases[j].bValid;
+                    bListed = true;
+                    break;
+                }
+            }
+            pl_test_expect_true(bListed, pcName); // new i_ files need an entry above
+        }
+
+        plJsonObject* ptRootJsonObject = NULL;
+        const bool bResult = pl_load_json(pcJson, &ptRootJsonObject);
+        if(bValid)
+            pl_test_expect_true(bResult, pcName);
+        else
+            pl_test_expect_false(bResult, pcName);
+        if(ptRootJsonObject)
+            pl_unload_json(&ptRootJsonObject);
+        free(pcJson);
+        free(apcFiles[i]);
+    }
+
+    // nesting limit
+    char acNested[2 * 1100 + 1] = {0};
+    for(uint32_t i = 0; i < 1100; i++)
+    {
+        acNested[i] = '[';
+        acNested[2 * 1100 - 1 - i] = ']';
+    }
+    plJsonObject* ptRootJsonObject = NULL;
+    pl_test_expect_false(pl_load_json(acNested, &ptRootJsonObject), "i_structure_1100_nested_arrays");
+    pl_test_expect_true(pl_parse_json(&acNested[1100 - 500], 1000, &ptRootJsonObject), "i_structure_500_nested_arrays");
+    pl_unload_json(&ptRootJsonObject);
+}
+
+void
+json_block_boundary_test(void* pData)
+{
+    // escapes & quotes straddling the 64 byte stage 1 blocks
+    char acJson[300] = {0};
+    char acExpected[256] = {0};
+    bool bAllPassed = true;
+    for(uint32_t uPadding = 0; uPadding < 140; uPadding++)
+    {
+        // even backslash run followed by an escaped quote
+        memset(acExpected, 0, sizeof(acExpected));
+        memset(acExpected, 'a', uPadding);
+        strcat(acExpected, "\\\\\\\"b");
+        snprintf(acJson, 300, "[\"%s\", 1]", acExpected);
+
+        plJsonObject* ptRootJsonObject = NULL;
+        if(!pl_load_json(acJson, &ptRootJsonObject))
+        {
+            bAllPassed = false;
+            continue;
+        }
+        if(strcmp(pl_json_as_string(pl_json_member_by_index(ptRootJsonObject, 0)), acExpected) != 0)
+            bAllPassed = false;
+        if(pl_json_as_int(pl_json_member_by_index(ptRootJsonObject, 1)) != 1)
+            bAllPassed = false;
+        pl_unload_json(&ptRootJsonObject);
+
+        // odd backslash run escapes the closing quote
+        snprintf(acJson, 300, "[\"%.*s\\\"]", uPadding, acExpected);
+        if(pl_load_json(acJson, &ptRootJsonObject))
+        {
+            bAllPassed = false;
+            pl_unload_json(&ptRootJsonObject);
+        }
+    }
+    pl_test_expect_true(bAllPassed, NULL);
+}
+
+void
+json_ndjson_test(void* pData)
+{
+    const char* pcJson = "{\"id\": 0}\n\n{\"id\": 1, \"name\": \"one\"}\r\n[2]\n{\"id\": }\n{\"id\": 4}";
+    const size_t szLength = strlen(pcJson);
+
+    size_t szCursor = 0;
+    plJsonObject* ptRootJsonObject = NULL;
+
+    pl_test_expect_true(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "id", -1), 0, NULL);
+    pl_unload_json(&ptRootJsonObject);
+
+    pl_test_expect_true(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "id", -1), 1, NULL);
+    pl_unload_json(&ptRootJsonObject);
+
+    pl_test_expect_true(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_int_equal(pl_json_as_int(pl_json_member_by_index(ptRootJsonObject, 0)), 2, NULL);
+    pl_unload_json(&ptRootJsonObject);
+
+    // bad line stops iteration with the cursor on it
+    const size_t szBadLine = szCursor;
+    pl_test_expect_false(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_true(szCursor == szBadLine && szCursor < szLength, NULL);
+
+    // skip it & continue
+    szCursor = (size_t)(strchr(&pcJson[szCursor], '\n') - pcJson) + 1;
+    pl_test_expect_true(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "id", -1), 4, NULL);
+    pl_unload_json(&ptRootJsonObject);
+
+    pl_test_expect_false(pl_parse_json_ndjson(pcJson, szLength, &szCursor, &ptRootJsonObject), NULL);
+    pl_test_expect_true(szCursor == szLength, NULL);
+}
+
+static void
+json_stream_write_document(plJsonWriter* ptWriter)
+{
+    pl_json_write_begin_object(ptWriter);
+
+    pl_json_write_key(ptWriter, "name");
+    pl_json_write_string(ptWriter, "stream");
+
+    pl_json_write_key(ptWriter, "quoted");
+    pl_json_write_string(ptWriter, "say \"hi\"\n");
+
+    pl_json_write_key(ptWriter, "int");
+    pl_json_write_int(ptWriter, -42);
+
+    pl_json_write_key(ptWriter, "uint");
+    pl_json_write_uint(ptWriter, 4000000000u);
+
+    pl_json_write_key(ptWriter, "float");
+    pl_json_write_float(ptWriter, 0.1f);
+
+    pl_json_write_key(ptWriter, "double");
+    pl_json_write_double(ptWriter, 3.141592653589793);
+
+    pl_json_write_key(ptWriter, "bool");
+    pl_json_write_bool(ptWriter, true);
+
+    pl_json_write_key(ptWriter, "nan");
+    pl_json_write_float(ptWriter, NAN);
+
+    pl_json_write_key(ptWriter, "empty");
+    pl_json_write_begin_object(ptWriter);
+    pl_json_write_end_object(ptWriter);
+
+    pl_json_write_key(ptWriter, "floats");
+    pl_json_write_begin_array(ptWriter);
+    pl_json_write_float(ptWriter, 1.0f);
+    pl_json_write_float(ptWriter, 1e-38f);
+    pl_json_write_float(ptWriter, FLT_MAX);
+    pl_json_write_float(ptWriter, 123.456f);
+    pl_json_write_end_array(ptWriter);
+
+    pl_json_write_key(ptWriter, "objects");
+    pl_json_write_begin_array(ptWriter);
+    for(int i = 0; i < 100; i++)
+    {
+        pl_json_write_begin_object(ptWriter);
+        pl_json_write_key(ptWriter, "id");
+        pl_json_write_int(ptWriter, i);
+        pl_json_write_end_object(ptWriter);
+    }
+    pl_json_write_end_array(ptWriter);
+
+    pl_json_write_end_object(ptWriter);
+}
+
+void
+json_stream_write_test(void* pData)
+{
+    for(uint32_t uPretty = 0; uPretty < 2; uPretty++)
+    {
+        char acOutput[8192] = {0};
+        plJsonMemorySink tSink = {
+            .pcBuffer   = acOutput,
+            .szCapacity = 8192
+        };
+
+        char acStaging[16]; // small to force many flushes
+        plJsonWriterDesc tDesc = {
+            .pfSink      = pl_json_memory_sink,
+            .pUserData   = &tSink,
+            .pcBuffer    = acStaging,
+            .uBufferSize = 16,
+            .bPretty     = uPretty == 1
+        };
+        plJsonWriter tWriter = {0};
+        pl_json_writer_init(&tWriter, &tDesc);
+        json_stream_write_document(&tWriter);
+        pl_test_expect_true(pl_json_writer_finish(&tWriter), NULL);
+        pl_test_expect_false(tSink.bOverflow, NULL);
+
+        plJsonObject* ptRootJsonObject = NULL;
+        pl_test_expect_true(pl_load_json(acOutput, &ptRootJsonObject), NULL);
+        if(ptRootJsonObject == NULL)
+            continue;
+
+        char acBuffer[64] = {0};
+        pl_test_expect_string_equal(pl_json_string_member(ptRootJsonObject, "name", acBuffer, 64), "stream", NULL);
+        pl_test_expect_string_equal(pl_json_string_member(ptRootJsonObject, "quoted", acBuffer, 64), "say \\\"hi\\\"\\n", NULL);
+        pl_test_expect_int_equal(pl_json_int_member(ptRootJsonObject, "int", 0), -42, NULL);
+        pl_test_expect_uint32_equal(pl_json_uint_member(ptRootJsonObject, "uint", 0), 4000000000u, NULL);
+        pl_test_expect_true(pl_json_float_member(ptRootJsonObject, "float", 0.0f) == 0.1f, NULL);
+        pl_test_expect_true(pl_json_double_member(ptRootJsonObject, "double", 0.0) == 3.141592653589793, NULL);
+        pl_test_expect_true(pl_json_bool_member(ptRootJsonObject, "bool", false), NULL);
+        pl_test_expect_int_equal(pl_json_get_type(pl_json_member_by_index(ptRootJsonObject, 7)), PL_JSON_TYPE_NULL, NULL);
+
+        uint32_t uSize = 0;
+        pl_test_expect_true(pl_json_member(ptRootJsonObject, "empty") != NULL, NULL);
+        float afValues[4] = {0};
+        pl_json_float_array_member(ptRootJsonObject, "floats", afValues, &uSize);
+        pl_test_expect_uint32_equal(uSize, 4, NULL);
+        pl_test_expect_true(afValues[0] == 1.0f && afValues[1] == 1e-38f && afValues[2] == FLT_MAX && afValues[3] == 123.456f, NULL);
+
+        plJsonObject* ptObjects = pl_json_array_member(ptRootJsonObject, "objects", &uSize);
+        pl_test_expect_uint32_equal(uSize, 100, NULL);
+        pl_test_expect_int_equal(pl_json_int_member(pl_json_member_by_index(ptObjects, 99), "id", 0), 99, NULL);
+
+        pl_unload_json(&ptRootJsonObject);
+    }
+
+    // shortest round trip formatting
+    {
+        char acOutput[64] = {0};
+        plJsonMemorySink tSink = {.pcBuffer = acOutput, .szCapacity = 64};
+        char acStaging[64];
+        plJsonWriterDesc tDesc = {.pfSink = pl_json_memory_sink, .pUserData = &tSink, .pcBuffer = acStaging, .uBufferSize = 64};
+        plJsonWriter tWriter = {0};
+        pl_json_writer_init(&tWriter, &tDesc);
+        pl_json_write_begin_array(&tWriter);
+        pl_json_write_float(&tWriter, 0.1f);
+        pl_json_write_double(&tWriter, 0.3);
+        pl_json_write_float(&tWriter, 2.5f);
+        pl_json_write_end_array(&tWriter);
+        pl_test_expect_true(pl_json_writer_finish(&tWriter), NULL);
+        pl_test_expect_string_equal(acOutput, "[0.1,0.3,2.5]", NULL);
+    }
+
+    // misuse is reported
+    {
+        char acOutput[64] = {0};
+        plJsonMemorySink tSink = {.pcBuffer = acOutput, .szCapacity = 64};
+        char acStaging[64];
+        plJsonWriterDesc tDesc = {.pfSink = pl_json_memory_sink, .pUserData = &tSink, .pcBuffer = acStaging, .uBufferSize = 64};
+        plJsonWriter tWriter = {0};
+
+        pl_json_writer_init(&tWriter, &tDesc);
+        pl_json_write_begin_object(&tWriter);
+        pl_json_write_int(&tWriter, 1); // missing key
+        pl_json_write_end_object(&tWriter);
+        pl_test_expect_false(pl_json_writer_finish(&tWriter), NULL);
+
+        pl_json_writer_init(&tWriter, &tDesc);
+        pl_json_write_begin_array(&tWriter);
+        pl_json_write_end_object(&tWriter); // mismatched
+        pl_test_expect_false(pl_json_writer_finish(&tWriter), NULL);
+
+        pl_json_writer_init(&tWriter, &tDesc);
+        pl_json_write_begin_array(&tWriter); // unterminated
+        pl_test_expect_false(pl_json_writer_finish(&tWriter), NULL);
+    }
+}
+
+void
+json_bin_test(void* pData)
+{
+    // text -> plBin -> text must be lossless (including number spelling)
+    char acJson[4096] = {0};
+    int iCursor = snprintf(acJson, 4096,
+        "{\"name\": \"plBin\", \"quoted\": \"a \\\"b\\\" \\u00e9\", \"small\": -12, \"large\": 9007199254740993,"
+        " \"min\": -9223372036854775808, \"real\": 0.1, \"spelled\": 1.0, \"exp\": 1e5, \"negzero\": -0,"
+        " \"yes\": true, \"no\": false, \"nothing\": null, \"empty\": {}, \"none\": [],"
+        " \"mixed\": [1, \"two\", [3.5, null], {\"four\": 4}], \"floats\": [0.5, 1.25, 2], \"names\": [\"plBin\", \"plBin\"],"
+        " \"wide\": {");
+    for(int i = 0; i < 40; i++)
+        iCursor += snprintf(&acJson[iCursor], 4096 - iCursor, "%s\"m%d\": %d", i == 0 ? "" : ", ", i, i * 1000);
+    snprintf(&acJson[iCursor], 4096 - iCursor, "}}");
+
+    plJsonObject* ptJson = NULL;
+    pl_test_expect_true(pl_load_json(acJson, &ptJson), NULL);
+    if(ptJson == NULL)
+        return;
+
+    size_t szSize = 0;
+    pl_test_expect_true(pl_write_json_bin(ptJson, NULL, &szSize), NULL);
+    uint32_t* puBin = malloc(szSize); // plBin buffers must be 4 byte aligned
+    pl_test_expect_false(pl_write_json_bin(ptJson, puBin, &(size_t){szSize - 4}), "buffer too small");
+    pl_test_expect_true(pl_write_json_bin(ptJson, puBin, &szSize), NULL);
+
+    // in place access
+    plJsonBinValue tRoot = {0};
+    pl_test_expect_true(pl_json_bin_root(puBin, szSize, &tRoot), NULL);
+    pl_test_expect_int_equal(pl_json_bin_get_type(tRoot), PL_JSON_TYPE_OBJECT, NULL);
+    pl_test_expect_uint32_equal(pl_json_bin_count(tRoot), 18, NULL);
+    pl_test_expect_string_equal(pl_json_bin_as_string(pl_json_bin_member(tRoot, "name")), "plBin", NULL);
+    pl_test_expect_string_equal(pl_json_bin_as_string(pl_json_bin_member(tRoot, "quoted")), "a \\\"b\\\" \\u00e9", NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "small")) == -12, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "large")) == 9007199254740993, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "min")) == INT64_MIN, NULL);
+    pl_test_expect_true(pl_json_bin_as_double(pl_json_bin_member(tRoot, "real")) == 0.1, NULL);
+    pl_test_expect_true(pl_json_bin_as_double(pl_json_bin_member(tRoot, "spelled")) == 1.0, NULL);
+    pl_test_expect_true(pl_json_bin_as_double(pl_json_bin_member(tRoot, "exp")) == 1e5, NULL);
+    pl_test_expect_true(pl_json_bin_as_bool(pl_json_bin_member(tRoot, "yes")), NULL);
+    pl_test_expect_false(pl_json_bin_as_bool(pl_json_bin_member(tRoot, "no")), NULL);
+    pl_test_expect_int_equal(pl_json_bin_get_type(pl_json_bin_member(tRoot, "nothing")), PL_JSON_TYPE_NULL, NULL);
+    pl_test_expect_int_equal(pl_json_bin_get_type(pl_json_bin_member(tRoot, "missing")), PL_JSON_TYPE_UNSPECIFIED, NULL);
+
+    plJsonBinValue tMixed = pl_json_bin_member(tRoot, "mixed");
+    pl_test_expect_uint32_equal(pl_json_bin_count(tMixed), 4, NULL);
+    pl_test_expect_true(pl_json_bin_as_double(pl_json_bin_element(pl_json_bin_element(tMixed, 2), 0)) == 3.5, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(pl_json_bin_element(tMixed, 3), "four")) == 4, NULL);
+    pl_test_expect_int_equal(pl_json_bin_get_type(pl_json_bin_element(tMixed, 4)), PL_JSON_TYPE_UNSPECIFIED, NULL);
+
+    // strings & names are stored once
+    plJsonBinValue tNames = pl_json_bin_member(tRoot, "names");
+    pl_test_expect_true(pl_json_bin_as_string(pl_json_bin_element(tNames, 0)) == pl_json_bin_as_string(pl_json_bin_element(tNames, 1)), NULL);
+    pl_test_expect_true(pl_json_bin_as_string(pl_json_bin_element(tNames, 0)) == pl_json_bin_as_string(pl_json_bin_member(tRoot, "name")), NULL);
+
+    // hashed members
+    plJsonBinValue tWide = pl_json_bin_member(tRoot, "wide");
+    const char* pcName = NULL;
+    pl_json_bin_member_by_index(tWide, 39, &pcName);
+    pl_test_expect_string_equal(pcName, "m39", NULL);
+    uint32_t uFound = 0;
+    for(int i = 0; i < 40; i++)
+    {
+        char acName[8];
+        snprintf(acName, 8, "m%d", i);
+        if(pl_json_bin_as_int(pl_json_bin_member(tWide, acName)) == i * 1000)
+            uFound++;
+    }
+    pl_test_expect_uint32_equal(uFound, 40, NULL);
+    pl_test_expect_int_equal(pl_json_bin_get_type(pl_json_bin_member(tWide, "m40")), PL_JSON_TYPE_UNSPECIFIED, NULL);
+
+    // back to the dom
+    plJsonObject* ptCopy = NULL;
+    pl_test_expect_true(pl_load_json_bin(puBin, szSize, &ptCopy), NULL);
+    if(ptCopy)
+    {
+        uint32_t uExpectedSize = 0;
+        uint32_t uCopySize = 0;
+        pl_write_json(ptJson, NULL, &uExpectedSize);
+        pl_write_json(ptCopy, NULL, &uCopySize);
+        pl_test_expect_uint32_equal(uCopySize, uExpectedSize, NULL);
+
+        char* pcExpected = calloc(1, uExpectedSize + 1);
+        char* pcCopy = calloc(1, uCopySize + 1);
+        pl_write_json(ptJson, pcExpected, &uExpectedSize);
+        pl_write_json(ptCopy, pcCopy, &uCopySize);
+        pl_test_expect_string_equal(pcCopy, pcExpected, NULL);
+
+        float afValues[3] = {0};
+        uint32_t uCount = 0;
+        pl_json_float_array_member(ptCopy, "floats", afValues, &uCount);
+        pl_test_expect_uint32_equal(uCount, 3, NULL);
+        pl_test_expect_true(afValues[0] == 0.5f && afValues[1] == 1.25f && afValues[2] == 2.0f, NULL);
+        pl_test_expect_int_equal(pl_json_int_member(pl_json_member(ptCopy, "wide"), "m17", 0), 17000, NULL);
+
+        free(pcExpected);
+        free(pcCopy);
+        pl_unload_json(&ptCopy);
+    }
+
+    // documents built with the writing api
+    {
+        plJsonObject* ptBuilt = pl_json_new_root_object("ROOT");
+        int aiValues[] = {1, -2, 300000000};
+        char* apcNames[] = {"a", "b"};
+        pl_json_add_int_array(ptBuilt, "ints", aiValues, 3);
+        pl_json_add_string_array(ptBuilt, "strings", apcNames, 2);
+        pl_json_add_double_member(ptBuilt, "pi", 3.141592653589793);
+
+        size_t szBuiltSize = 0;
+        pl_write_json_bin(ptBuilt, NULL, &szBuiltSize);
+        uint32_t* puBuilt = malloc(szBuiltSize);
+        pl_test_expect_true(pl_write_json_bin(ptBuilt, puBuilt, &szBuiltSize), NULL);
+
+        plJsonBinValue tBuilt = {0};
+        pl_json_bin_root(puBuilt, szBuiltSize, &tBuilt);
+        pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_element(pl_json_bin_member(tBuilt, "ints"), 2)) == 300000000, NULL);
+        pl_test_expect_string_equal(pl_json_bin_as_string(pl_json_bin_element(pl_json_bin_member(tBuilt, "strings"), 1)), "b", NULL);
+        pl_test_expect_true(pl_json_bin_as_double(pl_json_bin_member(tBuilt, "pi")) == 3.141592653589793, NULL);
+        free(puBuilt);
+        pl_unload_json(&ptBuilt);
+    }
+
+    // corrupt & truncated buffers are rejected
+    plJsonObject* ptBad = NULL;
+    pl_test_expect_false(pl_load_json_bin(puBin, 12, &ptBad), "truncated header");
+    pl_test_expect_false(pl_load_json_bin(puBin, szSize - 4, &ptBad), "truncated");
+    puBin[3] = (puBin[3] & 7) | ((uint32_t)(szSize / 4) << 3);
+    pl_test_expect_false(pl_load_json_bin(puBin, szSize, &ptBad), "root out of bounds");
+    puBin[0] = 0;
+    pl_test_expect_false(pl_json_bin_root(puBin, szSize, &tRoot), "bad magic");
+    pl_test_expect_true(ptBad == NULL, NULL);
+
+    free(puBin);
+    pl_unload_json(&ptJson);
+}
+
+void
+json_number_range_test(void* pData)
+{
+    // integer getters truncate fractions & saturate values outside the int64 range
+    const char* pcJson = "{\"frac\": 2.75, \"huge\": 1e300, \"tiny\": -1e300, \"over\": 9223372036854775808, \"row\": [-3.5, 7e1]}";
+
+    plJsonObject* ptJson = NULL;
+    pl_test_expect_true(pl_load_json(pcJson, &ptJson), NULL);
+    if(ptJson == NULL)
+        return;
+
+    pl_test_expect_int_equal(pl_json_int_member(ptJson, "frac", 0), 2, NULL);
+    pl_test_expect_uint32_equal(pl_json_uint_member(ptJson, "frac", 0), 2, NULL);
+    int aiRow[2] = {0};
+    pl_json_int_array_member(ptJson, "row", aiRow, NULL);
+    pl_test_expect_int_equal(aiRow[0], -3, NULL);
+    pl_test_expect_int_equal(aiRow[1], 70, NULL);
+
+    size_t szSize = 0;
+    pl_write_json_bin(ptJson, NULL, &szSize);
+    uint32_t* puBin = malloc(szSize);
+    pl_test_expect_true(pl_write_json_bin(ptJson, puBin, &szSize), NULL);
+    plJsonBinValue tRoot = {0};
+    pl_test_expect_true(pl_json_bin_root(puBin, szSize, &tRoot), NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "huge")) == INT64_MAX, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "tiny")) == INT64_MIN, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "over")) == INT64_MAX, NULL);
+    pl_test_expect_true(pl_json_bin_as_int(pl_json_bin_member(tRoot, "frac")) == 2, NULL);
+
+    free(puBin);
+    pl_unload_json(&ptJson);
+}
 
 void
 pl_json_tests(void* pData)
@@ -178,4 +848,12 @@ pl_json_tests(void* pData)
 
     pl_test_register_test(write_json_test, &pcBuffer);
     pl_test_register_test(read_json_test, &pcBuffer);
+    pl_test_register_test(read_json_text_test, NULL);
+    pl_test_register_test(read_json_large_object_test, NULL);
+    pl_test_register_test(json_conformance_test, NULL);
+    pl_test_register_test(json_block_boundary_test, NULL);
+    pl_test_register_test(json_ndjson_test, NULL);
+    pl_test_register_test(json_stream_write_test, NULL);
+    pl_test_register_test(json_bin_test, NULL);
+    pl_test_register_test(json_number_range_test, NULL);
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+#include "pl_number.h"
+
+// stride through float bit patterns for the float round trip test; the default
+// samples 1 in 251 patterns (~17M), pl_number_exhaustive_test builds with 1 (all 2^32)
+#ifndef PL_NUMBER_TEST_FLOAT_STRIDE
+    #define PL_NUMBER_TEST_FLOAT_STRIDE 251
+#endif
+
+void
+number_format_test(void* pData)
+{
+    char acBuffer[PL_NUMBER_MAX_CHARS] = {0};
+
+    pl_format_double(0.0, acBuffer);                     pl_test_expect_string_equal(acBuffer, "0", NULL);
+    pl_format_double(-0.0, acBuffer);                    pl_test_expect_string_equal(acBuffer, "-0", NULL);
+    pl_format_double(1.0, acBuffer);                     pl_test_expect_string_equal(acBuffer, "1", NULL);
+    pl_format_double(0.1, acBuffer);                     pl_test_expect_string_equal(acBuffer, "0.1", NULL);
+    pl_format_double(0.1 + 0.2, acBuffer);               pl_test_expect_string_equal(acBuffer, "0.30000000000000004", NULL);
+    pl_format_double(-123.456, acBuffer);                pl_test_expect_string_equal(acBuffer, "-123.456", NULL);
+    pl_format_double(1e21, acBuffer);                    pl_test_expect_string_equal(acBuffer, "1e+21", NULL);
+    pl_format_double(1e20, acBuffer);                    pl_test_expect_string_equal(acBuffer, "100000000000000000000", NULL);
+    pl_format_double(1e-7, acBuffer);                    pl_test_expect_string_equal(acBuffer, "1e-7", NULL);
+    pl_format_double(0.000001, acBuffer);                pl_test_expect_string_equal(acBuffer, "0.000001", NULL);
+    pl_format_double(5e-324, acBuffer);                  pl_test_expect_string_equal(acBuffer, "5e-324", NULL);
+    pl_format_double(1.7976931348623157e308, acBuffer);  pl_test_expect_string_equal(acBuffer, "1.7976931348623157e+308", NULL);
+    pl_format_double(9007199254740993.0, acBuffer);      pl_test_expect_string_equal(acBuffer, "9007199254740992", NULL);
+    pl_format_double((double)INFINITY, acBuffer);        pl_test_expect_string_equal(acBuffer, "inf", NULL);
+    pl_format_double(-(double)INFINITY, acBuffer);       pl_test_expect_string_equal(acBuffer, "-inf", NULL);
+    pl_format_double((double)NAN, acBuffer);             pl_test_expect_string_equal(acBuffer, "nan", NULL);
+
+    pl_format_float(0.1f, acBuffer);                     pl_test_expect_string_equal(acBuffer, "0.1", NULL);
+    pl_format_float(3.14159f, acBuffer);                 pl_test_expect_string_equal(acBuffer, "3.14159", NULL);
+    pl_format_float(16777216.0f, acBuffer);              pl_test_expect_string_equal(acBuffer, "16777216", NULL);
+    pl_format_float(3.4028235e38f, acBuffer);            pl_test_expect_string_equal(acBuffer, "3.4028235e+38", NULL);
+    pl_format_float(1e-45f, acBuffer);                   pl_test_expect_string_equal(acBuffer, "1e-45", NULL);
+
+    uint32_t uLength = pl_format_int32(INT32_MIN, acBuffer);
+    pl_test_expect_string_equal(acBuffer, "-2147483648", NULL);
+    pl_test_expect_uint32_equal(uLength, 11, NULL);
+    pl_format_int32(0, acBuffer);                        pl_test_expect_string_equal(acBuffer, "0", NULL);
+    pl_format_uint32(UINT32_MAX, acBuffer);              pl_test_expect_string_equal(acBuffer, "4294967295", NULL);
+    pl_format_int64(INT64_MIN, acBuffer);                pl_test_expect_string_equal(acBuffer, "-9223372036854775808", NULL);
+    pl_format_uint64(UINT64_MAX, acBuffer);              pl_test_expect_string_equal(acBuffer, "18446744073709551615", NULL);
+    pl_format_uint64(10000000, acBuffer);                pl_test_expect_string_equal(acBuffer, "10000000", NULL);
+}
+
+void
+number_parse_test(void* pData)
+{
+    double dValue = 0.0;
+    float  fValue = 0.0f;
+
+    pl_test_expect_uint64_equal(pl_parse_double("0.1", 3, &dValue), 3, NULL);
+    pl_test_expect_true(dValue == 0.1, "0.1");
+    pl_test_expect_uint64_equal(pl_parse_double("-1.5e3,", 7, &dValue), 6, "stops at delimiter");
+    pl_test_expect_true(dValue == -1500.0, "-1.5e3");
+    pl_test_expect_uint64_equal(pl_parse_double("1e", 2, &dValue), 1, "dangling exponent");
+    pl_test_expect_true(dValue == 1.0, "1e");
+    pl_test_expect_uint64_equal(pl_parse_double("12345", 3, &dValue), 3, "respects length");
+    pl_test_expect_true(dValue == 123.0, "123");
+    pl_test_expect_uint64_equal(pl_parse_double("abc", 3, &dValue), 0, "not a number");
+    pl_test_expect_uint64_equal(pl_parse_double(" 1", 2, &dValue), 0, "no whitespace skipping");
+
+    // edge of range
+    pl_parse_double("1.7976931348623157e308", 22, &dValue);
+    pl_test_expect_true(dValue == 1.7976931348623157e308, "DBL_MAX");
+    pl_parse_double("1.8e308", 7, &dValue);
+    pl_test_expect_true(isinf(dValue), "overflow");
+    pl_parse_double("4.9406564584124654e-324", 23, &dValue);
+    pl_test_expect_true(dValue == 5e-324, "smallest subnormal");
+    pl_parse_double("2.4703282292062327e-324", 23, &dValue);
+    pl_test_expect_true(dValue == 0.0, "underflow");
+    pl_parse_double("-0", 2, &dValue);
+    pl_test_expect_true(dValue == 0.0 && signbit(dValue), "negative zero");
+
+    // halfway cases that need more than 19 digits to resolve
+    const char* pcHalfway = "9007199254740993.000000000000000000000000000001";
+    pl_parse_double(pcHalfway, strlen(pcHalfway), &dValue);
+    pl_test_expect_true(dValue == 9007199254740994.0, "just above halfway rounds up");
+    pcHalfway = "9007199254740993";
+    pl_parse_double(pcHalfway, strlen(pcHalfway), &dValue);
+    pl_test_expect_true(dValue == 9007199254740992.0, "exact halfway rounds to even");
+    const char* pcLong = "2.22507385850720113605740979670913197593481954635164564802342610972482222202107694551652952390813508791414915891303962110687008643869459464552765720740782062174337998814106326732925355228688137214901298112245145188984905722230728525513315575501591439747639798341180199932396254828901710708185069063066665599493827577257201576306269066333264756530000000000000e-308";
+    pl_parse_double(pcLong, strlen(pcLong), &dValue);
+    pl_test_expect_true(dValue == 2.2250738585072009e-308, "long input near DBL_MIN");
+
+    pl_parse_float("3.4028235e38", 12, &fValue);
+    pl_test_expect_true(fValue == 3.4028235e38f, "FLT_MAX");
+    pl_parse_float("1.00000005960464477539062501", 28, &fValue);
+    pl_test_expect_true(fValue == 1.00000012f, "float above halfway");
+    pl_parse_float("1.000000059604644775390625", 26, &fValue);
+    pl_test_expect_true(fValue == 1.0f, "float exact halfway");
+
+    // specials
+    pl_test_expect_uint64_equal(pl_parse_double("inf", 3, &dValue), 3, NULL);
+    pl_test_expect_true(isinf(dValue) && dValue > 0.0, "inf");
+    pl_test_expect_uint64_equal(pl_parse_double("-Infinity", 9, &dValue), 9, NULL);
+    pl_test_expect_true(isinf(dValue) && dValue < 0.0, "-Infinity");
+    pl_test_expect_uint64_equal(pl_parse_double("NaN", 3, &dValue), 3, NULL);
+    pl_test_expect_true(isnan(dValue), "NaN");
+
+    // integers
+    int32_t  iValue32  = 0;
+    uint32_t uValue32  = 0;
+    int64_t  iValue64  = 0;
+    uint64_t uValue64  = 0;
+    pl_test_expect_uint64_equal(pl_parse_int32("-2147483648", 11, &iValue32), 11, NULL);
+    pl_test_expect_true(iValue32 == INT32_MIN, "INT32_MIN");
+    pl_test_expect_uint64_equal(pl_parse_int32("2147483648", 10, &iValue32), 0, "int32 overflow");
+    pl_test_expect_uint64_equal(pl_parse_uint32("4294967295", 10, &uValue32), 10, NULL);
+    pl_test_expect_uint32_equal(uValue32, UINT32_MAX, NULL);
+    pl_test_expect_uint64_equal(pl_parse_uint32("4294967296", 10, &uValue32), 0, "uint32 overflow");
+    pl_test_expect_uint64_equal(pl_parse_uint32("-1", 2, &uValue32), 0, "unsigned sign");
+    pl_test_expect_uint64_equal(pl_parse_int64("-9223372036854775808", 20, &iValue64), 20, NULL);
+    pl_test_expect_true(iValue64 == INT64_MIN, "INT64_MIN");
+    pl_test_expect_uint64_equal(pl_parse_int64("9223372036854775808", 19, &iValue64), 0, "int64 overflow");
+    pl_test_expect_uint64_equal(pl_parse_uint64("18446744073709551615", 20, &uValue64), 20, NULL);
+    pl_test_expect_uint64_equal(uValue64, UINT64_MAX, NULL);
+    pl_test_expect_uint64_equal(pl_parse_uint64("18446744073709551616", 20, &uValue64), 0, "uint64 overflow");
+    pl_test_expect_uint64_equal(pl_parse_uint64("123456789012x", 13, &uValue64), 12, NULL);
+    pl_test_expect_uint64_equal(uValue64, 123456789012ull, NULL);
+}
+
+void
+number_float_round_trip_test(void* pData)
+{
+    char acBuffer[PL_NUMBER_MAX_CHARS] = {0};
+
+    // every float bit pattern (at stride) must survive format -> parse
+    uint32_t uFloatFailures = 0;
+    for(uint64_t uBits = 0; uBits <= UINT32_MAX; uBits += PL_NUMBER_TEST_FLOAT_STRIDE)
+    {
+        const uint32_t uPattern = (uint32_t)uBits;
+        float fValue = 0.0f;
+        memcpy(&fValue, &uPattern, sizeof(float));
+        if(isnan(fValue))
+            continue;
+
+        const uint32_t uLength = pl_format_float(fValue, acBuffer);
+        float fParsed = 0.0f;
+        uint32_t uParsedPattern = 0;
+        if(pl_parse_float(acBuffer, uLength, &fParsed) != uLength)
+            uFloatFailures++;
+        memcpy(&uParsedPattern, &fParsed, sizeof(float));
+        if(uParsedPattern != uPattern)
+            uFloatFailures++;
+    }
+    pl_test_expect_uint32_equal(uFloatFailures, 0, "float round trip");
+}
+
+void
+number_round_trip_test(void* pData)
+{
+    char acBuffer[PL_NUMBER_MAX_CHARS] = {0};
+
+    // doubles from a fixed xorshift sequence
+    uint32_t uDoubleFailures = 0;
+    uint64_t uState = 0x9E3779B97F4A7C15ull;
+    for(uint32_t i = 0; i < 1000000; i++)
+    {
+        uState ^= uState << 13;
+        uState ^= uState >> 7;
+        uState ^= uState << 17;
+        double dValue = 0.0;
+        memcpy(&dValue, &uState, sizeof(double));
+        if(isnan(dValue) || isinf(dValue))
+            continue;
+
+        const uint32_t uLength = pl_format_double(dValue, acBuffer);
+        double dParsed = 0.0;
+        uint64_t uParsedPattern = 0;
+        if(pl_parse_double(acBuffer, uLength, &dParsed) != uLength)
+            uDoubleFailures++;
+        memcpy(&uParsedPattern, &dParsed, sizeof(double));
+        if(uParsedPattern != uState)
+            uDoubleFailures++;
+    }
+    pl_test_expect_uint32_equal(uDoubleFailures, 0, "double round trip");
+
+    // integers
+    uint32_t uIntegerFailures = 0;
+    for(uint32_t i = 0; i < 100000; i++)
+    {
+        uState ^= uState << 13;
+        uState ^= uState >> 7;
+        uState ^= uState << 17;
+        const int64_t iValue = (int64_t)(uState >> (1 + i % 63));
+        int64_t iParsed = 0;
+        const uint32_t uLength = pl_format_int64(i % 2 ? -iValue : iValue, acBuffer);
+        if(pl_parse_int64(acBuffer, uLength, &iParsed) != uLength || iParsed != (i % 2 ? -iValue : iValue))
+            uIntegerFailures++;
+    }
+    pl_test_expect_uint32_equal(uIntegerFailures, 0, "int64 round trip");
+}
+
+void
+pl_number_tests(void* pData)
+{
+    pl_test_register_test(number_format_test, NULL);
+    pl_test_register_test(number_parse_test, NULL);
+    pl_test_register_test(number_float_round_trip_test, NULL);
+    pl_test_register_test(number_round_trip_test, NULL);
+}
@@ -0,0 +1,382 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pl_test.h"
+
+#include <stdint.h>
+#include "pl_ecs_ext.h"
+#include "pl_spatial_ext.h"
+
+// uses the shared fixtures in pl_ecs_tests.h
+
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+static plAABB
+ecs_test_random_box(float fWorld, float fMaxSize)
+{
+    const plVec3 tCenter = {.x = (ecs_test_rand() * 2.0f - 1.0f) * fWorld, .y = (ecs_test_rand() * 2.0f - 1.0f) * fWorld, .z = (ecs_test_rand() * 2.0f - 1.0f) * fWorld};
+    const float fSize = ecs_test_rand() < 0.02f ? fMaxSize * 20.0f : ecs_test_rand() * fMaxSize; // a few huge ones stay high up
+    const plVec3 tHalf = {.x = fSize * (0.2f + ecs_test_rand()), .y = fSize * (0.2f + ecs_test_rand()), .z = fSize * (0.2f + ecs_test_rand())};
+    return (plAABB){pl_sub_vec3(tCenter, tHalf), pl_add_vec3(tCenter, tHalf)};
+}
+
+// random query of each type (uType % 4), built the way the public api builds them
+static plSpatialQuery
+ecs_test_random_spatial_query(uint32_t uType, float fWorld)
+{
+    plSpatialQuery tQuery = {.tType = (int)(uType % 4)};
+    const plVec3 tPoint = {.x = (ecs_test_rand() * 2.0f - 1.0f) * fWorld, .y = (ecs_test_rand() * 2.0f - 1.0f) * fWorld, .z = (ecs_test_rand() * 2.0f - 1.0f) * fWorld};
+    if(tQuery.tType == PL_SPATIAL_QUERY_AABB)
+        tQuery.tBox = ecs_test_random_box(fWorld, fWorld * 0.2f);
+    else if(tQuery.tType == PL_SPATIAL_QUERY_SPHERE)
+    {
+        const float fRadius = ecs_test_rand() * fWorld * 0.2f;
+        tQuery.tCenter = tPoint;
+        tQuery.fRadiusSquared = fRadius * fRadius;
+        const plVec3 tExtent = {.x = fRadius, .y = fRadius, .z = fRadius};
+        tQuery.tBox = (plAABB){.tMin = pl_sub_vec3(tPoint, tExtent), .tMax = pl_add_vec3(tPoint, tExtent)};
+    }
+    else if(tQuery.tType == PL_SPATIAL_QUERY_RAY)
+    {
+        plVec3 tDirection = {.x = ecs_test_rand() * 2.0f - 1.0f, .y = ecs_test_rand() * 2.0f - 1.0f, .z = ecs_test_rand() * 2.0f - 1.0f};
+        if(uType % 3 == 0) // axis parallel
+            tDirection.y = 0.0f;
+        pl__spatial_init_ray(&tQuery, tPoint, tDirection, uType % 2 ? FLT_MAX : fWorld * ecs_test_rand());
+    }
+    else
+    {
+        plCameraComponent tCamera = {
+            .tType        = PL_CAMERA_TYPE_PERSPECTIVE,
+            .tPos         = tPoint,
+            .fNearZ       = 0.1f,
+            .fFarZ        = fWorld * (0.2f + ecs_test_rand()),
+            .fFieldOfView = 0.5f + ecs_test_rand(),
+            .fAspectRatio = 1.5f,
+            .fYaw         = ecs_test_rand() * 6.0f,
+            .fPitch       = ecs_test_rand() - 0.5f
+        };
+        gptCamera->update(&tCamera);
+        const plMat4 tViewProjection = pl_mul_mat4(&tCamera.tProjMat, &tCamera.tViewMat);
+        plVec4 atRows[4];
+        for(uint32_t r = 0; r < 4; r++)
+            atRows[r] = (plVec4){.x = tViewProjection.col[0].d[r], .y = tViewProjection.col[1].d[r], .z = tViewProjection.col[2].d[r], .w = tViewProjection.col[3].d[r]};
+        tQuery.atPlanes[0] = pl_add_vec4(atRows[3], atRows[0]);
+        tQuery.atPlanes[1] = pl_sub_vec4(atRows[3], atRows[0]);
+        tQuery.atPlanes[2] = pl_add_vec4(atRows[3], atRows[1]);
+        tQuery.atPlanes[3] = pl_sub_vec4(atRows[3], atRows[1]);
+        tQuery.atPlanes[4] = atRows[2];
+        tQuery.atPlanes[5] = pl_sub_vec4(atRows[3], atRows[2]);
+    }
+    return tQuery;
+}
+
+static int
+ecs_test_entity_compare(const void* pA, const void* pB)
+{
+    const uint64_t uA = ((const plEntity*)pA)->ulData;
+    const uint64_t uB = ((const plEntity*)pB)->ulData;
+    return uA < uB ? -1 : (uA > uB ? 1 : 0);
+}
+
+static bool
+ecs_test_same_entities(plEntity* atEntities0, uint32_t uCount0, plEntity* atEntities1, uint32_t uCount1)
+{
+    if(uCount0 != uCount1)
+        return false;
+    qsort(atEntities0, uCount0, sizeof(plEntity), ecs_test_entity_compare);
+    qsort(atEntities1, uCount1, sizeof(plEntity), ecs_test_entity_compare);
+    return memcmp(atEntities0, atEntities1, sizeof(plEntity) * uCount0) == 0;
+}
+
+// every entry fits its node's loose bounds & is where its location says, subtree
+// counts add up & no empty subtrees are kept; returns the number of violations
+static uint32_t
+ecs_test_spatial_node_errors(const plSpatialIndex* ptIndex, uint32_t uNode, uint32_t* puCountOut)
+{
+    const plSpatialNode* ptNode = &ptIndex->sbtNodes[uNode];
+    const plAABB tLooseBounds = pl__spatial_loose_bounds(ptNode);
+    uint32_t uErrors = 0;
+    uint32_t uCount = pl_sb_size(ptNode->sbtEntries);
+    for(uint32_t i = 0; i < pl_sb_size(ptNode->sbtEntries); i++)
+    {
+        const plSpatialEntry* ptEntry = &ptNode->sbtEntries[i];
+        for(uint32_t j = 0; j < 3 && uNode != 0; j++)
+        {
+            if(ptEntry->tBounds.tMin.d[j] < tLooseBounds.tMin.d[j] - 1e-3f || ptEntry->tBounds.tMax.d[j] > tLooseBounds.tMax.d[j] + 1e-3f)
+                uErrors++;
+        }
+        const plSpatialLocation tLocation = ptIndex->sbtLocations[ptEntry->tEntity.uIndex];
+        if(tLocation.uNode != uNode || tLocation.uSlot != i)
+            uErrors++;
+    }
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        if(ptNode->auChildren[i] == 0)
+            continue;
+        uint32_t uChildCount = 0;
+        if(ptIndex->sbtNodes[ptNode->auChildren[i]].uParent != uNode)
+            uErrors++;
+        uErrors += ecs_test_spatial_node_errors(ptIndex, ptNode->auChildren[i], &uChildCount);
+        uCount += uChildCount;
+    }
+    if(uCount != ptNode->uSubtreeCount || (uNode != 0 && uCount == 0))
+        uErrors++;
+    *puCountOut = uCount;
+    return uErrors;
+}
+
+typedef struct _plEcsTestSpatialItem
+{
+    plEntity tEntity;
+    plAABB   tBounds;
+    bool     bLive;
+} plEcsTestSpatialItem;
+
+// every query type & raycasts against a linear scan of the live items; returns the number of mismatches
+static uint32_t
+ecs_test_spatial_mismatches(plSpatialIndex* ptIndex, const plEcsTestSpatialItem* atItems, uint32_t uItemCount, float fWorld, uint32_t uQueryCount)
+{
+    plEntity* atFound = malloc(sizeof(plEntity) * uItemCount);
+    plEntity* atExpected = malloc(sizeof(plEntity) * uItemCount);
+    uint32_t uMismatches = 0;
+    for(uint32_t i = 0; i < uQueryCount; i++)
+    {
+        const plSpatialQuery tQuery = ecs_test_random_spatial_query(i, fWorld);
+        uint32_t uExpected = 0;
+        for(uint32_t j = 0; j < uItemCount; j++)
+        {
+            if(atItems[j].bLive && pl__spatial_overlaps(&tQuery, &atItems[j].tBounds))
+                atExpected[uExpected++] = atItems[j].tEntity;
+        }
+        const uint32_t uFound = pl__spatial_run_query(ptIndex, &tQuery, atFound, uItemCount);
+        if(!ecs_test_same_entities(atFound, uFound, atExpected, uExpected))
+            uMismatches++;
+
+        if(tQuery.tType != PL_SPATIAL_QUERY_RAY)
+            continue;
+
+        // closest hit (ties may pick either entity)
+        float fClosest = FLT_MAX;
+        for(uint32_t j = 0; j < uItemCount; j++)
+        {
+            float fDistance = 0.0f;
+            if(atItems[j].bLive && pl__spatial_ray_distance(&tQuery, &atItems[j].tBounds, &fDistance))
+                fClosest = pl_minf(fClosest, fDistance);
+        }
+        const plVec3 tDirection = {
+            .x = tQuery.abParallel[0] ? 0.0f : 1.0f / tQuery.tInvDirection.x,
+            .y = tQuery.abParallel[1] ? 0.0f : 1.0f / tQuery.tInvDirection.y,
+            .z = tQuery.abParallel[2] ? 0.0f : 1.0f / tQuery.tInvDirection.z
+        };
+        plSpatialRayHit tHit = {0};
+        const bool bHit = gptSpatial->raycast(ptIndex, tQuery.tOrigin, tDirection, tQuery.fMaxDistance, &tHit);
+        if(bHit != (fClosest != FLT_MAX) || (bHit && fabsf(tHit.fDistance - fClosest) > 1e-3f * (1.0f + fClosest)))
+            uMismatches++;
+    }
+
+    // truncated output still counts everything, bounds are kept exactly
+    uint32_t uLive = 0;
+    for(uint32_t i = 0; i < uItemCount; i++)
+    {
+        plAABB tBounds;
+        const bool bFound = gptSpatial->get_bounds(ptIndex, atItems[i].tEntity, &tBounds);
+        if(bFound != atItems[i].bLive || (bFound && memcmp(&tBounds, &atItems[i].tBounds, sizeof(plAABB)) != 0))
+            uMismatches++;
+        uLive += atItems[i].bLive;
+    }
+    const plAABB tEverything = {.tMin = {.x = -fWorld * 2.0f, .y = -fWorld * 2.0f, .z = -fWorld * 2.0f}, .tMax = {.x = fWorld * 2.0f, .y = fWorld * 2.0f, .z = fWorld * 2.0f}};
+    if(gptSpatial->query_aabb(ptIndex, &tEverything, atFound, 3) != uLive || gptSpatial->get_count(ptIndex) != uLive)
+        uMismatches++;
+
+    free(atFound);
+    free(atExpected);
+    return uMismatches;
+}
+
+//-----------------------------------------------------------------------------
+// tests
+//-----------------------------------------------------------------------------
+
+void
+spatial_query_test(void* pData)
+{
+    // some items centered outside the root cell, some degenerate
+    const uint32_t uItemCount = 4000;
+    const float fWorld = 100.0f;
+    guEcsTestSeed = 44;
+    plEcsTestSpatialItem* atItems = calloc(uItemCount, sizeof(plEcsTestSpatialItem));
+    const plSpatialIndexDesc tDesc = {.fHalfSize = fWorld * 0.8f, .uMaxDepth = 7};
+    plSpatialIndex* ptIndex = gptSpatial->create(&tDesc);
+    for(uint32_t i = 0; i < uItemCount; i++)
+    {
+        atItems[i].tEntity = (plEntity){.uIndex = i * 3 + 1, .uGeneration = 7};
+        atItems[i].tBounds = ecs_test_random_box(fWorld, fWorld * 0.02f);
+        if(i % 50 == 0)
+            atItems[i].tBounds = (plAABB){.tMin = {.x = -1.0f, .y = -1.0f, .z = -1.0f}, .tMax = {.x = -1.0f, .y = -1.0f, .z = -1.0f}};
+        atItems[i].bLive = true;
+        gptSpatial->update(ptIndex, atItems[i].tEntity, &atItems[i].tBounds);
+    }
+    uint32_t uCount = 0;
+    pl_test_expect_uint32_equal(ecs_test_spatial_node_errors(ptIndex, 0, &uCount), 0, "octree invariants");
+    pl_test_expect_uint32_equal(ecs_test_spatial_mismatches(ptIndex, atItems, uItemCount, fWorld, 800), 0, "queries vs brute force");
+
+    // churn: small & large moves, removals, reinsertions & index reuse with a new generation
+    uint32_t uErrors = 0;
+    uint32_t uMismatches = 0;
+    for(uint32_t uRound = 0; uRound < 6; uRound++)
+    {
+        for(uint32_t i = 0; i < uItemCount; i++)
+        {
+            plEcsTestSpatialItem* ptItem = &atItems[i];
+            const float fAction = ecs_test_rand();
+            if(fAction < 0.3f)
+            {
+                plVec3 tDelta = {.x = ecs_test_rand() - 0.5f, .y = ecs_test_rand() - 0.5f, .z = ecs_test_rand() - 0.5f};
+                if(ecs_test_rand() < 0.1f)
+                    tDelta = pl_mul_vec3_scalarf(tDelta, fWorld);
+                ptItem->tBounds.tMin = pl_add_vec3(ptItem->tBounds.tMin, tDelta);
+                ptItem->tBounds.tMax = pl_add_vec3(ptItem->tBounds.tMax, tDelta);
+                if(ptItem->bLive)
+                    gptSpatial->update(ptIndex, ptItem->tEntity, &ptItem->tBounds);
+            }
+            else if(fAction < 0.35f)
+            {
+                if(ptItem->bLive)
+                    gptSpatial->remove(ptIndex, ptItem->tEntity);
+                else
+                {
+                    ptItem->tBounds = ecs_test_random_box(fWorld, fWorld * 0.05f);
+                    gptSpatial->update(ptIndex, ptItem->tEntity, &ptItem->tBounds);
+                }
+                ptItem->bLive = !ptItem->bLive;
+            }
+            else if(fAction < 0.37f && ptItem->bLive)
+            {
+                ptItem->tEntity.uGeneration++;
+                gptSpatial->remove(ptIndex, ptItem->tEntity);
+                ptItem->tBounds = ecs_test_random_box(fWorld, fWorld * 0.02f);
+                gptSpatial->update(ptIndex, ptItem->tEntity, &ptItem->tBounds);
+            }
+        }
+        uErrors += ecs_test_spatial_node_errors(ptIndex, 0, &uCount);
+        uMismatches += ecs_test_spatial_mismatches(ptIndex, atItems, uItemCount, fWorld, 400);
+    }
+    pl_test_expect_uint32_equal(uErrors, 0, "octree invariants after churn");
+    pl_test_expect_uint32_equal(uMismatches, 0, "queries vs brute force after churn");
+
+    // reset keeps only the root
+    gptSpatial->reset(ptIndex);
+    pl_test_expect_uint32_equal(gptSpatial->get_count(ptIndex), 0, "count after reset");
+    pl_test_expect_uint32_equal(pl_sb_size(ptIndex->sbtNodes) - pl_sb_size(ptIndex->sbuFreeNodes), 1, "nodes after reset");
+    for(uint32_t i = 0; i < uItemCount; i++)
+    {
+        atItems[i].tBounds = ecs_test_random_box(fWorld, fWorld * 0.02f);
+        atItems[i].bLive = true;
+        gptSpatial->update(ptIndex, atItems[i].tEntity, &atItems[i].tBounds);
+    }
+    pl_test_expect_uint32_equal(ecs_test_spatial_node_errors(ptIndex, 0, &uCount), 0, "octree invariants after reset");
+    pl_test_expect_uint32_equal(ecs_test_spatial_mismatches(ptIndex, atItems, uItemCount, fWorld, 200), 0, "queries vs brute force after reset");
+
+    gptSpatial->cleanup(&ptIndex);
+    pl_test_expect_true(ptIndex == NULL, "cleanup");
+    free(atItems);
+}
+
+void
+spatial_library_feed_test(void* pData)
+{
+    plComponentLibrary tLibrary = {0};
+    gptECS->init_component_library(&tLibrary);
+    guEcsTestSeed = 45;
+    ecs_test_build_scene(&tLibrary, 3000, 0);
+    const plSpatialIndexDesc tDesc = {.tCenter = {.x = 5.0f, .y = 5.0f, .z = 5.0f}, .fHalfSize = 20.0f};
+    plSpatialIndex* ptIndex = gptSpatial->create(&tDesc);
+    plEntity* atFound = malloc(sizeof(plEntity) * 4000);
+    plEntity* atExpected = malloc(sizeof(plEntity) * 4000);
+
+    uint32_t uStale = 0;
+    uint32_t uErrors = 0;
+    uint32_t uMismatches = 0;
+    for(uint32_t uFrame = 0; uFrame < 12; uFrame++)
+    {
+        gptECS->run_transform_update_system(&tLibrary);
+        gptECS->run_hierarchy_update_system(&tLibrary);
+        gptECS->run_object_update_system(&tLibrary);
+        gptSpatial->update_from_library(ptIndex, &tLibrary);
+
+        // every object is indexed by its mesh's current bounds
+        const plObjectComponent* sbtObjects = tLibrary.tObjectComponentManager.pComponents;
+        const uint32_t uObjectCount = pl_sb_size(sbtObjects);
+        if(gptSpatial->get_count(ptIndex) != uObjectCount)
+            uStale++;
+        const plSpatialQuery tQuery = {.tType = PL_SPATIAL_QUERY_SPHERE, .tCenter = {.x = 5.0f, .y = 5.0f, .z = 5.0f}, .fRadiusSquared = 16.0f};
+        uint32_t uExpected = 0;
+        for(uint32_t i = 0; i < uObjectCount; i++)
+        {
+            const plEntity tObject = tLibrary.tObjectComponentManager.sbtEntities[i];
+            const plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, sbtObjects[i].tMesh);
+            plAABB tBounds;
+            if(!gptSpatial->get_bounds(ptIndex, tObject, &tBounds) || memcmp(&tBounds, &ptMesh->tAABBFinal, sizeof(plAABB)) != 0)
+                uStale++;
+            if(pl__spatial_overlaps(&tQuery, &ptMesh->tAABBFinal))
+                atExpected[uExpected++] = tObject;
+        }
+        const uint32_t uFound = gptSpatial->query_sphere(ptIndex, tQuery.tCenter, 4.0f, atFound, 4000);
+        if(!ecs_test_same_entities(atFound, uFound, atExpected, uExpected))
+            uMismatches++;
+        uint32_t uIndexed = 0;
+        uErrors += ecs_test_spatial_node_errors(ptIndex, 0, &uIndexed);
+
+        // move some (far every 3rd frame), remove some (the tail included) & add some
+        plTransformComponent* sbtTransforms = tLibrary.tTransformComponentManager.pComponents;
+        for(uint32_t i = 0; i < pl_sb_size(sbtTransforms); i += 7)
+            sbtTransforms[i].tTranslation.x += ecs_test_rand() * (uFrame % 3 == 0 ? 40.0f : 1.0f);
+        for(uint32_t i = 0; i < 20; i++)
+        {
+            const uint32_t uCount = pl_sb_size(tLibrary.tObjectComponentManager.sbtEntities);
+            const uint32_t uRemove = i < 3 ? uCount - 1 : (uint32_t)(ecs_test_rand() * (float)uCount);
+            gptECS->remove_entity(&tLibrary, tLibrary.tObjectComponentManager.sbtEntities[uRemove]);
+        }
+        for(uint32_t i = 0; i < 15 && uFrame % 2 == 1; i++)
+        {
+            plEntity tObject = gptECS->create_object(&tLibrary, "new object", NULL);
+            plMeshComponent* ptMesh = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_MESH, tObject);
+            ptMesh->tAABB = (plAABB){.tMin = {.x = -1.0f, .y = -1.0f, .z = -1.0f}, .tMax = {.x = 1.0f, .y = 1.0f, .z = 1.0f}};
+            plTransformComponent* ptTransform = gptECS->get_component(&tLibrary, PL_COMPONENT_TYPE_TRANSFORM, tObject);
+            ptTransform->tTranslation = pl_create_vec3(ecs_test_rand() * 10.0f, ecs_test_rand() * 10.0f, ecs_test_rand() * 10.0f);
+        }
+    }
+    pl_test_expect_uint32_equal(uStale, 0, "stale entries");
+    pl_test_expect_uint32_equal(uErrors, 0, "octree invariants");
+    pl_test_expect_uint32_equal(uMismatches, 0, "queries vs brute force");
+
+    // feeding a different library starts over
+    plComponentLibrary tOther = {0};
+    gptECS->init_component_library(&tOther);
+    ecs_test_build_scene(&tOther, 50, 0);
+    gptECS->run_transform_update_system(&tOther);
+    gptECS->run_hierarchy_update_system(&tOther);
+    gptECS->run_object_update_system(&tOther);
+    gptSpatial->update_from_library(ptIndex, &tOther);
+    pl_test_expect_uint32_equal(gptSpatial->get_count(ptIndex), 50, "other library");
+
+    free(atFound);
+    free(atExpected);
+    gptSpatial->cleanup(&ptIndex);
+    gptECS->cleanup_component_library(&tOther);
+    gptECS->cleanup_component_library(&tLibrary);
+}
+
+//-----------------------------------------------------------------------------
+// registration
+//-----------------------------------------------------------------------------
+
+void
+pl_spatial_tests(void* pData)
+{
+    pl_test_register_test(spatial_query_test, NULL);
+    pl_test_register_test(spatial_library_feed_test, NULL);
+}